@@ -0,0 +1,328 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- analysis/AnalysisMember.cpp - in-situ analysis ----------*- C++ -*-===//
+//
+// Creates the analysis members from Config, manages their compute alarms and
+// calls their compute methods during the time loop.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisMember.h"
+#include "Error.h"
+#include "Field.h"
+#include "GlobalStats.h"
+#include "Logging.h"
+#include "SurfaceFields.h"
+#include "TimeAverage.h"
+#include "Timing.h"
+#include "ZonalMean.h"
+
+#include <type_traits>
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// create the static class members
+// All defined analysis members
+std::map<std::string, std::unique_ptr<AnalysisMember>>
+    AnalysisMember::AllMembers;
+
+//------------------------------------------------------------------------------
+// utility functions
+// convert string into AnalysisType enum
+AnalysisType getAnalysisTypeFromStr(const std::string &InString) {
+
+   AnalysisType TypeChoice = AnalysisType::Invalid;
+
+   if (InString == "GlobalStats") {
+      TypeChoice = AnalysisType::GlobalStats;
+   } else if (InString == "TimeAverage") {
+      TypeChoice = AnalysisType::TimeAverage;
+   } else if (InString == "ZonalMean") {
+      TypeChoice = AnalysisType::ZonalMean;
+   } else if (InString == "SurfaceFields") {
+      TypeChoice = AnalysisType::SurfaceFields;
+   }
+
+   return TypeChoice;
+}
+
+//------------------------------------------------------------------------------
+// Constructor fills the common members and creates the field group that will
+// hold the products of the member
+AnalysisMember::AnalysisMember(const std::string &InName, AnalysisType InType)
+    : Name(InName), Type(InType) {
+
+   Mesh = HorzMesh::getDefault();
+
+   if (FieldGroup::exists(Name))
+      ABORT_ERROR("AnalysisMember: field group {} already exists, choose "
+                  "another name for the analysis member",
+                  Name);
+   FieldGroup::create(Name);
+}
+
+//------------------------------------------------------------------------------
+// Create all enabled analysis members from the Analysis Config group
+void AnalysisMember::init(Clock *ModelClock) {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Analysis"))
+      return;
+
+   Config AnalysisConfig("Analysis");
+   Error Err = OmegaConfig->get(AnalysisConfig);
+   CHECK_ERROR_ABORT(Err, "AnalysisMember: error reading Analysis group");
+
+   for (auto It = AnalysisConfig.begin(); It != AnalysisConfig.end(); ++It) {
+
+      std::string MemberName = It->first.as<std::string>();
+      Config MemberConfig(MemberName);
+      Err = AnalysisConfig.get(MemberConfig);
+      CHECK_ERROR_ABORT(Err, "AnalysisMember: error reading Config for {}",
+                        MemberName);
+
+      bool Enabled = false;
+      Err          = MemberConfig.get("Enabled", Enabled);
+      CHECK_ERROR_ABORT(Err, "AnalysisMember: Enabled not found for {}",
+                        MemberName);
+      if (!Enabled)
+         continue;
+
+      // The type defaults to the member name
+      std::string TypeStr = MemberName;
+      if (MemberConfig.existsVar("Type")) {
+         Err = MemberConfig.get("Type", TypeStr);
+         CHECK_ERROR_ABORT(Err, "AnalysisMember: error reading Type for {}",
+                           MemberName);
+      }
+      AnalysisType MemberType = getAnalysisTypeFromStr(TypeStr);
+      if (MemberType == AnalysisType::Invalid)
+         ABORT_ERROR("AnalysisMember: Type should be one of 'GlobalStats', "
+                     "'TimeAverage', 'ZonalMean' or 'SurfaceFields' but got "
+                     "{} for member {}",
+                     TypeStr, MemberName);
+
+      create(MemberName, MemberType, MemberConfig, ModelClock);
+   }
+
+   LOG_INFO("AnalysisMember: {} analysis members enabled", AllMembers.size());
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Create an analysis member of a given type and attach its alarm
+AnalysisMember *AnalysisMember::create(const std::string &InName,
+                                       AnalysisType InType,
+                                       Config &MemberConfig,
+                                       Clock *ModelClock) {
+
+   // Check for duplicates
+   if (AllMembers.find(InName) != AllMembers.end()) {
+      LOG_ERROR("Attempted to create a new AnalysisMember with name {} but "
+                "it already exists",
+                InName);
+      return nullptr;
+   }
+
+   // Read the compute interval, using the same units as the IO streams
+   I4 ComputeFreq = 0;
+   std::string ComputeUnitStr;
+   Error Err = MemberConfig.get("ComputeFreq", ComputeFreq);
+   Err += MemberConfig.get("ComputeFreqUnits", ComputeUnitStr);
+   CHECK_ERROR_ABORT(Err,
+                     "AnalysisMember: ComputeFreq or ComputeFreqUnits not "
+                     "found for {}",
+                     InName);
+   TimeUnits ComputeUnits = TimeUnitsFromString(ComputeUnitStr);
+   if (ComputeFreq < 1 or ComputeUnits == TimeUnits::None)
+      ABORT_ERROR("AnalysisMember: invalid compute frequency {} {} for {}",
+                  ComputeFreq, ComputeUnitStr, InName);
+
+   AnalysisMember *NewMember;
+
+   switch (InType) {
+   case AnalysisType::GlobalStats:
+      NewMember = new GlobalStats(InName, MemberConfig);
+      break;
+   case AnalysisType::TimeAverage:
+      NewMember = new TimeAverage(InName, MemberConfig, ModelClock);
+      break;
+   case AnalysisType::ZonalMean:
+      NewMember = new ZonalMean(InName, MemberConfig);
+      break;
+   case AnalysisType::SurfaceFields:
+      NewMember = new SurfaceFields(InName, MemberConfig);
+      break;
+   case AnalysisType::Invalid:
+      ABORT_ERROR("Invalid analysis member type");
+   default:
+      ABORT_ERROR("Unknown analysis member type");
+   }
+
+   // The alarm is a member of the instance so its address is fixed
+   TimeInterval ComputeInt(ComputeFreq, ComputeUnits);
+   NewMember->ComputeAlarm =
+       Alarm(InName, ComputeInt, ModelClock->getStartTime());
+   ModelClock->attachAlarm(&(NewMember->ComputeAlarm));
+
+   AllMembers.emplace(InName, NewMember);
+
+   return NewMember;
+}
+
+//------------------------------------------------------------------------------
+// Compute all members with a ringing alarm
+void AnalysisMember::computeAll(OceanState *State, int TimeLevel,
+                                Clock *ModelClock) {
+
+   if (AllMembers.empty())
+      return;
+
+   Timing::start("analysis");
+
+   TimeInstant CurTime = ModelClock->getCurrentTime();
+   for (auto &[MemberName, Member] : AllMembers) {
+      if (Member->ComputeAlarm.isRinging()) {
+         Member->compute(State, TimeLevel);
+         Member->ComputeAlarm.reset(CurTime);
+      }
+      Member->checkAlarms(CurTime);
+   }
+
+   Timing::stop("analysis");
+
+} // end computeAll
+
+//------------------------------------------------------------------------------
+// Remove analysis member by name
+void AnalysisMember::erase(const std::string &Name) { AllMembers.erase(Name); }
+
+//------------------------------------------------------------------------------
+// Remove all analysis members
+void AnalysisMember::clear() { AllMembers.clear(); }
+
+//------------------------------------------------------------------------------
+// Get analysis member by name
+AnalysisMember *AnalysisMember::get(const std::string &Name) {
+
+   auto It = AllMembers.find(Name);
+   if (It == AllMembers.end()) {
+      LOG_ERROR("AnalysisMember::get: Attempt to retrieve non-existent "
+                "analysis member {}",
+                Name);
+      return nullptr;
+   }
+
+   return It->second.get();
+}
+
+//------------------------------------------------------------------------------
+// Get the number of defined members
+I4 AnalysisMember::getNumMembers() { return AllMembers.size(); }
+
+//------------------------------------------------------------------------------
+// Get name of analysis member
+std::string AnalysisMember::getName() const { return Name; }
+
+//------------------------------------------------------------------------------
+// Get analysis member type
+AnalysisType AnalysisMember::getType() const { return Type; }
+
+//------------------------------------------------------------------------------
+// Get the names of the product fields
+const std::vector<std::string> &AnalysisMember::getProductNames() const {
+   return ProductNames;
+}
+
+//------------------------------------------------------------------------------
+// Create a product field that inherits the units and valid range of its
+// source field and add it to the group of the member
+std::shared_ptr<Field>
+AnalysisMember::createProduct(const std::string &ProductName,
+                              const std::string &SourceName,
+                              const std::string &Description,
+                              const std::vector<std::string> &DimNames) {
+
+   if (Field::exists(ProductName))
+      ABORT_ERROR("AnalysisMember {}: product field {} already exists", Name,
+                  ProductName);
+
+   std::string Units;
+   std::any ValidMin = 0.0;
+   std::any ValidMax = 0.0;
+   std::any Fill     = 0.0;
+   if (!SourceName.empty()) {
+      std::shared_ptr<Field> SrcField = Field::get(SourceName);
+      std::shared_ptr<Metadata> Meta  = SrcField->getAllMetadata();
+      SrcField->getMetadata("units", Units);
+      ValidMin = (*Meta)["valid_min"];
+      ValidMax = (*Meta)["valid_max"];
+      Fill     = (*Meta)["_FillValue"];
+   }
+
+   auto Product =
+       Field::create(ProductName, Description, Units, "", ValidMin, ValidMax,
+                     Fill, DimNames.size(), DimNames);
+
+   I4 Err = FieldGroup::addFieldToGroup(ProductName, Name);
+   if (Err != 0)
+      ABORT_ERROR("AnalysisMember: error adding {} to field group {}",
+                  ProductName, Name);
+   ProductNames.push_back(ProductName);
+
+   return Product;
+}
+
+//------------------------------------------------------------------------------
+// Check that a source field can be analyzed
+void AnalysisMember::checkSourceField(const std::string &FieldName,
+                                      I4 NDims) const {
+
+   if (!Field::exists(FieldName))
+      ABORT_ERROR("AnalysisMember {}: field {} does not exist", Name,
+                  FieldName);
+
+   std::shared_ptr<Field> SrcField = Field::get(FieldName);
+   ArrayMemLoc MemLoc              = SrcField->getMemoryLocation();
+   const ArrayDataType RealType =
+       std::is_same_v<Real, R4> ? ArrayDataType::R4 : ArrayDataType::R8;
+   if (SrcField->getType() != RealType)
+      ABORT_ERROR("AnalysisMember {}: field {} is not of type Real", Name,
+                  FieldName);
+   if (MemLoc != ArrayMemLoc::Device and MemLoc != ArrayMemLoc::Both)
+      ABORT_ERROR("AnalysisMember {}: field {} is not on the device", Name,
+                  FieldName);
+   if (SrcField->getNumDims() != NDims)
+      ABORT_ERROR("AnalysisMember {}: field {} must have {} dimensions", Name,
+                  FieldName, NDims);
+
+   std::vector<std::string> DimNames(NDims);
+   SrcField->getDimNames(DimNames);
+   if (DimNames[0] != "NCells" and DimNames[0] != "NEdges")
+      ABORT_ERROR("AnalysisMember {}: field {} must be on cells or edges",
+                  Name, FieldName);
+}
+
+//------------------------------------------------------------------------------
+// Check whether the first dimension of a field is cells
+bool AnalysisMember::isCellField(const std::string &FieldName) {
+
+   std::shared_ptr<Field> SrcField = Field::get(FieldName);
+   std::vector<std::string> DimNames(SrcField->getNumDims());
+   SrcField->getDimNames(DimNames);
+
+   return DimNames[0] == "NCells";
+}
+
+//------------------------------------------------------------------------------
+// Get the number of owned entries of a cell or edge field
+I4 AnalysisMember::getNOwned(const std::string &FieldName) const {
+   return isCellField(FieldName) ? Mesh->NCellsOwned : Mesh->NEdgesOwned;
+}
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
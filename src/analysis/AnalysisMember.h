@@ -0,0 +1,221 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_ANALYSISMEMBER_H
+#define OMEGA_ANALYSISMEMBER_H
+//===-- analysis/AnalysisMember.h - in-situ analysis ------------*- C++ -*-===//
+//
+/// \file
+/// \brief Contains the base class for all Omega in-situ analysis members
+///
+/// An analysis member computes a reduced product of the model fields on the
+/// device while the model runs, so that only the product rather than the full
+/// fields needs to be written. Each member computes at the times of its own
+/// alarm on the model clock and stores its products in Fields that are added
+/// to a FieldGroup with the name of the member, so they can be written by any
+/// IOStream that lists the group in its Contents. Members are defined in the
+/// optional Analysis group of the Omega Config, with one subgroup per member:
+/// \ConfigInput
+/// Analysis:
+///    # The subgroup name is the name of the member, which is appended to
+///    # the names of the products and used as the name of the field group
+///    GlobalStats:
+///       # Type of member. Supported options are GlobalStats, TimeAverage,
+///       # ZonalMean and SurfaceFields. Defaults to the member name.
+///       Type: GlobalStats
+///       # Members are skipped unless enabled
+///       Enabled: false
+///       # Interval between computations in any time units
+///       ComputeFreq: 1
+///       ComputeFreqUnits: days
+///    TimeMean:
+///       Type: TimeAverage
+///       Enabled: false
+///       ComputeFreq: 1
+///       ComputeFreqUnits: hours
+///       # The means start over after each reset interval. The means are
+///       # over the full run if absent.
+///       ResetFreq: 1
+///       ResetFreqUnits: months
+///       # Fields to average. TimeAverage, ZonalMean and SurfaceFields
+///       # accept 2D real fields on cells or edges and levels, and TimeAverage
+///       # also accepts 1D real fields on cells or edges.
+///       Fields: [LayerThickness, Temperature, Salinity]
+///    ZonalMean:
+///       Type: ZonalMean
+///       Enabled: false
+///       ComputeFreq: 1
+///       ComputeFreqUnits: days
+///       # Number of equal latitude bins between the poles
+///       NLatBins: 180
+///       Fields: [Temperature, Salinity]
+///    Surface:
+///       Type: SurfaceFields
+///       Enabled: false
+///       ComputeFreq: 1
+///       ComputeFreqUnits: days
+///       Fields: [Temperature, Salinity, NormalVelocity]
+/// \EndConfigInput
+//
+//===----------------------------------------------------------------------===//
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "OceanState.h"
+#include "TimeMgr.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// An enum for every analysis member type
+/// needs to be extended every time a new analysis member is added
+enum class AnalysisType {
+   GlobalStats,   ///< global volume, tracer content and extrema
+   TimeAverage,   ///< running time means of fields
+   ZonalMean,     ///< area-weighted means in latitude bins
+   SurfaceFields, ///< top-level slices of 3D fields
+   Invalid
+};
+
+//------------------------------------------------------------------------------
+// Utility routine
+/// Translate string for analysis member type into enum
+AnalysisType getAnalysisTypeFromStr(
+    const std::string &InString ///< [in] choice of analysis member type
+);
+
+//------------------------------------------------------------------------------
+/// A base class for Omega in-situ analysis members
+///
+/// The AnalysisMember class defines the interface of an analysis member,
+/// manages the members and their compute alarms and contains common routines
+/// for checking the fields that members operate on
+class AnalysisMember {
+ public:
+   virtual ~AnalysisMember() = default;
+
+   /// The main method that every analysis member needs to define. Computes
+   /// the products of the member from the state at the input time level.
+   virtual void compute(OceanState *State, ///< [in] model state
+                        int TimeLevel      ///< [in] time level to analyze
+                        ) = 0;
+
+   /// Creates all enabled members from the optional Analysis group of the
+   /// Omega Config. Must be called after all the fields the members use
+   /// have been defined and before the streams are validated.
+   static void init(Clock *ModelClock ///< [in] the model clock
+   );
+
+   /// Creates an analysis member of the input type from its Config group
+   static AnalysisMember *
+   create(const std::string &InName, ///< [in] name of member
+          AnalysisType InType,       ///< [in] type of member
+          Config &MemberConfig,      ///< [in] Config group of member
+          Clock *ModelClock          ///< [in] model clock for the alarms
+   );
+
+   /// Calls compute for every member whose alarm is ringing and resets the
+   /// alarm, then lets every member check its other alarms. Called once per
+   /// time step after the state has been updated and before the streams are
+   /// written.
+   static void computeAll(OceanState *State, ///< [in] model state
+                          int TimeLevel,     ///< [in] time level to analyze
+                          Clock *ModelClock  ///< [in] model clock
+   );
+
+   // Delete/destroy functions
+   /// Remove analysis member by name
+   static void erase(const std::string &Name ///< [in] name of member
+   );
+
+   /// Remove all analysis members
+   static void clear();
+
+   // Retrieval functions
+   /// Get analysis member by name
+   static AnalysisMember *get(const std::string &Name ///< [in] name of member
+   );
+
+   /// Get the number of defined analysis members
+   static I4 getNumMembers();
+
+   /// Get name of analysis member from instance
+   std::string getName() const;
+
+   /// Get type (enum) of analysis member from instance
+   AnalysisType getType() const;
+
+   /// Get the names of the fields computed by this member
+   const std::vector<std::string> &getProductNames() const;
+
+ protected:
+   /// Name of analysis member, also used for its field group
+   std::string Name;
+
+   /// Type of analysis member
+   AnalysisType Type;
+
+   /// Alarm that rings at the times to compute
+   Alarm ComputeAlarm;
+
+   /// Names of the fields computed by this member
+   std::vector<std::string> ProductNames;
+
+   /// Pointer to the mesh
+   HorzMesh *Mesh;
+
+   /// Constructor creates the field group of the member
+   AnalysisMember(const std::string &InName, ///< [in] name of member
+                  AnalysisType InType        ///< [in] type of member
+   );
+
+   /// Creates a product field with the metadata of an existing field, adds
+   /// it to the field group of the member and returns it
+   std::shared_ptr<Field>
+   createProduct(const std::string &ProductName, ///< [in] product name
+                 const std::string &SourceName,  ///< [in] source field name
+                 const std::string &Description, ///< [in] long name
+                 const std::vector<std::string> &DimNames ///< [in] dims
+   );
+
+   /// Checks alarms of the member other than the compute alarm. Called by
+   /// computeAll every step, after compute if the compute alarm rang, so an
+   /// alarm is handled at its own time even if the member does not compute
+   /// at that step. Does nothing unless overridden.
+   virtual void checkAlarms(const TimeInstant &CurTime ///< [in] current time
+   ) {}
+
+   /// Checks that a field exists and is a device array of type Real with the
+   /// input number of dimensions and a first dimension of cells or edges,
+   /// since the members read the source data as Real arrays. Aborts with an
+   /// error message otherwise.
+   void checkSourceField(const std::string &FieldName, ///< [in] field name
+                         I4 NDims ///< [in] allowed number of dims (1 or 2)
+   ) const;
+
+   /// Returns true if the first dimension of a field is NCells
+   static bool isCellField(const std::string &FieldName ///< [in] field name
+   );
+
+   /// Returns the number of owned cells or edges of a field
+   I4 getNOwned(const std::string &FieldName ///< [in] field name
+   ) const;
+
+   // Disable copy constructor
+   AnalysisMember(const AnalysisMember &) = delete;
+   AnalysisMember(AnalysisMember &&)      = delete;
+
+ private:
+   /// All defined analysis members
+   static std::map<std::string, std::unique_ptr<AnalysisMember>> AllMembers;
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,161 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- analysis/GlobalStats.cpp - global statistics member -----*- C++ -*-===//
+//
+// The batch of reductions is rebuilt at each computation since the state and
+// tracer arrays of a time level change when the time levels are swapped.
+// Empty layers (zero thickness) are excluded from the tracer extrema.
+//
+//===----------------------------------------------------------------------===//
+
+#include "GlobalStats.h"
+#include "Error.h"
+#include "Field.h"
+#include "Logging.h"
+#include "Reductions.h"
+#include "Tracers.h"
+
+namespace OMEGA {
+
+// Value that no tracer or thickness reaches, used to exclude empty layers
+// from the extrema
+constexpr R8 ExcludedVal = 1.0e30;
+
+//------------------------------------------------------------------------------
+// Constructor creates a scalar field for each statistic
+GlobalStats::GlobalStats(const std::string &InName, Config &MemberConfig)
+    : AnalysisMember(InName, AnalysisType::GlobalStats) {
+
+   addScalar(Name + "Volume", "", "total ocean volume", "m3");
+   addScalar(Name + "MinThickness", "LayerThickness",
+             "minimum layer thickness", "");
+   addScalar(Name + "MaxThickness", "LayerThickness",
+             "maximum layer thickness", "");
+   addScalar(Name + "MaxSpeed", "NormalVelocity",
+             "maximum magnitude of normal velocity", "");
+
+   NTracers = Tracers::getNumTracers();
+   for (int L = 0; L < NTracers; ++L) {
+      std::string TracerName;
+      Tracers::getName(TracerName, L);
+      addScalar(TracerName + Name + "Mean", TracerName,
+                "volume-weighted global mean of " + TracerName, "");
+      addScalar(TracerName + Name + "Min", TracerName,
+                "global minimum of " + TracerName, "");
+      addScalar(TracerName + Name + "Max", TracerName,
+                "global maximum of " + TracerName, "");
+   }
+}
+
+//------------------------------------------------------------------------------
+// Create a scalar field with host storage of size one
+void GlobalStats::addScalar(const std::string &ProductName,
+                            const std::string &SourceName,
+                            const std::string &Description,
+                            const std::string &Units) {
+
+   std::vector<std::string> NoDims;
+   auto Product = createProduct(ProductName, SourceName, Description, NoDims);
+   if (!Units.empty())
+      Product->updateMetadata("units", Units);
+
+   HostArray1DReal Value(ProductName, 1);
+   Value(0) = 0;
+   Product->attachData<HostArray1DReal>(Value);
+   Values.push_back(Value);
+}
+
+//------------------------------------------------------------------------------
+// Compute all statistics
+void GlobalStats::compute(OceanState *State, int TimeLevel) {
+
+   Array2DReal LayerThick;
+   Array2DReal NormalVel;
+   Array3DReal TracerArray;
+   I4 Err = State->getLayerThickness(LayerThick, TimeLevel);
+   Err += State->getNormalVelocity(NormalVel, TimeLevel);
+   Err += Tracers::getAll(TracerArray, TimeLevel);
+   if (Err != 0)
+      ABORT_ERROR("GlobalStats {}: error retrieving state or tracers", Name);
+
+   const I4 NVertLevels = LayerThick.extent_int(1);
+   const auto &AreaCell = Mesh->AreaCell;
+   const auto &EdgeMask = Mesh->EdgeMask;
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+   const I4 NEdgesOwned = Mesh->NEdgesOwned;
+   ReductionBatch Batch;
+
+   // Handles follow the order of the products
+   std::vector<I4> Handles;
+   Handles.push_back(Batch.addSum(LayerThick, AreaCell, NCellsOwned));
+   Handles.push_back(Batch.addMin(
+       "globalStatsMinThick", NCellsOwned, NVertLevels,
+       KOKKOS_LAMBDA(int ICell, int K) {
+          return LayerThick(ICell, K) > 0 ? R8(LayerThick(ICell, K))
+                                          : ExcludedVal;
+       }));
+   Handles.push_back(Batch.addMax(LayerThick, NCellsOwned));
+   Handles.push_back(Batch.addMax(
+       "globalStatsMaxSpeed", NEdgesOwned, NVertLevels,
+       KOKKOS_LAMBDA(int IEdge, int K) {
+          return R8(EdgeMask(IEdge, K) * Kokkos::fabs(NormalVel(IEdge, K)));
+       }));
+
+   for (int L = 0; L < NTracers; ++L) {
+      Handles.push_back(Batch.addSum(
+          "globalStatsTracerContent", NCellsOwned, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             return R8(TracerArray(L, ICell, K)) * LayerThick(ICell, K) *
+                    AreaCell(ICell);
+          }));
+      Handles.push_back(Batch.addMin(
+          "globalStatsTracerMin", NCellsOwned, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             return LayerThick(ICell, K) > 0 ? R8(TracerArray(L, ICell, K))
+                                             : ExcludedVal;
+          }));
+      Handles.push_back(Batch.addMax(
+          "globalStatsTracerMax", NCellsOwned, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             return LayerThick(ICell, K) > 0 ? R8(TracerArray(L, ICell, K))
+                                             : -ExcludedVal;
+          }));
+   }
+
+   Err = Batch.reduce();
+   if (Err != 0)
+      ABORT_ERROR("GlobalStats {}: error in global reductions", Name);
+
+   for (int N = 0; N < Handles.size(); ++N)
+      Values[N](0) = Batch.getResult(Handles[N]);
+
+   // Tracer content is divided by the volume to give the mean
+   const R8 Volume = Values[0](0);
+   for (int L = 0; L < NTracers; ++L) {
+      HostArray1DReal &Mean = Values[4 + 3 * L];
+      Mean(0)               = Volume > 0 ? Mean(0) / Volume : 0;
+   }
+
+   LOG_INFO("GlobalStats {}: volume {:.10e} m3, max speed {:.6e}", Name,
+            Volume, Values[3](0));
+
+} // end compute
+
+//------------------------------------------------------------------------------
+// Get the value of a statistic by product name
+R8 GlobalStats::getValue(const std::string &ProductName) const {
+
+   for (int N = 0; N < ProductNames.size(); ++N) {
+      if (ProductNames[N] == ProductName)
+         return Values[N](0);
+   }
+
+   LOG_ERROR("GlobalStats {}: no statistic named {}", Name, ProductName);
+   return 0;
+}
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
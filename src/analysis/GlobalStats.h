@@ -0,0 +1,61 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_GLOBALSTATS_H
+#define OMEGA_GLOBALSTATS_H
+//===-- analysis/GlobalStats.h - global statistics member -------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the global statistics analysis member
+///
+/// The GlobalStats member computes the total ocean volume, the range of layer
+/// thickness, the maximum speed and the volume-weighted mean, minimum and
+/// maximum of every tracer. All reductions of a computation are combined into
+/// a single ReductionBatch so that only one message per reduction kind is
+/// sent, and the sums use the reproducible fixed-point method so that the
+/// statistics do not depend on the number of tasks. Each statistic is a
+/// scalar Field named with the statistic and the member name, for example
+/// GlobalStatsVolume and TemperatureGlobalStatsMean.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisMember.h"
+
+namespace OMEGA {
+
+/// An analysis member for global statistics
+class GlobalStats : public AnalysisMember {
+ public:
+   /// Constructor creates the scalar product fields
+   GlobalStats(const std::string &InName, ///< [in] name of member
+               Config &MemberConfig       ///< [in] Config group of member
+   );
+
+   /// Computes all statistics in one batch of global reductions
+   void compute(OceanState *State, ///< [in] model state
+                int TimeLevel      ///< [in] time level to analyze
+                ) override;
+
+   /// Returns the value of a statistic from the last computation
+   R8 getValue(const std::string &ProductName ///< [in] product field name
+   ) const;
+
+ private:
+   /// Number of tracers in the statistics
+   I4 NTracers;
+
+   /// Host storage of each scalar product, in the order of ProductNames
+   std::vector<HostArray1DReal> Values;
+
+   /// Adds a scalar product field and its host storage
+   void addScalar(const std::string &ProductName, ///< [in] product name
+                  const std::string &SourceName,  ///< [in] source field name
+                  const std::string &Description, ///< [in] long name
+                  const std::string &Units        ///< [in] units if not source
+   );
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,60 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- analysis/SurfaceFields.cpp - surface fields member ------*- C++ -*-===//
+//
+// The source arrays are retrieved at each computation since the state and
+// tracer fields are attached to a new array when the time levels are swapped.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SurfaceFields.h"
+#include "Error.h"
+#include "Field.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Constructor creates a 1D field for each source field
+SurfaceFields::SurfaceFields(const std::string &InName, Config &MemberConfig)
+    : AnalysisMember(InName, AnalysisType::SurfaceFields) {
+
+   Error Err = MemberConfig.get("Fields", SourceNames);
+   CHECK_ERROR_ABORT(Err, "SurfaceFields {}: Fields not found in Config",
+                     Name);
+
+   for (const std::string &SrcName : SourceNames) {
+      checkSourceField(SrcName, 2);
+
+      std::vector<std::string> DimNames(2);
+      Field::get(SrcName)->getDimNames(DimNames);
+      std::vector<std::string> SurfaceDims{DimNames[0]};
+      auto Product = createProduct(SrcName + Name, SrcName,
+                                   "surface value of " + SrcName, SurfaceDims);
+
+      auto Src = Field::getFieldDataArray<Array2DReal>(SrcName);
+      Array1DReal Surface(SrcName + Name, Src.extent(0));
+      Product->attachData<Array1DReal>(Surface);
+      Surfaces.push_back(Surface);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Copy the top level of each field
+void SurfaceFields::compute(OceanState *State, int TimeLevel) {
+
+   for (int N = 0; N < SourceNames.size(); ++N) {
+      const auto &Surface = Surfaces[N];
+      auto Src = Field::getFieldDataArray<Array2DReal>(SourceNames[N]);
+      parallelFor(
+          "surfaceFields", {Surface.extent_int(0)},
+          KOKKOS_LAMBDA(int I) { Surface(I) = Src(I, 0); });
+   }
+
+} // end compute
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,48 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_SURFACEFIELDS_H
+#define OMEGA_SURFACEFIELDS_H
+//===-- analysis/SurfaceFields.h - surface fields member --------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the surface fields analysis member
+///
+/// The SurfaceFields member copies the top level of a list of fields on cells
+/// or edges and levels into 1D fields, so that surface maps can be written
+/// at high frequency without writing the full 3D fields. The surface fields
+/// are device arrays on the same cells or edges as their fields and are
+/// named with the field name and the member name, for example
+/// TemperatureSurface.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisMember.h"
+
+namespace OMEGA {
+
+/// An analysis member for the top level of 3D fields
+class SurfaceFields : public AnalysisMember {
+ public:
+   /// Constructor creates the surface fields
+   SurfaceFields(const std::string &InName, ///< [in] name of member
+                 Config &MemberConfig       ///< [in] Config group of member
+   );
+
+   /// Copies the top level of each field
+   void compute(OceanState *State, ///< [in] model state
+                int TimeLevel      ///< [in] time level to analyze
+                ) override;
+
+ private:
+   /// Names of the source fields
+   std::vector<std::string> SourceNames;
+
+   /// Surface values of each field, attached to the product fields
+   std::vector<Array1DReal> Surfaces;
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,143 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- analysis/TimeAverage.cpp - time average member ----------*- C++ -*-===//
+//
+// The source arrays are retrieved from their fields at each computation since
+// the state and tracer fields are attached to a new array when the time
+// levels are swapped.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TimeAverage.h"
+#include "Error.h"
+#include "Field.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Constructor creates a mean field for each source field
+TimeAverage::TimeAverage(const std::string &InName, Config &MemberConfig,
+                         Clock *InClock)
+    : AnalysisMember(InName, AnalysisType::TimeAverage) {
+
+   Error Err = MemberConfig.get("Fields", SourceNames);
+   CHECK_ERROR_ABORT(Err, "TimeAverage {}: Fields not found in Config", Name);
+
+   for (const std::string &SrcName : SourceNames) {
+
+      if (!Field::exists(SrcName))
+         ABORT_ERROR("TimeAverage {}: field {} does not exist", Name,
+                     SrcName);
+      I4 NDims = Field::get(SrcName)->getNumDims();
+      if (NDims != 1 and NDims != 2)
+         ABORT_ERROR("TimeAverage {}: field {} must have 1 or 2 dimensions",
+                     Name, SrcName);
+      checkSourceField(SrcName, NDims);
+
+      std::vector<std::string> DimNames(NDims);
+      Field::get(SrcName)->getDimNames(DimNames);
+      auto Product = createProduct(SrcName + Name, SrcName,
+                                   "time mean of " + SrcName, DimNames);
+
+      if (NDims == 1) {
+         auto Src = Field::getFieldDataArray<Array1DReal>(SrcName);
+         Array1DReal Mean(SrcName + Name, Src.extent(0));
+         Product->attachData<Array1DReal>(Mean);
+         Means1D.push_back(Mean);
+         Means2D.push_back(Array2DReal());
+      } else {
+         auto Src = Field::getFieldDataArray<Array2DReal>(SrcName);
+         Array2DReal Mean(SrcName + Name, Src.extent(0), Src.extent(1));
+         Product->attachData<Array2DReal>(Mean);
+         Means1D.push_back(Array1DReal());
+         Means2D.push_back(Mean);
+      }
+   }
+
+   // The number of samples is written with the means
+   std::vector<std::string> NoDims;
+   auto SampleField = createProduct(Name + "NSamples", "",
+                                    "number of samples in time means", NoDims);
+   NSamples         = HostArray1DI4(Name + "NSamples", 1);
+   NSamples(0)      = 0;
+   SampleField->attachData<HostArray1DI4>(NSamples);
+
+   // Optional reset interval, otherwise the means are over the full run
+   if (MemberConfig.existsVar("ResetFreq")) {
+      I4 ResetFreq = 0;
+      std::string ResetUnitStr;
+      Err += MemberConfig.get("ResetFreq", ResetFreq);
+      Err += MemberConfig.get("ResetFreqUnits", ResetUnitStr);
+      CHECK_ERROR_ABORT(Err, "TimeAverage {}: error reading ResetFreq or "
+                             "ResetFreqUnits",
+                        Name);
+      TimeUnits ResetUnits = TimeUnitsFromString(ResetUnitStr);
+      if (ResetFreq < 1 or ResetUnits == TimeUnits::None)
+         ABORT_ERROR("TimeAverage {}: invalid reset frequency {} {}", Name,
+                     ResetFreq, ResetUnitStr);
+
+      TimeInterval ResetInt(ResetFreq, ResetUnits);
+      ResetAlarm = Alarm(Name + "Reset", ResetInt, InClock->getStartTime());
+      InClock->attachAlarm(&ResetAlarm);
+      HasReset = true;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Update the running means in place
+void TimeAverage::compute(OceanState *State, int TimeLevel) {
+
+   // With a count of one the update sets the mean to the sample, so a reset
+   // only needs to restart the count
+   if (ResetPending) {
+      NSamples(0)  = 0;
+      ResetPending = false;
+   }
+   ++NSamples(0);
+   const Real Weight = 1.0 / NSamples(0);
+
+   for (int N = 0; N < SourceNames.size(); ++N) {
+      const std::string &SrcName = SourceNames[N];
+      if (Means2D[N].size() > 0) {
+         auto Src         = Field::getFieldDataArray<Array2DReal>(SrcName);
+         const auto &Mean = Means2D[N];
+         parallelFor(
+             "timeAverage2D", {Mean.extent_int(0), Mean.extent_int(1)},
+             KOKKOS_LAMBDA(int I, int K) {
+                Mean(I, K) += Weight * (Src(I, K) - Mean(I, K));
+             });
+      } else {
+         auto Src         = Field::getFieldDataArray<Array1DReal>(SrcName);
+         const auto &Mean = Means1D[N];
+         parallelFor(
+             "timeAverage1D", {Mean.extent_int(0)},
+             KOKKOS_LAMBDA(int I) { Mean(I) += Weight * (Src(I) - Mean(I)); });
+      }
+   }
+
+} // end compute
+
+//------------------------------------------------------------------------------
+// Start new means with the next sample when the reset alarm rings. This is
+// checked every step after compute, so the means written at the reset time
+// hold the full interval and a reset time between samples is not missed.
+void TimeAverage::checkAlarms(const TimeInstant &CurTime) {
+
+   if (HasReset and ResetAlarm.isRinging()) {
+      ResetPending = true;
+      ResetAlarm.reset(CurTime);
+   }
+
+} // end checkAlarms
+
+//------------------------------------------------------------------------------
+// Get the number of samples in the current means
+I4 TimeAverage::getNumSamples() const { return NSamples(0); }
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
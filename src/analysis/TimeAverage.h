@@ -0,0 +1,70 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_TIMEAVERAGE_H
+#define OMEGA_TIMEAVERAGE_H
+//===-- analysis/TimeAverage.h - time average member ------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the time average analysis member
+///
+/// The TimeAverage member accumulates running means of a list of fields in
+/// place on the device. At each computation the mean of every field is
+/// updated as Mean += (X - Mean) / N with N the number of samples, so no
+/// separate sum array is needed and the mean can be written at any time.
+/// The means are on the same cells or edges and levels as their fields and
+/// are named with the field name and the member name, for example
+/// TemperatureTimeMean. The number of samples is the scalar Field
+/// <member>NSamples. If a reset interval is given, the means start over
+/// with the first sample after each reset time, so a mean written at the
+/// reset time holds all the samples of the interval that ends there.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisMember.h"
+
+namespace OMEGA {
+
+/// An analysis member for running time means
+class TimeAverage : public AnalysisMember {
+ public:
+   /// Constructor creates the mean fields and the reset alarm
+   TimeAverage(const std::string &InName, ///< [in] name of member
+               Config &MemberConfig,      ///< [in] Config group of member
+               Clock *InClock             ///< [in] model clock for the alarm
+   );
+
+   /// Adds the current fields to the running means
+   void compute(OceanState *State, ///< [in] model state
+                int TimeLevel      ///< [in] time level to analyze
+                ) override;
+
+   /// Starts new means with the next sample if the reset alarm is ringing
+   void checkAlarms(const TimeInstant &CurTime ///< [in] current time
+                    ) override;
+
+   /// Returns the number of samples in the current means
+   I4 getNumSamples() const;
+
+ private:
+   /// Names of the averaged fields
+   std::vector<std::string> SourceNames;
+
+   /// Running means of the 1D and 2D fields in the order of SourceNames,
+   /// with an empty array for the rank that is not used
+   std::vector<Array1DReal> Means1D;
+   std::vector<Array2DReal> Means2D;
+
+   /// Number of samples in the means, attached as a scalar field
+   HostArray1DI4 NSamples;
+
+   /// Alarm that rings at the end of each averaging interval
+   Alarm ResetAlarm;
+   bool HasReset     = false; ///< a reset interval is set
+   bool ResetPending = false; ///< the next sample starts new means
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,170 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- analysis/ZonalMean.cpp - zonal mean member --------------*- C++ -*-===//
+//
+// The bin sums are accumulated with atomic adds, since many cells of a task
+// fall in the same bin. The sums are not reproducible across task counts in
+// the last bits, which is acceptable for a diagnostic product.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ZonalMean.h"
+#include "Dimension.h"
+#include "Error.h"
+#include "Field.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "ScratchPool.h"
+
+#include <cmath>
+#include <typeinfo>
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Constructor assigns each cell to a bin and creates the mean fields
+ZonalMean::ZonalMean(const std::string &InName, Config &MemberConfig)
+    : AnalysisMember(InName, AnalysisType::ZonalMean) {
+
+   Error Err = MemberConfig.get("NLatBins", NLatBins);
+   Err += MemberConfig.get("Fields", SourceNames);
+   CHECK_ERROR_ABORT(Err, "ZonalMean {}: NLatBins or Fields not found", Name);
+   if (NLatBins < 1)
+      ABORT_ERROR("ZonalMean {}: NLatBins must be positive, got {}", Name,
+                  NLatBins);
+
+   NVertLevels          = Mesh->NVertLevels;
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+
+   // Bins are of equal width in latitude from the south pole
+   const auto &LatCell = Mesh->LatCell;
+   const R8 Pi         = 4.0 * std::atan(1.0);
+   const R8 BinWidth   = Pi / NLatBins;
+   const I4 LocNBins   = NLatBins;
+   BinOnCell           = Array1DI4("ZonalMeanBinOnCell", NCellsOwned);
+   const auto &Bin     = BinOnCell;
+   parallelFor(
+       "zonalMeanBins", {NCellsOwned}, KOKKOS_LAMBDA(int ICell) {
+          I4 IBin    = I4((LatCell(ICell) + 0.5 * Pi) / BinWidth);
+          Bin(ICell) = Kokkos::clamp(IBin, 0, LocNBins - 1);
+       });
+
+   // A cell is ocean at a level if any of its edges is
+   const auto &EdgesOnCell  = Mesh->EdgesOnCell;
+   const auto &NEdgesOnCell = Mesh->NEdgesOnCell;
+   const auto &EdgeMask     = Mesh->EdgeMask;
+   CellWeight = Array2DReal("ZonalMeanCellWeight", NCellsOwned, NVertLevels);
+   const auto &Weight = CellWeight;
+   parallelFor(
+       "zonalMeanWeights", {NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) {
+          Real Mask = 0;
+          for (int J = 0; J < NEdgesOnCell(ICell); ++J)
+             Mask = Kokkos::max(Mask, EdgeMask(EdgesOnCell(ICell, J), K));
+          Weight(ICell, K) = Mask;
+       });
+
+   for (const std::string &SrcName : SourceNames) {
+      checkSourceField(SrcName, 2);
+      if (!isCellField(SrcName))
+         ABORT_ERROR("ZonalMean {}: field {} must be on cells", Name,
+                     SrcName);
+   }
+
+   // The bins are a non-distributed dimension of the member
+   std::string BinDimName = "NLatBins" + Name;
+   Dimension::create(BinDimName, NLatBins);
+   std::vector<std::string> BinDims{BinDimName};
+   std::vector<std::string> MeanDims{BinDimName, "NVertLevels"};
+
+   auto LatField = createProduct(Name + "LatBins", "",
+                                 "latitude of zonal mean bin centers", BinDims);
+   LatField->updateMetadata("units", std::string("degrees_north"));
+   HostArray1DReal LatBins(Name + "LatBins", NLatBins);
+   for (int IBin = 0; IBin < NLatBins; ++IBin)
+      LatBins(IBin) = -90.0 + (IBin + 0.5) * 180.0 / NLatBins;
+   LatField->attachData<HostArray1DReal>(LatBins);
+
+   for (const std::string &SrcName : SourceNames) {
+      auto Product = createProduct(SrcName + Name, SrcName,
+                                   "zonal mean of " + SrcName, MeanDims);
+
+      std::any Fill = Field::get(SrcName)->getAllMetadata()->at("FillValue");
+      R8 FillValue  = 0;
+      if (Fill.type() == typeid(R8))
+         FillValue = std::any_cast<R8>(Fill);
+      else if (Fill.type() == typeid(R4))
+         FillValue = std::any_cast<R4>(Fill);
+      FillValues.push_back(FillValue);
+
+      HostArray2DReal Mean(SrcName + Name, NLatBins, NVertLevels);
+      Product->attachData<HostArray2DReal>(Mean);
+      Means.push_back(Mean);
+   }
+
+   // One slice of sums per field and one for the area
+   BinSums = Array3DR8("ZonalMeanBinSums", SourceNames.size() + 1, NLatBins,
+                       NVertLevels);
+}
+
+//------------------------------------------------------------------------------
+// Compute the zonal means of all fields
+void ZonalMean::compute(OceanState *State, int TimeLevel) {
+
+   const I4 NFields     = SourceNames.size();
+   const I4 NCellsOwned = Mesh->NCellsOwned;
+   const auto &AreaCell = Mesh->AreaCell;
+   const auto &Bin      = BinOnCell;
+   const auto &Weight   = CellWeight;
+   const auto &Sums     = BinSums;
+   deepCopy(Sums, 0);
+
+   // The ocean area of each bin and level is summed with the fields
+   parallelFor(
+       "zonalMeanArea", {NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) {
+          Kokkos::atomic_add(&Sums(NFields, Bin(ICell), K),
+                             R8(AreaCell(ICell) * Weight(ICell, K)));
+       });
+
+   for (int N = 0; N < NFields; ++N) {
+      auto Src = Field::getFieldDataArray<Array2DReal>(SourceNames[N]);
+      parallelFor(
+          "zonalMeanSum", {NCellsOwned, NVertLevels},
+          KOKKOS_LAMBDA(int ICell, int K) {
+             Kokkos::atomic_add(&Sums(N, Bin(ICell), K),
+                                R8(AreaCell(ICell) * Weight(ICell, K) *
+                                   Src(ICell, K)));
+          });
+   }
+
+   // All sums are combined in a single global reduction. The host arrays
+   // are reused from the scratch pool on every call.
+   HostArray3DR8 SumsH = ScratchPool::get<HostArray3DR8>(
+       "ZonalMeanSumsH", NFields + 1, NLatBins, NVertLevels);
+   HostArray3DR8 GlobalSums = ScratchPool::get<HostArray3DR8>(
+       "ZonalMeanGlobalSums", NFields + 1, NLatBins, NVertLevels);
+   deepCopy(SumsH, Sums);
+   I4 Err = MachEnv::getDefault()->allReduceHier(
+       SumsH.data(), GlobalSums.data(), SumsH.size(), MPI_DOUBLE, MPI_SUM);
+   if (Err != 0)
+      ABORT_ERROR("ZonalMean {}: error in global sum of bins", Name);
+
+   for (int N = 0; N < NFields; ++N) {
+      for (int IBin = 0; IBin < NLatBins; ++IBin) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            const R8 Area = GlobalSums(NFields, IBin, K);
+            Means[N](IBin, K) =
+                Area > 0 ? GlobalSums(N, IBin, K) / Area : FillValues[N];
+         }
+      }
+   }
+
+} // end compute
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,72 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_ZONALMEAN_H
+#define OMEGA_ZONALMEAN_H
+//===-- analysis/ZonalMean.h - zonal mean member ----------------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the zonal mean analysis member
+///
+/// The ZonalMean member computes area-weighted means of a list of cell fields
+/// in bins of equal latitude width between the poles. Each cell is assigned
+/// to the bin of its latitude once at construction. At each computation the
+/// weighted sums of every field and level are accumulated into the bins on
+/// the device, and the sums of all fields are combined in one global sum
+/// before they are divided by the area of each bin. Land cells and the
+/// levels below the bottom of each column are excluded through the edge
+/// mask of the cell edges, so a bin and level without ocean gets the fill
+/// value of the field. The means are host arrays on the non-distributed
+/// dimensions NLatBins<member> and NVertLevels, named with the field name and
+/// the member name, for example TemperatureZonalMean. The latitude of the
+/// center of each bin is the product <member>LatBins in degrees.
+//
+//===----------------------------------------------------------------------===//
+
+#include "AnalysisMember.h"
+
+namespace OMEGA {
+
+/// An analysis member for zonal means in latitude bins
+class ZonalMean : public AnalysisMember {
+ public:
+   /// Constructor assigns the cells to bins and creates the mean fields
+   ZonalMean(const std::string &InName, ///< [in] name of member
+             Config &MemberConfig       ///< [in] Config group of member
+   );
+
+   /// Computes the zonal means of all fields
+   void compute(OceanState *State, ///< [in] model state
+                int TimeLevel      ///< [in] time level to analyze
+                ) override;
+
+ private:
+   /// Number of latitude bins
+   I4 NLatBins;
+
+   /// Number of vertical levels
+   I4 NVertLevels;
+
+   /// Names of the averaged fields
+   std::vector<std::string> SourceNames;
+
+   /// Fill value of each averaged field for empty bins
+   std::vector<R8> FillValues;
+
+   /// Bin of each owned cell
+   Array1DI4 BinOnCell;
+
+   /// Ocean fraction of each owned cell and level from the edge mask
+   Array2DReal CellWeight;
+
+   /// Device sums of all fields and the area, with the area last
+   Array3DR8 BinSums;
+
+   /// Zonal means of each field, attached to the product fields
+   std::vector<HostArray2DReal> Means;
+};
+
+} // namespace OMEGA
+#endif
@@ -26,14 +26,20 @@
 #include "IO.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryRegistry.h"
 #include "OmegaKokkos.h"
 #include "Pacer.h"
 #include "mpi.h"
 #include "parmetis.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <numeric>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace OMEGA {
@@ -58,6 +64,431 @@ bool Decomp::validVertexID(I4 InVertexID) {
    return (InVertexID > 0 && InVertexID <= NVerticesGlobal);
 }
 
+//------------------------------------------------------------------------------
+// Exchanges a variable number of values between all tasks. SendCounts is
+// the number of values sent to each task, stored contiguously in task order
+// in SendBuf. On return, RecvBuf contains the values received from all tasks
+// in task order and RecvCounts the number of values received from each task.
+// The MPI data type must match the vector type T.
+
+template <typename T>
+static int alltoallvData(MPI_Comm Comm,                     // [in] MPI comm
+                         I4 NumTasks,                       // [in] num tasks
+                         MPI_Datatype DataType,             // [in] MPI type
+                         const std::vector<T> &SendBuf,     // [in] send values
+                         const std::vector<I4> &SendCounts, // [in] num to send
+                         std::vector<T> &RecvBuf,           // [out] vals recvd
+                         std::vector<I4> &RecvCounts        // [out] num recvd
+) {
+
+   RecvCounts.assign(NumTasks, 0);
+   int Err = MPI_Alltoall(SendCounts.data(), 1, MPI_INT32_T,
+                          RecvCounts.data(), 1, MPI_INT32_T, Comm);
+   if (Err != 0)
+      return Err;
+
+   std::vector<I4> SendDispls(NumTasks, 0);
+   std::vector<I4> RecvDispls(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task) {
+      SendDispls[Task] = SendDispls[Task - 1] + SendCounts[Task - 1];
+      RecvDispls[Task] = RecvDispls[Task - 1] + RecvCounts[Task - 1];
+   }
+   RecvBuf.resize(RecvDispls[NumTasks - 1] + RecvCounts[NumTasks - 1]);
+
+   Err = MPI_Alltoallv(SendBuf.data(), SendCounts.data(), SendDispls.data(),
+                       DataType, RecvBuf.data(), RecvCounts.data(),
+                       RecvDispls.data(), DataType, Comm);
+   return Err;
+
+} // end alltoallvData
+
+//------------------------------------------------------------------------------
+// Gathers a chunk of ChunkSize values from every task of an environment onto
+// the node leaders only. The chunks are gathered on each node to its leader
+// and then exchanged among the leaders, so the global array is held once
+// per node and only the leaders take part in the inter-node exchange. On
+// return, AllData on the leaders holds the chunks in environment task order
+// and is empty on the other tasks.
+
+static int gatherOnLeaders(const MachEnv *InEnv,    // [in] machine env
+                           const I4 *Chunk,         // [in] local chunk
+                           I4 ChunkSize,            // [in] values in chunk
+                           std::vector<I4> &AllData // [out] all chunks
+) {
+
+   const I4 MyTask       = InEnv->getMyTask();
+   const I4 NumNodeTasks = InEnv->getNumNodeTasks();
+   const bool IsLeader   = InEnv->isNodeLeader();
+
+   // Gather the task IDs and chunks of the node on its leader
+   std::vector<I4> NodeTasks(IsLeader ? NumNodeTasks : 0);
+   std::vector<I4> NodeData(IsLeader ? NumNodeTasks * ChunkSize : 0);
+   int Err = MPI_Gather(&MyTask, 1, MPI_INT32_T, NodeTasks.data(), 1,
+                        MPI_INT32_T, 0, InEnv->getNodeComm());
+   if (Err != 0)
+      return Err;
+   Err = MPI_Gather(Chunk, ChunkSize, MPI_INT32_T, NodeData.data(), ChunkSize,
+                    MPI_INT32_T, 0, InEnv->getNodeComm());
+   AllData.clear();
+   if (Err != 0 or !IsLeader)
+      return Err;
+
+   // Exchange the node blocks among the leaders
+   MPI_Comm LeaderComm = InEnv->getLeaderComm();
+   const I4 NumNodes   = InEnv->getNumNodes();
+   const I4 NumTasks   = InEnv->getNumTasks();
+   std::vector<int> TaskCount(NumNodes);
+   Err = MPI_Allgather(&NumNodeTasks, 1, MPI_INT, TaskCount.data(), 1, MPI_INT,
+                       LeaderComm);
+   if (Err != 0)
+      return Err;
+
+   std::vector<int> TaskDispl(NumNodes, 0);
+   std::vector<int> DataCount(NumNodes);
+   std::vector<int> DataDispl(NumNodes);
+   for (int Node = 0; Node < NumNodes; ++Node) {
+      if (Node > 0)
+         TaskDispl[Node] = TaskDispl[Node - 1] + TaskCount[Node - 1];
+      DataCount[Node] = TaskCount[Node] * ChunkSize;
+      DataDispl[Node] = TaskDispl[Node] * ChunkSize;
+   }
+
+   std::vector<I4> AllTasks(NumTasks);
+   std::vector<I4> NodeOrder(NumTasks * ChunkSize);
+   Err = MPI_Allgatherv(NodeTasks.data(), NumNodeTasks, MPI_INT32_T,
+                        AllTasks.data(), TaskCount.data(), TaskDispl.data(),
+                        MPI_INT32_T, LeaderComm);
+   if (Err != 0)
+      return Err;
+   Err = MPI_Allgatherv(NodeData.data(), NumNodeTasks * ChunkSize,
+                        MPI_INT32_T, NodeOrder.data(), DataCount.data(),
+                        DataDispl.data(), MPI_INT32_T, LeaderComm);
+   if (Err != 0)
+      return Err;
+
+   // Put the chunks in task order, since tasks of a node need not be
+   // contiguous
+   AllData.resize(NumTasks * ChunkSize);
+   for (int I = 0; I < NumTasks; ++I)
+      std::copy(NodeOrder.begin() + I * ChunkSize,
+                NodeOrder.begin() + (I + 1) * ChunkSize,
+                AllData.begin() + AllTasks[I] * ChunkSize);
+
+   return Err;
+
+} // end gatherOnLeaders
+
+//------------------------------------------------------------------------------
+// Computes the index along a 3D Hilbert curve of a point with coordinates
+// that have been scaled to integers in the range [0, 2^NBits - 1]. This is
+// the algorithm of Skilling (2004, AIP Conf. Proc. 707), which converts the
+// coordinates to the transposed Hilbert index that is then interleaved into
+// a single integer (3*NBits must be less than 64).
+
+static I8 hilbertIndex(I4 X[3], // [in] scaled coordinates (overwritten)
+                       I4 NBits // [in] number of bits per coordinate
+) {
+
+   const I4 NDims = 3;
+   const I4 MaxQ  = 1 << (NBits - 1);
+
+   // Inverse undo excess work
+   for (I4 Q = MaxQ; Q > 1; Q >>= 1) {
+      I4 P = Q - 1;
+      for (int I = 0; I < NDims; ++I) {
+         if (X[I] & Q) {
+            X[0] ^= P; // invert
+         } else {
+            I4 T = (X[0] ^ X[I]) & P; // exchange
+            X[0] ^= T;
+            X[I] ^= T;
+         }
+      }
+   }
+
+   // Gray encode
+   for (int I = 1; I < NDims; ++I)
+      X[I] ^= X[I - 1];
+   I4 T = 0;
+   for (I4 Q = MaxQ; Q > 1; Q >>= 1) {
+      if (X[NDims - 1] & Q)
+         T ^= Q - 1;
+   }
+   for (int I = 0; I < NDims; ++I)
+      X[I] ^= T;
+
+   // Interleave the transposed index, most significant bits first
+   I8 Index = 0;
+   for (int Bit = NBits - 1; Bit >= 0; --Bit) {
+      for (int I = 0; I < NDims; ++I)
+         Index = (Index << 1) | ((X[I] >> Bit) & 1);
+   }
+
+   return Index;
+
+} // end hilbertIndex
+
+//------------------------------------------------------------------------------
+// Computes a reverse Cuthill-McKee ordering of a graph with NNodes nodes and
+// adjacency stored in packed form (neighbors of node N are in
+// Adjacency[AdjAdd[N]:AdjAdd[N+1]-1]). Each connected component is traversed
+// breadth first starting from its node of lowest degree and visiting
+// unvisited neighbors in order of increasing degree. On return, Order
+// contains the original index of the node at each position.
+
+static void rcmOrder(I4 NNodes,                       // [in] number of nodes
+                     const std::vector<I4> &AdjAdd,    // [in] start of nbrs
+                     const std::vector<I4> &Adjacency, // [in] nbrs of nodes
+                     std::vector<I4> &Order            // [out] new order
+) {
+
+   std::vector<I4> Degree(NNodes);
+   for (int Node = 0; Node < NNodes; ++Node)
+      Degree[Node] = AdjAdd[Node + 1] - AdjAdd[Node];
+   auto ByDegree = [&Degree](I4 A, I4 B) { return Degree[A] < Degree[B]; };
+
+   // Candidate starting nodes in order of increasing degree
+   std::vector<I4> Seeds(NNodes);
+   std::iota(Seeds.begin(), Seeds.end(), 0);
+   std::stable_sort(Seeds.begin(), Seeds.end(), ByDegree);
+
+   std::vector<bool> Visited(NNodes, false);
+   std::vector<I4> Nbrs;
+   Order.clear();
+   Order.reserve(NNodes);
+   for (int ISeed = 0; ISeed < NNodes; ++ISeed) {
+      I4 Seed = Seeds[ISeed];
+      if (Visited[Seed])
+         continue;
+      Visited[Seed] = true;
+      Order.push_back(Seed);
+
+      // Breadth-first traversal of the component, the Order vector serves
+      // as the queue of nodes to process
+      for (int Head = Order.size() - 1; Head < Order.size(); ++Head) {
+         I4 Node = Order[Head];
+         Nbrs.clear();
+         for (int Add = AdjAdd[Node]; Add < AdjAdd[Node + 1]; ++Add) {
+            I4 Nbr = Adjacency[Add];
+            if (!Visited[Nbr]) {
+               Visited[Nbr] = true;
+               Nbrs.push_back(Nbr);
+            }
+         }
+         std::stable_sort(Nbrs.begin(), Nbrs.end(), ByDegree);
+         Order.insert(Order.end(), Nbrs.begin(), Nbrs.end());
+      }
+   }
+
+   std::reverse(Order.begin(), Order.end());
+
+} // end rcmOrder
+
+//------------------------------------------------------------------------------
+// Retrieves the Stride values stored for each of a list of (1-based) global
+// IDs from an array in the initial linear distribution, where each task
+// holds NChunk consecutive entries in LocalData. The IDs can be located on
+// any task and the values are returned in the same order as the IDs.
+
+static int fetchLinearData(MPI_Comm Comm,                    // [in] MPI comm
+                           I4 NumTasks,                      // [in] num tasks
+                           I4 MyTask,                        // [in] local task
+                           I4 NChunk,                        // [in] chunk size
+                           I4 Stride,                        // [in] vals per ID
+                           const std::vector<I4> &LocalData, // [in] local data
+                           const std::vector<I4> &IDs,       // [in] global IDs
+                           std::vector<I4> &Values           // [out] values
+) {
+
+   // Sort the requested IDs by the task that holds them, keeping track of
+   // the location of each ID in the request buffer
+   I4 NIDs = IDs.size();
+   std::vector<I4> ReqCounts(NumTasks, 0);
+   for (int I = 0; I < NIDs; ++I)
+      ++ReqCounts[(IDs[I] - 1) / NChunk];
+
+   std::vector<I4> ReqNext(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task)
+      ReqNext[Task] = ReqNext[Task - 1] + ReqCounts[Task - 1];
+
+   std::vector<I4> ReqBuf(NIDs);
+   std::vector<I4> ReqPos(NIDs);
+   for (int I = 0; I < NIDs; ++I) {
+      I4 Task               = (IDs[I] - 1) / NChunk;
+      ReqPos[I]             = ReqNext[Task];
+      ReqBuf[ReqNext[Task]] = IDs[I];
+      ++ReqNext[Task];
+   }
+
+   std::vector<I4> InReqs;
+   std::vector<I4> InCounts;
+   int Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, ReqBuf, ReqCounts,
+                           InReqs, InCounts);
+   if (Err != 0)
+      return Err;
+
+   // Fill the values for the IDs requested from this task and return them
+   I4 Start = MyTask * NChunk;
+   std::vector<I4> ReplyBuf(InReqs.size() * Stride);
+   for (int I = 0; I < InReqs.size(); ++I) {
+      I4 LocAdd = InReqs[I] - 1 - Start;
+      for (int J = 0; J < Stride; ++J)
+         ReplyBuf[I * Stride + J] = LocalData[LocAdd * Stride + J];
+   }
+   std::vector<I4> ReplyCounts(NumTasks);
+   for (int Task = 0; Task < NumTasks; ++Task)
+      ReplyCounts[Task] = InCounts[Task] * Stride;
+
+   std::vector<I4> OutBuf;
+   std::vector<I4> OutCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, ReplyBuf, ReplyCounts,
+                       OutBuf, OutCounts);
+   if (Err != 0)
+      return Err;
+
+   // The replies arrive in the order of the request buffer
+   Values.resize(NIDs * Stride);
+   for (int I = 0; I < NIDs; ++I) {
+      for (int J = 0; J < Stride; ++J)
+         Values[I * Stride + J] = OutBuf[ReqPos[I] * Stride + J];
+   }
+
+   return Err;
+
+} // end fetchLinearData
+
+//------------------------------------------------------------------------------
+// Stores the Stride values given for each of a list of (1-based) global IDs
+// into an array in the initial linear distribution, where each task holds
+// NChunk consecutive entries in LocalData. This is the inverse of
+// fetchLinearData and is used to build a directory of values held by any
+// task that can then be queried by ID. Entries of LocalData for IDs not in
+// any list are left unchanged.
+
+static int storeLinearData(MPI_Comm Comm,                 // [in] MPI comm
+                           I4 NumTasks,                   // [in] num tasks
+                           I4 MyTask,                     // [in] local task
+                           I4 NChunk,                     // [in] chunk size
+                           I4 Stride,                     // [in] vals per ID
+                           const std::vector<I4> &IDs,    // [in] global IDs
+                           const std::vector<I4> &Values, // [in] values
+                           std::vector<I4> &LocalData     // [inout] local data
+) {
+
+   // Pack each ID followed by its values, sorted by the task that holds
+   // the ID in the linear distribution
+   I4 NIDs      = IDs.size();
+   I4 SizePerID = Stride + 1;
+   std::vector<I4> SendCounts(NumTasks, 0);
+   for (int I = 0; I < NIDs; ++I)
+      SendCounts[(IDs[I] - 1) / NChunk] += SizePerID;
+
+   std::vector<I4> SendNext(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task)
+      SendNext[Task] = SendNext[Task - 1] + SendCounts[Task - 1];
+
+   std::vector<I4> SendBuf(NIDs * SizePerID);
+   for (int I = 0; I < NIDs; ++I) {
+      I4 Task         = (IDs[I] - 1) / NChunk;
+      I4 BufAdd       = SendNext[Task];
+      SendBuf[BufAdd] = IDs[I];
+      for (int J = 0; J < Stride; ++J)
+         SendBuf[BufAdd + 1 + J] = Values[I * Stride + J];
+      SendNext[Task] += SizePerID;
+   }
+
+   std::vector<I4> RecvBuf;
+   std::vector<I4> RecvCounts;
+   int Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, SendBuf, SendCounts,
+                           RecvBuf, RecvCounts);
+   if (Err != 0)
+      return Err;
+
+   // Store the values received for the IDs held by this task
+   I4 Start = MyTask * NChunk;
+   for (int BufAdd = 0; BufAdd < RecvBuf.size(); BufAdd += SizePerID) {
+      I4 LocAdd = RecvBuf[BufAdd] - 1 - Start;
+      for (int J = 0; J < Stride; ++J)
+         LocalData[LocAdd * Stride + J] = RecvBuf[BufAdd + 1 + J];
+   }
+
+   return Err;
+
+} // end storeLinearData
+
+//------------------------------------------------------------------------------
+// Mixes the bits of a 64-bit key (the splitmix64 finalizer) so that nearby
+// keys give unrelated hashes.
+
+static std::uint64_t hashKey(std::uint64_t Key) {
+   Key += 0x9e3779b97f4a7c15ULL;
+   Key  = (Key ^ (Key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   Key  = (Key ^ (Key >> 27)) * 0x94d049bb133111ebULL;
+   return Key ^ (Key >> 31);
+}
+
+//------------------------------------------------------------------------------
+// Computes a checksum of the cell connectivity and weights that identifies
+// a mesh for the partition cache. Each entry is hashed together with its
+// global position and the hashes are summed over all tasks, so the result
+// does not depend on how the initial linear distribution is laid out.
+
+static std::uint64_t
+meshChecksum(const MachEnv *InEnv,                   // [in] MPI info
+             I4 NCellsGlobal,                        // [in] global num cells
+             I4 NEdgesGlobal,                        // [in] global num edges
+             I4 NVerticesGlobal,                     // [in] global num vrtx
+             I4 MaxEdges,                            // [in] max cell edges
+             I4 NConstraints,                        // [in] weights per cell
+             const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs
+             const std::vector<I4> &EdgesOnCellInit, // [in] cell edges
+             const std::vector<I4> &CellWgtInit      // [in] cell weights
+) {
+
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 CellStart   = MyTask * NCellsChunk;
+   I4 NCellsLocal =
+       std::max(std::min(NCellsChunk, NCellsGlobal - CellStart), 0);
+
+   // Hash each entry with its global position and the array it belongs to
+   auto hashEntry = [](std::uint64_t Pos, std::uint64_t Tag, I4 Value) {
+      return hashKey((Pos * 4 + Tag) ^
+                     hashKey(static_cast<std::uint32_t>(Value)));
+   };
+
+   std::uint64_t LocalSum = 0;
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      std::uint64_t CellGlob = CellStart + Cell;
+      for (int J = 0; J < MaxEdges; ++J) {
+         std::uint64_t Pos = CellGlob * MaxEdges + J;
+         LocalSum += hashEntry(Pos, 1, CellsOnCellInit[Cell * MaxEdges + J]);
+         LocalSum += hashEntry(Pos, 2, EdgesOnCellInit[Cell * MaxEdges + J]);
+      }
+      if (!CellWgtInit.empty()) {
+         for (int J = 0; J < NConstraints; ++J) {
+            std::uint64_t Pos = CellGlob * NConstraints + J;
+            LocalSum +=
+                hashEntry(Pos, 3, CellWgtInit[Cell * NConstraints + J]);
+         }
+      }
+   }
+
+   std::uint64_t Checksum = 0;
+   MPI_Allreduce(&LocalSum, &Checksum, 1, MPI_UINT64_T, MPI_SUM, Comm);
+
+   // Include the mesh sizes so that meshes with no connectivity differ
+   for (I4 Size : {NCellsGlobal, NEdgesGlobal, NVerticesGlobal, MaxEdges,
+                   NConstraints})
+      Checksum = hashKey(Checksum ^ static_cast<std::uint32_t>(Size));
+
+   return Checksum;
+
+} // end meshChecksum
+
 //------------------------------------------------------------------------------
 // Local routine that searches a std::vector<I4> for a particular entry and
 // returns the index of that entry. If not found, the size is returned
@@ -125,7 +556,8 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
              std::vector<I4> &EdgesOnEdgeInit,    // all edges neighboring edge
              std::vector<I4> &VerticesOnEdgeInit, // vertices on ends of edge
              std::vector<I4> &CellsOnVertexInit,  // cells meeting at each vrtx
-             std::vector<I4> &EdgesOnVertexInit   // edges meeting at each vrtx
+             std::vector<I4> &EdgesOnVertexInit,  // edges meeting at each vrtx
+             bool ReadLazy                        // false to defer lazy arrays
 ) {
 
    int Err = 0;
@@ -288,10 +720,12 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
                           OnEdgeSize, OnEdgeOffset, Rearr);
    if (Err != 0)
       LOG_CRITICAL("Decomp: error creating OnEdge IO decomposition");
-   Err = IO::createDecomp(OnEdgeDecomp2, IO::IOTypeI4, NDims, OnEdgeDims2,
-                          OnEdgeSize2, OnEdgeOffset2, Rearr);
-   if (Err != 0)
-      LOG_CRITICAL("Decomp: error creating OnEdg2 IO decomposition");
+   if (ReadLazy) {
+      Err = IO::createDecomp(OnEdgeDecomp2, IO::IOTypeI4, NDims, OnEdgeDims2,
+                             OnEdgeSize2, OnEdgeOffset2, Rearr);
+      if (Err != 0)
+         LOG_CRITICAL("Decomp: error creating OnEdg2 IO decomposition");
+   }
    Err = IO::createDecomp(OnVertexDecomp, IO::IOTypeI4, NDims, OnVertexDims,
                           OnVertexSize, OnVertexOffset, Rearr);
    if (Err != 0)
@@ -303,10 +737,12 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
    EdgesOnCellInit.resize(OnCellSize);
    VerticesOnCellInit.resize(OnCellSize);
    CellsOnEdgeInit.resize(OnEdgeSize);
-   EdgesOnEdgeInit.resize(OnEdgeSize2);
+   if (ReadLazy)
+      EdgesOnEdgeInit.resize(OnEdgeSize2);
    VerticesOnEdgeInit.resize(OnEdgeSize);
    CellsOnVertexInit.resize(OnVertexSize);
-   EdgesOnVertexInit.resize(OnVertexSize);
+   if (ReadLazy)
+      EdgesOnVertexInit.resize(OnVertexSize);
 
    std::string VarName    = "CellsOnCell";
    std::string VarNameOld = "cellsOnCell";
@@ -356,16 +792,18 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
          LOG_CRITICAL("Decomp: error reading CellsOnEdge");
    }
 
-   VarName    = "EdgesOnEdge";
-   VarNameOld = "edgesOnEdge";
-   int EdgesOnEdgeID;
-   Err = IO::readArray(&EdgesOnEdgeInit[0], OnEdgeSize2, VarName, MeshFileID,
-                       OnEdgeDecomp2, EdgesOnEdgeID);
-   if (Err != 0) { // not found, try again under older name
-      Err = IO::readArray(&EdgesOnEdgeInit[0], OnEdgeSize2, VarNameOld,
+   if (ReadLazy) {
+      VarName    = "EdgesOnEdge";
+      VarNameOld = "edgesOnEdge";
+      int EdgesOnEdgeID;
+      Err = IO::readArray(&EdgesOnEdgeInit[0], OnEdgeSize2, VarName,
                           MeshFileID, OnEdgeDecomp2, EdgesOnEdgeID);
-      if (Err != 0)
-         LOG_CRITICAL("Decomp: error reading EdgesOnEdge");
+      if (Err != 0) { // not found, try again under older name
+         Err = IO::readArray(&EdgesOnEdgeInit[0], OnEdgeSize2, VarNameOld,
+                             MeshFileID, OnEdgeDecomp2, EdgesOnEdgeID);
+         if (Err != 0)
+            LOG_CRITICAL("Decomp: error reading EdgesOnEdge");
+      }
    }
 
    VarName    = "VerticesOnEdge";
@@ -392,16 +830,18 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
          LOG_CRITICAL("Decomp: error reading CellsOnVertex");
    }
 
-   VarName    = "EdgesOnVertex";
-   VarNameOld = "edgesOnVertex";
-   int EdgesOnVertexID;
-   Err = IO::readArray(&EdgesOnVertexInit[0], OnVertexSize, VarName, MeshFileID,
-                       OnVertexDecomp, EdgesOnVertexID);
-   if (Err != 0) { // not found, try again under older name
-      Err = IO::readArray(&EdgesOnVertexInit[0], OnVertexSize, VarNameOld,
+   if (ReadLazy) {
+      VarName    = "EdgesOnVertex";
+      VarNameOld = "edgesOnVertex";
+      int EdgesOnVertexID;
+      Err = IO::readArray(&EdgesOnVertexInit[0], OnVertexSize, VarName,
                           MeshFileID, OnVertexDecomp, EdgesOnVertexID);
-      if (Err != 0)
-         LOG_CRITICAL("Decomp: error reading EdgesOnVertex");
+      if (Err != 0) { // not found, try again under older name
+         Err = IO::readArray(&EdgesOnVertexInit[0], OnVertexSize, VarNameOld,
+                             MeshFileID, OnVertexDecomp, EdgesOnVertexID);
+         if (Err != 0)
+            LOG_CRITICAL("Decomp: error reading EdgesOnVertex");
+      }
    }
 
    // Initial decompositions are no longer needed so remove them now
@@ -411,9 +851,11 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
    Err = IO::destroyDecomp(OnEdgeDecomp);
    if (Err != 0)
       LOG_ERROR("Decomp: error destroying OnEdge decomposition");
-   Err = IO::destroyDecomp(OnEdgeDecomp2);
-   if (Err != 0)
-      LOG_ERROR("Decomp: error destroying OnEdge2 decomposition");
+   if (ReadLazy) {
+      Err = IO::destroyDecomp(OnEdgeDecomp2);
+      if (Err != 0)
+         LOG_ERROR("Decomp: error destroying OnEdge2 decomposition");
+   }
    Err = IO::destroyDecomp(OnVertexDecomp);
    if (Err != 0)
       LOG_ERROR("Decomp: error destroying OnVertex decomposition");
@@ -422,6 +864,103 @@ int readMesh(const int MeshFileID, // file ID for open mesh file
 
 } // end readMesh
 
+//------------------------------------------------------------------------------
+// Read or compute the weights of each cell used to balance the partition.
+// The weights are defined for the cells in the initial linear distribution
+// with NConstraints weights stored contiguously for each cell as required by
+// METIS. If no weighting is requested, the weight vector is left empty and
+// a single constraint is used.
+
+int readCellWeights(const int MeshFileID, // file ID for open mesh file
+                    const MachEnv *InEnv, // machine env for MPI layout
+                    I4 NCellsGlobal,      // total number of cells
+                    I4 NEdgesGlobal,      // total number of edges
+                    I4 MaxEdges,          // max number of edges on a cell
+                    PartWeight Weight,    // choice of partition weights
+                    const std::vector<I4> &EdgesOnCellInit, // edges on cell
+                    std::vector<I4> &CellWgtInit, // weights for each cell
+                    I4 &NConstraints              // number of weights per cell
+) {
+
+   int Err = 0;
+
+   NConstraints = 1;
+   CellWgtInit.clear();
+   if (Weight == PartWeightNone)
+      return Err;
+
+   // Retrieve some info on the MPI layout
+   I4 NumTasks = InEnv->getNumTasks();
+   I4 MyTask   = InEnv->getMyTask();
+
+   // Sizes of the initial linear distribution
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 CellStart   = std::min(MyTask * NCellsChunk, NCellsGlobal);
+   I4 CellEnd     = std::min(CellStart + NCellsChunk, NCellsGlobal);
+   I4 NCellsLocal = CellEnd - CellStart;
+
+   std::vector<I4> Dims{NCellsGlobal};
+   std::vector<I4> Offset(NCellsChunk, -1);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+      Offset[Cell] = CellStart + Cell;
+   I4 WgtDecomp;
+   Err = IO::createDecomp(WgtDecomp, IO::IOTypeI4, 1, Dims, NCellsChunk,
+                          Offset, IO::RearrBox);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: error creating cell weight IO decomposition");
+      return Err;
+   }
+
+   // Read the per-cell cost or number of active levels, checking both the
+   // Omega name and the older MPAS name for the latter
+   std::vector<I4> CellCost(NCellsChunk, 1);
+   std::string VarName    = "MaxLevelCell";
+   std::string VarNameOld = "maxLevelCell";
+   if (Weight == PartWeightCellCost) {
+      VarName    = "CellCost";
+      VarNameOld = "cellCost";
+   }
+   int WgtID;
+   Err = IO::readArray(&CellCost[0], NCellsChunk, VarName, MeshFileID,
+                       WgtDecomp, WgtID);
+   if (Err != 0) { // not found, try again under older name
+      Err = IO::readArray(&CellCost[0], NCellsChunk, VarNameOld, MeshFileID,
+                          WgtDecomp, WgtID);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: error reading {} for partition weights",
+                      VarName);
+         return Err;
+      }
+   }
+   Err = IO::destroyDecomp(WgtDecomp);
+   if (Err != 0)
+      LOG_ERROR("Decomp: error destroying cell weight decomposition");
+
+   // Every column carries some cost even if it has no active levels (eg
+   // land cells) and METIS requires positive total weights, so use a
+   // minimum weight of one. The second constraint for edge work is the
+   // number of active levels times the number of edges of the cell.
+   if (Weight == PartWeightLevelsEdges)
+      NConstraints = 2;
+   CellWgtInit.resize(NCellsChunk * NConstraints, 1);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      I4 Wgt                           = std::max(CellCost[Cell], 1);
+      CellWgtInit[Cell * NConstraints] = Wgt;
+      if (NConstraints > 1) {
+         I4 NEdgesCell = 0;
+         for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+            I4 EdgeGlob = EdgesOnCellInit[Cell * MaxEdges + Edge];
+            if (EdgeGlob > 0 && EdgeGlob <= NEdgesGlobal)
+               ++NEdgesCell;
+         }
+         CellWgtInit[Cell * NConstraints + 1] = Wgt * std::max(NEdgesCell, 1);
+      }
+   }
+
+   return Err;
+
+} // end readCellWeights
+
 //------------------------------------------------------------------------------
 // Initialize the decomposition and create the default decomposition with
 // (currently) one partition per MPI task using a ParMetis KWay method.
@@ -449,6 +988,49 @@ void Decomp::init(const std::string &MeshFileName) {
 
    PartMethod Method = getPartMethodFromStr(DecompMethodStr);
 
+   // The local ordering is optional and defaults to global ID order
+   LocalOrder Order = LocalOrderGlobalID;
+   if (DecompConfig.existsVar("LocalOrder")) {
+      std::string LocalOrderStr;
+      Err = DecompConfig.get("LocalOrder", LocalOrderStr);
+      CHECK_ERROR_ABORT(Err, "Decomp: error reading LocalOrder from Config");
+      Order = getLocalOrderFromStr(LocalOrderStr);
+      if (Order == LocalOrderUnknown)
+         ABORT_ERROR("Decomp: unknown LocalOrder {}", LocalOrderStr);
+   }
+
+   // Partition weights are optional and default to equal weights
+   PartWeight Weight = PartWeightNone;
+   if (DecompConfig.existsVar("PartWeight")) {
+      std::string PartWeightStr;
+      Err = DecompConfig.get("PartWeight", PartWeightStr);
+      CHECK_ERROR_ABORT(Err, "Decomp: error reading PartWeight from Config");
+      Weight = getPartWeightFromStr(PartWeightStr);
+      if (Weight == PartWeightUnknown)
+         ABORT_ERROR("Decomp: unknown PartWeight {}", PartWeightStr);
+   }
+
+   // Deferred reads of the EdgesOnEdge connectivity are optional
+   bool LazyRead = false;
+   if (DecompConfig.existsVar("LazyMeshRead")) {
+      Err = DecompConfig.get("LazyMeshRead", LazyRead);
+      CHECK_ERROR_ABORT(Err, "Decomp: error reading LazyMeshRead from Config");
+   }
+
+   // The partition cache is optional and disabled by an empty file name
+   std::string CacheFile;
+   if (DecompConfig.existsVar("DecompCache")) {
+      Err = DecompConfig.get("DecompCache", CacheFile);
+      CHECK_ERROR_ABORT(Err, "Decomp: error reading DecompCache from Config");
+   }
+
+   // The interior width is optional and defaults to the member default
+   I4 InteriorWidth = 0;
+   if (DecompConfig.existsVar("InteriorWidth")) {
+      Err = DecompConfig.get("InteriorWidth", InteriorWidth);
+      CHECK_ERROR_ABORT(Err, "Decomp: error reading InteriorWidth from Config");
+   }
+
    // Retrieve the default machine environment
    MachEnv *DefEnv = MachEnv::getDefault();
 
@@ -457,7 +1039,10 @@ void Decomp::init(const std::string &MeshFileName) {
 
    // Create the default decomposition and set pointer to it
    Decomp::DefaultDecomp = Decomp::create("Default", DefEnv, NParts, Method,
-                                          InHaloWidth, MeshFileName);
+                                          InHaloWidth, MeshFileName, Order,
+                                          Weight, LazyRead, CacheFile);
+   if (InteriorWidth > 0)
+      Decomp::DefaultDecomp->setInteriorWidth(InteriorWidth);
 
    TimerFlag = Pacer::stop("Decomp init") && TimerFlag;
    if (!TimerFlag)
@@ -474,13 +1059,21 @@ Decomp::Decomp(
     const MachEnv *InEnv,            //< [in] MachEnv for the new partition
     I4 NParts,                       //< [in] num of partitions for new decomp
     PartMethod Method,               //< [in] method for partitioning
-    I4 InHaloWidth,                  //< [in] width of halo in new decomp
-    const std::string &MeshFileName_ //< [in] name of file with mesh info
+    I4 InHaloWidth,                   //< [in] width of halo in new decomp
+    const std::string &MeshFileName_, //< [in] name of file with mesh info
+    LocalOrder Order,                 //< [in] ordering of local cells
+    PartWeight Weight,                //< [in] weights for partition
+    bool LazyRead,                    //< [in] defer the lazy arrays
+    const std::string &CacheFile      //< [in] partition cache file
 ) {
 
    bool TimerFlag = Pacer::start("Decomp construct");
    int Err        = 0; // internal error code
 
+   // Phase times are also kept here so they can be queried by benchmarks
+   R8 ConstructStart = MPI_Wtime();
+   R8 PhaseStart     = ConstructStart;
+
    // Retrieve some info on the MPI layout
    MPI_Comm Comm = InEnv->getComm();
    I4 NumTasks   = InEnv->getNumTasks();
@@ -505,28 +1098,56 @@ Decomp::Decomp(
    std::vector<I4> VerticesOnEdgeInit;
    std::vector<I4> CellsOnVertexInit;
    std::vector<I4> EdgesOnVertexInit;
-   HaloWidth = InHaloWidth;
+   HaloWidth           = InHaloWidth;
+   EdgesOnEdgeLoaded   = !LazyRead;
+   EdgesOnVertexLoaded = !LazyRead;
 
    Err = readMesh(FileID, InEnv, NCellsGlobal, NEdgesGlobal, NVerticesGlobal,
                   MaxEdges, MaxCellsOnEdge, VertexDegree, CellsOnCellInit,
                   EdgesOnCellInit, VerticesOnCellInit, CellsOnEdgeInit,
                   EdgesOnEdgeInit, VerticesOnEdgeInit, CellsOnVertexInit,
-                  EdgesOnVertexInit);
+                  EdgesOnVertexInit, !LazyRead);
    if (Err != 0)
       LOG_CRITICAL("Decomp: Error reading mesh connectivity");
 
+   // Read or compute the cell weights for a weighted partition
+   std::vector<I4> CellWgtInit;
+   I4 NConstraints = 1;
+   Err = readCellWeights(FileID, InEnv, NCellsGlobal, NEdgesGlobal, MaxEdges,
+                         Weight, EdgesOnCellInit, CellWgtInit, NConstraints);
+   if (Err != 0)
+      LOG_CRITICAL("Decomp: Error reading partition weights");
+
    // Close file
-   Err       = IO::closeFile(FileID);
-   TimerFlag = Pacer::stop("Decomp read mesh") && TimerFlag;
+   Err          = IO::closeFile(FileID);
+   TimerFlag    = Pacer::stop("Decomp read mesh") && TimerFlag;
+   ReadMeshTime = MPI_Wtime() - PhaseStart;
+
+   // If a partition cache is requested, try to read the cell decomposition
+   // from a previous run with the same mesh and options. The checksum of
+   // the mesh connectivity identifies the mesh.
+   TimerFlag  = Pacer::start("Decomp part cells") && TimerFlag;
+   PhaseStart = MPI_Wtime();
+   std::uint64_t MeshChecksum = 0;
+   if (!CacheFile.empty()) {
+      MeshChecksum =
+          meshChecksum(InEnv, NCellsGlobal, NEdgesGlobal, NVerticesGlobal,
+                       MaxEdges, NConstraints, CellsOnCellInit,
+                       EdgesOnCellInit, CellWgtInit);
+      CacheLoaded  = readDecompCache(InEnv, CacheFile, MeshChecksum, Method,
+                                     Order, Weight) == 0;
+      if (CacheLoaded)
+         LOG_INFO("Decomp: cell decomposition read from cache {}", CacheFile);
+   }
 
    // In the case of single task avoid calling a full partitioning routine and
    // just set the needed variables directly. This is done because some METIS
    // functions can raise SIGFPE when numparts == 1 due to division by zero
    // See: https://github.com/KarypisLab/METIS/issues/67
-   TimerFlag = Pacer::start("Decomp part cells") && TimerFlag;
-   if (NumTasks == 1) {
+   // A cached decomposition needs no partitioning.
+   if (!CacheLoaded and NumTasks == 1) {
       partCellsSingleTask();
-   } else {
+   } else if (!CacheLoaded) {
       // Use the mesh adjacency information to create a partition of cells
       switch (Method) { // branch depending on method chosen
 
@@ -534,7 +1155,8 @@ Decomp::Decomp(
       // ParMetis KWay method
       case PartMethodMetisKWay: {
 
-         Err = partCellsKWay(InEnv, CellsOnCellInit);
+         Err = partCellsKWay(InEnv, CellsOnCellInit, CellWgtInit,
+                             NConstraints);
          if (Err != 0) {
             LOG_CRITICAL("Decomp: Error partitioning cells KWay");
             return;
@@ -542,6 +1164,32 @@ Decomp::Decomp(
          break;
       } // end case MethodKWay
 
+      //---------------------------------------------------------------------------
+      // ParMetis distributed KWay method
+      case PartMethodParMetisKWay: {
+
+         Err = partCellsParMetisKWay(InEnv, CellsOnCellInit, CellWgtInit,
+                                     NConstraints);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error partitioning cells ParMetis KWay");
+            return;
+         }
+         break;
+      } // end case MethodParMetisKWay
+
+      //---------------------------------------------------------------------------
+      // Hilbert space-filling curve method
+      case PartMethodHilbertSFC: {
+
+         Err = partCellsSFC(InEnv, CellsOnCellInit, CellWgtInit,
+                            NConstraints);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: Error partitioning cells HilbertSFC");
+            return;
+         }
+         break;
+      } // end case MethodHilbertSFC
+
          //---------------------------------------------------------------------------
          // Unknown partitioning method
 
@@ -551,58 +1199,92 @@ Decomp::Decomp(
 
       } // End switch on Method
    }
-   TimerFlag = Pacer::stop("Decomp part cells") && TimerFlag;
+   TimerFlag     = Pacer::stop("Decomp part cells") && TimerFlag;
+   PartitionTime = MPI_Wtime() - PhaseStart;
 
    //---------------------------------------------------------------------------
    // Cell partitioning complete. Redistribute the initial XXOnCell arrays
    // to their final locations.
-   TimerFlag = Pacer::start("Decomp rearrange cells") && TimerFlag;
-   Err       = rearrangeCellArrays(InEnv, CellsOnCellInit, EdgesOnCellInit,
-                                   VerticesOnCellInit);
+   TimerFlag  = Pacer::start("Decomp rearrange cells") && TimerFlag;
+   PhaseStart = MPI_Wtime();
+   Err        = rearrangeCellArrays(InEnv, CellsOnCellInit, EdgesOnCellInit,
+                                    VerticesOnCellInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error rearranging XxOnCell arrays");
       return;
    }
-   TimerFlag = Pacer::stop("Decomp rearrange cells") && TimerFlag;
+   TimerFlag     = Pacer::stop("Decomp rearrange cells") && TimerFlag;
+   RearrangeTime = MPI_Wtime() - PhaseStart;
+
+   // Optionally reorder the local cells for better memory locality. This
+   // must occur before the edges and vertices are partitioned since their
+   // local order follows the cell order. A cached decomposition is already
+   // in its final order.
+   if (Order == LocalOrderRCM and !CacheLoaded) {
+      TimerFlag = Pacer::start("Decomp reorder cells") && TimerFlag;
+      Err       = reorderCells(InEnv);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error reordering local cells");
+         return;
+      }
+      TimerFlag = Pacer::stop("Decomp reorder cells") && TimerFlag;
+   }
+
+   // Save the final cell decomposition for later runs. A failed write only
+   // means the next run partitions the mesh again.
+   if (!CacheFile.empty() and !CacheLoaded) {
+      Err = writeDecompCache(InEnv, CacheFile, MeshChecksum, Method, Order,
+                             Weight);
+      if (Err != 0)
+         LOG_WARN("Decomp: unable to write partition cache {}", CacheFile);
+   }
 
    // Partition the edges
-   TimerFlag = Pacer::start("Decomp part edges") && TimerFlag;
-   Err       = partEdges(InEnv, CellsOnEdgeInit);
+   TimerFlag  = Pacer::start("Decomp part edges") && TimerFlag;
+   PhaseStart = MPI_Wtime();
+   Err        = partEdges(InEnv, CellsOnEdgeInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error partitioning edges");
       return;
    }
    TimerFlag = Pacer::stop("Decomp part edges") && TimerFlag;
+   PartitionTime += MPI_Wtime() - PhaseStart;
 
    // Edge partitioning complete. Redistribute the initial XXOnEdge arrays
    // to their final locations.
-   TimerFlag = Pacer::start("Decomp rearrange edges") && TimerFlag;
-   Err       = rearrangeEdgeArrays(InEnv, CellsOnEdgeInit, EdgesOnEdgeInit,
-                                   VerticesOnEdgeInit);
+   TimerFlag  = Pacer::start("Decomp rearrange edges") && TimerFlag;
+   PhaseStart = MPI_Wtime();
+   Err        = rearrangeEdgeArrays(InEnv, CellsOnEdgeInit, EdgesOnEdgeInit,
+                                    VerticesOnEdgeInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error rearranging XxOnEdge arrays");
       return;
    }
    TimerFlag = Pacer::stop("Decomp rearrange edges") && TimerFlag;
+   RearrangeTime += MPI_Wtime() - PhaseStart;
 
    // Partition the vertices
-   TimerFlag = Pacer::start("Decomp part vertices") && TimerFlag;
-   Err       = partVertices(InEnv, CellsOnVertexInit);
+   TimerFlag  = Pacer::start("Decomp part vertices") && TimerFlag;
+   PhaseStart = MPI_Wtime();
+   Err        = partVertices(InEnv, CellsOnVertexInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error partitioning vertices");
       return;
    }
    TimerFlag = Pacer::stop("Decomp part vertices") && TimerFlag;
+   PartitionTime += MPI_Wtime() - PhaseStart;
 
    // Vertex partitioning complete. Redistribute the initial XXOnVertex arrays
    // to their final locations.
-   TimerFlag = Pacer::start("Decomp rearrange vertices") && TimerFlag;
+   TimerFlag  = Pacer::start("Decomp rearrange vertices") && TimerFlag;
+   PhaseStart = MPI_Wtime();
    Err = rearrangeVertexArrays(InEnv, CellsOnVertexInit, EdgesOnVertexInit);
    if (Err != 0) {
       LOG_CRITICAL("Decomp: Error rearranging XxOnVertex arrays");
       return;
    }
    TimerFlag = Pacer::stop("Decomp rearrange vertices") && TimerFlag;
+   RearrangeTime += MPI_Wtime() - PhaseStart;
 
    // Convert global addresses to local addresses. Create the global to
    // local address ordered maps to simplify and optimize searches.
@@ -702,8 +1384,9 @@ Decomp::Decomp(
       }
    }
 
-   // EdgesOnEdge
-   for (int Edge = 0; Edge < NEdgesSize; ++Edge) {
+   // EdgesOnEdge (unless deferred to a later loadEdgesOnEdge call)
+   I4 NEdgesConvert = EdgesOnEdgeLoaded ? NEdgesSize : 0;
+   for (int Edge = 0; Edge < NEdgesConvert; ++Edge) {
       for (int NbrEdge = 0; NbrEdge < 2 * MaxEdges; ++NbrEdge) {
          I4 GlobID = EdgesOnEdgeH(Edge, NbrEdge);
          auto it   = GlobToLocEdge.find(GlobID);
@@ -750,8 +1433,9 @@ Decomp::Decomp(
       }
    }
 
-   // EdgesOnVertex
-   for (int Vrtx = 0; Vrtx < NVerticesSize; ++Vrtx) {
+   // EdgesOnVertex (unless deferred to a later loadEdgesOnVertex call)
+   I4 NVerticesConvert = EdgesOnVertexLoaded ? NVerticesSize : 0;
+   for (int Vrtx = 0; Vrtx < NVerticesConvert; ++Vrtx) {
       for (int Edge = 0; Edge < VertexDegree; ++Edge) {
          I4 GlobID = EdgesOnVertexH(Vrtx, Edge);
          auto it   = GlobToLocEdge.find(GlobID);
@@ -767,6 +1451,9 @@ Decomp::Decomp(
    }
    TimerFlag = Pacer::stop("Decomp construct global to local") && TimerFlag;
 
+   // Determine owned interior and boundary cells and edges
+   setInteriorLists();
+
    // Create device copies of all arrays
 
    TimerFlag  = Pacer::start("Decomp construct device copy") && TimerFlag;
@@ -788,69 +1475,417 @@ Decomp::Decomp(
    NEdgesOnCell   = createDeviceMirrorCopy(NEdgesOnCellH);
 
    CellsOnEdge    = createDeviceMirrorCopy(CellsOnEdgeH);
-   EdgesOnEdge    = createDeviceMirrorCopy(EdgesOnEdgeH);
    VerticesOnEdge = createDeviceMirrorCopy(VerticesOnEdgeH);
-   NEdgesOnEdge   = createDeviceMirrorCopy(NEdgesOnEdgeH);
+   if (EdgesOnEdgeLoaded) {
+      EdgesOnEdge  = createDeviceMirrorCopy(EdgesOnEdgeH);
+      NEdgesOnEdge = createDeviceMirrorCopy(NEdgesOnEdgeH);
+   }
 
    CellsOnVertex = createDeviceMirrorCopy(CellsOnVertexH);
-   EdgesOnVertex = createDeviceMirrorCopy(EdgesOnVertexH);
+   if (EdgesOnVertexLoaded)
+      EdgesOnVertex = createDeviceMirrorCopy(EdgesOnVertexH);
+
+   CellsInterior = createDeviceMirrorCopy(CellsInteriorH);
+   CellsBoundary = createDeviceMirrorCopy(CellsBoundaryH);
+   EdgesInterior = createDeviceMirrorCopy(EdgesInteriorH);
+   EdgesBoundary = createDeviceMirrorCopy(EdgesBoundaryH);
    TimerFlag     = Pacer::stop("Decomp construct device copy") && TimerFlag;
+
+   MemModule = "Decomp:" + Name;
+   recordMemory();
+
    TimerFlag     = Pacer::stop("Decomp construct") && TimerFlag;
+   ConstructTime = MPI_Wtime() - ConstructStart;
    if (!TimerFlag)
       LOG_WARN("Decomp constructor: Error encounterd in timers");
 } // end decomposition constructor
 
 //------------------------------------------------------------------------------
-// Creates a new decomposition using the constructor and puts it in the
-// AllDecomps map
-Decomp *Decomp::create(
-    const std::string &Name,        //< [in] Name for new decomposition
-    const MachEnv *Env,             //< [in] MachEnv for the new partition
-    I4 NParts,                      //< [in] num of partitions for new decomp
-    PartMethod Method,              //< [in] method for partitioning
-    I4 HaloWidth,                   //< [in] width of halo in new decomp
-    const std::string &MeshFileName //< [in] name of file with mesh info
-) {
+// Reorder the local cells within the owned cells and each halo layer with a
+// reverse Cuthill-McKee ordering. At this point the XxOnCell arrays still
+// contain global IDs so only their rows need to be permuted. The owned cells
+// change local address, so the new address of each halo cell is requested
+// from the task that owns it.
 
-   bool TimerFlag = Pacer::start("Decomp create");
-   // Check to see if a decomposition of the same name already exists and
-   // if so, exit with an error
-   if (AllDecomps.find(Name) != AllDecomps.end()) {
-      LOG_ERROR("Attempted to create a Decomp with name {} but a Decomp of "
-                "that name already exists",
-                Name);
-      return nullptr;
-   }
+int Decomp::reorderCells(const MachEnv *InEnv // [in] MachEnv with MPI info
+) {
 
-   // create a new decomp on the heap and put it in a map of
-   // unique_ptrs, which will manage its lifetime
-   auto *NewDecomp =
-       new Decomp(Name, Env, NParts, Method, HaloWidth, MeshFileName);
-   AllDecomps.emplace(Name, NewDecomp);
+   int Err = 0; // initialize return code
 
-   TimerFlag = Pacer::stop("Decomp create") && TimerFlag;
-   if (!TimerFlag)
-      LOG_WARN("Decomp::create: Error encountered in timers");
-   return NewDecomp;
-} // end Decomp create
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
 
-// Destructor
-//------------------------------------------------------------------------------
-// Destroys a decomposition and deallocates all arrays
+   // Bounds of the owned block and each halo layer
+   std::vector<I4> Bnds{0, NCellsOwned};
+   for (int Halo = 0; Halo < HaloWidth; ++Halo)
+      Bnds.push_back(NCellsHaloH(Halo));
+
+   // Compute the new order of each block from its internal adjacency.
+   // NewToOld holds the current local index of the cell at each new index.
+   std::vector<I4> NewToOld(NCellsAll);
+   for (int Blk = 0; Blk < Bnds.size() - 1; ++Blk) {
+      I4 Start = Bnds[Blk];
+      I4 NBlk  = Bnds[Blk + 1] - Start;
+
+      std::map<I4, I4> GlobToBlk;
+      for (int Cell = 0; Cell < NBlk; ++Cell)
+         GlobToBlk[CellIDH(Start + Cell)] = Cell;
+
+      std::vector<I4> AdjAdd(NBlk + 1, 0);
+      std::vector<I4> Adjacency;
+      for (int Cell = 0; Cell < NBlk; ++Cell) {
+         AdjAdd[Cell] = Adjacency.size();
+         for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+            auto It = GlobToBlk.find(CellsOnCellH(Start + Cell, Edge));
+            if (It != GlobToBlk.end())
+               Adjacency.push_back(It->second);
+         }
+      }
+      AdjAdd[NBlk] = Adjacency.size();
 
-Decomp::~Decomp() {
+      std::vector<I4> Order;
+      rcmOrder(NBlk, AdjAdd, Adjacency, Order);
+      for (int Cell = 0; Cell < NBlk; ++Cell)
+         NewToOld[Start + Cell] = Start + Order[Cell];
+   }
 
-   // No operations needed, Kokkos arrays removed when no longer in scope
+   // Permute the cell arrays. The extra entry at NCellsAll for boundary or
+   // undefined cells is unchanged.
+   HostArray1DI4 CellIDTmp("CellID", NCellsSize);
+   HostArray2DI4 CellLocTmp("CellLoc", NCellsSize, 2);
+   HostArray2DI4 CellsOnCellTmp("CellsOnCell", NCellsSize, MaxEdges);
+   HostArray2DI4 EdgesOnCellTmp("EdgesOnCell", NCellsSize, MaxEdges);
+   HostArray2DI4 VerticesOnCellTmp("VerticesOnCell", NCellsSize, MaxEdges);
+   HostArray1DI4 NEdgesOnCellTmp("NEdgesOnCell", NCellsSize);
+   deepCopy(CellIDTmp, CellIDH);
+   deepCopy(CellLocTmp, CellLocH);
+   deepCopy(CellsOnCellTmp, CellsOnCellH);
+   deepCopy(EdgesOnCellTmp, EdgesOnCellH);
+   deepCopy(VerticesOnCellTmp, VerticesOnCellH);
+   deepCopy(NEdgesOnCellTmp, NEdgesOnCellH);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      I4 OldCell            = NewToOld[Cell];
+      CellIDTmp(Cell)       = CellIDH(OldCell);
+      CellLocTmp(Cell, 0)   = CellLocH(OldCell, 0);
+      CellLocTmp(Cell, 1)   = CellLocH(OldCell, 1);
+      NEdgesOnCellTmp(Cell) = NEdgesOnCellH(OldCell);
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         CellsOnCellTmp(Cell, Edge)    = CellsOnCellH(OldCell, Edge);
+         EdgesOnCellTmp(Cell, Edge)    = EdgesOnCellH(OldCell, Edge);
+         VerticesOnCellTmp(Cell, Edge) = VerticesOnCellH(OldCell, Edge);
+      }
+   }
 
-} // end decomp destructor
+   // Owned cells are now at their new local address
+   std::vector<I4> OldToNew(NCellsOwned);
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      OldToNew[NewToOld[Cell]] = Cell;
+      CellLocTmp(Cell, 1)      = Cell;
+   }
 
-//------------------------------------------------------------------------------
-// Removes a decomposition from list and destroys it
+   // Request the new address of each halo cell from its owner, sending the
+   // previous address on the owning task
+   std::vector<I4> ReqCounts(NumTasks, 0);
+   for (int Cell = NCellsOwned; Cell < NCellsAll; ++Cell)
+      ++ReqCounts[CellLocTmp(Cell, 0)];
+   std::vector<I4> ReqNext(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task)
+      ReqNext[Task] = ReqNext[Task - 1] + ReqCounts[Task - 1];
+
+   I4 NHalo = NCellsAll - NCellsOwned;
+   std::vector<I4> ReqBuf(NHalo);
+   std::vector<I4> ReqPos(NHalo);
+   for (int Cell = NCellsOwned; Cell < NCellsAll; ++Cell) {
+      I4 Task                    = CellLocTmp(Cell, 0);
+      ReqPos[Cell - NCellsOwned] = ReqNext[Task];
+      ReqBuf[ReqNext[Task]]      = CellLocTmp(Cell, 1);
+      ++ReqNext[Task];
+   }
 
-void Decomp::erase(std::string InName // [in] name of decomp to remove
-) {
+   std::vector<I4> InReqs;
+   std::vector<I4> InCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, ReqBuf, ReqCounts,
+                       InReqs, InCounts);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error requesting reordered halo cell locations");
+      return Err;
+   }
+   for (int I = 0; I < InReqs.size(); ++I)
+      InReqs[I] = OldToNew[InReqs[I]];
 
-   AllDecomps.erase(InName); // removes the decomp from the list (map) and in
+   std::vector<I4> NewAdds;
+   std::vector<I4> NewCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, InReqs, InCounts, NewAdds,
+                       NewCounts);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error returning reordered halo cell locations");
+      return Err;
+   }
+   for (int Cell = NCellsOwned; Cell < NCellsAll; ++Cell)
+      CellLocTmp(Cell, 1) = NewAdds[ReqPos[Cell - NCellsOwned]];
+
+   CellIDH         = CellIDTmp;
+   CellLocH        = CellLocTmp;
+   CellsOnCellH    = CellsOnCellTmp;
+   EdgesOnCellH    = EdgesOnCellTmp;
+   VerticesOnCellH = VerticesOnCellTmp;
+   NEdgesOnCellH   = NEdgesOnCellTmp;
+
+   return Err;
+
+} // end function reorderCells
+
+//------------------------------------------------------------------------------
+// Sort the owned cells and edges into interior and boundary lists based on
+// the final local connectivity. Cell neighbors with local index NCellsAll
+// are outside the domain and do not require halo values.
+
+void Decomp::setInteriorLists() {
+
+   // Grow the set of cells near the halo by one layer of owned neighbors
+   // per step, starting from the halo cells
+   const I4 Width = std::min(InteriorWidth, HaloWidth);
+   std::vector<bool> NearHalo(NCellsAll, false);
+   for (int Cell = NCellsOwned; Cell < NCellsAll; ++Cell)
+      NearHalo[Cell] = true;
+   for (int Layer = 0; Layer < Width; ++Layer) {
+      std::vector<bool> NextNearHalo = NearHalo;
+      for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+         for (int J = 0; J < NEdgesOnCellH(Cell); ++J) {
+            I4 NbrCell = CellsOnCellH(Cell, J);
+            if (NbrCell < NCellsAll && NearHalo[NbrCell]) {
+               NextNearHalo[Cell] = true;
+               break;
+            }
+         }
+      }
+      NearHalo.swap(NextNearHalo);
+   }
+
+   std::vector<bool> CellIsInterior(NCellsAll, false);
+   std::vector<I4> IntCells;
+   std::vector<I4> BndCells;
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      bool Interior        = !NearHalo[Cell];
+      CellIsInterior[Cell] = Interior;
+      if (Interior) {
+         IntCells.push_back(Cell);
+      } else {
+         BndCells.push_back(Cell);
+      }
+   }
+
+   // An owned edge is interior if every valid cell on the edge is interior
+   std::vector<I4> IntEdges;
+   std::vector<I4> BndEdges;
+   for (int Edge = 0; Edge < NEdgesOwned; ++Edge) {
+      bool Interior = true;
+      for (int J = 0; J < MaxCellsOnEdge; ++J) {
+         I4 Cell = CellsOnEdgeH(Edge, J);
+         if (Cell < NCellsAll && !CellIsInterior[Cell]) {
+            Interior = false;
+            break;
+         }
+      }
+      if (Interior) {
+         IntEdges.push_back(Edge);
+      } else {
+         BndEdges.push_back(Edge);
+      }
+   }
+
+   NCellsInterior = IntCells.size();
+   NCellsBoundary = BndCells.size();
+   NEdgesInterior = IntEdges.size();
+   NEdgesBoundary = BndEdges.size();
+
+   CellsInteriorH = HostArray1DI4("CellsInterior", NCellsInterior);
+   CellsBoundaryH = HostArray1DI4("CellsBoundary", NCellsBoundary);
+   EdgesInteriorH = HostArray1DI4("EdgesInterior", NEdgesInterior);
+   EdgesBoundaryH = HostArray1DI4("EdgesBoundary", NEdgesBoundary);
+
+   for (int I = 0; I < NCellsInterior; ++I)
+      CellsInteriorH(I) = IntCells[I];
+   for (int I = 0; I < NCellsBoundary; ++I)
+      CellsBoundaryH(I) = BndCells[I];
+   for (int I = 0; I < NEdgesInterior; ++I)
+      EdgesInteriorH(I) = IntEdges[I];
+   for (int I = 0; I < NEdgesBoundary; ++I)
+      EdgesBoundaryH(I) = BndEdges[I];
+
+} // end setInteriorLists
+
+//------------------------------------------------------------------------------
+// Rebuilds the interior and boundary lists for a new interior width
+
+void Decomp::setInteriorWidth(I4 Width) {
+
+   if (Width < 1 or Width > HaloWidth)
+      ABORT_ERROR("Decomp: InteriorWidth {} must be between 1 and the halo "
+                  "width {}",
+                  Width, HaloWidth);
+   if (CellsOnCellH.size() == 0)
+      ABORT_ERROR("Decomp: setInteriorWidth needs the host connectivity, "
+                  "which has been dropped");
+
+   InteriorWidth = Width;
+   setInteriorLists();
+
+   CellsInterior = createDeviceMirrorCopy(CellsInteriorH);
+   CellsBoundary = createDeviceMirrorCopy(CellsBoundaryH);
+   EdgesInterior = createDeviceMirrorCopy(EdgesInteriorH);
+   EdgesBoundary = createDeviceMirrorCopy(EdgesBoundaryH);
+
+   recordMemory();
+
+} // end setInteriorWidth
+
+//------------------------------------------------------------------------------
+// Creates a new decomposition using the constructor and puts it in the
+// AllDecomps map
+Decomp *Decomp::create(
+    const std::string &Name,        //< [in] Name for new decomposition
+    const MachEnv *Env,             //< [in] MachEnv for the new partition
+    I4 NParts,                      //< [in] num of partitions for new decomp
+    PartMethod Method,              //< [in] method for partitioning
+    I4 HaloWidth,                    //< [in] width of halo in new decomp
+    const std::string &MeshFileName, //< [in] name of file with mesh info
+    LocalOrder Order,                //< [in] ordering of local cells
+    PartWeight Weight,               //< [in] weights for partition
+    bool LazyRead,                   //< [in] defer the lazy arrays
+    const std::string &CacheFile     //< [in] partition cache file
+) {
+
+   bool TimerFlag = Pacer::start("Decomp create");
+   // Check to see if a decomposition of the same name already exists and
+   // if so, exit with an error
+   if (AllDecomps.find(Name) != AllDecomps.end()) {
+      LOG_ERROR("Attempted to create a Decomp with name {} but a Decomp of "
+                "that name already exists",
+                Name);
+      return nullptr;
+   }
+
+   // create a new decomp on the heap and put it in a map of
+   // unique_ptrs, which will manage its lifetime
+   auto *NewDecomp =
+       new Decomp(Name, Env, NParts, Method, HaloWidth, MeshFileName, Order,
+                  Weight, LazyRead, CacheFile);
+   AllDecomps.emplace(Name, NewDecomp);
+
+   TimerFlag = Pacer::stop("Decomp create") && TimerFlag;
+   if (!TimerFlag)
+      LOG_WARN("Decomp::create: Error encountered in timers");
+   return NewDecomp;
+} // end Decomp create
+
+// Destructor
+//------------------------------------------------------------------------------
+// Destroys a decomposition and deallocates all arrays
+
+Decomp::~Decomp() {
+
+   // Kokkos arrays removed when no longer in scope, only the memory record
+   // needs to be removed
+   MemoryRegistry::removeModule(MemModule);
+
+} // end decomp destructor
+
+//------------------------------------------------------------------------------
+// Records the sizes of all device and host arrays in the MemoryRegistry
+
+void Decomp::recordMemory() {
+
+   MemoryRegistry::removeModule(MemModule);
+
+   const std::vector<std::pair<std::string, Array1DI4>> Dev1D = {
+       {"NCellsHalo", NCellsHalo},       {"CellID", CellID},
+       {"NEdgesHalo", NEdgesHalo},       {"EdgeID", EdgeID},
+       {"NVerticesHalo", NVerticesHalo}, {"VertexID", VertexID},
+       {"NEdgesOnCell", NEdgesOnCell},   {"NEdgesOnEdge", NEdgesOnEdge},
+       {"CellsInterior", CellsInterior}, {"CellsBoundary", CellsBoundary},
+       {"EdgesInterior", EdgesInterior}, {"EdgesBoundary", EdgesBoundary}};
+   const std::vector<std::pair<std::string, Array2DI4>> Dev2D = {
+       {"CellLoc", CellLoc},
+       {"EdgeLoc", EdgeLoc},
+       {"VertexLoc", VertexLoc},
+       {"CellsOnCell", CellsOnCell},
+       {"EdgesOnCell", EdgesOnCell},
+       {"VerticesOnCell", VerticesOnCell},
+       {"CellsOnEdge", CellsOnEdge},
+       {"EdgesOnEdge", EdgesOnEdge},
+       {"VerticesOnEdge", VerticesOnEdge},
+       {"CellsOnVertex", CellsOnVertex},
+       {"EdgesOnVertex", EdgesOnVertex}};
+   const std::vector<std::pair<std::string, HostArray1DI4>> Host1D = {
+       {"NCellsHaloH", NCellsHaloH},       {"CellIDH", CellIDH},
+       {"NEdgesHaloH", NEdgesHaloH},       {"EdgeIDH", EdgeIDH},
+       {"NVerticesHaloH", NVerticesHaloH}, {"VertexIDH", VertexIDH},
+       {"NEdgesOnCellH", NEdgesOnCellH},   {"NEdgesOnEdgeH", NEdgesOnEdgeH},
+       {"CellsInteriorH", CellsInteriorH}, {"CellsBoundaryH", CellsBoundaryH},
+       {"EdgesInteriorH", EdgesInteriorH}, {"EdgesBoundaryH", EdgesBoundaryH}};
+   const std::vector<std::pair<std::string, HostArray2DI4>> Host2D = {
+       {"CellLocH", CellLocH},
+       {"EdgeLocH", EdgeLocH},
+       {"VertexLocH", VertexLocH},
+       {"CellsOnCellH", CellsOnCellH},
+       {"EdgesOnCellH", EdgesOnCellH},
+       {"VerticesOnCellH", VerticesOnCellH},
+       {"CellsOnEdgeH", CellsOnEdgeH},
+       {"EdgesOnEdgeH", EdgesOnEdgeH},
+       {"VerticesOnEdgeH", VerticesOnEdgeH},
+       {"CellsOnVertexH", CellsOnVertexH},
+       {"EdgesOnVertexH", EdgesOnVertexH}};
+
+   // Arrays that are not allocated (eg a deferred EdgesOnEdge) have no size
+   for (const auto &[ArrayName, Array] : Dev1D)
+      MemoryRegistry::add(MemModule, ArrayName, Array);
+   for (const auto &[ArrayName, Array] : Dev2D)
+      MemoryRegistry::add(MemModule, ArrayName, Array);
+   for (const auto &[ArrayName, Array] : Host1D)
+      MemoryRegistry::add(MemModule, ArrayName, Array);
+   for (const auto &[ArrayName, Array] : Host2D)
+      MemoryRegistry::add(MemModule, ArrayName, Array);
+
+} // end recordMemory
+
+//------------------------------------------------------------------------------
+// Frees the host copies of the arrays only needed during mesh initialization
+
+void Decomp::dropHostMirrors() {
+
+   CellsOnCellH    = HostArray2DI4();
+   EdgesOnCellH    = HostArray2DI4();
+   NEdgesOnCellH   = HostArray1DI4();
+   VerticesOnCellH = HostArray2DI4();
+   CellsOnEdgeH    = HostArray2DI4();
+   VerticesOnEdgeH = HostArray2DI4();
+   CellsOnVertexH  = HostArray2DI4();
+   CellsInteriorH  = HostArray1DI4();
+   CellsBoundaryH  = HostArray1DI4();
+   EdgesInteriorH  = HostArray1DI4();
+   EdgesBoundaryH  = HostArray1DI4();
+
+   // A deferred EdgesOnEdge is still needed on the host when it is loaded
+   if (EdgesOnEdgeLoaded) {
+      EdgesOnEdgeH  = HostArray2DI4();
+      NEdgesOnEdgeH = HostArray1DI4();
+   }
+   if (EdgesOnVertexLoaded)
+      EdgesOnVertexH = HostArray2DI4();
+
+   recordMemory();
+
+} // end dropHostMirrors
+
+//------------------------------------------------------------------------------
+// Removes a decomposition from list and destroys it
+
+void Decomp::erase(std::string InName // [in] name of decomp to remove
+) {
+
+   AllDecomps.erase(InName); // removes the decomp from the list (map) and in
                              // the process, calls the destructor
 
 } // end decomp erase
@@ -917,6 +1952,237 @@ void Decomp::partCellsSingleTask() {
    }
 } // end function partCellsSingleTask
 
+//------------------------------------------------------------------------------
+// Layout of the partition cache file. The file starts with NCacheHeader I8
+// values identifying the mesh and decomposition options, followed by the
+// byte offset of the record for each task. Each task record holds
+// NCellsOwned, NCellsAll, the NCellsHalo array, CellID and the (task, local
+// address) pairs of CellLoc as I4 values.
+
+static constexpr I8 CacheMagic    = 0x4f6d656761504368; // "OmegaPCh"
+static constexpr I8 CacheVersion  = 1;
+static constexpr int NCacheHeader = 9;
+
+static void setCacheHeader(I8 *Header,                 // [out] header values
+                           std::uint64_t MeshChecksum, // [in] mesh checksum
+                           I4 NumTasks,                // [in] number of tasks
+                           I4 NCellsGlobal,            // [in] global cells
+                           I4 HaloWidth,               // [in] halo width
+                           PartMethod Method,          // [in] part method
+                           LocalOrder Order,           // [in] local order
+                           PartWeight Weight           // [in] part weights
+) {
+   Header[0] = CacheMagic;
+   Header[1] = CacheVersion;
+   Header[2] = static_cast<I8>(MeshChecksum);
+   Header[3] = NumTasks;
+   Header[4] = NCellsGlobal;
+   Header[5] = HaloWidth;
+   Header[6] = Method;
+   Header[7] = Order;
+   Header[8] = Weight;
+}
+
+//------------------------------------------------------------------------------
+// Read the cell decomposition from a partition cache file. All tasks agree
+// on whether the cache is used so that the collective partitioning is
+// either skipped or called by every task.
+
+int Decomp::readDecompCache(
+    const MachEnv *InEnv,         // [in] MachEnv with MPI info
+    const std::string &CacheFile, // [in] name of partition cache file
+    std::uint64_t MeshChecksum,   // [in] checksum of mesh connectivity
+    PartMethod Method,            // [in] method for partitioning
+    LocalOrder Order,             // [in] ordering of local cells
+    PartWeight Weight             // [in] weights for partition
+) {
+
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   MPI_File File;
+   int Err = MPI_File_open(Comm, CacheFile.c_str(), MPI_MODE_RDONLY,
+                           MPI_INFO_NULL, &File);
+   if (Err != MPI_SUCCESS) {
+      LOG_INFO("Decomp: partition cache {} not found, partitioning mesh",
+               CacheFile);
+      return 1;
+   }
+
+   // Check the header against the mesh and options of this run
+   I8 Header[NCacheHeader] = {0};
+   I8 Expected[NCacheHeader];
+   setCacheHeader(Expected, MeshChecksum, NumTasks, NCellsGlobal, HaloWidth,
+                  Method, Order, Weight);
+   Err = MPI_File_read_at_all(File, 0, Header, NCacheHeader, MPI_INT64_T,
+                              MPI_STATUS_IGNORE);
+   int LocalErr = 0;
+   int GlobalErr;
+   if (Err != MPI_SUCCESS or
+       !std::equal(Header, Header + NCacheHeader, Expected))
+      LocalErr = 1;
+   MPI_Allreduce(&LocalErr, &GlobalErr, 1, MPI_INT, MPI_MAX, Comm);
+   if (GlobalErr != 0) {
+      MPI_File_close(&File);
+      LOG_INFO("Decomp: partition cache {} does not match this mesh or "
+               "configuration, partitioning mesh",
+               CacheFile);
+      return 1;
+   }
+
+   // Read the offset of the record for this task and its sizes
+   MPI_Offset TableStart = NCacheHeader * sizeof(I8);
+   I8 RecordStart        = 0;
+   I4 Sizes[2]           = {0, 0};
+   Err = MPI_File_read_at_all(File, TableStart + MyTask * sizeof(I8),
+                              &RecordStart, 1, MPI_INT64_T, MPI_STATUS_IGNORE);
+   if (Err == MPI_SUCCESS)
+      Err = MPI_File_read_at_all(File, RecordStart, Sizes, 2, MPI_INT32_T,
+                                 MPI_STATUS_IGNORE);
+   LocalErr = (Err != MPI_SUCCESS or Sizes[0] < 0 or Sizes[1] < Sizes[0] or
+               Sizes[1] > NCellsGlobal);
+
+   // Read the rest of the record even on a failure above, since the read
+   // is collective
+   I4 NRecord = LocalErr == 0 ? HaloWidth + 3 * Sizes[1] : 0;
+   std::vector<I4> Record(NRecord);
+   Err = MPI_File_read_at_all(File, RecordStart + 2 * sizeof(I4),
+                              Record.data(), NRecord, MPI_INT32_T,
+                              MPI_STATUS_IGNORE);
+   MPI_File_close(&File);
+   if (Err != MPI_SUCCESS)
+      LocalErr = 1;
+
+   // Check the record is a valid decomposition of this mesh
+   I4 NOwned = Sizes[0];
+   I4 NAll   = Sizes[1];
+   if (LocalErr == 0) {
+      I4 Prev = NOwned;
+      for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+         if (Record[Halo] < Prev)
+            LocalErr = 1;
+         Prev = Record[Halo];
+      }
+      if (Prev != NAll)
+         LocalErr = 1;
+      for (int Cell = 0; Cell < NAll; ++Cell) {
+         I4 ID   = Record[HaloWidth + Cell];
+         I4 Task = Record[HaloWidth + NAll + 2 * Cell];
+         if (ID < 1 or ID > NCellsGlobal or Task < 0 or Task >= NumTasks)
+            LocalErr = 1;
+      }
+   }
+   MPI_Allreduce(&LocalErr, &GlobalErr, 1, MPI_INT, MPI_MAX, Comm);
+   if (GlobalErr != 0) {
+      LOG_WARN("Decomp: invalid partition cache {}, partitioning mesh",
+               CacheFile);
+      return 1;
+   }
+
+   // Copy the record into the cell decomposition
+   NCellsOwned = NOwned;
+   NCellsAll   = NAll;
+   NCellsSize  = NCellsAll + 1; // extra entry to store boundary value
+
+   NCellsHaloH = HostArray1DI4("NCellsHalo", HaloWidth);
+   for (int Halo = 0; Halo < HaloWidth; ++Halo)
+      NCellsHaloH(Halo) = Record[Halo];
+
+   CellIDH  = HostArray1DI4("CellID", NCellsSize);
+   CellLocH = HostArray2DI4("CellLoc", NCellsSize, 2);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      CellIDH(Cell)     = Record[HaloWidth + Cell];
+      CellLocH(Cell, 0) = Record[HaloWidth + NCellsAll + 2 * Cell];
+      CellLocH(Cell, 1) = Record[HaloWidth + NCellsAll + 2 * Cell + 1];
+   }
+
+   return 0;
+
+} // end readDecompCache
+
+//------------------------------------------------------------------------------
+// Write the cell decomposition to a partition cache file. The records of
+// all tasks are written in task order after the header and offset table.
+
+int Decomp::writeDecompCache(
+    const MachEnv *InEnv,         // [in] MachEnv with MPI info
+    const std::string &CacheFile, // [in] name of partition cache file
+    std::uint64_t MeshChecksum,   // [in] checksum of mesh connectivity
+    PartMethod Method,            // [in] method for partitioning
+    LocalOrder Order,             // [in] ordering of local cells
+    PartWeight Weight             // [in] weights for partition
+) {
+
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+   bool IsMaster = InEnv->isMasterTask();
+
+   // Pack the record for this task
+   std::vector<I4> Record;
+   Record.reserve(2 + HaloWidth + 3 * NCellsAll);
+   Record.push_back(NCellsOwned);
+   Record.push_back(NCellsAll);
+   for (int Halo = 0; Halo < HaloWidth; ++Halo)
+      Record.push_back(NCellsHaloH(Halo));
+   for (int Cell = 0; Cell < NCellsAll; ++Cell)
+      Record.push_back(CellIDH(Cell));
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      Record.push_back(CellLocH(Cell, 0));
+      Record.push_back(CellLocH(Cell, 1));
+   }
+
+   // The records follow the header and offset table in task order
+   I8 RecordBytes  = Record.size() * sizeof(I4);
+   I8 RecordOffset = 0;
+   MPI_Exscan(&RecordBytes, &RecordOffset, 1, MPI_INT64_T, MPI_SUM, Comm);
+   if (MyTask == 0) // Exscan result is undefined on the first task
+      RecordOffset = 0;
+   MPI_Offset TableStart = NCacheHeader * sizeof(I8);
+   I8 RecordStart        = TableStart + NumTasks * sizeof(I8) + RecordOffset;
+
+   MPI_File File;
+   int Err = MPI_File_open(Comm, CacheFile.c_str(),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                           &File);
+   if (Err != MPI_SUCCESS)
+      return 1;
+
+   // Remove any previous contents, then write the header from the master
+   // and the offset and record from every task
+   int LocalErr = 0;
+   if (MPI_File_set_size(File, 0) != MPI_SUCCESS)
+      LocalErr = 1;
+   if (IsMaster) {
+      I8 Header[NCacheHeader];
+      setCacheHeader(Header, MeshChecksum, NumTasks, NCellsGlobal, HaloWidth,
+                     Method, Order, Weight);
+      Err = MPI_File_write_at(File, 0, Header, NCacheHeader, MPI_INT64_T,
+                              MPI_STATUS_IGNORE);
+      if (Err != MPI_SUCCESS)
+         LocalErr = 1;
+   }
+   Err = MPI_File_write_at_all(File, TableStart + MyTask * sizeof(I8),
+                               &RecordStart, 1, MPI_INT64_T,
+                               MPI_STATUS_IGNORE);
+   if (Err != MPI_SUCCESS)
+      LocalErr = 1;
+   Err = MPI_File_write_at_all(File, RecordStart, Record.data(),
+                               Record.size(), MPI_INT32_T, MPI_STATUS_IGNORE);
+   if (Err != MPI_SUCCESS)
+      LocalErr = 1;
+   MPI_File_close(&File);
+
+   int GlobalErr;
+   MPI_Allreduce(&LocalErr, &GlobalErr, 1, MPI_INT, MPI_MAX, Comm);
+   if (GlobalErr == 0)
+      LOG_INFO("Decomp: cell decomposition written to cache {}", CacheFile);
+
+   return GlobalErr;
+
+} // end writeDecompCache
+
 //------------------------------------------------------------------------------
 // Partition the cells using the Metis/ParMetis KWay method
 // After this partitioning, the decomposition class member CellID and
@@ -925,55 +2191,79 @@ void Decomp::partCellsSingleTask() {
 
 int Decomp::partCellsKWay(
     const MachEnv *InEnv, // [in] input machine environment with MPI info
-    const std::vector<I4> &CellsOnCellInit // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellWgtInit,     // [in] cell wgts in linear distrb
+    I4 NConstraints                         // [in] number of weights per cell
 ) {
 
    int Err = 0; // initialize return code
 
    // Retrieve some info on the MPI layout
-   MPI_Comm Comm = InEnv->getComm();
-   I4 NumTasks   = InEnv->getNumTasks();
-   I4 MyTask     = InEnv->getMyTask();
-   I4 MasterTask = InEnv->getMasterTask();
-   bool IsMaster = InEnv->isMasterTask();
+   I4 NumTasks = InEnv->getNumTasks();
+   I4 MyTask   = InEnv->getMyTask();
 
    // TEMPORARY:
    // Due to difficulties with ParMetis, we use serial Metis for now with
-   // each task calling the serial form with the global adjacency data.
+   // each node calling the serial form with the global adjacency data.
    // This requires us to communicate the CellsOnCell data and pack it
    // into the Metis structure.
 
-   // Allocate adjacency arrays and a buffer for portions of the CellsOnCell
-   // array.
-   std::vector<idx_t> AdjAdd(NCellsGlobal + 1, 0);
-   std::vector<idx_t> Adjacency(2 * NEdgesGlobal, 0);
+   // The global adjacency graph and the resulting partition are identical
+   // on all tasks, so they are built once per node in a window of memory
+   // shared by the tasks on the node. Only the node leader receives the
+   // global CellsOnCell and weights, builds the graph and calls METIS, and
+   // the other tasks on the node read the results directly from the
+   // leader's memory.
+   MPI_Comm NodeComm   = InEnv->getNodeComm();
+   bool IsNodeLeader   = InEnv->isNodeLeader();
+   MPI_Aint NAdjAdd    = NCellsGlobal + 1;
+   MPI_Aint NAdjacency = 2 * NEdgesGlobal;
+   MPI_Aint NShared    = NAdjAdd + NAdjacency + NCellsGlobal;
+   MPI_Aint WinBytes   = IsNodeLeader ? NShared * sizeof(idx_t) : 0;
+   idx_t *SharedBuf    = nullptr;
+   MPI_Win SharedWin;
+   Err = MPI_Win_allocate_shared(WinBytes, sizeof(idx_t), MPI_INFO_NULL,
+                                 NodeComm, &SharedBuf, &SharedWin);
+   if (Err != MPI_SUCCESS) {
+      LOG_CRITICAL("Decomp: Error allocating shared adjacency window");
+      return Err;
+   }
+   if (!IsNodeLeader) {
+      MPI_Aint LeaderBytes;
+      int DispUnit;
+      MPI_Win_shared_query(SharedWin, 0, &LeaderBytes, &DispUnit, &SharedBuf);
+   } else {
+      std::fill(SharedBuf, SharedBuf + NShared, 0);
+   }
+   MPI_Win_fence(0, SharedWin);
+
+   // Adjacency arrays and partition in the shared window
+   idx_t *AdjAdd      = SharedBuf;
+   idx_t *Adjacency   = AdjAdd + NAdjAdd;
+   idx_t *CellTask    = Adjacency + NAdjacency;
    I4 NCellsChunk     = (NCellsGlobal - 1) / NumTasks + 1;
    I4 CellsOnCellSize = NCellsChunk * MaxEdges;
-   std::vector<I4> CellsOnCellBuf(CellsOnCellSize, 0);
 
    // This is an address counter needed to keep track of the starting
    // address for each cell in the packed adjacency array.
    I4 Add = 0;
 
-   // One at a time, each task broadcasts its portion of the CellsOnCell data
-   // and then unpacks it into the adjacency array in the packed form needed
-   // by METIS/ParMETIS
+   // Gather the CellsOnCell chunks of all tasks on the node leaders, which
+   // unpack them into the adjacency array in the packed form needed by
+   // METIS/ParMETIS
    bool TimerFlag = Pacer::start("Gather adjacency");
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      // If it is this task's turn, pack up the CellsOnCell data and broadcast
-      // to other tasks.
-      if (MyTask == Task) {
-         for (int n = 0; n < CellsOnCellSize; ++n) {
-            CellsOnCellBuf[n] = CellsOnCellInit[n];
-         } // end loop CellsOnCell
-      } // end if this is MyTask
-      Err = MPI_Bcast(&CellsOnCellBuf[0], CellsOnCellSize, MPI_INT32_T, Task,
-                      Comm);
-      if (Err != 0) {
-         LOG_CRITICAL("Decomp: Error communicating CellsOnCell info");
-         return Err;
-      }
+   R8 GatherStart = MPI_Wtime();
+   std::vector<I4> AllCellsOnCell;
+   Err = gatherOnLeaders(InEnv, CellsOnCellInit.data(), CellsOnCellSize,
+                         AllCellsOnCell);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating CellsOnCell info");
+      MPI_Win_free(&SharedWin);
+      return Err;
+   }
+
+   // Only the node leader builds the shared graph
+   for (int Task = 0; IsNodeLeader and Task < NumTasks; ++Task) {
 
       // Create the adjacency graph by aggregating the individual
       // chunks. Prune edges that don't have neighbors.
@@ -987,8 +2277,8 @@ int Decomp::partCellsKWay(
 
          AdjAdd[CellGlob] = Add; // start add for cell in Adjacency array
          for (int Edge = 0; Edge < MaxEdges; ++Edge) {
-            I4 BufAdd  = Cell * MaxEdges + Edge;
-            I4 NbrCell = CellsOnCellBuf[BufAdd];
+            I4 BufAdd  = Task * CellsOnCellSize + Cell * MaxEdges + Edge;
+            I4 NbrCell = AllCellsOnCell[BufAdd];
             // Skip edges with no neighbors
             if (NbrCell > 0 && NbrCell <= NCellsGlobal) {
                // switch to 0-based indx
@@ -999,19 +2289,42 @@ int Decomp::partCellsKWay(
       } // end cell loop for buffer
    } // end task loop
 
-   AdjAdd[NCellsGlobal] = Add; // Add the ending address
-   TimerFlag            = Pacer::stop("Gather adjacency") && TimerFlag;
+   if (IsNodeLeader)
+      AdjAdd[NCellsGlobal] = Add; // Add the ending address
+   AllCellsOnCell.clear();
+   AllCellsOnCell.shrink_to_fit();
+   TimerFlag  = Pacer::stop("Gather adjacency") && TimerFlag;
+   GatherTime = MPI_Wtime() - GatherStart;
+
+   // If a weighted partition is requested, gather the cell weights from
+   // the linear distribution on the node leaders. Each task holds a full
+   // chunk of weights so the chunks are contiguous in cell order.
+   std::vector<idx_t> VrtxWgt;
+   if (!CellWgtInit.empty()) {
+      TimerFlag   = Pacer::start("Gather weights") && TimerFlag;
+      I4 WgtChunk = NCellsChunk * NConstraints;
+      std::vector<I4> AllWgts;
+      Err = gatherOnLeaders(InEnv, CellWgtInit.data(), WgtChunk, AllWgts);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error communicating partition weights");
+         MPI_Win_free(&SharedWin);
+         return Err;
+      }
+      if (IsNodeLeader)
+         VrtxWgt.assign(AllWgts.begin(),
+                        AllWgts.begin() + NCellsGlobal * NConstraints);
+      TimerFlag = Pacer::stop("Gather weights") && TimerFlag;
+   }
 
    // Set up remaining partitioning variables
 
-   // NConstraints is the number of balancing constraints, mostly for
-   // use when multiple vertex weights are assigned. Must be at least 1.
-   // We do not yet support weighted partitions
-   idx_t NConstraints = 1;
+   // NConstraints is the number of balancing constraints, used when
+   // multiple vertex weights are assigned. Must be at least 1.
+   idx_t NConstraintsMetis = NConstraints;
 
    // Arrays needed for weighted decompositions. If no weighting used
    // set pointers to null.
-   idx_t *VrtxWgtPtr{nullptr};
+   idx_t *VrtxWgtPtr = VrtxWgt.empty() ? nullptr : VrtxWgt.data();
    idx_t *EdgeWgtPtr{nullptr};
    idx_t *VrtxSize{nullptr};
 
@@ -1020,35 +2333,42 @@ int Decomp::partCellsKWay(
 
    // These are for multi-constraint partitions where the vertex weight
    // has to be distributed among the multiple constraints.
-   // We do not use them so set them to null
+   // We use the METIS defaults (equal targets) so set them to null
    real_t *TpWgts{nullptr};
    real_t *Ubvec{nullptr};
 
-   // Results are stored in a new partition array which returns
+   // Results are stored in the shared partition array which returns
    // the processor (partition) assigned to the cell (vrtx)
    // The routine also returns the number of edge cuts in the partition
-   std::vector<idx_t> CellTask(NCellsGlobal);
    idx_t Edgecut = 0;
 
    // Convert to idx_t from Omega::I4, in case these aren't the same
    idx_t NCellsMetis   = NCellsGlobal;
    idx_t NumTasksMetis = NumTasks;
 
-   // Call METIS routine to partition the mesh
+   // Call METIS routine to partition the mesh on the node leader. The
+   // fence makes the partition visible to the other tasks on the node.
    // METIS routines are C code that expect pointers, so we use the
-   // idiom &Var[0] to extract the pointer to the data in std::vector
-   TimerFlag    = Pacer::start("Metis partitioning") && TimerFlag;
-   int MetisErr = METIS_PartGraphKway(&NCellsMetis, &NConstraints, &AdjAdd[0],
-                                      &Adjacency[0], VrtxWgtPtr, VrtxSize,
-                                      EdgeWgtPtr, &NumTasksMetis, TpWgts, Ubvec,
-                                      Options, &Edgecut, &CellTask[0]);
+   // idiom &Var[0] to extract the pointer to the data
+   TimerFlag     = Pacer::start("Metis partitioning") && TimerFlag;
+   R8 MetisStart = MPI_Wtime();
+   int MetisErr  = METIS_OK;
+   if (IsNodeLeader)
+      MetisErr = METIS_PartGraphKway(
+          &NCellsMetis, &NConstraintsMetis, &AdjAdd[0], &Adjacency[0],
+          VrtxWgtPtr, VrtxSize, EdgeWgtPtr, &NumTasksMetis, TpWgts, Ubvec,
+          Options, &Edgecut, &CellTask[0]);
+   MPI_Bcast(&MetisErr, 1, MPI_INT, 0, NodeComm);
+   MPI_Win_fence(0, SharedWin);
 
    if (MetisErr != METIS_OK) {
       LOG_CRITICAL("Decomp: Error in ParMETIS");
+      MPI_Win_free(&SharedWin);
       Err = -1;
       return Err;
    }
    TimerFlag = Pacer::stop("Metis partitioning") && TimerFlag;
+   MetisTime = MPI_Wtime() - MetisStart;
 
    // Determine the initial sizes needed by address arrays
 
@@ -1157,6 +2477,9 @@ int Decomp::partCellsKWay(
    NCellsAll  = NCellsHaloTmp(HaloWidth - 1);
    NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
 
+   // The shared graph and partition are no longer needed
+   MPI_Win_free(&SharedWin);
+
    // The cell decomposition is now complete, copy the information
    // into the final locations as class members on host (copy to device later)
 
@@ -1182,6 +2505,500 @@ int Decomp::partCellsKWay(
 
 } // end function partCellsKWay
 
+//------------------------------------------------------------------------------
+// Partition the cells using the distributed ParMetis KWay method. Each task
+// supplies the adjacency of the cells it holds in the initial linear
+// distribution and receives the partition for those cells. The final cell
+// decomposition is then constructed by setCellsFromPartition.
+
+int Decomp::partCellsParMetisKWay(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellWgtInit,     // [in] cell wgts in linear distrb
+    I4 NConstraints                         // [in] number of weights per cell
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   // The distribution of cells across tasks in the initial linear
+   // distribution. ParMETIS requires every task to hold at least one cell.
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   if (NCellsChunk * (NumTasks - 1) >= NCellsGlobal) {
+      LOG_CRITICAL("Decomp: too many tasks for ParMetis partition of {} cells",
+                   NCellsGlobal);
+      return -1;
+   }
+   std::vector<idx_t> VtxDist(NumTasks + 1);
+   for (int Task = 0; Task < NumTasks; ++Task)
+      VtxDist[Task] = Task * NCellsChunk;
+   VtxDist[NumTasks] = NCellsGlobal;
+   I4 NCellsLocal    = VtxDist[MyTask + 1] - VtxDist[MyTask];
+
+   // Create the local portion of the adjacency graph in the packed form
+   // needed by ParMETIS. Prune edges that don't have neighbors.
+   std::vector<idx_t> AdjAdd(NCellsLocal + 1, 0);
+   std::vector<idx_t> Adjacency;
+   Adjacency.reserve(NCellsLocal * MaxEdges);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      AdjAdd[Cell] = Adjacency.size();
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         I4 NbrCell = CellsOnCellInit[Cell * MaxEdges + Edge];
+         if (validCellID(NbrCell))
+            Adjacency.push_back(NbrCell - 1); // switch to 0-based indx
+      }
+   }
+   AdjAdd[NCellsLocal] = Adjacency.size();
+
+   // Set up remaining partitioning variables. Vertex weights are only
+   // used if a weighted partition was requested and edges are unweighted.
+   std::vector<idx_t> VrtxWgt;
+   if (!CellWgtInit.empty())
+      VrtxWgt.assign(CellWgtInit.begin(),
+                     CellWgtInit.begin() + NCellsLocal * NConstraints);
+   idx_t WgtFlag           = VrtxWgt.empty() ? 0 : 2; // vertex weights only
+   idx_t NumFlag           = 0;                       // 0-based numbering
+   idx_t NConstraintsMetis = NConstraints;
+   idx_t NParts            = NumTasks;
+   idx_t *VrtxWgtPtr       = VrtxWgt.empty() ? nullptr : VrtxWgt.data();
+   idx_t *EdgeWgtPtr{nullptr};
+
+   // ParMETIS requires the target partition weights and the load imbalance
+   // tolerance even for a uniform partition
+   std::vector<real_t> TpWgts(NConstraintsMetis * NParts, 1.0 / NParts);
+   std::vector<real_t> Ubvec(NConstraintsMetis, 1.05);
+
+   // Use default ParMETIS options
+   idx_t Options[3] = {0, 0, 0};
+
+   // The task assigned to each cell in the local portion and the number of
+   // edge cuts in the partition
+   std::vector<idx_t> CellTaskLocal(NCellsLocal);
+   idx_t Edgecut = 0;
+
+   bool TimerFlag = Pacer::start("ParMetis partitioning");
+   int MetisErr   = ParMETIS_V3_PartKway(
+       &VtxDist[0], &AdjAdd[0], Adjacency.data(), VrtxWgtPtr, EdgeWgtPtr,
+       &WgtFlag, &NumFlag, &NConstraintsMetis, &NParts, &TpWgts[0], &Ubvec[0],
+       Options, &Edgecut, &CellTaskLocal[0], &Comm);
+   TimerFlag = Pacer::stop("ParMetis partitioning") && TimerFlag;
+
+   if (MetisErr != METIS_OK) {
+      LOG_CRITICAL("Decomp: Error in ParMETIS");
+      Err = -1;
+      return Err;
+   }
+
+   // Convert to Omega::I4 from idx_t, in case these aren't the same
+   std::vector<I4> CellTaskInit(CellTaskLocal.begin(), CellTaskLocal.end());
+
+   Err = setCellsFromPartition(InEnv, CellsOnCellInit, CellTaskInit);
+
+   if (!TimerFlag)
+      LOG_WARN("Decomp::partCellsParMetisKWay: Error in timers");
+   return Err;
+
+} // end function partCellsParMetisKWay
+
+//------------------------------------------------------------------------------
+// Partition the cells along a Hilbert space-filling curve. The cell center
+// coordinates are read in the initial linear distribution and mapped to an
+// index along the curve. The cells are then sorted by this index with a
+// parallel sample sort and the sorted sequence is split into NumTasks
+// contiguous sections of nearly equal size (or nearly equal weight if cell
+// weights are supplied). The resulting partition is returned to the tasks
+// holding each cell in the initial distribution and the final cell
+// decomposition is constructed by setCellsFromPartition.
+
+int Decomp::partCellsSFC(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellWgtInit,     // [in] cell wgts in linear distrb
+    I4 NConstraints                         // [in] number of weights per cell
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   // Sizes of the initial linear distribution
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 CellStart   = std::min(MyTask * NCellsChunk, NCellsGlobal);
+   I4 CellEnd     = std::min(CellStart + NCellsChunk, NCellsGlobal);
+   I4 NCellsLocal = CellEnd - CellStart;
+
+   // Read the cell center coordinates in the initial distribution
+   bool TimerFlag = Pacer::start("SFC read coordinates");
+   int FileID;
+   Err = IO::openFile(FileID, MeshFileName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: error opening mesh file for SFC partition");
+      return Err;
+   }
+
+   std::vector<I4> CoordDims{NCellsGlobal};
+   std::vector<I4> CoordOffset(NCellsChunk, -1);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+      CoordOffset[Cell] = CellStart + Cell;
+   I4 CoordDecomp;
+   Err = IO::createDecomp(CoordDecomp, IO::IOTypeR8, 1, CoordDims,
+                          NCellsChunk, CoordOffset, IO::RearrBox);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: error creating cell coordinate IO decomposition");
+      return Err;
+   }
+
+   // Coordinates are read under the Omega name and then the older MPAS name
+   const std::string CoordNames[3]    = {"XCell", "YCell", "ZCell"};
+   const std::string CoordNamesOld[3] = {"xCell", "yCell", "zCell"};
+   std::vector<R8> Coords[3];
+   for (int Dim = 0; Dim < 3; ++Dim) {
+      Coords[Dim].resize(NCellsChunk, 0.0);
+      int CoordID;
+      Err = IO::readArray(&Coords[Dim][0], NCellsChunk, CoordNames[Dim],
+                          FileID, CoordDecomp, CoordID);
+      if (Err != 0) { // not found, try again under older name
+         Err = IO::readArray(&Coords[Dim][0], NCellsChunk, CoordNamesOld[Dim],
+                             FileID, CoordDecomp, CoordID);
+         if (Err != 0) {
+            LOG_CRITICAL("Decomp: error reading {}", CoordNamesOld[Dim]);
+            return Err;
+         }
+      }
+   }
+   Err = IO::destroyDecomp(CoordDecomp);
+   if (Err != 0)
+      LOG_ERROR("Decomp: error destroying cell coordinate decomposition");
+   Err = IO::closeFile(FileID);
+   if (Err != 0)
+      LOG_ERROR("Decomp: error closing mesh file after SFC read");
+   TimerFlag = Pacer::stop("SFC read coordinates") && TimerFlag;
+
+   // Scale the coordinates by the global bounding box and compute the
+   // index of each local cell along the curve
+   TimerFlag = Pacer::start("SFC sort") && TimerFlag;
+   R8 CoordMin[3];
+   R8 CoordMax[3];
+   for (int Dim = 0; Dim < 3; ++Dim) {
+      CoordMin[Dim] = std::numeric_limits<R8>::max();
+      CoordMax[Dim] = std::numeric_limits<R8>::lowest();
+      for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+         CoordMin[Dim] = std::min(CoordMin[Dim], Coords[Dim][Cell]);
+         CoordMax[Dim] = std::max(CoordMax[Dim], Coords[Dim][Cell]);
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, CoordMin, 3, MPI_DOUBLE, MPI_MIN, Comm);
+   MPI_Allreduce(MPI_IN_PLACE, CoordMax, 3, MPI_DOUBLE, MPI_MAX, Comm);
+
+   const I4 NBits  = 21; // bits per coordinate, 3*NBits < 64
+   const I4 MaxInt = (1 << NBits) - 1;
+
+   // Local (curve index, cell ID) pairs. Including the cell ID gives a
+   // unique ordering for cells with the same curve index.
+   std::vector<std::pair<I8, I4>> Keys(NCellsLocal);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      I4 X[3];
+      for (int Dim = 0; Dim < 3; ++Dim) {
+         R8 Range = CoordMax[Dim] - CoordMin[Dim];
+         R8 Frac  = Range > 0.0 ? (Coords[Dim][Cell] - CoordMin[Dim]) / Range
+                                : 0.0;
+         X[Dim]   = std::min(static_cast<I4>(Frac * MaxInt), MaxInt);
+      }
+      Keys[Cell] = std::make_pair(hilbertIndex(X, NBits), CellStart + Cell + 1);
+   }
+   std::sort(Keys.begin(), Keys.end());
+
+   // Choose NumTasks-1 splitters from regular samples of the locally sorted
+   // keys on all tasks
+   std::vector<I8> Samples(NumTasks - 1, std::numeric_limits<I8>::max());
+   for (int I = 0; I < NumTasks - 1 && NCellsLocal > 0; ++I)
+      Samples[I] = Keys[((I + 1) * NCellsLocal) / NumTasks].first;
+   std::vector<I8> AllSamples(NumTasks * (NumTasks - 1));
+   Err = MPI_Allgather(Samples.data(), NumTasks - 1, MPI_INT64_T,
+                       AllSamples.data(), NumTasks - 1, MPI_INT64_T, Comm);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error gathering SFC samples");
+      return Err;
+   }
+   std::sort(AllSamples.begin(), AllSamples.end());
+   std::vector<I8> Splitters(NumTasks - 1);
+   for (int I = 0; I < NumTasks - 1; ++I)
+      Splitters[I] = AllSamples[(I + 1) * (NumTasks - 1)];
+
+   // Send each key to the task responsible for its section of the curve.
+   // Since the local keys are sorted, the buckets are contiguous.
+   // The first weight of each cell travels with its key. Unweighted cells
+   // have unit weight.
+   std::vector<I4> SendCounts(NumTasks, 0);
+   std::vector<I8> SendIndex(NCellsLocal);
+   std::vector<I4> SendID(NCellsLocal);
+   std::vector<I4> SendWgt(NCellsLocal, 1);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      I4 Task = std::upper_bound(Splitters.begin(), Splitters.end(),
+                                 Keys[Cell].first) -
+                Splitters.begin();
+      ++SendCounts[Task];
+      SendIndex[Cell] = Keys[Cell].first;
+      SendID[Cell]    = Keys[Cell].second;
+      if (!CellWgtInit.empty())
+         SendWgt[Cell] = CellWgtInit[(SendID[Cell] - 1 - CellStart) *
+                                     NConstraints];
+   }
+   std::vector<I8> BucketIndex;
+   std::vector<I4> BucketID;
+   std::vector<I4> BucketWgt;
+   std::vector<I4> BucketCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT64_T, SendIndex, SendCounts,
+                       BucketIndex, BucketCounts);
+   Err += alltoallvData(Comm, NumTasks, MPI_INT32_T, SendID, SendCounts,
+                        BucketID, BucketCounts);
+   Err += alltoallvData(Comm, NumTasks, MPI_INT32_T, SendWgt, SendCounts,
+                        BucketWgt, BucketCounts);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error redistributing SFC keys");
+      return Err;
+   }
+
+   // Sort the bucket by (curve index, cell ID) keeping each cell weight
+   I4 NBucket = BucketID.size();
+   std::vector<std::pair<std::pair<I8, I4>, I4>> Bucket(NBucket);
+   for (int I = 0; I < NBucket; ++I)
+      Bucket[I] = std::make_pair(std::make_pair(BucketIndex[I], BucketID[I]),
+                                 BucketWgt[I]);
+   std::sort(Bucket.begin(), Bucket.end());
+
+   // The cumulative weight preceding each cell in the global sorted
+   // sequence determines the task it is assigned to. Each task is assigned
+   // a contiguous section of the sorted sequence with nearly equal weight
+   // (an equal number of cells for unit weights).
+   I8 BucketWgtSum = 0;
+   for (int I = 0; I < NBucket; ++I)
+      BucketWgtSum += Bucket[I].second;
+   I8 BucketStart = 0;
+   I8 TotalWgt    = 0;
+   MPI_Exscan(&BucketWgtSum, &BucketStart, 1, MPI_INT64_T, MPI_SUM, Comm);
+   if (MyTask == 0)
+      BucketStart = 0; // Exscan result is undefined on the first task
+   MPI_Allreduce(&BucketWgtSum, &TotalWgt, 1, MPI_INT64_T, MPI_SUM, Comm);
+   TimerFlag = Pacer::stop("SFC sort") && TimerFlag;
+
+   // Return the assigned task to the task holding each cell in the initial
+   // distribution as (cell ID, task) pairs
+   std::vector<I4> ReplyCounts(NumTasks, 0);
+   for (int I = 0; I < NBucket; ++I)
+      ReplyCounts[(Bucket[I].first.second - 1) / NCellsChunk] += 2;
+   std::vector<I4> ReplyNext(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task)
+      ReplyNext[Task] = ReplyNext[Task - 1] + ReplyCounts[Task - 1];
+   std::vector<I4> ReplyBuf(2 * NBucket);
+   I8 WgtBefore = BucketStart;
+   for (int I = 0; I < NBucket; ++I) {
+      I4 ID   = Bucket[I].first.second;
+      I4 Dest = (ID - 1) / NCellsChunk;
+
+      ReplyBuf[ReplyNext[Dest]]     = ID;
+      ReplyBuf[ReplyNext[Dest] + 1] = (WgtBefore * NumTasks) / TotalWgt;
+      ReplyNext[Dest] += 2;
+      WgtBefore += Bucket[I].second;
+   }
+   std::vector<I4> PartBuf;
+   std::vector<I4> PartCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, ReplyBuf, ReplyCounts,
+                       PartBuf, PartCounts);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating SFC partition");
+      return Err;
+   }
+
+   std::vector<I4> CellTaskInit(NCellsLocal);
+   for (int I = 0; I < PartBuf.size(); I += 2)
+      CellTaskInit[PartBuf[I] - 1 - CellStart] = PartBuf[I + 1];
+
+   Err = setCellsFromPartition(InEnv, CellsOnCellInit, CellTaskInit);
+
+   if (!TimerFlag)
+      LOG_WARN("Decomp::partCellsSFC: Error in timers");
+   return Err;
+
+} // end function partCellsSFC
+
+//------------------------------------------------------------------------------
+// Construct the cell decomposition from the task assigned to each cell in the
+// initial linear distribution. The owned cells are sorted by global ID and
+// the halo layers are built by requesting the neighbors and locations of
+// cells from the tasks that hold them in the initial distribution, so no
+// global arrays are needed.
+
+int Decomp::setCellsFromPartition(
+    const MachEnv *InEnv, // [in] input machine environment with MPI info
+    const std::vector<I4> &CellsOnCellInit, // [in] cell nbrs in linear distrb
+    const std::vector<I4> &CellTaskInit     // [in] task for each init cell
+) {
+
+   int Err = 0; // initialize return code
+
+   // Retrieve some info on the MPI layout
+   MPI_Comm Comm = InEnv->getComm();
+   I4 NumTasks   = InEnv->getNumTasks();
+   I4 MyTask     = InEnv->getMyTask();
+
+   I4 NCellsChunk = (NCellsGlobal - 1) / NumTasks + 1;
+   I4 NCellsLocal = CellTaskInit.size();
+   I4 CellStart   = MyTask * NCellsChunk;
+
+   // Send the global ID of each cell in the initial distribution to the
+   // task that will own it
+   std::vector<I4> SendCounts(NumTasks, 0);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell)
+      ++SendCounts[CellTaskInit[Cell]];
+
+   std::vector<I4> SendNext(NumTasks, 0);
+   for (int Task = 1; Task < NumTasks; ++Task)
+      SendNext[Task] = SendNext[Task - 1] + SendCounts[Task - 1];
+
+   std::vector<I4> SendBuf(NCellsLocal);
+   std::vector<I4> SendPos(NCellsLocal);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      I4 Task                 = CellTaskInit[Cell];
+      SendPos[Cell]           = SendNext[Task];
+      SendBuf[SendNext[Task]] = CellStart + Cell + 1; // IDs are 1-based
+      ++SendNext[Task];
+   }
+
+   std::vector<I4> OwnedIDs;
+   std::vector<I4> RecvCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, SendBuf, SendCounts,
+                       OwnedIDs, RecvCounts);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating owned cells");
+      return Err;
+   }
+
+   // Owned cells are sorted in CellID order, which defines their local
+   // address. During this process we also create an ordered list of all
+   // local (owned+halo) cells using std::set for later use in halo setup
+   std::vector<I4> CellIDTmp(OwnedIDs);
+   std::sort(CellIDTmp.begin(), CellIDTmp.end());
+   NCellsOwned = CellIDTmp.size();
+
+   std::vector<I4> CellLocTmp(2 * NCellsOwned, 0); // will grow when halo added
+   for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+      CellLocTmp[2 * Cell]     = MyTask;
+      CellLocTmp[2 * Cell + 1] = Cell;
+   }
+   std::set<I4> CellsInList(CellIDTmp.begin(), CellIDTmp.end());
+
+   // Return the local address of each owned cell to the task holding it in
+   // the initial distribution so the full address (TaskID, local index) of
+   // every cell is known in the initial distribution
+   std::vector<I4> AddBuf(OwnedIDs.size());
+   for (int I = 0; I < OwnedIDs.size(); ++I) {
+      auto It   = std::lower_bound(CellIDTmp.begin(), CellIDTmp.end(),
+                                   OwnedIDs[I]);
+      AddBuf[I] = std::distance(CellIDTmp.begin(), It);
+   }
+   std::vector<I4> AddReply;
+   std::vector<I4> AddCounts;
+   Err = alltoallvData(Comm, NumTasks, MPI_INT32_T, AddBuf, RecvCounts,
+                       AddReply, AddCounts);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating cell locations");
+      return Err;
+   }
+
+   std::vector<I4> CellLocInit(2 * NCellsChunk, 0);
+   for (int Cell = 0; Cell < NCellsLocal; ++Cell) {
+      CellLocInit[2 * Cell]     = CellTaskInit[Cell];
+      CellLocInit[2 * Cell + 1] = AddReply[SendPos[Cell]];
+   }
+
+   // Find and add the halo cells to the cell list one layer at a time.
+   // The neighbors of each cell in the previous layer are requested from the
+   // task holding that cell and are stored if they are not already in the
+   // local list. We use the std::set container to automatically sort each
+   // halo layer by cellID. The location of each new halo cell is then
+   // requested in the same way.
+   I4 CellLocStart = 0;
+   I4 CellLocEnd   = NCellsOwned - 1;
+   I4 CurSize      = NCellsOwned;
+   HostArray1DI4 NCellsHaloTmp("NCellsHalo", HaloWidth);
+   std::set<I4> HaloList;
+   for (int Halo = 0; Halo < HaloWidth; ++Halo) {
+
+      std::vector<I4> LayerIDs(CellIDTmp.begin() + CellLocStart,
+                               CellIDTmp.begin() + CellLocEnd + 1);
+      std::vector<I4> NbrIDs;
+      Err = fetchLinearData(Comm, NumTasks, MyTask, NCellsChunk, MaxEdges,
+                            CellsOnCellInit, LayerIDs, NbrIDs);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error communicating halo cell neighbors");
+         return Err;
+      }
+
+      HaloList.clear(); // reset list for this halo layer
+      for (int I = 0; I < NbrIDs.size(); ++I) {
+         I4 NbrID = NbrIDs[I];
+         if (validCellID(NbrID) &&
+             CellsInList.find(NbrID) == CellsInList.end()) {
+            HaloList.insert(NbrID);
+            CellsInList.insert(NbrID);
+         }
+      }
+
+      std::vector<I4> HaloIDs(HaloList.begin(), HaloList.end());
+      std::vector<I4> HaloLocs;
+      Err = fetchLinearData(Comm, NumTasks, MyTask, NCellsChunk, 2,
+                            CellLocInit, HaloIDs, HaloLocs);
+      if (Err != 0) {
+         LOG_CRITICAL("Decomp: Error communicating halo cell locations");
+         return Err;
+      }
+
+      // Extend size of ID, Loc arrays and add the new halo layer
+      I4 HaloAdd = CurSize;
+      CurSize += HaloIDs.size();
+      NCellsHaloTmp(Halo) = CurSize;
+      CellIDTmp.resize(CurSize);
+      CellLocTmp.resize(2 * CurSize);
+      for (int I = 0; I < HaloIDs.size(); ++I) {
+         CellIDTmp[HaloAdd + I]            = HaloIDs[I];
+         CellLocTmp[2 * (HaloAdd + I)]     = HaloLocs[2 * I];
+         CellLocTmp[2 * (HaloAdd + I) + 1] = HaloLocs[2 * I + 1];
+      }
+
+      // Reset for next halo layer
+      CellLocStart = CellLocEnd + 1;
+      CellLocEnd   = NCellsHaloTmp(Halo) - 1;
+   }
+   NCellsAll  = NCellsHaloTmp(HaloWidth - 1);
+   NCellsSize = NCellsAll + 1; // extra entry to store boundary/undefined value
+
+   // The cell decomposition is now complete, copy the information
+   // into the final locations as class members on host (copy to device later)
+
+   NCellsHaloH = NCellsHaloTmp;
+
+   HostArray1DI4 CellIDHTmp("CellID", NCellsSize);
+   HostArray2DI4 CellLocHTmp("CellLoc", NCellsSize, 2);
+   for (int Cell = 0; Cell < NCellsAll; ++Cell) {
+      CellIDHTmp(Cell)     = CellIDTmp[Cell];
+      CellLocHTmp(Cell, 0) = CellLocTmp[2 * Cell];     // task owning this cell
+      CellLocHTmp(Cell, 1) = CellLocTmp[2 * Cell + 1]; // local address on task
+   }
+   CellIDH  = CellIDHTmp;
+   CellLocH = CellLocHTmp;
+
+   return Err;
+
+} // end function setCellsFromPartition
+
 //------------------------------------------------------------------------------
 // Partition the edges based on the cell decomposition. The first cell ID in
 // the CellsOnEdge array for a given edge is assigned ownership of the edge.
@@ -1252,7 +3069,7 @@ int Decomp::partEdges(
    // To determine whether the edge is owned by this task, we first
    // determine ownership as the first valid cell in the CellsOnEdge
    // array. CellsOnEdge is only in the initial linear decomposition so
-   // we compute it there and broadcast the data to other MPI tasks.
+   // we compute it there and each task retrieves the entries it needs.
 
    std::vector<I4> EdgeOwnerInit(NEdgesChunk, NCellsGlobal + 1);
    for (int Edge = 0; Edge < NEdgesLocal; ++Edge) {
@@ -1266,44 +3083,26 @@ int Decomp::partEdges(
    }
    TimerFlag = Pacer::stop("partEdgesOwned") && TimerFlag;
 
-   // Broadcast the edge ownership to all tasks, one chunk at a time
-   // and create a sorted list of all owned edges.
-
-   std::vector<I4> EdgeBuf(NEdgesChunk);
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      TimerFlag = Pacer::start("partEdgesOwnerBcast") && TimerFlag;
-      // if it is this task's turn, fill the buffer with the owner info
-      if (Task == MyTask) {
-         for (int Edge = 0; Edge < NEdgesChunk; ++Edge) {
-            EdgeBuf[Edge] = EdgeOwnerInit[Edge];
-         }
-      }
-      // Broadcast this buffer
-      Err       = MPI_Bcast(&EdgeBuf[0], NEdgesChunk, MPI_INT32_T, Task, Comm);
-      TimerFlag = Pacer::stop("partEdgesOwnerBcast") && TimerFlag;
+   // Retrieve the owner of each edge around the owned cells from the
+   // initial linear distribution. Only these edges can be owned by this
+   // task since the owner cell of an edge is one of the cells it borders.
 
-      // For each edge in the buffer, check to see if the task owns
-      // the cell. If so, add the edge ID to the owned edges list.
-      TimerFlag = Pacer::start("partEdgesOwnerSearch") && TimerFlag;
-      for (int Edge = 0; Edge < NEdgesChunk; ++Edge) {
-
-         I4 EdgeGlob =
-             Task * NEdgesChunk + Edge + 1; // Global ID in initial distrb
-         // when number of edges doesn't divide evenly, the last
-         // task has some invalid edges at the end so break out of loop
-         if (EdgeGlob > NEdgesGlobal)
-            break;
-
-         I4 CellOwner = EdgeBuf[Edge];
-         if (CellsOwned.find(CellOwner) != CellsOwned.end()) {
-            // this task owns cell and therefore the edge
-            EdgesOwned.insert(EdgeGlob);
-         }
+   TimerFlag = Pacer::start("partEdgesOwnerFetch") && TimerFlag;
+   std::vector<I4> Halo1IDs(EdgesOwnedHalo1.begin(), EdgesOwnedHalo1.end());
+   std::vector<I4> Halo1Owners;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NEdgesChunk, 1, EdgeOwnerInit,
+                         Halo1IDs, Halo1Owners);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating edge owners");
+      return Err;
+   }
+   for (int I = 0; I < Halo1IDs.size(); ++I) {
+      if (CellsOwned.find(Halo1Owners[I]) != CellsOwned.end()) {
+         // this task owns cell and therefore the edge
+         EdgesOwned.insert(Halo1IDs[I]);
       }
-      TimerFlag = Pacer::stop("partEdgesOwnerSearch") && TimerFlag;
-
-   } // end task loop
+   }
+   TimerFlag = Pacer::stop("partEdgesOwnerFetch") && TimerFlag;
 
    // For compatibility with the previous MPAS model, we sort the
    // edges based on the order encounted in EdgesOnCell. The first halo
@@ -1381,62 +3180,54 @@ int Decomp::partEdges(
 
    TimerFlag = Pacer::start("partEdgesFinalLoc") && TimerFlag;
    HostArray2DI4 EdgeLocTmp("EdgeLoc", NEdgesSize, 2);
-   EdgeBuf.resize(2 * NEdgesChunk);
 
-   // For local owned cells, the location is obvious
-   // For others, we initialize to NEdgesAll and perform a search below
-   std::vector<bool> EdgeFound(NEdgesSize, false);
-   std::vector<I4> RemoteID;
+   // Each task stores the location of its owned edges in a directory in
+   // the initial linear distribution, from which each task then retrieves
+   // the location of its halo edges. Unset entries are marked with an
+   // invalid task.
+   std::vector<I4> OwnedIDs(NEdgesOwned);
+   std::vector<I4> OwnedLocs(2 * NEdgesOwned);
    for (int Edge = 0; Edge < NEdgesOwned; ++Edge) {
-      EdgeLocTmp(Edge, 0) = MyTask;
-      EdgeLocTmp(Edge, 1) = Edge;
-      EdgeFound[Edge]     = true;
+      OwnedIDs[Edge]          = EdgeIDTmp(Edge);
+      OwnedLocs[2 * Edge]     = MyTask;
+      OwnedLocs[2 * Edge + 1] = Edge;
    }
-   for (int Edge = NEdgesOwned; Edge < NEdgesSize; ++Edge) {
-      EdgeLocTmp(Edge, 0) = MyTask;
-      EdgeLocTmp(Edge, 1) = NEdgesAll;
+   std::vector<I4> EdgeLocInit(2 * NEdgesChunk, -1);
+   Err = storeLinearData(Comm, NumTasks, MyTask, NEdgesChunk, 2, OwnedIDs,
+                         OwnedLocs, EdgeLocInit);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error storing owned edge locations");
+      return Err;
    }
 
-   // Determine remote locations by having each task broadcast its list
-   // of owned edges. Then each task searches the list for the edges it
-   // needs and stores the remote address
-   for (int Task = 0; Task < NumTasks; ++Task) {
+   std::vector<I4> HaloIDs(NEdgesAll - NEdgesOwned);
+   for (int Edge = NEdgesOwned; Edge < NEdgesAll; ++Edge)
+      HaloIDs[Edge - NEdgesOwned] = EdgeIDTmp(Edge);
+   std::vector<I4> HaloLocs;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NEdgesChunk, 2, EdgeLocInit,
+                         HaloIDs, HaloLocs);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating halo edge locations");
+      return Err;
+   }
 
-      TimerFlag = Pacer::start("partEdgesFinalBcast") && TimerFlag;
-      // fill broadcast buffer with the list of owned edges. The
-      // first entry in the vector is the number of edges owned by
-      // this task.
-      if (Task == MyTask) {
-         EdgeBuf[0] = NEdgesOwned;
-         for (int BufEdge = 0; BufEdge < NEdgesOwned; ++BufEdge) {
-            EdgeBuf[BufEdge + 1] = EdgeIDTmp(BufEdge);
-         }
-      }
-      // Broadcast the list of edges owned by this task
-      Err = MPI_Bcast(&EdgeBuf[0], 2 * NEdgesChunk, MPI_INT32_T, Task, Comm);
-      TimerFlag = Pacer::stop("partEdgesFinalBcast") && TimerFlag;
-
-      // Extract the buffer into a local search vector
-      TimerFlag   = Pacer::start("partEdgesFinalSearch") && TimerFlag;
-      I4 BufOwned = EdgeBuf[0];
-      RemoteID.resize(BufOwned);
-      for (int Edge = 0; Edge < BufOwned; ++Edge)
-         RemoteID[Edge] = EdgeBuf[Edge + 1];
-
-      // For each halo point that hasn't yet been found, search the
-      // current vector and store the remote address if it's found
-      for (int Edge = NEdgesOwned; Edge < NEdgesAll; ++Edge) {
-         if (!EdgeFound[Edge]) {
-            I4 GlobID = EdgeIDTmp(Edge);
-            I4 BufLoc = srchVector(RemoteID, GlobID);
-            if (BufLoc < BufOwned) {
-               EdgeLocTmp(Edge, 0) = Task;   // Task that owns edge
-               EdgeLocTmp(Edge, 1) = BufLoc; // Local address on task
-               EdgeFound[Edge]     = true;   // Mark as found
-            }
-         }
+   // For local owned edges, the location is obvious. Halo edges that
+   // were not found and the extra boundary entry are given the local
+   // address NEdgesAll.
+   for (int Edge = 0; Edge < NEdgesOwned; ++Edge) {
+      EdgeLocTmp(Edge, 0) = MyTask;
+      EdgeLocTmp(Edge, 1) = Edge;
+   }
+   for (int Edge = NEdgesOwned; Edge < NEdgesSize; ++Edge) {
+      EdgeLocTmp(Edge, 0) = MyTask;
+      EdgeLocTmp(Edge, 1) = NEdgesAll;
+   }
+   for (int Edge = NEdgesOwned; Edge < NEdgesAll; ++Edge) {
+      I4 HaloAdd = 2 * (Edge - NEdgesOwned);
+      if (HaloLocs[HaloAdd] >= 0) {
+         EdgeLocTmp(Edge, 0) = HaloLocs[HaloAdd];     // Task that owns edge
+         EdgeLocTmp(Edge, 1) = HaloLocs[HaloAdd + 1]; // Local address on task
       }
-      TimerFlag = Pacer::stop("partEdgesFinalSearch") && TimerFlag;
    }
    TimerFlag = Pacer::stop("partEdgesFinalLoc") && TimerFlag;
 
@@ -1522,7 +3313,7 @@ int Decomp::partVertices(
    // To determine whether the vertex is owned by this task, we first
    // determine ownership as the first valid cell in the CellsOnVertex
    // array. CellsOnVertex is only in the initial linear decomposition so
-   // we compute it there and broadcast the data to other MPI tasks.
+   // we compute it there and each task retrieves the entries it needs.
 
    std::vector<I4> VrtxOwnerInit(NVerticesChunk, NCellsGlobal + 1);
    for (int Vrtx = 0; Vrtx < NVerticesLocal; ++Vrtx) {
@@ -1536,44 +3327,27 @@ int Decomp::partVertices(
    }
    TimerFlag = Pacer::stop("partVerticesOwned") && TimerFlag;
 
-   // Broadcast the vertex ownership to all tasks, one chunk at a time
-   // and create a sorted list of all owned vertices.
-
-   std::vector<I4> VrtxBuf(NVerticesChunk);
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      TimerFlag = Pacer::start("partVerticesOwnedBcast") && TimerFlag;
-      // if it is this task's turn, fill the buffer with the owner info
-      if (Task == MyTask) {
-         for (int Vrtx = 0; Vrtx < NVerticesChunk; ++Vrtx) {
-            VrtxBuf[Vrtx] = VrtxOwnerInit[Vrtx];
-         }
-      }
-      // Broadcast this buffer
-      Err = MPI_Bcast(&VrtxBuf[0], NVerticesChunk, MPI_INT32_T, Task, Comm);
-      TimerFlag = Pacer::stop("partVerticesOwnedBcast") && TimerFlag;
-
-      // For each vertex in the buffer, check to see if the task owns
-      // the cell. If so, add the vertex ID to the owned vertices list.
-      TimerFlag = Pacer::start("partVerticesOwnedSearch") && TimerFlag;
-      for (int Vrtx = 0; Vrtx < NVerticesChunk; ++Vrtx) {
-
-         I4 VrtxGlob =
-             Task * NVerticesChunk + Vrtx + 1; // Global ID init distrb
-         // when number of vertices doesn't divide evenly, the last
-         // task has some invalid vertices at the end so break out of loop
-         if (VrtxGlob > NVerticesGlobal)
-            break;
+   // Retrieve the owner of each vertex around the owned cells from the
+   // initial linear distribution. Only these vertices can be owned by this
+   // task since the owner cell of a vertex is one of the cells it borders.
 
-         I4 CellOwner = VrtxBuf[Vrtx];
-         if (CellsOwned.find(CellOwner) != CellsOwned.end()) {
-            // this task owns cell and therefore the edge
-            VerticesOwned.insert(VrtxGlob);
-         }
+   TimerFlag = Pacer::start("partVerticesOwnedFetch") && TimerFlag;
+   std::vector<I4> Halo1IDs(VerticesOwnedHalo1.begin(),
+                            VerticesOwnedHalo1.end());
+   std::vector<I4> Halo1Owners;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NVerticesChunk, 1,
+                         VrtxOwnerInit, Halo1IDs, Halo1Owners);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating vertex owners");
+      return Err;
+   }
+   for (int I = 0; I < Halo1IDs.size(); ++I) {
+      if (CellsOwned.find(Halo1Owners[I]) != CellsOwned.end()) {
+         // this task owns cell and therefore the vertex
+         VerticesOwned.insert(Halo1IDs[I]);
       }
-      TimerFlag = Pacer::stop("partVerticesOwnedSearch") && TimerFlag;
-
-   } // end task loop
+   }
+   TimerFlag = Pacer::stop("partVerticesOwnedFetch") && TimerFlag;
 
    // For compatibility with the previous MPAS model, we sort the
    // vertices based on the order encounted in VerticesOnCell. The first halo
@@ -1652,62 +3426,54 @@ int Decomp::partVertices(
 
    TimerFlag = Pacer::start("partVerticesFinalLoc") && TimerFlag;
    HostArray2DI4 VertexLocTmp("VertexLoc", NVerticesSize, 2);
-   VrtxBuf.resize(2 * NVerticesChunk);
 
-   // For local owned vertices, the location is obvious
-   // For halo vertices, we initialize to NVerticesAll and perform a search
-   std::vector<bool> VertexFound(NVerticesSize, false);
-   std::vector<I4> RemoteID;
+   // Each task stores the location of its owned vertices in a directory in
+   // the initial linear distribution, from which each task then retrieves
+   // the location of its halo vertices. Unset entries are marked with an
+   // invalid task.
+   std::vector<I4> OwnedIDs(NVerticesOwned);
+   std::vector<I4> OwnedLocs(2 * NVerticesOwned);
+   for (int Vrtx = 0; Vrtx < NVerticesOwned; ++Vrtx) {
+      OwnedIDs[Vrtx]          = VertexIDTmp(Vrtx);
+      OwnedLocs[2 * Vrtx]     = MyTask;
+      OwnedLocs[2 * Vrtx + 1] = Vrtx;
+   }
+   std::vector<I4> VertexLocInit(2 * NVerticesChunk, -1);
+   Err = storeLinearData(Comm, NumTasks, MyTask, NVerticesChunk, 2, OwnedIDs,
+                         OwnedLocs, VertexLocInit);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error storing owned vertex locations");
+      return Err;
+   }
+
+   std::vector<I4> HaloIDs(NVerticesAll - NVerticesOwned);
+   for (int Vrtx = NVerticesOwned; Vrtx < NVerticesAll; ++Vrtx)
+      HaloIDs[Vrtx - NVerticesOwned] = VertexIDTmp(Vrtx);
+   std::vector<I4> HaloLocs;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NVerticesChunk, 2,
+                         VertexLocInit, HaloIDs, HaloLocs);
+   if (Err != 0) {
+      LOG_CRITICAL("Decomp: Error communicating halo vertex locations");
+      return Err;
+   }
+
+   // For local owned vertices, the location is obvious. Halo vertices that
+   // were not found and the extra boundary entry are given the local
+   // address NVerticesAll.
    for (int Vrtx = 0; Vrtx < NVerticesOwned; ++Vrtx) {
       VertexLocTmp(Vrtx, 0) = MyTask;
       VertexLocTmp(Vrtx, 1) = Vrtx;
-      VertexFound[Vrtx]     = true;
    }
    for (int Vrtx = NVerticesOwned; Vrtx < NVerticesSize; ++Vrtx) {
       VertexLocTmp(Vrtx, 0) = MyTask;
       VertexLocTmp(Vrtx, 1) = NVerticesAll;
    }
-
-   // Determine remote locations by having each task broadcast its list
-   // of owned edges. Then each task searches the list for the edges it
-   // needs and stores the remote address
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      // fill broadcast buffer with the list of owned vertices. The
-      // first entry in the vector is the number of vertices owned by
-      // this task.
-      TimerFlag = Pacer::start("partVerticesFinalBcast") && TimerFlag;
-      if (Task == MyTask) {
-         VrtxBuf[0] = NVerticesOwned;
-         for (int BufVrtx = 0; BufVrtx < NVerticesOwned; ++BufVrtx) {
-            VrtxBuf[BufVrtx + 1] = VertexIDTmp(BufVrtx);
-         }
-      }
-      // Broadcast the list of vertices owned by this task
-      Err = MPI_Bcast(&VrtxBuf[0], 2 * NVerticesChunk, MPI_INT32_T, Task, Comm);
-      TimerFlag = Pacer::stop("partVerticesFinalBcast") && TimerFlag;
-
-      // Extract the buffer into a local search vector
-      TimerFlag   = Pacer::start("partVerticesFinalSearch") && TimerFlag;
-      I4 BufOwned = VrtxBuf[0];
-      RemoteID.resize(BufOwned);
-      for (int Vrtx = 0; Vrtx < BufOwned; ++Vrtx)
-         RemoteID[Vrtx] = VrtxBuf[Vrtx + 1];
-
-      // For each halo point that hasn't yet been found, search the
-      // current vector and store the remote address if it's found
-      for (int Vrtx = NVerticesOwned; Vrtx < NVerticesAll; ++Vrtx) {
-         if (!VertexFound[Vrtx]) {
-            I4 GlobID = VertexIDTmp(Vrtx);
-            I4 BufLoc = srchVector(RemoteID, GlobID);
-            if (BufLoc < BufOwned) {
-               VertexLocTmp(Vrtx, 0) = Task;   // Task that owns edge
-               VertexLocTmp(Vrtx, 1) = BufLoc; // Local address on task
-               VertexFound[Vrtx]     = true;   // Mark as found
-            }
-         }
+   for (int Vrtx = NVerticesOwned; Vrtx < NVerticesAll; ++Vrtx) {
+      I4 HaloAdd = 2 * (Vrtx - NVerticesOwned);
+      if (HaloLocs[HaloAdd] >= 0) {
+         VertexLocTmp(Vrtx, 0) = HaloLocs[HaloAdd];     // Task that owns vrtx
+         VertexLocTmp(Vrtx, 1) = HaloLocs[HaloAdd + 1]; // Local address
       }
-      TimerFlag = Pacer::stop("partVerticesFinalSearch") && TimerFlag;
    }
    TimerFlag = Pacer::stop("partVerticesFinalLoc") && TimerFlag;
 
@@ -1765,83 +3531,70 @@ int Decomp::rearrangeCellArrays(
    deepCopy(VerticesOnCellTmp, NVerticesGlobal + 1);
    deepCopy(NEdgesOnCellTmp, 0);
 
-   // For each cell this task owns, determine the task and local address
-   // of the cell in the initial linear distribution
-   std::vector<I4> TaskInit(NCellsSize, NumTasks);
-   std::vector<I4> AddInit(NCellsSize, NCellsGlobal + 1);
+   // Pack the local chunk of all three arrays in the initial linear
+   // distribution. Each task then retrieves the entries for its local
+   // (owned and halo) cells from the tasks holding them, so only the
+   // entries needed locally are communicated.
+   TimerFlag = Pacer::start("rearrangeCellsFetch") && TimerFlag;
+   for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         I4 BufAdd           = Cell * SizePerCell + Edge * 3;
+         I4 ArrayAdd         = Cell * MaxEdges + Edge;
+         CellBuf[BufAdd]     = CellsOnCellInit[ArrayAdd];
+         CellBuf[BufAdd + 1] = VerticesOnCellInit[ArrayAdd];
+         CellBuf[BufAdd + 2] = EdgesOnCellInit[ArrayAdd];
+      }
+   }
+
+   std::vector<I4> LocalIDs;
+   std::vector<I4> LocalAdds;
    for (int Cell = 0; Cell < NCellsAll; ++Cell) {
-      int GlobalID = CellIDH(Cell); // one-based
+      I4 GlobalID = CellIDH(Cell); // one-based
       if (validCellID(GlobalID)) {
-         TaskInit[Cell] = (GlobalID - 1) / NCellsChunk;
-         AddInit[Cell]  = GlobalID - 1 - TaskInit[Cell] * NCellsChunk;
-      }
-   }
-
-   // Each task will broadcast the cells it owns in the initial linear
-   // distribution and all tasks will search their list of cells to determine
-   // entries it needs.
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      TimerFlag = Pacer::start("rearrangeCellsBcast") && TimerFlag;
-      // If it is this task's turn to send, fill the buffer with the local
-      // chunk of all three arrays.
-      if (MyTask == Task) { // Fill buffer with local chunk
-         for (int Cell = 0; Cell < NCellsChunk; ++Cell) {
-            for (int Edge = 0; Edge < MaxEdges; ++Edge) {
-               I4 BufAdd           = Cell * SizePerCell + Edge * 3;
-               I4 ArrayAdd         = Cell * MaxEdges + Edge;
-               CellBuf[BufAdd]     = CellsOnCellInit[ArrayAdd];
-               CellBuf[BufAdd + 1] = VerticesOnCellInit[ArrayAdd];
-               CellBuf[BufAdd + 2] = EdgesOnCellInit[ArrayAdd];
-            }
-         }
+         LocalIDs.push_back(GlobalID);
+         LocalAdds.push_back(Cell);
       }
-      Err = MPI_Bcast(&CellBuf[0], BufSize, MPI_INT32_T, Task, Comm);
-      if (Err != 0) {
-         LOG_CRITICAL("rearrangeCellArrays: Error broadcasting cell buffer");
-         return Err;
-      }
-      TimerFlag = Pacer::stop("rearrangeCellsBcast") && TimerFlag;
-
-      // For each cell needed locally, we can compute the task and address
-      // of the cell in the linear distribution and extract from the buffer
-      // if needed
-
-      TimerFlag = Pacer::start("rearrangeCellsSearch") && TimerFlag;
-      for (int Cell = 0; Cell < NCellsAll; ++Cell) {
-         if (TaskInit[Cell] == Task) {
-            if (AddInit[Cell] < NCellsGlobal + 1) {
-
-               // Local cell needs the info so extract from the buffer
-               // into the local address. For edges, we only store the
-               // active edges and maintain a count of the edges.
-               I4 EdgeCount = 0;
-               for (int Edge = 0; Edge < MaxEdges; ++Edge) {
-                  I4 BufAdd  = AddInit[Cell] * SizePerCell + Edge * 3;
-                  I4 NbrCell = CellBuf[BufAdd];
-                  I4 NbrVrtx = CellBuf[BufAdd + 1];
-                  I4 NbrEdge = CellBuf[BufAdd + 2];
-                  if (validCellID(NbrCell)) {
-                     CellsOnCellTmp(Cell, Edge) = NbrCell;
-                  } else {
-                     CellsOnCellTmp(Cell, Edge) = NCellsGlobal + 1;
-                  }
-                  if (validVertexID(NbrVrtx)) {
-                     VerticesOnCellTmp(Cell, Edge) = NbrVrtx;
-                  } else {
-                     VerticesOnCellTmp(Cell, Edge) = NVerticesGlobal + 1;
-                  }
-                  if (validEdgeID(NbrEdge)) {
-                     EdgesOnCellTmp(Cell, EdgeCount) = NbrEdge;
-                     EdgeCount++;
-                  }
-               }
-               NEdgesOnCellTmp(Cell) = EdgeCount;
-            }
+   }
+
+   std::vector<I4> CellVals;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NCellsChunk, SizePerCell,
+                         CellBuf, LocalIDs, CellVals);
+   if (Err != 0) {
+      LOG_CRITICAL("rearrangeCellArrays: Error communicating cell arrays");
+      return Err;
+   }
+   TimerFlag = Pacer::stop("rearrangeCellsFetch") && TimerFlag;
+
+   // Extract the retrieved entries into the local address of each cell.
+   // For edges, we only store the active edges and maintain a count of the
+   // edges.
+   TimerFlag = Pacer::start("rearrangeCellsUnpack") && TimerFlag;
+   for (int I = 0; I < LocalIDs.size(); ++I) {
+      I4 Cell      = LocalAdds[I];
+      I4 EdgeCount = 0;
+      for (int Edge = 0; Edge < MaxEdges; ++Edge) {
+         I4 BufAdd  = I * SizePerCell + Edge * 3;
+         I4 NbrCell = CellVals[BufAdd];
+         I4 NbrVrtx = CellVals[BufAdd + 1];
+         I4 NbrEdge = CellVals[BufAdd + 2];
+         if (validCellID(NbrCell)) {
+            CellsOnCellTmp(Cell, Edge) = NbrCell;
+         } else {
+            CellsOnCellTmp(Cell, Edge) = NCellsGlobal + 1;
+         }
+         if (validVertexID(NbrVrtx)) {
+            VerticesOnCellTmp(Cell, Edge) = NbrVrtx;
+         } else {
+            VerticesOnCellTmp(Cell, Edge) = NVerticesGlobal + 1;
+         }
+         if (validEdgeID(NbrEdge)) {
+            EdgesOnCellTmp(Cell, EdgeCount) = NbrEdge;
+            EdgeCount++;
          }
       }
-      TimerFlag = Pacer::stop("rearrangeCellsSearch") && TimerFlag;
-   } // end loop over MPI tasks
+      NEdgesOnCellTmp(Cell) = EdgeCount;
+   }
+   TimerFlag = Pacer::stop("rearrangeCellsUnpack") && TimerFlag;
 
    // Copy to final location on host - wait to create device copies until
    // the entries are translated to local addresses rather than global IDs
@@ -1884,116 +3637,112 @@ int Decomp::rearrangeEdgeArrays(
    // Define the chunk sizes for the initial linear distribution
    I4 NEdgesChunk = (NEdgesGlobal - 1) / NumTasks + 1;
 
+   // An empty EdgesOnEdge array means its read has been deferred
+   bool HasEdgesOnEdge = !EdgesOnEdgeInit.empty();
+   I4 NEdgesOnEdgeBuf  = HasEdgesOnEdge ? 2 * MaxEdges : 0;
+
    // Create a buffer for sending all the edge array information
    // Each of the arrays are either NEdgesChunk*2 (cell, vertex)
    // or NEdgesChunk*MaxEdges*2 (edge)
-   I4 SizePerEdge = 2 * MaxEdges + MaxCellsOnEdge + 2;
+   I4 SizePerEdge = NEdgesOnEdgeBuf + MaxCellsOnEdge + 2;
    I4 BufSize     = NEdgesChunk * SizePerEdge;
    std::vector<I4> EdgeBuf(BufSize);
 
    // Create temporary arrays for holding the XxOnEdge results
    // and initialize to NXxGlobal+1 to denote a non-existent entry
    HostArray2DI4 CellsOnEdgeTmp("CellsOnEdge", NEdgesSize, MaxCellsOnEdge);
-   HostArray2DI4 EdgesOnEdgeTmp("EdgesOnEdge", NEdgesSize, 2 * MaxEdges);
+   I4 NEdgesOnEdgeSize = HasEdgesOnEdge ? NEdgesSize : 0;
+   HostArray2DI4 EdgesOnEdgeTmp("EdgesOnEdge", NEdgesOnEdgeSize, 2 * MaxEdges);
    HostArray2DI4 VerticesOnEdgeTmp("VerticesOnEdge", NEdgesSize, 2);
-   HostArray1DI4 NEdgesOnEdgeTmp("NEdgesOnEdge", NEdgesSize);
+   HostArray1DI4 NEdgesOnEdgeTmp("NEdgesOnEdge", NEdgesOnEdgeSize);
    deepCopy(CellsOnEdgeTmp, NCellsGlobal + 1);
    deepCopy(EdgesOnEdgeTmp, NEdgesGlobal + 1);
    deepCopy(VerticesOnEdgeTmp, NVerticesGlobal + 1);
    deepCopy(NEdgesOnEdgeTmp, 0);
 
-   // Compute task and local address for needed edges in initial linear
-   // distribution. Initialize to invalid task, addresses.
-   std::vector<I4> TaskInit(NEdgesAll, NumTasks);
-   std::vector<I4> AddInit(NEdgesAll, NEdgesGlobal + 1);
+   // Pack the local chunk of all arrays in the initial linear distribution.
+   // Each task then retrieves the entries for its local edges from the
+   // tasks holding them.
+   TimerFlag = Pacer::start("rearrangeEdgeArraysFetch") && TimerFlag;
+   for (int Edge = 0; Edge < NEdgesChunk; ++Edge) {
+      I4 BufAdd = Edge * SizePerEdge;
+      for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
+         I4 ArrayAdd     = Edge * MaxCellsOnEdge + Cell;
+         EdgeBuf[BufAdd] = CellsOnEdgeInit[ArrayAdd];
+         ++BufAdd;
+      }
+      for (int Vrtx = 0; Vrtx < 2; ++Vrtx) {
+         I4 ArrayAdd     = Edge * 2 + Vrtx;
+         EdgeBuf[BufAdd] = VerticesOnEdgeInit[ArrayAdd];
+         ++BufAdd;
+      }
+      for (int NbrEdge = 0; NbrEdge < NEdgesOnEdgeBuf; ++NbrEdge) {
+         I4 ArrayAdd     = Edge * 2 * MaxEdges + NbrEdge;
+         EdgeBuf[BufAdd] = EdgesOnEdgeInit[ArrayAdd];
+         ++BufAdd;
+      }
+   }
+
+   std::vector<I4> LocalIDs;
+   std::vector<I4> LocalAdds;
    for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
       I4 GlobalID = EdgeIDH(Edge); // one-based ID
       if (validEdgeID(GlobalID)) {
-         TaskInit[Edge] = (GlobalID - 1) / NEdgesChunk;
-         AddInit[Edge]  = GlobalID - 1 - TaskInit[Edge] * NEdgesChunk;
-      }
-   }
-
-   // Each task will broadcast the array chunks it owns in the initial linear
-   // distribution and all tasks will search that list and extract the
-   // entries it owns.
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      TimerFlag = Pacer::start("rearrangeEdgeArraysBcast") && TimerFlag;
-      // If it is this task's turn to send, fill the buffer with the local
-      // chunk of all three arrays.
-      if (MyTask == Task) { // Fill buffer with local chunk
-         for (int Edge = 0; Edge < NEdgesChunk; ++Edge) {
-            I4 BufAdd = Edge * SizePerEdge;
-            for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
-               I4 ArrayAdd     = Edge * MaxCellsOnEdge + Cell;
-               EdgeBuf[BufAdd] = CellsOnEdgeInit[ArrayAdd];
-               ++BufAdd;
-            }
-            for (int Vrtx = 0; Vrtx < 2; ++Vrtx) {
-               I4 ArrayAdd     = Edge * 2 + Vrtx;
-               EdgeBuf[BufAdd] = VerticesOnEdgeInit[ArrayAdd];
-               ++BufAdd;
-            }
-            for (int NbrEdge = 0; NbrEdge < 2 * MaxEdges; ++NbrEdge) {
-               I4 ArrayAdd     = Edge * 2 * MaxEdges + NbrEdge;
-               EdgeBuf[BufAdd] = EdgesOnEdgeInit[ArrayAdd];
-               ++BufAdd;
-            }
-         }
+         LocalIDs.push_back(GlobalID);
+         LocalAdds.push_back(Edge);
       }
-      Err = MPI_Bcast(&EdgeBuf[0], BufSize, MPI_INT32_T, Task, Comm);
-      if (Err != 0) {
-         LOG_CRITICAL("rearrangeEdgeArrays: Error broadcasting edge buffer");
-         return Err;
+   }
+
+   std::vector<I4> EdgeVals;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NEdgesChunk, SizePerEdge,
+                         EdgeBuf, LocalIDs, EdgeVals);
+   if (Err != 0) {
+      LOG_CRITICAL("rearrangeEdgeArrays: Error communicating edge arrays");
+      return Err;
+   }
+   TimerFlag = Pacer::stop("rearrangeEdgeArraysFetch") && TimerFlag;
+
+   // Extract CellsOnEdge, VerticesOnEdge and EdgesOnEdge into the local
+   // address of each edge
+   TimerFlag = Pacer::start("rearrangeEdgeArraysUnpack") && TimerFlag;
+   for (int I = 0; I < LocalIDs.size(); ++I) {
+      I4 Edge   = LocalAdds[I];
+      I4 BufAdd = I * SizePerEdge;
+      for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
+         CellsOnEdgeTmp(Edge, Cell) = EdgeVals[BufAdd];
+         ++BufAdd;
+      }
+      for (int Vrtx = 0; Vrtx < 2; ++Vrtx) {
+         VerticesOnEdgeTmp(Edge, Vrtx) = EdgeVals[BufAdd];
+         ++BufAdd;
+      }
+      // In the EdgeOnEdge array, a zero entry must be kept in
+      // place but assigned the boundary value NEdgesGlobal+1
+      I4 EdgeCount = 0;
+      for (int NbrEdge = 0; NbrEdge < NEdgesOnEdgeBuf; ++NbrEdge) {
+         I4 EdgeID = EdgeVals[BufAdd];
+         ++BufAdd;
+         if (EdgeID == 0) {
+            EdgesOnEdgeTmp(Edge, EdgeCount) = NEdgesGlobal + 1;
+            EdgeCount++;
+         } else if (validEdgeID(EdgeID)) {
+            EdgesOnEdgeTmp(Edge, EdgeCount) = EdgeID;
+            EdgeCount++;
+         }
       }
-      TimerFlag = Pacer::stop("rearrangeEdgeArraysBcast") && TimerFlag;
-
-      // If the local Edge array has points in this buffer, extract the
-      // array information into the proper location
-      TimerFlag = Pacer::start("rearrangeEdgeArraysSearch") && TimerFlag;
-      for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
-         if (TaskInit[Edge] == Task) {
-            if (AddInit[Edge] < NEdgesGlobal + 1) {
-
-               // Local edge exists in the buffer, compute starting address
-               // and extract CellsOnEdge, VerticesOnEdge
-               I4 BufAdd = AddInit[Edge] * SizePerEdge;
-               for (int Cell = 0; Cell < MaxCellsOnEdge; ++Cell) {
-                  CellsOnEdgeTmp(Edge, Cell) = EdgeBuf[BufAdd];
-                  ++BufAdd;
-               }
-               for (int Vrtx = 0; Vrtx < 2; ++Vrtx) {
-                  VerticesOnEdgeTmp(Edge, Vrtx) = EdgeBuf[BufAdd];
-                  ++BufAdd;
-               }
-               // In the EdgeOnEdge array, a zero entry must be kept in
-               // place but assigned the boundary value NEdgesGlobal+1
-               I4 EdgeCount = 0;
-               for (int NbrEdge = 0; NbrEdge < 2 * MaxEdges; ++NbrEdge) {
-                  I4 EdgeID = EdgeBuf[BufAdd];
-                  ++BufAdd;
-                  if (EdgeID == 0) {
-                     EdgesOnEdgeTmp(Edge, EdgeCount) = NEdgesGlobal + 1;
-                     EdgeCount++;
-                  } else if (validEdgeID(EdgeID)) {
-                     EdgesOnEdgeTmp(Edge, EdgeCount) = EdgeID;
-                     EdgeCount++;
-                  }
-               }
-               NEdgesOnEdgeTmp(Edge) = EdgeCount;
-            } // end if address in buffer
-         } // end if address on this task
-      } // end loop over local edges
-      TimerFlag = Pacer::stop("rearrangeEdgeArraysSearch") && TimerFlag;
-   } // end loop over MPI tasks
+      if (HasEdgesOnEdge)
+         NEdgesOnEdgeTmp(Edge) = EdgeCount;
+   } // end loop over local edges
+   TimerFlag = Pacer::stop("rearrangeEdgeArraysUnpack") && TimerFlag;
 
    // Copy to final location on host - wait to create device copies until
    // the entries are translated to local addresses rather than global IDs
    CellsOnEdgeH    = CellsOnEdgeTmp;
-   EdgesOnEdgeH    = EdgesOnEdgeTmp;
    VerticesOnEdgeH = VerticesOnEdgeTmp;
-   NEdgesOnEdgeH   = NEdgesOnEdgeTmp;
+   if (HasEdgesOnEdge) {
+      EdgesOnEdgeH  = EdgesOnEdgeTmp;
+      NEdgesOnEdgeH = NEdgesOnEdgeTmp;
+   }
 
    // All done
    if (!TimerFlag)
@@ -2002,6 +3751,273 @@ int Decomp::rearrangeEdgeArrays(
 
 } // end function rearrangeEdgeArrays
 
+//------------------------------------------------------------------------------
+// Reads an edge connectivity array of global edge IDs for all local (owned
+// and halo) edges directly from the mesh file, so no further communication
+// is needed, and converts the IDs to local addresses. Zero entries are kept
+// in place as the boundary address NEdgesAll and invalid entries are dropped
+// as in the construction of the other XxOnEdge arrays.
+int Decomp::readLocalEdgeArray(
+    const std::string &VarName,    //< [in] name in the mesh file
+    const std::string &VarNameOld, //< [in] older name in the mesh file
+    I4 NEntries,                   //< [in] entries per edge
+    HostArray2DI4 &ArrayH,         //< [out] local addresses
+    HostArray1DI4 &NValidH         //< [out] valid entries per edge
+) {
+
+   int Err = 0;
+
+   int FileID;
+   Err = IO::openFile(FileID, MeshFileName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error opening mesh file to read {}", VarName);
+      return Err;
+   }
+
+   // Define the parallel IO decomposition from the global IDs of the local
+   // edges. The padding entries are left as holes.
+   I4 NDims    = 2;
+   I4 ReadSize = NEdgesSize * NEntries;
+   std::vector<I4> OnEdgeDims{NEdgesGlobal, NEntries};
+   std::vector<I4> OnEdgeOffset(ReadSize, -1);
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      I4 EdgeGlob = EdgeIDH(Edge) - 1;
+      for (int Entry = 0; Entry < NEntries; ++Entry) {
+         OnEdgeOffset[Edge * NEntries + Entry] = EdgeGlob * NEntries + Entry;
+      }
+   }
+
+   I4 OnEdgeDecomp;
+   Err = IO::createDecomp(OnEdgeDecomp, IO::IOTypeI4, NDims, OnEdgeDims,
+                          ReadSize, OnEdgeOffset, IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating {} IO decomposition", VarName);
+      IO::closeFile(FileID);
+      return Err;
+   }
+
+   std::vector<I4> ArrayRead(ReadSize, 0);
+   int VarID;
+   Err = IO::readArray(&ArrayRead[0], ReadSize, VarName, FileID, OnEdgeDecomp,
+                       VarID);
+   if (Err != 0) { // not found, try again under older name
+      Err = IO::readArray(&ArrayRead[0], ReadSize, VarNameOld, FileID,
+                          OnEdgeDecomp, VarID);
+   }
+
+   int ErrClose = IO::destroyDecomp(OnEdgeDecomp);
+   if (ErrClose != 0)
+      LOG_ERROR("Decomp: error destroying {} decomposition", VarName);
+   ErrClose = IO::closeFile(FileID);
+   if (ErrClose != 0)
+      LOG_ERROR("Decomp: error closing mesh file after {} read", VarName);
+
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error reading {}", VarName);
+      return Err;
+   }
+
+   std::map<I4, I4> GlobToLocEdge;
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      GlobToLocEdge[EdgeIDH(Edge)] = Edge;
+   }
+
+   HostArray2DI4 ArrayTmp(VarName, NEdgesSize, NEntries);
+   HostArray1DI4 NValidTmp("N" + VarName, NEdgesSize);
+   deepCopy(ArrayTmp, NEdgesAll);
+   deepCopy(NValidTmp, 0);
+
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      I4 Count = 0;
+      for (int Entry = 0; Entry < NEntries; ++Entry) {
+         I4 GlobID = ArrayRead[Edge * NEntries + Entry];
+         if (GlobID == 0) {
+            ArrayTmp(Edge, Count) = NEdgesAll;
+            Count++;
+         } else if (validEdgeID(GlobID)) {
+            auto It = GlobToLocEdge.find(GlobID);
+            if (It != GlobToLocEdge.end()) {
+               ArrayTmp(Edge, Count) = It->second;
+            } else {
+               ArrayTmp(Edge, Count) = NEdgesAll;
+            }
+            Count++;
+         }
+      }
+      NValidTmp(Edge) = Count;
+   }
+
+   ArrayH  = ArrayTmp;
+   NValidH = NValidTmp;
+
+   return Err;
+
+} // end function readLocalEdgeArray
+
+//------------------------------------------------------------------------------
+// Reads the EdgesOnEdge and NEdgesOnEdge arrays if their read was deferred
+// at construction
+int Decomp::loadEdgesOnEdge() {
+
+   int Err = 0;
+
+   // Nothing to do if the arrays were read at construction or earlier
+   if (EdgesOnEdgeLoaded)
+      return Err;
+
+   bool TimerFlag = Pacer::start("Decomp load EdgesOnEdge");
+
+   Err = readLocalEdgeArray("EdgesOnEdge", "edgesOnEdge", 2 * MaxEdges,
+                            EdgesOnEdgeH, NEdgesOnEdgeH);
+   if (Err != 0) {
+      Pacer::stop("Decomp load EdgesOnEdge");
+      return Err;
+   }
+
+   EdgesOnEdge       = createDeviceMirrorCopy(EdgesOnEdgeH);
+   NEdgesOnEdge      = createDeviceMirrorCopy(NEdgesOnEdgeH);
+   EdgesOnEdgeLoaded = true;
+   recordMemory();
+
+   TimerFlag = Pacer::stop("Decomp load EdgesOnEdge") && TimerFlag;
+   if (!TimerFlag)
+      LOG_WARN("Decomp::loadEdgesOnEdge: Error in timers");
+
+   return Err;
+
+} // end function loadEdgesOnEdge
+
+//------------------------------------------------------------------------------
+// Reads a vertex connectivity array of global edge IDs for all local (owned
+// and halo) vertices directly from the mesh file and converts the IDs to
+// local edge addresses. Every entry is kept in place and edges that are not
+// local are given the boundary address NEdgesAll, as in the construction of
+// EdgesOnVertex.
+int Decomp::readLocalVertexArray(
+    const std::string &VarName,    //< [in] name in the mesh file
+    const std::string &VarNameOld, //< [in] older name in the mesh file
+    I4 NEntries,                   //< [in] entries per vertex
+    HostArray2DI4 &ArrayH          //< [out] local edge addresses
+) {
+
+   int Err = 0;
+
+   int FileID;
+   Err = IO::openFile(FileID, MeshFileName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error opening mesh file to read {}", VarName);
+      return Err;
+   }
+
+   // Define the parallel IO decomposition from the global IDs of the local
+   // vertices. The padding entries are left as holes.
+   I4 NDims    = 2;
+   I4 ReadSize = NVerticesSize * NEntries;
+   std::vector<I4> OnVertexDims{NVerticesGlobal, NEntries};
+   std::vector<I4> OnVertexOffset(ReadSize, -1);
+   for (int Vrtx = 0; Vrtx < NVerticesAll; ++Vrtx) {
+      I4 VrtxGlob = VertexIDH(Vrtx) - 1;
+      for (int Entry = 0; Entry < NEntries; ++Entry) {
+         OnVertexOffset[Vrtx * NEntries + Entry] = VrtxGlob * NEntries + Entry;
+      }
+   }
+
+   I4 OnVertexDecomp;
+   Err = IO::createDecomp(OnVertexDecomp, IO::IOTypeI4, NDims, OnVertexDims,
+                          ReadSize, OnVertexOffset, IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error creating {} IO decomposition", VarName);
+      IO::closeFile(FileID);
+      return Err;
+   }
+
+   std::vector<I4> ArrayRead(ReadSize, 0);
+   int VarID;
+   Err = IO::readArray(&ArrayRead[0], ReadSize, VarName, FileID,
+                       OnVertexDecomp, VarID);
+   if (Err != 0) { // not found, try again under older name
+      Err = IO::readArray(&ArrayRead[0], ReadSize, VarNameOld, FileID,
+                          OnVertexDecomp, VarID);
+   }
+
+   int ErrClose = IO::destroyDecomp(OnVertexDecomp);
+   if (ErrClose != 0)
+      LOG_ERROR("Decomp: error destroying {} decomposition", VarName);
+   ErrClose = IO::closeFile(FileID);
+   if (ErrClose != 0)
+      LOG_ERROR("Decomp: error closing mesh file after {} read", VarName);
+
+   if (Err != 0) {
+      LOG_ERROR("Decomp: error reading {}", VarName);
+      return Err;
+   }
+
+   std::map<I4, I4> GlobToLocEdge;
+   for (int Edge = 0; Edge < NEdgesAll; ++Edge) {
+      GlobToLocEdge[EdgeIDH(Edge)] = Edge;
+   }
+
+   HostArray2DI4 ArrayTmp(VarName, NVerticesSize, NEntries);
+   deepCopy(ArrayTmp, NEdgesAll);
+
+   for (int Vrtx = 0; Vrtx < NVerticesAll; ++Vrtx) {
+      for (int Entry = 0; Entry < NEntries; ++Entry) {
+         auto It = GlobToLocEdge.find(ArrayRead[Vrtx * NEntries + Entry]);
+         if (It != GlobToLocEdge.end())
+            ArrayTmp(Vrtx, Entry) = It->second;
+      }
+   }
+
+   ArrayH = ArrayTmp;
+
+   return Err;
+
+} // end function readLocalVertexArray
+
+//------------------------------------------------------------------------------
+// Reads the EdgesOnVertex array if its read was deferred at construction
+int Decomp::loadEdgesOnVertex() {
+
+   int Err = 0;
+
+   // Nothing to do if the array was read at construction or earlier
+   if (EdgesOnVertexLoaded)
+      return Err;
+
+   bool TimerFlag = Pacer::start("Decomp load EdgesOnVertex");
+
+   Err = readLocalVertexArray("EdgesOnVertex", "edgesOnVertex", VertexDegree,
+                              EdgesOnVertexH);
+   if (Err != 0) {
+      Pacer::stop("Decomp load EdgesOnVertex");
+      return Err;
+   }
+
+   EdgesOnVertex       = createDeviceMirrorCopy(EdgesOnVertexH);
+   EdgesOnVertexLoaded = true;
+   recordMemory();
+
+   TimerFlag = Pacer::stop("Decomp load EdgesOnVertex") && TimerFlag;
+   if (!TimerFlag)
+      LOG_WARN("Decomp::loadEdgesOnVertex: Error in timers");
+
+   return Err;
+
+} // end function loadEdgesOnVertex
+
+//------------------------------------------------------------------------------
+// Reads every connectivity array whose read was deferred at construction
+int Decomp::loadDeferred() {
+
+   int Err = 0;
+
+   Err += loadEdgesOnEdge();
+   Err += loadEdgesOnVertex();
+
+   return Err;
+
+} // end function loadDeferred
+
 //------------------------------------------------------------------------------
 // Redistribute the various XxOnVertex index arrays to the final vertex
 // decomposition. The inputs are the various XxOnVertex arrays in the
@@ -2027,90 +4043,84 @@ int Decomp::rearrangeVertexArrays(
    // Define the chunk sizes for the initial linear distribution
    I4 NVerticesChunk = (NVerticesGlobal - 1) / NumTasks + 1;
 
+   // An empty EdgesOnVertex array means its read has been deferred
+   bool HasEdgesOnVertex = !EdgesOnVertexInit.empty();
+   I4 NEdgesOnVertexBuf  = HasEdgesOnVertex ? VertexDegree : 0;
+
    // Create a buffer for sending all the vertex array information
    // Both of the arrays should be of size NVerticesChunk*VertexDegree
    // so the full buffer is twice that.
-   I4 SizePerVrtx = 2 * VertexDegree;
+   I4 SizePerVrtx = VertexDegree + NEdgesOnVertexBuf;
    I4 BufSize     = NVerticesChunk * SizePerVrtx;
    std::vector<I4> VrtxBuf(BufSize);
 
    // Create temporary arrays for holding the XxOnVertex results
    // and initialize to NXxGlobal+1 to denote a non-existent entry
+   I4 NEdgesOnVertexSize = HasEdgesOnVertex ? NVerticesSize : 0;
    HostArray2DI4 CellsOnVertexTmp("CellsOnVertex", NVerticesSize, VertexDegree);
-   HostArray2DI4 EdgesOnVertexTmp("EdgesOnVertex", NVerticesSize, VertexDegree);
+   HostArray2DI4 EdgesOnVertexTmp("EdgesOnVertex", NEdgesOnVertexSize,
+                                  VertexDegree);
    deepCopy(CellsOnVertexTmp, NCellsGlobal + 1);
    deepCopy(EdgesOnVertexTmp, NEdgesGlobal + 1);
 
-   // Compute the task and local address of each needed local vertex in the
-   // original linear decomposition
-   std::vector<I4> TaskInit(NVerticesAll, NumTasks);
-   std::vector<I4> AddInit(NVerticesAll, NVerticesGlobal + 1);
+   // Pack the local chunk of both arrays in the initial linear distribution.
+   // Each task then retrieves the entries for its local vertices from the
+   // tasks holding them.
+   TimerFlag = Pacer::start("rearrangeVertexArraysFetch") && TimerFlag;
+   for (int Vrtx = 0; Vrtx < NVerticesChunk; ++Vrtx) {
+      I4 BufAdd = Vrtx * SizePerVrtx;
+      for (int Cell = 0; Cell < VertexDegree; ++Cell) {
+         I4 ArrayAdd     = Vrtx * VertexDegree + Cell;
+         VrtxBuf[BufAdd] = CellsOnVertexInit[ArrayAdd];
+         ++BufAdd;
+      }
+      for (int Edge = 0; Edge < NEdgesOnVertexBuf; ++Edge) {
+         I4 ArrayAdd     = Vrtx * VertexDegree + Edge;
+         VrtxBuf[BufAdd] = EdgesOnVertexInit[ArrayAdd];
+         ++BufAdd;
+      }
+   }
+
+   std::vector<I4> LocalIDs;
+   std::vector<I4> LocalAdds;
    for (int Vrtx = 0; Vrtx < NVerticesAll; ++Vrtx) {
       I4 GlobalID = VertexIDH(Vrtx); // one-based ID
       if (validVertexID(GlobalID)) {
-         TaskInit[Vrtx] = (GlobalID - 1) / NVerticesChunk;
-         AddInit[Vrtx]  = GlobalID - 1 - TaskInit[Vrtx] * NVerticesChunk;
-      }
-   }
-
-   // Each task will broadcast the array chunks it owns in the initial linear
-   // distribution and all tasks will search that list and extract the
-   // entries it owns.
-   for (int Task = 0; Task < NumTasks; ++Task) {
-
-      // If it is this task's turn to send, fill the buffer with the local
-      // chunk of both arrays.
-      TimerFlag = Pacer::start("rearrangeVertexArraysBcast") && TimerFlag;
-      if (MyTask == Task) { // Fill buffer with local chunk
-         for (int Vrtx = 0; Vrtx < NVerticesChunk; ++Vrtx) {
-            I4 BufAdd = Vrtx * SizePerVrtx;
-            for (int Cell = 0; Cell < VertexDegree; ++Cell) {
-               I4 ArrayAdd     = Vrtx * VertexDegree + Cell;
-               VrtxBuf[BufAdd] = CellsOnVertexInit[ArrayAdd];
-               ++BufAdd;
-            }
-            for (int Edge = 0; Edge < VertexDegree; ++Edge) {
-               I4 ArrayAdd     = Vrtx * VertexDegree + Edge;
-               VrtxBuf[BufAdd] = EdgesOnVertexInit[ArrayAdd];
-               ++BufAdd;
-            }
-         }
+         LocalIDs.push_back(GlobalID);
+         LocalAdds.push_back(Vrtx);
       }
-      Err = MPI_Bcast(&VrtxBuf[0], BufSize, MPI_INT32_T, Task, Comm);
-      if (Err != 0) {
-         LOG_CRITICAL("rearrangeVertexArrays: Error broadcasting buffer");
-         return Err;
+   }
+
+   std::vector<I4> VrtxVals;
+   Err = fetchLinearData(Comm, NumTasks, MyTask, NVerticesChunk, SizePerVrtx,
+                         VrtxBuf, LocalIDs, VrtxVals);
+   if (Err != 0) {
+      LOG_CRITICAL("rearrangeVertexArrays: Error communicating buffer");
+      return Err;
+   }
+   TimerFlag = Pacer::stop("rearrangeVertexArraysFetch") && TimerFlag;
+
+   // Extract the arrays into the local address of each vertex
+   TimerFlag = Pacer::start("rearrangeVertexArraysUnpack") && TimerFlag;
+   for (int I = 0; I < LocalIDs.size(); ++I) {
+      I4 Vrtx   = LocalAdds[I];
+      I4 BufAdd = I * SizePerVrtx;
+      for (int Cell = 0; Cell < VertexDegree; ++Cell) {
+         CellsOnVertexTmp(Vrtx, Cell) = VrtxVals[BufAdd];
+         ++BufAdd;
+      }
+      for (int Edge = 0; Edge < NEdgesOnVertexBuf; ++Edge) {
+         EdgesOnVertexTmp(Vrtx, Edge) = VrtxVals[BufAdd];
+         ++BufAdd;
       }
-      TimerFlag = Pacer::stop("rearrangeVertexArraysBcast") && TimerFlag;
-
-      // For each local vertex in the distribution, determine whether the
-      // buffer contains the vertex and extract the arrays
-      TimerFlag = Pacer::start("rearrangeVertexArraysSearch") && TimerFlag;
-      for (int Vrtx = 0; Vrtx < NVerticesAll; ++Vrtx) {
-         if (TaskInit[Vrtx] == Task) {
-            if (AddInit[Vrtx] < NVerticesGlobal + 1) {
-
-               // Local vertex is in the buffer so compute a buffer starting
-               // address
-               I4 BufAdd = AddInit[Vrtx] * SizePerVrtx;
-               for (int Cell = 0; Cell < VertexDegree; ++Cell) {
-                  CellsOnVertexTmp(Vrtx, Cell) = VrtxBuf[BufAdd];
-                  ++BufAdd;
-               }
-               for (int Edge = 0; Edge < VertexDegree; ++Edge) {
-                  EdgesOnVertexTmp(Vrtx, Edge) = VrtxBuf[BufAdd];
-                  ++BufAdd;
-               }
-            } // end if valid vertex
-         } // end if task has the vertex
-      } // end loop over local vertices
-      TimerFlag = Pacer::stop("rearrangeVertexArraysSearch") && TimerFlag;
-   } // end loop over MPI tasks
+   } // end loop over local vertices
+   TimerFlag = Pacer::stop("rearrangeVertexArraysUnpack") && TimerFlag;
 
    // Copy to final location on host - wait to create device copies until
    // the entries are translated to local addresses rather than global IDs
    CellsOnVertexH = CellsOnVertexTmp;
-   EdgesOnVertexH = EdgesOnVertexTmp;
+   if (HasEdgesOnVertex)
+      EdgesOnVertexH = EdgesOnVertexTmp;
 
    // All done
    if (!TimerFlag)
@@ -2130,10 +4140,17 @@ PartMethod getPartMethodFromStr(const std::string &InMethod) {
                   [](unsigned char c) { return std::tolower(c); });
 
    // Check supported methods and return appropriate enum
-   // Currently, only the METIS/ParMETIS KWay option is supported
+   // Currently, the METIS and ParMETIS KWay and Hilbert SFC options are
+   // supported
    if (MethodComp == "metiskway") {
       return PartMethodMetisKWay;
 
+   } else if (MethodComp == "parmetiskway") {
+      return PartMethodParMetisKWay;
+
+   } else if (MethodComp == "hilbertsfc") {
+      return PartMethodHilbertSFC;
+
    } else {
       return PartMethodUnknown;
 
@@ -2141,6 +4158,58 @@ PartMethod getPartMethodFromStr(const std::string &InMethod) {
 
 } // End getPartMethodFromStr
 
+//------------------------------------------------------------------------------
+// Utility routine to convert a local ordering string into LocalOrder enum
+
+LocalOrder getLocalOrderFromStr(const std::string &InOrder) {
+
+   // convert string to lower case for easier equivalence checking
+   std::string OrderComp = InOrder;
+   std::transform(OrderComp.begin(), OrderComp.end(), OrderComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   if (OrderComp == "globalid") {
+      return LocalOrderGlobalID;
+
+   } else if (OrderComp == "rcm") {
+      return LocalOrderRCM;
+
+   } else {
+      return LocalOrderUnknown;
+
+   } // end branch on order string
+
+} // End getLocalOrderFromStr
+
+//------------------------------------------------------------------------------
+// Utility routine to convert a partition weight string into PartWeight enum
+
+PartWeight getPartWeightFromStr(const std::string &InWeight) {
+
+   // convert string to lower case for easier equivalence checking
+   std::string WeightComp = InWeight;
+   std::transform(WeightComp.begin(), WeightComp.end(), WeightComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   if (WeightComp == "none") {
+      return PartWeightNone;
+
+   } else if (WeightComp == "levels") {
+      return PartWeightLevels;
+
+   } else if (WeightComp == "levelsedges") {
+      return PartWeightLevelsEdges;
+
+   } else if (WeightComp == "cellcost") {
+      return PartWeightCellCost;
+
+   } else {
+      return PartWeightUnknown;
+
+   } // end branch on weight string
+
+} // End getPartWeightFromStr
+
 //------------------------------------------------------------------------------
 // end Decomp methods
 
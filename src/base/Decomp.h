@@ -28,9 +28,34 @@
 ///    # Width of halo around local domain (Default = 3)
 ///    HaloWidth: 3
 ///    # Method to use for decomposing the horizontal domain
-///    # The only currently supported option is MetisKWay but others may
-///    # be added in the future
+///    # Supported options are MetisKWay (serial Metis on every task),
+///    # ParMetisKWay (distributed ParMetis) and HilbertSFC (space-filling
+///    # curve through the cell centers)
 ///    DecompMethod: MetisKWay
+///    # Optional ordering of the local cells within the owned cells and
+///    # each halo layer. GlobalID (default) keeps cells sorted by global ID
+///    # and RCM applies a reverse Cuthill-McKee ordering for cache locality
+///    LocalOrder: GlobalID
+///    # Optional weights used to balance the partition. None (default)
+///    # weights every cell equally, Levels weights cells by the number of
+///    # active levels (MaxLevelCell), LevelsEdges adds a second constraint
+///    # for the edge work in each column and CellCost reads a per-cell cost
+///    # from the CellCost variable in the mesh file
+///    PartWeight: None
+///    # Optional deferred read of the EdgesOnEdge and EdgesOnVertex
+///    # connectivity. If true (default false), EdgesOnEdge, NEdgesOnEdge and
+///    # EdgesOnVertex are only read from the mesh file by loadDeferred,
+///    # after the partition
+///    LazyMeshRead: false
+///    # Optional partition cache file. If set, the cell decomposition is
+///    # read from this file when it matches the mesh, task count and the
+///    # options above, and is written to it otherwise
+///    DecompCache: ''
+///    # Optional number of cell layers (default 2, at most HaloWidth) that
+///    # separate the interior cells from the halo. It should be the width
+///    # of the widest stencil computed over the interior lists while a halo
+///    # exchange is in progress
+///    InteriorWidth: 2
 /// \EndConfigInput
 //
 //===----------------------------------------------------------------------===//
@@ -40,6 +65,7 @@
 #include "mpi.h"
 #include "parmetis.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -51,9 +77,11 @@ namespace OMEGA {
 
 /// Supported partitioning methods
 enum PartMethod {
-   PartMethodUnknown,   ///< Unknown or undefined method
-   PartMethodMetisKWay, ///< Metis K-way partitioning (default)
-   PartMethodMetisRB    ///< Metis recursive bisection (not yet supported)
+   PartMethodUnknown,      ///< Unknown or undefined method
+   PartMethodMetisKWay,    ///< Metis K-way partitioning (default)
+   PartMethodMetisRB,      ///< Metis recursive bisection (not yet supported)
+   PartMethodParMetisKWay, ///< ParMetis distributed K-way partitioning
+   PartMethodHilbertSFC    ///< Hilbert space-filling curve partitioning
 };
 
 /// Translates an input string for partition method option to the
@@ -62,6 +90,35 @@ PartMethod getPartMethodFromStr(
     const std::string &InMethod ///< [in] choice of partition method
 );
 
+/// Supported weightings of cells for balancing the partition
+enum PartWeight {
+   PartWeightUnknown,     ///< Unknown or undefined weighting
+   PartWeightNone,        ///< All cells weighted equally (default)
+   PartWeightLevels,      ///< Cells weighted by number of active levels
+   PartWeightLevelsEdges, ///< Active levels and edge levels as 2 constraints
+   PartWeightCellCost     ///< Cells weighted by CellCost from mesh file
+};
+
+/// Translates an input string for the partition weight option to the
+/// enum for later use
+PartWeight getPartWeightFromStr(
+    const std::string &InWeight ///< [in] choice of partition weights
+);
+
+/// Supported orderings of local cells within the owned cells and within
+/// each halo layer. Edges and vertices follow the resulting cell order.
+enum LocalOrder {
+   LocalOrderUnknown,  ///< Unknown or undefined ordering
+   LocalOrderGlobalID, ///< Cells sorted by global ID (default)
+   LocalOrderRCM       ///< Reverse Cuthill-McKee ordering of cells
+};
+
+/// Translates an input string for the local ordering option to the
+/// enum for later use
+LocalOrder getLocalOrderFromStr(
+    const std::string &InOrder ///< [in] choice of local ordering
+);
+
 /// The Decomp class creates and maintains most of the information related
 /// to the mesh index space and its distribution across partitions or processors
 /// in a parallel domain decomposition. This information includes the location
@@ -80,15 +137,72 @@ class Decomp {
    /// map paired with a name for later retrieval.
    static std::map<std::string, std::unique_ptr<Decomp>> AllDecomps;
 
+   /// Flag for whether the EdgesOnEdge and NEdgesOnEdge arrays have been
+   /// read. These are only read at construction unless a lazy read was
+   /// requested, in which case they are read by loadEdgesOnEdge.
+   bool EdgesOnEdgeLoaded = false;
+
+   /// Flag for whether the EdgesOnVertex array has been read, which is
+   /// deferred along with EdgesOnEdge and read by loadEdgesOnVertex
+   bool EdgesOnVertexLoaded = false;
+
+   /// Module name under which the arrays are recorded in the MemoryRegistry
+   std::string MemModule;
+
+   /// Records the sizes of all device and host arrays in the MemoryRegistry,
+   /// replacing any earlier record of this decomposition
+   void recordMemory();
+
    /// Partition cells by calling the METIS/ParMETIS KWay routine
    /// It starts with the CellsOnCell array from the input mesh file
-   /// distributed across tasks in linear contiguous chunks
+   /// distributed across tasks in linear contiguous chunks. If the cell
+   /// weights are not empty, they hold NConstraints weights for each cell
+   /// in the same distribution and the partition balances each weight.
    /// On output, it has defined all the NCells sizes (NCellsOwned,
    /// NCellsHalo array, NCellsAll and NCellsSize) and the final CellID
    /// and CellLoc arrays
    int partCellsKWay(
-       const MachEnv *InEnv,                  ///< [in] MachEnv with MPI info
-       const std::vector<I4> &CellsOnCellInit ///< [in] cell nbrs in init dstrb
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs init dstrb
+       const std::vector<I4> &CellWgtInit,     ///< [in] cell wgts init dstrb
+       I4 NConstraints                         ///< [in] num weights per cell
+   );
+
+   /// Partition cells by calling the distributed ParMETIS KWay routine.
+   /// Each task passes only its portion of the adjacency graph in the
+   /// initial linear distribution, so no task holds the global graph. On
+   /// output, the NCells sizes and the final CellID and CellLoc arrays are
+   /// defined as in partCellsKWay.
+   int partCellsParMetisKWay(
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs init dstrb
+       const std::vector<I4> &CellWgtInit,     ///< [in] cell wgts init dstrb
+       I4 NConstraints                         ///< [in] num weights per cell
+   );
+
+   /// Partition cells into equal contiguous sections of a Hilbert
+   /// space-filling curve through the cell centers read from the mesh file.
+   /// If cell weights are supplied, the sections have equal total weight
+   /// using the first weight of each cell.
+   /// The cells are sorted along the curve in parallel, so no adjacency
+   /// information needs to be gathered. On output, the NCells sizes and the
+   /// final CellID and CellLoc arrays are defined as in partCellsKWay.
+   int partCellsSFC(
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs init dstrb
+       const std::vector<I4> &CellWgtInit,     ///< [in] cell wgts init dstrb
+       I4 NConstraints                         ///< [in] num weights per cell
+   );
+
+   /// Define the NCells sizes and the final CellID and CellLoc arrays from
+   /// the task assigned to each cell in the initial linear distribution.
+   /// Cell ownership, locations and halo neighbors are exchanged between
+   /// tasks with all-to-all messages so that only the local portions of
+   /// the partition and adjacency are needed on each task.
+   int setCellsFromPartition(
+       const MachEnv *InEnv,                   ///< [in] MachEnv with MPI info
+       const std::vector<I4> &CellsOnCellInit, ///< [in] cell nbrs init dstrb
+       const std::vector<I4> &CellTaskInit     ///< [in] task for init cells
    );
 
    /// Trivially partition cells in the case of single task
@@ -135,7 +249,8 @@ class Decomp {
    /// Redistribute the various XxOnEdge index arrays to the final edge
    /// decomposition. The inputs are the various XxOnEdge arrays in the
    /// initial linear distribution. On exit, all the XxOnEdge arrays are
-   /// in the correct final domain decomposition.
+   /// in the correct final domain decomposition. An empty EdgesOnEdgeInit
+   /// denotes a lazy read and the EdgesOnEdge arrays are left unset.
    int rearrangeEdgeArrays(
        const MachEnv *InEnv, ///< [in] MachEnv for the new partition
        const std::vector<I4> &CellsOnEdgeInit, ///< [in] cell nbrs on each edge
@@ -153,6 +268,75 @@ class Decomp {
        const std::vector<I4> &EdgesOnVertexInit  ///< [in] edges at each vertex
    );
 
+   /// Reads an edge connectivity array of global edge IDs with NEntries
+   /// entries per edge directly into the final decomposition for all local
+   /// edges and converts the IDs to local addresses. Used for the arrays
+   /// whose read was deferred at construction.
+   int readLocalEdgeArray(
+       const std::string &VarName,    ///< [in] name in the mesh file
+       const std::string &VarNameOld, ///< [in] older name in the mesh file
+       I4 NEntries,                   ///< [in] entries per edge
+       HostArray2DI4 &ArrayH,         ///< [out] local addresses
+       HostArray1DI4 &NValidH         ///< [out] valid entries per edge
+   );
+
+   /// Reads a vertex connectivity array of global edge IDs with NEntries
+   /// entries per vertex directly into the final decomposition for all
+   /// local vertices and converts the IDs to local edge addresses. Used for
+   /// the vertex arrays whose read was deferred at construction.
+   int readLocalVertexArray(
+       const std::string &VarName,    ///< [in] name in the mesh file
+       const std::string &VarNameOld, ///< [in] older name in the mesh file
+       I4 NEntries,                   ///< [in] entries per vertex
+       HostArray2DI4 &ArrayH          ///< [out] local edge addresses
+   );
+
+   /// Reorder the local cells within the owned cells and within each halo
+   /// layer using a reverse Cuthill-McKee ordering of the cell adjacency in
+   /// that block, so neighboring cells are close in memory. The CellID,
+   /// CellLoc and XxOnCell arrays are permuted and the local addresses of
+   /// halo cells are updated from the tasks that own them. Must be called
+   /// after rearrangeCellArrays and before the edges and vertices are
+   /// partitioned, so that they inherit the new cell order.
+   int reorderCells(const MachEnv *InEnv ///< [in] MachEnv with MPI info
+   );
+
+   /// Read the cell decomposition (NCells sizes, CellID and CellLoc) from a
+   /// partition cache file written by writeDecompCache. The cache is only
+   /// used if it was written for the same mesh checksum, number of tasks,
+   /// halo width, partition method, weights and local ordering. Returns 0
+   /// on every task if the cache was loaded and non-zero on every task if
+   /// the file is missing or does not match, in which case the cell
+   /// members are left undefined.
+   int readDecompCache(
+       const MachEnv *InEnv,         ///< [in] MachEnv with MPI info
+       const std::string &CacheFile, ///< [in] name of partition cache file
+       std::uint64_t MeshChecksum,   ///< [in] checksum of mesh connectivity
+       PartMethod Method,            ///< [in] method for partitioning
+       LocalOrder Order,             ///< [in] ordering of local cells
+       PartWeight Weight             ///< [in] weights for partition
+   );
+
+   /// Write the final cell decomposition to a partition cache file so that
+   /// later runs with the same mesh and task count can skip the cell
+   /// partitioning and reordering. Every task writes its own record to a
+   /// single file with collective MPI-IO.
+   int writeDecompCache(
+       const MachEnv *InEnv,         ///< [in] MachEnv with MPI info
+       const std::string &CacheFile, ///< [in] name of partition cache file
+       std::uint64_t MeshChecksum,   ///< [in] checksum of mesh connectivity
+       PartMethod Method,            ///< [in] method for partitioning
+       LocalOrder Order,             ///< [in] ordering of local cells
+       PartWeight Weight             ///< [in] weights for partition
+   );
+
+   /// Sort the owned cells and edges into interior and boundary lists.
+   /// Interior cells are more than InteriorWidth cell layers from the halo
+   /// and interior edges border only interior cells, so stencils up to
+   /// InteriorWidth cells wide on them depend only on owned values and may
+   /// overlap with a halo exchange.
+   void setInteriorLists();
+
    /// Construct a new decomposition across an input MachEnv with
    /// NPart partitions of a mesh that is read from a mesh file.
    Decomp(const std::string &Name, ///< [in] Name for new decomposition
@@ -160,7 +344,11 @@ class Decomp {
           I4 NParts,               ///< [in] num of partitions for new decomp
           PartMethod Method,       ///< [in] method for partitioning
           I4 InHaloWidth,          ///< [in] width of halo in new decomp
-          const std::string &MeshFileName_ ///< [in] name of file with mesh info
+          const std::string &MeshFileName_, ///< [in] file with mesh info
+          LocalOrder Order,                 ///< [in] ordering of local cells
+          PartWeight Weight,                ///< [in] weights for partition
+          bool LazyRead,                    ///< [in] defer the lazy arrays
+          const std::string &CacheFile      ///< [in] partition cache file
    );
 
    // forbid copy and move construction
@@ -174,12 +362,27 @@ class Decomp {
 
    std::string MeshFileName; ///< The name of the file with mesh info
 
+   // Wall-clock times in seconds on this task of the phases of the
+   // construction, used to benchmark the decomposition. The gather and METIS
+   // times are only set by the KWay method and are part of the partition time.
+
+   R8 ReadMeshTime{0};  ///< read the mesh connectivity and weights
+   R8 GatherTime{0};    ///< gather the global adjacency graph
+   R8 MetisTime{0};     ///< METIS partition of the cells
+   R8 PartitionTime{0}; ///< partition cells, edges and vertices
+   R8 RearrangeTime{0}; ///< redistribute the connectivity arrays
+   R8 ConstructTime{0}; ///< total construction
+
+   bool CacheLoaded{false}; ///< cell decomposition was read from the cache
+
    // Sizes and global IDs
    // Note that all sizes are actual counts (1-based) so that loop extents
    // should always use the 0:NCellsXX-1 form.
 
    I4 HaloWidth; ///< Number of halo layers for cell-based variables
 
+   I4 InteriorWidth{2}; ///< Cell layers between interior cells and halo
+
    I4 NCellsGlobal; ///< Number of cells in the full global mesh
    I4 NCellsOwned;  ///< Number of cells owned by this task
    I4 NCellsAll;    ///< Total number of local cells (owned + all halo)
@@ -219,6 +422,28 @@ class Decomp {
    Array2DI4 VertexLoc;      ///< location (task, local add) for local vrtx halo
    HostArray2DI4 VertexLocH; ///< location (task, local add) for local vrtx halo
 
+   // Owned interior and boundary index lists. An owned cell is interior if
+   // no halo cell can be reached from it in InteriorWidth steps across cell
+   // neighbors. An owned edge is interior if all cells on the edge are
+   // interior cells. Stencils over interior elements that reach at most
+   // InteriorWidth cells away read no halo values and can be computed while
+   // a halo exchange is in progress, the boundary elements once the
+   // exchange completes.
+
+   I4 NCellsInterior;            ///< Number of owned interior cells
+   I4 NCellsBoundary;            ///< Number of owned boundary cells
+   Array1DI4 CellsInterior;      ///< local indices of owned interior cells
+   HostArray1DI4 CellsInteriorH; ///< local indices of owned interior cells
+   Array1DI4 CellsBoundary;      ///< local indices of owned boundary cells
+   HostArray1DI4 CellsBoundaryH; ///< local indices of owned boundary cells
+
+   I4 NEdgesInterior;            ///< Number of owned interior edges
+   I4 NEdgesBoundary;            ///< Number of owned boundary edges
+   Array1DI4 EdgesInterior;      ///< local indices of owned interior edges
+   HostArray1DI4 EdgesInteriorH; ///< local indices of owned interior edges
+   Array1DI4 EdgesBoundary;      ///< local indices of owned boundary edges
+   HostArray1DI4 EdgesBoundaryH; ///< local indices of owned boundary edges
+
    // Mesh connectivity
 
    Array2DI4 CellsOnCell;      ///< Indx of cells that neighbor each cell
@@ -266,7 +491,11 @@ class Decomp {
           I4 NParts,               ///< [in] num of partitions for new decomp
           PartMethod Method,       ///< [in] method for partitioning
           I4 HaloWidth,            ///< [in] width of halo in new decomp
-          const std::string &MeshFileName ///< [in] name of file with mesh info
+          const std::string &MeshFileName, ///< [in] file with mesh info
+          LocalOrder Order  = LocalOrderGlobalID, ///< [in] local cell order
+          PartWeight Weight = PartWeightNone,     ///< [in] partition weights
+          bool LazyRead     = false,              ///< [in] defer lazy arrays
+          const std::string &CacheFile = ""       ///< [in] partition cache
    );
 
    /// Destructor - deallocates all memory and deletes a Decomp.
@@ -289,8 +518,45 @@ class Decomp {
    /// Retrieve a decomposition by name.
    static Decomp *get(std::string name);
 
+   /// Reads the EdgesOnEdge and NEdgesOnEdge arrays from the mesh file if
+   /// they were deferred at construction and converts them to local
+   /// addresses. Does nothing if they are already loaded. It must be called
+   /// by all tasks in the decomposition since it uses parallel IO.
+   int loadEdgesOnEdge();
+
+   /// Reads the EdgesOnVertex array from the mesh file if it was deferred
+   /// at construction and converts it to local edge addresses. Does nothing
+   /// if it is already loaded. Must be called by all tasks in the
+   /// decomposition since it uses parallel IO.
+   int loadEdgesOnVertex();
+
+   /// Reads every connectivity array whose read was deferred at
+   /// construction (EdgesOnEdge and EdgesOnVertex). Must be called by all
+   /// tasks before any consumer copies the connectivity arrays, in
+   /// particular before the HorzMesh is built from this decomposition.
+   int loadDeferred();
+
+   /// Frees the host copies of the connectivity and interior/boundary
+   /// arrays, which are only needed while the mesh is initialized. The host
+   /// copies of the sizes, IDs and locations are kept since halos and IO
+   /// decompositions are built from them. Must not be called before all
+   /// users of the host connectivity arrays have been initialized.
+   void dropHostMirrors();
+
+   /// Rebuilds the interior and boundary lists so that interior cells are
+   /// more than Width cell layers from the halo. Width must be between 1
+   /// and HaloWidth and this must be called before dropHostMirrors.
+   void setInteriorWidth(I4 Width ///< [in] cell layers to the halo
+   );
+
    /// Query functions
 
+   /// Checks whether the EdgesOnEdge arrays have been read
+   bool hasEdgesOnEdge() const { return EdgesOnEdgeLoaded; }
+
+   /// Checks whether the EdgesOnVertex array has been read
+   bool hasEdgesOnVertex() const { return EdgesOnVertexLoaded; }
+
    /// Checks a global cell ID to make sure it is in the valid range
    bool validCellID(I4 InCellID ///< [in] a cell ID to check
    );
@@ -0,0 +1,117 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- base/ExecInstances.cpp - concurrent execution instances -*- C++ -*-===//
+//
+// Partitions the default execution space into one instance for each kernel
+// group that can run concurrently.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ExecInstances.h"
+#include "Config.h"
+#include "Error.h"
+#include "Logging.h"
+
+namespace OMEGA {
+
+// create the static class members
+std::vector<ExecSpace> ExecInstances::Instances;
+
+// Number of instances before the tracer instances
+static constexpr I4 NFixedInstances = 2;
+
+//------------------------------------------------------------------------------
+// Read the options from the optional ConcurrentExec group of the Omega Config
+// and partition the default execution space if concurrent execution is
+// enabled
+void ExecInstances::init() {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("ConcurrentExec"))
+      return;
+
+   Config ExecConfig("ConcurrentExec");
+   Error Err = OmegaConfig->get(ExecConfig);
+   CHECK_ERROR_ABORT(Err, "ExecInstances: error reading ConcurrentExec group");
+
+   bool Enabled;
+   Err += ExecConfig.get("Enabled", Enabled);
+   CHECK_ERROR_ABORT(Err, "ExecInstances: Enabled not found in "
+                          "ConcurrentExec Config");
+   if (!Enabled)
+      return;
+
+   I4 NTracerInstances;
+   Err += ExecConfig.get("NTracerInstances", NTracerInstances);
+   CHECK_ERROR_ABORT(Err, "ExecInstances: NTracerInstances not found in "
+                          "ConcurrentExec Config");
+   if (NTracerInstances < 1)
+      ABORT_ERROR("ExecInstances: NTracerInstances {} must be at least 1",
+                  NTracerInstances);
+
+   // All groups get an equal share of the device
+   std::vector<I4> Weights(NFixedInstances + NTracerInstances, 1);
+   Instances = Kokkos::Experimental::partition_space(ExecSpace(), Weights);
+
+   LOG_INFO("ExecInstances: concurrent execution with {} tracer instances",
+            NTracerInstances);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Return the instance of a kernel group
+ExecSpace ExecInstances::get(ExecGroup Group) {
+
+   if (Instances.empty())
+      return ExecSpace();
+
+   switch (Group) {
+   case ExecGroup::Thickness:
+      return Instances[0];
+   case ExecGroup::Velocity:
+      return Instances[1];
+   case ExecGroup::Tracer:
+      return getTracer(0);
+   }
+   return ExecSpace();
+}
+
+//------------------------------------------------------------------------------
+// Return the instance of a tracer group
+ExecSpace ExecInstances::getTracer(I4 ITracerGroup) {
+
+   if (Instances.empty())
+      return ExecSpace();
+
+   const I4 NTracerInstances = Instances.size() - NFixedInstances;
+   return Instances[NFixedInstances + ITracerGroup % NTracerInstances];
+}
+
+//------------------------------------------------------------------------------
+// Return true if the groups run on separate instances
+bool ExecInstances::isConcurrent() { return !Instances.empty(); }
+
+//------------------------------------------------------------------------------
+// Wait for the kernels on the default instance before launching the groups
+void ExecInstances::fenceDefault() {
+   if (!Instances.empty())
+      ExecSpace().fence("ExecInstances::fenceDefault");
+}
+
+//------------------------------------------------------------------------------
+// Wait for the kernels of all groups
+void ExecInstances::fence() {
+   for (const auto &Instance : Instances)
+      Instance.fence("ExecInstances::fence");
+}
+
+//------------------------------------------------------------------------------
+// Remove the instances
+void ExecInstances::clear() { Instances.clear(); }
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
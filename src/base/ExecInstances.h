@@ -0,0 +1,89 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_EXECINSTANCES_H
+#define OMEGA_EXECINSTANCES_H
+//===-- base/ExecInstances.h - concurrent execution instances ---*- C++ -*-===//
+//
+/// \file
+/// \brief Provides execution space instances for concurrent kernel groups
+///
+/// Groups of kernels that write disjoint outputs, such as the thickness,
+/// velocity and tracer tendencies, normally run one after another on the
+/// default execution space. On small meshes each kernel may underfill a GPU.
+/// With concurrent execution enabled, each group is given its own execution
+/// space instance (a CUDA or HIP stream) so the groups can overlap. The
+/// tracer tendencies can use several instances, one per tracer group.
+/// Kernels on different instances are not ordered, so the inputs of the
+/// groups, which are produced on the default instance, must be completed with
+/// fenceDefault() before the groups are launched, and the instances must be
+/// joined with fence() before the results are used by kernels on the default
+/// instance.
+///
+/// When concurrent execution is disabled, which is the default, every group
+/// uses the default instance and fence() does nothing. Options are read
+/// from the optional ConcurrentExec group of the Omega Config:
+/// \ConfigInput
+/// ConcurrentExec:
+///    # Launch the kernel groups on separate instances (default false)
+///    Enabled: false
+///    # Number of instances for the tracer groups
+///    NTracerInstances: 1
+/// \EndConfigInput
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <vector>
+
+namespace OMEGA {
+
+/// Kernel groups that can run concurrently
+enum class ExecGroup {
+   Thickness, ///< thickness tendencies
+   Velocity,  ///< normal velocity tendencies
+   Tracer     ///< tracer tendencies, first tracer group
+};
+
+/// Execution space instances for the concurrent kernel groups
+class ExecInstances {
+ public:
+   /// Reads the options from the optional ConcurrentExec group of the Omega
+   /// Config and creates the instances if concurrent execution is enabled
+   static void init();
+
+   /// Returns the instance of a kernel group
+   static ExecSpace get(ExecGroup Group ///< [in] kernel group
+   );
+
+   /// Returns the instance of tracer group ITracerGroup. Tracer groups
+   /// beyond the number of tracer instances share instances cyclically.
+   static ExecSpace getTracer(I4 ITracerGroup ///< [in] tracer group index
+   );
+
+   /// Returns true if the groups run on separate instances
+   static bool isConcurrent();
+
+   /// Waits for the kernels queued on the default instance, which produce
+   /// the inputs of the groups, to complete before the groups are launched.
+   /// Does nothing if the groups run on the default instance.
+   static void fenceDefault();
+
+   /// Waits for the kernels of all groups to complete. Does nothing if the
+   /// groups run on the default instance.
+   static void fence();
+
+   /// Removes the instances. Must be called before Kokkos is finalized.
+   static void clear();
+
+ private:
+   /// Instances of the thickness and velocity groups followed by those of
+   /// the tracer groups, empty if concurrent execution is disabled
+   static std::vector<ExecSpace> Instances;
+};
+
+} // namespace OMEGA
+#endif
@@ -10,24 +10,34 @@
 // supported Kokkos array types for a given machine environment (MachEnv)
 // and parallel decomposition (Decomp). These exchanges are carried out
 // via non-blocking MPI library routines. Constructor and private member
-// functions are defined here. Multiple Halo member functions are defined
-// as function templates, including the main interface to perform a halo
-// exchange on a given array, exchangeFullArrayHalo, and thus are defined
-// in the associated header file, Halo.h.
+// functions are defined here, along with exchangeArrayHalos which exchanges
+// a list of arrays with one message per neighbor. Multiple Halo member
+// functions are defined as function templates, including the main interface
+// to perform a halo exchange on a given array, exchangeFullArrayHalo, and
+// thus are defined in the associated header file, Halo.h.
 //
 //===----------------------------------------------------------------------===//
 
 #include "Halo.h"
+#include "Config.h"
+#include "Error.h"
+#include "Timing.h"
 #include "mpi.h"
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <utility>
 
 namespace OMEGA {
 
 // create the static class members
 Halo *Halo::DefaultHalo = nullptr;
 std::map<std::string, std::unique_ptr<Halo>> Halo::AllHalos;
+#ifdef OMEGA_MPI_ON_DEVICE
+bool Halo::MPIOnDevice = true;
+#else
+bool Halo::MPIOnDevice = false;
+#endif
 
 //------------------------------------------------------------------------------
 // Local routine that searches a std::vector<I4> for a particular entry and
@@ -142,6 +152,26 @@ int Halo::init() {
    MachEnv *DefEnv   = MachEnv::getDefault();
    Decomp *DefDecomp = Decomp::getDefault();
 
+   // The Halo Config group is optional. If present, MPIOnDevice selects
+   // whether device buffers are passed directly to MPI, otherwise the
+   // default set at build time is used.
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Halo")) {
+      Config HaloConfig("Halo");
+      Error Err = OmegaConfig->get(HaloConfig);
+      CHECK_ERROR_ABORT(Err, "Halo: error retrieving Halo Config group");
+
+      if (HaloConfig.existsVar("MPIOnDevice")) {
+         Err = HaloConfig.get("MPIOnDevice", MPIOnDevice);
+         CHECK_ERROR_ABORT(Err, "Halo: error reading MPIOnDevice from Config");
+      }
+   }
+#ifndef OMEGA_MPI_ON_DEVICE
+   if (MPIOnDevice)
+      LOG_WARN("Halo: MPIOnDevice requested but Omega was built without "
+               "OMEGA_MPI_ON_DEVICE, MPI must support device memory");
+#endif
+
    Halo::DefaultHalo = create("Default", DefEnv, DefDecomp);
 
    return IErr;
@@ -160,6 +190,14 @@ Halo::Halo(const std::string &Name, const MachEnv *InEnv,
    // Set pointer for the Decomp
    MyDecomp = InDecomp;
 
+   // Device buffers are passed to MPI directly if MPI is device aware,
+   // otherwise they are staged through host memory on a separate execution
+   // space instance
+   ExchOnDev = MPIOnDevice;
+   if (!ExchOnDev)
+      CopySpace = Kokkos::Experimental::partition_space(
+          Kokkos::DefaultExecutionSpace(), 1)[0];
+
    // Set member variable for the halo width
    HaloWidth = MyDecomp->HaloWidth;
 
@@ -232,7 +270,18 @@ Halo *Halo::create(const std::string &Name, const MachEnv *Env,
 
 Halo::~Halo() {
 
-   // No operations necessary
+   // Free the persistent requests of any registered exchanges. This is
+   // only possible if MPI has not yet been finalized.
+   I4 Finalized{0};
+   MPI_Finalized(&Finalized);
+   if (!Finalized) {
+      for (auto &RegEntry : RegExchanges) {
+         for (auto &Req : RegEntry.second.SendReqs)
+            MPI_Request_free(&Req);
+         for (auto &Req : RegEntry.second.RecvReqs)
+            MPI_Request_free(&Req);
+      }
+   }
 
 } // end destructor
 
@@ -283,6 +332,26 @@ Halo *Halo::get(const std::string Name // name of Halo to retrieve
    }
 } // end Halo get
 
+//------------------------------------------------------------------------------
+// Get the neighbor task IDs and the message sizes in elements for an index
+// space. The sizes are per element, so the message length of an array is
+// this size times the size of the array at each element.
+
+void Halo::getNeighborSizes(MeshElement Elem, std::vector<I4> &TaskIDs,
+                            std::vector<I4> &NSend,
+                            std::vector<I4> &NRecv) const {
+
+   TaskIDs.resize(NNghbr);
+   NSend.resize(NNghbr);
+   NRecv.resize(NNghbr);
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      TaskIDs[INghbr] = Neighbors[INghbr].TaskID;
+      NSend[INghbr]   = Neighbors[INghbr].SendLists[Elem].NTot;
+      NRecv[INghbr]   = Neighbors[INghbr].RecvLists[Elem].NTot;
+   }
+
+} // end getNeighborSizes
+
 //------------------------------------------------------------------------------
 // Sets Halo class members NeighborList, NNghbr, SendFlags, and RecvFlags during
 // Halo construction
@@ -654,6 +723,644 @@ int Halo::exchangeVectorInt(
    return Err;
 } // end exchangeVectorInt
 
+//------------------------------------------------------------------------------
+// Determine the total number of buffer elements to send to and receive from
+// each Neighbor for all arrays in the input list, and flag the neighbors that
+// a message must be sent to or received from in at least one index space
+
+int Halo::setExchangeSizes(const HaloArrayList &List) {
+
+   I4 Err{0}; // error code to return
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+
+      LocNeighbor.SendSize = 0;
+      LocNeighbor.RecvSize = 0;
+      LocNeighbor.SendMsg  = false;
+      LocNeighbor.RecvMsg  = false;
+
+      for (const auto &Entry : List.Entries) {
+         const MeshElement Elem = Entry.Elem;
+         if (SendFlags[Elem][INghbr]) {
+            LocNeighbor.SendSize +=
+                Entry.TotSize * LocNeighbor.SendLists[Elem].NTot;
+            LocNeighbor.SendMsg = true;
+         }
+         if (RecvFlags[Elem][INghbr]) {
+            LocNeighbor.RecvSize +=
+                Entry.TotSize * LocNeighbor.RecvLists[Elem].NTot;
+            LocNeighbor.RecvMsg = true;
+         }
+      }
+   }
+
+   return Err;
+} // end setExchangeSizes
+
+//------------------------------------------------------------------------------
+// Pack all arrays in the input list into the send buffer of each Neighbor.
+// Each array occupies a contiguous section of the buffer starting at the
+// end of the previous array.
+
+int Halo::packArrayList(const HaloArrayList &List) {
+
+   I4 Err{0}; // error code to return
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+      if (!LocNeighbor.SendMsg)
+         continue;
+
+      LocNeighbor.SendOffset = 0;
+      for (const auto &Entry : List.Entries) {
+         CurElem = Entry.Elem;
+         TotSize = Entry.TotSize;
+         if (SendFlags[CurElem][INghbr]) {
+            Entry.Pack(*this, INghbr);
+            LocNeighbor.SendOffset +=
+                TotSize * LocNeighbor.SendLists[CurElem].NTot;
+         }
+      }
+      LocNeighbor.SendOffset = 0;
+   }
+
+   return Err;
+} // end packArrayList
+
+//------------------------------------------------------------------------------
+// Unpack all arrays in the input list from the receive buffer of the
+// Neighbor INghbr, in the same order they were packed by the sending task
+
+int Halo::unpackArrayList(const HaloArrayList &List, const I4 INghbr) {
+
+   I4 Err{0}; // error code to return
+
+   auto &LocNeighbor = Neighbors[INghbr];
+
+   LocNeighbor.RecvOffset = 0;
+   for (const auto &Entry : List.Entries) {
+      CurElem = Entry.Elem;
+      TotSize = Entry.TotSize;
+      if (RecvFlags[CurElem][INghbr]) {
+         Entry.Unpack(*this, INghbr);
+         LocNeighbor.RecvOffset +=
+             TotSize * LocNeighbor.RecvLists[CurElem].NTot;
+      }
+   }
+   LocNeighbor.RecvOffset = 0;
+
+   return Err;
+} // end unpackArrayList
+
+//------------------------------------------------------------------------------
+// Start a split-phase halo exchange for every array in the input list. The
+// receives are posted, the buffers packed and the sends started, but the
+// function returns without waiting for any message to arrive.
+
+HaloExchangeHandle Halo::startExchange(const HaloArrayList &List) {
+
+   HaloExchangeHandle Handle;
+   Handle.List = std::make_shared<const HaloArrayList>(List);
+
+   if (ExchangeActive) {
+      LOG_ERROR("Halo: cannot start a halo exchange while another exchange "
+                "on the same Halo is in progress");
+      Handle.Err = -1;
+      return Handle;
+   }
+
+   if (List.Entries.empty())
+      return Handle;
+
+   // For now, all arrays in an aggregated exchange must be in the same memory
+   // space since they share the same host or device buffers
+   Handle.UseDevBuffer = List.Entries[0].OnDev;
+   for (const auto &Entry : List.Entries) {
+      if (Entry.OnDev != Handle.UseDevBuffer) {
+         LOG_ERROR("Halo: all arrays in a HaloArrayList must reside in the "
+                   "same memory space");
+         Handle.Err = -1;
+         return Handle;
+      }
+   }
+
+   // Compute the aggregated message size for each neighbor
+   setExchangeSizes(List);
+
+   // Device buffers exchanged through host memory are sections of the
+   // contiguous staging buffers
+   const bool Staged = Handle.UseDevBuffer && !ExchOnDev;
+   if (Staged)
+      setStagingBuffers();
+
+   // Allocate the receive buffers and Call MPI_Irecv for each Neighbor
+   // so the local task is ready to accept messages from each
+   // neighboring task
+   if (startReceives(Handle.UseDevBuffer) != 0)
+      Handle.Err = -1;
+
+   // Make sure the send buffers are large enough for all the arrays before
+   // packing, since expanding a buffer discards its contents
+   for (int INghbr = 0; INghbr < NNghbr && !Staged; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+      if (LocNeighbor.SendMsg) {
+         if (Handle.UseDevBuffer) {
+            expandBuffer(LocNeighbor.SendBuffer, LocNeighbor.SendSize);
+         } else {
+            expandBuffer(LocNeighbor.SendBufferH, LocNeighbor.SendSize);
+         }
+      }
+   }
+
+   // Pack the buffers for all neighbors that elements are sent to
+   packArrayList(List);
+
+   // Call MPI_Isend for each Neighbor to send the packed buffers
+   if (startSends(Handle.UseDevBuffer) != 0)
+      Handle.Err = -1;
+
+   // Collect all send and receive requests in the handle
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      if (Neighbors[INghbr].SendMsg) {
+         Handle.SendReqs.push_back(Neighbors[INghbr].SReq);
+      }
+      if (Neighbors[INghbr].RecvMsg) {
+         Handle.RecvReqs.push_back(Neighbors[INghbr].RReq);
+         Handle.RecvNghbr.push_back(INghbr);
+      }
+   }
+
+   Handle.Active  = true;
+   ExchangeActive = true;
+
+   return Handle;
+} // end startExchange
+
+//------------------------------------------------------------------------------
+// Unpack any messages of an active split-phase exchange that have already
+// arrived. Returns true once all messages have been received.
+
+bool Halo::testExchange(HaloExchangeHandle &Handle) {
+
+   if (!Handle.Active)
+      return true;
+
+   I4 NReqs = Handle.RecvReqs.size();
+   if (Handle.NRcvd == NReqs)
+      return true;
+
+   I4 NDone{0};
+   std::vector<I4> Indices(NReqs);
+   MPI_Testsome(NReqs, Handle.RecvReqs.data(), &NDone, Indices.data(),
+                MPI_STATUSES_IGNORE);
+
+   // Staged messages that arrive early are copied to the device one at a
+   // time so they can be unpacked while the others are still in flight
+   const bool Staged = Handle.UseDevBuffer && !ExchOnDev;
+
+   // MPI_Testsome returns MPI_UNDEFINED if no active requests remain
+   if (NDone != MPI_UNDEFINED) {
+      for (int IDone = 0; IDone < NDone; ++IDone) {
+         const I4 INghbr = Handle.RecvNghbr[Indices[IDone]];
+         if (Staged)
+            copyRecvMsg(INghbr);
+         if (unpackArrayList(*Handle.List, INghbr) != 0)
+            Handle.Err = -1;
+         ++Handle.NRcvd;
+      }
+   }
+
+   return Handle.NRcvd == NReqs;
+} // end testExchange
+
+//------------------------------------------------------------------------------
+// Complete a split-phase exchange. The remaining messages are unpacked in the
+// order they arrive, blocking in MPI_Waitany rather than polling.
+
+int Halo::finishExchange(HaloExchangeHandle &Handle) {
+
+   if (!Handle.Active)
+      return Handle.Err;
+
+   I4 NReqs = Handle.RecvReqs.size();
+
+   // If device buffers are staged through host memory and none of the
+   // messages were unpacked by testExchange, wait for all messages, copy
+   // them to the device at once and then unpack them all. Otherwise the
+   // remaining messages are copied and unpacked one at a time below.
+   const bool Staged = Handle.UseDevBuffer && !ExchOnDev;
+   if (Staged && Handle.NRcvd == 0) {
+      I4 IErr = MPI_Waitall(NReqs, Handle.RecvReqs.data(), MPI_STATUSES_IGNORE);
+      if (IErr != MPI_SUCCESS) {
+         LOG_ERROR("Halo: error waiting for messages during halo exchange");
+         Handle.Err = -1;
+      }
+      copyRecvStage();
+      for (int IReq = 0; IReq < NReqs; ++IReq) {
+         if (unpackArrayList(*Handle.List, Handle.RecvNghbr[IReq]) != 0)
+            Handle.Err = -1;
+      }
+      Handle.NRcvd = NReqs;
+   }
+
+   while (Handle.NRcvd < NReqs) {
+      I4 IDone{MPI_UNDEFINED};
+      I4 IErr = MPI_Waitany(NReqs, Handle.RecvReqs.data(), &IDone,
+                            MPI_STATUS_IGNORE);
+      if (IErr != MPI_SUCCESS || IDone == MPI_UNDEFINED) {
+         LOG_ERROR("Halo: error waiting for messages during halo exchange");
+         Handle.Err = -1;
+         break;
+      }
+      if (Staged)
+         copyRecvMsg(Handle.RecvNghbr[IDone]);
+      if (unpackArrayList(*Handle.List, Handle.RecvNghbr[IDone]) != 0)
+         Handle.Err = -1;
+      ++Handle.NRcvd;
+   }
+
+   // We need to fence here because we are reusing buffers and GPU work is
+   // async. Only the default instance runs the unpacking kernels.
+   if (Handle.UseDevBuffer) {
+      Kokkos::DefaultExecutionSpace().fence();
+   }
+
+   // Wait for all sends to complete before proceeding
+   MPI_Waitall(Handle.SendReqs.size(), Handle.SendReqs.data(),
+               MPI_STATUSES_IGNORE);
+
+   // Restore the Neighbor buffers if this was a registered exchange
+   if (!Handle.RegName.empty()) {
+      auto It = RegExchanges.find(Handle.RegName);
+      if (It != RegExchanges.end())
+         swapRegisteredBuffers(It->second);
+   }
+
+   Handle.Active  = false;
+   ExchangeActive = false;
+
+   return Handle.Err;
+} // end finishExchange
+
+//------------------------------------------------------------------------------
+// Register a list of arrays for repeated exchange. Buffers are allocated at
+// the exact size needed for each neighbor and persistent MPI requests are
+// created once for these buffers.
+
+int Halo::registerExchange(const std::string &Name,
+                           const HaloArrayList &List) {
+
+   I4 Err{0}; // error code to return
+
+   // Registration resizes the Neighbor messages, which an exchange in
+   // progress is still using
+   if (ExchangeActive) {
+      LOG_ERROR("Halo: cannot register exchange {} while an exchange on the "
+                "same Halo is in progress",
+                Name);
+      return -1;
+   }
+
+   if (RegExchanges.find(Name) != RegExchanges.end()) {
+      LOG_ERROR("Halo: attempt to register exchange {} but an exchange of "
+                "that name is already registered",
+                Name);
+      return -1;
+   }
+
+   if (List.Entries.empty()) {
+      LOG_ERROR("Halo: attempt to register empty exchange {}", Name);
+      return -1;
+   }
+
+   RegisteredExchange Reg;
+   Reg.List         = std::make_shared<const HaloArrayList>(List);
+   Reg.UseDevBuffer = List.Entries[0].OnDev;
+   for (const auto &Entry : List.Entries) {
+      if (Entry.OnDev != Reg.UseDevBuffer) {
+         LOG_ERROR("Halo: all arrays in a HaloArrayList must reside in the "
+                   "same memory space");
+         return -1;
+      }
+   }
+
+   // Device buffers are needed whenever the arrays are packed on device,
+   // host buffers whenever the MPI calls use host memory
+   const bool NeedDev  = Reg.UseDevBuffer;
+   const bool NeedHost = !(Reg.UseDevBuffer && ExchOnDev);
+
+   setExchangeSizes(List);
+
+   // If both are needed, the buffers of all neighbors are sections of
+   // contiguous staging buffers so each direction needs only one copy
+   const bool Staged = NeedDev && NeedHost;
+   if (Staged) {
+      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+         auto &LocNeighbor = Neighbors[INghbr];
+         if (LocNeighbor.SendMsg)
+            Reg.SendStageSize += LocNeighbor.SendSize;
+         if (LocNeighbor.RecvMsg)
+            Reg.RecvStageSize += LocNeighbor.RecvSize;
+      }
+      Reg.SendStage  = Array1DR8("RegSendStage", Reg.SendStageSize);
+      Reg.RecvStage  = Array1DR8("RegRecvStage", Reg.RecvStageSize);
+      Reg.SendStageH = HostArray1DR8("RegSendStageH", Reg.SendStageSize);
+      Reg.RecvStageH = HostArray1DR8("RegRecvStageH", Reg.RecvStageSize);
+   }
+
+   I4 SendStart{0}; // start of next neighbor in send staging buffers
+   I4 RecvStart{0}; // start of next neighbor in recv staging buffers
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+
+      const I4 SendSize = LocNeighbor.SendMsg ? LocNeighbor.SendSize : 0;
+      const I4 RecvSize = LocNeighbor.RecvMsg ? LocNeighbor.RecvSize : 0;
+
+      if (Staged) {
+         auto SendRange = Kokkos::make_pair(SendStart, SendStart + SendSize);
+         auto RecvRange = Kokkos::make_pair(RecvStart, RecvStart + RecvSize);
+         Reg.SendBuffer.push_back(Kokkos::subview(Reg.SendStage, SendRange));
+         Reg.RecvBuffer.push_back(Kokkos::subview(Reg.RecvStage, RecvRange));
+         Reg.SendBufferH.push_back(
+             Kokkos::subview(Reg.SendStageH, SendRange));
+         Reg.RecvBufferH.push_back(
+             Kokkos::subview(Reg.RecvStageH, RecvRange));
+         SendStart += SendSize;
+         RecvStart += RecvSize;
+      } else {
+         Reg.SendBuffer.push_back(
+             Array1DR8("RegSendBuffer", NeedDev ? SendSize : 0));
+         Reg.RecvBuffer.push_back(
+             Array1DR8("RegRecvBuffer", NeedDev ? RecvSize : 0));
+         Reg.SendBufferH.push_back(
+             HostArray1DR8("RegSendBufferH", NeedHost ? SendSize : 0));
+         Reg.RecvBufferH.push_back(
+             HostArray1DR8("RegRecvBufferH", NeedHost ? RecvSize : 0));
+      }
+
+      if (LocNeighbor.RecvMsg) {
+         void *DataPtr = NeedHost ? (void *)Reg.RecvBufferH[INghbr].data()
+                                  : (void *)Reg.RecvBuffer[INghbr].data();
+         MPI_Request Req;
+         I4 IErr = MPI_Recv_init(DataPtr, RecvSize, MPI_DOUBLE,
+                                 LocNeighbor.TaskID, MPI_ANY_TAG, MyComm, &Req);
+         if (IErr != 0) {
+            LOG_ERROR("MPI error {} on task {} receive init from task {}",
+                      IErr, MyTask, LocNeighbor.TaskID);
+            Err = -1;
+         }
+         Reg.RecvReqs.push_back(Req);
+         Reg.RecvNghbr.push_back(INghbr);
+      }
+
+      if (LocNeighbor.SendMsg) {
+         void *DataPtr = NeedHost ? (void *)Reg.SendBufferH[INghbr].data()
+                                  : (void *)Reg.SendBuffer[INghbr].data();
+         MPI_Request Req;
+         I4 IErr = MPI_Send_init(DataPtr, SendSize, MPI_DOUBLE,
+                                 LocNeighbor.TaskID, 0, MyComm, &Req);
+         if (IErr != 0) {
+            LOG_ERROR("MPI error {} on task {} send init to task {}", IErr,
+                      MyTask, LocNeighbor.TaskID);
+            Err = -1;
+         }
+         Reg.SendReqs.push_back(Req);
+      }
+   }
+
+   RegExchanges.emplace(Name, std::move(Reg));
+
+   return Err;
+} // end registerExchange
+
+//------------------------------------------------------------------------------
+// Remove a registered exchange, freeing its persistent MPI requests. The
+// buffers are deallocated when the struct is destroyed.
+
+void Halo::unregisterExchange(const std::string &Name) {
+
+   auto It = RegExchanges.find(Name);
+   if (It == RegExchanges.end()) {
+      LOG_ERROR("Halo: attempt to unregister non-existent exchange {}", Name);
+      return;
+   }
+
+   for (auto &Req : It->second.SendReqs)
+      MPI_Request_free(&Req);
+   for (auto &Req : It->second.RecvReqs)
+      MPI_Request_free(&Req);
+
+   RegExchanges.erase(It);
+
+} // end unregisterExchange
+
+//------------------------------------------------------------------------------
+// Swap the registered buffers with the Neighbor buffers. Kokkos views are
+// reference-counted handles so this does not copy or allocate any memory.
+
+void Halo::swapRegisteredBuffers(RegisteredExchange &Reg) {
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+      std::swap(LocNeighbor.SendBuffer, Reg.SendBuffer[INghbr]);
+      std::swap(LocNeighbor.RecvBuffer, Reg.RecvBuffer[INghbr]);
+      std::swap(LocNeighbor.SendBufferH, Reg.SendBufferH[INghbr]);
+      std::swap(LocNeighbor.RecvBufferH, Reg.RecvBufferH[INghbr]);
+   }
+   std::swap(SendStage, Reg.SendStage);
+   std::swap(RecvStage, Reg.RecvStage);
+   std::swap(SendStageH, Reg.SendStageH);
+   std::swap(RecvStageH, Reg.RecvStageH);
+   std::swap(SendStageSize, Reg.SendStageSize);
+   std::swap(RecvStageSize, Reg.RecvStageSize);
+
+} // end swapRegisteredBuffers
+
+//------------------------------------------------------------------------------
+// Start a split-phase exchange of a registered list of arrays using the
+// persistent requests created at registration
+
+HaloExchangeHandle Halo::startRegisteredExchange(const std::string &Name) {
+
+   HaloExchangeHandle Handle;
+
+   auto It = RegExchanges.find(Name);
+   if (It == RegExchanges.end()) {
+      LOG_ERROR("Halo: attempt to start non-existent registered exchange {}",
+                Name);
+      Handle.Err = -1;
+      return Handle;
+   }
+   if (ExchangeActive) {
+      LOG_ERROR("Halo: cannot start a halo exchange while another exchange "
+                "on the same Halo is in progress");
+      Handle.Err = -1;
+      return Handle;
+   }
+
+   RegisteredExchange &Reg = It->second;
+
+   Handle.List         = Reg.List;
+   Handle.RegName      = Name;
+   Handle.UseDevBuffer = Reg.UseDevBuffer;
+   Handle.RecvReqs     = Reg.RecvReqs;
+   Handle.SendReqs     = Reg.SendReqs;
+   Handle.RecvNghbr    = Reg.RecvNghbr;
+
+   // Restore the message sizes and flags used by the pack and unpack methods
+   setExchangeSizes(*Reg.List);
+   swapRegisteredBuffers(Reg);
+
+   // Post all receives before packing
+   if (!Handle.RecvReqs.empty()) {
+      if (MPI_Startall(Handle.RecvReqs.size(), Handle.RecvReqs.data()) != 0)
+         Handle.Err = -1;
+   }
+
+   packArrayList(*Reg.List);
+
+   // If MPI can not access device memory, the packed device buffers are
+   // copied to the host buffers bound to the persistent requests
+   if (Handle.UseDevBuffer) {
+      if (ExchOnDev) {
+         Kokkos::DefaultExecutionSpace().fence();
+      } else {
+         copySendStage();
+      }
+   }
+
+   if (!Handle.SendReqs.empty()) {
+      if (MPI_Startall(Handle.SendReqs.size(), Handle.SendReqs.data()) != 0)
+         Handle.Err = -1;
+   }
+
+   Handle.Active  = true;
+   ExchangeActive = true;
+
+   return Handle;
+} // end startRegisteredExchange
+
+//------------------------------------------------------------------------------
+// Perform a full halo exchange of a registered list of arrays
+
+int Halo::exchangeRegistered(const std::string &Name) {
+
+   TimingRegion Region("haloExchange");
+
+   HaloExchangeHandle Handle = startRegisteredExchange(Name);
+
+   return finishExchange(Handle);
+
+} // end exchangeRegistered
+
+//------------------------------------------------------------------------------
+// Perform a full halo exchange for every array in the input list, sending a
+// single aggregated message to each neighboring task
+
+int Halo::exchangeArrayHalos(const HaloArrayList &List) {
+
+   TimingRegion Region("haloExchange");
+
+   HaloExchangeHandle Handle = startExchange(List);
+
+   return finishExchange(Handle);
+
+} // end exchangeArrayHalos
+
+//------------------------------------------------------------------------------
+// Size the contiguous staging buffers for the current exchange and set the
+// device and host buffers of each Neighbor to consecutive sections of them.
+// The staging buffers only grow, so their allocation is reused by later
+// exchanges of the same or smaller size.
+
+void Halo::setStagingBuffers() {
+
+   SendStageSize = 0;
+   RecvStageSize = 0;
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+      if (LocNeighbor.SendMsg)
+         SendStageSize += LocNeighbor.SendSize;
+      if (LocNeighbor.RecvMsg)
+         RecvStageSize += LocNeighbor.RecvSize;
+   }
+
+   expandBuffer(SendStage, SendStageSize);
+   expandBuffer(RecvStage, RecvStageSize);
+   expandBuffer(SendStageH, SendStageSize);
+   expandBuffer(RecvStageH, RecvStageSize);
+
+   I4 SendStart{0}; // start of next neighbor in send staging buffers
+   I4 RecvStart{0}; // start of next neighbor in recv staging buffers
+
+   for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
+      auto &LocNeighbor = Neighbors[INghbr];
+      if (LocNeighbor.SendMsg) {
+         I4 End     = SendStart + LocNeighbor.SendSize;
+         auto Range = Kokkos::make_pair(SendStart, End);
+         LocNeighbor.SendBuffer  = Kokkos::subview(SendStage, Range);
+         LocNeighbor.SendBufferH = Kokkos::subview(SendStageH, Range);
+         SendStart += LocNeighbor.SendSize;
+      }
+      if (LocNeighbor.RecvMsg) {
+         I4 End     = RecvStart + LocNeighbor.RecvSize;
+         auto Range = Kokkos::make_pair(RecvStart, End);
+         LocNeighbor.RecvBuffer  = Kokkos::subview(RecvStage, Range);
+         LocNeighbor.RecvBufferH = Kokkos::subview(RecvStageH, Range);
+         RecvStart += LocNeighbor.RecvSize;
+      }
+   }
+
+} // end setStagingBuffers
+
+//------------------------------------------------------------------------------
+// Copy the packed messages for all neighbors from the device staging buffer
+// to the host staging buffer. The copy is queued on the default instance
+// behind the packing kernels, so the host only waits once, for the copy.
+
+void Halo::copySendStage() {
+
+   if (SendStageSize > 0) {
+      Kokkos::DefaultExecutionSpace PackSpace;
+      auto CopyRange = Kokkos::make_pair(0, SendStageSize);
+      Kokkos::deep_copy(PackSpace, Kokkos::subview(SendStageH, CopyRange),
+                        Kokkos::subview(SendStage, CopyRange));
+      PackSpace.fence("Halo::copySendStage");
+   }
+
+} // end copySendStage
+
+//------------------------------------------------------------------------------
+// Copy the received messages for all neighbors from the host staging buffer
+// to the device staging buffer before unpacking
+
+void Halo::copyRecvStage() {
+
+   if (RecvStageSize > 0) {
+      auto CopyRange = Kokkos::make_pair(0, RecvStageSize);
+      Kokkos::deep_copy(CopySpace, Kokkos::subview(RecvStage, CopyRange),
+                        Kokkos::subview(RecvStageH, CopyRange));
+      CopySpace.fence();
+   }
+
+} // end copyRecvStage
+
+//------------------------------------------------------------------------------
+// Copy the received message of a single neighbor from its section of the
+// host staging buffer to the device. The copy is queued on the default
+// instance ahead of the unpacking kernels, so no fence is needed.
+
+void Halo::copyRecvMsg(const I4 INghbr) {
+
+   auto &LocNeighbor = Neighbors[INghbr];
+   if (LocNeighbor.RecvSize > 0)
+      Kokkos::deep_copy(Kokkos::DefaultExecutionSpace(),
+                        LocNeighbor.RecvBuffer, LocNeighbor.RecvBufferH);
+
+} // end copyRecvMsg
+
 //------------------------------------------------------------------------------
 // Allocate the required receive buffer and prepare for MPI communication by
 // calling MPI_Irecv for each Neighbor
@@ -666,10 +1373,10 @@ int Halo::startReceives(const bool UseDevBuffer) {
    I4 Err{0}; // Error code to return
 
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      if (RecvFlags[CurElem][INghbr]) {
-         auto &LocNeighbor = Neighbors[INghbr];
+      auto &LocNeighbor = Neighbors[INghbr];
+      if (LocNeighbor.RecvMsg) {
 
-         I4 BufferSize = TotSize * LocNeighbor.RecvLists[CurElem].NTot;
+         I4 BufferSize = LocNeighbor.RecvSize;
 
          void *DataPtr{nullptr};
 
@@ -708,37 +1415,30 @@ int Halo::startSends(const bool UseDevBuffer) {
 
    I4 Err{0}; // Error code to return
 
-   if (UseDevBuffer)
-      Kokkos::fence();
+   // Make sure packing is complete before MPI reads the buffers. If MPI can
+   // not access device memory, all packed device buffers are copied to the
+   // host with one copy.
+   if (UseDevBuffer) {
+      if (ExchOnDev) {
+         Kokkos::DefaultExecutionSpace().fence();
+      } else {
+         copySendStage();
+      }
+   }
 
    for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-      if (SendFlags[CurElem][INghbr]) {
-         auto &LocNeighbor = Neighbors[INghbr];
+      auto &LocNeighbor = Neighbors[INghbr];
+      if (LocNeighbor.SendMsg) {
 
          void *DataPtr{nullptr};
 
-         I4 BufferSize = TotSize * LocNeighbor.SendLists[CurElem].NTot;
-
-         // If UseDevBuffer is true the device buffer was packed by packBuffer,
-         // otherwise the host buffer was
-         if (UseDevBuffer) {
-            // If ExchOnDev is true, the device buffer can be passed to
-            // MPI_Isend, otherwise the device buffer needs to be copied
-            // to the host buffer, which will be passed to MPI_Isend
-            if (ExchOnDev) {
-               DataPtr = LocNeighbor.SendBuffer.data();
-            } else {
-               expandBuffer(LocNeighbor.SendBufferH, BufferSize);
+         I4 BufferSize = LocNeighbor.SendSize;
 
-               // The number of elements we need to copy is different
-               // than the buffer allocation size
-               auto CopyRange = Kokkos::make_pair(0, BufferSize);
-
-               deepCopy(Kokkos::subview(LocNeighbor.SendBufferH, CopyRange),
-                        Kokkos::subview(LocNeighbor.SendBuffer, CopyRange));
-
-               DataPtr = LocNeighbor.SendBufferH.data();
-            }
+         // If both flags are true, the packed device buffer is passed to
+         // MPI_Isend, otherwise the host buffer is. The host buffer was
+         // either packed directly or filled from the staging copy above.
+         if (UseDevBuffer && ExchOnDev) {
+            DataPtr = LocNeighbor.SendBuffer.data();
          } else {
             DataPtr = LocNeighbor.SendBufferH.data();
          }
@@ -18,7 +18,9 @@
 /// exchange The halo exchanges are carried out via non-blocking MPI library
 /// routines. The Halo class public member function exchangeFullArrayHalo
 /// which is called by the user to perform halo exchanges is a template
-/// function and thus is fully defined in this header.
+/// function and thus is fully defined in this header. Several arrays can be
+/// exchanged at once with a single message per neighbor by collecting them
+/// in a HaloArrayList and calling exchangeArrayHalos.
 ///
 //
 //===----------------------------------------------------------------------===//
@@ -28,10 +30,14 @@
 #include "Logging.h"
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
+#include "ScratchPool.h"
 #include "mpi.h"
 #include <cstring>
+#include <functional>
+#include <map>
 #include <memory>
 #include <numeric>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -48,14 +54,85 @@ static const MPI_Datatype MPI_RealKind = MPI_DOUBLE;
 /// The MeshElement enum identifies the index space to use for a halo exchange.
 enum MeshElement { OnCell, OnEdge, OnVertex };
 
-// Conditionally resize MPI buffer if it is not large enough
+// Conditionally resize MPI buffer if it is not large enough. The old buffer
+// is dropped first so that the new allocation from the scratch pool can
+// free it, unless another neighbor or exchange still uses it.
 template <class BufferType>
 void expandBuffer(BufferType &Buffer, int BufferSize) {
    if (Buffer.extent_int(0) < BufferSize) {
-      Buffer = BufferType(Buffer.label(), BufferSize);
+      const std::string Label = Buffer.label();
+      Buffer                  = BufferType();
+      Buffer = ScratchPool::get<BufferType>(Label, BufferSize);
    }
 }
 
+class Halo;
+
+/// The HaloArrayList class collects a set of arrays to be exchanged together
+/// by a single call to Halo::exchangeArrayHalos. The arrays may be of any
+/// supported type and rank and may be defined on different index spaces.
+/// All arrays in a list are packed into one buffer per neighboring task so
+/// that only one message is sent to each neighbor per exchange. Because
+/// Kokkos arrays are reference counted, the list shares the data of each
+/// added array rather than copying it.
+class HaloArrayList {
+ private:
+   /// Information needed to pack and unpack one array in the list
+   struct Entry {
+      MeshElement Elem; ///< index space the array is defined on
+      I4 TotSize;       ///< array size at each mesh element
+      bool OnDev;       ///< whether packs and unpacks use device buffers
+      std::function<void(Halo &, const I4)> Pack;   ///< pack for a neighbor
+      std::function<void(Halo &, const I4)> Unpack; ///< unpack for a neighbor
+   };
+
+   std::vector<Entry> Entries; ///< arrays in the order they were added
+
+ public:
+   /// Add an array defined on the index space ThisElem to the list. Defined
+   /// after the Halo class below since it calls Halo pack/unpack methods.
+   template <typename T>
+   void add(const T &Array,      ///< [in] Kokkos array of any type
+            MeshElement ThisElem ///< [in] index space Array is defined on
+   );
+
+   /// Remove all arrays from the list
+   void clear() { Entries.clear(); }
+
+   /// Number of arrays in the list
+   I4 size() const { return Entries.size(); }
+
+   friend class Halo;
+}; // end class HaloArrayList
+
+/// The HaloExchangeHandle class tracks a split-phase halo exchange that has
+/// been started with Halo::startExchange and must be completed with
+/// Halo::finishExchange. Between these two calls, the messages are in flight
+/// and the caller can perform computation that does not depend on halo
+/// values, for example over the interior cells and edges listed in Decomp.
+/// The handle holds a copy of the list of arrays being exchanged, the MPI
+/// requests for the messages and the state of the exchange.
+class HaloExchangeHandle {
+ private:
+   /// Arrays being exchanged
+   std::shared_ptr<const HaloArrayList> List;
+
+   std::string RegName;               ///< name of registered exchange if any
+   bool Active{false};                ///< true until exchange is finished
+   bool UseDevBuffer{false};          ///< whether device buffers are used
+   I4 Err{0};                         ///< error code from start of exchange
+   I4 NRcvd{0};                       ///< number of messages unpacked
+   std::vector<MPI_Request> RecvReqs; ///< receive requests for neighbors
+   std::vector<MPI_Request> SendReqs; ///< send requests for neighbors
+   std::vector<I4> RecvNghbr;         ///< neighbor index for each RecvReq
+
+ public:
+   /// Returns true if the exchange has been started but not yet finished
+   bool isActive() const { return Active; }
+
+   friend class Halo;
+}; // end class HaloExchangeHandle
+
 /// The Halo class contains two nested classes, ExchList and Neighbor classes,
 /// defined below. The Halo class holds all the Neighbor objects needed by a
 /// task to perform a full halo exchange with each of its neighboring tasks for
@@ -65,13 +142,15 @@ void expandBuffer(BufferType &Buffer, int BufferSize) {
 /// for easy accessibility by the Halo methods.
 class Halo {
  private:
+   /// Value of ExchOnDev for newly created Halos. The default is determined
+   /// by the pre-processing parameter OMEGA_MPI_ON_DEVICE and can be
+   /// overridden with the MPIOnDevice option in the Halo Config group.
+   static bool MPIOnDevice;
+
    /// Flag to allow passing device arrays to MPI_Irecv and MPI_Isend in
-   /// startReceives and startSends, determined by pre-processing parameter
-#ifdef OMEGA_MPI_ON_DEVICE
-   const bool ExchOnDev = true;
-#else
-   const bool ExchOnDev = false;
-#endif
+   /// startReceives and startSends. If false, device buffers are staged
+   /// through host memory with one batched copy in each direction.
+   bool ExchOnDev;
 
    /// The default Halo handles halo exchanges for arrays defined on the mesh
    /// with the default decomposition. A pointer is stored here for easy
@@ -92,9 +171,53 @@ class Halo {
    MPI_Comm MyComm;     /// MPI communicator handle
    MeshElement CurElem; /// index space of current array
 
+   /// Flag set while a split-phase exchange is in progress. The neighbor
+   /// buffers are shared by all exchanges, so only one exchange per Halo
+   /// can be in flight at a time.
+   bool ExchangeActive{false};
+
+   /// Contiguous buffers holding the messages for all neighbors when device
+   /// buffers are exchanged through host memory. The Neighbor buffers are
+   /// subviews of these, so all messages are moved between memory spaces
+   /// with a single copy rather than one copy per neighbor.
+   Array1DR8 SendStage, RecvStage;
+   HostArray1DR8 SendStageH, RecvStageH;
+   I4 SendStageSize{0}, RecvStageSize{0};
+
+   /// Execution space instance used for the staged receive copy, so it does
+   /// not serialize with kernels launched on the default instance
+   Kokkos::DefaultExecutionSpace CopySpace;
+
    /// Forward Declaration of Neighbor class, defined below
    class Neighbor;
 
+   /// The RegisteredExchange struct holds everything needed to repeat an
+   /// exchange of a fixed list of arrays without per-exchange setup. The
+   /// send and receive buffers are allocated once at the exact size needed
+   /// for each neighbor and persistent MPI requests are bound to them, so
+   /// each exchange only packs, calls MPI_Startall and unpacks. The buffers
+   /// are indexed by neighbor in the same order as the Neighbors vector and
+   /// are swapped with the Neighbor buffers while an exchange is active.
+   struct RegisteredExchange {
+      /// Arrays in the registered exchange
+      std::shared_ptr<const HaloArrayList> List;
+
+      bool UseDevBuffer{false};               ///< whether device buffers used
+      std::vector<Array1DR8> SendBuffer;      ///< device send buffers
+      std::vector<Array1DR8> RecvBuffer;      ///< device receive buffers
+      std::vector<HostArray1DR8> SendBufferH; ///< host send buffers
+      std::vector<HostArray1DR8> RecvBufferH; ///< host receive buffers
+      std::vector<MPI_Request> SendReqs;      ///< persistent send requests
+      std::vector<MPI_Request> RecvReqs;      ///< persistent receive requests
+      std::vector<I4> RecvNghbr;              ///< neighbor index of RecvReqs
+      Array1DR8 SendStage, RecvStage;         ///< device staging buffers
+      HostArray1DR8 SendStageH, RecvStageH;   ///< host staging buffers
+      I4 SendStageSize{0}, RecvStageSize{0};  ///< staged message sizes
+   };
+
+   /// Registered exchanges, stored by name
+   std::map<std::string, RegisteredExchange> RegExchanges;
+
    /// Vector of Neighbor class objects for all neighboring tasks, contains
    /// all the exchange lists and buffer memory sufficient for a full halo
    /// exchange in any index space.
@@ -163,11 +286,18 @@ class Halo {
       /// MPI request handles for non-blocking MPI communication
       MPI_Request RReq, SReq;
 
-      // Flags to track whether a message has been received and whether
-      // the buffer has been unpacked yet. The MPI_Test routine requires an
-      // integer, so Received is stored as an I4.
-      I4 Received{false};
-      bool Unpacked{false};
+      /// Total number of buffer elements to send to and receive from this
+      /// neighbor in the current exchange, summed over all exchanged arrays
+      I4 SendSize{0}, RecvSize{0};
+
+      /// Flags set if a message is sent to or received from this neighbor in
+      /// the current exchange
+      bool SendMsg{false}, RecvMsg{false};
+
+      /// Offsets into the send and receive buffers of the first element of
+      /// the array currently being packed or unpacked. These are zero unless
+      /// several arrays share one buffer in an aggregated exchange.
+      I4 SendOffset{0}, RecvOffset{0};
 
       /// Neighbor constructor takes takes as input six unique vectors of
       /// vectors containing the indices of array elements to send or receive
@@ -228,6 +358,41 @@ class Halo {
                          std::vector<std::vector<std::vector<I4>>> &RecvLists,
                          const MeshElement IndexSpace);
 
+   /// Determine, for each Neighbor, the total send and receive buffer sizes
+   /// and whether any message is exchanged for all the arrays in the list.
+   /// Utilized at the start of each exchange.
+   int setExchangeSizes(const HaloArrayList &List);
+
+   /// Pack every array in the list into the send buffer of each Neighbor,
+   /// one after the other in the order they were added to the list
+   int packArrayList(const HaloArrayList &List);
+
+   /// Unpack every array in the list from the receive buffer of Neighbor
+   /// INghbr, using the same ordering as packArrayList
+   int unpackArrayList(const HaloArrayList &List, const I4 INghbr);
+
+   /// Swap the buffers of a registered exchange with the Neighbor buffers so
+   /// that the pack and unpack methods operate on the registered buffers.
+   /// Called at the start and again at the end of a registered exchange.
+   void swapRegisteredBuffers(RegisteredExchange &Reg);
+
+   /// Size the contiguous staging buffers for the current exchange and point
+   /// the Neighbor buffers at consecutive sections of them. Used when device
+   /// buffers are exchanged through host memory.
+   void setStagingBuffers();
+
+   /// Copy all packed send messages from device to host with one copy
+   /// queued behind the packing kernels on the default instance
+   void copySendStage();
+
+   /// Copy all received messages from host to device with one copy on
+   /// CopySpace before they are unpacked
+   void copyRecvStage();
+
+   /// Copy the received message of Neighbor INghbr from host to device
+   /// ahead of its unpacking kernels on the default instance
+   void copyRecvMsg(const I4 INghbr);
+
    /// Allocate the recieve buffers and call MPI_Irecv for each Neighbor.
    /// The input bool UseDevBuffer specifies whether or not the device buffer
    /// will be used in the unpackBuffer functionfor unpacking into the array.
@@ -238,11 +403,28 @@ class Halo {
    /// the device buffer was packed in the packBuffer function.
    int startSends(bool UseDevBuffer);
 
+   /// Function template that returns the number of array elements at each
+   /// cell, edge, or vertex in the input array, which is the product of all
+   /// array extents other than the mesh index
+   template <typename T> static I4 getTotSize(const T &Array) {
+      I4 NDims = Array.rank();
+      I4 Size  = 1;
+      if (NDims == 2) {
+         Size = Array.extent(1);
+      } else if (NDims > 2) {
+         for (int I = 0; I < NDims - 2; ++I) {
+            Size *= Array.extent(I);
+         }
+         Size *= Array.extent(NDims - 1);
+      }
+      return Size;
+   }
+
    /// Function template that returns a bool that is true if the Array is
    /// on the device, or if the device and host memory spaces are the same
    /// space. Used to determine if buffer packs and unpacks are done within
    /// Kokkos parallelFor kernels.
-   template <typename T> bool devBufferPUP(const T &Array) {
+   template <typename T> static bool devBufferPUP(const T &Array) {
       bool OnDev = findArrayMemLoc<T>() == ArrayMemLoc::Both ||
                    findArrayMemLoc<T>() == ArrayMemLoc::Device;
       return OnDev;
@@ -255,12 +437,20 @@ class Halo {
    Halo(const Halo &) = delete;
    Halo(Halo &&)      = delete;
 
+   /// HaloArrayList is a friend class to access the array size and memory
+   /// location utilities when arrays are added to a list
+   friend class HaloArrayList;
+
  public:
    // Methods
 
-   /// initialize default Halo
+   /// initialize default Halo, reading the optional Halo Config group
    static int init();
 
+   /// Set whether device buffers are passed directly to MPI in Halos
+   /// created after this call. Overrides the build default and Config.
+   static void setMPIOnDevice(bool OnDevice) { MPIOnDevice = OnDevice; }
+
    /// Creates a new halo by calling the constructor and puts it in the AllHalos
    /// map
    static Halo *create(const std::string &Name, const MachEnv *Env,
@@ -282,6 +472,15 @@ class Halo {
    /// Retrieves a pointer to a Halo object by Name
    static Halo *get(std::string Name);
 
+   /// Retrieves the task ID of each neighbor and the number of mesh elements
+   /// sent to and received from it in a full exchange of an index space,
+   /// summed over all halo layers
+   void getNeighborSizes(MeshElement Elem, ///< [in] index space
+                         std::vector<I4> &TaskIDs, ///< [out] neighbor tasks
+                         std::vector<I4> &NSend,   ///< [out] elements sent
+                         std::vector<I4> &NRecv    ///< [out] elements received
+   ) const;
+
    /// Buffer pack specialized function templates for supported Kokkos array
    /// ranks. Select out the proper elements from the input Array to send to a
    /// neighboring task and pack them into the proper send buffer for
@@ -295,29 +494,30 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].SendLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.SendOffset;
 
       const I4 BufferSize = LocList.NTot;
 
       if (devBufferPUP(Array)) {
          OMEGA_SCOPE(LocIndex, LocList.Index);
-         expandBuffer(LocNeighbor.SendBuffer, BufferSize);
+         expandBuffer(LocNeighbor.SendBuffer, Offset + BufferSize);
          OMEGA_SCOPE(LocBuff, Neighbors[CurNeighbor].SendBuffer);
          parallelFor(
              {LocList.NTot}, KOKKOS_LAMBDA(int IExch) {
                 const ValType Val = Array(LocIndex(IExch));
                 R8 RVal;
                 memcpy(&RVal, &Val, sizeof(ValType));
-                LocBuff(IExch) = RVal;
+                LocBuff(Offset + IExch) = RVal;
              });
       } else {
          OMEGA_SCOPE(LocIndexH, LocList.IndexH);
-         expandBuffer(LocNeighbor.SendBufferH, BufferSize);
+         expandBuffer(LocNeighbor.SendBufferH, Offset + BufferSize);
          OMEGA_SCOPE(LocBuffH, Neighbors[CurNeighbor].SendBufferH);
          for (int IExch = 0; IExch < LocList.NTot; ++IExch) {
             const ValType Val = Array(LocIndexH(IExch));
             R8 RVal;
             memcpy(&RVal, &Val, sizeof(ValType));
-            LocBuffH(IExch) = RVal;
+            LocBuffH(Offset + IExch) = RVal;
          }
       }
    }
@@ -332,6 +532,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].SendLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.SendOffset;
 
       const I4 NJ = Array.extent(1);
 
@@ -339,7 +540,7 @@ class Halo {
 
       if (devBufferPUP(Array)) {
          OMEGA_SCOPE(LocIndex, LocList.Index);
-         expandBuffer(LocNeighbor.SendBuffer, BufferSize);
+         expandBuffer(LocNeighbor.SendBuffer, Offset + BufferSize);
          OMEGA_SCOPE(LocBuff, Neighbors[CurNeighbor].SendBuffer);
 
          parallelFor(
@@ -348,11 +549,11 @@ class Halo {
                 R8 RVal;
                 memcpy(&RVal, &Val, sizeof(ValType));
                 const I4 IBuff = IExch * NJ + J;
-                LocBuff(IBuff) = RVal;
+                LocBuff(Offset + IBuff) = RVal;
              });
       } else {
          OMEGA_SCOPE(LocIndexH, LocList.IndexH);
-         expandBuffer(LocNeighbor.SendBufferH, BufferSize);
+         expandBuffer(LocNeighbor.SendBufferH, Offset + BufferSize);
          OMEGA_SCOPE(LocBuffH, Neighbors[CurNeighbor].SendBufferH);
          for (int IExch = 0; IExch < LocList.NTot; ++IExch) {
             for (int J = 0; J < NJ; ++J) {
@@ -360,7 +561,7 @@ class Halo {
                const ValType Val = Array(LocIndexH(IExch), J);
                R8 RVal;
                memcpy(&RVal, &Val, sizeof(ValType));
-               LocBuffH(IBuff) = RVal;
+               LocBuffH(Offset + IBuff) = RVal;
             }
          }
       }
@@ -376,6 +577,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].SendLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.SendOffset;
 
       const I4 NJ = Array.extent(2);
       const I4 NK = Array.extent(0);
@@ -385,7 +587,7 @@ class Halo {
 
       if (devBufferPUP(Array)) {
          OMEGA_SCOPE(LocIndex, LocList.Index);
-         expandBuffer(LocNeighbor.SendBuffer, BufferSize);
+         expandBuffer(LocNeighbor.SendBuffer, Offset + BufferSize);
          OMEGA_SCOPE(LocBuff, Neighbors[CurNeighbor].SendBuffer);
 
          parallelFor(
@@ -394,11 +596,11 @@ class Halo {
                 R8 RVal;
                 memcpy(&RVal, &Val, sizeof(ValType));
                 const I4 IBuff = (K * NTotList + IExch) * NJ + J;
-                LocBuff(IBuff) = RVal;
+                LocBuff(Offset + IBuff) = RVal;
              });
       } else {
          OMEGA_SCOPE(LocIndexH, LocList.IndexH);
-         expandBuffer(LocNeighbor.SendBufferH, BufferSize);
+         expandBuffer(LocNeighbor.SendBufferH, Offset + BufferSize);
          OMEGA_SCOPE(LocBuffH, Neighbors[CurNeighbor].SendBufferH);
          for (int K = 0; K < NK; ++K) {
             for (int IExch = 0; IExch < LocList.NTot; ++IExch) {
@@ -407,7 +609,7 @@ class Halo {
                   const ValType Val = Array(K, LocIndexH(IExch), J);
                   R8 RVal;
                   memcpy(&RVal, &Val, sizeof(ValType));
-                  LocBuffH(IBuff) = RVal;
+                  LocBuffH(Offset + IBuff) = RVal;
                }
             }
          }
@@ -424,6 +626,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].SendLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.SendOffset;
 
       const I4 NJ = Array.extent(3);
       const I4 NK = Array.extent(1);
@@ -434,7 +637,7 @@ class Halo {
 
       if (devBufferPUP(Array)) {
          OMEGA_SCOPE(LocIndex, LocList.Index);
-         expandBuffer(LocNeighbor.SendBuffer, BufferSize);
+         expandBuffer(LocNeighbor.SendBuffer, Offset + BufferSize);
          OMEGA_SCOPE(LocBuff, Neighbors[CurNeighbor].SendBuffer);
 
          parallelFor(
@@ -444,11 +647,11 @@ class Halo {
                 R8 RVal;
                 memcpy(&RVal, &Val, sizeof(ValType));
                 const I4 IBuff = ((L * NK + K) * NTotList + IExch) * NJ + J;
-                LocBuff(IBuff) = RVal;
+                LocBuff(Offset + IBuff) = RVal;
              });
       } else {
          OMEGA_SCOPE(LocIndexH, LocList.IndexH);
-         expandBuffer(LocNeighbor.SendBufferH, BufferSize);
+         expandBuffer(LocNeighbor.SendBufferH, Offset + BufferSize);
          OMEGA_SCOPE(LocBuffH, Neighbors[CurNeighbor].SendBufferH);
          for (int L = 0; L < NL; ++L) {
             for (int K = 0; K < NK; ++K) {
@@ -459,7 +662,7 @@ class Halo {
                      const ValType Val = Array(L, K, LocIndexH(IExch), J);
                      R8 RVal;
                      memcpy(&RVal, &Val, sizeof(ValType));
-                     LocBuffH(IBuff) = RVal;
+                     LocBuffH(Offset + IBuff) = RVal;
                   }
                }
             }
@@ -477,6 +680,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].SendLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.SendOffset;
 
       const I4 NJ = Array.extent(4);
       const I4 NK = Array.extent(2);
@@ -488,7 +692,7 @@ class Halo {
 
       if (devBufferPUP(Array)) {
          OMEGA_SCOPE(LocIndex, LocList.Index);
-         expandBuffer(LocNeighbor.SendBuffer, BufferSize);
+         expandBuffer(LocNeighbor.SendBuffer, Offset + BufferSize);
          OMEGA_SCOPE(LocBuff, Neighbors[CurNeighbor].SendBuffer);
 
          parallelFor(
@@ -499,11 +703,11 @@ class Halo {
                 memcpy(&RVal, &Val, sizeof(ValType));
                 const I4 IBuff =
                     (((M * NL + L) * NK + K) * NTotList + IExch) * NJ + J;
-                LocBuff(IBuff) = RVal;
+                LocBuff(Offset + IBuff) = RVal;
              });
       } else {
          OMEGA_SCOPE(LocIndexH, LocList.IndexH);
-         expandBuffer(LocNeighbor.SendBufferH, BufferSize);
+         expandBuffer(LocNeighbor.SendBufferH, Offset + BufferSize);
          OMEGA_SCOPE(LocBuffH, Neighbors[CurNeighbor].SendBufferH);
          for (int M = 0; M < NM; ++M) {
             for (int L = 0; L < NL; ++L) {
@@ -516,7 +720,7 @@ class Halo {
                         const ValType Val = Array(M, L, K, LocIndexH(IExch), J);
                         R8 RVal;
                         memcpy(&RVal, &Val, sizeof(ValType));
-                        LocBuffH(IBuff) = RVal;
+                        LocBuffH(Offset + IBuff) = RVal;
                      }
                   }
                }
@@ -539,6 +743,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].RecvLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.RecvOffset;
 
       if (devBufferPUP(Array)) {
          OMEGA_SCOPE(LocIndex, LocList.Index);
@@ -546,7 +751,7 @@ class Halo {
          parallelFor(
              {LocList.NTot}, KOKKOS_LAMBDA(int IExch) {
                 const I4 IArr = LocIndex(IExch);
-                const R8 RVal = LocBuff(IExch);
+                const R8 RVal = LocBuff(Offset + IExch);
                 ValType Val;
                 memcpy(&Val, &RVal, sizeof(ValType));
                 Array(IArr) = Val;
@@ -556,7 +761,7 @@ class Halo {
          OMEGA_SCOPE(LocBuffH, Neighbors[CurNeighbor].RecvBufferH);
          for (int IExch = 0; IExch < LocList.NTot; ++IExch) {
             const I4 IArr = LocIndexH(IExch);
-            const R8 RVal = LocBuffH(IExch);
+            const R8 RVal = LocBuffH(Offset + IExch);
             ValType Val;
             memcpy(&Val, &RVal, sizeof(ValType));
             Array(IArr) = Val;
@@ -574,6 +779,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].RecvLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.RecvOffset;
 
       const I4 NJ = Array.extent(1);
 
@@ -585,7 +791,7 @@ class Halo {
              {LocList.NTot, NJ}, KOKKOS_LAMBDA(int IExch, int J) {
                 const I4 IBuff = IExch * NJ + J;
                 const I4 IArr  = LocIndex(IExch);
-                const R8 RVal  = LocBuff(IBuff);
+                const R8 RVal  = LocBuff(Offset + IBuff);
                 ValType Val;
                 memcpy(&Val, &RVal, sizeof(ValType));
                 Array(IArr, J) = Val;
@@ -597,7 +803,7 @@ class Halo {
             for (int J = 0; J < NJ; ++J) {
                const I4 IBuff = IExch * NJ + J;
                const I4 IArr  = LocIndexH(IExch);
-               const R8 RVal  = LocBuffH(IBuff);
+               const R8 RVal  = LocBuffH(Offset + IBuff);
                ValType Val;
                memcpy(&Val, &RVal, sizeof(ValType));
                Array(IArr, J) = Val;
@@ -616,6 +822,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].RecvLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.RecvOffset;
 
       const I4 NJ = Array.extent(2);
       const I4 NK = Array.extent(0);
@@ -630,7 +837,7 @@ class Halo {
              {NK, NTotList, NJ}, KOKKOS_LAMBDA(int K, int IExch, int J) {
                 const I4 IBuff = (K * NTotList + IExch) * NJ + J;
                 const I4 IArr  = LocIndex(IExch);
-                const R8 RVal  = LocBuff(IBuff);
+                const R8 RVal  = LocBuff(Offset + IBuff);
                 ValType Val;
                 memcpy(&Val, &RVal, sizeof(ValType));
                 Array(K, IArr, J) = Val;
@@ -643,7 +850,7 @@ class Halo {
                for (int J = 0; J < NJ; ++J) {
                   const I4 IBuff = (K * LocList.NTot + IExch) * NJ + J;
                   const I4 IArr  = LocIndexH(IExch);
-                  const R8 RVal  = LocBuffH(IBuff);
+                  const R8 RVal  = LocBuffH(Offset + IBuff);
                   ValType Val;
                   memcpy(&Val, &RVal, sizeof(ValType));
                   Array(K, IArr, J) = Val;
@@ -663,6 +870,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].RecvLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.RecvOffset;
 
       const I4 NJ = Array.extent(3);
       const I4 NK = Array.extent(1);
@@ -679,7 +887,7 @@ class Halo {
              KOKKOS_LAMBDA(int L, int K, int IExch, int J) {
                 const I4 IBuff = ((L * NK + K) * NTotList + IExch) * NJ + J;
                 const I4 IArr  = LocIndex(IExch);
-                const R8 RVal  = LocBuff(IBuff);
+                const R8 RVal  = LocBuff(Offset + IBuff);
                 ValType Val;
                 memcpy(&Val, &RVal, sizeof(ValType));
                 Array(L, K, IArr, J) = Val;
@@ -694,7 +902,7 @@ class Halo {
                      const I4 IBuff =
                          ((L * NK + K) * NTotList + IExch) * NJ + J;
                      const I4 IArr = LocIndexH(IExch);
-                     const R8 RVal = LocBuffH(IBuff);
+                     const R8 RVal = LocBuffH(Offset + IBuff);
                      ValType Val;
                      memcpy(&Val, &RVal, sizeof(ValType));
                      Array(L, K, IArr, J) = Val;
@@ -715,6 +923,7 @@ class Halo {
 
       OMEGA_SCOPE(LocList, Neighbors[CurNeighbor].RecvLists[CurElem]);
       OMEGA_SCOPE(LocNeighbor, Neighbors[CurNeighbor]);
+      const I4 Offset = LocNeighbor.RecvOffset;
 
       const I4 NJ = Array.extent(4);
       const I4 NK = Array.extent(2);
@@ -733,7 +942,7 @@ class Halo {
                 const I4 IBuff =
                     (((M * NL + L) * NK + K) * NTotList + IExch) * NJ + J;
                 const I4 IArr = LocIndex(IExch);
-                const R8 RVal = LocBuff(IBuff);
+                const R8 RVal = LocBuff(Offset + IBuff);
                 ValType Val;
                 memcpy(&Val, &RVal, sizeof(ValType));
                 Array(M, L, K, IArr, J) = Val;
@@ -750,7 +959,7 @@ class Halo {
                             (((M * NL + L) * NK + K) * NTotList + IExch) * NJ +
                             J;
                         const I4 IArr = LocIndexH(IExch);
-                        const R8 RVal = LocBuffH(IBuff);
+                        const R8 RVal = LocBuffH(Offset + IBuff);
                         ValType Val;
                         memcpy(&Val, &RVal, sizeof(ValType));
                         Array(M, L, K, IArr, J) = Val;
@@ -762,6 +971,51 @@ class Halo {
       }
    }
 
+   //---------------------------------------------------------------------------
+   /// Start a split-phase halo exchange of all the arrays in the input list.
+   /// The receives are posted and the packed buffers are sent, then control
+   /// returns to the caller without waiting for messages to arrive. The
+   /// halo elements of the arrays must not be read, and the owned elements
+   /// must not be modified, until finishExchange is called on the returned
+   /// handle. Any error is stored in the handle and returned by
+   /// finishExchange.
+   HaloExchangeHandle startExchange(const HaloArrayList &List);
+
+   /// Unpack any messages of an active split-phase exchange that have
+   /// already arrived without waiting for the remaining messages. This can
+   /// be called periodically during overlapped computation to progress the
+   /// exchange. Returns true if all messages have been received.
+   bool testExchange(HaloExchangeHandle &Handle);
+
+   /// Complete a split-phase exchange, waiting for and unpacking all
+   /// remaining messages and waiting for all sends to complete. On return,
+   /// the halo elements of all arrays in the exchange are up to date.
+   int finishExchange(HaloExchangeHandle &Handle);
+
+   /// Register a list of arrays that is exchanged repeatedly under the input
+   /// Name. Fixed-size buffers and persistent MPI requests are created for
+   /// the list so that later exchanges avoid any allocation or request
+   /// setup. The arrays in the list must keep the same size and must not be
+   /// reallocated while the exchange is registered. Returns an error if an
+   /// exchange on this Halo is in progress.
+   int registerExchange(const std::string &Name, const HaloArrayList &List);
+
+   /// Remove a registered exchange and free its buffers and MPI requests
+   void unregisterExchange(const std::string &Name);
+
+   /// Start a split-phase exchange of a registered list of arrays. The
+   /// returned handle is completed with finishExchange as for startExchange.
+   HaloExchangeHandle startRegisteredExchange(const std::string &Name);
+
+   /// Perform a full halo exchange of a registered list of arrays
+   int exchangeRegistered(const std::string &Name);
+
+   /// Perform a full halo exchange on all the arrays in the input list. Each
+   /// array is packed in turn into a single buffer per neighboring task so
+   /// that one message per neighbor is needed regardless of the number of
+   /// arrays. All arrays in the list must be in the same memory space.
+   int exchangeArrayHalos(const HaloArrayList &List);
+
    //---------------------------------------------------------------------------
    // Function template to perform a full halo exchange on the input Kokkos
    // array of any supported type defined on the input index space ThisElem
@@ -771,138 +1025,39 @@ class Halo {
                          MeshElement ThisElem // index space Array is defined on
    ) {
 
-      I4 IErr{0}; // error code
-
-      // Logical flag to track if all messages have been received
-      bool AllReceived{false};
-
-      // Save the index space the input array is defined on
-      CurElem = ThisElem;
-
-      // For cell-based quantities, the number of halo layers equals HaloWidth,
-      // edge- and vertex-based quantities have an extra layer.
-      if (CurElem == OnCell) {
-         NumLayers = HaloWidth;
-      } else {
-         NumLayers = HaloWidth + 1;
-      }
-
-      // Determine the number of array elements per cell, edge, or vertex
-      // in the input array
-      I4 NDims = Array.rank();
-      if (NDims == 1) {
-         TotSize = 1;
-      } else if (NDims == 2) {
-         TotSize = Array.extent(1);
-      } else {
-         TotSize = 1;
-         for (int I = 0; I < NDims - 2; ++I) {
-            TotSize *= Array.extent(I);
-         }
-         TotSize *= Array.extent(NDims - 1);
-      }
-
-      // If the Array is in device memory space, the buffer pack and unpack
-      // functions will use device buffers
-      bool UseDevBuffer = devBufferPUP(Array);
-
-      // Allocate the receive buffers and Call MPI_Irecv for each Neighbor
-      // so the local task is ready to accept messages from each
-      // neighboring task
-      startReceives(UseDevBuffer);
-
-      // Loop through each Neighbor, resetting communication flags and packing
-      // buffers if there are elements to be sent to the neighboring task
-      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-         Neighbors[INghbr].Received = false;
-         Neighbors[INghbr].Unpacked = false;
-         if (SendFlags[CurElem][INghbr]) {
-            packBuffer(Array, INghbr);
-         }
-      }
-
-      // Call MPI_Isend for each Neighbor to send the packed buffers
-      startSends(UseDevBuffer);
+      HaloArrayList List;
+      List.add(Array, ThisElem);
 
-      // Collect all send requests
-      std::vector<MPI_Request> SendReqs;
-      for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-         if (SendFlags[CurElem][INghbr]) {
-            SendReqs.push_back(Neighbors[INghbr].SReq);
-         }
-      }
+      return exchangeArrayHalos(List);
 
-      I4 MaxIter = 1000000000; // Large integer to prevent infinite loop
-      I4 IPass   = 0;          // Number of passes through while loop
-      I4 NRcvd   = 0;          // Integer to track number of messages received
-
-      // Total number of messages the local task will receive
-      I4 NMessages = std::accumulate(RecvFlags[CurElem].begin(),
-                                     RecvFlags[CurElem].end(), 0);
-
-      // Until all messages from neighboring tasks are received, loop
-      // through Neighbor objects and use MPI_Test to check if the message
-      // has been received. Unpack buffers upon receipt of each message
-      while (!AllReceived) {
-         for (int INghbr = 0; INghbr < NNghbr; ++INghbr) {
-            if (RecvFlags[CurElem][INghbr]) {
-               if (!Neighbors[INghbr].Received) {
-                  MPI_Test(&Neighbors[INghbr].RReq, &Neighbors[INghbr].Received,
-                           MPI_STATUS_IGNORE);
-                  if (Neighbors[INghbr].Received) {
-                     ++NRcvd;
-                  }
-               }
-               if (Neighbors[INghbr].Received && !Neighbors[INghbr].Unpacked) {
-                  // If the device buffer will be used in unpackBuffer, but the
-                  // exchange was done with the host buffer, a deep copy from
-                  // host to device is needed.
-                  if (UseDevBuffer && !ExchOnDev) {
-                     expandBuffer(Neighbors[INghbr].RecvBuffer,
-                                  Neighbors[INghbr].RecvBufferH.size());
-
-                     // The number of elements we need to copy is different
-                     // than the buffer allocation size
-                     const I4 BufferSize =
-                         TotSize * Neighbors[INghbr].RecvLists[CurElem].NTot;
-                     auto CopyRange = Kokkos::make_pair(0, BufferSize);
-
-                     deepCopy(Kokkos::subview(Neighbors[INghbr].RecvBuffer,
-                                              CopyRange),
-                              Kokkos::subview(Neighbors[INghbr].RecvBufferH,
-                                              CopyRange));
-                  }
-                  unpackBuffer(Array, INghbr);
-                  Neighbors[INghbr].Unpacked = true;
-               }
-            }
-         }
-
-         if (NRcvd == NMessages) {
-            AllReceived = true;
-         }
-         ++IPass;
-         if (IPass == MaxIter) {
-            LOG_ERROR("Halo: Maximum iterations reached during halo exchange");
-            IErr = -1;
-            break;
-         }
-      }
-
-      // We need to fence here because we are reusing buffers and GPU work is
-      // async
-      if (UseDevBuffer) {
-         Kokkos::fence();
-      }
-
-      // Wait for all sends to complete before proceeding
-      MPI_Waitall(SendReqs.size(), SendReqs.data(), MPI_STATUS_IGNORE);
-
-      return IErr;
    } // end exchangeFullArrayHalo
 
 }; // end class Halo
 
+//------------------------------------------------------------------------------
+// Add an array to a HaloArrayList. The pack and unpack functions capture a
+// copy of the array view so the correct rank-specific Halo methods are called
+// during the exchange.
+template <typename T>
+void HaloArrayList::add(const T &Array,      // Kokkos array of any type
+                        MeshElement ThisElem // index space Array is defined on
+) {
+
+   Entry NewEntry;
+   NewEntry.Elem    = ThisElem;
+   NewEntry.TotSize = Halo::getTotSize(Array);
+   NewEntry.OnDev   = Halo::devBufferPUP(Array);
+   NewEntry.Pack    = [Array](Halo &MyHalo, const I4 INghbr) {
+      MyHalo.packBuffer(Array, INghbr);
+   };
+   NewEntry.Unpack = [Array](Halo &MyHalo, const I4 INghbr) {
+      MyHalo.unpackBuffer(Array, INghbr);
+   };
+
+   Entries.push_back(NewEntry);
+
+} // end HaloArrayList add
+
 } // end namespace OMEGA
 
 //===----------------------------------------------------------------------===//
@@ -32,6 +32,21 @@ int SysID               = 0;
 FileFmt DefaultFileFmt  = FmtDefault;
 Rearranger DefaultRearr = RearrDefault;
 
+// Cache of decompositions that can be reused across arrays with the same
+// layout, stored as (key, (decomp ID, IO system ID)) pairs
+static std::map<std::string, std::pair<int, int>> DecompCache;
+
+// Communicator used to initialize the IO system
+static MPI_Comm IOComm = MPI_COMM_NULL;
+
+// IO systems for writing subfiles, one for each number of subfiles in use
+struct SubfileSystem {
+   int SysID;        // IO system for the subfile group of the local task
+   int SubfileIndex; // subfile written by the local task
+   MPI_Comm Comm;    // communicator for the tasks in the subfile group
+};
+static std::map<int, SubfileSystem> SubfileSystems;
+
 // Utilities
 //------------------------------------------------------------------------------
 // Converts string choice for PIO rearranger to an enum
@@ -191,6 +206,37 @@ IfExists IfExistsFromString(
 
 } // End IfExistsFromString
 
+//------------------------------------------------------------------------------
+// Converts string choice for variable compression to an enum
+Compression CompressionFromString(
+    const std::string &InCompress // [in] choice of compression method
+) {
+   // Set default return value
+   Compression ReturnCompress = CompressUnknown;
+
+   // Convert input string to lowercase for easier comparison
+   std::string CompCompare = InCompress;
+   std::transform(CompCompare.begin(), CompCompare.end(), CompCompare.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   // Determine the appropriate enum to use based on the input string
+   if (CompCompare == "none") {
+      ReturnCompress = CompressNone;
+
+   } else if (CompCompare == "deflate" or CompCompare == "zlib") {
+      ReturnCompress = CompressDeflate;
+
+   } else if (CompCompare == "zstd" or CompCompare == "zstandard") {
+      ReturnCompress = CompressZstd;
+
+   } else {
+      ReturnCompress = CompressUnknown;
+   }
+
+   return ReturnCompress;
+
+} // End CompressionFromString
+
 // Methods
 //------------------------------------------------------------------------------
 // Initializes the IO system based on configuration inputs and
@@ -210,6 +256,7 @@ int init(const MPI_Comm &InComm // [in] MPI communicator to use
    Rearranger Rearrange   = RearrDefault;
 
    // Call PIO routine to initialize
+   IOComm       = InComm;
    DefaultRearr = Rearrange;
    Err          = PIOc_Init_Intracomm(InComm, NumIOTasks, IOStride, IOBaseTask,
                                       Rearrange, &SysID);
@@ -234,17 +281,19 @@ int openFile(
     const std::string &Filename, // [in] name (incl path) of file to open
     Mode InMode,                 // [in] mode (read or write)
     FileFmt InFormat,            // [in] (optional) file format
-    IfExists InIfExists          // [in] (for writes) behavior if file exists
+    IfExists InIfExists,         // [in] (for writes) behavior if file exists
+    int InSysID                  // [in] (optional) IO system to use
 ) {
 
-   int Err    = 0;        // default success return code
-   int Format = InFormat; // coerce to integer for PIO calls
+   int Err     = 0;        // default success return code
+   int Format  = InFormat; // coerce to integer for PIO calls
+   int MySysID = InSysID < 0 ? SysID : InSysID;
 
    switch (InMode) {
 
    // If reading, open the file for read-only
    case ModeRead:
-      Err = PIOc_openfile(SysID, &FileID, &Format, Filename.c_str(), InMode);
+      Err = PIOc_openfile(MySysID, &FileID, &Format, Filename.c_str(), InMode);
       if (Err != PIO_NOERR)
          LOG_ERROR("IO::openFile: PIO error opening file {} for read",
                    Filename);
@@ -258,7 +307,7 @@ int openFile(
       // If the write should be a new file and fail if the
       // file exists, we use create and fail with an error
       case IfExists::Fail:
-         Err = PIOc_createfile(SysID, &FileID, &Format, Filename.c_str(),
+         Err = PIOc_createfile(MySysID, &FileID, &Format, Filename.c_str(),
                                NC_NOCLOBBER | InMode);
          if (Err != PIO_NOERR)
             LOG_ERROR("IO::openFile: PIO error opening file {} for writing",
@@ -268,7 +317,7 @@ int openFile(
       // If the write should replace any existing file
       // we use create with the CLOBBER option
       case IfExists::Replace:
-         Err = PIOc_createfile(SysID, &FileID, &Format, Filename.c_str(),
+         Err = PIOc_createfile(MySysID, &FileID, &Format, Filename.c_str(),
                                NC_CLOBBER | InMode);
          if (Err != PIO_NOERR)
             LOG_ERROR("IO::openFile: PIO error opening file {} for writing",
@@ -280,10 +329,10 @@ int openFile(
       // the file if it doesn't already exist
       case IfExists::Append:
          if (std::filesystem::exists(Filename)) {
-            Err = PIOc_openfile(SysID, &FileID, &Format, Filename.c_str(),
+            Err = PIOc_openfile(MySysID, &FileID, &Format, Filename.c_str(),
                                 InMode);
          } else {
-            Err = PIOc_createfile(SysID, &FileID, &Format, Filename.c_str(),
+            Err = PIOc_createfile(MySysID, &FileID, &Format, Filename.c_str(),
                                   InMode);
          }
 
@@ -707,6 +756,102 @@ int defineVar(int FileID,                 // [in] ID of the file containing var
 
 } // End defineVar
 
+//------------------------------------------------------------------------------
+// Sets the chunk sizes for a variable in a NetCDF4/HDF5 file
+int defineVarChunks(int FileID, // [in] ID of the file containing var
+                    int VarID,  // [in] ID of the variable
+                    const std::vector<int> &ChunkSizes // [in] chunk shape
+) {
+
+   int Err = 0;
+
+   std::vector<PIO_Offset> Chunks(ChunkSizes.begin(), ChunkSizes.end());
+   Err = PIOc_def_var_chunking(FileID, VarID, NC_CHUNKED, Chunks.data());
+   if (Err != PIO_NOERR) {
+      LOG_ERROR("IO::defineVarChunks: PIO error setting chunk sizes");
+      Err = 1;
+   }
+
+   return Err;
+
+} // End defineVarChunks
+
+//------------------------------------------------------------------------------
+// Sets lossless compression for a variable in a NetCDF4/HDF5 file. The
+// shuffle filter is always used since it improves compression of numeric
+// data for little cost.
+int defineVarCompression(int FileID,         // [in] ID of the file
+                         int VarID,          // [in] ID of the variable
+                         Compression Method, // [in] compression method
+                         int Level           // [in] compression level
+) {
+
+   int Err = 0;
+
+   switch (Method) {
+   case CompressNone:
+      break;
+
+   case CompressDeflate:
+      Err = PIOc_def_var_deflate(FileID, VarID, 1, 1, Level);
+      if (Err != PIO_NOERR) {
+         LOG_ERROR("IO::defineVarCompression: PIO error setting deflate");
+         Err = 1;
+      }
+      break;
+
+   case CompressZstd: {
+#ifdef PIO_HAS_PAR_FILTERS
+      // Zstandard is applied through the registered HDF5 filter
+      constexpr unsigned int ZstdFilterID = 32015;
+      unsigned int Params[1]              = {static_cast<unsigned int>(Level)};
+      Err = PIOc_def_var_filter(FileID, VarID, ZstdFilterID, 1, Params);
+      if (Err != PIO_NOERR) {
+         LOG_ERROR("IO::defineVarCompression: PIO error setting zstd filter");
+         Err = 1;
+      }
+#else
+      LOG_ERROR("IO::defineVarCompression: zstd compression requires PIO "
+                "built with parallel filter support");
+      Err = 1;
+#endif
+      break;
+   }
+
+   default:
+      LOG_ERROR("IO::defineVarCompression: unknown compression method");
+      Err = 1;
+   }
+
+   return Err;
+
+} // End defineVarCompression
+
+//------------------------------------------------------------------------------
+// Sets bit-grooming quantization for a floating point variable
+int defineVarQuantize(int FileID,    // [in] ID of the file
+                      int VarID,     // [in] ID of the variable
+                      int NSigDigits // [in] significant digits to keep
+) {
+
+   int Err = 0;
+
+#ifdef NC_HAS_QUANTIZE
+   Err = PIOc_def_var_quantize(FileID, VarID, NC_QUANTIZE_BITGROOM, NSigDigits);
+   if (Err != PIO_NOERR) {
+      LOG_ERROR("IO::defineVarQuantize: PIO error setting quantization");
+      Err = 1;
+   }
+#else
+   LOG_ERROR("IO::defineVarQuantize: quantization requires NetCDF 4.9 or "
+             "later");
+   Err = 1;
+#endif
+
+   return Err;
+
+} // End defineVarQuantize
+
 //------------------------------------------------------------------------------
 /// Ends define phase signifying all field definitions and metadata
 /// have been written and the larger data sets can now be written
@@ -734,7 +879,8 @@ int createDecomp(
     const std::vector<int> &DimLengths, // [in] global dimension lengths
     int Size,                           // [in] local size of array
     const std::vector<int> &GlobalIndx, // [in] global indx for each local indx
-    Rearranger Rearr                    // [in] rearranger method to use
+    Rearranger Rearr,                   // [in] rearranger method to use
+    int InSysID                         // [in] (optional) IO system to use
 ) {
 
    int Err = 0; // default return code
@@ -750,7 +896,8 @@ int createDecomp(
    // int TmpRearr = Rearr; // needed for type compliance across interface
    // Err = PIOc_InitDecomp(SysID, VarType, NDims, DimLengths, Size, CompMap,
    //                      &DecompID, &TmpRearr, nullptr, nullptr);
-   Err = PIOc_init_decomp(SysID, VarType, NDims, &DimLengths[0], Size,
+   int MySysID = InSysID < 0 ? SysID : InSysID;
+   Err = PIOc_init_decomp(MySysID, VarType, NDims, &DimLengths[0], Size,
                           &CompMap[0], &DecompID, Rearr, nullptr, nullptr);
    if (Err != PIO_NOERR)
       LOG_ERROR("IO::createDecomp: PIO error defining decomposition");
@@ -761,10 +908,12 @@ int createDecomp(
 
 //------------------------------------------------------------------------------
 // Removes a defined PIO decomposition description to free memory
-int destroyDecomp(int &DecompID // [inout] ID for decomposition to be removed
+int destroyDecomp(int &DecompID, // [inout] ID for decomposition to be removed
+                  int InSysID     // [in] (optional) IO system of decomp
 ) {
 
-   int Err = PIOc_freedecomp(SysID, DecompID);
+   int MySysID = InSysID < 0 ? SysID : InSysID;
+   int Err     = PIOc_freedecomp(MySysID, DecompID);
    if (Err != PIO_NOERR)
       LOG_ERROR("IO::destroyDecomp: PIO error freeing decomposition");
 
@@ -772,6 +921,152 @@ int destroyDecomp(int &DecompID // [inout] ID for decomposition to be removed
 
 } // End destroyDecomp
 
+//------------------------------------------------------------------------------
+// Retrieves a decomposition from the cache. Returns true and the ID if a
+// decomposition with a matching key has been cached.
+bool getCachedDecomp(const std::string &Key, // [in] key describing decomp
+                     int &DecompID           // [out] ID of the cached decomp
+) {
+
+   auto It = DecompCache.find(Key);
+   if (It == DecompCache.end())
+      return false;
+
+   DecompID = It->second.first;
+   return true;
+
+} // End getCachedDecomp
+
+//------------------------------------------------------------------------------
+// Adds a decomposition to the cache for later reuse
+void cacheDecomp(const std::string &Key, // [in] key describing decomp
+                 int DecompID,           // [in] ID of decomp to cache
+                 int InSysID             // [in] (optional) IO system of decomp
+) {
+
+   auto It = DecompCache.find(Key);
+   if (It != DecompCache.end()) {
+      LOG_WARN("IO::cacheDecomp: decomposition {} already cached", Key);
+      return;
+   }
+   DecompCache[Key] = std::make_pair(DecompID, InSysID);
+
+} // End cacheDecomp
+
+//------------------------------------------------------------------------------
+// Destroys all cached decompositions and clears the cache
+int clearDecompCache() {
+
+   int Err = 0; // default return code
+
+   for (auto It = DecompCache.begin(); It != DecompCache.end(); ++It) {
+      int DecompID = It->second.first;
+      int Err1     = destroyDecomp(DecompID, It->second.second);
+      if (Err1 != 0) {
+         LOG_ERROR("IO::clearDecompCache: error destroying decomp {}",
+                   It->first);
+         ++Err;
+      }
+   }
+   DecompCache.clear();
+
+   return Err;
+
+} // End clearDecompCache
+
+//------------------------------------------------------------------------------
+// Retrieves the IO system for writing NumSubfiles subfiles, creating it on
+// first use. Consecutive tasks are grouped so that a subfile is written
+// by tasks that are typically on the same node.
+int getSubfileSystem(int NumSubfiles,   // [in] number of subfiles
+                     int &SubSysID,     // [out] IO system for the subfile
+                     int &SubfileIndex, // [out] subfile of local task
+                     MPI_Comm &SubComm  // [out] comm for tasks in subfile
+) {
+
+   int Err = 0; // default return code
+
+   auto It = SubfileSystems.find(NumSubfiles);
+   if (It == SubfileSystems.end()) {
+
+      int MyTask;
+      int NumTasks;
+      MPI_Comm_rank(IOComm, &MyTask);
+      MPI_Comm_size(IOComm, &NumTasks);
+      if (NumSubfiles < 1 or NumSubfiles > NumTasks) {
+         LOG_ERROR("IO::getSubfileSystem: invalid number of subfiles {} "
+                   "for {} tasks",
+                   NumSubfiles, NumTasks);
+         return 1;
+      }
+
+      // Split the tasks into contiguous groups, one for each subfile
+      SubfileSystem NewSys;
+      NewSys.SubfileIndex = static_cast<int>(static_cast<I8>(MyTask) *
+                                             NumSubfiles / NumTasks);
+      Err = MPI_Comm_split(IOComm, NewSys.SubfileIndex, MyTask, &NewSys.Comm);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("IO::getSubfileSystem: error splitting communicator");
+         return Err;
+      }
+
+      // Each group writes its subfile through a single IO task
+      Err = PIOc_Init_Intracomm(NewSys.Comm, 1, 1, 0, DefaultRearr,
+                                &NewSys.SysID);
+      if (Err != PIO_NOERR) {
+         LOG_ERROR("IO::getSubfileSystem: error initializing SCORPIO for "
+                   "subfiles");
+         return Err;
+      }
+
+      It = SubfileSystems.emplace(NumSubfiles, NewSys).first;
+   }
+
+   SubSysID     = It->second.SysID;
+   SubfileIndex = It->second.SubfileIndex;
+   SubComm      = It->second.Comm;
+
+   return Err;
+
+} // End getSubfileSystem
+
+//------------------------------------------------------------------------------
+// Frees all IO systems and communicators created for subfiles
+int clearSubfileSystems() {
+
+   int Err = 0; // default return code
+
+   for (auto It = SubfileSystems.begin(); It != SubfileSystems.end(); ++It) {
+      int Err1 = PIOc_free_iosystem(It->second.SysID);
+      if (Err1 != PIO_NOERR) {
+         LOG_ERROR("IO::clearSubfileSystems: error freeing IO system for {} "
+                   "subfiles",
+                   It->first);
+         ++Err;
+      }
+      MPI_Comm_free(&(It->second.Comm));
+   }
+   SubfileSystems.clear();
+
+   return Err;
+
+} // End clearSubfileSystems
+
+//------------------------------------------------------------------------------
+// Builds the name of a subfile by appending the subfile index to the name of
+// the full file
+std::string subfileName(const std::string &Filename, // [in] base filename
+                        int SubfileIndex             // [in] subfile index
+) {
+
+   std::string Index = std::to_string(SubfileIndex);
+   if (Index.size() < 4)
+      Index.insert(0, 4 - Index.size(), '0');
+
+   return Filename + "." + Index;
+
+} // End subfileName
+
 //------------------------------------------------------------------------------
 // Reads a distributed array. Uses a void pointer for generic interface.
 // All arrays are assumed to be in contiguous storage.
@@ -47,6 +47,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace OMEGA {
 namespace IO {
@@ -93,6 +94,14 @@ enum class IfExists {
    Append,  /// Append to the existing file
 };
 
+/// Compression methods for variables in NetCDF4/HDF5 files
+enum Compression {
+   CompressNone,    ///< no compression (default)
+   CompressDeflate, ///< lossless zlib deflate
+   CompressZstd,    ///< lossless Zstandard (requires parallel filters)
+   CompressUnknown  ///< unknown or undefined
+};
+
 /// Data types for PIO corresponding to Omega types
 enum IODataType {
    IOTypeI4      = PIO_INT,    /// 32-bit integer
@@ -104,7 +113,7 @@ enum IODataType {
 };
 
 /// The IO system id, defined on IO initialization and used by all
-/// IO functions
+/// IO functions unless another system (eg for subfiles) is requested
 extern int SysID;
 
 /// The default file format set on initialization. This value will
@@ -133,6 +142,10 @@ Mode ModeFromString(
 IfExists IfExistsFromString(
     const std::string &IfExists ///< [in] choice of behavior on file existence
 );
+/// Converts string choice for variable compression to an enum
+Compression CompressionFromString(
+    const std::string &Compress ///< [in] choice of compression method
+);
 
 // Methods
 
@@ -154,7 +167,8 @@ int openFile(
     const std::string &Filename,    ///< [in] name (incl path) of file to open
     Mode Mode,                      ///< [in] mode (read or write)
     FileFmt Format    = FmtDefault, ///< [in] (optional) file format
-    IfExists IfExists = IfExists::Fail ///< [in] behavior if file exists
+    IfExists IfExists = IfExists::Fail, ///< [in] behavior if file exists
+    int InSysID       = -1 ///< [in] (optional) IO system, default SysID
 );
 
 /// Closes an open file using the fileID, returns an error code
@@ -249,6 +263,32 @@ int defineVar(int FileID, ///< [in] ID of the file containing dim
               int &VarID   ///< [out] id assigned to this variable
 );
 
+/// Sets the chunk sizes for a variable in a NetCDF4/HDF5 file. There must
+/// be one chunk size for each variable dimension (including any
+/// unlimited time dimension). Must be called after defineVar and before any
+/// data is written.
+int defineVarChunks(int FileID, ///< [in] ID of the file containing var
+                    int VarID,  ///< [in] ID of the variable
+                    const std::vector<int> &ChunkSizes ///< [in] chunk shape
+);
+
+/// Sets lossless compression for a variable in a NetCDF4/HDF5 file with
+/// the given compression level. Must be called after defineVar and before
+/// any data is written.
+int defineVarCompression(int FileID,         ///< [in] ID of the file
+                         int VarID,          ///< [in] ID of the variable
+                         Compression Method, ///< [in] compression method
+                         int Level           ///< [in] compression level
+);
+
+/// Sets lossy quantization (bit-grooming) for a floating point variable in
+/// a NetCDF4/HDF5 file, retaining the given number of significant digits.
+/// Quantized data compresses much better with lossless compression.
+int defineVarQuantize(int FileID,    ///< [in] ID of the file
+                      int VarID,     ///< [in] ID of the variable
+                      int NSigDigits ///< [in] significant digits to keep
+);
+
 /// Ends define mode signifying all field definitions and metadata
 /// have been written and the larger data sets can now be written
 int endDefinePhase(int FileID ///< [in] ID of the file being written
@@ -263,11 +303,57 @@ int createDecomp(
     const std::vector<int> &DimLengths, ///< [in] global dimension lengths
     int Size,                           ///< [in] local size of array
     const std::vector<int> &GlobalIndx, ///< [in] global indx for each loc indx
-    Rearranger Rearr                    ///< [in] rearranger method to use
+    Rearranger Rearr,                   ///< [in] rearranger method to use
+    int InSysID = -1 ///< [in] (optional) IO system, default SysID
 );
 
 /// Removes a PIO decomposition to free memory.
-int destroyDecomp(int &DecompID ///< [inout] ID for decomp to remove
+int destroyDecomp(int &DecompID,  ///< [inout] ID for decomp to remove
+                  int InSysID = -1 ///< [in] (optional) IO system of decomp
+);
+
+/// Retrieves a decomposition previously added to the decomposition cache
+/// under the given key. Returns true and the decomposition ID if a
+/// matching entry exists, false otherwise. The key must uniquely describe
+/// the data type and layout of the decomposition (eg the data type and the
+/// names and lengths of the dimensions that define the offsets).
+bool getCachedDecomp(const std::string &Key, ///< [in] key describing decomp
+                     int &DecompID ///< [out] ID of the cached decomp
+);
+
+/// Adds a decomposition to the cache so that it can be reused by later
+/// reads and writes of arrays with the same layout. Cached decompositions
+/// are owned by the IO layer and must not be destroyed by the caller.
+void cacheDecomp(const std::string &Key, ///< [in] key describing decomp
+                 int DecompID,           ///< [in] ID of decomp to cache
+                 int InSysID = -1 ///< [in] (optional) IO system of decomp
+);
+
+/// Destroys all decompositions in the cache and clears the cache.
+/// Returns an error code.
+int clearDecompCache();
+
+/// Retrieves the IO system used to write files split into NumSubfiles
+/// subfiles, creating it on first use. The tasks are divided into
+/// NumSubfiles groups of consecutive tasks (typically the tasks on a node or
+/// group of nodes) and each group writes its own file through its own IO
+/// system with a single IO task. Returns the IO system ID, the subfile
+/// written by the local task and the communicator for the group of tasks
+/// sharing the subfile. Must be called by all tasks.
+int getSubfileSystem(int NumSubfiles,   ///< [in] number of subfiles
+                     int &SubSysID,     ///< [out] IO system for the subfile
+                     int &SubfileIndex, ///< [out] subfile of local task
+                     MPI_Comm &SubComm  ///< [out] comm for tasks in subfile
+);
+
+/// Frees all IO systems and communicators created for subfiles.
+/// Returns an error code.
+int clearSubfileSystems();
+
+/// Builds the name of a subfile from the name of the full file by
+/// appending the subfile index, eg ocn.restart.nc.0003
+std::string subfileName(const std::string &Filename, ///< [in] base filename
+                        int SubfileIndex             ///< [in] subfile index
 );
 
 /// Reads a distributed array. We use a void pointer here to create
@@ -0,0 +1,101 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- base/KernelPolicy.cpp - column kernel policies ----------*- C++ -*-===//
+//
+// Stores the parallel policy chosen for each column kernel. The functors look
+// up their policy by kernel name when they are constructed.
+//
+//===----------------------------------------------------------------------===//
+
+#include "KernelPolicy.h"
+#include "Config.h"
+#include "Error.h"
+#include "Logging.h"
+
+namespace OMEGA {
+
+#ifdef OMEGA_TEAM_POLICY
+static constexpr KernelPolicyType BuildDefaultPolicy = KernelPolicyType::Team;
+#else
+static constexpr KernelPolicyType BuildDefaultPolicy = KernelPolicyType::Flat;
+#endif
+
+// create the static class members
+KernelPolicyType KernelPolicy::DefaultPolicy = BuildDefaultPolicy;
+std::map<std::string, KernelPolicyType> KernelPolicy::Policies;
+
+//------------------------------------------------------------------------------
+// Read the policies from the optional KernelPolicy group of the Omega Config.
+// Every entry other than Default names a kernel.
+void KernelPolicy::init() {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("KernelPolicy"))
+      return;
+
+   Config PolicyConfig("KernelPolicy");
+   Error Err = OmegaConfig->get(PolicyConfig);
+   CHECK_ERROR_ABORT(Err, "KernelPolicy: error reading KernelPolicy group");
+
+   for (auto It = PolicyConfig.begin(); It != PolicyConfig.end(); ++It) {
+      std::string KernelName;
+      std::string PolicyName;
+      Err += Config::getName(It, KernelName);
+      Err += PolicyConfig.get(KernelName, PolicyName);
+      CHECK_ERROR_ABORT(Err, "KernelPolicy: error reading entry {}",
+                        KernelName);
+
+      if (KernelName == "Default") {
+         DefaultPolicy = fromString(PolicyName);
+      } else {
+         Policies[KernelName] = fromString(PolicyName);
+         LOG_INFO("KernelPolicy: {} policy for kernel {}", PolicyName,
+                  KernelName);
+      }
+   }
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Return the policy of a kernel, or the default if it is not set
+KernelPolicyType KernelPolicy::get(const std::string &KernelName) {
+
+   auto It = Policies.find(KernelName);
+   if (It != Policies.end())
+      return It->second;
+   return DefaultPolicy;
+}
+
+//------------------------------------------------------------------------------
+// Set the policy of a kernel
+void KernelPolicy::set(const std::string &KernelName,
+                       KernelPolicyType Policy) {
+   Policies[KernelName] = Policy;
+}
+
+//------------------------------------------------------------------------------
+// Restore the build default for all kernels
+void KernelPolicy::clear() {
+   Policies.clear();
+   DefaultPolicy = BuildDefaultPolicy;
+}
+
+//------------------------------------------------------------------------------
+// Convert a policy name to the policy type
+KernelPolicyType KernelPolicy::fromString(const std::string &Name) {
+
+   if (Name == "Flat" or Name == "flat")
+      return KernelPolicyType::Flat;
+   if (Name == "Team" or Name == "team")
+      return KernelPolicyType::Team;
+
+   ABORT_ERROR("KernelPolicy: unknown policy {}, must be Flat or Team", Name);
+   return KernelPolicyType::Flat;
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,96 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_KERNELPOLICY_H
+#define OMEGA_KERNELPOLICY_H
+//===-- base/KernelPolicy.h - parallel policy of column kernels -*- C++ -*-===//
+//
+/// \file
+/// \brief Selects the parallel execution policy of the column kernels
+///
+/// The column kernels are normally launched with a flat policy over
+/// (entity, vertical chunk) pairs. Kernels that support it can instead be
+/// launched with a hierarchical team policy: one team per cell or edge,
+/// with the vertical chunks spread over the threads and vector lanes of the
+/// team and the neighbor connectivity of the entity staged once in team
+/// scratch memory. On GPUs this makes the loads of each neighbor list
+/// contiguous and shared by all levels of the column.
+///
+/// The policy is chosen per kernel by name. The default is Flat, or Team
+/// for builds with -DOMEGA_TEAM_POLICY, and can be changed at run time with
+/// the optional KernelPolicy group of the Omega Config:
+/// \ConfigInput
+/// KernelPolicy:
+///    # Policy of all kernels not listed below, Flat or Team
+///    Default: Flat
+///    # Policy of individual kernels
+///    fusedVelocityTendOnEdge: Team
+/// \EndConfigInput
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <map>
+#include <string>
+
+namespace OMEGA {
+
+/// Parallel execution policies of a column kernel
+enum class KernelPolicyType {
+   Flat, ///< flat policy over entities and vertical chunks
+   Team  ///< one team per entity with chunks over the team
+};
+
+/// Team policy and scratch memory types for the team kernels
+using TeamPolicyType = Kokkos::TeamPolicy<ExecSpace>;
+using TeamMemberType = TeamPolicyType::member_type;
+using ScratchArray1DI4 =
+    Kokkos::View<I4 *, ExecSpace::scratch_memory_space,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+using ScratchArray2DI4 =
+    Kokkos::View<I4 **, ExecSpace::scratch_memory_space,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+using ScratchArray1DReal =
+    Kokkos::View<Real *, ExecSpace::scratch_memory_space,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+using ScratchArray2DReal =
+    Kokkos::View<Real **, ExecSpace::scratch_memory_space,
+                 Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+/// Registry of the parallel policy of each column kernel
+class KernelPolicy {
+ public:
+   /// Reads the policies from the optional KernelPolicy group of the Omega
+   /// Config. The build default is used for all kernels if it is absent.
+   static void init();
+
+   /// Returns the policy of a kernel
+   static KernelPolicyType get(const std::string &KernelName ///< [in] kernel
+   );
+
+   /// Sets the policy of a kernel. Only affects functors created afterward.
+   static void set(const std::string &KernelName, ///< [in] kernel
+                   KernelPolicyType Policy        ///< [in] new policy
+   );
+
+   /// Restores the build default for all kernels
+   static void clear();
+
+   /// Converts a policy name (Flat or Team) to the policy type, aborting
+   /// for an unknown name
+   static KernelPolicyType fromString(const std::string &Name ///< [in] name
+   );
+
+ private:
+   /// Policy of kernels that are not set individually
+   static KernelPolicyType DefaultPolicy;
+
+   /// Policies of individual kernels
+   static std::map<std::string, KernelPolicyType> Policies;
+};
+
+} // namespace OMEGA
+#endif
@@ -65,6 +65,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
 #else
    NumThreads = 1;
 #endif
+
+   // create the node and leader communicators
+   initNodeComms();
 } // end constructor with MPI communicator
 
 //------------------------------------------------------------------------------
@@ -152,6 +155,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
 #else
    NumThreads = 1;
 #endif
+
+   // create the node and leader communicators
+   initNodeComms();
 } // end subset constructor with contiguous range
 
 //------------------------------------------------------------------------------
@@ -241,6 +247,9 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    NumThreads = 1;
 #endif
 
+   // create the node and leader communicators
+   initNodeComms();
+
 } // end constructor using strided range
 
 //------------------------------------------------------------------------------
@@ -328,8 +337,55 @@ MachEnv::MachEnv(const std::string Name, // [in] name of environment
    NumThreads = 1;
 #endif
 
+   // create the node and leader communicators
+   initNodeComms();
+
 } // end constructor with selected tasks
 
+//------------------------------------------------------------------------------
+// Creates the node and leader communicators. The node communicator groups
+// the tasks that can share memory and the leader communicator groups the
+// first task of each node. Tasks outside the environment get null
+// communicators and bogus values.
+
+void MachEnv::initNodeComms() {
+
+   if (!MemberFlag) {
+      NodeComm       = MPI_COMM_NULL;
+      LeaderComm     = MPI_COMM_NULL;
+      MyNodeTask     = -999;
+      NumNodeTasks   = -999;
+      MyNode         = -999;
+      NumNodes       = -999;
+      NodeLeaderFlag = false;
+      return;
+   }
+
+   // split into tasks sharing memory, keeping the task order of the
+   // environment within each node
+   MPI_Comm_split_type(Comm, MPI_COMM_TYPE_SHARED, MyTask, MPI_INFO_NULL,
+                       &NodeComm);
+   MPI_Comm_rank(NodeComm, &MyNodeTask);
+   MPI_Comm_size(NodeComm, &NumNodeTasks);
+   NodeLeaderFlag = (MyNodeTask == 0);
+
+   // the leaders are ordered by environment task so that the node ID
+   // increases with the task IDs on the node
+   int Color = NodeLeaderFlag ? 0 : MPI_UNDEFINED;
+   MPI_Comm_split(Comm, Color, MyTask, &LeaderComm);
+   if (NodeLeaderFlag) {
+      MPI_Comm_rank(LeaderComm, &MyNode);
+      MPI_Comm_size(LeaderComm, &NumNodes);
+   }
+
+   // share the node ID and number of nodes with the rest of the node
+   int NodeInfo[2] = {MyNode, NumNodes};
+   MPI_Bcast(NodeInfo, 2, MPI_INT, 0, NodeComm);
+   MyNode   = NodeInfo[0];
+   NumNodes = NodeInfo[1];
+
+} // end initNodeComms
+
 //------------------------------------------------------------------------------
 // Initializes the Machine Environment by creating the DefaultEnv for Omega
 
@@ -342,6 +398,24 @@ void MachEnv::init(const MPI_Comm InComm // [in] communicator to use
 } // end init Mach Env
 
 // Remove/delete functions
+//------------------------------------------------------------------------------
+// Destructor frees the node and leader communicators created by
+// initNodeComms. Nothing can be freed once MPI has been finalized.
+
+MachEnv::~MachEnv() {
+
+   int Finalized = 0;
+   MPI_Finalized(&Finalized);
+   if (Finalized)
+      return;
+
+   if (LeaderComm != MPI_COMM_NULL)
+      MPI_Comm_free(&LeaderComm);
+   if (NodeComm != MPI_COMM_NULL)
+      MPI_Comm_free(&NodeComm);
+
+} // end destructor
+
 //------------------------------------------------------------------------------
 // Remove environment
 
@@ -414,6 +488,75 @@ bool MachEnv::isMasterTask() const { return MasterTaskFlag; }
 
 bool MachEnv::isMember() const { return MemberFlag; }
 
+//------------------------------------------------------------------------------
+// Get communicator of tasks on the same node
+MPI_Comm MachEnv::getNodeComm() const { return NodeComm; }
+
+//------------------------------------------------------------------------------
+// Get communicator of node leaders
+MPI_Comm MachEnv::getLeaderComm() const { return LeaderComm; }
+
+//------------------------------------------------------------------------------
+// Get task ID within the node
+int MachEnv::getMyNodeTask() const { return MyNodeTask; }
+
+//------------------------------------------------------------------------------
+// Get number of tasks on this node
+int MachEnv::getNumNodeTasks() const { return NumNodeTasks; }
+
+//------------------------------------------------------------------------------
+// Get node ID
+int MachEnv::getMyNode() const { return MyNode; }
+
+//------------------------------------------------------------------------------
+// Get total number of nodes
+int MachEnv::getNumNodes() const { return NumNodes; }
+
+//------------------------------------------------------------------------------
+// Determine whether local task is the node leader
+bool MachEnv::isNodeLeader() const { return NodeLeaderFlag; }
+
+//------------------------------------------------------------------------------
+// Hierarchical all-reduce: reduce on the node, all-reduce across the node
+// leaders and broadcast the result on the node
+
+int MachEnv::allReduceHier(const void *SendBuf, // [in] local values
+                           void *RecvBuf,       // [out] reduced values
+                           int Count,           // [in] number of values
+                           MPI_Datatype Type,   // [in] MPI type of values
+                           MPI_Op Op            // [in] reduction operation
+) const {
+
+   int Err = 0;
+
+   // If called from outside the group, don't do anything
+   if (!MemberFlag)
+      return Err;
+
+   // With a single task per node the node steps do nothing
+   if (NumNodeTasks == 1)
+      return MPI_Allreduce(SendBuf, RecvBuf, Count, Type, Op, Comm);
+
+   // Only the root of the node reduction may reduce in place
+   if (NodeLeaderFlag) {
+      Err = MPI_Reduce(SendBuf, RecvBuf, Count, Type, Op, 0, NodeComm);
+   } else {
+      const void *LocalBuf = (SendBuf == MPI_IN_PLACE) ? RecvBuf : SendBuf;
+      Err = MPI_Reduce(LocalBuf, nullptr, Count, Type, Op, 0, NodeComm);
+   }
+   if (Err != MPI_SUCCESS)
+      return Err;
+
+   if (NodeLeaderFlag && NumNodes > 1) {
+      Err = MPI_Allreduce(MPI_IN_PLACE, RecvBuf, Count, Type, Op, LeaderComm);
+      if (Err != MPI_SUCCESS)
+         return Err;
+   }
+
+   return MPI_Bcast(RecvBuf, Count, Type, 0, NodeComm);
+
+} // end allReduceHier
+
 //------------------------------------------------------------------------------
 // Set task ID for the master task (if not 0)
 
@@ -452,6 +595,11 @@ void MachEnv::print() const {
    LOG_INFO("  MasterTask     = {}", MasterTask);
    LOG_INFO("  MasterTaskFlag = {}", MasterTaskFlag);
    LOG_INFO("  MemberFlag     = {}", MemberFlag);
+   LOG_INFO("  MyNodeTask     = {}", MyNodeTask);
+   LOG_INFO("  NumNodeTasks   = {}", NumNodeTasks);
+   LOG_INFO("  MyNode         = {}", MyNode);
+   LOG_INFO("  NumNodes       = {}", NumNodes);
+   LOG_INFO("  NodeLeaderFlag = {}", NodeLeaderFlag);
    LOG_INFO("  NumThreads     = {}", NumThreads);
    LOG_INFO("  VecLength      = {}", VecLength);
 
@@ -28,13 +28,27 @@
 #include <map>
 #include <memory>
 
+#ifdef OMEGA_SIMD
+#include <Kokkos_SIMD.hpp>
+#endif
+
 namespace OMEGA {
 
 // For CPUs, a compile-time vector length is useful for
 // blocking the inner loops. This should be set to an appropriate
 // length (typically 32, 64, 128) for CPU-only builds, but set to one for
-// GPU builds to maximize parallelism instead.
+// GPU builds to maximize parallelism instead. A build with explicit SIMD
+// vectorization (OMEGA_SIMD) instead uses the width of the native SIMD type
+// so that each vertical chunk fits in one SIMD register.
+#ifdef OMEGA_SIMD
+#ifdef OMEGA_SINGLE_PRECISION
+constexpr int VecLength = Kokkos::Experimental::native_simd<float>::size();
+#else
+constexpr int VecLength = Kokkos::Experimental::native_simd<double>::size();
+#endif
+#else
 constexpr int VecLength = OMEGA_VECTOR_LENGTH;
+#endif
 
 /// The MachEnv class is a container that holds information on
 /// the message passing, threading and node environment.
@@ -51,10 +65,20 @@ class MachEnv {
    // Add threading variables here
    int NumThreads; ///< number of OpenMP threads per task
 
+   // Node layout. Tasks that share memory on a node are grouped in a node
+   // communicator and the first task on each node (the node leader) is a
+   // member of a leader communicator spanning the nodes.
+   MPI_Comm NodeComm;   ///< communicator of tasks on the same node
+   MPI_Comm LeaderComm; ///< communicator of node leaders (null on others)
+   int MyNodeTask;      ///< task ID within the node communicator
+   int NumNodeTasks;    ///< number of tasks on this node
+   int MyNode;          ///< node ID (rank of the node leader among leaders)
+   int NumNodes;        ///< total number of nodes in this environment
+   bool NodeLeaderFlag; ///< true if this task is the leader on its node
+
    // Add any other useful machine parameters here
    // It may be useful at some point to track the number
-   // of various devices per node (CPUs, GPUs), the number
-   // of tasks allocated per node, etc.
+   // of various devices per node (CPUs, GPUs), etc.
 
    /// The default environment describes the environment for OMEGA
    /// defined for most of the model. Because it is used most often,
@@ -107,6 +131,10 @@ class MachEnv {
            const int InMasterTask = 0 ///< [in] optional task to use for master
    );
 
+   /// Creates the node and leader communicators from the environment
+   /// communicator. Called by all constructors once the communicator is set.
+   void initNodeComms();
+
    // forbid copy and move construction
    MachEnv(const MachEnv &) = delete;
    MachEnv(MachEnv &&)      = delete;
@@ -114,6 +142,9 @@ class MachEnv {
  public:
    // Methods
 
+   /// Destructor frees the node and leader communicators
+   ~MachEnv();
+
    // Creates a new environment by calling the constructor with the
    // supplied arguments and stores it in the map of all environments.
    // This a variadic template because MachEnv constructors have different
@@ -184,6 +215,41 @@ class MachEnv {
    /// tasks.
    bool isMember() const;
 
+   /// Get communicator of the tasks sharing memory on this node
+   MPI_Comm getNodeComm() const;
+
+   /// Get communicator of the node leaders. This is MPI_COMM_NULL on tasks
+   /// that are not node leaders.
+   MPI_Comm getLeaderComm() const;
+
+   /// Get task ID within the node
+   int getMyNodeTask() const;
+
+   /// Get number of tasks on this node
+   int getNumNodeTasks() const;
+
+   /// Get node ID
+   int getMyNode() const;
+
+   /// Get total number of nodes
+   int getNumNodes() const;
+
+   /// Determine whether local task is the leader (first task) on its node
+   bool isNodeLeader() const;
+
+   /// Hierarchical all-reduce over the environment. Values are reduced on
+   /// each node to the node leader, then across node leaders and finally
+   /// broadcast on each node, so only one task per node takes part in the
+   /// inter-node reduction. The operation must be commutative. Results may
+   /// differ in the last bits from MPI_Allreduce for floating-point sums.
+   /// \return MPI error code
+   int allReduceHier(const void *SendBuf, ///< [in] local values
+                     void *RecvBuf,       ///< [out] reduced values
+                     int Count,           ///< [in] number of values
+                     MPI_Datatype Type,   ///< [in] MPI type of values
+                     MPI_Op Op            ///< [in] reduction operation
+   ) const;
+
    // Only one variable can be set
 
    /// Set master task ID. By default, the master task is task 0 but
@@ -0,0 +1,173 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- base/MemoryRegistry.cpp - memory footprint accounting ---*- C++ -*-===//
+//
+// Records the arrays of each module and Field and reports their sizes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "MemoryRegistry.h"
+#include "Config.h"
+#include "Error.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "ScratchPool.h"
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace OMEGA {
+
+// create the static class members
+std::map<std::string, std::map<std::string, MemoryRegistry::Entry>>
+    MemoryRegistry::Modules;
+bool MemoryRegistry::ReportEnabled   = false;
+I4 MemoryRegistry::NTopFields        = 10;
+bool MemoryRegistry::DropHostMirrors = false;
+
+//------------------------------------------------------------------------------
+// Read the options from the optional MemoryReport group of the Omega Config
+void MemoryRegistry::init() {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("MemoryReport"))
+      return;
+
+   Config MemConfig("MemoryReport");
+   Error Err = OmegaConfig->get(MemConfig);
+   CHECK_ERROR_ABORT(Err, "MemoryRegistry: error reading MemoryReport group");
+
+   Err += MemConfig.get("Enabled", ReportEnabled);
+   CHECK_ERROR_ABORT(Err, "MemoryRegistry: Enabled not found in "
+                          "MemoryReport Config");
+
+   if (MemConfig.existsVar("NTopFields")) {
+      Err += MemConfig.get("NTopFields", NTopFields);
+      CHECK_ERROR_ABORT(Err, "MemoryRegistry: error reading NTopFields");
+   }
+
+   if (MemConfig.existsVar("DropHostMirrors")) {
+      Err += MemConfig.get("DropHostMirrors", DropHostMirrors);
+      CHECK_ERROR_ABORT(Err, "MemoryRegistry: error reading DropHostMirrors");
+   }
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Record a block of memory of a module
+void MemoryRegistry::addBytes(const std::string &Module,
+                              const std::string &Name, bool OnHost, I8 Bytes) {
+   Entry &NewEntry = Modules[Module][Name];
+   NewEntry.OnHost = OnHost;
+   NewEntry.Bytes  = Bytes;
+}
+
+//------------------------------------------------------------------------------
+// Remove an entry
+void MemoryRegistry::remove(const std::string &Module,
+                            const std::string &Name) {
+   auto It = Modules.find(Module);
+   if (It != Modules.end())
+      It->second.erase(Name);
+}
+
+//------------------------------------------------------------------------------
+// Remove all entries of a module
+void MemoryRegistry::removeModule(const std::string &Module) {
+   Modules.erase(Module);
+}
+
+//------------------------------------------------------------------------------
+// Return the bytes recorded for a module in host or device memory
+I8 MemoryRegistry::getBytes(const std::string &Module, bool OnHost) {
+
+   I8 Bytes = 0;
+   auto It  = Modules.find(Module);
+   if (It == Modules.end())
+      return Bytes;
+
+   for (const auto &[Name, Array] : It->second) {
+      if (Array.OnHost == OnHost)
+         Bytes += Array.Bytes;
+   }
+   return Bytes;
+}
+
+//------------------------------------------------------------------------------
+// Write the memory report to the log
+void MemoryRegistry::report(const std::string &When) {
+
+   if (!ReportEnabled)
+      return;
+
+   const R8 MiB = 1024.0 * 1024.0;
+   LOG_INFO("MemoryRegistry: memory use {} (MiB on the master task)", When);
+   LOG_INFO("MemoryRegistry:   {:<20} {:>12} {:>12}", "Module", "Device",
+            "Host");
+
+   // Totals exclude the Field entries, which overlap the module arrays
+   I8 Totals[2] = {0, 0};
+   for (const auto &[Module, Arrays] : Modules) {
+      const I8 DevBytes  = getBytes(Module, false);
+      const I8 HostBytes = getBytes(Module, true);
+      LOG_INFO("MemoryRegistry:   {:<20} {:>12.2f} {:>12.2f}", Module,
+               DevBytes / MiB, HostBytes / MiB);
+      if (Module != "Field") {
+         Totals[0] += DevBytes;
+         Totals[1] += HostBytes;
+      }
+   }
+   LOG_INFO("MemoryRegistry:   {:<20} {:>12.2f} {:>12.2f}", "ScratchPool",
+            ScratchPool::getDeviceBytes() / MiB,
+            ScratchPool::getHostBytes() / MiB);
+   Totals[0] += ScratchPool::getDeviceBytes();
+   Totals[1] += ScratchPool::getHostBytes();
+
+   // List the largest fields
+   auto FieldIt = Modules.find("Field");
+   if (FieldIt != Modules.end()) {
+      std::vector<std::pair<I8, std::string>> Fields;
+      for (const auto &[Name, Array] : FieldIt->second)
+         Fields.emplace_back(Array.Bytes, Name);
+      std::sort(Fields.rbegin(), Fields.rend());
+      const I4 NList = std::min<I4>(NTopFields, Fields.size());
+      LOG_INFO("MemoryRegistry:   largest {} of {} fields:", NList,
+               Fields.size());
+      for (int IField = 0; IField < NList; ++IField) {
+         const std::string &Name = Fields[IField].second;
+         LOG_INFO("MemoryRegistry:     {:<30} {:>12.2f} {}", Name,
+                  Fields[IField].first / MiB,
+                  FieldIt->second[Name].OnHost ? "host" : "device");
+      }
+   }
+
+   MPI_Allreduce(MPI_IN_PLACE, Totals, 2, MPI_INT64_T, MPI_MAX,
+                 MachEnv::getDefault()->getComm());
+   LOG_INFO("MemoryRegistry:   total over modules, max over tasks: "
+            "{:.2f} MiB device, {:.2f} MiB host",
+            Totals[0] / MiB, Totals[1] / MiB);
+
+} // end report
+
+//------------------------------------------------------------------------------
+// Return true if init-only host mirrors should be freed
+bool MemoryRegistry::dropHostMirrors() { return DropHostMirrors; }
+
+//------------------------------------------------------------------------------
+// Remove all entries and reset the options
+void MemoryRegistry::clear() {
+   Modules.clear();
+   ReportEnabled   = false;
+   NTopFields      = 10;
+   DropHostMirrors = false;
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
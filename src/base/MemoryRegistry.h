@@ -0,0 +1,117 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_MEMORYREGISTRY_H
+#define OMEGA_MEMORYREGISTRY_H
+//===-- base/MemoryRegistry.h - memory footprint accounting -----*- C++ -*-===//
+//
+/// \file
+/// \brief Tracks the memory used by each module and Field
+///
+/// Modules record the arrays they allocate in the MemoryRegistry under the
+/// module name and an array name. Every array attached to a Field is also
+/// recorded under the Field module with the field name. Recording an array
+/// under a name that is already present replaces the old entry, so arrays
+/// that are reallocated or swapped are not counted twice. The registry can
+/// report the bytes of each module in device and host memory and the
+/// largest fields. Field data usually belong to another module (state,
+/// tracers, auxiliary variables), so the Field total overlaps the totals of
+/// those modules when they record their arrays too.
+///
+/// The report and the removal of host mirrors that are only needed during
+/// init are controlled by the optional MemoryReport group of the Omega
+/// Config:
+/// \ConfigInput
+/// MemoryReport:
+///    # Write the memory report at the end of init and of the run
+///    Enabled: false
+///    # Number of largest fields listed in the report
+///    NTopFields: 10
+///    # Free host copies of the mesh connectivity after init
+///    DropHostMirrors: false
+/// \EndConfigInput
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <map>
+#include <string>
+
+namespace OMEGA {
+
+/// Registry of the memory used by each module and Field
+class MemoryRegistry {
+ public:
+   /// Reads the options from the optional MemoryReport group of the Omega
+   /// Config
+   static void init();
+
+   /// Records an array of a module. An entry with the same module and name
+   /// is replaced.
+   template <class ViewType>
+   static void add(const std::string &Module, ///< [in] owning module
+                   const std::string &Name,   ///< [in] array name
+                   const ViewType &Array      ///< [in] array to record
+   ) {
+      using SpaceType   = typename ViewType::memory_space;
+      const bool OnHost =
+          Kokkos::SpaceAccessibility<Kokkos::HostSpace, SpaceType>::accessible;
+      addBytes(Module, Name, OnHost,
+               Array.span() * sizeof(typename ViewType::value_type));
+   }
+
+   /// Records a block of memory of a module that is not a Kokkos array,
+   /// such as a std::vector staging buffer
+   static void addBytes(const std::string &Module, ///< [in] owning module
+                        const std::string &Name,   ///< [in] block name
+                        bool OnHost,               ///< [in] true if on host
+                        I8 Bytes                   ///< [in] size of the block
+   );
+
+   /// Removes an entry
+   static void remove(const std::string &Module, ///< [in] owning module
+                      const std::string &Name    ///< [in] array name
+   );
+
+   /// Removes all entries of a module
+   static void removeModule(const std::string &Module ///< [in] module
+   );
+
+   /// Returns the bytes recorded for a module in host or device memory
+   static I8 getBytes(const std::string &Module, ///< [in] module
+                      bool OnHost                ///< [in] true for host memory
+   );
+
+   /// Writes the bytes of each module by memory space and the largest
+   /// fields on the master task, and the total maximized over all tasks, to
+   /// the log if the report is enabled
+   static void report(const std::string &When ///< [in] label of the report
+   );
+
+   /// Returns true if host mirrors that are only needed during init should
+   /// be freed at the end of init
+   static bool dropHostMirrors();
+
+   /// Removes all entries and resets the options
+   static void clear();
+
+ private:
+   /// Size and location of a recorded array
+   struct Entry {
+      bool OnHost = false; ///< true if the array is in host memory
+      I8 Bytes    = 0;     ///< size of the array
+   };
+
+   /// Entries by module and array name
+   static std::map<std::string, std::map<std::string, Entry>> Modules;
+
+   static bool ReportEnabled;   ///< Write the report
+   static I4 NTopFields;        ///< Number of fields listed in the report
+   static bool DropHostMirrors; ///< Free init-only host mirrors
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,120 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_SIMD_H
+#define OMEGA_SIMD_H
+//===-- base/OmegaSimd.h - explicit SIMD for vertical chunks ----*- C++ -*-===//
+//
+/// \file
+/// \brief Defines SIMD types and helpers for the vertical chunks of kernels
+///
+/// Most Omega kernels work on chunks of VecLength vertical levels and rely on
+/// the compiler to vectorize the loop over the levels of a chunk. The
+/// indirect loads of neighbor indices often prevent this on CPUs. In a build
+/// with the -DOMEGA_SIMD flag, VecLength is the width of the native
+/// Kokkos::Experimental::simd type for Real and the chunked kernels hold a
+/// chunk in one SimdReal value, using the load and store helpers below to
+/// move the levels KStart to KStart + VecLength - 1 of an array row. The
+/// arrays must have the vertical index last and contiguous. Rows of arrays
+/// in another layout or precision, such as a TracerArray or the single
+/// precision tracer auxiliary arrays, are moved one level at a time with
+/// gatherChunk and scatterChunk. In other builds only simdWidth is defined
+/// and the kernels use their scalar loops. The number of vertical levels must
+/// be a multiple of VecLength, which ocnInit checks.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+
+#ifdef OMEGA_SIMD
+#include <Kokkos_SIMD.hpp>
+#include <cstddef>
+#include <type_traits>
+#endif
+
+namespace OMEGA {
+
+#ifdef OMEGA_SIMD
+
+/// SIMD type holding one vertical chunk of Real values
+using SimdReal = Kokkos::Experimental::native_simd<Real>;
+
+static_assert(SimdReal::size() == VecLength,
+              "OMEGA_SIMD requires VecLength to match the native SIMD width");
+static_assert(std::is_same_v<Array2DReal::array_layout, Kokkos::LayoutRight>,
+              "OMEGA_SIMD requires arrays with the vertical index contiguous");
+
+/// Loads levels KStart to KStart + VecLength - 1 of row I of a 2D array
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION SimdReal loadChunk(const ViewType &Arr, I4 I,
+                                          I4 KStart) {
+   SimdReal Chunk;
+   Chunk.copy_from(&Arr(I, KStart),
+                   Kokkos::Experimental::element_aligned_tag());
+   return Chunk;
+}
+
+/// Loads levels KStart to KStart + VecLength - 1 of row (L, I) of a 3D array
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION SimdReal loadChunk(const ViewType &Arr, I4 L, I4 I,
+                                          I4 KStart) {
+   SimdReal Chunk;
+   Chunk.copy_from(&Arr(L, I, KStart),
+                   Kokkos::Experimental::element_aligned_tag());
+   return Chunk;
+}
+
+/// Stores a chunk to levels KStart to KStart + VecLength - 1 of row I of a
+/// 2D array
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION void storeChunk(const ViewType &Arr, I4 I, I4 KStart,
+                                       const SimdReal &Chunk) {
+   Chunk.copy_to(&Arr(I, KStart), Kokkos::Experimental::element_aligned_tag());
+}
+
+/// Stores a chunk to levels KStart to KStart + VecLength - 1 of row (L, I)
+/// of a 3D array
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION void storeChunk(const ViewType &Arr, I4 L, I4 I,
+                                       I4 KStart, const SimdReal &Chunk) {
+   Chunk.copy_to(&Arr(L, I, KStart),
+                 Kokkos::Experimental::element_aligned_tag());
+}
+
+/// Loads levels KStart to KStart + VecLength - 1 of row (L, I) of a 3D array
+/// of any layout and precision one level at a time, converting to Real
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION SimdReal gatherChunk(const ViewType &Arr, I4 L, I4 I,
+                                            I4 KStart) {
+   return SimdReal([&](std::size_t KVec) {
+      return static_cast<Real>(Arr(L, I, KStart + KVec));
+   });
+}
+
+/// Stores a chunk to levels KStart to KStart + VecLength - 1 of row (L, I)
+/// of a 3D array of any layout and precision one level at a time
+template <class ViewType>
+KOKKOS_INLINE_FUNCTION void scatterChunk(const ViewType &Arr, I4 L, I4 I,
+                                         I4 KStart, const SimdReal &Chunk) {
+   for (std::size_t KVec = 0; KVec < SimdReal::size(); ++KVec)
+      Arr(L, I, KStart + KVec) = Chunk[KVec];
+}
+
+#endif
+
+/// Returns the number of Real values processed by one vector instruction in
+/// the chunked kernels: the native SIMD width with OMEGA_SIMD and 1
+/// otherwise, where vectorization is left to the compiler
+constexpr int simdWidth() {
+#ifdef OMEGA_SIMD
+   return SimdReal::size();
+#else
+   return 1;
+#endif
+}
+
+} // namespace OMEGA
+#endif
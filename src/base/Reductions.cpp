@@ -0,0 +1,327 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- base/Reductions.cpp - batched global reductions ---------*- C++ -*-===//
+//
+// Implements the batched global reductions. The minima and maxima of a batch
+// are reduced together with one MPI_MAX reduction, negating the minima. The
+// fixed-point sums need the global magnitude of each sum to choose its
+// scale, which is reduced in the same message, so a batch needs at most two
+// messages whatever the method.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Reductions.h"
+#include "DataTypes.h"
+#include "Error.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Translates an input string for the sum method to the enum
+
+SumMethod getSumMethodFromStr(const std::string &InMethod) {
+
+   if (InMethod == "Native")
+      return SumMethodNative;
+   if (InMethod == "Compensated")
+      return SumMethodCompensated;
+   if (InMethod == "FixedPoint")
+      return SumMethodFixedPoint;
+
+   return SumMethodUnknown;
+
+} // end getSumMethodFromStr
+
+//------------------------------------------------------------------------------
+// Converts a fixed-point sum back to floating point. The carries are first
+// propagated so that every limb below the first holds at most LimbBits bits
+// and the limbs are then added from the least significant, so the result
+// only depends on the integer limbs.
+
+R8 FixedPoint::toR8(R8 Scale) const {
+
+   const I8 LimbBase = I8(1) << LimbBits;
+
+   I8 Carried[NLimbs];
+   for (int I = 0; I < NLimbs; ++I)
+      Carried[I] = Limb[I];
+   for (int I = NLimbs - 1; I > 0; --I) {
+      const I8 Carry = Carried[I] / LimbBase;
+      Carried[I] -= Carry * LimbBase;
+      Carried[I - 1] += Carry;
+   }
+
+   R8 Result = 0;
+   for (int I = NLimbs - 1; I >= 0; --I)
+      Result = (Result + static_cast<R8>(Carried[I])) / LimbScale;
+
+   return Result / Scale;
+
+} // end FixedPoint::toR8
+
+//------------------------------------------------------------------------------
+// MPI reduction operator that adds double-double values with the same
+// algorithm as the local sums
+
+static void sumDoubleDouble(void *InBuf,           // [in] values to add
+                            void *InOutBuf,        // [inout] running sums
+                            int *Len,              // [in] number of values
+                            MPI_Datatype *DataType // [in] unused
+) {
+   const auto *In = static_cast<const DoubleDouble *>(InBuf);
+   auto *InOut    = static_cast<DoubleDouble *>(InOutBuf);
+   for (int I = 0; I < *Len; ++I)
+      InOut[I] += In[I];
+}
+
+//------------------------------------------------------------------------------
+// Creates an empty batch for the tasks of a MachEnv
+
+ReductionBatch::ReductionBatch(const MachEnv *InEnv, // [in] MachEnv for tasks
+                               SumMethod InMethod    // [in] method for sums
+) {
+   Comm   = InEnv->getComm();
+   Method = InMethod;
+   if (Method == SumMethodUnknown)
+      ABORT_ERROR("ReductionBatch: unknown sum method");
+}
+
+//------------------------------------------------------------------------------
+// Adds a reduction to the batch and returns its handle
+
+I4 ReductionBatch::addTerm(ReductionKind Kind,
+                           std::unique_ptr<ReductionTerm> &&Term) {
+   Terms.push_back(std::move(Term));
+   Kinds.push_back(Kind);
+   Results.push_back(0);
+   return Terms.size() - 1;
+}
+
+//------------------------------------------------------------------------------
+// Convenience interfaces for common array reductions over owned entries
+
+I4 ReductionBatch::addSum(const Array1DReal &Array, I4 NOwned) {
+   return addSum(
+       "globalSum1D", NOwned, 1,
+       KOKKOS_LAMBDA(int I, int) { return R8(Array(I)); });
+}
+
+I4 ReductionBatch::addSum(const Array2DReal &Array, I4 NOwned) {
+   return addSum(
+       "globalSum2D", NOwned, Array.extent_int(1),
+       KOKKOS_LAMBDA(int I, int K) { return R8(Array(I, K)); });
+}
+
+I4 ReductionBatch::addSum(const Array2DReal &Array, const Array1DReal &Weight,
+                          I4 NOwned) {
+   return addSum(
+       "globalSumWeighted", NOwned, Array.extent_int(1),
+       KOKKOS_LAMBDA(int I, int K) { return R8(Array(I, K)) * R8(Weight(I)); });
+}
+
+I4 ReductionBatch::addSum(const Array2DReal &Array1,
+                          const Array2DReal &Array2, I4 NOwned) {
+   return addSum(
+       "globalSumProduct", NOwned, Array1.extent_int(1),
+       KOKKOS_LAMBDA(int I, int K) {
+          return R8(Array1(I, K)) * R8(Array2(I, K));
+       });
+}
+
+I4 ReductionBatch::addMin(const Array2DReal &Array, I4 NOwned) {
+   return addMin(
+       "globalMin2D", NOwned, Array.extent_int(1),
+       KOKKOS_LAMBDA(int I, int K) { return R8(Array(I, K)); });
+}
+
+I4 ReductionBatch::addMax(const Array2DReal &Array, I4 NOwned) {
+   return addMax(
+       "globalMax2D", NOwned, Array.extent_int(1),
+       KOKKOS_LAMBDA(int I, int K) { return R8(Array(I, K)); });
+}
+
+//------------------------------------------------------------------------------
+// Computes all reductions in the batch
+
+I4 ReductionBatch::reduce() {
+
+   I4 Err       = 0;
+   I4 NTerms    = Terms.size();
+   bool IsFixed = Method == SumMethodFixedPoint;
+
+   // Local maxima of the maxima, the negated minima and, for fixed-point
+   // sums, the magnitude of the sums, reduced together
+   std::vector<R8> LocalMax;
+   for (int N = 0; N < NTerms; ++N) {
+      if (Kinds[N] == KindMax)
+         LocalMax.push_back(Terms[N]->localMax());
+      else if (Kinds[N] == KindMin)
+         LocalMax.push_back(-Terms[N]->localMin());
+      else if (IsFixed)
+         LocalMax.push_back(Terms[N]->localMaxAbs());
+   }
+
+   I4 NMax = LocalMax.size();
+   std::vector<R8> GlobalMax(NMax);
+   if (NMax > 0) {
+      Err = MPI_Allreduce(LocalMax.data(), GlobalMax.data(), NMax, MPI_DOUBLE,
+                          MPI_MAX, Comm);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("ReductionBatch: error in MPI_Allreduce of maxima");
+         return Err;
+      }
+   }
+
+   // Scale of each fixed-point sum, a power of two above its largest value.
+   // Sums of infinite values have no fixed-point representation.
+   std::vector<R8> Scale(NTerms, 1.0);
+   std::vector<bool> Finite(NTerms, true);
+   I4 IMax = 0;
+   for (int N = 0; N < NTerms; ++N) {
+      if (Kinds[N] == KindMax) {
+         Results[N] = GlobalMax[IMax++];
+      } else if (Kinds[N] == KindMin) {
+         Results[N] = -GlobalMax[IMax++];
+      } else if (IsFixed) {
+         const R8 MaxAbs = GlobalMax[IMax++];
+         Finite[N]       = std::isfinite(MaxAbs);
+         int Exponent    = 0;
+         if (Finite[N])
+            std::frexp(MaxAbs, &Exponent);
+         Scale[N] = std::ldexp(1.0, -Exponent);
+      }
+   }
+
+   // Local sums packed into a single buffer for each method
+   std::vector<I4> SumTerms;
+   for (int N = 0; N < NTerms; ++N) {
+      if (Kinds[N] == KindSum)
+         SumTerms.push_back(N);
+   }
+   I4 NSums = SumTerms.size();
+   if (NSums == 0)
+      return 0;
+
+   switch (Method) {
+
+   case SumMethodNative: {
+      std::vector<R8> LocalSum(NSums);
+      std::vector<R8> GlobalSum(NSums);
+      for (int S = 0; S < NSums; ++S)
+         LocalSum[S] = Terms[SumTerms[S]]->localSum();
+      Err = MPI_Allreduce(LocalSum.data(), GlobalSum.data(), NSums,
+                          MPI_DOUBLE, MPI_SUM, Comm);
+      for (int S = 0; S < NSums; ++S)
+         Results[SumTerms[S]] = GlobalSum[S];
+      break;
+   }
+
+   case SumMethodCompensated: {
+      std::vector<DoubleDouble> LocalSum(NSums);
+      std::vector<DoubleDouble> GlobalSum(NSums);
+      for (int S = 0; S < NSums; ++S)
+         LocalSum[S] = Terms[SumTerms[S]]->localSumCompensated();
+
+      MPI_Datatype DDType;
+      MPI_Op DDSum;
+      MPI_Type_contiguous(2, MPI_DOUBLE, &DDType);
+      MPI_Type_commit(&DDType);
+      MPI_Op_create(&sumDoubleDouble, 1, &DDSum);
+      Err = MPI_Allreduce(LocalSum.data(), GlobalSum.data(), NSums, DDType,
+                          DDSum, Comm);
+      MPI_Op_free(&DDSum);
+      MPI_Type_free(&DDType);
+
+      for (int S = 0; S < NSums; ++S)
+         Results[SumTerms[S]] = GlobalSum[S].Hi + GlobalSum[S].Lo;
+      break;
+   }
+
+   case SumMethodFixedPoint: {
+      const I4 NLimbs = FixedPoint::NLimbs;
+      std::vector<I8> LocalSum(NSums * NLimbs);
+      std::vector<I8> GlobalSum(NSums * NLimbs);
+      for (int S = 0; S < NSums; ++S) {
+         const I4 N = SumTerms[S];
+         FixedPoint Sum;
+         if (Finite[N])
+            Sum = Terms[N]->localSumFixed(Scale[N]);
+         for (int L = 0; L < NLimbs; ++L)
+            LocalSum[S * NLimbs + L] = Sum.Limb[L];
+      }
+      Err = MPI_Allreduce(LocalSum.data(), GlobalSum.data(), NSums * NLimbs,
+                          MPI_INT64_T, MPI_SUM, Comm);
+      for (int S = 0; S < NSums; ++S) {
+         const I4 N = SumTerms[S];
+         FixedPoint Sum;
+         for (int L = 0; L < NLimbs; ++L)
+            Sum.Limb[L] = GlobalSum[S * NLimbs + L];
+         Results[N] = Finite[N] ? Sum.toR8(Scale[N])
+                                : std::numeric_limits<R8>::quiet_NaN();
+      }
+      break;
+   }
+
+   default:
+      LOG_ERROR("ReductionBatch: unknown sum method");
+      return 1;
+   }
+
+   if (Err != MPI_SUCCESS)
+      LOG_ERROR("ReductionBatch: error in MPI_Allreduce of sums");
+
+   return Err;
+
+} // end reduce
+
+//------------------------------------------------------------------------------
+// Retrieval functions
+
+R8 ReductionBatch::getResult(I4 Handle) const {
+   if (Handle < 0 or Handle >= static_cast<I4>(Results.size()))
+      ABORT_ERROR("ReductionBatch: invalid reduction handle {}", Handle);
+   return Results[Handle];
+}
+
+I4 ReductionBatch::getNumReductions() const { return Terms.size(); }
+
+SumMethod ReductionBatch::getSumMethod() const { return Method; }
+
+//------------------------------------------------------------------------------
+// Single-array global sums
+
+R8 globalSum(const Array1DReal &Array, I4 NOwned, const MachEnv *InEnv,
+             SumMethod Method) {
+   ReductionBatch Batch(InEnv, Method);
+   I4 Handle = Batch.addSum(Array, NOwned);
+   I4 Err    = Batch.reduce();
+   if (Err != 0)
+      ABORT_ERROR("globalSum: error computing global sum");
+   return Batch.getResult(Handle);
+}
+
+R8 globalSum(const Array2DReal &Array, I4 NOwned, const MachEnv *InEnv,
+             SumMethod Method) {
+   ReductionBatch Batch(InEnv, Method);
+   I4 Handle = Batch.addSum(Array, NOwned);
+   I4 Err    = Batch.reduce();
+   if (Err != 0)
+      ABORT_ERROR("globalSum: error computing global sum");
+   return Batch.getResult(Handle);
+}
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
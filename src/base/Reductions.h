@@ -0,0 +1,360 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_REDUCTIONS_H
+#define OMEGA_REDUCTIONS_H
+//===-- base/Reductions.h - batched global reductions -----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines global sums, minima and maxima of distributed arrays
+///
+/// A ReductionBatch collects a number of scalar reductions (sums, minima and
+/// maxima) of distributed arrays or expressions over the owned cells, edges
+/// or vertices of each task. The local part of each reduction is computed on
+/// the device with a Kokkos parallel reduction and the local results of all
+/// the reductions in the batch are combined across tasks with a single
+/// MPI_Allreduce for the sums and one for the minima and maxima, so that
+/// diagnostics like conservation checks do not pay the message latency for
+/// every quantity. Sums can use native double-precision additions, the
+/// compensated double-double (DDPDD) algorithm that is nearly independent of
+/// the order of the additions, or integer (fixed-point) accumulators that
+/// give bit-for-bit identical sums for any number of tasks and threads.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Supported algorithms for global sums
+enum SumMethod {
+   SumMethodUnknown,     ///< Unknown or undefined method
+   SumMethodNative,      ///< Double-precision sums in any order (fastest)
+   SumMethodCompensated, ///< Double-double (DDPDD) compensated sums
+   SumMethodFixedPoint   ///< Integer accumulators, bit-for-bit reproducible
+};
+
+/// Translates an input string for the sum method option to the
+/// enum for later use
+SumMethod getSumMethodFromStr(const std::string &InMethod ///< [in] method
+);
+
+/// Double-double accumulator for compensated sums. Two values are added
+/// with the DDPDD algorithm of He and Ding (2001, J. Supercomputing, 18,
+/// 259), which keeps the rounding error of the leading part in the low part.
+struct DoubleDouble {
+   R8 Hi; ///< leading part of the value
+   R8 Lo; ///< rounding error of the leading part
+
+   KOKKOS_INLINE_FUNCTION DoubleDouble() : Hi(0), Lo(0) {}
+   KOKKOS_INLINE_FUNCTION DoubleDouble(R8 Val) : Hi(Val), Lo(0) {}
+
+   KOKKOS_INLINE_FUNCTION DoubleDouble &operator+=(const DoubleDouble &Rhs) {
+      const R8 Sum = Hi + Rhs.Hi;
+      const R8 Err = Sum - Hi;
+      const R8 Low = ((Rhs.Hi - Err) + (Hi - (Sum - Err))) + Lo + Rhs.Lo;
+      Hi           = Sum + Low;
+      Lo           = Low - (Hi - Sum);
+      return *this;
+   }
+};
+
+/// Fixed-point accumulator for reproducible sums. A value is scaled by a
+/// power of two so that its magnitude is below one and is then split into
+/// NLimbs integers of LimbBits bits each, from the most to the least
+/// significant. Integer additions are exact and associative, so the sum of
+/// the limbs does not depend on the order of the additions. Bits below the
+/// last limb are truncated from each value before it is added, which also
+/// does not depend on the order. At most 2^31 values can be added before
+/// the limbs may overflow.
+struct FixedPoint {
+   static constexpr int NLimbs   = 4;  ///< number of integer limbs
+   static constexpr int LimbBits = 32; ///< bits of the value in each limb
+   static constexpr R8 LimbScale = 4294967296.0; ///< 2^LimbBits
+
+   I8 Limb[NLimbs]; ///< integer limbs, most significant first
+
+   KOKKOS_INLINE_FUNCTION FixedPoint() {
+      for (int I = 0; I < NLimbs; ++I)
+         Limb[I] = 0;
+   }
+
+   /// Converts a value for which Val*Scale has a magnitude below one. Scale
+   /// must be a power of two so that the scaling is exact.
+   KOKKOS_INLINE_FUNCTION FixedPoint(R8 Val, R8 Scale) {
+      R8 Frac = Val * Scale;
+      for (int I = 0; I < NLimbs; ++I) {
+         Frac *= LimbScale;
+         Limb[I] = static_cast<I8>(Frac); // truncates toward zero
+         Frac -= static_cast<R8>(Limb[I]);
+      }
+   }
+
+   KOKKOS_INLINE_FUNCTION FixedPoint &operator+=(const FixedPoint &Rhs) {
+      for (int I = 0; I < NLimbs; ++I)
+         Limb[I] += Rhs.Limb[I];
+      return *this;
+   }
+
+   /// Converts the accumulated sum back to a floating-point value, undoing
+   /// the Scale used to convert the values
+   R8 toR8(R8 Scale) const;
+};
+
+} // namespace OMEGA
+
+// Identity values that allow the accumulators to be used with the
+// Kokkos::Sum reducer
+namespace Kokkos {
+template <> struct reduction_identity<OMEGA::DoubleDouble> {
+   KOKKOS_FORCEINLINE_FUNCTION static OMEGA::DoubleDouble sum() {
+      return OMEGA::DoubleDouble();
+   }
+};
+template <> struct reduction_identity<OMEGA::FixedPoint> {
+   KOKKOS_FORCEINLINE_FUNCTION static OMEGA::FixedPoint sum() {
+      return OMEGA::FixedPoint();
+   }
+};
+} // namespace Kokkos
+
+namespace OMEGA {
+
+/// Base class for a reduction in a batch. Each reduction is an expression
+/// evaluated at every point of a 2D index range (for example owned cells
+/// and vertical levels) and computes its local results on this task.
+class ReductionTerm {
+ public:
+   virtual ~ReductionTerm() = default;
+
+   virtual R8 localSum() const                      = 0; ///< native sum
+   virtual DoubleDouble localSumCompensated() const = 0; ///< DDPDD sum
+   virtual FixedPoint localSumFixed(R8 Scale) const = 0; ///< fixed-point sum
+   virtual R8 localMin() const                      = 0; ///< minimum value
+   virtual R8 localMax() const                      = 0; ///< maximum value
+   virtual R8 localMaxAbs() const                   = 0; ///< max magnitude
+};
+
+/// A reduction of an expression Func(I, K) over 0 <= I < N1, 0 <= K < N2.
+/// The expression is copied to the device, so it must be a KOKKOS_LAMBDA or
+/// functor that captures arrays by value.
+template <class F> class ReductionTermImpl : public ReductionTerm {
+ public:
+   ReductionTermImpl(const std::string &InLabel, ///< [in] kernel label
+                     I4 InN1,                    ///< [in] first extent
+                     I4 InN2,                    ///< [in] second extent
+                     const F &InFunc             ///< [in] expression
+                     )
+       : Label(InLabel), N1(InN1), N2(InN2), Func(InFunc) {}
+
+   R8 localSum() const override {
+      const F LocFunc = Func;
+      R8 Sum          = 0;
+      parallelReduce(
+          Label, {N1, N2},
+          KOKKOS_LAMBDA(int I, int K, R8 &Accum) { Accum += LocFunc(I, K); },
+          Kokkos::Sum<R8>(Sum));
+      return Sum;
+   }
+
+   DoubleDouble localSumCompensated() const override {
+      const F LocFunc = Func;
+      DoubleDouble Sum;
+      parallelReduce(
+          Label, {N1, N2},
+          KOKKOS_LAMBDA(int I, int K, DoubleDouble &Accum) {
+             Accum += DoubleDouble(LocFunc(I, K));
+          },
+          Kokkos::Sum<DoubleDouble>(Sum));
+      return Sum;
+   }
+
+   FixedPoint localSumFixed(R8 Scale) const override {
+      const F LocFunc = Func;
+      FixedPoint Sum;
+      parallelReduce(
+          Label, {N1, N2},
+          KOKKOS_LAMBDA(int I, int K, FixedPoint &Accum) {
+             Accum += FixedPoint(LocFunc(I, K), Scale);
+          },
+          Kokkos::Sum<FixedPoint>(Sum));
+      return Sum;
+   }
+
+   R8 localMin() const override {
+      const F LocFunc = Func;
+      R8 Min;
+      parallelReduce(
+          Label, {N1, N2},
+          KOKKOS_LAMBDA(int I, int K, R8 &Accum) {
+             Accum = Kokkos::min(Accum, R8(LocFunc(I, K)));
+          },
+          Kokkos::Min<R8>(Min));
+      return Min;
+   }
+
+   R8 localMax() const override {
+      const F LocFunc = Func;
+      R8 Max;
+      parallelReduce(
+          Label, {N1, N2},
+          KOKKOS_LAMBDA(int I, int K, R8 &Accum) {
+             Accum = Kokkos::max(Accum, R8(LocFunc(I, K)));
+          },
+          Kokkos::Max<R8>(Max));
+      return Max;
+   }
+
+   R8 localMaxAbs() const override {
+      const F LocFunc = Func;
+      R8 Max          = 0;
+      parallelReduce(
+          Label, {N1, N2},
+          KOKKOS_LAMBDA(int I, int K, R8 &Accum) {
+             Accum = Kokkos::max(Accum, Kokkos::fabs(R8(LocFunc(I, K))));
+          },
+          Kokkos::Max<R8>(Max));
+      return Max;
+   }
+
+ private:
+   std::string Label; ///< label of the reduction kernels
+   I4 N1;             ///< extent of the first index
+   I4 N2;             ///< extent of the second index
+   F Func;            ///< expression to reduce
+};
+
+/// A batch of global reductions that are combined across the tasks of a
+/// MachEnv with as few messages as possible. Reductions are added once, each
+/// returning a handle, and the batch can then be reduced repeatedly (for
+/// example every time step) since the expressions and arrays are kept by
+/// reference. Only the tasks of the MachEnv may use the batch.
+class ReductionBatch {
+ public:
+   /// Creates an empty batch of reductions across the tasks of a MachEnv
+   ReductionBatch(const MachEnv *InEnv = MachEnv::getDefault(), ///< [in] env
+                  SumMethod InMethod   = SumMethodFixedPoint ///< [in] sums
+   );
+
+   /// Adds the global sum of an expression Func(I, K) over the index range
+   /// 0 <= I < N1, 0 <= K < N2 and returns its handle
+   template <class F>
+   I4 addSum(const std::string &Label, ///< [in] label for the kernels
+             I4 N1,                    ///< [in] first extent (eg NCellsOwned)
+             I4 N2,                    ///< [in] second extent (eg levels)
+             const F &Func             ///< [in] expression to sum
+   ) {
+      return addTerm(KindSum, std::make_unique<ReductionTermImpl<F>>(
+                                  Label, N1, N2, Func));
+   }
+
+   /// Adds the global minimum of an expression and returns its handle
+   template <class F>
+   I4 addMin(const std::string &Label, ///< [in] label for the kernels
+             I4 N1,                    ///< [in] first extent (eg NCellsOwned)
+             I4 N2,                    ///< [in] second extent (eg levels)
+             const F &Func             ///< [in] expression to minimize
+   ) {
+      return addTerm(KindMin, std::make_unique<ReductionTermImpl<F>>(
+                                  Label, N1, N2, Func));
+   }
+
+   /// Adds the global maximum of an expression and returns its handle
+   template <class F>
+   I4 addMax(const std::string &Label, ///< [in] label for the kernels
+             I4 N1,                    ///< [in] first extent (eg NCellsOwned)
+             I4 N2,                    ///< [in] second extent (eg levels)
+             const F &Func             ///< [in] expression to maximize
+   ) {
+      return addTerm(KindMax, std::make_unique<ReductionTermImpl<F>>(
+                                  Label, N1, N2, Func));
+   }
+
+   /// Adds the global sum of the first NOwned entries of an array
+   I4 addSum(const Array1DReal &Array, ///< [in] array to sum
+             I4 NOwned                 ///< [in] number of owned entries
+   );
+
+   /// Adds the global sum over the first NOwned rows of a 2D array
+   I4 addSum(const Array2DReal &Array, ///< [in] array to sum
+             I4 NOwned                 ///< [in] number of owned rows
+   );
+
+   /// Adds the global sum of Array(I,K)*Weight(I) over the first NOwned
+   /// rows, for example a quantity times the cell area
+   I4 addSum(const Array2DReal &Array,  ///< [in] array to sum
+             const Array1DReal &Weight, ///< [in] weight of each row
+             I4 NOwned                  ///< [in] number of owned rows
+   );
+
+   /// Adds the global sum of Array1(I,K)*Array2(I,K) over the first NOwned
+   /// rows, for example a quantity times a mask or a layer thickness
+   I4 addSum(const Array2DReal &Array1, ///< [in] first array of product
+             const Array2DReal &Array2, ///< [in] second array of product
+             I4 NOwned                  ///< [in] number of owned rows
+   );
+
+   /// Adds the global minimum over the first NOwned rows of a 2D array
+   I4 addMin(const Array2DReal &Array, ///< [in] array to minimize
+             I4 NOwned                 ///< [in] number of owned rows
+   );
+
+   /// Adds the global maximum over the first NOwned rows of a 2D array
+   I4 addMax(const Array2DReal &Array, ///< [in] array to maximize
+             I4 NOwned                 ///< [in] number of owned rows
+   );
+
+   /// Computes all reductions in the batch. Must be called by all tasks of
+   /// the MachEnv. Returns 0 on success.
+   I4 reduce();
+
+   /// Returns the result of a reduction from the last call to reduce
+   R8 getResult(I4 Handle ///< [in] handle returned when it was added
+   ) const;
+
+   /// Returns the number of reductions in the batch
+   I4 getNumReductions() const;
+
+   /// Returns the method used for the sums
+   SumMethod getSumMethod() const;
+
+ private:
+   /// Kind of each reduction
+   enum ReductionKind { KindSum, KindMin, KindMax };
+
+   /// Adds a reduction to the batch and returns its handle
+   I4 addTerm(ReductionKind Kind, std::unique_ptr<ReductionTerm> &&Term);
+
+   MPI_Comm Comm;    ///< communicator of the tasks in the MachEnv
+   SumMethod Method; ///< method used for the sums
+
+   std::vector<std::unique_ptr<ReductionTerm>> Terms; ///< all reductions
+   std::vector<ReductionKind> Kinds; ///< kind of each reduction
+   std::vector<R8> Results;          ///< results of the last reduce
+};
+
+/// Computes the global sum of the first NOwned entries of an array
+R8 globalSum(const Array1DReal &Array, ///< [in] array to sum
+             I4 NOwned,                ///< [in] number of owned entries
+             const MachEnv *InEnv = MachEnv::getDefault(), ///< [in] env
+             SumMethod Method     = SumMethodFixedPoint    ///< [in] method
+);
+
+/// Computes the global sum over the first NOwned rows of a 2D array
+R8 globalSum(const Array2DReal &Array, ///< [in] array to sum
+             I4 NOwned,                ///< [in] number of owned rows
+             const MachEnv *InEnv = MachEnv::getDefault(), ///< [in] env
+             SumMethod Method     = SumMethodFixedPoint    ///< [in] method
+);
+
+} // namespace OMEGA
+#endif
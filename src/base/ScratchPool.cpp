@@ -0,0 +1,129 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- base/ScratchPool.cpp - pool of reusable scratch arrays --*- C++ -*-===//
+//
+// Keeps the statistics of the scratch array pools and reports and frees
+// them at the end of the run.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ScratchPool.h"
+#include "Logging.h"
+#include "MachEnv.h"
+
+#include "mpi.h"
+
+namespace OMEGA {
+
+// create the static class members
+I8 ScratchPool::DeviceBytes     = 0;
+I8 ScratchPool::HostBytes       = 0;
+I8 ScratchPool::DevicePeakBytes = 0;
+I8 ScratchPool::HostPeakBytes   = 0;
+I8 ScratchPool::NDeviceArrays   = 0;
+I8 ScratchPool::NHostArrays     = 0;
+I8 ScratchPool::NDevicePeak     = 0;
+I8 ScratchPool::NHostPeak       = 0;
+I8 ScratchPool::NReused         = 0;
+std::vector<std::function<void()>> ScratchPool::Clearers;
+
+//------------------------------------------------------------------------------
+// Record a new allocation in the statistics of its pool
+void ScratchPool::addAllocation(bool OnHost, I8 Bytes) {
+   if (OnHost) {
+      HostBytes += Bytes;
+      ++NHostArrays;
+      if (HostBytes > HostPeakBytes) {
+         HostPeakBytes = HostBytes;
+         NHostPeak     = NHostArrays;
+      }
+   } else {
+      DeviceBytes += Bytes;
+      ++NDeviceArrays;
+      if (DeviceBytes > DevicePeakBytes) {
+         DevicePeakBytes = DeviceBytes;
+         NDevicePeak     = NDeviceArrays;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Remove a freed allocation from the statistics of its pool. The peaks are
+// kept.
+void ScratchPool::removeAllocation(bool OnHost, I8 Bytes) {
+   if (OnHost) {
+      HostBytes -= Bytes;
+      --NHostArrays;
+   } else {
+      DeviceBytes -= Bytes;
+      --NDeviceArrays;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Write the peak sizes and reuse counts of the pools to the log
+void ScratchPool::report() {
+
+   MachEnv *DefEnv = MachEnv::getDefault();
+
+   I8 Stats[5] = {DevicePeakBytes, HostPeakBytes, NDevicePeak, NHostPeak,
+                  NReused};
+   MPI_Allreduce(MPI_IN_PLACE, Stats, 5, MPI_INT64_T, MPI_MAX,
+                 DefEnv->getComm());
+
+   const R8 MiB = 1024.0 * 1024.0;
+   LOG_INFO("ScratchPool: device peak {:.2f} MiB in {} arrays "
+            "(max over tasks)",
+            Stats[0] / MiB, Stats[2]);
+   LOG_INFO("ScratchPool: host peak {:.2f} MiB in {} arrays "
+            "(max over tasks)",
+            Stats[1] / MiB, Stats[3]);
+   LOG_INFO("ScratchPool: {} requests served from the pool (max over tasks)",
+            Stats[4]);
+
+} // end report
+
+//------------------------------------------------------------------------------
+// Free all pooled arrays and reset the statistics
+void ScratchPool::clear() {
+
+   for (auto &Clear : Clearers)
+      Clear();
+
+   DeviceBytes     = 0;
+   HostBytes       = 0;
+   DevicePeakBytes = 0;
+   HostPeakBytes   = 0;
+   NDeviceArrays   = 0;
+   NHostArrays     = 0;
+   NDevicePeak     = 0;
+   NHostPeak       = 0;
+   NReused         = 0;
+}
+
+//------------------------------------------------------------------------------
+// Return the bytes held by the device pool
+I8 ScratchPool::getDeviceBytes() { return DeviceBytes; }
+
+//------------------------------------------------------------------------------
+// Return the bytes held by the host pool
+I8 ScratchPool::getHostBytes() { return HostBytes; }
+
+//------------------------------------------------------------------------------
+// Return the peak of the bytes held by the device pool
+I8 ScratchPool::getDevicePeakBytes() { return DevicePeakBytes; }
+
+//------------------------------------------------------------------------------
+// Return the peak of the bytes held by the host pool
+I8 ScratchPool::getHostPeakBytes() { return HostPeakBytes; }
+
+//------------------------------------------------------------------------------
+// Return the number of requests served by reusing a pooled array
+I8 ScratchPool::getNumReused() { return NReused; }
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,196 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_SCRATCHPOOL_H
+#define OMEGA_SCRATCHPOOL_H
+//===-- base/ScratchPool.h - pool of reusable scratch arrays ----*- C++ -*-===//
+//
+/// \file
+/// \brief Provides a pool of scratch arrays that are reused between calls
+///
+/// Code paths that run every time step and need temporary arrays would
+/// otherwise allocate and free them on every call. On GPUs each device
+/// allocation is a synchronizing cudaMalloc or hipMalloc that causes latency
+/// spikes and fragments the device memory. The ScratchPool keeps the arrays
+/// it hands out. An array is free again once the caller has dropped all its
+/// copies, which is detected with the Kokkos reference count, so callers
+/// simply let their copy go out of scope. A later request for an array of
+/// the same type and extents gets the free array back instead of a new
+/// allocation. Rank-1 arrays are matched on capacity instead: the request
+/// gets the leading entries of any free array that is long enough, and a
+/// new allocation frees the shorter free arrays of its type, so buffers
+/// that are grown over the run do not pile up in the pool.
+///
+/// Kernels launched asynchronously may still use an array after the last
+/// host copy is dropped. Each array remembers the execution space instance
+/// it was requested for, and is fenced on that instance before it is handed
+/// to a request on another instance. Requests on the same instance are
+/// ordered by the instance itself.
+///
+/// Device and host arrays are kept in separate pools by their memory space.
+/// The contents of an array from the pool are undefined. report writes the
+/// peak of the bytes held by each pool to the log at the end of the run.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Pool of reusable scratch arrays
+class ScratchPool {
+ public:
+   /// Returns a free array of type ViewType with the given extents for use
+   /// by kernels on the execution space instance Space, allocating a new
+   /// one with the label Label if there is none. The array returns to the
+   /// pool when all copies of it are dropped.
+   template <class ViewType, class... ExtentTypes>
+   static ViewType get(const ExecSpace &Space,    ///< [in] instance of use
+                       const std::string &Label, ///< [in] label if allocated
+                       ExtentTypes... Extents    ///< [in] array extents
+   ) {
+      static_assert(sizeof...(ExtentTypes) == ViewType::rank,
+                    "ScratchPool::get needs one extent per array dimension");
+
+      const size_t Dims[]                = {static_cast<size_t>(Extents)...};
+      std::vector<Entry<ViewType>> &Pool = entries<ViewType>();
+      constexpr bool ByCapacity          = ViewType::rank == 1;
+
+      // An array only referenced by the pool is free. The shortest free
+      // array that is long enough serves a rank-1 request.
+      Entry<ViewType> *Found = nullptr;
+      for (Entry<ViewType> &Pooled : Pool) {
+         if (Pooled.Array.use_count() != 1)
+            continue;
+         bool Fits = true;
+         for (int Dim = 0; Dim < ViewType::rank; ++Dim)
+            Fits = Fits && (ByCapacity ? Pooled.Array.extent(Dim) >= Dims[Dim]
+                                       : Pooled.Array.extent(Dim) == Dims[Dim]);
+         if (Fits and (Found == nullptr or
+                       Pooled.Array.span() < Found->Array.span()))
+            Found = &Pooled;
+      }
+
+      if (Found != nullptr) {
+         if (!(Found->Space == Space))
+            Found->Space.fence("ScratchPool: reuse on another instance");
+         Found->Space = Space;
+         ++NReused;
+         if constexpr (ByCapacity)
+            return Kokkos::subview(Found->Array,
+                                   Kokkos::make_pair(size_t(0), Dims[0]));
+         else
+            return Found->Array;
+      }
+
+      using SpaceType = typename ViewType::memory_space;
+      const bool OnHost =
+          Kokkos::SpaceAccessibility<Kokkos::HostSpace, SpaceType>::accessible;
+      const I8 ValueBytes = sizeof(typename ViewType::value_type);
+
+      // The new array serves every request the shorter free arrays could
+      if constexpr (ByCapacity) {
+         for (auto It = Pool.begin(); It != Pool.end();) {
+            if (It->Array.use_count() == 1 and It->Array.extent(0) < Dims[0]) {
+               removeAllocation(OnHost, It->Array.span() * ValueBytes);
+               It = Pool.erase(It);
+            } else {
+               ++It;
+            }
+         }
+      }
+
+      ViewType Array(Kokkos::view_alloc(Kokkos::WithoutInitializing, Label),
+                     Extents...);
+      Pool.push_back({Array, Space});
+      addAllocation(OnHost, Array.span() * ValueBytes);
+
+      return Array;
+   }
+
+   /// Returns a free array for use by kernels on the default execution
+   /// space instance, as above
+   template <class ViewType, class... ExtentTypes>
+   static ViewType get(const std::string &Label, ///< [in] label if allocated
+                       ExtentTypes... Extents    ///< [in] array extents
+   ) {
+      return get<ViewType>(ExecSpace(), Label, Extents...);
+   }
+
+   /// Writes the peak bytes held by the device and host pools and the
+   /// reuse counts to the log. The maximum over the tasks of the default
+   /// MachEnv is reported.
+   static void report();
+
+   /// Frees all arrays held by the pools. Arrays still in use stay valid
+   /// until their last copy is dropped. Must be called before Kokkos is
+   /// finalized.
+   static void clear();
+
+   /// Returns the bytes held by the device pool
+   static I8 getDeviceBytes();
+
+   /// Returns the bytes held by the host pool
+   static I8 getHostBytes();
+
+   /// Returns the peak of the bytes held by the device pool
+   static I8 getDevicePeakBytes();
+
+   /// Returns the peak of the bytes held by the host pool
+   static I8 getHostPeakBytes();
+
+   /// Returns the number of requests served by reusing a pooled array
+   static I8 getNumReused();
+
+ private:
+   /// A pooled array and the execution space instance it was last
+   /// requested for
+   template <class ViewType> struct Entry {
+      ViewType Array;
+      ExecSpace Space;
+   };
+
+   /// Returns the pooled arrays of a type. The list is created and
+   /// registered for clear on the first request for the type.
+   template <class ViewType> static std::vector<Entry<ViewType>> &entries() {
+      static std::vector<Entry<ViewType>> Pool;
+      static bool Registered = false;
+      if (!Registered) {
+         Clearers.push_back([]() { Pool.clear(); });
+         Registered = true;
+      }
+      return Pool;
+   }
+
+   /// Records a new allocation in the statistics of its pool
+   static void addAllocation(bool OnHost, ///< [in] true for the host pool
+                             I8 Bytes     ///< [in] size of the allocation
+   );
+
+   /// Removes a freed allocation from the statistics of its pool
+   static void removeAllocation(bool OnHost, ///< [in] true for the host pool
+                                I8 Bytes     ///< [in] size of the allocation
+   );
+
+   static I8 DeviceBytes;     ///< Bytes held by the device pool
+   static I8 HostBytes;       ///< Bytes held by the host pool
+   static I8 DevicePeakBytes; ///< Peak bytes held by the device pool
+   static I8 HostPeakBytes;   ///< Peak bytes held by the host pool
+   static I8 NDeviceArrays;   ///< Number of arrays in the device pool
+   static I8 NHostArrays;     ///< Number of arrays in the host pool
+   static I8 NDevicePeak;     ///< Arrays in the device pool at its peak
+   static I8 NHostPeak;       ///< Arrays in the host pool at its peak
+   static I8 NReused;         ///< Requests served by reusing an array
+
+   /// Functions that empty the list of each pooled array type
+   static std::vector<std::function<void()>> Clearers;
+};
+
+} // namespace OMEGA
+#endif
@@ -24,9 +24,12 @@ int main(int argc, char **argv) {
    int ErrAll;
    int ErrCurr;
    int ErrFinalize;
+   int ThreadLevel;
 
-   MPI_Init(&argc, &argv); // initialize MPI
-   Kokkos::initialize();   // initialize Kokkos
+   // Initialize MPI with thread support for asynchronous stream writes.
+   // Streams fall back to synchronous writes if this is not provided.
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &ThreadLevel);
+   Kokkos::initialize(); // initialize Kokkos
    Pacer::initialize(MPI_COMM_WORLD);
    Pacer::setPrefix("Omega:");
 
@@ -26,16 +26,16 @@
 
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 namespace OMEGA {
 
 // Declare some of the Config static variables
-const int Config::ReadGroupSize = 20;
-bool Config::NotInitialized     = true;
-int Config::ReadGroupID         = -1;
-int Config::NumReadGroups       = 0;
+bool Config::NotInitialized = true;
 MPI_Comm Config::ConfigComm;
+MPI_Comm Config::ConfigNodeComm;
+MPI_Comm Config::ConfigLeaderComm = MPI_COMM_NULL;
 Config Config::ConfigAll;
 
 //------------------------------------------------------------------------------
@@ -44,22 +44,15 @@ Config Config::ConfigAll;
 Config::Config(const std::string &InName // [in] name of config, node
 ) {
 
-   // If this is the first Config created, set variables for reading the
-   // input configuration file. In particular, to avoid too many MPI tasks
-   // reading the same input stream, we divide the tasks into groups and
-   // only one group at a time loads the full configuration from a stream
+   // If this is the first Config created, save the communicators used to
+   // distribute the input configuration file. Only one task reads the file
+   // and the text is broadcast over the node layout of the default MachEnv.
 
    if (NotInitialized) {
-      // Determine MPI variables
-      MachEnv *DefEnv = MachEnv::getDefault();
-      I4 NumTasks     = DefEnv->getNumTasks();
-      I4 MyTask       = DefEnv->getMyTask();
-      ConfigComm      = DefEnv->getComm();
-
-      // Set number of groups to read and assign tasks to each
-      // group in a round-robin way
-      NumReadGroups = (NumTasks - 1) / ReadGroupSize + 1;
-      ReadGroupID   = MyTask % NumReadGroups;
+      MachEnv *DefEnv  = MachEnv::getDefault();
+      ConfigComm       = DefEnv->getComm();
+      ConfigNodeComm   = DefEnv->getNodeComm();
+      ConfigLeaderComm = DefEnv->getLeaderComm();
 
       NotInitialized = false; // now initialized for future calls
    }
@@ -83,9 +76,11 @@ Config::Config() {} // end Config constructor
 // Reads the full configuration for omega and stores in it a static
 // YAML node for later use.  The file must be in YAML format and must be in
 // the same directory as the executable, though Unix soft links can be used
-// to point to a file in an alternate location.  The full configuration is
-// only read by the master task.  The accessor functions (get/set) will
-// broadcast or communicate the data as needed to/from other MPI tasks.
+// to point to a file in an alternate location.  The file is only opened by
+// the leader of the first node, which broadcasts the raw text to the other
+// node leaders and then each leader to the tasks on its node. Every task then
+// parses the same text from memory, so the file system sees a single open
+// regardless of the number of tasks.
 
 void Config::readAll(const std::string &ConfigFile // [in] input YAML file
 ) {
@@ -97,18 +92,43 @@ void Config::readAll(const std::string &ConfigFile // [in] input YAML file
    // top-level omega node from the Root.
    ConfigAll.Name = "Omega";
 
-   for (int ReadGroup = 0; ReadGroup < Config::NumReadGroups; ++ReadGroup) {
-
-      // If it is this tasks turn, read the configuration file
-      if (Config::ReadGroupID == ReadGroup) {
-         // Read temporary root node
-         YAML::Node RootNode = YAML::LoadFile(ConfigFile);
-         // Extract Omega node
-         ConfigAll.Node = RootNode["Omega"];
+   // The first node leader (task 0 of the leader communicator) reads the
+   // full file into a string. A negative length signals a failed read.
+   std::string ConfigText;
+   I8 TextLength = 0;
+   int MyLeader  = -1;
+   if (ConfigLeaderComm != MPI_COMM_NULL)
+      MPI_Comm_rank(ConfigLeaderComm, &MyLeader);
+   if (MyLeader == 0) {
+      std::ifstream ConfigStream(ConfigFile, std::ios::in | std::ios::binary);
+      if (ConfigStream) {
+         ConfigText.assign(std::istreambuf_iterator<char>(ConfigStream),
+                           std::istreambuf_iterator<char>());
+         TextLength = ConfigText.size();
+      } else {
+         TextLength = -1;
       }
-      MPI_Barrier(ConfigComm);
    }
 
+   // Broadcast the length and then the text across the node leaders and
+   // then within each node
+   if (ConfigLeaderComm != MPI_COMM_NULL)
+      MPI_Bcast(&TextLength, 1, MPI_INT64_T, 0, ConfigLeaderComm);
+   MPI_Bcast(&TextLength, 1, MPI_INT64_T, 0, ConfigNodeComm);
+   if (TextLength < 0)
+      ABORT_ERROR("Config::readAll: unable to open config file {}",
+                  ConfigFile);
+
+   ConfigText.resize(TextLength);
+   if (ConfigLeaderComm != MPI_COMM_NULL)
+      MPI_Bcast(ConfigText.data(), int(TextLength), MPI_CHAR, 0,
+                ConfigLeaderComm);
+   MPI_Bcast(ConfigText.data(), int(TextLength), MPI_CHAR, 0, ConfigNodeComm);
+
+   // Parse temporary root node from memory and extract Omega node
+   YAML::Node RootNode = YAML::Load(ConfigText);
+   ConfigAll.Node      = RootNode["Omega"];
+
    Pacer::stop("ConfigReadAll");
    return;
 
@@ -48,13 +48,12 @@ class Config {
    /// The YAML node containing the configuration.
    YAML::Node Node;
 
-   /// All MPI tasks must read the initial input file but there may
-   /// be a limit to the number of tasks who can simultaneously read
-   /// so only a subset of tasks reads at the same time
-   static const int ReadGroupSize;
-   static int ReadGroupID;
-   static int NumReadGroups;
+   /// Only one task reads the input file and the text of the file is
+   /// broadcast first across the node leaders and then within each node,
+   /// so every task parses the configuration from memory
    static MPI_Comm ConfigComm;
+   static MPI_Comm ConfigNodeComm;   ///< tasks on the same node
+   static MPI_Comm ConfigLeaderComm; ///< node leaders, null on other tasks
 
    /// We do not use an initialization routine, so we include this
    /// initialization flag so that the first Config constructed will
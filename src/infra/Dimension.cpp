@@ -30,6 +30,7 @@ namespace OMEGA {
 
 // Create static class members that store instantiations of metadata
 std::map<std::string, std::shared_ptr<Dimension>> Dimension::AllDims;
+I8 Dimension::NextID = 0;
 
 //------------------------------------------------------------------------------
 // Creates a distributed dimension given a name, global (unpartitioned)
@@ -70,6 +71,7 @@ std::shared_ptr<Dimension> Dimension::create(
       Dim->LocalLength  = LocalLength;
       Dim->Offset       = Offset;
       Dim->Distributed  = true;
+      Dim->ID           = NextID++;
       AllDims[Name]     = Dim; // add to list of dims
    }
 
@@ -112,6 +114,7 @@ Dimension::create(const std::string &Name, // [in] name of dimension
          NewOffset(I) = I;
       }
       Dim->Offset   = NewOffset;
+      Dim->ID       = NextID++;
       AllDims[Name] = Dim; // add to list of dims
    }
 
@@ -246,6 +249,10 @@ I4 Dimension::getDimLengthLocal(
 // Get global offset for each local address from dim instance
 HostArray1DI4 Dimension::getOffset() const { return Offset; }
 
+//------------------------------------------------------------------------------
+// Get the ID of this instance of the dimension
+I8 Dimension::getID() const { return ID; }
+
 //------------------------------------------------------------------------------
 // Get global offset for each local address given a dim name
 HostArray1DI4
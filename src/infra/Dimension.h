@@ -51,6 +51,13 @@ class Dimension {
    /// This is typically the 0-based global ID (eg CellID - 1).
    HostArray1DI4 Offset;
 
+   /// Number that identifies this instance. A dimension that is destroyed
+   /// and created again with the same name gets a new ID.
+   I8 ID;
+
+   /// ID of the next dimension created
+   static I8 NextID;
+
  public:
    //---------------------------------------------------------------------------
    /// Creates a distributed dimension given a name, global (unpartitioned)
@@ -140,6 +147,12 @@ class Dimension {
    getDimOffset(const std::string &Name ///< [in] name of dimension
    );
 
+   //---------------------------------------------------------------------------
+   /// Get the ID of this instance of the dimension. IDs are never reused,
+   /// so data derived from the offsets (eg IO decompositions) can be keyed
+   /// by the ID and are not reused after the dimension is re-created.
+   I8 getID() const;
+
    //----------------------------------------------------------------------------//
    // Retrieves the total number of currently defined dimensions
    static int getNumDefinedDims();
@@ -43,9 +43,11 @@ void Error::reset() {
 }
 
 //------------------------------------------------------------------------------
-// Aborts the simulation by calling the MPI abort command
+// Aborts the simulation by calling the MPI abort command. Queued log
+// messages are written first so the reason for the abort is not lost.
 void Error::abort() {
    LOG_CRITICAL("Omega aborting");
+   finalizeLogging();
    int ErrCode = static_cast<int>(ErrorCode::Critical);
    int Err     = MPI_Abort(MPI_COMM_WORLD, ErrCode);
 }
@@ -23,15 +23,18 @@
 #include "Dimension.h"
 #include "IO.h"
 #include "Logging.h"
+#include "MemoryRegistry.h"
 #include <iostream>
 #include <map>
 #include <memory>
 #include <set>
+#include <typeinfo>
 
 namespace OMEGA {
 
 // Initialize static variables
 std::map<std::string, std::shared_ptr<Field>> Field::AllFields;
+std::vector<std::shared_ptr<Field>> Field::FieldsByHandle;
 std::map<std::string, std::shared_ptr<FieldGroup>> FieldGroup::AllGroups;
 
 //------------------------------------------------------------------------------
@@ -140,7 +143,7 @@ Field::create(const std::string &FieldName,   // [in] Name of variable/field
    ThisField->RetainPrecision = RetainPrecision;
 
    // Number of dimensions for the field
-   ThisField->NDims = NumDims;
+   ThisField->Info.NDims = NumDims;
 
    // Dimension names for retrieval of dimension info
    // These must be in the same index order as the stored data
@@ -158,14 +161,17 @@ Field::create(const std::string &FieldName,   // [in] Name of variable/field
 
    // Initialize data info to Unknown - these will be determined when the
    // field data is attached.
-   ThisField->DataType = ArrayDataType::Unknown;
-   ThisField->MemLoc   = ArrayMemLoc::Unknown;
+   ThisField->Info.DataType = ArrayDataType::Unknown;
+   ThisField->Info.MemLoc   = ArrayMemLoc::Unknown;
 
    // Initialize Data pointer as null until data is actually attached.
    ThisField->DataArray = nullptr;
 
+   // Keep a typed copy of the fill value
+   ThisField->cacheFillValue();
+
    // Add to list of fields and return
-   AllFields[FieldName] = ThisField;
+   addField(ThisField);
    return ThisField;
 }
 
@@ -193,18 +199,29 @@ Field::create(const std::string &FieldName // [in] Name of field
    ThisField->FldName = FieldName;
 
    // Number of dimensions is 0 for this field
-   ThisField->NDims = 0;
+   ThisField->Info.NDims = 0;
 
    // Initialize to Unknown or null - no data is attached
-   ThisField->DataType  = ArrayDataType::Unknown;
-   ThisField->MemLoc    = ArrayMemLoc::Unknown;
-   ThisField->DataArray = nullptr;
+   ThisField->Info.DataType = ArrayDataType::Unknown;
+   ThisField->Info.MemLoc   = ArrayMemLoc::Unknown;
+   ThisField->DataArray     = nullptr;
 
    // Add to list of fields and return
-   AllFields[FieldName] = ThisField;
+   addField(ThisField);
    return ThisField;
 }
 
+//------------------------------------------------------------------------------
+// Adds a new field to the name map and assigns the next handle. Handles are
+// the index in the handle list and are never reused, so a handle saved
+// before a field is destroyed cannot refer to a different field.
+void Field::addField(std::shared_ptr<Field> NewField // [in] new field
+) {
+   NewField->Info.Handle = FieldsByHandle.size();
+   FieldsByHandle.push_back(NewField);
+   AllFields[NewField->FldName] = NewField;
+}
+
 //------------------------------------------------------------------------------
 // Removes a single IOField from the list of available fields
 // That process also decrements the reference counters for the
@@ -216,8 +233,10 @@ int Field::destroy(const std::string &FieldName // [in] Name of Field to remove
    // Check that the group exists
    if (exists(FieldName)) {
 
-      // Erase the group from the list of all groups
+      // Erase the field from the list of all fields and its handle entry
+      FieldsByHandle[AllFields[FieldName]->Info.Handle] = nullptr;
       AllFields.erase(FieldName);
+      MemoryRegistry::remove("Field", FieldName);
 
       // Group does not exist, exit with error
    } else {
@@ -233,8 +252,15 @@ int Field::destroy(const std::string &FieldName // [in] Name of Field to remove
 // Removes all Fields. This must be called before exiting environments
 // This removes all fields from the map structure and also
 // decrements the reference counter for the shared pointers,
-// removing them if the count has reached 0.
-void Field::clear() { AllFields.clear(); }
+// removing them if the count has reached 0. The handle entries are only
+// nulled, so handles keep increasing and a handle saved before the clear
+// cannot refer to a field created after it.
+void Field::clear() {
+   AllFields.clear();
+   for (auto &HandleField : FieldsByHandle)
+      HandleField = nullptr;
+   MemoryRegistry::removeModule("Field");
+}
 
 //------------------------------------------------------------------------------
 // Retrieve a field pointer by name
@@ -250,13 +276,51 @@ Field::get(const std::string &FieldName // [in] name of field
    }
 }
 
+//------------------------------------------------------------------------------
+// Retrieve a field pointer by handle
+std::shared_ptr<Field> Field::get(FieldHandle Handle // [in] field handle
+) {
+
+   if (Handle >= 0 and Handle < FieldHandle(FieldsByHandle.size()) and
+       FieldsByHandle[Handle] != nullptr) {
+      return FieldsByHandle[Handle];
+   } else {
+      LOG_ERROR("Unable to retrieve Field with handle {}. Field not found.",
+                Handle);
+      return nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Retrieve the handle of a field by name
+FieldHandle Field::getHandle(const std::string &FieldName // [in] field name
+) {
+
+   auto It = AllFields.find(FieldName);
+   if (It != AllFields.end()) {
+      return It->second->Info.Handle;
+   } else {
+      LOG_ERROR("Unable to retrieve handle for Field {}. Field not found.",
+                FieldName);
+      return InvalidFieldHandle;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Get field handle
+FieldHandle Field::getHandle() const { return Info.Handle; }
+
+//------------------------------------------------------------------------------
+// Get typed field attributes
+const FieldInfo &Field::getInfo() const { return Info; }
+
 //------------------------------------------------------------------------------
 // Get field name
 std::string Field::getName() const { return FldName; }
 
 //------------------------------------------------------------------------------
 // Determine type of a given field from instance
-ArrayDataType Field::getType() const { return DataType; }
+ArrayDataType Field::getType() const { return Info.DataType; }
 
 //------------------------------------------------------------------------------
 // Determine type of a given field by name
@@ -278,7 +342,7 @@ Field::getFieldType(const std::string &FieldName // [in] name of field
 
 //------------------------------------------------------------------------------
 // Determine memory location of data from instance
-ArrayMemLoc Field::getMemoryLocation() const { return MemLoc; }
+ArrayMemLoc Field::getMemoryLocation() const { return Info.MemLoc; }
 
 //------------------------------------------------------------------------------
 // Determine memory location of data by field name
@@ -302,7 +366,7 @@ Field::getFieldMemoryLocation(const std::string &FieldName // [in] name of field
 //------------------------------------------------------------------------------
 // Query whether field is located on host from instance
 bool Field::isOnHost() const {
-   if (MemLoc == ArrayMemLoc::Host or MemLoc == ArrayMemLoc::Both) {
+   if (Info.MemLoc == ArrayMemLoc::Host or Info.MemLoc == ArrayMemLoc::Both) {
       return true;
    } else {
       return false;
@@ -329,7 +393,7 @@ bool Field::isFieldOnHost(const std::string &FieldName // [in] name of field
 
 //------------------------------------------------------------------------------
 // Returns the number of dimensions for the field
-int Field::getNumDims() const { return NDims; }
+int Field::getNumDims() const { return Info.NDims; }
 
 //------------------------------------------------------------------------------
 // Determines whether the field is time dependent and requires the unlimited
@@ -356,8 +420,8 @@ int Field::getDimNames(
    int Err = 0;
 
    // Make sure vector is correct length
-   if (NDims > 0) {
-      Dimensions.resize(NDims);
+   if (Info.NDims > 0) {
+      Dimensions.resize(Info.NDims);
    } else {
       LOG_ERROR("Unable to retrieve dimension names for Field {}. NDims < 1",
                 FldName);
@@ -365,7 +429,7 @@ int Field::getDimNames(
    }
 
    // Fill vector
-   for (int I = 0; I < NDims; ++I) {
+   for (int I = 0; I < Info.NDims; ++I) {
       Dimensions[I] = DimNames[I];
    }
 
@@ -425,6 +489,8 @@ int Field::addMetadata(const std::string &MetaName, // [in] Name of new metadata
 
    } else {
       FieldMeta[MetaName] = Value;
+      if (MetaName == "FillValue" or MetaName == "_FillValue")
+         cacheFillValue();
    }
 
    return RetVal;
@@ -454,6 +520,8 @@ int Field::updateMetadata(const std::string &MetaName, // [in] Name of metadata
 
    if (hasMetadata(MetaName)) {
       FieldMeta[MetaName] = Value;
+      if (MetaName == "FillValue" or MetaName == "_FillValue")
+         cacheFillValue();
 
    } else {
       LOG_ERROR("Failed to update metadata {} for field {} because the field "
@@ -481,6 +549,8 @@ int Field::removeMetadata(
                    FldName);
          RetVal = -2;
       }
+      if (MetaName == "FillValue" or MetaName == "_FillValue")
+         cacheFillValue();
 
    } else {
       LOG_ERROR("Failed to remove metadata {} for the field {}: "
@@ -495,7 +565,44 @@ int Field::removeMetadata(
 
 //----------------------------------------------------------------------------//
 // Removes all defined Metadata
-void Field::removeAllMetadata() { FieldMeta.clear(); }
+void Field::removeAllMetadata() {
+   FieldMeta.clear();
+   cacheFillValue();
+}
+
+//------------------------------------------------------------------------------
+// Keeps a typed copy of the FillValue metadata (or _FillValue if only the CF
+// name is present) for retrieval without a std::any cast
+void Field::cacheFillValue() {
+
+   Info.HasFillValue  = false;
+   Info.FillIsInteger = false;
+   Info.FillValueInt  = 0;
+   Info.FillValueReal = 0;
+
+   auto It = FieldMeta.find("FillValue");
+   if (It == FieldMeta.end())
+      It = FieldMeta.find("_FillValue");
+   if (It == FieldMeta.end())
+      return;
+
+   const std::any &Fill = It->second;
+   Info.HasFillValue    = true;
+   if (Fill.type() == typeid(R8)) {
+      Info.FillValueReal = std::any_cast<R8>(Fill);
+   } else if (Fill.type() == typeid(R4)) {
+      Info.FillValueReal = std::any_cast<R4>(Fill);
+   } else if (Fill.type() == typeid(I4)) {
+      Info.FillIsInteger = true;
+      Info.FillValueInt  = std::any_cast<I4>(Fill);
+   } else if (Fill.type() == typeid(I8)) {
+      Info.FillIsInteger = true;
+      Info.FillValueInt  = std::any_cast<I8>(Fill);
+   } else {
+      // Other types (eg strings) cannot be used as a fill value for data
+      Info.HasFillValue = false;
+   }
+}
 
 //------------------------------------------------------------------------------
 // Retrieves the value of the metadata associated with a given name
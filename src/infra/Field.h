@@ -17,25 +17,54 @@
 /// is also possible to define field groups to provide a shortcut for fields
 /// that are commonly used together. Once a field is defined/created, a data
 /// array can be attached detached or swapped to hold the latest data values
-/// (esp for fields with multiple time levels).
+/// (esp for fields with multiple time levels). Each field is also assigned
+/// an integer FieldHandle when it is created. Code that accesses a field
+/// repeatedly (eg every time step or every write) can retrieve the handle
+/// once and use it to avoid looking up the field by name. The attributes
+/// needed on every read or write are also kept in a typed FieldInfo struct
+/// so they can be retrieved without a metadata lookup or std::any cast.
 ///
 //===----------------------------------------------------------------------===//
 
 #include "DataTypes.h"
 #include "Dimension.h"
 #include "Logging.h"
+#include "MemoryRegistry.h"
 #include "OmegaKokkos.h"
 #include "TimeMgr.h"
 #include <any>
 #include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
 namespace OMEGA {
 
 // Define the metadata data type
 using Metadata = std::map<std::string, std::any>;
 
+/// Integer handle assigned to each field at creation for fast retrieval
+using FieldHandle = I4;
+
+/// Handle value for a field that does not exist
+constexpr FieldHandle InvalidFieldHandle = -1;
+
+/// Typed copies of the field attributes used on every read or write. These
+/// are kept current as the field is created, data is attached and metadata
+/// is updated. The fill value is kept as an integer or a real depending on
+/// the type it was given with, so it can be converted to the type of the
+/// data without a std::any cast.
+struct FieldInfo {
+   FieldHandle Handle     = InvalidFieldHandle;     ///< handle of field
+   ArrayDataType DataType = ArrayDataType::Unknown; ///< type of data
+   ArrayMemLoc MemLoc     = ArrayMemLoc::Unknown;   ///< location of data
+   int NDims              = 0;                      ///< number of dimensions
+   bool HasFillValue      = false; ///< field has a FillValue entry
+   bool FillIsInteger     = false; ///< FillValue was given as an integer
+   I8 FillValueInt        = 0;     ///< FillValue if given as an integer
+   R8 FillValueReal       = 0;     ///< FillValue if given as a real
+};
+
 /// Field name to use for global code metadata
 static const std::string CodeMeta{"code"}; ///< name for code metadata
 /// Field name to use for global simulation metadata
@@ -50,25 +79,24 @@ class Field {
    /// Store and maintain all defined fields
    static std::map<std::string, std::shared_ptr<Field>> AllFields;
 
+   /// All fields indexed by handle. Handles are not reused, even after a
+   /// clear, so the entry of a destroyed field is null.
+   static std::vector<std::shared_ptr<Field>> FieldsByHandle;
+
    /// Field name
    std::string FldName;
 
    /// Metadata (name, value) pairs for descriptive metadata
    Metadata FieldMeta;
 
-   /// Number of dimensions for the field (0 if scalar field or global metadata)
-   int NDims;
+   /// Handle, number of dimensions (0 if scalar field or global metadata),
+   /// data type, data location and fill value of the field
+   FieldInfo Info;
 
    /// Dimension names for retrieval of dimension info
    /// These must be in the same index order as the stored data
    std::vector<std::string> DimNames;
 
-   /// Data type for field data
-   ArrayDataType DataType;
-
-   /// Location of data
-   ArrayMemLoc MemLoc;
-
    /// Flag for whether this is a time-dependent field that needs the
    /// Unlimited time dimension added during IO
    bool TimeDependent;
@@ -86,6 +114,13 @@ class Field {
    /// various types and cast to the appropriate type when needed.
    std::shared_ptr<void> DataArray;
 
+   /// Adds a new field to the lists of fields and assigns its handle
+   static void addField(std::shared_ptr<Field> NewField ///< [in] new field
+   );
+
+   /// Updates the cached fill value after the FillValue metadata changes
+   void cacheFillValue();
+
  public:
    //---------------------------------------------------------------------------
    // Initialization
@@ -156,6 +191,40 @@ class Field {
    get(const std::string &FieldName ///< [in] name of field to retrieve
    );
 
+   //---------------------------------------------------------------------------
+   /// Retrieve pointer to a full field by handle without a name lookup
+   static std::shared_ptr<Field> get(FieldHandle Handle ///< [in] field handle
+   );
+
+   //---------------------------------------------------------------------------
+   /// Returns the handle of a field by name, or InvalidFieldHandle if the
+   /// field does not exist. This is the slow path and should be called once
+   /// with the handle saved for later use.
+   static FieldHandle
+   getHandle(const std::string &FieldName ///< [in] name of field
+   );
+
+   /// Returns the handle of this field
+   FieldHandle getHandle() const;
+
+   /// Returns the typed attributes of this field
+   const FieldInfo &getInfo() const;
+
+   /// Retrieves the fill value converted to the type of the output. Returns
+   /// an error code if the field has no fill value.
+   template <typename T> int getFillValue(T &Value ///< [out] fill value
+   ) const {
+      if (!Info.HasFillValue) {
+         LOG_ERROR("FillValue does not exist for field {}", FldName);
+         return -1;
+      }
+      if (Info.FillIsInteger)
+         Value = static_cast<T>(Info.FillValueInt);
+      else
+         Value = static_cast<T>(Info.FillValueReal);
+      return 0;
+   }
+
    //---------------------------------------------------------------------------
    /// Retrieve field name
    std::string getName() const;
@@ -316,12 +385,29 @@ class Field {
       DataArray = std::make_shared<T>(InDataArray);
 
       // Determine type and location
-      DataType = checkArrayType<T>();
-      MemLoc   = findArrayMemLoc<T>();
+      Info.DataType = checkArrayType<T>();
+      Info.MemLoc   = findArrayMemLoc<T>();
+
+      // Record the array size, replacing any previously attached array
+      MemoryRegistry::add("Field", FldName, InDataArray);
 
       return Err;
    };
 
+   //---------------------------------------------------------------------------
+   /// Attaches an array of data to an existing Field by handle. This is
+   /// the same as attaching by name but without a name lookup, for fields
+   /// whose data is attached often (eg swapped time levels).
+   template <typename T>
+   static int attachFieldData(FieldHandle Handle, ///< [in] handle of Field
+                              const T &InDataArray ///< [in] Array to attach
+   ) {
+      std::shared_ptr<Field> ThisField = get(Handle);
+      if (ThisField == nullptr)
+         return -1;
+      return ThisField->attachData<T>(InDataArray);
+   };
+
    //---------------------------------------------------------------------------
    /// Attaches an array of data to an existing Field by name. If a data array
    /// needs to be updated, calling the attach routine with new data
@@ -410,6 +496,18 @@ class Field {
       return Data;
    };
 
+   //---------------------------------------------------------------------------
+   /// Retrieves Field data array given the field handle, without a name
+   /// lookup. Returns an empty array if the handle is not valid.
+   template <typename T>
+   static T getFieldDataArray(FieldHandle Handle ///< [in] handle of Field
+   ) {
+      std::shared_ptr<Field> ThisField = get(Handle);
+      if (ThisField == nullptr)
+         return T();
+      return ThisField->getDataArray<T>();
+   };
+
    //---------------------------------------------------------------------------
    // Field Group is a friend class so it can access field list
    friend class FieldGroup;
@@ -20,26 +20,37 @@
 #include "Field.h"
 #include "IO.h"
 #include "Logging.h"
+#include "MemoryRegistry.h"
 #include "OmegaKokkos.h"
+#include "ScratchPool.h"
 #include "TimeMgr.h"
+#include "Timing.h"
 #include <algorithm>
 #include <any>
 #include <cctype>
 #include <cmath>
 #include <ctime>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
+#include <unordered_map>
+#include <vector>
 
 namespace OMEGA {
 
 // Create static class members
 std::map<std::string, std::shared_ptr<IOStream>> IOStream::AllStreams;
+std::future<int> IOStream::PendingWrite;
+std::string IOStream::PendingName;
 
 //------------------------------------------------------------------------------
 // Initializes all streams defined in the input configuration file. This
@@ -106,8 +117,28 @@ int IOStream::finalize(
       }
    } // end loop over streams
 
+   // Complete any asynchronous writes before the streams and cached
+   // decompositions are removed
+   if (waitForWrites() != 0)
+      ++Err;
+
    // Remove all streams
    AllStreams.clear();
+   MemoryRegistry::removeModule("IOStream");
+
+   // Destroy all decompositions cached during stream reads and writes
+   int Err1 = IO::clearDecompCache();
+   if (Err1 != 0) {
+      LOG_ERROR("Error destroying cached IO decompositions");
+      ++Err;
+   }
+
+   // Free the IO systems created for writing subfiles
+   Err1 = IO::clearSubfileSystems();
+   if (Err1 != 0) {
+      LOG_ERROR("Error freeing IO systems for subfiles");
+      ++Err;
+   }
 
    return Err;
 
@@ -137,6 +168,7 @@ IOStream::get(const std::string &StreamName ///< [in] name of stream to retrieve
 void IOStream::addField(const std::string &FieldName ///< [in] Name of field
 ) {
    this->Contents.insert(FieldName);
+   this->Validated = false;
 } // End addField
 
 //------------------------------------------------------------------------------
@@ -145,6 +177,7 @@ void IOStream::addField(const std::string &FieldName ///< [in] Name of field
 void IOStream::removeField(const std::string &FieldName ///< [in] Name of field
 ) {
    this->Contents.erase(FieldName);
+   this->Validated = false;
 } // End removeField
 
 //------------------------------------------------------------------------------
@@ -188,7 +221,9 @@ bool IOStream::validate() {
    }
 
    // Loop through all the field names in Contents and check whether they
-   // have been defined as a Field
+   // have been defined as a Field, saving the handle of each field
+   ContentHandles.clear();
+   TimeHandle = Field::getHandle("time");
    for (auto IField = Contents.begin(); IField != Contents.end(); ++IField) {
       std::string FieldName = *IField;
 
@@ -196,6 +231,17 @@ bool IOStream::validate() {
          LOG_ERROR("Cannot validate stream {}: Field {} has not been defined",
                    Name, FieldName);
          ReturnVal = false;
+      } else {
+         ContentHandles.push_back(Field::getHandle(FieldName));
+      }
+   }
+
+   // Streams with a time reduction need accumulators for the contents
+   if (ReturnVal and Reduction != TimeReduction::None) {
+      if (initAccumulators() != 0) {
+         LOG_ERROR("Cannot validate stream {}: error creating accumulators",
+                   Name);
+         ReturnVal = false;
       }
    }
 
@@ -233,6 +279,32 @@ bool IOStream::validateAll() {
 
 } // End validateAll
 
+//------------------------------------------------------------------------------
+// Determines whether a field is written by any output stream. Streams that
+// have not yet been validated may still list group names, so the groups in
+// the contents are also searched.
+bool IOStream::isFieldWritten(const std::string &FieldName // [in] field name
+) {
+
+   for (auto Iter = AllStreams.begin(); Iter != AllStreams.end(); Iter++) {
+      std::shared_ptr ThisStream = Iter->second;
+      if (ThisStream->Mode != IO::ModeWrite)
+         continue;
+
+      if (ThisStream->Contents.find(FieldName) != ThisStream->Contents.end())
+         return true;
+
+      for (const std::string &GrpName : ThisStream->Contents) {
+         if (FieldGroup::exists(GrpName) and
+             FieldGroup::isFieldInGroup(FieldName, GrpName))
+            return true;
+      }
+   }
+
+   return false;
+
+} // End isFieldWritten
+
 //------------------------------------------------------------------------------
 // Reads a single stream if it is time. Returns an error code.
 int IOStream::read(
@@ -317,6 +389,63 @@ int IOStream::writeAll(
 
 } // End writeAll
 
+//------------------------------------------------------------------------------
+// Loops through all output streams with a time reduction and adds the current
+// field values to the stream accumulators. The samples are weighted by the
+// length of the step just taken, which can change with adaptive time steps.
+int IOStream::accumulateAll(const Clock *ModelClock // [in] model clock
+) {
+
+   int Err = Success; // accumulated error for return value
+
+   R8 StepSeconds;
+   TimeInterval StepLength =
+       ModelClock->getCurrentTime() - ModelClock->getPreviousTime();
+   StepLength.get(StepSeconds, TimeUnits::Seconds);
+
+   for (auto Iter = AllStreams.begin(); Iter != AllStreams.end(); Iter++) {
+
+      std::string StreamName               = Iter->first;
+      std::shared_ptr<IOStream> ThisStream = Iter->second;
+
+      if (ThisStream->Mode != IO::ModeWrite or
+          ThisStream->Reduction == TimeReduction::None)
+         continue;
+
+      if (ThisStream->accumulate(StepSeconds) == Fail) {
+         ++Err;
+         LOG_ERROR("accumulateAll error in stream {}", StreamName);
+      }
+   }
+
+   return Err;
+
+} // End accumulateAll
+
+//------------------------------------------------------------------------------
+// Waits for any asynchronous stream write still in progress to complete.
+// Returns an error code from the pending write.
+int IOStream::waitForWrites() {
+
+   int Err = Success;
+
+   if (!PendingWrite.valid())
+      return Err;
+
+   Err = PendingWrite.get();
+   if (Err != Success) {
+      LOG_ERROR("Error in asynchronous write of stream {}", PendingName);
+      Err = Fail;
+   }
+
+   return Err;
+
+} // End waitForWrites
+
+//------------------------------------------------------------------------------
+// Checks whether an asynchronous write has not yet been waited for
+bool IOStream::hasPendingWrite() { return PendingWrite.valid(); }
+
 //------------------------------------------------------------------------------
 // Constructs an empty IOStream
 IOStream::IOStream() {
@@ -332,6 +461,14 @@ IOStream::IOStream() {
    UsePointer         = false;
    PtrFilename        = " ";
    UseStartEnd        = false;
+   AsyncWrite         = false;
+   NumSubfiles        = 1;
+   SubfileSysID       = -1;
+   FileFormat         = IO::FmtDefault;
+   Compress           = IO::CompressNone;
+   CompressLevel      = 1;
+   QuantizeDigits     = 0;
+   Reduction          = TimeReduction::None;
    Validated          = false;
 }
 
@@ -422,6 +559,135 @@ Error IOStream::create(const std::string &StreamName, //< [in] name of stream
          NewStream->ExistAction = IO::IfExistsFromString(ExistAct);
    }
 
+   // Set the optional flag for asynchronous writes. The write happens in a
+   // background thread that makes MPI calls, so it requires MPI to be
+   // initialized with full thread support.
+   NewStream->AsyncWrite = false;
+   if (NewStream->Mode == IO::ModeWrite and
+       StreamConfig.existsVar("AsyncWrite")) {
+      Error ErrAsync = StreamConfig.get("AsyncWrite", NewStream->AsyncWrite);
+      CHECK_ERROR_ABORT(ErrAsync, "Error reading AsyncWrite for IO stream {}",
+                        StreamName);
+      int ThreadLevel;
+      MPI_Query_thread(&ThreadLevel);
+      if (NewStream->AsyncWrite and ThreadLevel < MPI_THREAD_MULTIPLE) {
+         LOG_WARN("MPI_THREAD_MULTIPLE not available, stream {} will be "
+                  "written synchronously",
+                  StreamName);
+         NewStream->AsyncWrite = false;
+      }
+   }
+
+   // Set the optional number of subfiles for writes. Reads detect whether
+   // the file was written as subfiles.
+   NewStream->NumSubfiles = 1;
+   if (NewStream->Mode == IO::ModeWrite and
+       StreamConfig.existsVar("Subfiles")) {
+      Error ErrSub = StreamConfig.get("Subfiles", NewStream->NumSubfiles);
+      CHECK_ERROR_ABORT(ErrSub, "Error reading Subfiles for IO stream {}",
+                        StreamName);
+      if (NewStream->NumSubfiles < 1) {
+         LOG_WARN("Invalid number of subfiles for stream {}, using one file",
+                  StreamName);
+         NewStream->NumSubfiles = 1;
+      }
+   }
+
+   // Set the optional file format, otherwise use the IO default
+   NewStream->FileFormat = IO::FmtDefault;
+   if (StreamConfig.existsVar("Format")) {
+      std::string FormatString;
+      Error ErrFmt = StreamConfig.get("Format", FormatString);
+      CHECK_ERROR_ABORT(ErrFmt, "Error reading Format for IO stream {}",
+                        StreamName);
+      NewStream->FileFormat = IO::FileFmtFromString(FormatString);
+      if (NewStream->FileFormat == IO::FmtUnknown) {
+         LOG_WARN("Unknown Format {} for stream {}, using default format",
+                  FormatString, StreamName);
+         NewStream->FileFormat = IO::FmtDefault;
+      }
+   }
+
+   // Set the optional storage options for NetCDF4/HDF5 output: compression
+   // and compression level, quantization of floating point data to a
+   // number of significant digits and chunk sizes by dimension name
+   NewStream->Compress       = IO::CompressNone;
+   NewStream->CompressLevel  = 1;
+   NewStream->QuantizeDigits = 0;
+   if (NewStream->Mode == IO::ModeWrite) {
+      if (StreamConfig.existsVar("Compression")) {
+         std::string CompressString;
+         Error ErrComp = StreamConfig.get("Compression", CompressString);
+         CHECK_ERROR_ABORT(ErrComp, "Error reading Compression for stream {}",
+                           StreamName);
+         NewStream->Compress = IO::CompressionFromString(CompressString);
+         if (NewStream->Compress == IO::CompressUnknown)
+            ABORT_ERROR("Unknown Compression {} for IO stream {}",
+                        CompressString, StreamName);
+      }
+      if (StreamConfig.existsVar("CompressionLevel")) {
+         Error ErrLevel =
+             StreamConfig.get("CompressionLevel", NewStream->CompressLevel);
+         CHECK_ERROR_ABORT(ErrLevel,
+                           "Error reading CompressionLevel for stream {}",
+                           StreamName);
+      }
+      if (StreamConfig.existsVar("Quantize")) {
+         Error ErrQuant =
+             StreamConfig.get("Quantize", NewStream->QuantizeDigits);
+         CHECK_ERROR_ABORT(ErrQuant, "Error reading Quantize for stream {}",
+                           StreamName);
+      }
+      if (StreamConfig.existsGroup("ChunkSizes")) {
+         Config ChunkConfig("ChunkSizes");
+         Error ErrChunk = StreamConfig.get(ChunkConfig);
+         CHECK_ERROR_ABORT(ErrChunk, "Error reading ChunkSizes for stream {}",
+                           StreamName);
+         for (auto It = ChunkConfig.begin(); It != ChunkConfig.end(); ++It) {
+            std::string DimName = It->first.as<std::string>();
+            I4 ChunkSize;
+            ErrChunk = ChunkConfig.get(DimName, ChunkSize);
+            CHECK_ERROR_ABORT(ErrChunk,
+                              "Error reading chunk size for {} in stream {}",
+                              DimName, StreamName);
+            NewStream->ChunkSizes[DimName] = ChunkSize;
+         }
+      }
+
+      // The storage options are only defined for HDF5-based files, so they
+      // are ignored for other formats rather than failing at the write
+      bool HasStorage = NewStream->Compress != IO::CompressNone or
+                        NewStream->QuantizeDigits > 0 or
+                        !NewStream->ChunkSizes.empty();
+      bool IsHDF5     = NewStream->FileFormat == IO::FmtNetCDF4c or
+                        NewStream->FileFormat == IO::FmtNetCDF4p or
+                        NewStream->FileFormat == IO::FmtHDF5;
+      if (HasStorage and !IsHDF5) {
+         LOG_WARN("Compression, Quantize and ChunkSizes require a NetCDF4 "
+                  "or HDF5 Format and are ignored for stream {}",
+                  StreamName);
+         NewStream->Compress       = IO::CompressNone;
+         NewStream->QuantizeDigits = 0;
+         NewStream->ChunkSizes.clear();
+      }
+   }
+
+   // Set the optional reduction in time for output streams. The fields are
+   // then accumulated every step and the reduced values written at each
+   // alarm instead of the values at the alarm time.
+   NewStream->Reduction = TimeReduction::None;
+   if (NewStream->Mode == IO::ModeWrite and
+       StreamConfig.existsVar("Reduction")) {
+      std::string ReductionString;
+      Error ErrRed = StreamConfig.get("Reduction", ReductionString);
+      CHECK_ERROR_ABORT(ErrRed, "Error reading Reduction for IO stream {}",
+                        StreamName);
+      NewStream->Reduction = reductionFromString(ReductionString);
+      if (NewStream->Reduction == TimeReduction::Unknown)
+         ABORT_ERROR("Unknown Reduction {} for IO stream {}", ReductionString,
+                     StreamName);
+   }
+
    // Set alarm based on read/write frequency
    // Use stream name as alarm name
    std::string AlarmName = StreamName;
@@ -648,6 +914,11 @@ int IOStream::defineAllDims(
       I4 Length = IDim->second->getLengthGlobal();
       I4 DimID;
 
+      // Distributed dimensions in a subfile have the subfile length
+      auto SubIt = SubfileLengths.find(DimName);
+      if (SubIt != SubfileLengths.end())
+         Length = SubIt->second;
+
       // First check to see if the dimension already exists in the file
       I4 InLength;
       Err = IO::getDimFromFile(FileID, DimName, DimID, InLength);
@@ -731,6 +1002,12 @@ void IOStream::getFieldSize(
 //------------------------------------------------------------------------------
 // Computes the parallel decomposition (offsets) for a field needed for parallel
 // I/O. Return error code and also Decomp ID and array size for field.
+// Decompositions are cached by the IO layer with a key formed from the IO data
+// type and the name, lengths and ID of each dimension, so fields sharing the
+// same layout reuse a single decomposition across fields, streams and output
+// times. The ID identifies the offsets of the dimension, so a dimension
+// re-created on a new decomposition never matches a cached entry. The cached
+// decompositions are destroyed in IOStream::finalize.
 int IOStream::computeDecomp(
     std::shared_ptr<Field> FieldPtr, // [in] pointer to Field
     int &DecompID,                   // [out] ID assigned to the decomposition
@@ -768,6 +1045,14 @@ int IOStream::computeDecomp(
    std::vector<I4> DimLengthGlob(MaxDims, 1); // lengths padded to MaxDims
    std::vector<I4> DimLengthLoc(MaxDims, 1);  // lengths padded to MaxDims
 
+   // The key for the decomposition cache is built from the data type and
+   // the dimensions in the same loop, using the dimension ID for the
+   // offsets. Subfile layouts use a separate IO system so they are
+   // distinguished by a key prefix. Decompositions for reading subfiles are
+   // only used once and are not cached.
+   std::string DecompKey = SubfileKey + std::to_string(MyIOType);
+   bool UseCache         = Mode == IO::ModeWrite or SubfileOffsets.empty();
+
    for (int IDim = 0; IDim < NDims; ++IDim) {
       I4 StartDim                        = MaxDims - NDims;
       std::string DimName                = DimNames[IDim];
@@ -775,12 +1060,26 @@ int IOStream::computeDecomp(
       DimLengths[IDim]                   = ThisDim->getLengthLocal();
       DimLengthsGlob[IDim]               = ThisDim->getLengthGlobal();
       DimOffsets[StartDim + IDim]        = ThisDim->getOffset();
-      DimLengthLoc[StartDim + IDim]      = DimLengths[IDim];
-      DimLengthGlob[StartDim + IDim]     = DimLengthsGlob[IDim];
+
+      // Distributed dimensions in a subfile use the subfile layout
+      auto SubIt = SubfileOffsets.find(DimName);
+      if (SubIt != SubfileOffsets.end()) {
+         DimLengthsGlob[IDim]        = SubfileLengths[DimName];
+         DimOffsets[StartDim + IDim] = SubIt->second;
+      }
+      DimLengthLoc[StartDim + IDim]  = DimLengths[IDim];
+      DimLengthGlob[StartDim + IDim] = DimLengthsGlob[IDim];
       LocalSize *= DimLengths[IDim];
       GlobalSize *= DimLengthsGlob[IDim];
+      DecompKey += ":" + DimName + "/" + std::to_string(DimLengths[IDim]) +
+                   "/" + std::to_string(DimLengthsGlob[IDim]) + "/" +
+                   std::to_string(ThisDim->getID());
    }
 
+   // Reuse a previously computed decomposition with the same layout
+   if (UseCache and OMEGA::IO::getCachedDecomp(DecompKey, DecompID))
+      return Err;
+
    // Create the data decomposition based on dimension information
    // Compute offset index (0-based global index of each element) in
    // linear address space. Needed for the decomposition definition.
@@ -843,17 +1142,290 @@ int IOStream::computeDecomp(
    }
 
    Err = OMEGA::IO::createDecomp(DecompID, MyIOType, NDims, DimLengthsGlob,
-                                 LocalSize, Offset, OMEGA::IO::DefaultRearr);
+                                 LocalSize, Offset, OMEGA::IO::DefaultRearr,
+                                 SubfileSysID);
    if (Err != 0) {
       LOG_ERROR("Error creating decomp for field {} in stream {}", FieldName,
                 Name);
       return Fail;
    }
+   if (UseCache)
+      OMEGA::IO::cacheDecomp(DecompKey, DecompID, SubfileSysID);
 
    return Err;
 
 } // End computeDecomp
 
+//------------------------------------------------------------------------------
+// Computes the layout of the distributed dimensions in the subfile written by
+// the local group of tasks. The owned elements of each task are stored
+// contiguously in task order so the subfile offset of each owned element is
+// the number of owned elements on lower tasks in the group plus the position
+// of the element among the locally owned elements.
+int IOStream::setSubfileWriteLayout(
+    MPI_Comm SubComm // [in] communicator for tasks sharing the subfile
+) {
+
+   int Err = 0;
+
+   int SubTask;
+   MPI_Comm_rank(SubComm, &SubTask);
+
+   SubfileLengths.clear();
+   SubfileOffsets.clear();
+
+   for (auto IDim = Dimension::begin(); IDim != Dimension::end(); ++IDim) {
+      std::shared_ptr<Dimension> ThisDim = IDim->second;
+      if (!ThisDim->isDistributed())
+         continue;
+      std::string DimName      = IDim->first;
+      I4 LengthLocal           = ThisDim->getLengthLocal();
+      HostArray1DI4 GlobOffset = ThisDim->getOffset();
+
+      // Count the owned elements and determine where this task starts
+      I4 NOwned = 0;
+      for (int I = 0; I < LengthLocal; ++I) {
+         if (GlobOffset(I) >= 0)
+            ++NOwned;
+      }
+      I4 SubStart  = 0;
+      I4 SubLength = 0;
+
+      Err = MPI_Exscan(&NOwned, &SubStart, 1, MPI_INT32_T, MPI_SUM, SubComm);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("Error computing subfile offsets for dimension {}",
+                   DimName);
+         return Fail;
+      }
+      if (SubTask == 0) // result of exscan undefined on first task
+         SubStart = 0;
+      Err = MPI_Allreduce(&NOwned, &SubLength, 1, MPI_INT32_T, MPI_SUM,
+                          SubComm);
+      if (Err != MPI_SUCCESS) {
+         LOG_ERROR("Error computing subfile length for dimension {}",
+                   DimName);
+         return Fail;
+      }
+
+      HostArray1DI4 SubOffset("SubOffset" + DimName, LengthLocal);
+      I4 NextOffset = SubStart;
+      for (int I = 0; I < LengthLocal; ++I) {
+         if (GlobOffset(I) >= 0) {
+            SubOffset(I) = NextOffset;
+            ++NextOffset;
+         } else {
+            SubOffset(I) = -1;
+         }
+      }
+
+      SubfileLengths[DimName] = SubLength;
+      SubfileOffsets[DimName] = SubOffset;
+   }
+
+   return Success;
+
+} // End setSubfileWriteLayout
+
+//------------------------------------------------------------------------------
+// Computes the layout of the distributed dimensions in a subfile being read.
+// Each subfile stores the global offset of each of its elements so the owned
+// elements of the local task can be located in any subfile, independent of
+// the decomposition used to write the file.
+int IOStream::setSubfileReadLayout(
+    int FileID, // [in] id assigned to the open subfile
+    std::map<std::string, I4> &NumFound // [inout] owned elements found
+) {
+
+   int Err = 0;
+
+   SubfileLengths.clear();
+   SubfileOffsets.clear();
+
+   for (auto IDim = Dimension::begin(); IDim != Dimension::end(); ++IDim) {
+      std::shared_ptr<Dimension> ThisDim = IDim->second;
+      if (!ThisDim->isDistributed())
+         continue;
+      std::string DimName = IDim->first;
+
+      // Skip any dimensions that are not in this file
+      I4 DimID;
+      I4 SubLength;
+      Err = IO::getDimFromFile(FileID, DimName, DimID, SubLength);
+      if (Err != 0 or SubLength < 0) {
+         Err = Success;
+         continue;
+      }
+
+      // Read the global offset of each element in the subfile
+      std::vector<I4> SubMap(std::max(SubLength, 1));
+      int MapID;
+      Err = IO::readNDVar(SubMap.data(), DimName + "GlobalOffset", FileID,
+                          MapID);
+      if (Err != 0) {
+         LOG_ERROR("Error reading subfile map for dimension {} in stream {}",
+                   DimName, Name);
+         return Fail;
+      }
+
+      // Locate each of the locally owned elements in the subfile
+      NumFound.try_emplace(DimName, 0);
+      I4 LengthLocal           = ThisDim->getLengthLocal();
+      HostArray1DI4 GlobOffset = ThisDim->getOffset();
+      std::unordered_map<I4, I4> LocalIndex;
+      for (int I = 0; I < LengthLocal; ++I) {
+         if (GlobOffset(I) >= 0)
+            LocalIndex[GlobOffset(I)] = I;
+      }
+
+      HostArray1DI4 SubOffset("SubOffset" + DimName, LengthLocal);
+      Kokkos::deep_copy(SubOffset, -1);
+      for (int ISub = 0; ISub < SubLength; ++ISub) {
+         auto It = LocalIndex.find(SubMap[ISub]);
+         if (It != LocalIndex.end()) {
+            SubOffset(It->second) = ISub;
+            ++NumFound[DimName];
+         }
+      }
+
+      SubfileLengths[DimName] = SubLength;
+      SubfileOffsets[DimName] = SubOffset;
+   }
+
+   return Err;
+
+} // End setSubfileReadLayout
+
+//------------------------------------------------------------------------------
+// Defines and writes the global offset of each element of the distributed
+// dimensions in a subfile. Elements not owned by the local task are not
+// written.
+int IOStream::writeSubfileMaps(
+    int FileID,                           // [in] id assigned to the subfile
+    std::map<std::string, int> &AllDimIDs // [in] dimension IDs
+) {
+
+   int Err = 0;
+
+   // Define all map variables before any data is written
+   std::map<std::string, int> MapIDs;
+   for (auto IDim = SubfileOffsets.begin(); IDim != SubfileOffsets.end();
+        ++IDim) {
+      std::string DimName = IDim->first;
+      int DimID           = AllDimIDs[DimName];
+      int MapID;
+      Err = IO::defineVar(FileID, DimName + "GlobalOffset", IO::IOTypeI4, 1,
+                          &DimID, MapID);
+      if (Err != 0) {
+         LOG_ERROR("Error defining subfile map for dimension {} in stream {}",
+                   DimName, Name);
+         return Fail;
+      }
+      MapIDs[DimName] = MapID;
+   }
+
+   // Write the map for each dimension using the subfile layout
+   for (auto IDim = SubfileOffsets.begin(); IDim != SubfileOffsets.end();
+        ++IDim) {
+      std::string DimName                = IDim->first;
+      HostArray1DI4 SubOffset            = IDim->second;
+      std::shared_ptr<Dimension> ThisDim = Dimension::get(DimName);
+      HostArray1DI4 GlobOffset           = ThisDim->getOffset();
+      I4 LengthLocal                     = ThisDim->getLengthLocal();
+
+      std::string MapKey = SubfileKey + "Map:" + DimName + "/" +
+                           std::to_string(ThisDim->getID());
+      int DecompID;
+      if (!IO::getCachedDecomp(MapKey, DecompID)) {
+         std::vector<I4> DimLengthSub(1, SubfileLengths[DimName]);
+         std::vector<I4> Offset(SubOffset.data(),
+                                SubOffset.data() + LengthLocal);
+         Err = IO::createDecomp(DecompID, IO::IOTypeI4, 1, DimLengthSub,
+                                LengthLocal, Offset, IO::DefaultRearr,
+                                SubfileSysID);
+         if (Err != 0) {
+            LOG_ERROR("Error creating subfile map decomp for dimension {}",
+                      DimName);
+            return Fail;
+         }
+         IO::cacheDecomp(MapKey, DecompID, SubfileSysID);
+      }
+
+      // Non-owned entries are skipped so the fill value is never used
+      I4 FillValue = -1;
+
+      Err = IO::writeArray(GlobOffset.data(), LengthLocal, &FillValue, FileID,
+                           DecompID, MapIDs[DimName]);
+      if (Err != 0) {
+         LOG_ERROR("Error writing subfile map for dimension {} in stream {}",
+                   DimName, Name);
+         return Fail;
+      }
+   }
+
+   return Success;
+
+} // End writeSubfileMaps
+
+//------------------------------------------------------------------------------
+// Sets the chunking, compression and quantization requested for the stream
+// on a newly defined field variable. These options only apply to
+// NetCDF4/HDF5 files and to fields with at least one dimension.
+int IOStream::defineFieldStorage(
+    int FileID,                              // [in] id of open file
+    int FieldID,                             // [in] id of the field
+    IO::IODataType MyIOType,                 // [in] IO type of field
+    const std::vector<std::string> &DimNames // [in] dims incl time
+) {
+
+   int Err = 0;
+
+   int NDims = DimNames.size();
+   if (NDims == 0)
+      return Success;
+
+   // Chunk sizes are limited to the dimension length in the file. Other
+   // dimensions are not split and time dependent fields use one time slice
+   // per chunk.
+   if (!ChunkSizes.empty()) {
+      std::vector<int> Chunks(NDims);
+      for (int IDim = 0; IDim < NDims; ++IDim) {
+         std::string DimName = DimNames[IDim];
+         if (DimName == "time") {
+            Chunks[IDim] = 1;
+            continue;
+         }
+         I4 Length  = Dimension::get(DimName)->getLengthGlobal();
+         auto SubIt = SubfileLengths.find(DimName);
+         if (SubIt != SubfileLengths.end())
+            Length = SubIt->second;
+         Chunks[IDim] = std::max(Length, 1);
+         auto ChunkIt = ChunkSizes.find(DimName);
+         if (ChunkIt != ChunkSizes.end() and ChunkIt->second > 0)
+            Chunks[IDim] = std::min(ChunkIt->second, Chunks[IDim]);
+      }
+      Err = IO::defineVarChunks(FileID, FieldID, Chunks);
+      if (Err != 0)
+         return Fail;
+   }
+
+   // Quantization only applies to floating point data
+   bool IsFloat = MyIOType == IO::IOTypeR4 or MyIOType == IO::IOTypeR8;
+   if (QuantizeDigits > 0 and IsFloat) {
+      Err = IO::defineVarQuantize(FileID, FieldID, QuantizeDigits);
+      if (Err != 0)
+         return Fail;
+   }
+
+   if (Compress != IO::CompressNone) {
+      Err = IO::defineVarCompression(FileID, FieldID, Compress, CompressLevel);
+      if (Err != 0)
+         return Fail;
+   }
+
+   return Success;
+
+} // End defineFieldStorage
+
 //------------------------------------------------------------------------------
 // Write all metadata associated with a field
 int IOStream::writeFieldMeta(
@@ -930,725 +1502,604 @@ int IOStream::writeFieldMeta(
 } // End writeFieldMeta
 
 //------------------------------------------------------------------------------
-// Write a field's data array, performing any manipulations to reduce
-// precision or move data between host and device
-int IOStream::writeFieldData(
-    std::shared_ptr<Field> FieldPtr,      // [in] field to write
-    int FileID,                           // [in] id assigned to open file
-    int FieldID,                          // [in] id assigned to the field
-    std::map<std::string, int> &AllDimIDs // [in] dimension IDs
-) {
+// Unmanaged host view used to wrap the contiguous staging vectors so that they
+// can be used in Kokkos kernels and copies without additional allocation
+template <typename T>
+using HostBuffer = Kokkos::View<T *, Kokkos::HostSpace,
+                                Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
 
-   int Err = 0;
+//------------------------------------------------------------------------------
+// Copies a single element between an array and a buffer with any conversion
+// between their types
+template <bool Pack, typename ArrayT, typename BufT>
+KOKKOS_INLINE_FUNCTION void packElement(ArrayT &ArrayVal, BufT &BufVal) {
+   if constexpr (Pack)
+      BufVal = static_cast<BufT>(ArrayVal);
+   else
+      ArrayVal = static_cast<ArrayT>(BufVal);
+}
 
-   // Retrieve some basic field information
-   std::string FieldName = FieldPtr->getName();
-   bool OnHost           = FieldPtr->isOnHost();
-   bool IsDistributed    = FieldPtr->isDistributed();
-   bool IsTimeDependent  = FieldPtr->isTimeDependent();
-   bool RetainPrecision  = FieldPtr->retainPrecision();
-   ArrayDataType MyType  = FieldPtr->getType();
-   int NDims             = FieldPtr->getNumDims();
-   if (NDims < 0) {
-      LOG_ERROR("Invalid number of dimensions for Field {}", FieldName);
-      return Fail;
-   }
+//------------------------------------------------------------------------------
+// Packs (Pack = true) a field data array into a contiguous 1D buffer ordered
+// with the last local dimension varying fastest or unpacks (Pack = false) the
+// buffer into the array. Type conversion is fused into the same loop. The loop
+// runs in the execution space of the array so device arrays are packed on the
+// device and only the packed data needs to be transferred.
+template <bool Pack, typename ArrayType, typename BufType>
+void packArray(const ArrayType &Data,              // [inout] field array
+               const BufType &Buf,                 // [inout] contiguous buffer
+               const std::vector<int> &DimLengths, // [in] local dim lengths
+               bool Fence = true // [in] wait for the loop to complete
+) {
+   using ExecSpace    = typename ArrayType::execution_space;
+   constexpr int Rank = ArrayType::rank;
+
+   if constexpr (Rank == 1) {
+      Kokkos::parallel_for(
+          "IOStreamPack1D", Kokkos::RangePolicy<ExecSpace>(0, DimLengths[0]),
+          KOKKOS_LAMBDA(int I) { packElement<Pack>(Data(I), Buf(I)); });
+   } else if constexpr (Rank == 2) {
+      int N1 = DimLengths[1];
+      Kokkos::parallel_for(
+          "IOStreamPack2D",
+          Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>>(
+              {0, 0}, {DimLengths[0], N1}),
+          KOKKOS_LAMBDA(int J, int I) {
+             packElement<Pack>(Data(J, I), Buf(J * N1 + I));
+          });
+   } else if constexpr (Rank == 3) {
+      int N1 = DimLengths[1];
+      int N2 = DimLengths[2];
+      Kokkos::parallel_for(
+          "IOStreamPack3D",
+          Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<3>>(
+              {0, 0, 0}, {DimLengths[0], N1, N2}),
+          KOKKOS_LAMBDA(int K, int J, int I) {
+             packElement<Pack>(Data(K, J, I), Buf((K * N1 + J) * N2 + I));
+          });
+   } else if constexpr (Rank == 4) {
+      int N1 = DimLengths[1];
+      int N2 = DimLengths[2];
+      int N3 = DimLengths[3];
+      Kokkos::parallel_for(
+          "IOStreamPack4D",
+          Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<4>>(
+              {0, 0, 0, 0}, {DimLengths[0], N1, N2, N3}),
+          KOKKOS_LAMBDA(int L, int K, int J, int I) {
+             packElement<Pack>(Data(L, K, J, I),
+                               Buf(((L * N1 + K) * N2 + J) * N3 + I));
+          });
+   } else {
+      static_assert(Rank == 5, "IOStream arrays limited to 5 dimensions");
+      int N1 = DimLengths[1];
+      int N2 = DimLengths[2];
+      int N3 = DimLengths[3];
+      int N4 = DimLengths[4];
+      Kokkos::parallel_for(
+          "IOStreamPack5D",
+          Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<5>>(
+              {0, 0, 0, 0, 0}, {DimLengths[0], N1, N2, N3, N4}),
+          KOKKOS_LAMBDA(int M, int L, int K, int J, int I) {
+             packElement<Pack>(
+                 Data(M, L, K, J, I),
+                 Buf((((M * N1 + L) * N2 + K) * N3 + J) * N4 + I));
+          });
+   }
+   if (Fence)
+      ExecSpace().fence();
+
+} // end packArray
 
-   // Create the decomposition needed for parallel I/O or if not decomposed
-   // get the relevant size information
-   int MyDecompID;
-   int LocSize;
-   int NDimsTmp = std::max(NDims, 1);
-   std::vector<int> DimLengths(NDimsTmp);
-   if (IsDistributed) {
-      Err = computeDecomp(FieldPtr, MyDecompID, LocSize, DimLengths);
-      if (Err != 0) {
-         LOG_ERROR("Error computing decomposition for Field {}", FieldName);
-         return Fail;
+//------------------------------------------------------------------------------
+// Determines whether a host array can be passed directly to the IO routines
+// without staging. The array must already have the IO data type and be
+// contiguous in C-ordering with extents equal to the local dim lengths.
+template <typename BufT, typename ArrayType>
+bool isDirectIO(const ArrayType &Data,              // [in] field array
+                const std::vector<int> &DimLengths, // [in] local dim lengths
+                int LocSize                         // [in] local size
+) {
+   using ArrayT       = typename ArrayType::non_const_value_type;
+   using ArrayLayout  = typename ArrayType::array_layout;
+   constexpr int Rank = ArrayType::rank;
+
+   if constexpr (!std::is_same_v<ArrayT, BufT>) {
+      return false;
+   } else if constexpr (Rank > 1 and
+                        !std::is_same_v<ArrayLayout, Kokkos::LayoutRight>) {
+      return false;
+   } else {
+      if (!Data.span_is_contiguous() or
+          Data.span() != static_cast<size_t>(LocSize))
+         return false;
+      for (int IDim = 0; IDim < Rank; ++IDim) {
+         if (Data.extent_int(IDim) != DimLengths[IDim])
+            return false;
       }
-   } else { // Get dimension lengths
-      IOStream::getFieldSize(FieldPtr, LocSize, DimLengths);
-      // Scalar data stored as an array with size 1 so reset the local NDims
-      // to pick this up
-      if (NDims == 0)
-         ++NDims;
+      return true;
    }
 
-   // Extract and write the array of data based on the type, dimension and
-   // memory location. The IO routines require a contiguous data pointer on
-   // the host. Kokkos array types do not guarantee contigous memory for
-   // multi-dimensional arrays. Here we create a contiguous space and perform
-   // any other transformations (host-device data transfer, reduce precision).
-   void *DataPtr;
-   void *FillValPtr;
-
-   // Vector for contiguous storage - the appropriate vector will be
-   // selected and resized later.
-   std::vector<I4> DataI4(1);
-   std::vector<I8> DataI8(1);
-   std::vector<R4> DataR4(1);
-   std::vector<R8> DataR8(1);
-   I4 FillValI4;
-   I8 FillValI8;
-   R4 FillValR4;
-   R8 FillValR8;
+} // end isDirectIO
 
+//------------------------------------------------------------------------------
+// Calls a generic function with default (empty) host and device arrays of the
+// type and dimension of a field array so that the function can be
+// instantiated for each supported array type.
+template <typename F>
+int dispatchArrayType(ArrayDataType MyType, // [in] data type of field
+                      int NDims,            // [in] number of dimensions
+                      F &&Func              // [in] function to call
+) {
    switch (MyType) {
-
-   // I4 Fields
    case ArrayDataType::I4:
-
-      DataI4.resize(LocSize);
-      DataPtr = DataI4.data();
-      // get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValI4);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         return Fail;
-      }
-      FillValPtr = &FillValI4;
-
       switch (NDims) {
       case 1:
-         if (OnHost) {
-            HostArray1DI4 Data = FieldPtr->getDataArray<HostArray1DI4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI4[I] = Data(I);
-            }
-         } else {
-            Array1DI4 DataTmp  = FieldPtr->getDataArray<Array1DI4>();
-            HostArray1DI4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI4[I] = Data(I);
-            }
-         }
-         break;
+         return Func(HostArray1DI4(), Array1DI4());
       case 2:
-         if (OnHost) {
-            HostArray2DI4 Data = FieldPtr->getDataArray<HostArray2DI4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI4 DataTmp  = FieldPtr->getDataArray<Array2DI4>();
-            HostArray2DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
+         return Func(HostArray2DI4(), Array2DI4());
       case 3:
-         if (OnHost) {
-            HostArray3DI4 Data = FieldPtr->getDataArray<HostArray3DI4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI4 DataTmp  = FieldPtr->getDataArray<Array3DI4>();
-            HostArray3DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray3DI4(), Array3DI4());
       case 4:
-         if (OnHost) {
-            HostArray4DI4 Data = FieldPtr->getDataArray<HostArray4DI4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI4 DataTmp  = FieldPtr->getDataArray<Array4DI4>();
-            HostArray4DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray4DI4(), Array4DI4());
       case 5:
-         if (OnHost) {
-            HostArray5DI4 Data = FieldPtr->getDataArray<HostArray5DI4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI4 DataTmp  = FieldPtr->getDataArray<Array5DI4>();
-            HostArray5DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-
-      } // end switch NDims
-      break; // end I4 type
-
-   // I8 Fields
-   case ArrayDataType::I8:
-
-      DataI8.resize(LocSize);
-      DataPtr = DataI8.data();
-      // Get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValI8);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         return Fail;
+         return Func(HostArray5DI4(), Array5DI4());
       }
-      FillValPtr = &FillValI8;
-
+      break;
+   case ArrayDataType::I8:
       switch (NDims) {
       case 1:
-         if (OnHost) {
-            HostArray1DI8 Data = FieldPtr->getDataArray<HostArray1DI8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI8[I] = Data(I);
-            }
-         } else {
-            Array1DI8 DataTmp  = FieldPtr->getDataArray<Array1DI8>();
-            HostArray1DI8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataI8[I] = Data(I);
-            }
-         }
-         break;
+         return Func(HostArray1DI8(), Array1DI8());
       case 2:
-         if (OnHost) {
-            HostArray2DI8 Data = FieldPtr->getDataArray<HostArray2DI8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI8 DataTmp  = FieldPtr->getDataArray<Array2DI8>();
-            HostArray2DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataI8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
+         return Func(HostArray2DI8(), Array2DI8());
       case 3:
-         if (OnHost) {
-            HostArray3DI8 Data = FieldPtr->getDataArray<HostArray3DI8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI8 DataTmp  = FieldPtr->getDataArray<Array3DI8>();
-            HostArray3DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataI8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray3DI8(), Array3DI8());
       case 4:
-         if (OnHost) {
-            HostArray4DI8 Data = FieldPtr->getDataArray<HostArray4DI8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI8 DataTmp  = FieldPtr->getDataArray<Array4DI8>();
-            HostArray4DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataI8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray4DI8(), Array4DI8());
       case 5:
-         if (OnHost) {
-            HostArray5DI8 Data = FieldPtr->getDataArray<HostArray5DI8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI8 DataTmp  = FieldPtr->getDataArray<Array5DI8>();
-            HostArray5DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataI8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      } // end switch NDims
-      break; // end I8 type
-
-   // R4 Fields
-   case ArrayDataType::R4:
-
-      DataR4.resize(LocSize);
-      DataPtr = DataR4.data();
-      // Get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValR4);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         return Fail;
+         return Func(HostArray5DI8(), Array5DI8());
       }
-      FillValPtr = &FillValR4;
-
+      break;
+   case ArrayDataType::R4:
       switch (NDims) {
       case 1:
-         if (OnHost) {
-            HostArray1DR4 Data = FieldPtr->getDataArray<HostArray1DR4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR4[I] = Data(I);
-            }
-         } else {
-            Array1DR4 DataTmp  = FieldPtr->getDataArray<Array1DR4>();
-            HostArray1DR4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR4[I] = Data(I);
-            }
-         }
-         break;
+         return Func(HostArray1DR4(), Array1DR4());
       case 2:
-         if (OnHost) {
-            HostArray2DR4 Data = FieldPtr->getDataArray<HostArray2DR4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR4 DataTmp  = FieldPtr->getDataArray<Array2DR4>();
-            HostArray2DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR4[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
+         return Func(HostArray2DR4(), Array2DR4());
       case 3:
-         if (OnHost) {
-            HostArray3DR4 Data = FieldPtr->getDataArray<HostArray3DR4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR4 DataTmp  = FieldPtr->getDataArray<Array3DR4>();
-            HostArray3DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR4[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray3DR4(), Array3DR4());
       case 4:
-         if (OnHost) {
-            HostArray4DR4 Data = FieldPtr->getDataArray<HostArray4DR4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR4 DataTmp  = FieldPtr->getDataArray<Array4DR4>();
-            HostArray4DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR4[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray4DR4(), Array4DR4());
       case 5:
-         if (OnHost) {
-            HostArray5DR4 Data = FieldPtr->getDataArray<HostArray5DR4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR4 DataTmp  = FieldPtr->getDataArray<Array5DR4>();
-            HostArray5DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR4[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      } // end switch NDims
-      break; // end R4 type
-
-   // R8 Fields
-   case ArrayDataType::R8:
-
-      // Get fill value
-      Err = FieldPtr->getMetadata("FillValue", FillValR8);
-      if (Err != 0) {
-         LOG_ERROR("Error retrieving FillValue for Field {}", FieldName);
-         return Fail;
-      }
-      DataR8.resize(LocSize);
-      if (ReducePrecision and !RetainPrecision) {
-         FillValR4  = FillValR8;
-         FillValPtr = &FillValR4;
-         DataR4.resize(LocSize);
-         DataPtr = DataR4.data();
-      } else {
-         FillValPtr = &FillValR8;
-         DataPtr    = DataR8.data();
+         return Func(HostArray5DR4(), Array5DR4());
       }
-
+      break;
+   case ArrayDataType::R8:
       switch (NDims) {
       case 1:
-         if (OnHost) {
-            HostArray1DR8 Data = FieldPtr->getDataArray<HostArray1DR8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR8[I] = Data(I);
-            }
-         } else {
-            Array1DR8 DataTmp  = FieldPtr->getDataArray<Array1DR8>();
-            HostArray1DR8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               DataR8[I] = Data(I);
-            }
-         }
-         break;
+         return Func(HostArray1DR8(), Array1DR8());
       case 2:
-         if (OnHost) {
-            HostArray2DR8 Data = FieldPtr->getDataArray<HostArray2DR8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR8 DataTmp  = FieldPtr->getDataArray<Array2DR8>();
-            HostArray2DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  DataR8[VecAdd] = Data(J, I);
-                  ++VecAdd;
-               }
-            }
-         }
-         break;
+         return Func(HostArray2DR8(), Array2DR8());
       case 3:
-         if (OnHost) {
-            HostArray3DR8 Data = FieldPtr->getDataArray<HostArray3DR8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR8 DataTmp  = FieldPtr->getDataArray<Array3DR8>();
-            HostArray3DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     DataR8[VecAdd] = Data(K, J, I);
-                     ++VecAdd;
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray3DR8(), Array3DR8());
       case 4:
-         if (OnHost) {
-            HostArray4DR8 Data = FieldPtr->getDataArray<HostArray4DR8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR8 DataTmp  = FieldPtr->getDataArray<Array4DR8>();
-            HostArray4DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        DataR8[VecAdd] = Data(L, K, J, I);
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         }
-         break;
+         return Func(HostArray4DR8(), Array4DR8());
       case 5:
-         if (OnHost) {
-            HostArray5DR8 Data = FieldPtr->getDataArray<HostArray5DR8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
+         return Func(HostArray5DR8(), Array5DR8());
+      }
+      break;
+   default:
+      break;
+   }
+
+   LOG_ERROR("Unsupported data type or number of dimensions ({}) for IO",
+             NDims);
+   return IOStream::Fail;
+
+} // end dispatchArrayType
+
+//------------------------------------------------------------------------------
+// Retrieves the address and size of the data array of a real field that is
+// accumulated in a stream with a time reduction. The array must be contiguous
+// so that the accumulators can treat it as a 1D array.
+int getAccumDataAddr(std::shared_ptr<Field> FieldPtr, // [in] field
+                     I8 &Addr,                        // [out] data address
+                     I4 &Size                         // [out] number of values
+) {
+
+   bool OnHost = FieldPtr->isOnHost();
+
+   return dispatchArrayType(
+       FieldPtr->getType(), FieldPtr->getNumDims(),
+       [&](auto HostArr, auto DevArr) {
+          auto SetAddr = [&](const auto &Data) {
+             if (Data.data() == nullptr or !Data.span_is_contiguous())
+                return IOStream::Fail;
+             Addr = reinterpret_cast<I8>(Data.data());
+             Size = Data.size();
+             return IOStream::Success;
+          };
+          if (OnHost)
+             return SetAddr(FieldPtr->getDataArray<decltype(HostArr)>());
+          return SetAddr(FieldPtr->getDataArray<decltype(DevArr)>());
+       });
+
+} // end getAccumDataAddr
+
+//------------------------------------------------------------------------------
+// Records the bytes of the staging buffers of the stream in host and device
+// memory in the MemoryRegistry
+void IOStream::recordStagingMemory() {
+
+   I8 DevBytes  = 0;
+   I8 HostBytes = 0;
+   for (const auto &[FieldName, Stage] : Staging) {
+      HostBytes += Stage.DataI4.capacity() * sizeof(I4) +
+                   Stage.DataI8.capacity() * sizeof(I8) +
+                   Stage.DataR4.capacity() * sizeof(R4) +
+                   Stage.DataR8.capacity() * sizeof(R8);
+      HostBytes += Stage.PinDataI4.span() * sizeof(I4) +
+                   Stage.PinDataI8.span() * sizeof(I8) +
+                   Stage.PinDataR4.span() * sizeof(R4) +
+                   Stage.PinDataR8.span() * sizeof(R8);
+      DevBytes += Stage.DevDataI4.span() * sizeof(I4) +
+                  Stage.DevDataI8.span() * sizeof(I8) +
+                  Stage.DevDataR4.span() * sizeof(R4) +
+                  Stage.DevDataR8.span() * sizeof(R8);
+   }
+
+   // Device buffers are host memory in host-only builds
+   const bool DevOnHost =
+       Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                  Array1DR8::memory_space>::accessible;
+   MemoryRegistry::addBytes("IOStream", Name + " device", DevOnHost,
+                            DevBytes);
+   MemoryRegistry::addBytes("IOStream", Name + " host", true, HostBytes);
+
+} // end recordStagingMemory
+
+//------------------------------------------------------------------------------
+// Sets up the accumulators for a stream with a time reduction. Only real,
+// time-dependent fields with data on the device are accumulated. The fields
+// are placed contiguously in one buffer and the offsets, fill values and data
+// types are copied to the device for the accumulation kernel.
+int IOStream::initAccumulators() {
+
+   Accum        = Accumulator();
+   I4 TotalSize = 0;
+   bool NeedR4  = false;
+   bool NeedR8  = false;
+   Accum.HostOffsets.push_back(0);
+
+   for (FieldHandle Handle : ContentHandles) {
+
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      const FieldInfo &Info            = ThisField->getInfo();
+
+      bool IsR4     = Info.DataType == ArrayDataType::R4;
+      bool IsReal   = IsR4 or Info.DataType == ArrayDataType::R8;
+      bool OnDevice = Info.MemLoc == ArrayMemLoc::Device or
+                      Info.MemLoc == ArrayMemLoc::Both;
+      if (!IsReal or !OnDevice or !ThisField->isTimeDependent())
+         continue;
+
+      I8 Addr;
+      I4 Size;
+      if (getAccumDataAddr(ThisField, Addr, Size) != Success) {
+         LOG_WARN("Field {} in stream {} can not be accumulated and will be "
+                  "written with its current values",
+                  ThisField->getName(), Name);
+         continue;
+      }
+
+      // Fill values are compared in the precision of the field data
+      R8 FillVal = 0.0;
+      if (Info.HasFillValue) {
+         if (IsR4) {
+            R4 FillValR4;
+            ThisField->getFillValue(FillValR4);
+            FillVal = FillValR4;
          } else {
-            Array5DR8 DataTmp  = FieldPtr->getDataArray<Array5DR8>();
-            HostArray5DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           DataR8[VecAdd] = Data(M, L, K, J, I);
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         }
-         break;
-      } // end switch NDims
-      if (ReducePrecision and !RetainPrecision) {
-         for (int I = 0; I < LocSize; ++I) {
-            DataR4[I] = DataR8[I];
+            ThisField->getFillValue(FillVal);
          }
       }
-      break; // end R8 type
 
-   default:
-      LOG_ERROR("Cannot determine data type for field {}", FieldName);
-      Err = 3;
-      break;
+      Accum.Index[Handle] = Accum.Handles.size();
+      Accum.Handles.push_back(Handle);
+      Accum.HostFillVals.push_back(FillVal);
+      Accum.HostHasFill.push_back(Info.HasFillValue ? 1 : 0);
+      Accum.HostIsR4.push_back(IsR4 ? 1 : 0);
+      TotalSize += Size;
+      Accum.HostOffsets.push_back(TotalSize);
+      NeedR4 = NeedR4 or IsR4;
+      NeedR8 = NeedR8 or !IsR4;
+   }
+
+   int NAccum = Accum.Handles.size();
+   if (NAccum == 0) {
+      LOG_WARN("Stream {} has a time reduction but no fields that can be "
+               "accumulated",
+               Name);
+      return Success;
+   }
+
+   // Copy the field properties to the device
+   HostArray1DI4 OffsetsH("AccumOffsets", NAccum + 1);
+   HostArray1DR8 FillValsH("AccumFillVals", NAccum);
+   HostArray1DI4 HasFillH("AccumHasFill", NAccum);
+   HostArray1DI4 IsR4H("AccumIsR4", NAccum);
+   for (int IAcc = 0; IAcc < NAccum; ++IAcc) {
+      OffsetsH(IAcc)  = Accum.HostOffsets[IAcc];
+      FillValsH(IAcc) = Accum.HostFillVals[IAcc];
+      HasFillH(IAcc)  = Accum.HostHasFill[IAcc];
+      IsR4H(IAcc)     = Accum.HostIsR4[IAcc];
+   }
+   OffsetsH(NAccum) = TotalSize;
+   Accum.Offsets    = createDeviceMirrorCopy(OffsetsH);
+   Accum.FillVals   = createDeviceMirrorCopy(FillValsH);
+   Accum.HasFill    = createDeviceMirrorCopy(HasFillH);
+   Accum.IsR4       = createDeviceMirrorCopy(IsR4H);
+
+   // The data addresses are set on each accumulation
+   Accum.DataAddrH = HostArray1DI8("AccumDataAddrH", NAccum);
+   Accum.DataAddr  = Array1DI8("AccumDataAddr", NAccum);
+
+   Accum.Data = Array1DR8("Accum" + Name, TotalSize);
+   if (NeedR4)
+      Accum.OutR4 = Array1DR4("AccumOutR4" + Name, TotalSize);
+   if (NeedR8)
+      Accum.OutR8 = Array1DR8("AccumOutR8" + Name, TotalSize);
+
+   resetAccumulators();
 
-   } // end switch data type
+   return Success;
 
-   // In the case where the field is not time-dependent but this is
-   // a multi-slice file, we reset the Frame temporarily for this field
-   int FldFrame = Frame; // default time slice for file
-   if (!IsTimeDependent)
-      FldFrame = -1;
+} // end initAccumulators
 
-   // Write the data
-   if (IsDistributed) {
-      Err = OMEGA::IO::writeArray(DataPtr, LocSize, FillValPtr, FileID,
-                                  MyDecompID, FieldID, FldFrame);
-      if (Err != 0) {
-         LOG_ERROR("Error writing data array for field {} in stream {}",
-                   FieldName, Name);
+//------------------------------------------------------------------------------
+// Resets the accumulators to the initial value of the reduction to start a
+// new interval
+void IOStream::resetAccumulators() {
+
+   R8 InitVal = 0.0;
+   if (Reduction == TimeReduction::Min)
+      InitVal = std::numeric_limits<R8>::max();
+   else if (Reduction == TimeReduction::Max)
+      InitVal = std::numeric_limits<R8>::lowest();
+
+   if (Accum.Data.size() > 0)
+      deepCopy(Accum.Data, InitVal);
+   Accum.NSamples   = 0;
+   Accum.SumWeights = 0.0;
+
+} // end resetAccumulators
+
+//------------------------------------------------------------------------------
+// Adds the current values of all accumulated fields in the stream to the
+// accumulators. All fields are updated in one kernel over the accumulator
+// buffer, locating the field for each element from the field offsets.
+// Elements equal to the fill value of a field remain at the fill value for
+// the rest of the interval. Averages are accumulated as the sum of the values
+// times the step length so the mean is weighted by the time each value holds.
+int IOStream::accumulate(R8 Weight // [in] length of the step in seconds
+) {
+
+   // The accumulators are created when the stream is validated
+   if (!validate()) {
+      LOG_ERROR("IOStream accumulate: contents of stream {} are not valid",
+                Name);
+      return Fail;
+   }
+
+   // Only accumulate within the active interval of the stream
+   if (UseStartEnd and (!StartAlarm.isRinging() or EndAlarm.isRinging()))
+      return Skipped;
+
+   const int NAccum = Accum.Handles.size();
+   if (NAccum == 0)
+      return Skipped;
+
+   TimingRegion Region("accumulateStream");
+
+   // The field data arrays can be replaced between steps (eg when time
+   // levels are swapped) so the data addresses are updated every step
+   for (int IAcc = 0; IAcc < NAccum; ++IAcc) {
+      std::shared_ptr<Field> ThisField = Field::get(Accum.Handles[IAcc]);
+      I8 Addr;
+      I4 Size;
+      int Err = getAccumDataAddr(ThisField, Addr, Size);
+      if (Err != Success or
+          Size != Accum.HostOffsets[IAcc + 1] - Accum.HostOffsets[IAcc]) {
+         LOG_ERROR("Data array for Field {} in stream {} has changed and "
+                   "can not be accumulated",
+                   ThisField->getName(), Name);
          return Fail;
       }
+      Accum.DataAddrH(IAcc) = Addr;
+   }
+   deepCopy(Accum.DataAddr, Accum.DataAddrH);
+
+   const auto &AccData    = Accum.Data;
+   const auto &Offsets    = Accum.Offsets;
+   const auto &FillVals   = Accum.FillVals;
+   const auto &HasFill    = Accum.HasFill;
+   const auto &IsR4       = Accum.IsR4;
+   const auto &DataAddr   = Accum.DataAddr;
+   const TimeReduction Op = Reduction;
+
+   parallelFor(
+       "accumulateStream", {Accum.HostOffsets[NAccum]},
+       KOKKOS_LAMBDA(int I) {
+          // Bisect the offsets to find the field holding this element
+          int IFld = 0;
+          int IEnd = NAccum;
+          while (IEnd - IFld > 1) {
+             int IMid = (IFld + IEnd) / 2;
+             if (I >= Offsets(IMid))
+                IFld = IMid;
+             else
+                IEnd = IMid;
+          }
+          const int J = I - Offsets(IFld);
+
+          R8 Val;
+          if (IsR4(IFld))
+             Val = reinterpret_cast<const R4 *>(DataAddr(IFld))[J];
+          else
+             Val = reinterpret_cast<const R8 *>(DataAddr(IFld))[J];
+
+          if (HasFill(IFld) and
+              (Val == FillVals(IFld) or AccData(I) == FillVals(IFld))) {
+             AccData(I) = FillVals(IFld);
+             return;
+          }
+
+          if (Op == TimeReduction::Min)
+             AccData(I) = Kokkos::min(AccData(I), Val);
+          else if (Op == TimeReduction::Max)
+             AccData(I) = Kokkos::max(AccData(I), Val);
+          else if (Op == TimeReduction::Average)
+             AccData(I) += Weight * Val;
+          else
+             AccData(I) += Val;
+       });
+
+   ++Accum.NSamples;
+   Accum.SumWeights += Weight;
 
-      // Clean up the decomp
-      Err = OMEGA::IO::destroyDecomp(MyDecompID);
-      if (Err != 0) {
-         LOG_ERROR("Error destroying decomp for field {} in stream {}",
-                   FieldName, Name);
-         return Fail;
+   return Success;
+
+} // end accumulate
+
+//------------------------------------------------------------------------------
+// Computes the reduced values of an accumulated field for writing. The values
+// are stored at the field offset in the output buffer of the field type and
+// returned as an unmanaged array with the extents of the field array.
+template <typename ArrayType>
+ArrayType IOStream::reducedArray(int IAcc,             // [in] accumulator index
+                                 const ArrayType &Data // [in] field data array
+) {
+
+   using ArrayT = typename ArrayType::non_const_value_type;
+
+   const I4 Offset    = Accum.HostOffsets[IAcc];
+   const I4 Size      = Accum.HostOffsets[IAcc + 1] - Offset;
+   const bool UseFill = Accum.HostHasFill[IAcc];
+   const R8 FillVal   = Accum.HostFillVals[IAcc];
+   const R8 Scale =
+       Reduction == TimeReduction::Average ? 1.0 / Accum.SumWeights : 1.0;
+
+   const auto &AccData = Accum.Data;
+   const auto &Out     = Accum.outData<ArrayT>();
+   parallelFor(
+       "reduceStreamField", {Size}, KOKKOS_LAMBDA(int I) {
+          const R8 Val = AccData(Offset + I);
+          if (UseFill and Val == FillVal)
+             Out(Offset + I) = static_cast<ArrayT>(FillVal);
+          else
+             Out(Offset + I) = static_cast<ArrayT>(Scale * Val);
+       });
+   Kokkos::fence();
+
+   return ArrayType(Out.data() + Offset, Data.layout());
+
+} // end reducedArray
+
+//------------------------------------------------------------------------------
+// Copy a field data array of a given host and device array type into the
+// stage, converting to the staged type BufT.
+template <typename BufT, typename HostArrayType, typename DevArrayType>
+int IOStream::stageArray(std::shared_ptr<Field> FieldPtr, // [in] field
+                         StagedField &Stage // [inout] staged field data
+) {
+
+   using ArrayT = typename HostArrayType::non_const_value_type;
+
+   // Retrieve the cached fill value and convert to the staged type
+   ArrayT FillVal;
+   int Err = FieldPtr->getFillValue(FillVal);
+   if (Err != 0) {
+      LOG_ERROR("Error retrieving FillValue for Field {}", Stage.FieldName);
+      return Fail;
+   }
+   Stage.fillVal<BufT>() = static_cast<BufT>(FillVal);
+
+   std::vector<BufT> &HostData = Stage.hostData<BufT>();
+   Stage.DirectData            = nullptr;
+
+   // Streams with a time reduction write the reduced values of accumulated
+   // fields in place of the current values
+   int IAcc = -1;
+   if constexpr (std::is_floating_point_v<ArrayT>) {
+      auto AccIt = Accum.Index.find(FieldPtr->getHandle());
+      if (AccIt != Accum.Index.end() and Accum.NSamples > 0)
+         IAcc = AccIt->second;
+   }
+
+   if (FieldPtr->isOnHost()) {
+      HostArrayType Data = FieldPtr->getDataArray<HostArrayType>();
+      if constexpr (std::is_floating_point_v<ArrayT>) {
+         if (IAcc >= 0)
+            Data = reducedArray(IAcc, Data);
       }
 
+      // Synchronous writes can pass a host array that is already in the
+      // needed form directly to the IO routines. Asynchronous writes must
+      // copy the data since the field can change before it is written.
+      if (!AsyncWrite and
+          isDirectIO<BufT>(Data, Stage.DimLengths, Stage.LocSize)) {
+         Stage.DirectData = Data.data();
+         return Success;
+      }
+
+      HostData.resize(Stage.LocSize);
+      HostBuffer<BufT> Buf(HostData.data(), Stage.LocSize);
+      packArray<true>(Data, Buf, Stage.DimLengths);
+
    } else {
-      Err = OMEGA::IO::writeNDVar(DataPtr, FileID, FieldID, FldFrame,
-                                  &DimLengths);
-      if (Err != 0) {
-         LOG_ERROR(
-             "Error writing non-distributed data for field {} in stream {}",
-             FieldName, Name);
-         return Fail;
+      DevArrayType Data = FieldPtr->getDataArray<DevArrayType>();
+      if constexpr (std::is_floating_point_v<ArrayT>) {
+         if (IAcc >= 0)
+            Data = reducedArray(IAcc, Data);
       }
+
+      // Pack and convert on the device into a buffer that is retained for
+      // later writes, then copy only the packed data to the host
+      auto &DevData = Stage.devData<BufT>();
+      if (DevData.extent_int(0) != Stage.LocSize)
+         DevData = std::remove_reference_t<decltype(DevData)>(
+             "Stage" + Stage.FieldName, Stage.LocSize);
+      packArray<true>(Data, DevData, Stage.DimLengths);
+
+      HostData.resize(Stage.LocSize);
+      HostBuffer<BufT> Buf(HostData.data(), Stage.LocSize);
+      Kokkos::deep_copy(Buf, DevData);
    }
 
-   return Err;
+   return Success;
 
-} // end writeFieldData
+} // end stageArray
 
 //------------------------------------------------------------------------------
-// Read a field's data array, performing any manipulations to reduce
-// precision or move data between host and device
-int IOStream::readFieldData(
-    std::shared_ptr<Field> FieldPtr,       // [in] field to read
-    int FileID,                            // [in] id assigned to open file
-    std::map<std::string, int> &AllDimIDs, // [in] dimension IDs
-    int &FieldID                           // [out] id assigned to the field
+// Copy a field's data array into contiguous host storage for writing,
+// performing any manipulations to reduce precision or move data between host
+// and device. Unless the stream is written asynchronously, host arrays that
+// are already contiguous with the IO type are used directly. Otherwise, the
+// staged data no longer depends on the field so the field can be modified
+// before the staged data is written.
+int IOStream::stageFieldData(
+    std::shared_ptr<Field> FieldPtr, // [in] field to write
+    int FieldID,                     // [in] id assigned to the field
+    StagedField &Stage               // [out] field data staged for writing
 ) {
 
    int Err = 0;
 
    // Retrieve some basic field information
    std::string FieldName = FieldPtr->getName();
-   // For MPAS back compatibility, the old name has a first letter that is
-   // lower case
-   std::string OldFieldName = FieldName;
-   OldFieldName[0]          = std::tolower(OldFieldName[0]);
-   bool OnHost              = FieldPtr->isOnHost();
-   bool IsDistributed       = FieldPtr->isDistributed();
-   bool IsTimeDependent     = FieldPtr->isTimeDependent();
-   ArrayDataType MyType     = FieldPtr->getType();
-   int NDims                = FieldPtr->getNumDims();
+   bool IsDistributed    = FieldPtr->isDistributed();
+   bool IsTimeDependent  = FieldPtr->isTimeDependent();
+   ArrayDataType MyType  = FieldPtr->getType();
+   int NDims             = FieldPtr->getNumDims();
    if (NDims < 0) {
       LOG_ERROR("Invalid number of dimensions for Field {}", FieldName);
       return Fail;
@@ -1656,12 +2107,12 @@ int IOStream::readFieldData(
 
    // Create the decomposition needed for parallel I/O or if not decomposed
    // get the relevant size information
-   int DecompID;
+   int MyDecompID;
    int LocSize;
-   int NDimsTmp = std::min(NDims, 1);
+   int NDimsTmp = std::max(NDims, 1);
    std::vector<int> DimLengths(NDimsTmp);
    if (IsDistributed) {
-      Err = computeDecomp(FieldPtr, DecompID, LocSize, DimLengths);
+      Err = computeDecomp(FieldPtr, MyDecompID, LocSize, DimLengths);
       if (Err != 0) {
          LOG_ERROR("Error computing decomposition for Field {}", FieldName);
          return Fail;
@@ -1674,626 +2125,301 @@ int IOStream::readFieldData(
          ++NDims;
    }
 
-   // The IO routines require a pointer to a contiguous memory on the host
-   // so we first read into a vector. Only one of the vectors below will
-   // be used and resized appropriately.
-   void *DataPtr;
-   std::vector<I4> DataI4(1);
-   std::vector<I8> DataI8(1);
-   std::vector<R4> DataR4(1);
-   std::vector<R8> DataR8(1);
+   // In the case where the field is not time-dependent but this is
+   // a multi-slice file, we reset the Frame temporarily for this field
+   Stage.Frame = Frame; // default time slice for file
+   if (!IsTimeDependent)
+      Stage.Frame = -1;
+
+   Stage.FieldName     = FieldName;
+   Stage.FieldID       = FieldID;
+   Stage.IOType        = getFieldIOType(FieldPtr);
+   Stage.IsDistributed = IsDistributed;
+   Stage.DecompID      = MyDecompID;
+   Stage.LocSize       = LocSize;
+   Stage.DimLengths    = DimLengths;
+
+   // The IO routines require a contiguous data pointer on the host. Kokkos
+   // array types do not guarantee contiguous memory for multi-dimensional
+   // arrays, so the data is packed into a contiguous buffer with any
+   // transformations (host-device data transfer, reduce precision) applied
+   // in the same pass. R8 data is staged as R4 if the precision is reduced.
+   Err = dispatchArrayType(MyType, NDims, [&](auto HostArr, auto DevArr) {
+      using HostArrayType = decltype(HostArr);
+      using DevArrayType  = decltype(DevArr);
+      using ArrayT        = typename HostArrayType::non_const_value_type;
+      if constexpr (std::is_same_v<ArrayT, R8>) {
+         if (Stage.IOType == IO::IOTypeR4)
+            return stageArray<R4, HostArrayType, DevArrayType>(FieldPtr,
+                                                               Stage);
+      }
+      return stageArray<ArrayT, HostArrayType, DevArrayType>(FieldPtr, Stage);
+   });
+   if (Err != 0) {
+      LOG_ERROR("Error staging data for Field {}", FieldName);
+      return Fail;
+   }
 
-   switch (MyType) {
-   case ArrayDataType::I4:
-      DataI4.resize(LocSize);
-      DataPtr = DataI4.data();
+   return Err;
+
+} // end stageFieldData
+
+//------------------------------------------------------------------------------
+// Write a field's data array by staging the data and writing it immediately
+int IOStream::writeFieldData(
+    std::shared_ptr<Field> FieldPtr,      // [in] field to write
+    int FileID,                           // [in] id assigned to open file
+    int FieldID,                          // [in] id assigned to the field
+    std::map<std::string, int> &AllDimIDs // [in] dimension IDs
+) {
+
+   StagedField &Stage = Staging[FieldPtr->getName()];
+   int Err            = stageFieldData(FieldPtr, FieldID, Stage);
+   if (Err != 0)
+      return Fail;
+
+   return writeStagedField(Name, FileID, Stage);
+
+} // end writeFieldData
+
+//------------------------------------------------------------------------------
+// Write a field's data array that has been staged in contiguous host storage.
+// This routine only uses the staged data so it can be called from the
+// background thread for asynchronous writes.
+int IOStream::writeStagedField(
+    const std::string &StreamName, // [in] name of stream for error messages
+    int FileID,                    // [in] id assigned to open file
+    StagedField &Stage             // [in] staged field data
+) {
+
+   int Err = 0;
+
+   // Select the staged data and fill value based on the IO data type
+   void *DataPtr;
+   void *FillValPtr;
+   switch (Stage.IOType) {
+   case IO::IOTypeI4:
+      DataPtr    = Stage.DataI4.data();
+      FillValPtr = &Stage.FillValI4;
       break;
-   case ArrayDataType::I8:
-      DataI8.resize(LocSize);
-      DataPtr = DataI8.data();
+   case IO::IOTypeI8:
+      DataPtr    = Stage.DataI8.data();
+      FillValPtr = &Stage.FillValI8;
       break;
-   case ArrayDataType::R4:
-      DataR4.resize(LocSize);
-      DataPtr = DataR4.data();
+   case IO::IOTypeR4:
+      DataPtr    = Stage.DataR4.data();
+      FillValPtr = &Stage.FillValR4;
       break;
-   case ArrayDataType::R8:
-      DataR8.resize(LocSize);
-      DataPtr = DataR8.data();
+   case IO::IOTypeR8:
+      DataPtr    = Stage.DataR8.data();
+      FillValPtr = &Stage.FillValR8;
       break;
-   case ArrayDataType::Unknown:
-      ABORT_ERROR("Unknown data array type");
    default:
-      ABORT_ERROR("Invalid data array type");
+      LOG_ERROR("Invalid data type for staged field {} in stream {}",
+                Stage.FieldName, StreamName);
+      return Fail;
    }
 
-   // read data into vector
-   if (IsDistributed) {
-      Err =
-          IO::readArray(DataPtr, LocSize, FieldName, FileID, DecompID, FieldID);
-   } else {
-      Err = IO::readNDVar(DataPtr, FieldName, FileID, FieldID);
-   }
-   if (Err != 0) {
-      // For back compatibility, try to read again with old field name
-      if (IsDistributed) {
-         Err = IO::readArray(DataPtr, LocSize, OldFieldName, FileID, DecompID,
-                             FieldID);
-      } else {
-         Err = IO::readNDVar(DataPtr, OldFieldName, FileID, FieldID);
+   // Use the field array directly if it did not require staging
+   if (Stage.DirectData != nullptr)
+      DataPtr = Stage.DirectData;
+
+   // Write the data
+   if (Stage.IsDistributed) {
+      Err = OMEGA::IO::writeArray(DataPtr, Stage.LocSize, FillValPtr, FileID,
+                                  Stage.DecompID, Stage.FieldID, Stage.Frame);
+      if (Err != 0) {
+         LOG_ERROR("Error writing data array for field {} in stream {}",
+                   Stage.FieldName, StreamName);
+         return Fail;
       }
-      if (Err != 0) { // still not found - return error
-         LOG_ERROR("Error reading data array for {} in stream {}", FieldName,
-                   Name);
+
+      // The decomposition is cached for reuse and is destroyed at finalize
+
+   } else {
+      Err = OMEGA::IO::writeNDVar(DataPtr, FileID, Stage.FieldID, Stage.Frame,
+                                  &Stage.DimLengths);
+      if (Err != 0) {
+         LOG_ERROR(
+             "Error writing non-distributed data for field {} in stream {}",
+             Stage.FieldName, StreamName);
          return Fail;
       }
    }
 
-   // Unpack vector into array based on type, dims and location
-   switch (MyType) {
+   return Err;
 
-   // I4 Fields
-   case ArrayDataType::I4:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DI4 Data = FieldPtr->getDataArray<HostArray1DI4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI4[I];
-            }
-         } else {
-            Array1DI4 DataTmp  = FieldPtr->getDataArray<Array1DI4>();
-            HostArray1DI4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI4[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DI4 Data = FieldPtr->getDataArray<HostArray2DI4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI4 DataTmp  = FieldPtr->getDataArray<Array2DI4>();
-            HostArray2DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DI4 Data = FieldPtr->getDataArray<HostArray3DI4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI4 DataTmp  = FieldPtr->getDataArray<Array3DI4>();
-            HostArray3DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DI4 Data = FieldPtr->getDataArray<HostArray4DI4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI4 DataTmp  = FieldPtr->getDataArray<Array4DI4>();
-            HostArray4DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DI4 Data = FieldPtr->getDataArray<HostArray5DI4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI4 DataTmp  = FieldPtr->getDataArray<Array5DI4>();
-            HostArray5DI4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end I4 fields
+} // end writeStagedField
 
-   // I8 Fields
-   case ArrayDataType::I8:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DI8 Data = FieldPtr->getDataArray<HostArray1DI8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI8[I];
-            }
-         } else {
-            Array1DI8 DataTmp  = FieldPtr->getDataArray<Array1DI8>();
-            HostArray1DI8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataI8[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DI8 Data = FieldPtr->getDataArray<HostArray2DI8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DI8 DataTmp  = FieldPtr->getDataArray<Array2DI8>();
-            HostArray2DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataI8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DI8 Data = FieldPtr->getDataArray<HostArray3DI8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DI8 DataTmp  = FieldPtr->getDataArray<Array3DI8>();
-            HostArray3DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataI8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DI8 Data = FieldPtr->getDataArray<HostArray4DI8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DI8 DataTmp  = FieldPtr->getDataArray<Array4DI8>();
-            HostArray4DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataI8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DI8 Data = FieldPtr->getDataArray<HostArray5DI8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DI8 DataTmp  = FieldPtr->getDataArray<Array5DI8>();
-            HostArray5DI8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataI8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end I8 fields
+//------------------------------------------------------------------------------
+// Read a field data array of a given host and device array type. Contiguous
+// host arrays are read directly and other host arrays are read into the
+// staging vector and unpacked. Device arrays are read into a pinned buffer,
+// uploaded and unpacked on the device without waiting for completion, so the
+// transfer overlaps the read of the next field. The caller must fence before
+// the buffers are reused or the field is used.
+template <typename HostArrayType, typename DevArrayType>
+int IOStream::readFieldArray(
+    std::shared_ptr<Field> FieldPtr, // [in] field to read
+    int FileID,                      // [in] id assigned to open file
+    int &FieldID,                    // [out] id assigned to the field
+    StagedField &Stage               // [inout] staging buffers
+) {
+
+   using ArrayT = typename HostArrayType::non_const_value_type;
+
+   int Err               = 0;
+   bool OnHost           = FieldPtr->isOnHost();
+   int LocSize           = Stage.LocSize;
+   std::string FieldName = Stage.FieldName;
+   // For MPAS back compatibility, the old name has a first letter that is
+   // lower case
+   std::string OldFieldName = FieldName;
+   OldFieldName[0]          = std::tolower(OldFieldName[0]);
 
-   // R4 Fields
-   case ArrayDataType::R4:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DR4 Data = FieldPtr->getDataArray<HostArray1DR4>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR4[I];
-            }
-         } else {
-            Array1DR4 DataTmp  = FieldPtr->getDataArray<Array1DR4>();
-            HostArray1DR4 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR4[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DR4 Data = FieldPtr->getDataArray<HostArray2DR4>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR4 DataTmp  = FieldPtr->getDataArray<Array2DR4>();
-            HostArray2DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR4[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DR4 Data = FieldPtr->getDataArray<HostArray3DR4>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR4 DataTmp  = FieldPtr->getDataArray<Array3DR4>();
-            HostArray3DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR4[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DR4 Data = FieldPtr->getDataArray<HostArray4DR4>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR4 DataTmp  = FieldPtr->getDataArray<Array4DR4>();
-            HostArray4DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR4[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DR4 Data = FieldPtr->getDataArray<HostArray5DR4>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR4 DataTmp  = FieldPtr->getDataArray<Array5DR4>();
-            HostArray5DR4 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR4[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end R4 fields
+   // The IO routines require a pointer to contiguous memory on the host.
+   // Use the host array itself if possible, otherwise the staging vector
+   // for host arrays or the pinned buffer for device arrays.
+   std::vector<ArrayT> &HostData = Stage.hostData<ArrayT>();
+   auto &PinnedData              = Stage.pinnedData<ArrayT>();
+   HostArrayType HostArr;
+   void *DataPtr = nullptr;
+   if (OnHost) {
+      HostArr = FieldPtr->getDataArray<HostArrayType>();
+      if (isDirectIO<ArrayT>(HostArr, Stage.DimLengths, LocSize))
+         DataPtr = HostArr.data();
+      if (DataPtr == nullptr) {
+         HostData.resize(LocSize);
+         DataPtr = HostData.data();
+      }
+   } else {
+      if (PinnedData.extent_int(0) != LocSize)
+         PinnedData = std::remove_reference_t<decltype(PinnedData)>(
+             Kokkos::view_alloc(Kokkos::WithoutInitializing,
+                                "Pinned" + FieldName),
+             LocSize);
+      DataPtr = PinnedData.data();
+   }
+   bool Direct = OnHost and DataPtr == HostArr.data();
+
+   // read data
+   if (Stage.IsDistributed) {
+      Err = IO::readArray(DataPtr, LocSize, FieldName, FileID, Stage.DecompID,
+                          FieldID);
+   } else {
+      Err = IO::readNDVar(DataPtr, FieldName, FileID, FieldID);
+   }
+   if (Err != 0) {
+      // For back compatibility, try to read again with old field name
+      if (Stage.IsDistributed) {
+         Err = IO::readArray(DataPtr, LocSize, OldFieldName, FileID,
+                             Stage.DecompID, FieldID);
+      } else {
+         Err = IO::readNDVar(DataPtr, OldFieldName, FileID, FieldID);
+      }
+      if (Err != 0) { // still not found - return error
+         LOG_ERROR("Error reading data array for {} in stream {}", FieldName,
+                   Name);
+         return Fail;
+      }
+   }
 
-   // R8 Fields
-   case ArrayDataType::R8:
-      switch (NDims) {
-      case 1:
-         if (OnHost) {
-            HostArray1DR8 Data = FieldPtr->getDataArray<HostArray1DR8>();
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR8[I];
-            }
-         } else {
-            Array1DR8 DataTmp  = FieldPtr->getDataArray<Array1DR8>();
-            HostArray1DR8 Data = createHostMirrorCopy(DataTmp);
-            for (int I = 0; I < DimLengths[0]; ++I) {
-               Data(I) = DataR8[I];
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 2:
-         if (OnHost) {
-            HostArray2DR8 Data = FieldPtr->getDataArray<HostArray2DR8>();
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-         } else {
-            Array2DR8 DataTmp  = FieldPtr->getDataArray<Array2DR8>();
-            HostArray2DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int J = 0; J < DimLengths[0]; ++J) {
-               for (int I = 0; I < DimLengths[1]; ++I) {
-                  Data(J, I) = DataR8[VecAdd];
-                  ++VecAdd;
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 3:
-         if (OnHost) {
-            HostArray3DR8 Data = FieldPtr->getDataArray<HostArray3DR8>();
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-         } else {
-            Array3DR8 DataTmp  = FieldPtr->getDataArray<Array3DR8>();
-            HostArray3DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int K = 0; K < DimLengths[0]; ++K) {
-               for (int J = 0; J < DimLengths[1]; ++J) {
-                  for (int I = 0; I < DimLengths[2]; ++I) {
-                     Data(K, J, I) = DataR8[VecAdd];
-                     ++VecAdd;
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 4:
-         if (OnHost) {
-            HostArray4DR8 Data = FieldPtr->getDataArray<HostArray4DR8>();
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-         } else {
-            Array4DR8 DataTmp  = FieldPtr->getDataArray<Array4DR8>();
-            HostArray4DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int L = 0; L < DimLengths[0]; ++L) {
-               for (int K = 0; K < DimLengths[1]; ++K) {
-                  for (int J = 0; J < DimLengths[2]; ++J) {
-                     for (int I = 0; I < DimLengths[3]; ++I) {
-                        Data(L, K, J, I) = DataR8[VecAdd];
-                        ++VecAdd;
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      case 5:
-         if (OnHost) {
-            HostArray5DR8 Data = FieldPtr->getDataArray<HostArray5DR8>();
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-         } else {
-            Array5DR8 DataTmp  = FieldPtr->getDataArray<Array5DR8>();
-            HostArray5DR8 Data = createHostMirrorCopy(DataTmp);
-            int VecAdd         = 0;
-            for (int M = 0; M < DimLengths[0]; ++M) {
-               for (int L = 0; L < DimLengths[1]; ++L) {
-                  for (int K = 0; K < DimLengths[2]; ++K) {
-                     for (int J = 0; J < DimLengths[3]; ++J) {
-                        for (int I = 0; I < DimLengths[4]; ++I) {
-                           Data(M, L, K, J, I) = DataR8[VecAdd];
-                           ++VecAdd;
-                        }
-                     }
-                  }
-               }
-            }
-            deepCopy(DataTmp, Data);
-         }
-         break;
-      } // end switch NDims
-      break; // end R8 fields
+   // Unpack the staged data into the field array
+   if (Direct)
+      return Success;
 
-   default:
-      LOG_ERROR("Invalid data type while reading field {} for stream {}",
-                FieldName, Name);
+   if (OnHost) {
+      HostBuffer<ArrayT> Buf(HostData.data(), LocSize);
+      packArray<false>(HostArr, Buf, Stage.DimLengths);
+   } else {
+      // Upload the contiguous data with one asynchronous copy and unpack on
+      // the device. Both are queued in order on the execution space of the
+      // field array.
+      using DevExecSpace = typename DevArrayType::execution_space;
+      DevArrayType Data  = FieldPtr->getDataArray<DevArrayType>();
+      auto &DevData      = Stage.devData<ArrayT>();
+      if (DevData.extent_int(0) != LocSize)
+         DevData = std::remove_reference_t<decltype(DevData)>(
+             "Stage" + FieldName, LocSize);
+      Kokkos::deep_copy(DevExecSpace(), DevData, PinnedData);
+      packArray<false>(Data, DevData, Stage.DimLengths, false);
+   }
+
+   return Success;
+
+} // end readFieldArray
+
+//------------------------------------------------------------------------------
+// Read a field's data array, performing any manipulations to reduce
+// precision or move data between host and device
+int IOStream::readFieldData(
+    std::shared_ptr<Field> FieldPtr,       // [in] field to read
+    int FileID,                            // [in] id assigned to open file
+    std::map<std::string, int> &AllDimIDs, // [in] dimension IDs
+    int &FieldID                           // [out] id assigned to the field
+) {
+
+   int Err = 0;
+
+   // Retrieve some basic field information
+   std::string FieldName = FieldPtr->getName();
+   bool IsDistributed    = FieldPtr->isDistributed();
+   ArrayDataType MyType  = FieldPtr->getType();
+   int NDims             = FieldPtr->getNumDims();
+   if (NDims < 0) {
+      LOG_ERROR("Invalid number of dimensions for Field {}", FieldName);
       return Fail;
+   }
+
+   // Create the decomposition needed for parallel I/O or if not decomposed
+   // get the relevant size information
+   int DecompID;
+   int LocSize;
+   int NDimsTmp = std::max(NDims, 1);
+   std::vector<int> DimLengths(NDimsTmp);
+   if (IsDistributed) {
+      Err = computeDecomp(FieldPtr, DecompID, LocSize, DimLengths);
+      if (Err != 0) {
+         LOG_ERROR("Error computing decomposition for Field {}", FieldName);
+         return Fail;
+      }
+   } else { // Get dimension lengths
+      IOStream::getFieldSize(FieldPtr, LocSize, DimLengths);
+      // Scalar data stored as an array with size 1 so reset the local NDims
+      // to pick this up
+      if (NDims == 0)
+         ++NDims;
+   }
 
-   } // end switch data type
+   // Read the data using the staging buffers for this field, which are
+   // retained for subsequent reads
+   StagedField &Stage  = Staging[FieldName];
+   Stage.FieldName     = FieldName;
+   Stage.IsDistributed = IsDistributed;
+   Stage.DecompID      = DecompID;
+   Stage.LocSize       = LocSize;
+   Stage.DimLengths    = DimLengths;
 
-   // Clean up the decomp
-   Err = OMEGA::IO::destroyDecomp(DecompID);
+   Err = dispatchArrayType(MyType, NDims, [&](auto HostArr, auto DevArr) {
+      return readFieldArray<decltype(HostArr), decltype(DevArr)>(
+          FieldPtr, FileID, FieldID, Stage);
+   });
    if (Err != 0) {
-      LOG_ERROR("Error destroying decomp after reading field {} in stream {}",
-                FieldName, Name);
+      LOG_ERROR("Error reading field {} for stream {}", FieldName, Name);
       return Fail;
    }
 
+   // The decomposition is cached for reuse and is destroyed at finalize,
+   // except for subfile layouts that are only read once
+   if (IsDistributed and !SubfileOffsets.empty()) {
+      Err = IO::destroyDecomp(DecompID, SubfileSysID);
+      if (Err != 0) {
+         LOG_ERROR("Error destroying subfile decomposition for field {}",
+                   FieldName);
+         return Fail;
+      }
+   }
+
    return Err;
 
 } // End readFieldData
@@ -2327,6 +2453,19 @@ int IOStream::readStream(
       }
    }
 
+   // The field handles of the contents are set by validation
+   if (!validate()) {
+      LOG_ERROR("IOStream read: contents of stream {} are not valid", Name);
+      return Fail;
+   }
+
+   // Complete any asynchronous write in progress since IO calls can not
+   // overlap and the file to read may be the one being written
+   Err = waitForWrites();
+   if (Err != 0)
+      LOG_ERROR("Error completing asynchronous writes before reading {}",
+                Name);
+
    // Get current simulation time and time string
    TimeInstant SimTime    = ModelClock->getCurrentTime();
    std::string SimTimeStr = SimTime.getString(5, 0, "_");
@@ -2351,15 +2490,34 @@ int IOStream::readStream(
       InFileName = Filename;
    }
 
+   // If the file was written as subfiles, the subfiles are read in turn.
+   // Global metadata is read from the first subfile.
+   std::string OpenFileName = InFileName;
+   bool ReadSubfiles        = false;
+   if (!std::filesystem::exists(InFileName) and
+       std::filesystem::exists(IO::subfileName(InFileName, 0))) {
+      OpenFileName = IO::subfileName(InFileName, 0);
+      ReadSubfiles = true;
+   }
+
    // Open input file
    int InFileID;
-   Err = OMEGA::IO::openFile(InFileID, InFileName, Mode, IO::FmtDefault,
+   Err = OMEGA::IO::openFile(InFileID, OpenFileName, Mode, FileFormat,
                              ExistAction);
    if (Err != 0) {
-      LOG_ERROR("Error opening file {} for input", InFileName);
+      LOG_ERROR("Error opening file {} for input", OpenFileName);
       return Fail;
    }
 
+   I4 NumInFiles = 1;
+   if (ReadSubfiles) {
+      Err = IO::readMeta("NumSubfiles", NumInFiles, InFileID, IO::GlobalID);
+      if (Err != 0) {
+         LOG_ERROR("Error reading number of subfiles from {}", OpenFileName);
+         return Fail;
+      }
+   }
+
    // Read any requested global metadata
    for (auto Iter = ReqMetadata.begin(); Iter != ReqMetadata.end(); ++Iter) {
       std::string MetaName = Iter->first;
@@ -2415,39 +2573,96 @@ int IOStream::readStream(
       }
    } // end loop over requested metadata
 
-   // Get dimensions from file and check that file has same dimension lengths
-   std::map<std::string, int> AllDimIDs;
-   Err = defineAllDims(InFileID, AllDimIDs);
-   if (Err != 0) {
-      LOG_ERROR("Error defining dimensions for file {} ", InFileName);
-      return Fail;
-   }
-
-   // For each field in the contents, define field and read field data
-   for (auto IFld = Contents.begin(); IFld != Contents.end(); ++IFld) {
+   // Read the field data from each file. For subfiles, the owned elements
+   // are located in each subfile and read with a subfile decomposition.
+   // Elements not in a subfile are skipped and retain their values in the
+   // staging buffers, so the field is complete after the last subfile.
+   // Non-distributed fields are the same in all subfiles and only read once.
+   std::map<std::string, I4> NumFound;
+   for (int IFile = 0; IFile < NumInFiles; ++IFile) {
+
+      if (IFile > 0) {
+         OpenFileName = IO::subfileName(InFileName, IFile);
+         Err = OMEGA::IO::openFile(InFileID, OpenFileName, Mode, FileFormat,
+                                   ExistAction);
+         if (Err != 0) {
+            LOG_ERROR("Error opening file {} for input", OpenFileName);
+            return Fail;
+         }
+      }
 
-      // Retrieve the field name and pointer
-      std::string FieldName            = *IFld;
-      std::shared_ptr<Field> ThisField = Field::get(FieldName);
+      if (ReadSubfiles) {
+         Err = setSubfileReadLayout(InFileID, NumFound);
+         if (Err != 0) {
+            LOG_ERROR("Error reading subfile layout from {}", OpenFileName);
+            return Fail;
+         }
+      }
 
-      // Extract the data pointer and read the data array
-      int FieldID; // not currently used but available if field metadata needed
-      Err = readFieldData(ThisField, InFileID, AllDimIDs, FieldID);
+      // Get dimensions from file and check that file has same dimension
+      // lengths
+      std::map<std::string, int> AllDimIDs;
+      Err = defineAllDims(InFileID, AllDimIDs);
       if (Err != 0) {
-         LOG_ERROR("Error reading field data for Field {} in Stream {}",
-                   FieldName, Name);
+         LOG_ERROR("Error defining dimensions for file {} ", OpenFileName);
          return Fail;
       }
 
-   } // End loop over field list
+      // For each field in the contents, define field and read field data
+      for (FieldHandle Handle : ContentHandles) {
 
-   // Close input file
-   Err = IO::closeFile(InFileID);
-   if (Err != 0) {
-      LOG_ERROR("Error closing input file {}", InFileName);
-      return Fail;
+         // Retrieve the field pointer and name
+         std::shared_ptr<Field> ThisField = Field::get(Handle);
+         std::string FieldName            = ThisField->getName();
+         if (IFile > 0 and !ThisField->isDistributed())
+            continue;
+
+         // Extract the data pointer and read the data array
+         int FieldID; // not currently used but available for field metadata
+         Err = readFieldData(ThisField, InFileID, AllDimIDs, FieldID);
+         if (Err != 0) {
+            LOG_ERROR("Error reading field data for Field {} in Stream {}",
+                      FieldName, Name);
+            return Fail;
+         }
+
+      } // End loop over field list
+
+      // Complete the uploads of device fields before their buffers are
+      // reused for the next file or the fields are used
+      Kokkos::fence("IOStream::readStream");
+
+      // Close input file
+      Err = IO::closeFile(InFileID);
+      if (Err != 0) {
+         LOG_ERROR("Error closing input file {}", OpenFileName);
+         return Fail;
+      }
+
+   } // End loop over files
+
+   // Make sure all owned elements were found in the subfiles
+   if (ReadSubfiles) {
+      SubfileLengths.clear();
+      SubfileOffsets.clear();
+      for (auto IDim = NumFound.begin(); IDim != NumFound.end(); ++IDim) {
+         HostArray1DI4 GlobOffset = Dimension::get(IDim->first)->getOffset();
+         I4 NOwned                = 0;
+         for (int I = 0; I < GlobOffset.extent_int(0); ++I) {
+            if (GlobOffset(I) >= 0)
+               ++NOwned;
+         }
+         if (IDim->second != NOwned) {
+            LOG_ERROR("Only {} of {} owned elements of dimension {} found in "
+                      "subfiles for stream {}",
+                      IDim->second, NOwned, IDim->first, Name);
+            return Fail;
+         }
+      }
    }
 
+   recordStagingMemory();
+
    LOG_INFO("Successfully read stream {} from file {}", Name, InFileName);
 
    // End of routine - return
@@ -2485,6 +2700,22 @@ int IOStream::writeStream(
       }
    }
 
+   // Time the write from here, after skipped streams have returned
+   TimingRegion Region("writeStream");
+
+   // The field handles of the contents are set by validation
+   if (!validate()) {
+      LOG_ERROR("IOStream write: contents of stream {} are not valid", Name);
+      return Fail;
+   }
+
+   // Complete any asynchronous write in progress before starting this one.
+   // Only one write can be in progress since the IO calls can not overlap.
+   Err = waitForWrites();
+   if (Err != 0)
+      LOG_ERROR("Error completing asynchronous writes before writing {}",
+                Name);
+
    // Get start time, current simulation time and time string
    TimeInstant StartTime  = ModelClock->getStartTime();
    TimeInstant SimTime    = ModelClock->getCurrentTime();
@@ -2503,9 +2734,11 @@ int IOStream::writeStream(
    TimeInterval ElapsedTime = SimTime - StartTime;
    R8 ElapsedTimeR8;
    ElapsedTime.get(ElapsedTimeR8, TimeUnits::Seconds);
-   HostArray1DR8 OutTime("OutTime", 1);
+   // The time array is taken from the scratch pool so that repeated writes
+   // reuse the arrays released by earlier writes
+   HostArray1DR8 OutTime = ScratchPool::get<HostArray1DR8>("OutTime", 1);
    OutTime(0) = ElapsedTimeR8;
-   Err        = Field::attachFieldData("time", OutTime);
+   Err        = Field::attachFieldData(TimeHandle, OutTime);
 
    // Reset alarms and flags
    if (OnStartup)
@@ -2524,13 +2757,37 @@ int IOStream::writeStream(
       OutFileName = Filename;
    }
 
+   // For streams written as subfiles, each group of tasks writes its own
+   // file through the IO system for the group. The subfile layout of the
+   // distributed dimensions does not change so is only computed once.
+   std::string OpenFileName = OutFileName;
+   int SubfileIndex         = 0;
+   if (NumSubfiles > 1) {
+      MPI_Comm SubComm;
+      Err = IO::getSubfileSystem(NumSubfiles, SubfileSysID, SubfileIndex,
+                                 SubComm);
+      if (Err != 0) {
+         LOG_ERROR("Error creating IO system for subfiles in stream {}", Name);
+         return Fail;
+      }
+      if (SubfileOffsets.empty()) {
+         Err = setSubfileWriteLayout(SubComm);
+         if (Err != 0) {
+            LOG_ERROR("Error computing subfile layout for stream {}", Name);
+            return Fail;
+         }
+      }
+      SubfileKey   = "Subfile" + std::to_string(NumSubfiles) + ":";
+      OpenFileName = IO::subfileName(OutFileName, SubfileIndex);
+   }
+
    // Open output file
    int OutFileID;
-   Err = OMEGA::IO::openFile(OutFileID, OutFileName, Mode, IO::FmtDefault,
-                             ExistAction);
+   Err = OMEGA::IO::openFile(OutFileID, OpenFileName, Mode, FileFormat,
+                             ExistAction, SubfileSysID);
    if (Err != 0) {
       LOG_ERROR("IOStream::write: error opening file {} for output",
-                OutFileName);
+                OpenFileName);
       return Fail;
    }
 
@@ -2594,6 +2851,18 @@ int IOStream::writeStream(
          LOG_ERROR("Error writing Simulation Metadata to file {}", OutFileName);
          return Fail;
       }
+      // Subfiles record the subfile count so the reader can find them all
+      if (NumSubfiles > 1) {
+         Err = IO::writeMeta("NumSubfiles", NumSubfiles, OutFileID,
+                             IO::GlobalID);
+         Err += IO::writeMeta("SubfileIndex", SubfileIndex, OutFileID,
+                              IO::GlobalID);
+         if (Err != 0) {
+            LOG_ERROR("Error writing subfile metadata to file {}",
+                      OpenFileName);
+            return Fail;
+         }
+      }
    }
 
    // Create and write a field for any global data that is file or time
@@ -2631,16 +2900,37 @@ int IOStream::writeStream(
       return Fail;
    }
 
-   // Define each field and write field metadata
-   std::map<std::string, int> FieldIDs;
+   // Fields reduced in time are identified with the CF cell_methods attribute
+   std::string CellMethods;
+   switch (Reduction) {
+   case TimeReduction::Average:
+      CellMethods = "time: mean";
+      break;
+   case TimeReduction::Min:
+      CellMethods = "time: minimum";
+      break;
+   case TimeReduction::Max:
+      CellMethods = "time: maximum";
+      break;
+   case TimeReduction::Accumulate:
+      CellMethods = "time: sum";
+      break;
+   default:
+      break;
+   }
+
+   // Define each field and write field metadata. The field IDs are in the
+   // order of the content handles.
+   std::vector<int> FieldIDs;
+   FieldIDs.reserve(ContentHandles.size());
    I4 NDims;
    std::vector<std::string> DimNames;
    std::vector<int> FieldDims;
-   for (auto IFld = Contents.begin(); IFld != Contents.end(); ++IFld) {
+   for (FieldHandle Handle : ContentHandles) {
 
       // Retrieve the field pointer
-      std::string FieldName            = *IFld;
-      std::shared_ptr<Field> ThisField = Field::get(FieldName);
+      std::shared_ptr<Field> ThisField = Field::get(Handle);
+      std::string FieldName            = ThisField->getName();
 
       // Retrieve the dimensions for this field and determine dim IDs
       NDims = ThisField->getNumDims();
@@ -2678,26 +2968,97 @@ int IOStream::writeStream(
          LOG_ERROR("Error defining field {} in stream {}", FieldName, Name);
          return Fail;
       }
-      FieldIDs[FieldName] = FieldID;
+      FieldIDs.push_back(FieldID);
 
-      // Now we can write the field metadata
+      // Now we can write the field metadata and set storage options
       if (Frame < 1) { // only write if it's the first time
+         std::vector<std::string> VarDimNames(DimNames.begin(),
+                                              DimNames.begin() + NDims);
+         Err = defineFieldStorage(OutFileID, FieldID, MyIOType, VarDimNames);
+         if (Err != 0) {
+            LOG_ERROR("Error setting storage options for field {} in "
+                      "stream {}",
+                      FieldName, Name);
+            return Fail;
+         }
          Err = writeFieldMeta(FieldName, OutFileID, FieldID);
          if (Err != 0) {
             LOG_ERROR("Error writing field metadata for field {} in stream {}",
                       FieldName, Name);
             return Fail;
          }
+         if (Accum.Index.find(Handle) != Accum.Index.end()) {
+            Err = IO::writeMeta("cell_methods", CellMethods, OutFileID,
+                                FieldID);
+            if (Err != 0) {
+               LOG_ERROR("Error writing cell_methods for field {} in "
+                         "stream {}",
+                         FieldName, Name);
+               return Fail;
+            }
+         }
+      }
+   }
+
+   // Subfiles also store the global offsets of the distributed dimensions
+   // so that they can be read back with any decomposition
+   if (NumSubfiles > 1) {
+      Err = writeSubfileMaps(OutFileID, AllDimIDs);
+      if (Err != 0) {
+         LOG_ERROR("Error writing subfile maps for stream {}", Name);
+         return Fail;
+      }
+   }
+
+   // For asynchronous writes, copy the data for all fields into staging
+   // buffers now and write the staged data and close the file in a
+   // background thread. The model can then modify the fields while the
+   // data is written.
+   if (AsyncWrite) {
+      // The staging buffers are retained by the stream and are not
+      // modified until this write has completed
+      std::vector<StagedField *> AllStaged;
+      for (int IFld = 0; IFld < ContentHandles.size(); ++IFld) {
+         std::shared_ptr<Field> ThisField = Field::get(ContentHandles[IFld]);
+         std::string FieldName            = ThisField->getName();
+         StagedField &Stage               = Staging[FieldName];
+         Err = stageFieldData(ThisField, FieldIDs[IFld], Stage);
+         if (Err != 0) {
+            LOG_ERROR("Error staging field data for Field {} in Stream {}",
+                      FieldName, Name);
+            return Fail;
+         }
+         AllStaged.push_back(&Stage);
       }
+
+      // The reduced values have been staged so a new interval can start
+      if (Reduction != TimeReduction::None)
+         resetAccumulators();
+      recordStagingMemory();
+
+      PendingName  = Name;
+      PendingWrite = std::async(
+          std::launch::async,
+          [StreamName = Name, OutFileID, OutFileName, UsePtr = UsePointer,
+           PtrName = PtrFilename, AllStaged = std::move(AllStaged)]() mutable {
+             for (StagedField *Stage : AllStaged) {
+                if (writeStagedField(StreamName, OutFileID, *Stage) != 0)
+                   return Fail;
+             }
+             return closeStreamFile(StreamName, OutFileID, OutFileName, UsePtr,
+                                    PtrName);
+          });
+
+      return Success;
    }
 
    // Now write data arrays for all fields in contents
-   for (auto IFld = Contents.begin(); IFld != Contents.end(); ++IFld) {
+   for (int IFld = 0; IFld < ContentHandles.size(); ++IFld) {
 
       // Retrieve the field pointer and FieldID
-      std::string FieldName            = *IFld;
-      std::shared_ptr<Field> ThisField = Field::get(FieldName);
-      int FieldID                      = FieldIDs[FieldName];
+      std::shared_ptr<Field> ThisField = Field::get(ContentHandles[IFld]);
+      std::string FieldName            = ThisField->getName();
+      int FieldID                      = FieldIDs[IFld];
 
       // Extract and write the data array
       Err = this->writeFieldData(ThisField, OutFileID, FieldID, AllDimIDs);
@@ -2708,8 +3069,32 @@ int IOStream::writeStream(
       }
    }
 
+   // Start a new interval for streams with a time reduction
+   if (Reduction != TimeReduction::None)
+      resetAccumulators();
+   recordStagingMemory();
+
+   // Close the file and update the pointer file
+   return closeStreamFile(Name, OutFileID, OutFileName, UsePointer,
+                          PtrFilename);
+
+} // end writeStream
+
+//------------------------------------------------------------------------------
+// Closes an output file after all data has been written and, if using pointer
+// files, writes the filename to the pointer file. This routine only uses its
+// arguments so it can be called from the background thread for asynchronous
+// writes.
+int IOStream::closeStreamFile(
+    const std::string &StreamName,  // [in] name of stream
+    int OutFileID,                  // [in] id assigned to open file
+    const std::string &OutFileName, // [in] name of output file
+    bool UsePtr,                    // [in] flag for using a pointer file
+    const std::string &PtrName      // [in] name of pointer file
+) {
+
    // Close output file
-   Err = IO::closeFile(OutFileID);
+   int Err = IO::closeFile(OutFileID);
    if (Err != 0) {
       LOG_ERROR("Error closing output file {}", OutFileName);
       return Fail;
@@ -2717,24 +3102,29 @@ int IOStream::writeStream(
 
    // If using pointer files for this stream, write the filename to the pointer
    // after the file is successfully written
-   if (UsePointer) {
-      std::ofstream PtrFile(PtrFilename, std::ios::trunc);
+   if (UsePtr) {
+      std::ofstream PtrFile(PtrName, std::ios::trunc);
       PtrFile << OutFileName << std::endl;
       PtrFile.close();
    }
 
-   LOG_INFO("Successfully wrote stream {} to file {}", Name, OutFileName);
+   LOG_INFO("Successfully wrote stream {} to file {}", StreamName,
+            OutFileName);
 
    // End of routine - return
    return Success;
 
-} // end writeStream
+} // end closeStreamFile
 
 //------------------------------------------------------------------------------
 // Removes a single IOStream from the list of all streams.
 void IOStream::erase(const std::string &StreamName // Name of IOStream to remove
 ) {
+   // Complete any pending write that may still use the stream buffers
+   waitForWrites();
    AllStreams.erase(StreamName); // use the map erase function to remove
+   MemoryRegistry::remove("IOStream", StreamName + " device");
+   MemoryRegistry::remove("IOStream", StreamName + " host");
 } // End erase
 
 //------------------------------------------------------------------------------
@@ -2963,5 +3353,34 @@ void IOStream::setPrecisionFlag(
 
 } // End setPrecisionFlag
 
+//------------------------------------------------------------------------------
+// Converts the time reduction option from the input YAML to the reduction
+// type, using case insensitive comparison
+
+IOStream::TimeReduction IOStream::reductionFromString(
+    const std::string &ReductionString ///< [in] reduction from input YAML
+) {
+
+   // Convert input string to lowercase for easier comparison
+   std::string RedComp = ReductionString;
+   std::transform(RedComp.begin(), RedComp.end(), RedComp.begin(),
+                  [](unsigned char c) { return std::tolower(c); });
+
+   if (RedComp == "none" or RedComp == "instant") {
+      return TimeReduction::None;
+   } else if (RedComp == "average" or RedComp == "mean") {
+      return TimeReduction::Average;
+   } else if (RedComp == "min" or RedComp == "minimum") {
+      return TimeReduction::Min;
+   } else if (RedComp == "max" or RedComp == "maximum") {
+      return TimeReduction::Max;
+   } else if (RedComp == "accumulate" or RedComp == "sum") {
+      return TimeReduction::Accumulate;
+   } else {
+      return TimeReduction::Unknown;
+   }
+
+} // End reductionFromString
+
 } // namespace OMEGA
 //===----------------------------------------------------------------------===//
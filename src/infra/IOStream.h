@@ -60,6 +60,7 @@
 ///      Freq: 6
 ///      FreqUnits: months
 ///      UseStartEnd: false
+///      Subfiles: 1
 ///      Contents:
 ///        - Restart
 ///    # Sample history file - values at the specified time
@@ -72,10 +73,31 @@
 ///      Freq: 1
 ///      FreqUnits: months
 ///      UseStartEnd: false
+///      # Optional: write in a background thread so the model continues
+///      # while the file is written (requires MPI_THREAD_MULTIPLE)
+///      AsyncWrite: true
 ///      Contents:
 ///        - Tracers
 ///        - State
 ///        - SshCellDefault
+///    # Sample monthly mean output. The fields are accumulated on the device
+///    # every step and the mean over the interval, weighted by the length of
+///    # each step, is written at each alarm. The Reduction can be average,
+///    # min, max or accumulate (sum). Disabled until FreqUnits is changed
+///    # from never to months.
+///    MonthlyMean:
+///      UsePointerFile: false
+///      Filename: ocn.mean.$Y-$M
+///      Mode: write
+///      IfExists: replace
+///      Precision: double
+///      Freq: 1
+///      FreqUnits: never
+///      UseStartEnd: false
+///      Reduction: average
+///      Contents:
+///        - Tracers
+///        - SshCellDefault
 ///    # Sample high-frequency output. Limited fields and time duration
 ///    Highfreq:
 ///      UsePointerFile: false
@@ -103,10 +125,13 @@
 #include "Field.h"
 #include "IO.h"
 #include "TimeMgr.h" // need Alarms, TimeInstant
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace OMEGA {
 
@@ -121,6 +146,15 @@ class IOStream {
    std::string Filename;     ///< filename or filename template (with path)
    bool FilenameIsTemplate;  ///< true if the filename is a template
    IO::IfExists ExistAction; ///< action if file exists (write only)
+   IO::FileFmt FileFormat;   ///< file format (default from IO init)
+
+   /// Storage options for variables in NetCDF4/HDF5 output files. Chunk
+   /// sizes are given by dimension name; dimensions not listed are not
+   /// split and the unlimited time dimension always has a chunk size of one.
+   IO::Compression Compress;             ///< lossless compression method
+   int CompressLevel;                    ///< compression level
+   int QuantizeDigits;                   ///< significant digits kept, 0 = off
+   std::map<std::string, I4> ChunkSizes; ///< chunk size per dimension
 
    IO::Mode Mode;        ///< mode (read or write)
    bool ReducePrecision; ///< flag to use 32-bit precision for 64-bit floats
@@ -147,9 +181,172 @@ class IOStream {
    /// Contents of stream in the form of a set of Field names
    std::set<std::string> Contents;
 
+   /// Handles of the fields in Contents, in the same order, set when the
+   /// stream is validated so reads and writes need no field name lookups
+   std::vector<FieldHandle> ContentHandles;
+
+   /// Handle of the time field that is updated on each write
+   FieldHandle TimeHandle = InvalidFieldHandle;
+
    /// Flag to determine whether the Contents have been validated or not
    bool Validated;
 
+   /// Flag to write the stream asynchronously. The field data is copied
+   /// into staging buffers at the write time and the data is written and
+   /// the file closed in a background thread. Only one write can be in
+   /// progress at a time and it is completed before the next stream read or
+   /// write or at finalize.
+   bool AsyncWrite;
+
+   /// Number of subfiles for writing this stream. If greater than one, the
+   /// tasks are divided into groups (typically by node) and each group
+   /// writes its own file with its own IO system and a local decomposition.
+   int NumSubfiles;
+
+   /// Layout of the distributed dimensions in the subfile being read or
+   /// written: the dimension length in the subfile and, for each local
+   /// index, the offset in the subfile (-1 if not in the subfile). The maps
+   /// are empty if the stream does not use subfiles.
+   std::map<std::string, I4> SubfileLengths;
+   std::map<std::string, HostArray1DI4> SubfileOffsets;
+   int SubfileSysID;       ///< IO system for the subfile (-1 for default)
+   std::string SubfileKey; ///< decomp cache key prefix for subfile layouts
+
+   /// Result of the asynchronous write in progress (if any) and the name of
+   /// the stream being written
+   static std::future<int> PendingWrite;
+   static std::string PendingName;
+
+   /// Pinned host buffer used to upload data read for device arrays. It is
+   /// host memory for host-only builds.
+   template <typename T>
+   using PinnedBuffer = Kokkos::View<T *, Kokkos::SharedHostPinnedSpace>;
+
+   /// Field data staged in contiguous host storage for reading or writing.
+   /// Only the buffers and fill value matching the IO data type are used.
+   /// Device arrays are packed into the device buffer before a single copy
+   /// to the host vector. Data read for device arrays is read into the
+   /// pinned buffer so it can be uploaded asynchronously. Host arrays that
+   /// are already contiguous with the IO type can be used directly and the
+   /// pointer is stored in DirectData.
+   struct StagedField {
+      std::string FieldName;       ///< name of field
+      int FieldID;                 ///< id assigned to the field in the file
+      IO::IODataType IOType;       ///< data type in the file
+      bool IsDistributed;          ///< flag for a distributed array
+      int DecompID;                ///< IO decomposition for distributed data
+      int LocSize;                 ///< local size of the staged array
+      int Frame;                   ///< frame to write, -1 if not time-dep
+      std::vector<int> DimLengths; ///< local dim lengths for non-distrb data
+      std::vector<I4> DataI4;      ///< staged I4 data
+      std::vector<I8> DataI8;      ///< staged I8 data
+      std::vector<R4> DataR4;      ///< staged R4 data
+      std::vector<R8> DataR8;      ///< staged R8 data
+      I4 FillValI4;                ///< fill value for I4 data
+      I8 FillValI8;                ///< fill value for I8 data
+      R4 FillValR4;                ///< fill value for R4 data
+      R8 FillValR8;                ///< fill value for R8 data
+      Array1DI4 DevDataI4;         ///< device staging buffer for I4 data
+      Array1DI8 DevDataI8;         ///< device staging buffer for I8 data
+      Array1DR4 DevDataR4;         ///< device staging buffer for R4 data
+      Array1DR8 DevDataR8;         ///< device staging buffer for R8 data
+      PinnedBuffer<I4> PinDataI4;  ///< pinned read buffer for I4 data
+      PinnedBuffer<I8> PinDataI8;  ///< pinned read buffer for I8 data
+      PinnedBuffer<R4> PinDataR4;  ///< pinned read buffer for R4 data
+      PinnedBuffer<R8> PinDataR8;  ///< pinned read buffer for R8 data
+      void *DirectData = nullptr;  ///< field array used without staging
+
+      /// Returns the host vector for data of type T
+      template <typename T> std::vector<T> &hostData() {
+         if constexpr (std::is_same_v<T, I4>)
+            return DataI4;
+         else if constexpr (std::is_same_v<T, I8>)
+            return DataI8;
+         else if constexpr (std::is_same_v<T, R4>)
+            return DataR4;
+         else
+            return DataR8;
+      }
+
+      /// Returns the device buffer for data of type T
+      template <typename T> auto &devData() {
+         if constexpr (std::is_same_v<T, I4>)
+            return DevDataI4;
+         else if constexpr (std::is_same_v<T, I8>)
+            return DevDataI8;
+         else if constexpr (std::is_same_v<T, R4>)
+            return DevDataR4;
+         else
+            return DevDataR8;
+      }
+
+      /// Returns the pinned read buffer for data of type T
+      template <typename T> auto &pinnedData() {
+         if constexpr (std::is_same_v<T, I4>)
+            return PinDataI4;
+         else if constexpr (std::is_same_v<T, I8>)
+            return PinDataI8;
+         else if constexpr (std::is_same_v<T, R4>)
+            return PinDataR4;
+         else
+            return PinDataR8;
+      }
+
+      /// Returns the fill value for data of type T
+      template <typename T> T &fillVal() {
+         if constexpr (std::is_same_v<T, I4>)
+            return FillValI4;
+         else if constexpr (std::is_same_v<T, I8>)
+            return FillValI8;
+         else if constexpr (std::is_same_v<T, R4>)
+            return FillValR4;
+         else
+            return FillValR8;
+      }
+   };
+
+   /// Staging buffers for each field in the stream, retained across writes
+   /// so the buffers are only allocated on the first write
+   std::map<std::string, StagedField> Staging;
+
+   /// Optional reduction in time of the fields in an output stream. Streams
+   /// without a reduction write the instantaneous field values.
+   enum class TimeReduction { None, Average, Min, Max, Accumulate, Unknown };
+   TimeReduction Reduction;
+
+   /// Device accumulators for a stream with a time reduction. The real
+   /// device fields of the stream are stored contiguously in a single buffer
+   /// at the offset for each field so that all fields are updated in one
+   /// kernel every step. Other fields are written with their current values.
+   struct Accumulator {
+      std::vector<FieldHandle> Handles; ///< handles of accumulated fields
+      std::map<FieldHandle, int> Index; ///< position of each field in Handles
+      std::vector<I4> HostOffsets;      ///< start of each field and total size
+      std::vector<R8> HostFillVals;     ///< fill value of each field
+      std::vector<I4> HostHasFill;      ///< flag for fields with fill values
+      std::vector<I4> HostIsR4;         ///< flag for fields with R4 data
+      I4 NSamples   = 0;                ///< number of samples since last write
+      R8 SumWeights = 0.0;              ///< sum of the step lengths sampled
+      Array1DR8 Data;                   ///< accumulated values of all fields
+      Array1DI4 Offsets;                ///< field offsets on the device
+      Array1DR8 FillVals;               ///< fill values on the device
+      Array1DI4 HasFill;                ///< fill value flags on the device
+      Array1DI4 IsR4;                   ///< flag for fields with R4 data
+      Array1DI8 DataAddr;               ///< address of current field data
+      HostArray1DI8 DataAddrH;          ///< host copy of data addresses
+      Array1DR4 OutR4;                  ///< reduced R4 fields for writing
+      Array1DR8 OutR8;                  ///< reduced R8 fields for writing
+
+      /// Returns the output buffer for reduced data of type T
+      template <typename T> auto &outData() {
+         if constexpr (std::is_same_v<T, R4>)
+            return OutR4;
+         else
+            return OutR8;
+      }
+   };
+   Accumulator Accum;
+
    //---- Private utility functions to support public interfaces
    /// Creates a new stream and adds to the list of all streams, based on
    /// options in the input model configuration. This routine is called by
@@ -168,7 +365,9 @@ class IOStream {
    );
 
    /// Computes the parallel decomposition (offsets) for a field.
-   /// Needed for parallel I/O
+   /// Needed for parallel I/O. The decomposition is cached in the IO layer
+   /// and reused by fields with the same data type and dimensions until
+   /// the streams are finalized, so it must not be destroyed by the caller.
    int computeDecomp(
        std::shared_ptr<Field> FieldPtr, ///< [in] field
        int &DecompID, ///< [out] ID assigned to the defined decomposition
@@ -176,6 +375,29 @@ class IOStream {
        std::vector<int> &DimLengths // [out] local dim lengths
    );
 
+   /// Computes the layout of the distributed dimensions in the subfile
+   /// written by the local group of tasks. Owned elements of each task are
+   /// stored contiguously in task order within the subfile.
+   int setSubfileWriteLayout(MPI_Comm SubComm ///< [in] comm for subfile tasks
+   );
+
+   /// Computes the layout of the distributed dimensions in a subfile being
+   /// read from the map of global offsets stored in the subfile. Owned
+   /// elements not in the subfile are skipped. The number of owned elements
+   /// found for each dimension is added to NumFound.
+   int setSubfileReadLayout(
+       int FileID, ///< [in] id assigned to the open subfile
+       std::map<std::string, I4> &NumFound ///< [inout] owned elements found
+   );
+
+   /// Defines and writes the global offsets of the elements of each
+   /// distributed dimension in a subfile so the subfile can be read with
+   /// any decomposition
+   int writeSubfileMaps(
+       int FileID, ///< [in] id assigned to the open subfile
+       std::map<std::string, int> &AllDimIDs ///< [in] dimension IDs
+   );
+
    /// Retrieves field size information for non-distributed fields
    /// (distributed fields get this info from computeDecomp)
    void getFieldSize(std::shared_ptr<Field> FieldPtr, ///< [in] field
@@ -199,12 +421,92 @@ class IOStream {
        bool FinalCall  = false  ///< [in] Optional flag for shutdown
    );
 
+   /// Sets the chunking, compression and quantization requested for the
+   /// stream on a newly defined field variable
+   int defineFieldStorage(
+       int FileID,                               ///< [in] id of open file
+       int FieldID,                              ///< [in] id of the field
+       IO::IODataType MyIOType,                  ///< [in] IO type of field
+       const std::vector<std::string> &DimNames ///< [in] dims incl time
+   );
+
    /// Write all metadata associated with a field
    int writeFieldMeta(std::string FieldName, ///< [in] metadata from field;
                       int FileID,            ///< [in] id assigned to open file
                       int FieldID            ///< [in] id assigned to the field
    );
 
+   /// Copy a field's data array into contiguous host storage for writing,
+   /// performing any manipulations to reduce precision or move data between
+   /// host and device
+   int stageFieldData(std::shared_ptr<Field> FieldPtr, ///< [in] field
+                      int FieldID,       ///< [in] id assigned to the field
+                      StagedField &Stage ///< [out] staged field data
+   );
+
+   /// Copy a field data array of a given host and device array type into
+   /// the stage, converting to the staged type BufT. Device arrays are packed
+   /// and converted on the device. Host arrays already in the required form
+   /// are used directly for synchronous writes.
+   template <typename BufT, typename HostArrayType, typename DevArrayType>
+   int stageArray(std::shared_ptr<Field> FieldPtr, ///< [in] field
+                  StagedField &Stage               ///< [inout] staged data
+   );
+
+   /// Read a field data array of a given host and device array type,
+   /// reading directly into contiguous host arrays or staging the data and
+   /// unpacking it into the field array. Device arrays are uploaded and
+   /// unpacked asynchronously, so a fence is needed before they are used.
+   template <typename HostArrayType, typename DevArrayType>
+   int readFieldArray(std::shared_ptr<Field> FieldPtr, ///< [in] field
+                      int FileID,        ///< [in] id assigned to open file
+                      int &FieldID,      ///< [out] id assigned to the field
+                      StagedField &Stage ///< [inout] staging buffers
+   );
+
+   /// Records the bytes of the staging buffers of the stream in host and
+   /// device memory in the MemoryRegistry
+   void recordStagingMemory();
+
+   /// Sets up the accumulators for a stream with a time reduction from the
+   /// validated contents and resets them to start a new interval
+   int initAccumulators();
+
+   /// Resets the accumulators to the initial value of the reduction
+   void resetAccumulators();
+
+   /// Adds the current values of all accumulated fields in the stream to
+   /// the accumulators in a single device kernel. Averages weight each
+   /// sample by the length of the step.
+   int accumulate(R8 Weight ///< [in] length of the step in seconds
+   );
+
+   /// Computes the reduced values of an accumulated field for writing and
+   /// returns them in an array with the type and extents of the field array
+   template <typename ArrayType>
+   ArrayType reducedArray(int IAcc,             ///< [in] accumulator index
+                          const ArrayType &Data ///< [in] field data array
+   );
+
+   /// Write a field's data array that has been staged in host storage. Does
+   /// not access the stream or field so it can be used in a background
+   /// thread.
+   static int
+   writeStagedField(const std::string &StreamName, ///< [in] name of stream
+                    int FileID,         ///< [in] id assigned to open file
+                    StagedField &Stage  ///< [in] staged field data
+   );
+
+   /// Close an output file and update the pointer file if needed. Does not
+   /// access the stream so it can be used in a background thread.
+   static int
+   closeStreamFile(const std::string &StreamName,  ///< [in] name of stream
+                   int OutFileID,                  ///< [in] id of open file
+                   const std::string &OutFileName, ///< [in] name of file
+                   bool UsePtr,               ///< [in] flag for pointer file
+                   const std::string &PtrName ///< [in] name of pointer file
+   );
+
    /// Write a field's data array, performing any manipulations to reduce
    /// precision or move data between host and device
    int
@@ -252,6 +554,12 @@ class IOStream {
        const std::string &PrecisionString ///< [in] precision from input YAML
    );
 
+   /// Converts the time reduction option from the input YAML to the
+   /// reduction type, using case insensitive comparison
+   static TimeReduction reductionFromString(
+       const std::string &ReductionString ///< [in] reduction from input YAML
+   );
+
  public:
    //---------------------------------------------------------------------------
    /// Return codes - these will be removed once Error Handler is completed
@@ -318,6 +626,13 @@ class IOStream {
    /// Returns true if all streams are valid.
    static bool validateAll();
 
+   //---------------------------------------------------------------------------
+   /// Determines whether a field is written by any output stream, either
+   /// directly or as a member of a field group in the stream contents.
+   static bool
+   isFieldWritten(const std::string &FieldName ///< [in] Name of field
+   );
+
    //---------------------------------------------------------------------------
    /// Reads a stream if it is time. Returns an error code.
    static int read(const std::string &StreamName, ///< [in] Name of stream
@@ -341,6 +656,29 @@ class IOStream {
    writeAll(const Clock *ModelClock ///< [in] Model clock for time stamps
    );
 
+   //---------------------------------------------------------------------------
+   /// Loops through all output streams with a time reduction and adds the
+   /// current field values to the stream accumulators. This must be called
+   /// once every step after the clock is advanced and before the streams are
+   /// written so that the step ending an output interval is included. The
+   /// length of the step just taken, from the previous to the current clock
+   /// time, weights the samples of averages.
+   static int
+   accumulateAll(const Clock *ModelClock ///< [in] Model clock for step length
+   );
+
+   //---------------------------------------------------------------------------
+   /// Waits for completion of any asynchronous stream write in progress.
+   /// This is called before any stream read or write and at finalize, but
+   /// can also be called directly, eg before a restart file is used
+   /// outside the IOStreams. Returns an error code.
+   static int waitForWrites();
+
+   //---------------------------------------------------------------------------
+   /// Returns true if an asynchronous stream write has been started and not
+   /// yet waited for
+   static bool hasPendingWrite();
+
    //---------------------------------------------------------------------------
    /// Removes a single IOStream from the list of all streams.
    /// That process also decrements the reference counters for the
@@ -169,6 +169,24 @@ int initLogging(
     std::shared_ptr<spdlog::logger> Logger ///< [in] Logger to use
 );
 
+/// Applies the options in the optional Logging group of the Omega Config:
+/// an asynchronous sink with a bounded queue that drops the oldest messages
+/// when full while errors are written synchronously, the log level on the
+/// master task and on all other tasks, and the frequency of per-step messages.
+/// Must be called after initLogging and after the Config has been read.
+int configLogging(const OMEGA::MachEnv *DefEnv ///< [in] MachEnv with task info
+);
+
+/// Determines whether per-step messages should be written for a step based
+/// on the StepLogFreq option
+bool isLogStep(I8 Step ///< [in] current step count
+);
+
+/// Waits until all queued messages are written and restores the
+/// synchronous logger so that all messages are written before the model
+/// exits or aborts
+void finalizeLogging();
+
 /// Utility function to create a log message with prefix
 std::string
 _PackLogMsg(const char *file, ///< [in] file where log called (cpp __FILE__)
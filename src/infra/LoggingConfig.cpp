@@ -0,0 +1,205 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- infra/LoggingConfig.cpp - configurable logging options --*- C++ -*-===//
+//
+// Applies the run-time logging options from the Omega Config. Log messages
+// can be queued and written by a background thread so that log calls never
+// wait on file IO while errors are still written synchronously, the log level
+// can differ between the master task and the other tasks, and per-step
+// messages can be limited to every N steps.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Error.h"
+#include "Logging.h"
+#include "MachEnv.h"
+
+#include <spdlog/async.h>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+// Frequency of per-step messages in steps
+static I4 LogStepFreq = 1;
+
+// Synchronous logger replaced by the asynchronous logger, restored at
+// finalize so that messages after finalize are still written
+static std::shared_ptr<spdlog::logger> SyncLogger;
+
+//------------------------------------------------------------------------------
+// Sink of the default logger when logging is asynchronous. Messages below the
+// error level are passed to the asynchronous logger, which queues them for the
+// background thread. Errors and critical messages are written and flushed to
+// the original sinks by the calling task, so they reach the log even if the
+// queue is full or the model aborts before the queue is written. The original
+// sinks are thread safe, so both threads can write to them.
+class SplitSink
+    : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+ public:
+   SplitSink(std::shared_ptr<spdlog::logger> InAsync, // [in] queued logger
+             std::vector<spdlog::sink_ptr> InSinks   // [in] original sinks
+             )
+       : Async(std::move(InAsync)), Sinks(std::move(InSinks)) {}
+
+ protected:
+   void sink_it_(const spdlog::details::log_msg &Msg) override {
+      if (Msg.level < spdlog::level::err) {
+         Async->log(Msg.time, Msg.source, Msg.level, Msg.payload);
+         return;
+      }
+      for (auto &Sink : Sinks) {
+         if (Sink->should_log(Msg.level)) {
+            Sink->log(Msg);
+            Sink->flush();
+         }
+      }
+   }
+
+   // Only queues a flush, the queue is written by finalizeLogging
+   void flush_() override { Async->flush(); }
+
+ private:
+   std::shared_ptr<spdlog::logger> Async; ///< logger queueing messages
+   std::vector<spdlog::sink_ptr> Sinks;   ///< original sinks for errors
+};
+
+//------------------------------------------------------------------------------
+// Applies the options in the optional Logging group of the Omega Config
+int configLogging(const MachEnv *DefEnv // [in] MachEnv with task info
+) {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Logging"))
+      return 0;
+
+   Config LogConfig("Logging");
+   Error Err = OmegaConfig->get(LogConfig);
+   CHECK_ERROR_ABORT(Err, "configLogging: error reading Logging group");
+
+   bool Async;
+   I4 QueueSize;
+   I4 FlushInterval;
+   std::string MasterLevel;
+   std::string OtherLevel;
+   Err += LogConfig.get("Async", Async);
+   Err += LogConfig.get("QueueSize", QueueSize);
+   Err += LogConfig.get("FlushInterval", FlushInterval);
+   Err += LogConfig.get("MasterLevel", MasterLevel);
+   Err += LogConfig.get("OtherLevel", OtherLevel);
+   Err += LogConfig.get("StepLogFreq", LogStepFreq);
+   CHECK_ERROR_ABORT(Err, "configLogging: missing options in Logging Config");
+
+   if (LogStepFreq < 1) {
+      LOG_WARN("configLogging: invalid StepLogFreq {}, using 1", LogStepFreq);
+      LogStepFreq = 1;
+   }
+
+   // Tasks with logging turned off by initLogging stay off
+   std::shared_ptr<spdlog::logger> Logger = spdlog::default_logger();
+   if (Logger->level() == spdlog::level::off)
+      return 0;
+
+   // Set the level for this task. Unknown level names are converted to off
+   // by spdlog so they are checked here.
+   const std::string &LevelName =
+       DefEnv->isMasterTask() ? MasterLevel : OtherLevel;
+   spdlog::level::level_enum Level = spdlog::level::from_str(LevelName);
+   if (Level == spdlog::level::off and LevelName != "off") {
+      LOG_WARN("configLogging: unknown log level {}, using info", LevelName);
+      Level = spdlog::level::info;
+   }
+
+   // Replace the default logger by a logger that queues messages below the
+   // error level for an asynchronous logger writing to the same sinks and
+   // writes errors directly (see SplitSink). If the queue is full the oldest
+   // queued message is dropped, so a log call never waits on the background
+   // thread. Errors are never queued and so never dropped.
+   if (Async) {
+      if (QueueSize < 1) {
+         LOG_WARN("configLogging: invalid QueueSize {}, using 8192",
+                  QueueSize);
+         QueueSize = 8192;
+      }
+      spdlog::init_thread_pool(QueueSize, 1);
+      auto AsyncLogger = std::make_shared<spdlog::async_logger>(
+          Logger->name(), Logger->sinks().begin(), Logger->sinks().end(),
+          spdlog::thread_pool(),
+          spdlog::async_overflow_policy::overrun_oldest);
+      AsyncLogger->set_level(spdlog::level::trace);
+      auto Split = std::make_shared<SplitSink>(AsyncLogger, Logger->sinks());
+      SyncLogger = Logger;
+      Logger     = std::make_shared<spdlog::logger>(SyncLogger->name(), Split);
+      spdlog::set_default_logger(Logger);
+   }
+   Logger->set_level(Level);
+
+   // Errors are flushed as soon as they are written and other messages at
+   // the flush interval. For the asynchronous logger the flush of other
+   // messages is queued with the messages, so finalizeLogging drains the
+   // queue before an abort or exit.
+   Logger->flush_on(spdlog::level::err);
+   if (FlushInterval > 0)
+      spdlog::flush_every(std::chrono::seconds(FlushInterval));
+
+   return 0;
+
+} // end configLogging
+
+//------------------------------------------------------------------------------
+// Determines whether per-step messages should be written for a step
+bool isLogStep(I8 Step // [in] current step count
+) {
+   return LogStepFreq <= 1 or Step % LogStepFreq == 0;
+} // end isLogStep
+
+//------------------------------------------------------------------------------
+// Writes all queued messages and restores the synchronous logger. A flush of
+// the asynchronous logger is only queued, so the thread pool is shut down
+// instead, which joins the background thread once the queue is written.
+// Also called by Error::abort so that the abort message reaches the log.
+void finalizeLogging() {
+
+   std::shared_ptr<spdlog::logger> Logger = spdlog::default_logger();
+
+   if (!SyncLogger) {
+      Logger->flush();
+      return;
+   }
+
+   SyncLogger->set_level(Logger->level());
+   SyncLogger->flush_on(spdlog::level::err);
+   Logger = nullptr;
+
+   // Messages dropped because the queue was full
+   std::size_t NDropped = 0;
+   if (auto Pool = spdlog::thread_pool())
+      NDropped = Pool->overrun_counter();
+
+   // Drops all loggers, stops the periodic flush and waits for the queue
+   spdlog::shutdown();
+
+   spdlog::set_default_logger(SyncLogger);
+   SyncLogger = nullptr;
+   if (NDropped > 0)
+      LOG_WARN("finalizeLogging: {} log messages dropped with a full queue, "
+               "increase Logging QueueSize to keep them",
+               NDropped);
+   spdlog::default_logger()->flush();
+
+} // end finalizeLogging
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -513,6 +513,14 @@ bool TimeFrac::operator==(
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
 
+   // fast path for fractions on the same denominator: proper fractions
+   // can be compared by components without any GCD reduction
+   if (Ttmp1.Denom == Ttmp2.Denom) {
+      Ttmp1.normalize();
+      Ttmp2.normalize();
+      return Ttmp1.Whole == Ttmp2.Whole && Ttmp1.Numer == Ttmp2.Numer;
+   }
+
    // ensure proper base time
    Ttmp1.simplify();
    Ttmp2.simplify();
@@ -535,6 +543,14 @@ bool TimeFrac::operator!=(
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
 
+   // fast path for fractions on the same denominator: proper fractions
+   // can be compared by components without any GCD reduction
+   if (Ttmp1.Denom == Ttmp2.Denom) {
+      Ttmp1.normalize();
+      Ttmp2.normalize();
+      return Ttmp1.Whole != Ttmp2.Whole || Ttmp1.Numer != Ttmp2.Numer;
+   }
+
    // ensure proper base time
    Ttmp1.simplify();
    Ttmp2.simplify();
@@ -557,6 +573,15 @@ bool TimeFrac::operator<(
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
 
+   // fast path for fractions on the same denominator
+   if (Ttmp1.Denom == Ttmp2.Denom) {
+      Ttmp1.normalize();
+      Ttmp2.normalize();
+      if (Ttmp1.Whole != Ttmp2.Whole)
+         return Ttmp1.Whole < Ttmp2.Whole;
+      return Ttmp1.Numer < Ttmp2.Numer;
+   }
+
    // ensure proper fractions; check for divide-by-zero
    Ttmp1.simplify();
    Ttmp2.simplify();
@@ -584,6 +609,15 @@ bool TimeFrac::operator>(
    TimeFrac Ttmp1 = *this;
    TimeFrac Ttmp2 = Time;
 
+   // fast path for fractions on the same denominator
+   if (Ttmp1.Denom == Ttmp2.Denom) {
+      Ttmp1.normalize();
+      Ttmp2.normalize();
+      if (Ttmp1.Whole != Ttmp2.Whole)
+         return Ttmp1.Whole > Ttmp2.Whole;
+      return Ttmp1.Numer > Ttmp2.Numer;
+   }
+
    // ensure proper fractions; check for divide-by-zero
    Ttmp1.simplify();
    Ttmp2.simplify();
@@ -609,8 +643,8 @@ bool TimeFrac::operator>(
 bool TimeFrac::operator<=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
-   // reuse < and == operators defined above
-   return *this < Time || *this == Time;
+   // the complement of the strict comparison avoids comparing twice
+   return !(*this > Time);
 
 } // end TimeFrac::operator(<=)
 
@@ -621,8 +655,8 @@ bool TimeFrac::operator<=(
 bool TimeFrac::operator>=(
     const TimeFrac &Time) const { // [in] TimeFrac to compare
 
-   // reuse > and == operators defined above
-   return *this > Time || *this == Time;
+   // the complement of the strict comparison avoids comparing twice
+   return !(*this < Time);
 
 } // end TimeFrac::operator(>=)
 
@@ -639,16 +673,21 @@ TimeFrac::operator+(const TimeFrac &Time) const { // [in] TimeFrac to add
 
    TimeFrac Sum;
 
-   // fractional part addition
-   Sum.Denom = TimeFracLCM(Denom, Time.Denom);
-   Sum.Numer =
-       Numer * (Sum.Denom / Denom) + Time.Numer * (Sum.Denom / Time.Denom);
-
    // whole part addition
    Sum.Whole = Whole + Time.Whole;
 
+   // fractional part addition, skipping the LCM for a shared denominator
+   if (Denom == Time.Denom) {
+      Sum.Denom = Denom;
+      Sum.Numer = Numer + Time.Numer;
+   } else {
+      Sum.Denom = TimeFracLCM(Denom, Time.Denom);
+      Sum.Numer =
+          Numer * (Sum.Denom / Denom) + Time.Numer * (Sum.Denom / Time.Denom);
+   }
+
    // ensure simplified form
-   Sum.simplify();
+   Sum.reduce();
 
    return Sum;
 
@@ -667,17 +706,22 @@ TimeFrac::operator-(const TimeFrac &Time) const { // [in] TimeFrac to subtract
 
    TimeFrac Diff;
 
-   // fractional part subtraction
-   // must convert to same denominator
-   Diff.Denom = TimeFracLCM(Denom, Time.Denom);
-   Diff.Numer =
-       Numer * (Diff.Denom / Denom) - Time.Numer * (Diff.Denom / Time.Denom);
-
    // whole part subtraction
    Diff.Whole = Whole - Time.Whole;
 
+   // fractional part subtraction
+   // must convert to same denominator, unless already shared
+   if (Denom == Time.Denom) {
+      Diff.Denom = Denom;
+      Diff.Numer = Numer - Time.Numer;
+   } else {
+      Diff.Denom = TimeFracLCM(Denom, Time.Denom);
+      Diff.Numer =
+          Numer * (Diff.Denom / Denom) - Time.Numer * (Diff.Denom / Time.Denom);
+   }
+
    // ensure simplified form
-   Diff.simplify();
+   Diff.reduce();
 
    return Diff;
 
@@ -726,7 +770,7 @@ TimeFrac::operator*(const I4 Multiplier) const { // [in] integer multiplier
    Product.Whole = Whole * Multiplier;
 
    // ensure simplified form
-   Product.simplify();
+   Product.reduce();
 
    return Product;
 
@@ -953,16 +997,17 @@ void TimeFrac::convert(I8 Denominator) {
 } // end TimeFrac::convert
 
 //------------------------------------------------------------------------------
-// TimeFrac::simplify
-// Ensure proper fraction and reduce to lowest denominator
+// TimeFrac::normalize
+// Ensure proper fraction without reducing the denominator
 // If fraction >= 1, add to whole part, and adjust fraction to
-// remainder. Then reduce to lowest denominator.
+// remainder. The whole and fraction parts are given the same sign and
+// the denominator is made positive.
 
-void TimeFrac::simplify(void) {
+void TimeFrac::normalize(void) {
 
    // check for divide-by-zero
    if (Denom == 0)
-      ABORT_ERROR("TimeMgr: TimeFrac::simplify encountered 0 denominator");
+      ABORT_ERROR("TimeMgr: TimeFrac::normalize encountered 0 denominator");
 
    // normalize to proper fraction - if fraction > 1 add to the
    // whole number component to bring fraction under 1
@@ -992,6 +1037,17 @@ void TimeFrac::simplify(void) {
       Numer *= -1;
    }
 
+} // end TimeFrac::normalize
+
+//------------------------------------------------------------------------------
+// TimeFrac::simplify
+// Ensure proper fraction and reduce to lowest denominator
+
+void TimeFrac::simplify(void) {
+
+   // ensure proper fraction
+   normalize();
+
    // reduce to lowest denominator
 
    I8 GCD = TimeFracGCD(Numer, Denom);
@@ -1004,6 +1060,25 @@ void TimeFrac::simplify(void) {
 
 } // end TimeFrac::simplify
 
+//------------------------------------------------------------------------------
+// TimeFrac::reduce
+// Simplify the result of an arithmetic operation. The GCD reduction is only
+// needed for a nonzero fraction, so results in whole seconds, the common
+// case of integer time steps, are put on a unit denominator directly.
+
+void TimeFrac::reduce(void) {
+
+   if (Numer == 0) {
+      // check for divide-by-zero
+      if (Denom == 0)
+         ABORT_ERROR("TimeMgr: TimeFrac::reduce encountered 0 denominator");
+      Denom = 1;
+   } else {
+      simplify();
+   }
+
+} // end TimeFrac::reduce
+
 //------------------------------------------------------------------------------
 // Calendar definitions
 //------------------------------------------------------------------------------
@@ -3552,6 +3627,7 @@ Alarm::Alarm(void) {
 
    TimeInstant AlarmTime;
    RingTime = AlarmTime;
+   setRingWhole();
 
 } // end Alarm::Alarm - default
 
@@ -3574,6 +3650,7 @@ Alarm::Alarm(
 
    // Now set ringing time to desired input value
    RingTime = AlarmTime;
+   setRingWhole();
 
 } // end Alarm::Alarm (single instance alarm)
 
@@ -3603,6 +3680,7 @@ Alarm::Alarm(
    // present) later calls to the updateStatus method will move the previous
    // ring time forward to be closer to the actual time
    RingTime = IntervalStart + AlarmInterval;
+   setRingWhole();
 
 } // end Alarm::Alarm constructor for periodic/interval alarms
 
@@ -3630,16 +3708,39 @@ bool Alarm::isRinging(void) { return Ringing; }
 // time instant. If the instant is equal to, or later than the ring time,
 // the alarm begins ringing until stopped.
 
-void Alarm::updateStatus(const TimeInstant CurrentTime // [in] current time
+void Alarm::updateStatus(const TimeInstant &CurrentTime // [in] current time
 ) {
 
-   if (!Stopped) { // if stopped, then status never changes
-      if (CurrentTime >= RingTime)
-         Ringing = true;
-   }
+   // if stopped, then status never changes and a ringing alarm rings until
+   // it is stopped or reset
+   if (Stopped || Ringing)
+      return;
+
+   // A non-negative time in proper form lies below its whole seconds plus
+   // one, so it is earlier than the ring time when its whole seconds are
+   // less than those of the ring time
+   TimeFrac Current = CurrentTime.ElapsedTime;
+   Current.normalize();
+   if (Current.getWhole() >= 0 && Current.getWhole() < RingWhole)
+      return;
+
+   if (CurrentTime >= RingTime)
+      Ringing = true;
 
 } // end Alarm::updateStatus
 
+//------------------------------------------------------------------------------
+// Alarm::setRingWhole - Caches the whole seconds of the ring time
+// Must be called whenever the ring time changes.
+
+void Alarm::setRingWhole(void) {
+
+   TimeFrac Ring = RingTime.ElapsedTime;
+   Ring.normalize();
+   RingWhole = Ring.getWhole();
+
+} // end Alarm::setRingWhole
+
 //------------------------------------------------------------------------------
 // Alarm::reset - Stops a ringing alarm and resets to a new alarm time
 // Stops a ringing alarm and sets next a new ring time. If the alarm
@@ -3674,6 +3775,7 @@ void Alarm::reset(const TimeInstant InTime // [in] new alarm time
       // input value
       RingTime = InTime;
    }
+   setRingWhole();
 
 } // end Alarm::reset
 
@@ -3713,6 +3815,31 @@ const TimeInterval *Alarm::getInterval() const { return &RingInterval; }
 
 const TimeInstant *Alarm::getRingTimePrev(void) const { return &RingTimePrev; }
 
+//------------------------------------------------------------------------------
+// Alarm::getNextRingTime - finds the first ring time after an input time
+// A periodic alarm that is ringing or was not yet reset still rings at the
+// following interval boundaries, so the interval is added until the time is
+// after the input time. A one-time alarm only rings again if its ring time
+// is after the input time.
+
+bool Alarm::getNextRingTime(const TimeInstant &AfterTime, // [in] time
+                            TimeInstant &NextRingTime     // [out] ring time
+) const {
+
+   if (Stopped)
+      return false;
+
+   NextRingTime = RingTime;
+   if (Periodic) {
+      while (NextRingTime <= AfterTime)
+         NextRingTime += RingInterval;
+      return true;
+   }
+
+   return NextRingTime > AfterTime;
+
+} // end Alarm::getNextRingTime
+
 //------------------------------------------------------------------------------
 // Clock definitions
 //------------------------------------------------------------------------------
@@ -3856,6 +3983,28 @@ void Clock::attachAlarm(Alarm *InAlarm // [in] pointer to alarm to attach
 
 } // end Clock::attachAlarm
 
+//------------------------------------------------------------------------------
+// Clock::getNextAlarmTime - Finds the next ring time of the attached alarms
+// Returns the earliest time after the current time at which an attached
+// alarm rings, so a caller changing the time step can land on it.
+
+bool Clock::getNextAlarmTime(TimeInstant &NextAlarmTime // [out] ring time
+) const {
+
+   bool Found = false;
+   for (I4 N = 0; N < NumAlarms; ++N) {
+      TimeInstant RingTime;
+      if (Alarms[N]->getNextRingTime(CurrTime, RingTime) &&
+          (!Found || RingTime < NextAlarmTime)) {
+         NextAlarmTime = RingTime;
+         Found         = true;
+      }
+   }
+
+   return Found;
+
+} // end Clock::getNextAlarmTime
+
 // Clock methods
 //------------------------------------------------------------------------------
 // Clock::advance - Advances a clock one timestep and updates alarms
@@ -125,6 +125,10 @@ class TimeFrac {
    I8 Numer; ///< Integer fractional second (n/d) numerator
    I8 Denom; ///< Integer fractional second (n/d) denominator
 
+   /// Simplify the result of an arithmetic operation, skipping the GCD
+   /// reduction when the fraction is zero
+   void reduce(void);
+
  public:
    // Accessor methods
 
@@ -253,6 +257,10 @@ class TimeFrac {
 
    /// Convert a time fraction to new denominator
    void convert(const I8 Denom); ///< [in] new denominator
+   /// Ensure a proper fraction with a positive denominator, without
+   /// reducing the denominator. Fractions on the same denominator can then
+   /// be compared by components.
+   void normalize(void);
    /// Reduce a time fraction to simplest form
    void simplify(void);
 
@@ -603,6 +611,8 @@ class TimeInstant {
  private:
    TimeFrac ElapsedTime; ///< Fractional seconds since reference time
 
+   friend class Alarm;
+
  public:
    // constructors/destructors
 
@@ -744,6 +754,13 @@ class Alarm {
    TimeInterval RingInterval; ///< interval at which this alarm rings
    TimeInstant RingTimePrev;  ///< previous alarm time for interval alarms
 
+   /// Whole seconds of the ring time, used to skip the full comparison in
+   /// updateStatus for times that are whole seconds before the ring time
+   I8 RingWhole;
+
+   /// Updates the cached whole seconds after a change in ring time
+   void setRingWhole(void);
+
  public:
    // constructors/destructors
 
@@ -772,7 +789,7 @@ class Alarm {
 
    /// Checks whether the alarm should ring based on the current
    /// (or supplied) time instant
-   void updateStatus(const TimeInstant CurrentTime ///< [in] current time
+   void updateStatus(const TimeInstant &CurrentTime ///< [in] current time
    );
 
    /// Stops a ringing alarm and sets next a new ring time. If the alarm
@@ -798,6 +815,15 @@ class Alarm {
    /// Get last time the alarm rang
    const TimeInstant *getRingTimePrev(void) const;
 
+   /// Finds the first time after the input time at which the alarm rings.
+   /// For a ringing periodic alarm this is the ring time after the next
+   /// reset. Returns false for a stopped alarm or a one-time alarm that
+   /// does not ring after the input time.
+   bool getNextRingTime(
+       const TimeInstant &AfterTime, ///< [in] time after which alarm rings
+       TimeInstant &NextRingTime     ///< [out] next ring time
+   ) const;
+
 }; // end class Alarm
 
 // default max number of alarms to create initial space in Alarms vector
@@ -865,6 +891,11 @@ class Clock {
    void attachAlarm(Alarm *InAlarm ///< [in] pointer to alarm to attach
    );
 
+   /// Finds the earliest time after the current time at which any attached
+   /// alarm rings. Returns false if no attached alarm rings again.
+   bool getNextAlarmTime(TimeInstant &NextAlarmTime ///< [out] next ring time
+   ) const;
+
    /// Advance a clock one timestep and update status of any attached
    /// alarms.
    void advance(void);
@@ -0,0 +1,269 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- infra/Timing.cpp - timers for kernels and model regions -*- C++ -*-===//
+//
+// Implements the hierarchical region timers. Each region is forwarded to
+// Pacer and its time, call count and bytes touched are also accumulated here
+// so that a summary across tasks with the achieved bandwidth can be written
+// at finalize.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Timing.h"
+#include "Config.h"
+#include "Error.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+
+#include <algorithm>
+
+namespace OMEGA {
+
+// create the static class members
+bool Timing::Enabled      = true;
+bool Timing::FenceKernels = false;
+std::map<std::string, Timing::RegionStats> Timing::AllRegions;
+std::vector<std::string> Timing::ActivePaths;
+std::vector<R8> Timing::StartTimes;
+
+//------------------------------------------------------------------------------
+// Read the timing options from the optional Timing group of the Omega Config
+void Timing::init() {
+
+   bool InEnabled = true;
+   bool InFence   = false;
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (OmegaConfig->existsGroup("Timing")) {
+      Config TimingConfig("Timing");
+      Error Err = OmegaConfig->get(TimingConfig);
+      CHECK_ERROR_ABORT(Err, "Timing: error reading Timing group from Config");
+
+      Err += TimingConfig.get("Enabled", InEnabled);
+      Err += TimingConfig.get("FenceKernels", InFence);
+      CHECK_ERROR_ABORT(Err, "Timing: Enabled or FenceKernels not found in "
+                             "Timing Config");
+   }
+
+   setOptions(InEnabled, InFence);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Set the timing options
+void Timing::setOptions(bool InEnabled, bool InFence) {
+   Enabled      = InEnabled;
+   FenceKernels = InFence;
+}
+
+//------------------------------------------------------------------------------
+// Check whether timing is enabled
+bool Timing::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Start a region. The device is fenced first so that the region does not
+// include the completion of kernels launched before it.
+void Timing::start(const std::string &Name) {
+
+   if (!Enabled)
+      return;
+
+   if (FenceKernels)
+      Kokkos::fence();
+
+   Pacer::start(Name);
+
+   std::string Path = Name;
+   if (!ActivePaths.empty())
+      Path = ActivePaths.back() + ":" + Name;
+
+   ActivePaths.push_back(Path);
+   StartTimes.push_back(MPI_Wtime());
+
+} // end start
+
+//------------------------------------------------------------------------------
+// Stop the innermost region and accumulate its statistics. The device is
+// fenced first so that the region includes the kernels it launched.
+void Timing::stop(const std::string &Name, R8 Bytes) {
+
+   if (!Enabled)
+      return;
+
+   if (FenceKernels)
+      Kokkos::fence();
+
+   R8 EndTime = MPI_Wtime();
+
+   // The innermost active region must be the one being stopped
+   const I4 NActive = ActivePaths.size();
+   std::string Path = Name;
+   if (NActive > 1)
+      Path = ActivePaths[NActive - 2] + ":" + Name;
+   if (NActive == 0 or ActivePaths.back() != Path) {
+      LOG_ERROR("Timing: region {} stopped but not the innermost region",
+                Name);
+      return;
+   }
+
+   RegionStats &Stats = AllRegions[Path];
+   Stats.Time += EndTime - StartTimes.back();
+   Stats.Bytes += Bytes;
+   ++Stats.Calls;
+
+   ActivePaths.pop_back();
+   StartTimes.pop_back();
+
+   Pacer::stop(Name);
+
+} // end stop
+
+//------------------------------------------------------------------------------
+// Retrieve the statistics of a region on this task
+Timing::RegionStats Timing::getStats(const std::string &Path) {
+
+   auto It = AllRegions.find(Path);
+   if (It == AllRegions.end())
+      return RegionStats();
+
+   return It->second;
+}
+
+//------------------------------------------------------------------------------
+// Sum the statistics of a region over all of its paths on this task. A path
+// is included if its last region has the given name and no enclosing region
+// does, so that the time of a region nested in itself is not counted twice.
+Timing::RegionStats Timing::getTotalStats(const std::string &Name) {
+
+   RegionStats Total;
+   for (const auto &[Path, Stats] : AllRegions) {
+
+      // Split the path into the names of its regions
+      std::vector<std::string> Names;
+      std::size_t Begin = 0;
+      std::size_t End   = 0;
+      while ((End = Path.find(':', Begin)) != std::string::npos) {
+         Names.push_back(Path.substr(Begin, End - Begin));
+         Begin = End + 1;
+      }
+      Names.push_back(Path.substr(Begin));
+
+      if (Names.back() != Name or
+          std::count(Names.begin(), Names.end(), Name) > 1)
+         continue;
+
+      Total.Time += Stats.Time;
+      Total.Bytes += Stats.Bytes;
+      Total.Calls += Stats.Calls;
+   }
+
+   return Total;
+
+} // end getTotalStats
+
+//------------------------------------------------------------------------------
+// Write a summary of the regions across tasks. The region paths of the master
+// task are broadcast so that all tasks reduce the same regions in the same
+// order, even if some regions were not timed on every task.
+void Timing::printSummary(MPI_Comm Comm) {
+
+   if (!Enabled)
+      return;
+
+   I4 MyTask;
+   I4 NTasks;
+   MPI_Comm_rank(Comm, &MyTask);
+   MPI_Comm_size(Comm, &NTasks);
+
+   // Broadcast the region paths of the master task as one string with a
+   // newline after each path
+   std::string PathList;
+   if (MyTask == 0) {
+      for (const auto &[Path, Stats] : AllRegions)
+         PathList += Path + "\n";
+   }
+   I4 ListLength = PathList.size();
+   MPI_Bcast(&ListLength, 1, MPI_INT32_T, 0, Comm);
+   PathList.resize(ListLength);
+   MPI_Bcast(PathList.data(), ListLength, MPI_CHAR, 0, Comm);
+
+   std::vector<std::string> Paths;
+   std::size_t Begin = 0;
+   while (Begin < PathList.size()) {
+      std::size_t End = PathList.find('\n', Begin);
+      Paths.push_back(PathList.substr(Begin, End - Begin));
+      Begin = End + 1;
+   }
+   const I4 NRegions = Paths.size();
+   if (NRegions == 0)
+      return;
+
+   // Gather the local statistics of each region
+   std::vector<R8> Times(NRegions);
+   std::vector<R8> Bytes(NRegions);
+   std::vector<I8> Calls(NRegions);
+   for (int I = 0; I < NRegions; ++I) {
+      RegionStats Stats = getStats(Paths[I]);
+      Times[I]          = Stats.Time;
+      Bytes[I]          = Stats.Bytes;
+      Calls[I]          = Stats.Calls;
+   }
+
+   std::vector<R8> MinTimes(NRegions);
+   std::vector<R8> MaxTimes(NRegions);
+   std::vector<R8> SumTimes(NRegions);
+   std::vector<R8> SumBytes(NRegions);
+   std::vector<I8> MaxCalls(NRegions);
+   MPI_Reduce(Times.data(), MinTimes.data(), NRegions, MPI_DOUBLE, MPI_MIN, 0,
+              Comm);
+   MPI_Reduce(Times.data(), MaxTimes.data(), NRegions, MPI_DOUBLE, MPI_MAX, 0,
+              Comm);
+   MPI_Reduce(Times.data(), SumTimes.data(), NRegions, MPI_DOUBLE, MPI_SUM, 0,
+              Comm);
+   MPI_Reduce(Bytes.data(), SumBytes.data(), NRegions, MPI_DOUBLE, MPI_SUM, 0,
+              Comm);
+   MPI_Reduce(Calls.data(), MaxCalls.data(), NRegions, MPI_INT64_T, MPI_MAX,
+              0, Comm);
+
+   if (MyTask != 0)
+      return;
+
+   // The bandwidth is the mean bytes per task over the mean time per task
+   LOG_INFO("Timing summary over {} tasks (times in seconds):", NTasks);
+   LOG_INFO("{:<48} {:>8} {:>12} {:>12} {:>12} {:>10}", "Region", "Calls",
+            "Min", "Max", "Mean", "GB/s");
+   for (int I = 0; I < NRegions; ++I) {
+      R8 MeanTime = SumTimes[I] / NTasks;
+      R8 GBPerSec = 0;
+      if (SumTimes[I] > 0)
+         GBPerSec = SumBytes[I] / SumTimes[I] * 1.0e-9;
+      LOG_INFO("{:<48} {:>8} {:>12.5e} {:>12.5e} {:>12.5e} {:>10.3f}",
+               Paths[I], MaxCalls[I], MinTimes[I], MaxTimes[I], MeanTime,
+               GBPerSec);
+   }
+
+} // end printSummary
+
+//------------------------------------------------------------------------------
+// Remove all regions
+void Timing::clear() {
+   AllRegions.clear();
+   ActivePaths.clear();
+   StartTimes.clear();
+}
+
+//------------------------------------------------------------------------------
+// Scoped region
+TimingRegion::TimingRegion(const std::string &InName, R8 InBytes)
+    : Name(InName), Bytes(InBytes) {
+   Timing::start(Name);
+}
+
+TimingRegion::~TimingRegion() { Timing::stop(Name, Bytes); }
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
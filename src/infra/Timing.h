@@ -0,0 +1,127 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_TIMING_H
+#define OMEGA_TIMING_H
+//===-- infra/Timing.h - timers for kernels and model regions ---*- C++ -*-===//
+//
+/// \file
+/// \brief Defines hierarchical timers with bandwidth accounting
+///
+/// The Timing class times named regions of the model, such as a kernel, a
+/// group of tendency terms, a halo exchange or the write of a stream. Each
+/// region is also started and stopped in Pacer, so the regions appear in the
+/// Pacer timing output. Regions nest: a region started while another is
+/// active is recorded under the path of the enclosing regions, for example
+/// "doStep:updateThickByTend". A region can be given the number of bytes
+/// read and written by each of its calls, from which the achieved memory
+/// bandwidth is computed. Kernels are launched asynchronously on devices, so
+/// the device can be fenced at the start and end of each region for
+/// accurate kernel times, at the cost of removing any overlap between
+/// kernels. At finalize, printSummary writes the minimum, maximum and mean
+/// time over all MPI tasks and the bandwidth of each region. The
+/// TimingRegion class starts a region on construction and stops it when it
+/// goes out of scope.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "mpi.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Hierarchical timers of named regions
+class Timing {
+ public:
+   /// Statistics accumulated by a region on this task
+   struct RegionStats {
+      R8 Time{0};  ///< total time in seconds
+      R8 Bytes{0}; ///< total bytes read and written
+      I8 Calls{0}; ///< number of calls
+   };
+
+   /// Initializes the timers from the Timing group of the Omega Config.
+   /// Timing is enabled without fencing if the group is absent.
+   static void init();
+
+   /// Sets the timing options directly rather than from Config
+   static void setOptions(bool InEnabled, ///< [in] enable the timers
+                          bool InFence    ///< [in] fence device in regions
+   );
+
+   /// Returns true if timing is enabled
+   static bool isEnabled();
+
+   /// Starts a region nested in any currently active regions
+   static void start(const std::string &Name ///< [in] name of region
+   );
+
+   /// Stops the innermost active region, which must have the given name,
+   /// and adds its time and the bytes it touched to its statistics
+   static void stop(const std::string &Name, ///< [in] name of region
+                    R8 Bytes = 0             ///< [in] bytes read and written
+   );
+
+   /// Returns the statistics of a region from its full path, or zeros if
+   /// the region has not been timed on this task
+   static RegionStats getStats(const std::string &Path ///< [in] region path
+   );
+
+   /// Returns the statistics of a region summed over every path it was timed
+   /// under on this task, for example all halo exchanges wherever they
+   /// occur. Regions nested in a region of the same name are not counted
+   /// twice.
+   static RegionStats
+   getTotalStats(const std::string &Name ///< [in] name of region
+   );
+
+   /// Writes the minimum, maximum and mean time over the tasks in a
+   /// communicator, the number of calls and the mean bandwidth of each
+   /// region timed on the master task. Must be called by all tasks.
+   static void printSummary(MPI_Comm Comm ///< [in] communicator of tasks
+   );
+
+   /// Removes all region statistics and any active regions
+   static void clear();
+
+ private:
+   static bool Enabled;      ///< timers are active
+   static bool FenceKernels; ///< fence device at region start and stop
+
+   /// Statistics of each region, by full path
+   static std::map<std::string, RegionStats> AllRegions;
+
+   /// Full paths and start times of the active regions, innermost last
+   static std::vector<std::string> ActivePaths;
+   static std::vector<R8> StartTimes;
+};
+
+/// Times a region for the lifetime of the object, so that a region with
+/// several return points is always stopped
+class TimingRegion {
+ public:
+   /// Starts a region
+   TimingRegion(const std::string &Name, ///< [in] name of region
+                R8 Bytes = 0             ///< [in] bytes read and written
+   );
+
+   /// Stops the region
+   ~TimingRegion();
+
+   // Regions can not be copied or moved
+   TimingRegion(const TimingRegion &)            = delete;
+   TimingRegion &operator=(const TimingRegion &) = delete;
+
+ private:
+   std::string Name;
+   R8 Bytes;
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,131 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- ocn/AuxDependencies.cpp - aux variable dependencies -----*- C++ -*-===//
+//
+// Collects the auxiliary variable groups needed by the tendency terms and
+// output streams and tracks which groups are valid in the current stage
+//
+//===----------------------------------------------------------------------===//
+
+#include "AuxDependencies.h"
+#include "IOStream.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Start with no groups needed or computed
+AuxDependencies::AuxDependencies() {
+   for (int I = 0; I < NAuxGroups; ++I) {
+      Required[I] = false;
+      Computed[I] = false;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Mark a group as needed. The tracer Laplacian is computed from the mean
+// layer thickness on edges, so the tracer group also needs the layer
+// thickness group. The other groups only use the ocean state.
+void AuxDependencies::require(AuxGroup Group) {
+   Required[static_cast<int>(Group)] = true;
+   if (Group == AuxGroup::Tracer)
+      require(AuxGroup::LayerThickness);
+}
+
+//------------------------------------------------------------------------------
+// The thickness flux divergence uses the flux layer thickness on edges
+void AuxDependencies::addTerms(const ThicknessFluxDivOnCell &ThickFluxDiv) {
+   if (ThickFluxDiv.Enabled)
+      require(AuxGroup::LayerThickness);
+}
+
+//------------------------------------------------------------------------------
+// Add the groups providing the inputs of each enabled velocity term
+void AuxDependencies::addTerms(const FusedVelocityTendOnEdge &VelocityTend) {
+   using Fused    = FusedVelocityTendOnEdge;
+   const I4 Terms = VelocityTend.getTerms();
+
+   // Vorticity and flux layer thickness on edges
+   if (Terms & Fused::PVAdv) {
+      require(AuxGroup::Vorticity);
+      require(AuxGroup::LayerThickness);
+   }
+   // Kinetic energy on cells
+   if (Terms & Fused::KEGrad)
+      require(AuxGroup::Kinetic);
+   // Sea surface height on cells
+   if (Terms & Fused::SSHGrad)
+      require(AuxGroup::LayerThickness);
+   // Velocity divergence on cells and relative vorticity on vertices
+   if (Terms & Fused::Del2) {
+      require(AuxGroup::Kinetic);
+      require(AuxGroup::Vorticity);
+   }
+   // Laplacians of the divergence and relative vorticity
+   if (Terms & Fused::Del4)
+      require(AuxGroup::VelocityDel2);
+   // Mean layer thickness on edges
+   if (Terms & Fused::Wind)
+      require(AuxGroup::LayerThickness);
+   // Kinetic energy on cells and mean layer thickness on edges
+   if (Terms & Fused::Drag) {
+      require(AuxGroup::Kinetic);
+      require(AuxGroup::LayerThickness);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Add the groups providing the inputs of each enabled tracer term
+void AuxDependencies::addTerms(const FusedTracerTendOnCell &TracerTend) {
+   using Fused    = FusedTracerTendOnCell;
+   const I4 Terms = TracerTend.getTerms();
+
+   // Thickness-weighted tracers on edges
+   if (Terms & Fused::HAdv)
+      require(AuxGroup::Tracer);
+   // Mean layer thickness on edges
+   if (Terms & Fused::Del2)
+      require(AuxGroup::LayerThickness);
+   // Laplacian of the tracers on cells
+   if (Terms & Fused::Del4)
+      require(AuxGroup::Tracer);
+}
+
+//------------------------------------------------------------------------------
+// Add a group if any of its fields is in an output stream
+void AuxDependencies::addStreamFields(
+    AuxGroup Group, const std::vector<std::string> &FieldNames) {
+   for (const std::string &FieldName : FieldNames) {
+      if (IOStream::isFieldWritten(FieldName)) {
+         require(Group);
+         return;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Check whether a group is needed
+bool AuxDependencies::isRequired(AuxGroup Group) const {
+   return Required[static_cast<int>(Group)];
+}
+
+//------------------------------------------------------------------------------
+// Invalidate all groups at the start of a stage
+void AuxDependencies::startStage() {
+   for (int I = 0; I < NAuxGroups; ++I)
+      Computed[I] = false;
+}
+
+//------------------------------------------------------------------------------
+// Return true the first time a needed group is used in a stage
+bool AuxDependencies::needsCompute(AuxGroup Group) {
+   const int I = static_cast<int>(Group);
+   if (!Required[I] or Computed[I])
+      return false;
+   Computed[I] = true;
+   return true;
+}
+
+} // namespace OMEGA
@@ -0,0 +1,93 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_AUXDEPENDENCIES_H
+#define OMEGA_AUXDEPENDENCIES_H
+//===-- ocn/AuxDependencies.h - aux variable dependencies -------*- C++ -*-===//
+//
+/// \file
+/// \brief Tracks which auxiliary variables are needed and when they are valid
+///
+/// The auxiliary state is made of groups of variables that are computed
+/// together, such as the kinetic energy and velocity divergence of
+/// KineticAuxVars. Not every group is used in every configuration: for
+/// example the Laplacians of VelocityDel2AuxVars are only read by the
+/// biharmonic mixing term. The AuxDependencies class collects the groups
+/// needed by the enabled tendency terms and by the fields written by output
+/// streams, including the groups that those depend on. During time stepping
+/// it also records which groups have been computed for the current stage,
+/// so that each needed group is computed at most once per stage and only
+/// when it is first used.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "TendencyTerms.h"
+
+#include <string>
+#include <vector>
+
+namespace OMEGA {
+
+/// Groups of auxiliary variables that are computed together
+enum class AuxGroup {
+   Kinetic,        ///< KineticAuxVars
+   LayerThickness, ///< LayerThicknessAuxVars
+   Vorticity,      ///< VorticityAuxVars
+   VelocityDel2,   ///< VelocityDel2AuxVars
+   Tracer          ///< TracerAuxVars
+};
+
+/// Number of auxiliary variable groups
+constexpr int NAuxGroups = 5;
+
+/// Needed auxiliary variable groups and their state in the current stage
+class AuxDependencies {
+ public:
+   /// Constructor starts with no groups needed
+   AuxDependencies();
+
+   /// Marks a group, and the groups it is computed from, as needed
+   void require(AuxGroup Group ///< [in] group needed
+   );
+
+   /// Adds the groups needed by the thickness flux divergence if enabled
+   void addTerms(const ThicknessFluxDivOnCell &ThickFluxDiv ///< [in] term
+   );
+
+   /// Adds the groups needed by the enabled terms of the velocity tendency
+   void addTerms(const FusedVelocityTendOnEdge &VelocityTend ///< [in] terms
+   );
+
+   /// Adds the groups needed by the enabled terms of the tracer tendency
+   void addTerms(const FusedTracerTendOnCell &TracerTend ///< [in] terms
+   );
+
+   /// Adds a group if any of its fields is written by an output stream
+   void addStreamFields(
+       AuxGroup Group,                            ///< [in] group of the fields
+       const std::vector<std::string> &FieldNames ///< [in] fields of group
+   );
+
+   /// Returns true if a group is needed
+   bool isRequired(AuxGroup Group ///< [in] group to check
+   ) const;
+
+   /// Starts a new stage, after which all groups need to be recomputed
+   void startStage();
+
+   /// Returns true if a needed group has not yet been computed in this
+   /// stage and marks it as computed, so the caller computes the group
+   /// whenever this returns true
+   bool needsCompute(AuxGroup Group ///< [in] group to be used
+   );
+
+ private:
+   bool Required[NAuxGroups]; ///< Groups needed in this configuration
+   bool Computed[NAuxGroups]; ///< Groups computed in the current stage
+};
+
+} // namespace OMEGA
+#endif
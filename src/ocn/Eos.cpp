@@ -6,9 +6,9 @@
 //===-- ocn/Eos.cpp - Equation of State ------------------*- C++ -*-===//
 //
 // The Eos class is responsible for managing the equation of state. It
-// has a linear EOS and TEOS-10 EOS option, which is determined at
-// initialization. It contains arrays that store the specific volume and
-// displaced specific volume data.
+// has a linear EOS, a TEOS-10 EOS and a tabulated TEOS-10 EOS option, which
+// is determined at initialization. It contains arrays that store the specific
+// volume and displaced specific volume data.
 //
 //===----------------------------------------------------------------------===//
 
@@ -19,19 +19,64 @@
 namespace OMEGA {
 
 /// Constructor for Teos10Eos
-Teos10Eos::Teos10Eos(int NVertLevels) : NVertLevels(NVertLevels) {
-   SpecVolPCoeffs = Array2DReal("SpecVolPCoeffs", 6, VecLength);
-}
+Teos10Eos::Teos10Eos(int NVertLevels) : NVertLevels(NVertLevels) {}
 
 /// Constructor for LinearEos
 LinearEos::LinearEos() {}
 
+/// Constructor for Teos10TableEos, the table is filled later by build
+Teos10TableEos::Teos10TableEos(int NVertLevels) : NVertLevels(NVertLevels) {}
+
+/// Fill the table from the TEOS-10 polynomial, one grid point per thread
+void Teos10TableEos::build(const Teos10Eos &Teos10, Real CtMin_, Real CtMax,
+                           I4 NCt_, Real SaMin_, Real SaMax, I4 NSa_,
+                           Real PMin_, Real PMax, I4 NP_) {
+
+   if (NCt_ < 2 or NSa_ < 2 or NP_ < 2)
+      ABORT_ERROR("Teos10TableEos::build: table needs at least two points "
+                  "in each coordinate");
+   if (CtMax <= CtMin_ or SaMax <= SaMin_ or PMax <= PMin_)
+      ABORT_ERROR("Teos10TableEos::build: table max must exceed table min");
+   // The polynomial uses sqrt(Sa + 24), which limits the salinity range
+   if (SaMin_ < 0.0)
+      ABORT_ERROR("Teos10TableEos::build: negative table salinity");
+
+   CtMin  = CtMin_;
+   SaMin  = SaMin_;
+   PMin   = PMin_;
+   NCt    = NCt_;
+   NSa    = NSa_;
+   NP     = NP_;
+   InvDCt = (NCt - 1) / (CtMax - CtMin);
+   InvDSa = (NSa - 1) / (SaMax - SaMin);
+   InvDP  = (NP - 1) / (PMax - PMin);
+   Table  = Array3DReal("Teos10Table", NP, NSa, NCt);
+
+   const auto &LocTable = Table;
+   const Real DCt       = 1.0_Real / InvDCt;
+   const Real DSa       = 1.0_Real / InvDSa;
+   const Real DP        = 1.0_Real / InvDP;
+   const Real LocCtMin  = CtMin;
+   const Real LocSaMin  = SaMin;
+   const Real LocPMin   = PMin;
+
+   parallelFor(
+       "eos-teos10-table-build", {NP, NSa, NCt},
+       KOKKOS_LAMBDA(I4 IP, I4 ISa, I4 ICt) {
+          Real PCoeffs[Teos10Eos::NPCoeffs];
+          Teos10.calcPCoeffs(PCoeffs, LocCtMin + ICt * DCt,
+                             LocSaMin + ISa * DSa);
+          LocTable(IP, ISa, ICt) =
+              Teos10.calcSpecVolAtP(PCoeffs, LocPMin + IP * DP);
+       });
+}
+
 /// Constructor for Eos
 Eos::Eos(const std::string &Name_, ///< [in] Name for eos object
          const HorzMesh *Mesh,     ///< [in] Horizontal mesh
          int NVertLevels           ///< [in] Number of vertical levels
          )
-    : ComputeSpecVolTeos10(NVertLevels) {
+    : ComputeSpecVolTeos10(NVertLevels), ComputeSpecVolTable(NVertLevels) {
    SpecVol = Array2DReal("SpecVol", Mesh->NCellsAll, NVertLevels);
    SpecVolDisplaced =
        Array2DReal("SpecVolDisplaced", Mesh->NCellsAll, NVertLevels);
@@ -110,11 +155,50 @@ void Eos::init() {
    } else if ((EosTypeStr == "teos10") or (EosTypeStr == "teos-10") or
               (EosTypeStr == "TEOS-10")) {
       eos->EosChoice = EosType::Teos10Eos;
+   } else if ((EosTypeStr == "teos10table") or
+              (EosTypeStr == "Teos10Table")) {
+      eos->EosChoice = EosType::Teos10TableEos;
+      eos->initTeos10Table();
    } else {
       LOG_ERROR("Eos::init: Unknown EosType requested");
    }
 } // end init
 
+/// Reads the table grid from the Teos10Table config group and fills the
+/// table of the tabulated TEOS-10 EOS
+void Eos::initTeos10Table() {
+
+   Error Err; // error code
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   Config EosConfig("Eos");
+   Err += OmegaConfig->get(EosConfig);
+   Config TableConfig("Teos10Table");
+   Err += EosConfig.get(TableConfig);
+   CHECK_ERROR_ABORT(Err, "Eos::initTeos10Table: Teos10Table subgroup not "
+                          "found in EosConfig");
+
+   R8 CtMin, CtMax, SaMin, SaMax, PMin, PMax;
+   I4 NCt, NSa, NP;
+   Err += TableConfig.get("CtMin", CtMin);
+   Err += TableConfig.get("CtMax", CtMax);
+   Err += TableConfig.get("NCt", NCt);
+   Err += TableConfig.get("SaMin", SaMin);
+   Err += TableConfig.get("SaMax", SaMax);
+   Err += TableConfig.get("NSa", NSa);
+   Err += TableConfig.get("PMin", PMin);
+   Err += TableConfig.get("PMax", PMax);
+   Err += TableConfig.get("NP", NP);
+   CHECK_ERROR_ABORT(
+       Err, "Eos::initTeos10Table: missing parameter in Teos10Table group");
+
+   ComputeSpecVolTable.build(ComputeSpecVolTeos10, CtMin, CtMax, NCt, SaMin,
+                             SaMax, NSa, PMin, PMax, NP);
+
+   LOG_INFO("Eos: TEOS-10 table of {} x {} x {} points ({} MB)", NCt, NSa, NP,
+            Real(NCt) * NSa * NP * sizeof(Real) / 1.0e6);
+}
+
 /// Compute specific volume for all cells/levels (no displacement)
 void Eos::computeSpecVol(const Array2DReal &ConservTemp,
                          const Array2DReal &AbsSalinity,
@@ -124,7 +208,8 @@ void Eos::computeSpecVol(const Array2DReal &ConservTemp,
                ComputeSpecVolLinear); /// Local view for linear EOS computation
    OMEGA_SCOPE(LocComputeSpecVolTeos10,
                ComputeSpecVolTeos10); /// Local view for TEOS-10 computation
-   deepCopy(LocSpecVol, 0); /// Initialize local specific volume to zero
+   OMEGA_SCOPE(LocComputeSpecVolTable,
+               ComputeSpecVolTable); /// Local view for tabulated TEOS-10
 
    I4 KDisp = 0; /// No displacement in this case
 
@@ -143,6 +228,13 @@ void Eos::computeSpecVol(const Array2DReal &ConservTemp,
              LocComputeSpecVolTeos10(LocSpecVol, ICell, KChunk, ConservTemp,
                                      AbsSalinity, Pressure, KDisp);
           });
+   } else if (EosChoice == EosType::Teos10TableEos) {
+      parallelFor(
+          "eos-teos10-table", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(I4 ICell, I4 KChunk) {
+             LocComputeSpecVolTable(LocSpecVol, ICell, KChunk, ConservTemp,
+                                    AbsSalinity, Pressure, KDisp);
+          });
    }
 }
 
@@ -156,8 +248,8 @@ void Eos::computeSpecVolDisp(const Array2DReal &ConservTemp,
                ComputeSpecVolLinear); /// Local view for linear EOS computation
    OMEGA_SCOPE(LocComputeSpecVolTeos10,
                ComputeSpecVolTeos10); /// Local view for TEOS-10 computation
-   deepCopy(LocSpecVolDisplaced,
-            0); /// Initialize local specific volume to zero
+   OMEGA_SCOPE(LocComputeSpecVolTable,
+               ComputeSpecVolTable); /// Local view for tabulated TEOS-10
 
    /// Dispatch to the correct EOS calculation
    /// If EosChoice is Linear, the displaced specific
@@ -179,6 +271,55 @@ void Eos::computeSpecVolDisp(const Array2DReal &ConservTemp,
              LocComputeSpecVolTeos10(LocSpecVolDisplaced, ICell, KChunk,
                                      ConservTemp, AbsSalinity, Pressure, KDisp);
           });
+   } else if (EosChoice == EosType::Teos10TableEos) {
+      parallelFor(
+          "eos-teos10-table", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(I4 ICell, I4 KChunk) {
+             LocComputeSpecVolTable(LocSpecVolDisplaced, ICell, KChunk,
+                                    ConservTemp, AbsSalinity, Pressure, KDisp);
+          });
+   }
+}
+
+/// Compute the specific volume and the displaced specific volume together.
+/// Every level is written by the kernels, so the arrays are not initialized.
+void Eos::computeSpecVolAndDisp(const Array2DReal &ConservTemp,
+                                const Array2DReal &AbsSalinity,
+                                const Array2DReal &Pressure, I4 KDisp) {
+   OMEGA_SCOPE(LocSpecVol, SpecVol); /// Local view for computation
+   OMEGA_SCOPE(LocSpecVolDisplaced,
+               SpecVolDisplaced); /// Local view for computation
+   OMEGA_SCOPE(LocComputeSpecVolLinear,
+               ComputeSpecVolLinear); /// Local view for linear EOS computation
+   OMEGA_SCOPE(LocComputeSpecVolTeos10,
+               ComputeSpecVolTeos10); /// Local view for TEOS-10 computation
+   OMEGA_SCOPE(LocComputeSpecVolTable,
+               ComputeSpecVolTable); /// Local view for tabulated TEOS-10
+
+   /// Dispatch to the correct EOS calculation
+   if (EosChoice == EosType::LinearEos) {
+      parallelFor(
+          "eos-linear-both", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(I4 ICell, I4 KChunk) {
+             LocComputeSpecVolLinear(LocSpecVol, LocSpecVolDisplaced, ICell,
+                                     KChunk, ConservTemp, AbsSalinity);
+          });
+   } else if (EosChoice == EosType::Teos10Eos) {
+      parallelFor(
+          "eos-teos10-both", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(I4 ICell, I4 KChunk) {
+             LocComputeSpecVolTeos10(LocSpecVol, LocSpecVolDisplaced, ICell,
+                                     KChunk, ConservTemp, AbsSalinity, Pressure,
+                                     KDisp);
+          });
+   } else if (EosChoice == EosType::Teos10TableEos) {
+      parallelFor(
+          "eos-teos10-table-both", {NCellsAll, NChunks},
+          KOKKOS_LAMBDA(I4 ICell, I4 KChunk) {
+             LocComputeSpecVolTable(LocSpecVol, LocSpecVolDisplaced, ICell,
+                                    KChunk, ConservTemp, AbsSalinity, Pressure,
+                                    KDisp);
+          });
    }
 }
 
@@ -20,20 +20,23 @@
 #include "HorzMesh.h"
 #include "MachEnv.h"
 #include "OmegaKokkos.h"
+#include "OmegaSimd.h"
 #include "TimeMgr.h"
 #include <string>
 
 namespace OMEGA {
 
 enum class EosType {
-   LinearEos, /// Linear equation of state
-   Teos10Eos  /// Roquet et al. 2015 75 term expansion
+   LinearEos,     /// Linear equation of state
+   Teos10Eos,     /// Roquet et al. 2015 75 term expansion
+   Teos10TableEos /// TEOS-10 tabulated on a (Ct, Sa, P) grid
 };
 
 /// TEOS10 75-term Polynomial Equation of State
 class Teos10Eos {
  public:
-   Array2DReal SpecVolPCoeffs;
+   /// Number of coefficients of the pressure polynomial
+   static constexpr int NPCoeffs = 6;
 
    /// constructor declaration
    Teos10Eos(int NVertLevels);
@@ -48,46 +51,112 @@ class Teos10Eos {
                                    const Array2DReal &Pressure,
                                    I4 KDisp) const {
 
-      OMEGA_SCOPE(LocSpecVolPCoeffs, SpecVolPCoeffs);
       const I4 KStart = KChunk * VecLength;
+#ifdef OMEGA_SIMD
+      SimdReal PCoeffs[NPCoeffs];
+      calcPCoeffs(PCoeffs, loadChunk(ConservTemp, ICell, KStart),
+                  loadChunk(AbsSalinity, ICell, KStart));
+      storeChunk(SpecVol, ICell, KStart,
+                 calcSpecVolAtP(PCoeffs,
+                                loadDispChunk(Pressure, ICell, KStart, KDisp)));
+#else
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
 
          /// Calculate the local specific volume polynomial pressure
-         /// coefficients
-         calcPCoeffs(LocSpecVolPCoeffs, KVec, ConservTemp(ICell, K),
-                     AbsSalinity(ICell, K));
+         /// coefficients. These are private to each thread and are kept in
+         /// registers.
+         Real PCoeffs[NPCoeffs];
+         calcPCoeffs(PCoeffs, ConservTemp(ICell, K), AbsSalinity(ICell, K));
 
          /// Calculate the specific volume at the given pressure
          /// If KDisp is 0, we use the current pressure, otherwise we use the
          /// displaced pressure (K + KDisp)
          /// Note: KDisp is only used for TEOS-10, for Linear EOS it
          /// is always 0.
-         if (KDisp == 0) {
-            // No displacement
-            SpecVol(ICell, K) =
-                calcRefProfile(Pressure(ICell, K)) +
-                calcDelta(LocSpecVolPCoeffs, KVec, Pressure(ICell, K));
-         } else {
-            // Displacement, use the displaced pressure
-            I4 KTmp = Kokkos::min(K + KDisp, NVertLevels - 1);
-            KTmp    = Kokkos::max(0, KTmp);
-            SpecVol(ICell, K) =
-                calcRefProfile(Pressure(ICell, KTmp)) +
-                calcDelta(LocSpecVolPCoeffs, KVec, Pressure(ICell, KTmp));
-         }
+         const I4 KP       = calcDispLevel(K, KDisp);
+         SpecVol(ICell, K) = calcSpecVolAtP(PCoeffs, Pressure(ICell, KP));
       }
+#endif
+   }
+
+   //   The functor variant for both the local and the displaced specific
+   //   volume. The temperature and salinity dependent coefficients are
+   //   computed once for each cell and level and evaluated at the local
+   //   pressure and at the pressure of level K + KDisp.
+   KOKKOS_FUNCTION void operator()(Array2DReal SpecVol,
+                                   Array2DReal SpecVolDisplaced, I4 ICell,
+                                   I4 KChunk, const Array2DReal &ConservTemp,
+                                   const Array2DReal &AbsSalinity,
+                                   const Array2DReal &Pressure,
+                                   I4 KDisp) const {
+
+      const I4 KStart = KChunk * VecLength;
+#ifdef OMEGA_SIMD
+      SimdReal PCoeffs[NPCoeffs];
+      calcPCoeffs(PCoeffs, loadChunk(ConservTemp, ICell, KStart),
+                  loadChunk(AbsSalinity, ICell, KStart));
+      storeChunk(SpecVol, ICell, KStart,
+                 calcSpecVolAtP(PCoeffs, loadChunk(Pressure, ICell, KStart)));
+      storeChunk(SpecVolDisplaced, ICell, KStart,
+                 calcSpecVolAtP(PCoeffs,
+                                loadDispChunk(Pressure, ICell, KStart, KDisp)));
+#else
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K = KStart + KVec;
+
+         Real PCoeffs[NPCoeffs];
+         calcPCoeffs(PCoeffs, ConservTemp(ICell, K), AbsSalinity(ICell, K));
+
+         const I4 KP = calcDispLevel(K, KDisp);
+
+         SpecVol(ICell, K) = calcSpecVolAtP(PCoeffs, Pressure(ICell, K));
+
+         SpecVolDisplaced(ICell, K) =
+             calcSpecVolAtP(PCoeffs, Pressure(ICell, KP));
+      }
+#endif
+   }
+
+   /// Returns the level K + KDisp limited to the vertical levels
+   KOKKOS_FUNCTION I4 calcDispLevel(const I4 K, const I4 KDisp) const {
+      return Kokkos::max(0, Kokkos::min(K + KDisp, NVertLevels - 1));
+   }
+
+#ifdef OMEGA_SIMD
+   /// Loads the pressure of the levels K + KDisp limited to the vertical
+   /// levels for the levels K of a chunk. The displaced levels of the top
+   /// and bottom chunks repeat, so they are gathered one level at a time.
+   KOKKOS_FUNCTION SimdReal loadDispChunk(const Array2DReal &Pressure,
+                                          const I4 ICell, const I4 KStart,
+                                          const I4 KDisp) const {
+      return SimdReal([&](std::size_t KVec) {
+         return Pressure(ICell, calcDispLevel(KStart + KVec, KDisp));
+      });
+   }
+#endif
+
+   /// The helpers below are templates on the value type, which is Real for a
+   /// single level or SimdReal for a vertical chunk with OMEGA_SIMD.
+
+   /// Evaluates the specific volume at pressure P from the pressure
+   /// polynomial coefficients of a cell and level
+   template <class T>
+   KOKKOS_FUNCTION T calcSpecVolAtP(const T (&PCoeffs)[NPCoeffs],
+                                    const T &P) const {
+      return calcRefProfile(P) + calcDelta(PCoeffs, P);
    }
 
    /// TEOS-10 helpers
    /// Calculate pressure polynomial coefficients for TEOS-10
-   KOKKOS_FUNCTION void calcPCoeffs(Array2DReal SpecVolPCoeffs, const I4 K,
-                                    const Real Ct, const Real Sa) const {
+   template <class T>
+   KOKKOS_FUNCTION void calcPCoeffs(T (&PCoeffs)[NPCoeffs], const T &Ct,
+                                    const T &Sa) const {
       constexpr Real SAu    = 40.0 * 35.16504 / 35.0;
       constexpr Real CTu    = 40.0;
       constexpr Real DeltaS = 24.0;
-      Real Ss               = Kokkos::sqrt((Sa + DeltaS) / SAu);
-      Real Tt               = Ct / CTu;
+      const T Ss            = Kokkos::sqrt((Sa + DeltaS) / SAu);
+      const T Tt            = Ct / CTu;
 
       /// Coefficients for the polynomial expansion
       constexpr Real V000 = 1.0769995862e-03;
@@ -165,18 +234,18 @@ class Teos10Eos {
       constexpr Real V014 = 3.1454099902e-07;
       constexpr Real V005 = 4.2369007180e-09;
 
-      SpecVolPCoeffs(5, K) = V005;
-      SpecVolPCoeffs(4, K) = V014 * Tt + V104 * Ss + V004;
-      SpecVolPCoeffs(3, K) =
+      PCoeffs[5] = V005;
+      PCoeffs[4] = V014 * Tt + V104 * Ss + V004;
+      PCoeffs[3] =
           (V023 * Tt + V113 * Ss + V013) * Tt + (V203 * Ss + V103) * Ss + V003;
-      SpecVolPCoeffs(2, K) =
+      PCoeffs[2] =
           (((V042 * Tt + V132 * Ss + V032) * Tt + (V222 * Ss + V122) * Ss +
             V022) *
                Tt +
            ((V312 * Ss + V212) * Ss + V112) * Ss + V012) *
               Tt +
           (((V402 * Ss + V302) * Ss + V202) * Ss + V102) * Ss + V002;
-      SpecVolPCoeffs(1, K) =
+      PCoeffs[1] =
           ((((V051 * Tt + V141 * Ss + V041) * Tt + (V231 * Ss + V131) * Ss +
              V031) *
                 Tt +
@@ -186,7 +255,7 @@ class Teos10Eos {
               Tt +
           ((((V501 * Ss + V401) * Ss + V301) * Ss + V201) * Ss + V101) * Ss +
           V001;
-      SpecVolPCoeffs(0, K) =
+      PCoeffs[0] =
           (((((V060 * Tt + V150 * Ss + V050) * Tt + (V240 * Ss + V140) * Ss +
               V040) *
                  Tt +
@@ -206,25 +275,22 @@ class Teos10Eos {
    }
 
    /// Evaluate pressure polynomial delta for TEOS-10
-   KOKKOS_FUNCTION Real calcDelta(const Array2DReal &SpecVolPCoeffs, const I4 K,
-                                  const Real P) const {
+   template <class T>
+   KOKKOS_FUNCTION T calcDelta(const T (&PCoeffs)[NPCoeffs],
+                               const T &P) const {
 
       constexpr Real Pu = 1e4;
-      Real Pp           = P / Pu;
-
-      Real Delta = ((((SpecVolPCoeffs(5, K) * Pp + SpecVolPCoeffs(4, K)) * Pp +
-                      SpecVolPCoeffs(3, K)) *
-                         Pp +
-                     SpecVolPCoeffs(2, K)) *
-                        Pp +
-                    SpecVolPCoeffs(1, K)) *
-                       Pp +
-                   SpecVolPCoeffs(0, K);
+      const T Pp        = P / Pu;
+
+      // Horner evaluation from the highest order coefficient
+      T Delta = PCoeffs[NPCoeffs - 1];
+      for (int N = NPCoeffs - 2; N >= 0; --N)
+         Delta = Delta * Pp + PCoeffs[N];
       return Delta;
    }
 
    /// Calculate reference profile for TEOS-10
-   KOKKOS_FUNCTION Real calcRefProfile(Real P) const {
+   template <class T> KOKKOS_FUNCTION T calcRefProfile(const T &P) const {
       constexpr Real Pu  = 1e4;
       constexpr Real V00 = -4.4015007269e-05;
       constexpr Real V01 = 6.9232335784e-06;
@@ -232,9 +298,9 @@ class Teos10Eos {
       constexpr Real V03 = 1.7009109288e-08;
       constexpr Real V04 = -1.6884162004e-08;
       constexpr Real V05 = 1.9613503930e-09;
-      Real Pp            = P / Pu;
+      const T Pp         = P / Pu;
 
-      Real V0 =
+      const T V0 =
           (((((V05 * Pp + V04) * Pp + V03) * Pp + V02) * Pp + V01) * Pp + V00) *
           Pp;
       return V0;
@@ -263,12 +329,161 @@ class LinearEos {
                                    const Array2DReal &ConservTemp,
                                    const Array2DReal &AbsSalinity) const {
       const I4 KStart = KChunk * VecLength;
+#ifdef OMEGA_SIMD
+      const SimdReal Ct = loadChunk(ConservTemp, ICell, KStart);
+      const SimdReal Sa = loadChunk(AbsSalinity, ICell, KStart);
+      storeChunk(SpecVol, ICell, KStart,
+                 1.0_Real / (RhoT0S0 + (DRhodT * Ct + DRhodS * Sa)));
+#else
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
          SpecVol(ICell, K) =
              1.0_Real / (RhoT0S0 + (DRhodT * ConservTemp(ICell, K) +
                                     DRhodS * AbsSalinity(ICell, K)));
       }
+#endif
+   }
+
+   //   The functor variant for both the local and the displaced specific
+   //   volume, which are the same for the linear EOS
+   KOKKOS_FUNCTION void operator()(Array2DReal SpecVol,
+                                   Array2DReal SpecVolDisplaced, I4 ICell,
+                                   I4 KChunk, const Array2DReal &ConservTemp,
+                                   const Array2DReal &AbsSalinity) const {
+      operator()(SpecVol, ICell, KChunk, ConservTemp, AbsSalinity);
+      const I4 KStart = KChunk * VecLength;
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K                 = KStart + KVec;
+         SpecVolDisplaced(ICell, K) = SpecVol(ICell, K);
+      }
+   }
+};
+
+/// Tabulated TEOS-10 Equation of State
+///
+/// The TEOS-10 specific volume is evaluated once at initialization on a
+/// regular grid of conservative temperature, absolute salinity and pressure
+/// and stored in a device array. The functors then interpolate trilinearly
+/// in the table, which replaces the 75 term polynomial by eight table reads.
+/// Values outside the table range are taken at the nearest table edge, so
+/// the table range should cover the expected state.
+class Teos10TableEos {
+ public:
+   Array3DReal Table; ///< Specific volume at the grid points (P, Sa, Ct)
+
+   /// constructor declaration
+   Teos10TableEos(int NVertLevels);
+
+   /// Fills the table on a grid of NCt x NSa x NP points from the TEOS-10
+   /// polynomial. Each grid needs at least two points.
+   void build(const Teos10Eos &Teos10, ///< [in] TEOS-10 polynomial
+              Real CtMin,              ///< [in] min conservative temperature
+              Real CtMax,              ///< [in] max conservative temperature
+              I4 NCt,                  ///< [in] number of temperature points
+              Real SaMin,              ///< [in] min absolute salinity
+              Real SaMax,              ///< [in] max absolute salinity
+              I4 NSa,                  ///< [in] number of salinity points
+              Real PMin,               ///< [in] min pressure
+              Real PMax,               ///< [in] max pressure
+              I4 NP                    ///< [in] number of pressure points
+   );
+
+   //   The functor takes the full arrays of specific volume (inout),
+   //   the indices ICell and KChunk, and the ocean tracers (conservative)
+   //   temperature, and (absolute) salinity as inputs, and outputs the
+   //   specific volume interpolated from the table at the pressure of level
+   //   K + KDisp.
+   KOKKOS_FUNCTION void operator()(Array2DReal SpecVol, I4 ICell, I4 KChunk,
+                                   const Array2DReal &ConservTemp,
+                                   const Array2DReal &AbsSalinity,
+                                   const Array2DReal &Pressure,
+                                   I4 KDisp) const {
+
+      const I4 KStart = KChunk * VecLength;
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K        = KStart + KVec;
+         const I4 KP       = calcDispLevel(K, KDisp);
+         SpecVol(ICell, K) = interpSpecVol(
+             ConservTemp(ICell, K), AbsSalinity(ICell, K), Pressure(ICell, KP));
+      }
+   }
+
+   //   The functor variant for both the local and the displaced specific
+   //   volume
+   KOKKOS_FUNCTION void operator()(Array2DReal SpecVol,
+                                   Array2DReal SpecVolDisplaced, I4 ICell,
+                                   I4 KChunk, const Array2DReal &ConservTemp,
+                                   const Array2DReal &AbsSalinity,
+                                   const Array2DReal &Pressure,
+                                   I4 KDisp) const {
+
+      const I4 KStart = KChunk * VecLength;
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K    = KStart + KVec;
+         const I4 KP   = calcDispLevel(K, KDisp);
+         const Real Ct = ConservTemp(ICell, K);
+         const Real Sa = AbsSalinity(ICell, K);
+
+         SpecVol(ICell, K) = interpSpecVol(Ct, Sa, Pressure(ICell, K));
+
+         SpecVolDisplaced(ICell, K) =
+             interpSpecVol(Ct, Sa, Pressure(ICell, KP));
+      }
+   }
+
+   /// Returns the level K + KDisp limited to the vertical levels
+   KOKKOS_FUNCTION I4 calcDispLevel(const I4 K, const I4 KDisp) const {
+      return Kokkos::max(0, Kokkos::min(K + KDisp, NVertLevels - 1));
+   }
+
+   /// Interpolates the specific volume trilinearly from the table
+   KOKKOS_FUNCTION Real interpSpecVol(const Real Ct, const Real Sa,
+                                      const Real P) const {
+      I4 ICt, ISa, IP;
+      Real WCt, WSa, WP;
+      locate(ICt, WCt, Ct, CtMin, InvDCt, NCt);
+      locate(ISa, WSa, Sa, SaMin, InvDSa, NSa);
+      locate(IP, WP, P, PMin, InvDP, NP);
+
+      // Interpolate in temperature, then salinity, then pressure
+      const Real V00 = lerp(Table(IP, ISa, ICt), Table(IP, ISa, ICt + 1), WCt);
+      const Real V01 =
+          lerp(Table(IP, ISa + 1, ICt), Table(IP, ISa + 1, ICt + 1), WCt);
+      const Real V10 =
+          lerp(Table(IP + 1, ISa, ICt), Table(IP + 1, ISa, ICt + 1), WCt);
+      const Real V11 = lerp(Table(IP + 1, ISa + 1, ICt),
+                            Table(IP + 1, ISa + 1, ICt + 1), WCt);
+
+      return lerp(lerp(V00, V01, WSa), lerp(V10, V11, WSa), WP);
+   }
+
+ private:
+   const int NVertLevels;
+
+   Real CtMin  = 0.0; ///< Table origin and inverse spacing in temperature
+   Real InvDCt = 1.0;
+   Real SaMin  = 0.0; ///< Table origin and inverse spacing in salinity
+   Real InvDSa = 1.0;
+   Real PMin   = 0.0; ///< Table origin and inverse spacing in pressure
+   Real InvDP  = 1.0;
+   I4 NCt      = 0; ///< Number of grid points in each coordinate
+   I4 NSa      = 0;
+   I4 NP       = 0;
+
+   /// Finds the lower grid index and the interpolation weight of X, limited
+   /// to the table range
+   KOKKOS_FUNCTION static void locate(I4 &I, Real &W, const Real X,
+                                      const Real XMin, const Real InvDX,
+                                      const I4 N) {
+      const Real XGrid =
+          Kokkos::min(Kokkos::max((X - XMin) * InvDX, 0._Real), Real(N - 1));
+      I = Kokkos::min(static_cast<I4>(XGrid), N - 2);
+      W = XGrid - I;
+   }
+
+   KOKKOS_FUNCTION static Real lerp(const Real A, const Real B,
+                                    const Real W) {
+      return A + W * (B - A);
    }
 };
 
@@ -301,9 +516,19 @@ class Eos {
                            const Array2DReal &AbsSalinity,
                            const Array2DReal &Pressure, I4 KDisp);
 
+   /// Compute both the specific volume and the displaced specific volume in
+   /// one pass, sharing the temperature and salinity dependent terms
+   void computeSpecVolAndDisp(const Array2DReal &ConservTemp,
+                              const Array2DReal &AbsSalinity,
+                              const Array2DReal &Pressure, I4 KDisp);
+
    /// Initialize EOS from config and mesh
    static void init();
 
+   /// Build the TEOS-10 table from the Eos:Teos10Table config group. This is
+   /// called by init when the table EOS is selected.
+   void initTeos10Table();
+
  private:
    /// Private constructor
    Eos(const std::string &Name, const HorzMesh *Mesh, int NVertLevels);
@@ -323,8 +548,9 @@ class Eos {
    I4 NCellsAll; ///< Number of horizontal cells
    I4 NChunks;   ///< Number of vertical chunks (for vectorization)
 
-   Teos10Eos ComputeSpecVolTeos10; ///< TEOS-10 specific volume calculator
-   LinearEos ComputeSpecVolLinear; ///< Linear specific volume calculator
+   Teos10Eos ComputeSpecVolTeos10;     ///< TEOS-10 specific volume calculator
+   LinearEos ComputeSpecVolLinear;     ///< Linear specific volume calculator
+   Teos10TableEos ComputeSpecVolTable; ///< Tabulated TEOS-10 calculator
 
    // Define fields and metadata
    void defineFields();
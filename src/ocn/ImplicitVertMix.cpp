@@ -0,0 +1,379 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- ocn/ImplicitVertMix.cpp - implicit vertical mixing ------*- C++ -*-===//
+//
+// Solves the backward Euler vertical diffusion equation in all owned columns
+// with a batched Thomas algorithm. For level K of a column with thickness h
+// and the coefficient kappa at the top of each level, the system is
+//
+//   -A_K phi_{K-1} + (h_K + A_K + A_{K+1}) phi_K - A_{K+1} phi_{K+1}
+//      = h_K phi_K^{old},   A_K = Dt kappa_K / (0.5 (h_{K-1} + h_K))
+//
+// with A_K = 0 at the first active level and A_{K+1} = 0 at the last.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ImplicitVertMix.h"
+#include "Config.h"
+#include "Decomp.h"
+#include "Error.h"
+#include "IO.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+#include "StencilCoeffs.h"
+#include "Timing.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace OMEGA {
+
+// Default instance, created by init if mixing is enabled
+std::unique_ptr<ImplicitVertMix> ImplicitVertMix::DefaultInstance;
+
+//------------------------------------------------------------------------------
+// Read the options from the optional ImplicitVertMix group of the Omega
+// Config and create the default instance if mixing is enabled
+void ImplicitVertMix::init() {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("ImplicitVertMix"))
+      return;
+
+   Config MixConfig("ImplicitVertMix");
+   Error Err = OmegaConfig->get(MixConfig);
+   CHECK_ERROR_ABORT(Err, "ImplicitVertMix: error reading ImplicitVertMix "
+                          "group");
+
+   bool Enabled;
+   Err += MixConfig.get("Enabled", Enabled);
+   CHECK_ERROR_ABORT(Err, "ImplicitVertMix: Enabled not found in "
+                          "ImplicitVertMix Config");
+   if (!Enabled)
+      return;
+
+   Real BackgroundDiff;
+   Real BackgroundVisc;
+   Err += MixConfig.get("BackgroundDiffusivity", BackgroundDiff);
+   Err += MixConfig.get("BackgroundViscosity", BackgroundVisc);
+   CHECK_ERROR_ABORT(Err, "ImplicitVertMix: BackgroundDiffusivity or "
+                          "BackgroundViscosity not found in ImplicitVertMix "
+                          "Config");
+
+   if (BackgroundDiff < 0 or BackgroundVisc < 0)
+      ABORT_ERROR("ImplicitVertMix: background diffusivity {} and viscosity "
+                  "{} must not be negative",
+                  BackgroundDiff, BackgroundVisc);
+
+   DefaultInstance = std::make_unique<ImplicitVertMix>(
+       HorzMesh::getDefault(), BackgroundDiff, BackgroundVisc);
+
+   LOG_INFO("ImplicitVertMix: enabled with background diffusivity {} and "
+            "viscosity {}",
+            BackgroundDiff, BackgroundVisc);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Return the default instance or null if mixing is disabled
+ImplicitVertMix *ImplicitVertMix::getDefault() { return DefaultInstance.get(); }
+
+//------------------------------------------------------------------------------
+// Remove the default instance
+void ImplicitVertMix::clear() { DefaultInstance.reset(); }
+
+//------------------------------------------------------------------------------
+// Read the 1-based first and last active level of each owned cell from the
+// mesh file of the default decomposition, under the Omega and then the older
+// MPAS names, and convert them to 0-based levels. The first level defaults to
+// the top if it is not in the file. Returns an error if the last level is not
+// in the file.
+static int readCellLevels(I4 NVertLevels,            // [in] num of levels
+                          const Array1DI4 &MinLevel, // [out] first level
+                          const Array1DI4 &MaxLevel  // [out] last level
+) {
+
+   int Err           = 0;
+   const Decomp *Dcp = Decomp::getDefault();
+   const I4 NCells   = Dcp->NCellsSize;
+
+   int FileID;
+   Err = IO::openFile(FileID, Dcp->MeshFileName, IO::ModeRead);
+   if (Err != 0) {
+      LOG_ERROR("ImplicitVertMix: error opening mesh file {}",
+                Dcp->MeshFileName);
+      return Err;
+   }
+
+   // Only the owned cells are read
+   std::vector<I4> Dims{Dcp->NCellsGlobal};
+   std::vector<I4> Offset(NCells, -1);
+   for (int Cell = 0; Cell < Dcp->NCellsOwned; ++Cell)
+      Offset[Cell] = Dcp->CellIDH(Cell) - 1;
+   I4 LevelDecomp;
+   Err = IO::createDecomp(LevelDecomp, IO::IOTypeI4, 1, Dims, NCells, Offset,
+                          IO::RearrBox);
+   if (Err != 0) {
+      LOG_ERROR("ImplicitVertMix: error creating cell level decomposition");
+      IO::closeFile(FileID);
+      return Err;
+   }
+
+   std::vector<I4> MinLevelIn(NCells, 1);
+   std::vector<I4> MaxLevelIn(NCells, 0);
+   int VarID;
+   Err = IO::readArray(&MaxLevelIn[0], NCells, "MaxLevelCell", FileID,
+                       LevelDecomp, VarID);
+   if (Err != 0) // not found, try again under older name
+      Err = IO::readArray(&MaxLevelIn[0], NCells, "maxLevelCell", FileID,
+                          LevelDecomp, VarID);
+   if (Err == 0) {
+      int ErrMin = IO::readArray(&MinLevelIn[0], NCells, "MinLevelCell",
+                                 FileID, LevelDecomp, VarID);
+      if (ErrMin != 0)
+         ErrMin = IO::readArray(&MinLevelIn[0], NCells, "minLevelCell",
+                                FileID, LevelDecomp, VarID);
+      if (ErrMin != 0)
+         std::fill(MinLevelIn.begin(), MinLevelIn.end(), 1);
+   }
+
+   IO::destroyDecomp(LevelDecomp);
+   IO::closeFile(FileID);
+   if (Err != 0)
+      return Err;
+
+   // Cells beyond the owned cells are not mixed
+   HostArray1DI4 MinLevelH("MinLevelH", MinLevel.extent(0));
+   HostArray1DI4 MaxLevelH("MaxLevelH", MaxLevel.extent(0));
+   for (int Cell = 0; Cell < MinLevelH.extent_int(0); ++Cell) {
+      const bool Owned = Cell < Dcp->NCellsOwned;
+      MinLevelH(Cell)  = Owned ? std::max(MinLevelIn[Cell] - 1, 0) : 0;
+      MaxLevelH(Cell) =
+          Owned ? std::min(MaxLevelIn[Cell] - 1, NVertLevels - 1) : -1;
+   }
+   deepCopy(MinLevel, MinLevelH);
+   deepCopy(MaxLevel, MaxLevelH);
+
+   return Err;
+
+} // end readCellLevels
+
+//------------------------------------------------------------------------------
+// Allocate the coefficients and work arrays. The columns of the cells span
+// the active levels of each cell read from the mesh file. The edge-based
+// level ranges of the stencil coefficients can end above the bottom of a
+// cell that is deeper than its neighbors, so they are only used for the
+// cells if the mesh file has no active levels. The edge ranges are shared
+// with the stencil coefficients.
+ImplicitVertMix::ImplicitVertMix(const HorzMesh *Mesh, Real BackgroundDiff,
+                                 Real BackgroundVisc)
+    : NCellsOwned(Mesh->NCellsOwned), NEdgesOwned(Mesh->NEdgesOwned),
+      NVertLevels(Mesh->NVertLevels), CellsOnEdge(Mesh->CellsOnEdge) {
+
+   const StencilCoeffs *Coeffs = StencilCoeffs::get(Mesh);
+   MinLevelEdge                = Coeffs->MinLevelEdge;
+   MaxLevelEdge                = Coeffs->MaxLevelEdge;
+
+   MinLevelCell = Array1DI4("VertMixMinLevelCell", Mesh->NCellsSize);
+   MaxLevelCell = Array1DI4("VertMixMaxLevelCell", Mesh->NCellsSize);
+   if (readCellLevels(NVertLevels, MinLevelCell, MaxLevelCell) != 0) {
+      LOG_WARN("ImplicitVertMix: MaxLevelCell not found in mesh file, using "
+               "the active levels of the cell edges");
+      MinLevelCell = Coeffs->MinLevelCell;
+      MaxLevelCell = Coeffs->MaxLevelCell;
+   }
+
+   VertDiff = Array2DReal("VertDiff", Mesh->NCellsSize, NVertLevels);
+   VertVisc = Array2DReal("VertVisc", Mesh->NCellsSize, NVertLevels);
+   deepCopy(VertDiff, BackgroundDiff);
+   deepCopy(VertVisc, BackgroundVisc);
+
+   FactorLower   = Array2DReal("VertMixLower", NVertLevels, NCellsOwned);
+   FactorUpper   = Array2DReal("VertMixUpper", NVertLevels, NCellsOwned);
+   FactorInvDiag = Array2DReal("VertMixInvDiag", NVertLevels, NCellsOwned);
+   FactorWeight  = Array2DReal("VertMixWeight", NVertLevels, NCellsOwned);
+   EdgeUpper     = Array2DReal("VertMixEdgeUpper", NVertLevels, NEdgesOwned);
+}
+
+//------------------------------------------------------------------------------
+// Mix all tracers in the owned cells. Each iteration factors the matrices of
+// a chunk of VecLength columns and then applies the forward elimination and
+// back substitution to each tracer in place.
+void ImplicitVertMix::mixTracers(const Array3DReal &TracerArray,
+                                 const Array2DReal &LayerThick,
+                                 Real Dt) const {
+
+   const I4 NTracers    = TracerArray.extent_int(0);
+   const I4 NCells      = NCellsOwned;
+   const I4 NLevels     = NVertLevels;
+   const I4 NChunks     = (NCells + VecLength - 1) / VecLength;
+   const auto &Diff     = VertDiff;
+   const auto &MinLevel = MinLevelCell;
+   const auto &MaxLevel = MaxLevelCell;
+   const auto &Lower    = FactorLower;
+   const auto &Upper    = FactorUpper;
+   const auto &InvDiag  = FactorInvDiag;
+   const auto &Weight   = FactorWeight;
+
+   // Reads the thickness and diffusivity, writes the factors and reads and
+   // writes each tracer twice
+   const R8 Bytes = (6.0 + 4.0 * NTracers) * NCells * NVertLevels *
+                    sizeof(Real);
+   TimingRegion Region("implicitVertMixTracers", Bytes);
+
+   parallelFor(
+       "implicitVertMixTracers", {NChunks}, KOKKOS_LAMBDA(int IChunk) {
+          const I4 CellStart = IChunk * VecLength;
+          const I4 NLanes    = Kokkos::min(VecLength, NCells - CellStart);
+
+          // Levels spanned by the active levels of the columns in the chunk
+          I4 KStart = NLevels;
+          I4 KEnd   = -1;
+          for (int Lane = 0; Lane < NLanes; ++Lane) {
+             KStart = Kokkos::min(KStart, MinLevel(CellStart + Lane));
+             KEnd   = Kokkos::max(KEnd, MaxLevel(CellStart + Lane));
+          }
+
+          // Factor the matrix of each column, with identity rows at the
+          // inactive levels
+          for (int K = KStart; K <= KEnd; ++K) {
+             for (int Lane = 0; Lane < NLanes; ++Lane) {
+                const I4 ICell = CellStart + Lane;
+                Real Thick     = 1;
+                Real Above     = 0;
+                Real Below     = 0;
+                if (K >= MinLevel(ICell) && K <= MaxLevel(ICell)) {
+                   Thick = LayerThick(ICell, K);
+                   if (K > MinLevel(ICell))
+                      Above = 2 * Dt * Diff(ICell, K) /
+                              (LayerThick(ICell, K - 1) + Thick);
+                   if (K < MaxLevel(ICell))
+                      Below = 2 * Dt * Diff(ICell, K + 1) /
+                              (Thick + LayerThick(ICell, K + 1));
+                }
+                Real Pivot = Thick + Above + Below;
+                if (K > KStart)
+                   Pivot += Above * Upper(K - 1, ICell);
+                const Real InvPivot = 1 / Pivot;
+                Lower(K, ICell)     = -Above;
+                Upper(K, ICell)     = -Below * InvPivot;
+                InvDiag(K, ICell)   = InvPivot;
+                Weight(K, ICell)    = Thick;
+             }
+          }
+
+          for (int L = 0; L < NTracers; ++L) {
+             // Forward elimination, storing the intermediate solution in
+             // the tracer array
+             for (int K = KStart; K <= KEnd; ++K) {
+                for (int Lane = 0; Lane < NLanes; ++Lane) {
+                   const I4 ICell = CellStart + Lane;
+                   Real Rhs       = Weight(K, ICell) * TracerArray(L, ICell, K);
+                   if (K > KStart)
+                      Rhs -= Lower(K, ICell) * TracerArray(L, ICell, K - 1);
+                   TracerArray(L, ICell, K) = Rhs * InvDiag(K, ICell);
+                }
+             }
+             // Back substitution
+             for (int K = KEnd - 1; K >= KStart; --K) {
+                for (int Lane = 0; Lane < NLanes; ++Lane) {
+                   const I4 ICell = CellStart + Lane;
+                   TracerArray(L, ICell, K) -=
+                       Upper(K, ICell) * TracerArray(L, ICell, K + 1);
+                }
+             }
+          }
+       });
+
+} // end mixTracers
+
+//------------------------------------------------------------------------------
+// Mix the normal velocity on the owned edges. There is a single field so the
+// factorization and forward elimination are done in one sweep.
+void ImplicitVertMix::mixVelocity(const Array2DReal &NormalVel,
+                                  const Array2DReal &LayerThick,
+                                  Real Dt) const {
+
+   const I4 NEdges      = NEdgesOwned;
+   const I4 NLevels     = NVertLevels;
+   const I4 NChunks     = (NEdges + VecLength - 1) / VecLength;
+   const auto &Visc     = VertVisc;
+   const auto &CellsOnE = CellsOnEdge;
+   const auto &MinLevel = MinLevelEdge;
+   const auto &MaxLevel = MaxLevelEdge;
+   const auto &Upper    = EdgeUpper;
+
+   // Reads the thickness and viscosity of two cells, writes the factor and
+   // reads and writes the velocity twice
+   const R8 Bytes = 9.0 * NEdges * NVertLevels * sizeof(Real);
+   TimingRegion Region("implicitVertMixVelocity", Bytes);
+
+   parallelFor(
+       "implicitVertMixVelocity", {NChunks}, KOKKOS_LAMBDA(int IChunk) {
+          const I4 EdgeStart = IChunk * VecLength;
+          const I4 NLanes    = Kokkos::min(VecLength, NEdges - EdgeStart);
+
+          I4 KStart = NLevels;
+          I4 KEnd   = -1;
+          for (int Lane = 0; Lane < NLanes; ++Lane) {
+             KStart = Kokkos::min(KStart, MinLevel(EdgeStart + Lane));
+             KEnd   = Kokkos::max(KEnd, MaxLevel(EdgeStart + Lane));
+          }
+
+          // Factorization and forward elimination
+          for (int K = KStart; K <= KEnd; ++K) {
+             for (int Lane = 0; Lane < NLanes; ++Lane) {
+                const I4 IEdge = EdgeStart + Lane;
+                Real Thick     = 1;
+                Real Above     = 0;
+                Real Below     = 0;
+                if (K >= MinLevel(IEdge) && K <= MaxLevel(IEdge)) {
+                   const I4 Cell1 = CellsOnE(IEdge, 0);
+                   const I4 Cell2 = CellsOnE(IEdge, 1);
+                   Thick          =
+                       0.5_Real * (LayerThick(Cell1, K) + LayerThick(Cell2, K));
+                   if (K > MinLevel(IEdge)) {
+                      const Real ThickAbove =
+                          0.5_Real *
+                          (LayerThick(Cell1, K - 1) + LayerThick(Cell2, K - 1));
+                      Above = Dt * (Visc(Cell1, K) + Visc(Cell2, K)) /
+                              (ThickAbove + Thick);
+                   }
+                   if (K < MaxLevel(IEdge)) {
+                      const Real ThickBelow =
+                          0.5_Real *
+                          (LayerThick(Cell1, K + 1) + LayerThick(Cell2, K + 1));
+                      Below = Dt * (Visc(Cell1, K + 1) + Visc(Cell2, K + 1)) /
+                              (Thick + ThickBelow);
+                   }
+                }
+                Real Pivot = Thick + Above + Below;
+                Real Rhs   = Thick * NormalVel(IEdge, K);
+                if (K > KStart) {
+                   Pivot += Above * Upper(K - 1, IEdge);
+                   Rhs += Above * NormalVel(IEdge, K - 1);
+                }
+                const Real InvPivot = 1 / Pivot;
+                Upper(K, IEdge)     = -Below * InvPivot;
+                NormalVel(IEdge, K) = Rhs * InvPivot;
+             }
+          }
+
+          // Back substitution
+          for (int K = KEnd - 1; K >= KStart; --K) {
+             for (int Lane = 0; Lane < NLanes; ++Lane) {
+                const I4 IEdge = EdgeStart + Lane;
+                NormalVel(IEdge, K) -=
+                    Upper(K, IEdge) * NormalVel(IEdge, K + 1);
+             }
+          }
+       });
+
+} // end mixVelocity
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
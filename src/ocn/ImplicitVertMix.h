@@ -0,0 +1,131 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_IMPLICITVERTMIX_H
+#define OMEGA_IMPLICITVERTMIX_H
+//===-- ocn/ImplicitVertMix.h - implicit vertical mixing --------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the implicit vertical mixing of velocity and tracers
+///
+/// The ImplicitVertMix class solves the backward Euler vertical diffusion
+/// equation in every owned column, which is a tridiagonal system over the
+/// active levels of the column. The systems of all columns are solved in one
+/// batched kernel. Each kernel iteration solves a chunk of VecLength
+/// adjacent columns with the Thomas algorithm, so on GPUs (VecLength = 1)
+/// each thread solves one column and on CPUs the inner loops over the
+/// columns of a chunk can be vectorized. The columns of a chunk are
+/// eliminated in lockstep over the union of their active levels, with the
+/// inactive levels of each column solved as identity rows. For tracers the
+/// matrix of each column is factored once and the factorization is applied
+/// to all tracers.
+///
+/// The mixing coefficients are stored at the top interface of each cell
+/// level and are set to the background values at init. The interfaces at
+/// the top and bottom of the active levels have no flux, so the column
+/// integrals of the thickness-weighted tracers and velocity are conserved.
+/// Options are read from the optional ImplicitVertMix group of the Omega
+/// Config:
+/// \ConfigInput
+/// ImplicitVertMix:
+///    # Mixing is only applied if enabled (default false if absent)
+///    Enabled: false
+///    # Background vertical diffusivity for tracers in m^2/s
+///    BackgroundDiffusivity: 1.0e-5
+///    # Background vertical viscosity for velocity in m^2/s
+///    BackgroundViscosity: 1.0e-4
+/// \EndConfigInput
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+
+#include <memory>
+
+namespace OMEGA {
+
+/// Batched tridiagonal solver for the implicit vertical mixing
+class ImplicitVertMix {
+ public:
+   /// Vertical diffusivity for tracers at the top interface of each cell
+   /// level, in m^2/s
+   Array2DReal VertDiff;
+
+   /// Vertical viscosity for velocity at the top interface of each cell
+   /// level, in m^2/s. The viscosity at an edge is the mean of the values
+   /// of its two cells.
+   Array2DReal VertVisc;
+
+   /// Reads the options from the optional ImplicitVertMix group of the
+   /// Omega Config and creates the default instance if mixing is enabled.
+   /// Requires the default HorzMesh.
+   static void init();
+
+   /// Returns the default instance or a null pointer if mixing is disabled
+   static ImplicitVertMix *getDefault();
+
+   /// Removes the default instance
+   static void clear();
+
+   /// Constructor allocates the coefficients and the work arrays and fills
+   /// the coefficients with the background values
+   ImplicitVertMix(const HorzMesh *Mesh, ///< [in] horizontal mesh
+                   Real BackgroundDiff,  ///< [in] background diffusivity
+                   Real BackgroundVisc   ///< [in] background viscosity
+   );
+
+   /// Returns the first active level of each cell column
+   const Array1DI4 &getMinLevelCell() const { return MinLevelCell; }
+
+   /// Returns the last active level of each cell column
+   const Array1DI4 &getMaxLevelCell() const { return MaxLevelCell; }
+
+   // The methods below contain kernels and are public only because of CUDA
+   // limitations
+
+   /// Mixes all tracers in the owned cells over a time step of Dt seconds.
+   /// The tracers are concentrations and are replaced by the mixed values.
+   void mixTracers(const Array3DReal &TracerArray, ///< [inout] tracers
+                   const Array2DReal &LayerThick,  ///< [in] layer thickness
+                   Real Dt                         ///< [in] time step in s
+   ) const;
+
+   /// Mixes the normal velocity on the owned edges over a time step of Dt
+   /// seconds. The edge thickness is the mean of the thickness of its cells.
+   void mixVelocity(const Array2DReal &NormalVel,  ///< [inout] velocity
+                    const Array2DReal &LayerThick, ///< [in] layer thickness
+                    Real Dt                        ///< [in] time step in s
+   ) const;
+
+ private:
+   I4 NCellsOwned; ///< Number of owned cells
+   I4 NEdgesOwned; ///< Number of owned edges
+   I4 NVertLevels; ///< Number of vertical levels
+
+   Array2DI4 CellsOnEdge;  ///< Cells on each side of an edge
+   Array1DI4 MinLevelCell; ///< First active level of each cell
+   Array1DI4 MaxLevelCell; ///< Last active level of each cell
+   Array1DI4 MinLevelEdge; ///< First active level of each edge
+   Array1DI4 MaxLevelEdge; ///< Last active level of each edge
+
+   // Work arrays for the factored cell matrices, dimensioned
+   // (NVertLevels, NCellsOwned) so that adjacent columns are adjacent in
+   // memory for both the GPU threads and the CPU vector lanes
+   Array2DReal FactorLower;   ///< Lower diagonal
+   Array2DReal FactorUpper;   ///< Upper diagonal divided by the pivot
+   Array2DReal FactorInvDiag; ///< Inverse of the pivot
+   Array2DReal FactorWeight;  ///< Thickness weight of the right hand side
+
+   /// Upper diagonal divided by the pivot for the edge matrices, dimensioned
+   /// (NVertLevels, NEdgesOwned)
+   Array2DReal EdgeUpper;
+
+   /// Default instance, null if mixing is disabled
+   static std::unique_ptr<ImplicitVertMix> DefaultInstance;
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,201 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- ocn/LoadBalance.cpp - load imbalance measurement --------*- C++ -*-===//
+//
+// Implements the imbalance measurement. The compute time of each interval
+// is the difference of the Timing statistics of the step and halo regions
+// between the start and end of the interval, as in the benchmark mode.
+//
+//===----------------------------------------------------------------------===//
+
+#include "LoadBalance.h"
+#include "Config.h"
+#include "Error.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "StencilCoeffs.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OMEGA {
+
+// create the static class members
+bool LoadBalance::Enabled     = false;
+I4 LoadBalance::CheckInterval = 100;
+R8 LoadBalance::Threshold     = 1.1;
+R8 LoadBalance::Imbalance     = 1.0;
+R8 LoadBalance::IntervalTime  = 0;
+Timing::RegionStats LoadBalance::StepStart;
+Timing::RegionStats LoadBalance::HaloStart;
+
+// Mean cost of a cell given to the partitioner
+static constexpr R8 MeanCellCost = 100.0;
+
+//------------------------------------------------------------------------------
+// Return the number of active levels of each owned cell of a mesh, from the
+// active level range of the stencil coefficients
+static std::vector<I4> ownedCellLevels(const HorzMesh *Mesh) {
+
+   const StencilCoeffs *Coeffs = StencilCoeffs::get(Mesh);
+   auto MinLevelH              = createHostMirrorCopy(Coeffs->MinLevelCell);
+   auto MaxLevelH              = createHostMirrorCopy(Coeffs->MaxLevelCell);
+
+   std::vector<I4> Levels(Mesh->NCellsOwned);
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+      Levels[ICell] = std::max(MaxLevelH(ICell) - MinLevelH(ICell) + 1, 0);
+
+   return Levels;
+
+} // end ownedCellLevels
+
+//------------------------------------------------------------------------------
+// Read the options from the optional LoadBalance group of the Omega Config
+void LoadBalance::init() {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("LoadBalance"))
+      return;
+
+   Config LBConfig("LoadBalance");
+   Error Err = OmegaConfig->get(LBConfig);
+   CHECK_ERROR_ABORT(Err, "LoadBalance: error reading LoadBalance group");
+
+   Err += LBConfig.get("Enabled", Enabled);
+   Err += LBConfig.get("CheckInterval", CheckInterval);
+   Err += LBConfig.get("Threshold", Threshold);
+   CHECK_ERROR_ABORT(Err, "LoadBalance: Enabled, CheckInterval or Threshold "
+                          "not found in LoadBalance Config");
+
+   if (!Enabled)
+      return;
+
+   if (CheckInterval < 1)
+      ABORT_ERROR("LoadBalance: CheckInterval {} must be at least 1",
+                  CheckInterval);
+
+   if (!Timing::isEnabled()) {
+      LOG_WARN("LoadBalance: Timing is disabled, the load imbalance can not "
+               "be measured");
+      Enabled = false;
+      return;
+   }
+
+   StepStart = Timing::getTotalStats("doStep");
+   HaloStart = Timing::getTotalStats("haloExchange");
+
+   LOG_INFO("LoadBalance: imbalance measured every {} steps, warning above {}",
+            CheckInterval, Threshold);
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Check whether the imbalance is measured
+bool LoadBalance::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Measure and report the imbalance of the interval that ends at this step
+bool LoadBalance::checkImbalance(I8 IStep) {
+
+   if (!Enabled or IStep % CheckInterval != 0)
+      return false;
+
+   // Halo exchanges are all inside the step, so compute is the step time
+   // outside halo exchanges
+   const Timing::RegionStats StepNow = Timing::getTotalStats("doStep");
+   const Timing::RegionStats HaloNow = Timing::getTotalStats("haloExchange");
+   IntervalTime = std::max(
+       (StepNow.Time - StepStart.Time) - (HaloNow.Time - HaloStart.Time), 0.0);
+   StepStart = StepNow;
+   HaloStart = HaloNow;
+
+   // The time per active level separates a slow task from a task with
+   // more work. A task with no active levels reports zero.
+   I8 NLevels = 0;
+   for (I4 Levels : ownedCellLevels(HorzMesh::getDefault()))
+      NLevels += Levels;
+   const R8 LevelTime = NLevels > 0 ? IntervalTime / NLevels : 0.0;
+
+   MachEnv *DefEnv = MachEnv::getDefault();
+   R8 MaxTimes[2]  = {IntervalTime, LevelTime};
+   R8 SumTimes[2]  = {IntervalTime, LevelTime};
+   MPI_Allreduce(MPI_IN_PLACE, MaxTimes, 2, MPI_DOUBLE, MPI_MAX,
+                 DefEnv->getComm());
+   MPI_Allreduce(MPI_IN_PLACE, SumTimes, 2, MPI_DOUBLE, MPI_SUM,
+                 DefEnv->getComm());
+
+   const I4 NumTasks = DefEnv->getNumTasks();
+   const R8 MeanTime = SumTimes[0] / NumTasks;
+   Imbalance         = MeanTime > 0 ? MaxTimes[0] / MeanTime : 1.0;
+
+   LOG_INFO("LoadBalance: step {} compute time max {:.4f} s, mean {:.4f} s, "
+            "imbalance {:.3f}, time per level max {:.3e} s, mean {:.3e} s",
+            IStep, MaxTimes[0], MeanTime, Imbalance, MaxTimes[1],
+            SumTimes[1] / NumTasks);
+
+   const bool Exceeded = Imbalance > Threshold;
+   if (Exceeded)
+      LOG_WARN("LoadBalance: imbalance {:.3f} above threshold {}", Imbalance,
+               Threshold);
+
+   return Exceeded;
+
+} // end checkImbalance
+
+//------------------------------------------------------------------------------
+// Return the imbalance of the last measurement
+R8 LoadBalance::getImbalance() { return Imbalance; }
+
+//------------------------------------------------------------------------------
+// Return the measured cost of each owned cell. The work of a cell is its
+// number of active levels and the cost of that work is the measured time
+// per level of the task, relative to the mean over the mesh.
+std::vector<I4> LoadBalance::measuredCellCost(const HorzMesh *Mesh) {
+
+   const std::vector<I4> Levels = ownedCellLevels(Mesh);
+   I8 NLevels                   = 0;
+   for (I4 CellLevels : Levels)
+      NLevels += CellLevels;
+
+   // Global sums of the compute time, active levels and cells
+   R8 Sums[3] = {IntervalTime, static_cast<R8>(NLevels),
+                 static_cast<R8>(Mesh->NCellsOwned)};
+   MPI_Allreduce(MPI_IN_PLACE, Sums, 3, MPI_DOUBLE, MPI_SUM,
+                 MachEnv::getDefault()->getComm());
+
+   // Cost of one active level of this task. Without a measurement every
+   // level costs the same.
+   R8 LevelCost = 0;
+   if (Sums[0] > 0 and NLevels > 0)
+      LevelCost = MeanCellCost * Sums[2] * (IntervalTime / NLevels) / Sums[0];
+   else if (Sums[1] > 0)
+      LevelCost = MeanCellCost * Sums[2] / Sums[1];
+
+   std::vector<I4> Cost(Mesh->NCellsOwned);
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell)
+      Cost[ICell] = std::max(
+          static_cast<I4>(std::lround(Levels[ICell] * LevelCost)), 1);
+
+   return Cost;
+
+} // end measuredCellCost
+
+//------------------------------------------------------------------------------
+// Reset the options and measurements
+void LoadBalance::clear() {
+
+   Enabled       = false;
+   CheckInterval = 100;
+   Threshold     = 1.1;
+   Imbalance     = 1.0;
+   IntervalTime  = 0;
+
+} // end clear
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,91 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_LOADBALANCE_H
+#define OMEGA_LOADBALANCE_H
+//===-- ocn/LoadBalance.h - load imbalance measurement ----------*- C++ -*-===//
+//
+/// \file
+/// \brief Measures and reports the load imbalance of a run
+///
+/// The static partition is weighted by estimates of the cost of each cell,
+/// but the real cost of a task drifts during a long run. The LoadBalance
+/// class measures the compute time of each task, taken as the time in the
+/// Timing region doStep outside the region haloExchange, over a number of
+/// steps and reports the imbalance, the maximum over the mean task time,
+/// together with the spread of the time per active cell level. The
+/// measured cost of each owned cell, its number of active levels times the
+/// measured time per level of its task, can be retrieved as a partition
+/// weight.
+///
+/// The options are read from the optional LoadBalance group of the Omega
+/// Config:
+/// \ConfigInput
+/// LoadBalance:
+///    # Measure and report the load imbalance
+///    Enabled: false
+///    # Number of steps between measurements
+///    CheckInterval: 100
+///    # Imbalance (max over mean task time) above which a warning is logged
+///    Threshold: 1.1
+/// \EndConfigInput
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "Timing.h"
+
+#include <vector>
+
+namespace OMEGA {
+
+/// Load imbalance measurement
+class LoadBalance {
+ public:
+   /// Reads the options from the optional LoadBalance group of the Omega
+   /// Config. The measurement is disabled if the group is absent.
+   static void init();
+
+   /// Returns true if the imbalance is measured
+   static bool isEnabled();
+
+   /// Measures and logs the imbalance at the end of every CheckInterval
+   /// steps and returns true if it is above the threshold. Must be called
+   /// by all tasks after every step.
+   static bool checkImbalance(I8 IStep ///< [in] step count, starting from 1
+   );
+
+   /// Returns the imbalance of the last measurement, or 1 before the first
+   static R8 getImbalance();
+
+   /// Returns the measured cost of each owned cell of a mesh for use as a
+   /// partition weight: the number of active levels of the cell from the
+   /// StencilCoeffs times the compute time per active level of the task
+   /// measured by the last checkImbalance, scaled so that the mean over the
+   /// mesh is 100. Before the first measurement, the cost is proportional
+   /// to the number of active levels. Cells without active levels get the
+   /// minimum cost of 1. Must be called by all tasks.
+   static std::vector<I4>
+   measuredCellCost(const HorzMesh *Mesh ///< [in] mesh of the measurement
+   );
+
+   /// Resets the options and measurements
+   static void clear();
+
+ private:
+   static bool Enabled;     ///< imbalance is measured
+   static I4 CheckInterval; ///< steps between measurements
+   static R8 Threshold;     ///< imbalance above which a warning is logged
+   static R8 Imbalance;     ///< imbalance of the last measurement
+   static R8 IntervalTime;  ///< compute time of the last interval
+
+   /// Timing statistics at the start of the current interval
+   static Timing::RegionStats StepStart;
+   static Timing::RegionStats HaloStart;
+};
+
+} // namespace OMEGA
+#endif
@@ -10,18 +10,29 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "AnalysisMember.h"
 #include "AuxiliaryState.h"
 #include "Decomp.h"
+#include "ExecInstances.h"
 #include "Field.h"
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "IO.h"
+#include "IOStream.h"
+#include "ImplicitVertMix.h"
+#include "LoadBalance.h"
+#include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryRegistry.h"
 #include "OceanDriver.h"
 #include "OceanState.h"
+#include "ScratchPool.h"
+#include "StencilCoeffs.h"
 #include "Tendencies.h"
+#include "Throughput.h"
 #include "TimeMgr.h"
 #include "TimeStepper.h"
+#include "Timing.h"
 #include "Tracers.h"
 
 namespace OMEGA {
@@ -34,7 +45,26 @@ int ocnFinalize(const TimeInstant &CurrTime ///< [in] current sim time
 
    // Write restart file if necessary
 
+   // Write the streams flagged for shutdown and complete any asynchronous
+   // write before the fields, decompositions and IO system are removed
+   TimeStepper *DefStepper = TimeStepper::getDefault();
+   if (IOStream::finalize(DefStepper->getClock()) != 0) {
+      LOG_ERROR("ocnFinalize: error finalizing IO streams");
+      RetVal = 1;
+   }
+
+   // Write the benchmark results and the timing summary across all tasks
+   // before the environment is removed
+   MachEnv *DefEnv = MachEnv::getDefault();
+   Throughput::report(DefEnv->getComm());
+   Timing::printSummary(DefEnv->getComm());
+   Timing::clear();
+   ScratchPool::report();
+   MemoryRegistry::report("at finalize");
+
    // clean up all objects
+   LoadBalance::clear();
+   AnalysisMember::clear();
    Tracers::clear();
    TimeStepper::clear();
    Tendencies::clear();
@@ -42,11 +72,19 @@ int ocnFinalize(const TimeInstant &CurrTime ///< [in] current sim time
    OceanState::clear();
    Dimension::clear();
    Field::clear();
+   ImplicitVertMix::clear();
+   ExecInstances::clear();
+   StencilCoeffs::clear();
    HorzMesh::clear();
    Halo::clear();
    Decomp::clear();
+   ScratchPool::clear();
+   MemoryRegistry::clear();
    MachEnv::removeAll();
 
+   // Write any queued log messages
+   finalizeLogging();
+
    return RetVal;
 } // end ocnFinalize
 
@@ -12,23 +12,31 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "AnalysisMember.h"
 #include "AuxiliaryState.h"
 #include "Config.h"
 #include "DataTypes.h"
 #include "Decomp.h"
 #include "Error.h"
+#include "ExecInstances.h"
 #include "Field.h"
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "IO.h"
+#include "ImplicitVertMix.h"
 #include "IOStream.h"
+#include "KernelPolicy.h"
+#include "LoadBalance.h"
 #include "Logging.h"
 #include "MachEnv.h"
+#include "MemoryRegistry.h"
 #include "OceanDriver.h"
 #include "OceanState.h"
 #include "Tendencies.h"
+#include "Throughput.h"
 #include "TimeMgr.h"
 #include "TimeStepper.h"
+#include "Timing.h"
 #include "Tracers.h"
 
 #include "mpi.h"
@@ -52,6 +60,28 @@ int ocnInit(MPI_Comm Comm ///< [in] ocean MPI communicator
    Config::readAll("omega.yml");
    Config *OmegaConfig = Config::getOmegaConfig();
 
+   // Apply the logging options from Config (async sink, levels by task)
+   configLogging(DefEnv);
+
+   // Initialize the timers so that all later modules can time regions
+   Timing::init();
+
+   // Read the benchmark mode options, which use the timers
+   Throughput::init();
+
+   // Read the load balancing options, which also use the timers
+   LoadBalance::init();
+
+   // Read the parallel policies of the column kernels, which are looked up
+   // when the tendency functors are created
+   KernelPolicy::init();
+
+   // Create the execution space instances for concurrent kernel groups
+   ExecInstances::init();
+
+   // Read the memory report options
+   MemoryRegistry::init();
+
    // initialize remaining Omega modules
    Err = initOmegaModules(Comm);
    if (Err != 0)
@@ -89,6 +119,13 @@ int initOmegaModules(MPI_Comm Comm) {
 
    Decomp::init();
 
+   // The mesh copies all connectivity arrays from the decomposition, so any
+   // deferred read must be done before it is built
+   Err = Decomp::getDefault()->loadDeferred();
+   if (Err != 0) {
+      ABORT_ERROR("ocnInit: Error reading deferred mesh connectivity");
+   }
+
    Err = Halo::init();
    if (Err != 0) {
       ABORT_ERROR("ocnInit: Error initializing default halo");
@@ -108,11 +145,18 @@ int initOmegaModules(MPI_Comm Comm) {
    CHECK_ERROR_ABORT(ConfigErr,
                      "ocnInit: NVertLevels not found in Dimension Config");
 
+   // The kernels loop over whole chunks of VecLength levels and, with
+   // OMEGA_SIMD, load each chunk as one SIMD value
+   if (NVertLevels % VecLength != 0)
+      ABORT_ERROR("ocnInit: NVertLevels {} is not a multiple of VecLength {}",
+                  NVertLevels, VecLength);
+
    auto VertDim = OMEGA::Dimension::create("NVertLevels", NVertLevels);
 
    Tracers::init();
    AuxiliaryState::init();
    Tendencies::init();
+   ImplicitVertMix::init();
    TimeStepper::init2();
 
    Err = OceanState::init();
@@ -120,6 +164,10 @@ int initOmegaModules(MPI_Comm Comm) {
       ABORT_ERROR("ocnInit: Error initializing default state");
    }
 
+   // Create the analysis members, which add the field groups of their
+   // products for use in the stream contents
+   AnalysisMember::init(ModelClock);
+
    // Now that all fields have been defined, validate all the streams
    // contents
    bool StreamsValid = IOStream::validateAll();
@@ -156,26 +204,33 @@ int initOmegaModules(MPI_Comm Comm) {
    }
 
    // Update Halos and Host arrays with new state, auxiliary state, and tracer
-   // fields
+   // fields. The state and tracers (at the same time level index) are
+   // exchanged together in one round of messages.
 
    OceanState *DefState = OceanState::getDefault();
    I4 CurTimeLevel      = 0;
-   DefState->exchangeHalo(CurTimeLevel);
+   Array3DReal TracerArray;
+   Err = Tracers::getAll(TracerArray, CurTimeLevel);
+   if (Err != 0) {
+      ABORT_ERROR("Error retrieving tracers after restart");
+   }
+   DefStepper->exchangeStateHalos(DefState, TracerArray, CurTimeLevel);
    DefState->copyToHost(CurTimeLevel);
 
    AuxiliaryState *DefAuxState = AuxiliaryState::getDefault();
    DefAuxState->exchangeHalo();
 
-   // Now update tracers - assume using same time level index
-   Err = Tracers::exchangeHalo(CurTimeLevel);
-   if (Err != 0) {
-      ABORT_ERROR("Error updating tracer halo after restart");
-   }
    Err = Tracers::copyToHost(CurTimeLevel);
    if (Err != 0) {
       ABORT_ERROR("Error updating tracer device arrays after restart");
    }
 
+   // The host connectivity of the mesh is no longer needed once the mesh,
+   // halos and streams have been initialized
+   if (MemoryRegistry::dropHostMirrors())
+      Decomp::getDefault()->dropHostMirrors();
+   MemoryRegistry::report("after init");
+
    return Err;
 
 } // end initOmegaModules
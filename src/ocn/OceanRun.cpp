@@ -10,11 +10,16 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "AnalysisMember.h"
 #include "IOStream.h"
+#include "LoadBalance.h"
+#include "Logging.h"
 #include "OceanDriver.h"
 #include "OceanState.h"
+#include "Throughput.h"
 #include "TimeMgr.h"
 #include "TimeStepper.h"
+#include "Timing.h"
 
 namespace OMEGA {
 
@@ -44,21 +49,51 @@ int ocnRun(TimeInstant &CurrTime ///< [inout] current sim time
       // track step count
       ++IStep;
 
+      // open the benchmark window once the warm-up steps are done
+      Throughput::startStep(IStep);
+      TimeInstant StepStartTime = OmegaClock->getCurrentTime();
+
       // call forcing routines, anything needed pre-timestep
 
       // do forward time step
+      Timing::start("doStep");
       DefTimeStepper->doStep(DefOceanState, SimTime);
+      Timing::stop("doStep");
+
+      // adjust the time step from the CFL number if adaptive stepping is on
+      DefTimeStepper->adaptTimeStep(DefOceanState, IStep);
+
+      // compute the analysis members on the new state so their products
+      // are current when the streams are written
+      AnalysisMember::computeAll(DefOceanState, 0, OmegaClock);
+
+      // accumulate the fields of streams with a time reduction, including
+      // the step that ends an output interval
+      Err = IOStream::accumulateAll(OmegaClock);
+      if (Err != 0) {
+         LOG_CRITICAL("Error accumulating stream fields at end of step");
+         break;
+      }
 
       // write restart file/output, anything needed post-timestep
 
+      Timing::start("writeAll");
       Err = IOStream::writeAll(OmegaClock);
+      Timing::stop("writeAll");
       if (Err != 0) {
          LOG_CRITICAL("Error writing streams at end of step");
          break;
       }
 
-      LOG_INFO("ocnRun: Time step {} complete, clock time: {}", IStep,
-               SimTime.getString(4, 4, "-"));
+      Throughput::endStep(OmegaClock->getCurrentTime() - StepStartTime);
+
+      // measure and report the load imbalance
+      LoadBalance::checkImbalance(IStep);
+
+      if (isLogStep(IStep)) {
+         LOG_INFO("ocnRun: Time step {} complete, clock time: {}", IStep,
+                  SimTime.getString(4, 4, "-"));
+      }
    }
 
    return Err;
@@ -0,0 +1,153 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- ocn/StencilCoeffs.cpp - stencil coefficients -----------*- C++ -*-===//
+//
+// Computes and stores the geometric coefficients of the horizontal stencils
+// once per mesh
+//
+//===----------------------------------------------------------------------===//
+
+#include "StencilCoeffs.h"
+#include "Error.h"
+#include "OmegaKokkos.h"
+
+namespace OMEGA {
+
+// Coefficients for all meshes
+std::map<const HorzMesh *, std::unique_ptr<StencilCoeffs>>
+    StencilCoeffs::AllCoeffs;
+
+//------------------------------------------------------------------------------
+// Compute the coefficients from the mesh geometry. Entries beyond the number
+// of edges on a cell and for padded cells and edges are left zero. The active
+// level ranges are found from the edge mask.
+StencilCoeffs::StencilCoeffs(const HorzMesh *Mesh) {
+
+   const I4 MaxEdges     = Mesh->EdgesOnCell.extent_int(1);
+   const I4 VertexDegree = Mesh->VertexDegree;
+
+   DivCoeffOnCell         =
+       Array2DReal("DivCoeffOnCell", Mesh->NCellsSize, MaxEdges);
+   LaplaceCoeffOnCell     =
+       Array2DReal("LaplaceCoeffOnCell", Mesh->NCellsSize, MaxEdges);
+   KineticCoeffOnCell     =
+       Array2DReal("KineticCoeffOnCell", Mesh->NCellsSize, MaxEdges);
+   CurlCoeffOnVertex      =
+       Array2DReal("CurlCoeffOnVertex", Mesh->NVerticesSize, VertexDegree);
+   KiteCoeffOnVertex      =
+       Array2DReal("KiteCoeffOnVertex", Mesh->NVerticesSize, VertexDegree);
+   GradCoeffOnEdge        = Array1DReal("GradCoeffOnEdge", Mesh->NEdgesSize);
+   TangentGradCoeffOnEdge =
+       Array1DReal("TangentGradCoeffOnEdge", Mesh->NEdgesSize);
+   MinLevelEdge           = Array1DI4("MinLevelEdge", Mesh->NEdgesSize);
+   MaxLevelEdge           = Array1DI4("MaxLevelEdge", Mesh->NEdgesSize);
+   MinLevelCell           = Array1DI4("MinLevelCell", Mesh->NCellsSize);
+   MaxLevelCell           = Array1DI4("MaxLevelCell", Mesh->NCellsSize);
+
+   const auto &NEdgesOnCell   = Mesh->NEdgesOnCell;
+   const auto &EdgesOnCell    = Mesh->EdgesOnCell;
+   const auto &EdgeSignOnCell = Mesh->EdgeSignOnCell;
+   const auto &DvEdge         = Mesh->DvEdge;
+   const auto &DcEdge         = Mesh->DcEdge;
+   const auto &AreaCell       = Mesh->AreaCell;
+   const auto &DivCoeff       = DivCoeffOnCell;
+   const auto &LaplaceCoeff   = LaplaceCoeffOnCell;
+   const auto &KineticCoeff   = KineticCoeffOnCell;
+   const auto &GradCoeff      = GradCoeffOnEdge;
+   const auto &TangentCoeff   = TangentGradCoeffOnEdge;
+   const auto &EdgeMask       = Mesh->EdgeMask;
+   const auto &MinEdge        = MinLevelEdge;
+   const auto &MaxEdge        = MaxLevelEdge;
+   const auto &MinCell        = MinLevelCell;
+   const auto &MaxCell        = MaxLevelCell;
+   const I4 NVertLevels       = EdgeMask.extent_int(1);
+
+   parallelFor(
+       "stencilCoeffsOnCell", {Mesh->NCellsAll, MaxEdges},
+       KOKKOS_LAMBDA(int ICell, int J) {
+          if (J < NEdgesOnCell(ICell)) {
+             const I4 JEdge         = EdgesOnCell(ICell, J);
+             const Real Coeff       =
+                 EdgeSignOnCell(ICell, J) * DvEdge(JEdge) / AreaCell(ICell);
+             DivCoeff(ICell, J)     = Coeff;
+             LaplaceCoeff(ICell, J) = Coeff / DcEdge(JEdge);
+             KineticCoeff(ICell, J) =
+                 0.25_Real * DcEdge(JEdge) * DvEdge(JEdge) / AreaCell(ICell);
+          }
+       });
+
+   // EdgesOnVertex is empty if its read was deferred and the mesh was built
+   // before Decomp::loadDeferred was called
+   if (Mesh->EdgesOnVertex.extent(0) == 0)
+      ABORT_ERROR("StencilCoeffs: EdgesOnVertex not loaded, call "
+                  "Decomp::loadDeferred before building the mesh");
+
+   const auto &EdgesOnVertex    = Mesh->EdgesOnVertex;
+   const auto &EdgeSignOnVertex = Mesh->EdgeSignOnVertex;
+   const auto &KiteAreas        = Mesh->KiteAreasOnVertex;
+   const auto &AreaTriangle     = Mesh->AreaTriangle;
+   const auto &CurlCoeff        = CurlCoeffOnVertex;
+   const auto &KiteCoeff        = KiteCoeffOnVertex;
+
+   parallelFor(
+       "stencilCoeffsOnVertex", {Mesh->NVerticesAll, VertexDegree},
+       KOKKOS_LAMBDA(int IVertex, int J) {
+          const I4 JEdge        = EdgesOnVertex(IVertex, J);
+          const Real InvArea    = 1._Real / AreaTriangle(IVertex);
+          CurlCoeff(IVertex, J) =
+              EdgeSignOnVertex(IVertex, J) * DcEdge(JEdge) * InvArea;
+          KiteCoeff(IVertex, J) = KiteAreas(IVertex, J) * InvArea;
+       });
+
+   parallelFor(
+       "stencilCoeffsOnEdge", {Mesh->NEdgesAll}, KOKKOS_LAMBDA(int IEdge) {
+          GradCoeff(IEdge)    = 1._Real / DcEdge(IEdge);
+          TangentCoeff(IEdge) = 1._Real / DvEdge(IEdge);
+
+          I4 MinLevel = NVertLevels;
+          I4 MaxLevel = -1;
+          for (int K = 0; K < NVertLevels; ++K) {
+             if (EdgeMask(IEdge, K) != 0) {
+                MinLevel = Kokkos::min(MinLevel, K);
+                MaxLevel = K;
+             }
+          }
+          MinEdge(IEdge) = MinLevel;
+          MaxEdge(IEdge) = MaxLevel;
+       });
+
+   parallelFor(
+       "activeLevelsOnCell", {Mesh->NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+          I4 MinLevel = NVertLevels;
+          I4 MaxLevel = -1;
+          for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+             const I4 JEdge = EdgesOnCell(ICell, J);
+             MinLevel       = Kokkos::min(MinLevel, MinEdge(JEdge));
+             MaxLevel       = Kokkos::max(MaxLevel, MaxEdge(JEdge));
+          }
+          MinCell(ICell) = MinLevel;
+          MaxCell(ICell) = MaxLevel;
+       });
+}
+
+//------------------------------------------------------------------------------
+// Return the coefficients for a mesh, computing them on first use
+StencilCoeffs *StencilCoeffs::get(const HorzMesh *Mesh) {
+
+   auto It = AllCoeffs.find(Mesh);
+   if (It != AllCoeffs.end())
+      return It->second.get();
+
+   auto Inserted =
+       AllCoeffs.emplace(Mesh, std::make_unique<StencilCoeffs>(Mesh));
+   return Inserted.first->second.get();
+}
+
+//------------------------------------------------------------------------------
+// Remove the coefficients for all meshes
+void StencilCoeffs::clear() { AllCoeffs.clear(); }
+
+} // namespace OMEGA
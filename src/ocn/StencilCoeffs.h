@@ -0,0 +1,101 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_STENCILCOEFFS_H
+#define OMEGA_STENCILCOEFFS_H
+//===-- ocn/StencilCoeffs.h - precomputed stencil coefficients --*- C++ -*-===//
+//
+/// \file
+/// \brief Defines precomputed geometric coefficients for mesh stencils
+///
+/// The horizontal operators combine the same mesh geometry on every call,
+/// for example DvEdge * EdgeSignOnCell / AreaCell for the divergence and
+/// 1 / DcEdge for the gradient. The StencilCoeffs class computes these
+/// products once per mesh and stores them in contiguous arrays, so that each
+/// kernel streams one coefficient array instead of several geometry arrays
+/// and does no divisions. The class also stores the range of active vertical
+/// levels of each cell and edge column, so that kernels can skip the chunks
+/// of levels that are masked out below the bathymetry. One set of
+/// coefficients is kept for each mesh and is shared by all the functors
+/// using that mesh.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "MachEnv.h"
+
+#include <map>
+#include <memory>
+
+namespace OMEGA {
+
+/// Precomputed geometric coefficients for the cell and edge stencils
+class StencilCoeffs {
+ public:
+   /// Divergence coefficients for each edge of a cell:
+   /// EdgeSignOnCell(ICell, J) * DvEdge(EdgesOnCell(ICell, J)) / AreaCell
+   Array2DReal DivCoeffOnCell;
+
+   /// Laplacian coefficients for each edge of a cell, the divergence
+   /// coefficient divided by DcEdge of the edge
+   Array2DReal LaplaceCoeffOnCell;
+
+   /// Kinetic energy coefficients for each edge of a cell:
+   /// 0.25 * DcEdge * DvEdge / AreaCell
+   Array2DReal KineticCoeffOnCell;
+
+   /// Curl coefficients for each edge of a vertex:
+   /// EdgeSignOnVertex(IVertex, J) * DcEdge(EdgesOnVertex(IVertex, J)) /
+   /// AreaTriangle
+   Array2DReal CurlCoeffOnVertex;
+
+   /// Interpolation weights from the cells of a vertex to the vertex:
+   /// KiteAreasOnVertex / AreaTriangle
+   Array2DReal KiteCoeffOnVertex;
+
+   /// Normal gradient coefficient on edges: 1 / DcEdge
+   Array1DReal GradCoeffOnEdge;
+
+   /// Tangential gradient coefficient on edges: 1 / DvEdge
+   Array1DReal TangentGradCoeffOnEdge;
+
+   /// First and last active level of each edge, from the nonzero entries of
+   /// EdgeMask. Edges with no active levels have MaxLevelEdge < MinLevelEdge.
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
+
+   /// First and last active level of each cell, the union of the active
+   /// ranges of the edges of the cell. The cell tendencies are built from
+   /// masked edge fluxes, so they vanish outside this range.
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+
+   /// Returns the coefficients for a mesh, computing them on first use
+   static StencilCoeffs *get(const HorzMesh *Mesh ///< [in] mesh
+   );
+
+   /// Removes the coefficients for all meshes
+   static void clear();
+
+   /// Constructor computes all coefficients from the mesh geometry. Use get
+   /// rather than constructing directly so the arrays are shared.
+   explicit StencilCoeffs(const HorzMesh *Mesh ///< [in] mesh
+   );
+
+ private:
+   /// Coefficients for all meshes that have been used
+   static std::map<const HorzMesh *, std::unique_ptr<StencilCoeffs>> AllCoeffs;
+};
+
+/// Returns true if the vertical chunk of VecLength levels starting at KStart
+/// overlaps the active levels MinLevel to MaxLevel of a column
+KOKKOS_INLINE_FUNCTION bool isActiveChunk(I4 KStart, I4 MinLevel,
+                                          I4 MaxLevel) {
+   return KStart <= MaxLevel && KStart + VecLength > MinLevel;
+}
+
+} // namespace OMEGA
+#endif
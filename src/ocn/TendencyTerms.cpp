@@ -16,38 +16,63 @@
 #include "TendencyTerms.h"
 #include "AuxiliaryState.h"
 #include "DataTypes.h"
+#include "Error.h"
 #include "HorzMesh.h"
 #include "OceanState.h"
 #include "Tracers.h"
 
 namespace OMEGA {
 
+// The EdgesOnEdge arrays are empty if their read was deferred and the mesh
+// was built before Decomp::loadDeferred was called
+static void checkEdgesOnEdge(const HorzMesh *Mesh, const char *Functor) {
+   if (Mesh->EdgesOnEdge.extent(0) == 0)
+      ABORT_ERROR("{}: EdgesOnEdge not loaded, call Decomp::loadDeferred "
+                  "before building the mesh",
+                  Functor);
+}
+
 ThicknessFluxDivOnCell::ThicknessFluxDivOnCell(const HorzMesh *Mesh)
     : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
-      EdgeSignOnCell(Mesh->EdgeSignOnCell) {}
+      DivCoeffOnCell(StencilCoeffs::get(Mesh)->DivCoeffOnCell) {}
 
 PotentialVortHAdvOnEdge::PotentialVortHAdvOnEdge(const HorzMesh *Mesh)
     : NEdgesOnEdge(Mesh->NEdgesOnEdge), EdgesOnEdge(Mesh->EdgesOnEdge),
-      WeightsOnEdge(Mesh->WeightsOnEdge), EdgeMask(Mesh->EdgeMask) {}
+      WeightsOnEdge(Mesh->WeightsOnEdge), EdgeMask(Mesh->EdgeMask),
+      MinLevelEdge(StencilCoeffs::get(Mesh)->MinLevelEdge),
+      MaxLevelEdge(StencilCoeffs::get(Mesh)->MaxLevelEdge) {
+   checkEdgesOnEdge(Mesh, "PotentialVortHAdvOnEdge");
+}
 
 KEGradOnEdge::KEGradOnEdge(const HorzMesh *Mesh)
-    : CellsOnEdge(Mesh->CellsOnEdge), DcEdge(Mesh->DcEdge),
-      EdgeMask(Mesh->EdgeMask) {}
+    : CellsOnEdge(Mesh->CellsOnEdge),
+      GradCoeffOnEdge(StencilCoeffs::get(Mesh)->GradCoeffOnEdge),
+      EdgeMask(Mesh->EdgeMask),
+      MinLevelEdge(StencilCoeffs::get(Mesh)->MinLevelEdge),
+      MaxLevelEdge(StencilCoeffs::get(Mesh)->MaxLevelEdge) {}
 
 SSHGradOnEdge::SSHGradOnEdge(const HorzMesh *Mesh)
-    : CellsOnEdge(Mesh->CellsOnEdge), DcEdge(Mesh->DcEdge),
-      EdgeMask(Mesh->EdgeMask) {}
+    : CellsOnEdge(Mesh->CellsOnEdge),
+      GradCoeffOnEdge(StencilCoeffs::get(Mesh)->GradCoeffOnEdge),
+      EdgeMask(Mesh->EdgeMask),
+      MinLevelEdge(StencilCoeffs::get(Mesh)->MinLevelEdge),
+      MaxLevelEdge(StencilCoeffs::get(Mesh)->MaxLevelEdge) {}
 
 VelocityDiffusionOnEdge::VelocityDiffusionOnEdge(const HorzMesh *Mesh)
     : CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
-      DcEdge(Mesh->DcEdge), DvEdge(Mesh->DvEdge),
-      MeshScalingDel2(Mesh->MeshScalingDel2), EdgeMask(Mesh->EdgeMask) {}
+      GradCoeffOnEdge(StencilCoeffs::get(Mesh)->GradCoeffOnEdge),
+      TangentGradCoeffOnEdge(StencilCoeffs::get(Mesh)->TangentGradCoeffOnEdge),
+      MeshScalingDel2(Mesh->MeshScalingDel2), EdgeMask(Mesh->EdgeMask),
+      MinLevelEdge(StencilCoeffs::get(Mesh)->MinLevelEdge),
+      MaxLevelEdge(StencilCoeffs::get(Mesh)->MaxLevelEdge) {}
 
 VelocityHyperDiffOnEdge::VelocityHyperDiffOnEdge(const HorzMesh *Mesh)
     : CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
-      DcEdge(Mesh->DcEdge), DvEdge(Mesh->DvEdge),
-      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask) {}
+      GradCoeffOnEdge(StencilCoeffs::get(Mesh)->GradCoeffOnEdge),
+      TangentGradCoeffOnEdge(StencilCoeffs::get(Mesh)->TangentGradCoeffOnEdge),
+      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask),
+      MinLevelEdge(StencilCoeffs::get(Mesh)->MinLevelEdge),
+      MaxLevelEdge(StencilCoeffs::get(Mesh)->MaxLevelEdge) {}
 
 WindForcingOnEdge::WindForcingOnEdge(const HorzMesh *Mesh)
     : Enabled(false), EdgeMask(Mesh->EdgeMask) {}
@@ -56,23 +81,103 @@ BottomDragOnEdge::BottomDragOnEdge(const HorzMesh *Mesh)
     : Enabled(false), Coeff(0), CellsOnEdge(Mesh->CellsOnEdge),
       NVertLevels(Mesh->NVertLevels), EdgeMask(Mesh->EdgeMask) {}
 
+FusedVelocityTendOnEdge::FusedVelocityTendOnEdge(const HorzMesh *Mesh)
+    : NVertLevels(Mesh->NVertLevels),
+      Policy(KernelPolicy::get("fusedVelocityTendOnEdge")),
+      NEdgesOnEdge(Mesh->NEdgesOnEdge), EdgesOnEdge(Mesh->EdgesOnEdge),
+      CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
+      WeightsOnEdge(Mesh->WeightsOnEdge),
+      GradCoeffOnEdge(StencilCoeffs::get(Mesh)->GradCoeffOnEdge),
+      TangentGradCoeffOnEdge(StencilCoeffs::get(Mesh)->TangentGradCoeffOnEdge),
+      MeshScalingDel2(Mesh->MeshScalingDel2),
+      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask),
+      MinLevelEdge(StencilCoeffs::get(Mesh)->MinLevelEdge),
+      MaxLevelEdge(StencilCoeffs::get(Mesh)->MaxLevelEdge) {
+   checkEdgesOnEdge(Mesh, "FusedVelocityTendOnEdge");
+}
+
+// Collect the enabled flags and coefficients of the individual terms so the
+// fused kernel stays consistent with the unfused ones
+void FusedVelocityTendOnEdge::setTerms(
+    const PotentialVortHAdvOnEdge &PotVortHAdv, const KEGradOnEdge &KEGradTerm,
+    const SSHGradOnEdge &SSHGradTerm, const VelocityDiffusionOnEdge &VelDiff,
+    const VelocityHyperDiffOnEdge &VelHyperDiff,
+    const WindForcingOnEdge &WindForcing, const BottomDragOnEdge &BottomDrag) {
+
+   Terms = 0;
+   if (PotVortHAdv.Enabled)
+      Terms |= PVAdv;
+   if (KEGradTerm.Enabled)
+      Terms |= KEGrad;
+   if (SSHGradTerm.Enabled)
+      Terms |= SSHGrad;
+   if (VelDiff.Enabled)
+      Terms |= Del2;
+   if (VelHyperDiff.Enabled)
+      Terms |= Del4;
+   if (WindForcing.Enabled)
+      Terms |= Wind;
+   if (BottomDrag.Enabled)
+      Terms |= Drag;
+
+   ViscDel2         = VelDiff.ViscDel2;
+   ViscDel4         = VelHyperDiff.ViscDel4;
+   DivFactor        = VelHyperDiff.DivFactor;
+   SaltWaterDensity = WindForcing.SaltWaterDensity;
+   DragCoeff        = BottomDrag.Coeff;
+}
+
 TracerHorzAdvOnCell::TracerHorzAdvOnCell(const HorzMesh *Mesh)
     : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell), EdgeMask(Mesh->EdgeMask) {
-}
+      DivCoeffOnCell(StencilCoeffs::get(Mesh)->DivCoeffOnCell),
+      EdgeMask(Mesh->EdgeMask),
+      MinLevelCell(StencilCoeffs::get(Mesh)->MinLevelCell),
+      MaxLevelCell(StencilCoeffs::get(Mesh)->MaxLevelCell) {}
 
 TracerDiffOnCell::TracerDiffOnCell(const HorzMesh *Mesh)
     : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DvEdge(Mesh->DvEdge), DcEdge(Mesh->DcEdge), AreaCell(Mesh->AreaCell),
-      MeshScalingDel2(Mesh->MeshScalingDel2), EdgeMask(Mesh->EdgeMask) {}
+      CellsOnEdge(Mesh->CellsOnEdge),
+      LaplaceCoeffOnCell(StencilCoeffs::get(Mesh)->LaplaceCoeffOnCell),
+      MeshScalingDel2(Mesh->MeshScalingDel2), EdgeMask(Mesh->EdgeMask),
+      MinLevelCell(StencilCoeffs::get(Mesh)->MinLevelCell),
+      MaxLevelCell(StencilCoeffs::get(Mesh)->MaxLevelCell) {}
 
 TracerHyperDiffOnCell::TracerHyperDiffOnCell(const HorzMesh *Mesh)
     : NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DvEdge(Mesh->DvEdge), DcEdge(Mesh->DcEdge), AreaCell(Mesh->AreaCell),
-      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask) {}
+      CellsOnEdge(Mesh->CellsOnEdge),
+      LaplaceCoeffOnCell(StencilCoeffs::get(Mesh)->LaplaceCoeffOnCell),
+      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask),
+      MinLevelCell(StencilCoeffs::get(Mesh)->MinLevelCell),
+      MaxLevelCell(StencilCoeffs::get(Mesh)->MaxLevelCell) {}
+
+FusedTracerTendOnCell::FusedTracerTendOnCell(const HorzMesh *Mesh)
+    : NVertLevels(Mesh->NVertLevels),
+      Policy(KernelPolicy::get("fusedTracerTendOnCell")),
+      NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
+      CellsOnEdge(Mesh->CellsOnEdge),
+      DivCoeffOnCell(StencilCoeffs::get(Mesh)->DivCoeffOnCell),
+      LaplaceCoeffOnCell(StencilCoeffs::get(Mesh)->LaplaceCoeffOnCell),
+      MeshScalingDel2(Mesh->MeshScalingDel2),
+      MeshScalingDel4(Mesh->MeshScalingDel4), EdgeMask(Mesh->EdgeMask),
+      MinLevelCell(StencilCoeffs::get(Mesh)->MinLevelCell),
+      MaxLevelCell(StencilCoeffs::get(Mesh)->MaxLevelCell) {}
+
+// Collect the enabled flags and coefficients of the individual tracer terms
+void FusedTracerTendOnCell::setTerms(const TracerHorzAdvOnCell &TrHorzAdv,
+                                     const TracerDiffOnCell &TrDiff,
+                                     const TracerHyperDiffOnCell &TrHyperDiff) {
+
+   Terms = 0;
+   if (TrHorzAdv.Enabled)
+      Terms |= HAdv;
+   if (TrDiff.Enabled)
+      Terms |= Del2;
+   if (TrHyperDiff.Enabled)
+      Terms |= Del4;
+
+   EddyDiff2 = TrDiff.EddyDiff2;
+   EddyDiff4 = TrHyperDiff.EddyDiff4;
+}
 
 } // end namespace OMEGA
 
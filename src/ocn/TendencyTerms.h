@@ -16,9 +16,15 @@
 //===----------------------------------------------------------------------===//
 
 #include "AuxiliaryState.h"
+#include "ExecInstances.h"
 #include "HorzMesh.h"
+#include "KernelPolicy.h"
 #include "MachEnv.h"
 #include "OceanState.h"
+#include "OmegaSimd.h"
+#include "StencilCoeffs.h"
+#include "TracerAuxVars.h"
+#include "TracerLayout.h"
 
 #include <functional>
 #include <memory>
@@ -40,18 +46,31 @@ class ThicknessFluxDivOnCell {
                                    const Array2DReal &ThicknessFlux,
                                    const Array2DReal &NormalVelEdge) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * VecLength;
+
+#ifdef OMEGA_SIMD
+      SimdReal DivTmp(0._Real);
 
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
+
+         const SimdReal Flux = loadChunk(ThicknessFlux, JEdge, KStart);
+         const SimdReal Vel  = loadChunk(NormalVelEdge, JEdge, KStart);
+         DivTmp              = DivTmp - DivCoeff * Flux * Vel;
+      }
+
+      storeChunk(Tend, ICell, KStart, loadChunk(Tend, ICell, KStart) - DivTmp);
+#else
       Real DivTmp[VecLength] = {0};
 
       for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const I4 JEdge = EdgesOnCell(ICell, J);
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
          for (int KVec = 0; KVec < VecLength; ++KVec) {
             const I4 K = KStart + KVec;
-            DivTmp[KVec] -= DvEdge(JEdge) * EdgeSignOnCell(ICell, J) *
-                            ThicknessFlux(JEdge, K) * NormalVelEdge(JEdge, K) *
-                            InvAreaCell;
+            DivTmp[KVec] -=
+                DivCoeff * ThicknessFlux(JEdge, K) * NormalVelEdge(JEdge, K);
          }
       }
 
@@ -59,14 +78,13 @@ class ThicknessFluxDivOnCell {
          const I4 K = KStart + KVec;
          Tend(ICell, K) -= DivTmp[KVec];
       }
+#endif
    }
 
  private:
    Array1DI4 NEdgesOnCell;
    Array2DI4 EdgesOnCell;
-   Array1DReal DvEdge;
-   Array1DReal AreaCell;
-   Array2DReal EdgeSignOnCell;
+   Array2DReal DivCoeffOnCell;
 };
 
 /// Horizontal advection of potential vorticity defined on edges, for
@@ -88,7 +106,10 @@ class PotentialVortHAdvOnEdge {
                                    const Array2DReal &FluxLayerThickEdge,
                                    const Array2DReal &NormVelEdge) const {
 
-      const I4 KStart         = KChunk * VecLength;
+      const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelEdge(IEdge), MaxLevelEdge(IEdge)))
+         return;
+
       Real VortTmp[VecLength] = {0};
 
       for (int J = 0; J < NEdgesOnEdge(IEdge); ++J) {
@@ -116,6 +137,8 @@ class PotentialVortHAdvOnEdge {
    Array2DI4 EdgesOnEdge;
    Array2DReal WeightsOnEdge;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
 };
 
 /// Gradient of kinetic energy defined on edges, for momentum equation
@@ -131,22 +154,36 @@ class KEGradOnEdge {
    KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
                                    const Array2DReal &KECell) const {
 
-      const I4 KStart      = KChunk * VecLength;
+      const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelEdge(IEdge), MaxLevelEdge(IEdge)))
+         return;
+
       const I4 JCell0      = CellsOnEdge(IEdge, 0);
       const I4 JCell1      = CellsOnEdge(IEdge, 1);
-      const Real InvDcEdge = 1._Real / DcEdge(IEdge);
-
+      const Real InvDcEdge = GradCoeffOnEdge(IEdge);
+
+#ifdef OMEGA_SIMD
+      const SimdReal KE0  = loadChunk(KECell, JCell0, KStart);
+      const SimdReal KE1  = loadChunk(KECell, JCell1, KStart);
+      const SimdReal Mask = loadChunk(EdgeMask, IEdge, KStart);
+      const SimdReal Grad = (KE1 - KE0) * InvDcEdge;
+      storeChunk(Tend, IEdge, KStart,
+                 loadChunk(Tend, IEdge, KStart) - Mask * Grad);
+#else
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
          Tend(IEdge, K) -= EdgeMask(IEdge, K) *
                            (KECell(JCell1, K) - KECell(JCell0, K)) * InvDcEdge;
       }
+#endif
    }
 
  private:
    Array2DI4 CellsOnEdge;
-   Array1DReal DcEdge;
+   Array1DReal GradCoeffOnEdge;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
 };
 
 /// Gradient of sea surface height defined on edges multipled by gravitational
@@ -163,24 +200,38 @@ class SSHGradOnEdge {
    KOKKOS_FUNCTION void operator()(const Array2DReal &Tend, I4 IEdge, I4 KChunk,
                                    const Array2DReal &SshCell) const {
 
-      const I4 KStart      = KChunk * VecLength;
+      const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelEdge(IEdge), MaxLevelEdge(IEdge)))
+         return;
+
       const I4 ICell0      = CellsOnEdge(IEdge, 0);
       const I4 ICell1      = CellsOnEdge(IEdge, 1);
-      const Real InvDcEdge = 1._Real / DcEdge(IEdge);
-
+      const Real InvDcEdge = GradCoeffOnEdge(IEdge);
+
+#ifdef OMEGA_SIMD
+      const SimdReal Ssh0 = loadChunk(SshCell, ICell0, KStart);
+      const SimdReal Ssh1 = loadChunk(SshCell, ICell1, KStart);
+      const SimdReal Mask = loadChunk(EdgeMask, IEdge, KStart);
+      const SimdReal Grad = Grav * (Ssh1 - Ssh0) * InvDcEdge;
+      storeChunk(Tend, IEdge, KStart,
+                 loadChunk(Tend, IEdge, KStart) - Mask * Grad);
+#else
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
          Tend(IEdge, K) -= EdgeMask(IEdge, K) * Grav *
                            (SshCell(ICell1, K) - SshCell(ICell0, K)) *
                            InvDcEdge;
       }
+#endif
    }
 
  private:
    Real Grav = 9.80665_Real;
    Array2DI4 CellsOnEdge;
-   Array1DReal DcEdge;
+   Array1DReal GradCoeffOnEdge;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
 };
 
 /// Laplacian horizontal mixing, for momentum equation
@@ -201,14 +252,17 @@ class VelocityDiffusionOnEdge {
                                    const Array2DReal &RVortVertex) const {
 
       const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelEdge(IEdge), MaxLevelEdge(IEdge)))
+         return;
+
       const I4 ICell0 = CellsOnEdge(IEdge, 0);
       const I4 ICell1 = CellsOnEdge(IEdge, 1);
 
       const I4 IVertex0 = VerticesOnEdge(IEdge, 0);
       const I4 IVertex1 = VerticesOnEdge(IEdge, 1);
 
-      const Real DcEdgeInv = 1._Real / DcEdge(IEdge);
-      const Real DvEdgeInv = 1._Real / DvEdge(IEdge);
+      const Real DcEdgeInv = GradCoeffOnEdge(IEdge);
+      const Real DvEdgeInv = TangentGradCoeffOnEdge(IEdge);
 
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
@@ -225,10 +279,12 @@ class VelocityDiffusionOnEdge {
  private:
    Array2DI4 CellsOnEdge;
    Array2DI4 VerticesOnEdge;
-   Array1DReal DcEdge;
-   Array1DReal DvEdge;
+   Array1DReal GradCoeffOnEdge;
+   Array1DReal TangentGradCoeffOnEdge;
    Array1DReal MeshScalingDel2;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
 };
 
 /// Biharmonic horizontal mixing, for momentum equation
@@ -250,14 +306,17 @@ class VelocityHyperDiffOnEdge {
                                    const Array2DReal &Del2RVortVertex) const {
 
       const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelEdge(IEdge), MaxLevelEdge(IEdge)))
+         return;
+
       const I4 ICell0 = CellsOnEdge(IEdge, 0);
       const I4 ICell1 = CellsOnEdge(IEdge, 1);
 
       const I4 IVertex0 = VerticesOnEdge(IEdge, 0);
       const I4 IVertex1 = VerticesOnEdge(IEdge, 1);
 
-      const Real DcEdgeInv = 1._Real / DcEdge(IEdge);
-      const Real DvEdgeInv = 1._Real / DvEdge(IEdge);
+      const Real DcEdgeInv = GradCoeffOnEdge(IEdge);
+      const Real DvEdgeInv = TangentGradCoeffOnEdge(IEdge);
 
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
@@ -275,10 +334,12 @@ class VelocityHyperDiffOnEdge {
  private:
    Array2DI4 CellsOnEdge;
    Array2DI4 VerticesOnEdge;
-   Array1DReal DcEdge;
-   Array1DReal DvEdge;
+   Array1DReal GradCoeffOnEdge;
+   Array1DReal TangentGradCoeffOnEdge;
    Array1DReal MeshScalingDel4;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
 };
 
 /// Wind forcing
@@ -343,31 +404,360 @@ class BottomDragOnEdge {
    Array2DReal EdgeMask;
 };
 
-// Tracer horizontal advection term
+/// Fused momentum tendency on edges. Computes the sum of all enabled
+/// momentum tendency terms in a single pass over edges and vertical chunks,
+/// so the edge connectivity and geometry are loaded once per edge and each
+/// entry of the tendency array is written once rather than updated by every
+/// term. The set of terms is a template parameter of the kernel so that
+/// disabled terms generate no code, and compute selects the kernel matching
+/// the terms enabled at run time. The tendency array is overwritten, so it
+/// does not need to be zeroed beforehand. The kernel is launched with the
+/// KernelPolicy of fusedVelocityTendOnEdge. With the team policy the
+/// neighbor edges and weights of each edge are staged in team scratch memory
+/// once for all vertical chunks.
+class FusedVelocityTendOnEdge {
+ public:
+   /// Bit flags for the terms included in the fused tendency
+   enum Term : I4 {
+      PVAdv   = 1 << 0, ///< potential vorticity horizontal advection
+      KEGrad  = 1 << 1, ///< gradient of kinetic energy
+      SSHGrad = 1 << 2, ///< gradient of sea surface height
+      Del2    = 1 << 3, ///< Laplacian horizontal mixing
+      Del4    = 1 << 4, ///< biharmonic horizontal mixing
+      Wind    = 1 << 5, ///< wind forcing
+      Drag    = 1 << 6  ///< bottom drag
+   };
+
+   /// Number of distinct combinations of terms
+   static constexpr I4 NCombinations = 1 << 7;
+
+   /// Input arrays for all terms. Arrays needed only by disabled terms are
+   /// not accessed and may be left unallocated.
+   struct Inputs {
+      Array2DReal NormRVortEdge;      ///< normalized relative vorticity
+      Array2DReal NormFEdge;          ///< normalized planetary vorticity
+      Array2DReal FluxLayerThickEdge; ///< layer thickness for fluxes
+      Array2DReal NormVelEdge;        ///< normal velocity
+      Array2DReal KECell;             ///< kinetic energy at cells
+      Array2DReal SshCell;            ///< sea surface height at cells
+      Array2DReal DivCell;            ///< velocity divergence at cells
+      Array2DReal RVortVertex;        ///< relative vorticity at vertices
+      Array2DReal Del2DivCell;        ///< Laplacian of divergence
+      Array2DReal Del2RVortVertex;    ///< Laplacian of relative vorticity
+      Array1DReal NormalStressEdge;   ///< normal wind stress
+      Array2DReal LayerThickEdge;     ///< mean layer thickness at edges
+   };
+
+   /// constructor declaration
+   FusedVelocityTendOnEdge(const HorzMesh *Mesh);
+
+   /// Sets the enabled terms and their coefficients from the individual
+   /// term functors
+   void setTerms(const PotentialVortHAdvOnEdge &PotVortHAdv,
+                 const KEGradOnEdge &KEGradTerm,
+                 const SSHGradOnEdge &SSHGradTerm,
+                 const VelocityDiffusionOnEdge &VelDiff,
+                 const VelocityHyperDiffOnEdge &VelHyperDiff,
+                 const WindForcingOnEdge &WindForcing,
+                 const BottomDragOnEdge &BottomDrag);
+
+   /// Returns the bit mask of enabled terms
+   I4 getTerms() const { return Terms; }
+
+   /// Sets the parallel policy of the kernel
+   void setPolicy(KernelPolicyType InPolicy) { Policy = InPolicy; }
+
+   /// Returns the parallel policy of the kernel
+   KernelPolicyType getPolicy() const { return Policy; }
+
+   /// Computes the fused tendency for edges 0 to NEdges - 1 and all vertical
+   /// chunks on the instance of the velocity group. The kernels queued on the
+   /// default instance are completed first. With concurrent execution the
+   /// groups must be joined with ExecInstances::fence() before the tendency
+   /// is used.
+   void compute(const Array2DReal &Tend, ///< [out] velocity tendency
+                const Inputs &In,        ///< [in] input arrays
+                I4 NEdges                ///< [in] number of edges to compute
+   ) const {
+      ExecInstances::fenceDefault();
+      dispatch<0>(Tend, In, NEdges, ExecInstances::get(ExecGroup::Velocity));
+   }
+
+   /// Computes the fused tendency as above on an execution space instance,
+   /// which can run concurrently with kernels on other instances. The caller
+   /// must complete the kernels that produce the inputs first, for example
+   /// with ExecInstances::fenceDefault(), and the instance must be fenced
+   /// before the tendency is used elsewhere.
+   void compute(const Array2DReal &Tend, ///< [out] velocity tendency
+                const Inputs &In,        ///< [in] input arrays
+                I4 NEdges,               ///< [in] number of edges to compute
+                const ExecSpace &Space   ///< [in] execution space instance
+   ) const {
+      dispatch<0>(Tend, In, NEdges, Space);
+   }
+
+   /// Neighbor edges and weights of an edge read from the mesh arrays
+   struct MeshStencil {
+      const FusedVelocityTendOnEdge &Fused;
+      I4 IEdge;
+      KOKKOS_FUNCTION I4 nEdges() const { return Fused.NEdgesOnEdge(IEdge); }
+      KOKKOS_FUNCTION I4 edge(I4 J) const {
+         return Fused.EdgesOnEdge(IEdge, J);
+      }
+      KOKKOS_FUNCTION Real weight(I4 J) const {
+         return Fused.WeightsOnEdge(IEdge, J);
+      }
+   };
+
+   /// Neighbor edges and weights of an edge staged in team scratch memory
+   struct ScratchStencil {
+      I4 NEdges;
+      ScratchArray1DI4 Edges;
+      ScratchArray1DReal Weights;
+      KOKKOS_FUNCTION I4 nEdges() const { return NEdges; }
+      KOKKOS_FUNCTION I4 edge(I4 J) const { return Edges(J); }
+      KOKKOS_FUNCTION Real weight(I4 J) const { return Weights(J); }
+   };
+
+   /// The kernel for one edge and vertical chunk, including the terms in
+   /// TermMask
+   template <I4 TermMask>
+   KOKKOS_FUNCTION void computeChunk(const Array2DReal &Tend, I4 IEdge,
+                                     I4 KChunk, const Inputs &In) const {
+      computeChunk<TermMask>(Tend, IEdge, KChunk, In,
+                             MeshStencil{*this, IEdge});
+   }
+
+   /// The kernel for one edge and vertical chunk with the neighbor edges
+   /// taken from Nbrs, either a MeshStencil or a ScratchStencil
+   template <I4 TermMask, class Stencil>
+   KOKKOS_FUNCTION void computeChunk(const Array2DReal &Tend, I4 IEdge,
+                                     I4 KChunk, const Inputs &In,
+                                     const Stencil &Nbrs) const {
+
+      const I4 KStart = KChunk * VecLength;
+
+      // The tendency is overwritten, so inactive chunks are set to zero
+      if (!isActiveChunk(KStart, MinLevelEdge(IEdge), MaxLevelEdge(IEdge))) {
+         for (int KVec = 0; KVec < VecLength; ++KVec)
+            Tend(IEdge, KStart + KVec) = 0;
+         return;
+      }
+
+      const I4 ICell0 = CellsOnEdge(IEdge, 0);
+      const I4 ICell1 = CellsOnEdge(IEdge, 1);
+
+      const I4 IVertex0 = VerticesOnEdge(IEdge, 0);
+      const I4 IVertex1 = VerticesOnEdge(IEdge, 1);
+
+      const Real InvDcEdge = GradCoeffOnEdge(IEdge);
+      const Real InvDvEdge = TangentGradCoeffOnEdge(IEdge);
+
+      Real TendTmp[VecLength] = {0};
+
+      if constexpr ((TermMask & PVAdv) != 0) {
+         for (int J = 0; J < Nbrs.nEdges(); ++J) {
+            const I4 JEdge    = Nbrs.edge(J);
+            const Real Weight = Nbrs.weight(J);
+            for (int KVec = 0; KVec < VecLength; ++KVec) {
+               const I4 K    = KStart + KVec;
+               Real NormVort = (In.NormRVortEdge(IEdge, K) +
+                                In.NormFEdge(IEdge, K) +
+                                In.NormRVortEdge(JEdge, K) +
+                                In.NormFEdge(JEdge, K)) *
+                               0.5_Real;
+               TendTmp[KVec] += Weight * In.FluxLayerThickEdge(JEdge, K) *
+                                In.NormVelEdge(JEdge, K) * NormVort;
+            }
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K = KStart + KVec;
+         if constexpr ((TermMask & KEGrad) != 0) {
+            TendTmp[KVec] -=
+                (In.KECell(ICell1, K) - In.KECell(ICell0, K)) * InvDcEdge;
+         }
+         if constexpr ((TermMask & SSHGrad) != 0) {
+            TendTmp[KVec] -= Grav *
+                             (In.SshCell(ICell1, K) - In.SshCell(ICell0, K)) *
+                             InvDcEdge;
+         }
+         if constexpr ((TermMask & Del2) != 0) {
+            const Real Del2U =
+                ((In.DivCell(ICell1, K) - In.DivCell(ICell0, K)) * InvDcEdge -
+                 (In.RVortVertex(IVertex1, K) - In.RVortVertex(IVertex0, K)) *
+                     InvDvEdge);
+            TendTmp[KVec] += ViscDel2 * MeshScalingDel2(IEdge) * Del2U;
+         }
+         if constexpr ((TermMask & Del4) != 0) {
+            const Real Del2U =
+                (DivFactor *
+                     (In.Del2DivCell(ICell1, K) - In.Del2DivCell(ICell0, K)) *
+                     InvDcEdge -
+                 (In.Del2RVortVertex(IVertex1, K) -
+                  In.Del2RVortVertex(IVertex0, K)) *
+                     InvDvEdge);
+            TendTmp[KVec] -= ViscDel4 * MeshScalingDel4(IEdge) * Del2U;
+         }
+      }
+
+      if constexpr ((TermMask & Wind) != 0) {
+         if (KChunk == 0) {
+            const Real InvThickEdge = 1._Real / In.LayerThickEdge(IEdge, 0);
+            TendTmp[0] +=
+                InvThickEdge * In.NormalStressEdge(IEdge) / SaltWaterDensity;
+         }
+      }
+
+      if constexpr ((TermMask & Drag) != 0) {
+         const I4 KBot = NVertLevels - 1;
+         const I4 KVec = KBot - KStart;
+         if (KVec >= 0 && KVec < VecLength) {
+            const Real VelNormEdge  = Kokkos::sqrt(In.KECell(ICell0, KBot) +
+                                                   In.KECell(ICell1, KBot));
+            const Real InvThickEdge = 1._Real / In.LayerThickEdge(IEdge, KBot);
+            TendTmp[KVec] -= DragCoeff * VelNormEdge * InvThickEdge *
+                             In.NormVelEdge(IEdge, KBot);
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K     = KStart + KVec;
+         Tend(IEdge, K) = EdgeMask(IEdge, K) * TendTmp[KVec];
+      }
+   }
+
+   // these should be private, they are public only because of CUDA
+   // limitations
+
+   /// Launches the kernel for the terms in TermMask over all edges and
+   /// vertical chunks with the selected policy
+   template <I4 TermMask>
+   void launch(const Array2DReal &Tend, const Inputs &In, I4 NEdges,
+               const ExecSpace &Space) const {
+      if (Policy == KernelPolicyType::Team) {
+         launchTeam<TermMask>(Tend, In, NEdges, Space);
+         return;
+      }
+      const FusedVelocityTendOnEdge Fused = *this;
+      const I4 NChunks                    = NVertLevels / VecLength;
+      Kokkos::parallel_for(
+          "fusedVelocityTendOnEdge",
+          Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>>(
+              Space, {0, 0}, {NEdges, NChunks}),
+          KOKKOS_LAMBDA(int IEdge, int KChunk) {
+             Fused.computeChunk<TermMask>(Tend, IEdge, KChunk, In);
+          });
+   }
+
+   /// Launches the kernel with one team per edge. The neighbor edges and
+   /// weights are staged in team scratch memory and the vertical chunks are
+   /// spread over the threads and vector lanes of the team.
+   template <I4 TermMask>
+   void launchTeam(const Array2DReal &Tend, const Inputs &In, I4 NEdges,
+                   const ExecSpace &Space) const {
+      const FusedVelocityTendOnEdge Fused = *this;
+      const I4 NChunks                    = NVertLevels / VecLength;
+      const I4 MaxEdges                   = EdgesOnEdge.extent_int(1);
+      const size_t ScratchBytes = ScratchArray1DI4::shmem_size(MaxEdges) +
+                                  ScratchArray1DReal::shmem_size(MaxEdges);
+
+      TeamPolicyType TeamPolicy(Space, NEdges, Kokkos::AUTO);
+      TeamPolicy.set_scratch_size(0, Kokkos::PerTeam(ScratchBytes));
+
+      Kokkos::parallel_for(
+          "fusedVelocityTendOnEdgeTeam", TeamPolicy,
+          KOKKOS_LAMBDA(const TeamMemberType &Member) {
+             const I4 IEdge = Member.league_rank();
+             ScratchStencil Nbrs{
+                 Fused.NEdgesOnEdge(IEdge),
+                 ScratchArray1DI4(Member.team_scratch(0), MaxEdges),
+                 ScratchArray1DReal(Member.team_scratch(0), MaxEdges)};
+
+             Kokkos::parallel_for(
+                 Kokkos::TeamVectorRange(Member, Nbrs.NEdges), [&](int J) {
+                    Nbrs.Edges(J)   = Fused.EdgesOnEdge(IEdge, J);
+                    Nbrs.Weights(J) = Fused.WeightsOnEdge(IEdge, J);
+                 });
+             Member.team_barrier();
+
+             Kokkos::parallel_for(
+                 Kokkos::TeamVectorRange(Member, NChunks), [&](int KChunk) {
+                    Fused.computeChunk<TermMask>(Tend, IEdge, KChunk, In,
+                                                 Nbrs);
+                 });
+          });
+   }
+
+   /// Searches the term combinations from TermMask upward and launches the
+   /// kernel matching the enabled terms
+   template <I4 TermMask>
+   void dispatch(const Array2DReal &Tend, const Inputs &In, I4 NEdges,
+                 const ExecSpace &Space) const {
+      if constexpr (TermMask < NCombinations) {
+         if (Terms == TermMask) {
+            launch<TermMask>(Tend, In, NEdges, Space);
+         } else {
+            dispatch<TermMask + 1>(Tend, In, NEdges, Space);
+         }
+      }
+   }
+
+ private:
+   I4 Terms = 0;
+   I4 NVertLevels;
+   KernelPolicyType Policy;
+   Real Grav             = 9.80665_Real;
+   Real ViscDel2         = 0;
+   Real ViscDel4         = 0;
+   Real DivFactor        = 0;
+   Real SaltWaterDensity = 1;
+   Real DragCoeff        = 0;
+   Array1DI4 NEdgesOnEdge;
+   Array2DI4 EdgesOnEdge;
+   Array2DI4 CellsOnEdge;
+   Array2DI4 VerticesOnEdge;
+   Array2DReal WeightsOnEdge;
+   Array1DReal GradCoeffOnEdge;
+   Array1DReal TangentGradCoeffOnEdge;
+   Array1DReal MeshScalingDel2;
+   Array1DReal MeshScalingDel4;
+   Array2DReal EdgeMask;
+   Array1DI4 MinLevelEdge;
+   Array1DI4 MaxLevelEdge;
+};
+
+// Tracer horizontal advection term. The tracer functors take the tracer
+// arrays as template arguments so they can be either the canonical
+// Array3DReal or a TracerArray in another layout.
 class TracerHorzAdvOnCell {
  public:
    bool Enabled;
 
    TracerHorzAdvOnCell(const HorzMesh *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array3DReal &Tend, I4 L, I4 ICell,
-                                   I4 KChunk, const Array2DReal &NormVelEdge,
-                                   const Array3DReal &HTracersOnEdge) const {
+   template <class TracerArrayType>
+   KOKKOS_FUNCTION void
+   operator()(const TracerArrayType &Tend, I4 L, I4 ICell, I4 KChunk,
+              const Array2DReal &NormVelEdge,
+              const Array3DTracerAux &HTracersOnEdge) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
 
       Real HAdvTmp[VecLength] = {0};
 
       for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
-         const I4 JEdge = EdgesOnCell(ICell, J);
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
 
          for (int KVec = 0; KVec < VecLength; ++KVec) {
             const I4 K = KStart + KVec;
-            HAdvTmp[KVec] -= EdgeMask(JEdge, K) * DvEdge(JEdge) *
-                             EdgeSignOnCell(ICell, J) *
+            HAdvTmp[KVec] -= EdgeMask(JEdge, K) * DivCoeff *
                              HTracersOnEdge(L, JEdge, K) *
-                             NormVelEdge(JEdge, K) * InvAreaCell;
+                             NormVelEdge(JEdge, K);
          }
       }
       for (int KVec = 0; KVec < VecLength; ++KVec) {
@@ -379,11 +769,10 @@ class TracerHorzAdvOnCell {
  private:
    Array1DI4 NEdgesOnCell;
    Array2DI4 EdgesOnCell;
-   Array2DI4 CellsOnEdge;
-   Array2DReal EdgeSignOnCell;
-   Array1DReal DvEdge;
-   Array1DReal AreaCell;
+   Array2DReal DivCoeffOnCell;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
 };
 
 // Tracer horizontal diffusion term
@@ -395,14 +784,37 @@ class TracerDiffOnCell {
 
    TracerDiffOnCell(const HorzMesh *Mesh);
 
+   template <class TracerArrayType>
    KOKKOS_FUNCTION void
-   operator()(const Array3DReal &Tend, I4 L, I4 ICell, I4 KChunk,
-              const Array3DReal &TracerCell,
+   operator()(const TracerArrayType &Tend, I4 L, I4 ICell, I4 KChunk,
+              const TracerArrayType &TracerCell,
               const Array2DReal &MeanLayerThickEdge) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
+
+#ifdef OMEGA_SIMD
+      SimdReal DiffTmp(0._Real);
+
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const I4 JEdge  = EdgesOnCell(ICell, J);
+         const I4 JCell0 = CellsOnEdge(JEdge, 0);
+         const I4 JCell1 = CellsOnEdge(JEdge, 1);
+
+         const Real RTemp =
+             MeshScalingDel2(JEdge) * LaplaceCoeffOnCell(ICell, J);
+
+         const SimdReal Tr0   = loadChunk(TracerCell, L, JCell0, KStart);
+         const SimdReal Tr1   = loadChunk(TracerCell, L, JCell1, KStart);
+         const SimdReal Mask  = loadChunk(EdgeMask, JEdge, KStart);
+         const SimdReal Thick = loadChunk(MeanLayerThickEdge, JEdge, KStart);
+         DiffTmp              = DiffTmp - Mask * RTemp * Thick * (Tr1 - Tr0);
+      }
 
+      storeChunk(Tend, L, ICell, KStart,
+                 loadChunk(Tend, L, ICell, KStart) + EddyDiff2 * DiffTmp);
+#else
       Real DiffTmp[VecLength] = {0};
 
       for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
@@ -412,33 +824,33 @@ class TracerDiffOnCell {
          const I4 JCell1 = CellsOnEdge(JEdge, 1);
 
          const Real RTemp =
-             MeshScalingDel2(JEdge) * DvEdge(JEdge) / DcEdge(JEdge);
+             MeshScalingDel2(JEdge) * LaplaceCoeffOnCell(ICell, J);
 
          for (int KVec = 0; KVec < VecLength; ++KVec) {
             const I4 K = KStart + KVec;
             const Real TracerGrad =
                 (TracerCell(L, JCell1, K) - TracerCell(L, JCell0, K));
 
-            DiffTmp[KVec] -= EdgeMask(JEdge, K) * EdgeSignOnCell(ICell, J) *
-                             RTemp * MeanLayerThickEdge(JEdge, K) * TracerGrad;
+            DiffTmp[KVec] -= EdgeMask(JEdge, K) * RTemp *
+                             MeanLayerThickEdge(JEdge, K) * TracerGrad;
          }
       }
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
-         Tend(L, ICell, K) += EddyDiff2 * DiffTmp[KVec] * InvAreaCell;
+         Tend(L, ICell, K) += EddyDiff2 * DiffTmp[KVec];
       }
+#endif
    }
 
  private:
    Array1DI4 NEdgesOnCell;
    Array2DI4 EdgesOnCell;
    Array2DI4 CellsOnEdge;
-   Array2DReal EdgeSignOnCell;
-   Array1DReal DvEdge;
-   Array1DReal DcEdge;
-   Array1DReal AreaCell;
+   Array2DReal LaplaceCoeffOnCell;
    Array1DReal MeshScalingDel2;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
 };
 
 // Tracer biharmonic horizontal mixing term
@@ -450,12 +862,14 @@ class TracerHyperDiffOnCell {
 
    TracerHyperDiffOnCell(const HorzMesh *Mesh);
 
-   KOKKOS_FUNCTION void operator()(const Array3DReal &Tend, I4 L, I4 ICell,
+   template <class TracerArrayType>
+   KOKKOS_FUNCTION void operator()(const TracerArrayType &Tend, I4 L, I4 ICell,
                                    I4 KChunk,
-                                   const Array3DReal &TrDel2Cell) const {
+                                   const Array3DTracerAux &TrDel2Cell) const {
 
-      const I4 KStart        = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const I4 KStart = KChunk * VecLength;
+      if (!isActiveChunk(KStart, MinLevelCell(ICell), MaxLevelCell(ICell)))
+         return;
 
       Real HypTmp[VecLength] = {0};
 
@@ -466,20 +880,21 @@ class TracerHyperDiffOnCell {
          const I4 JCell1 = CellsOnEdge(JEdge, 1);
 
          const Real RTemp =
-             MeshScalingDel4(JEdge) * DvEdge(JEdge) / DcEdge(JEdge);
+             MeshScalingDel4(JEdge) * LaplaceCoeffOnCell(ICell, J);
 
          for (int KVec = 0; KVec < VecLength; ++KVec) {
             const I4 K = KStart + KVec;
+            // promote before differencing in case of reduced storage
             const Real Del2TrGrad =
-                (TrDel2Cell(L, JCell1, K) - TrDel2Cell(L, JCell0, K));
+                static_cast<Real>(TrDel2Cell(L, JCell1, K)) -
+                static_cast<Real>(TrDel2Cell(L, JCell0, K));
 
-            HypTmp[KVec] -= EdgeMask(JEdge, K) * EdgeSignOnCell(ICell, J) *
-                            RTemp * Del2TrGrad;
+            HypTmp[KVec] -= EdgeMask(JEdge, K) * RTemp * Del2TrGrad;
          }
       }
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const I4 K = KStart + KVec;
-         Tend(L, ICell, K) -= EddyDiff4 * HypTmp[KVec] * InvAreaCell;
+         Tend(L, ICell, K) -= EddyDiff4 * HypTmp[KVec];
       }
    }
 
@@ -487,12 +902,312 @@ class TracerHyperDiffOnCell {
    Array1DI4 NEdgesOnCell;
    Array2DI4 EdgesOnCell;
    Array2DI4 CellsOnEdge;
-   Array2DReal EdgeSignOnCell;
-   Array1DReal DvEdge;
-   Array1DReal DcEdge;
-   Array1DReal AreaCell;
+   Array2DReal LaplaceCoeffOnCell;
+   Array1DReal MeshScalingDel4;
+   Array2DReal EdgeMask;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
+};
+
+/// Fused tracer tendency on cells. Computes horizontal advection, Laplacian
+/// and biharmonic mixing of all tracers in a single pass over cells and
+/// vertical chunks. The tracers are processed in batches of TracerBatchSize
+/// so that the edge stencil geometry of a cell and the velocity, mask and
+/// thickness on each edge are loaded once per batch of tracers rather than
+/// once per tracer and term. As for FusedVelocityTendOnEdge, the enabled
+/// terms are a template parameter of the kernel and the tendency array is
+/// overwritten rather than updated. The kernel is launched with the
+/// KernelPolicy of fusedTracerTendOnCell. With the team policy the edges,
+/// edge cells and coefficients of each cell are staged in team scratch
+/// memory once for all vertical chunks.
+class FusedTracerTendOnCell {
+ public:
+   /// Bit flags for the terms included in the fused tendency
+   enum Term : I4 {
+      HAdv = 1 << 0, ///< horizontal advection
+      Del2 = 1 << 1, ///< Laplacian horizontal mixing
+      Del4 = 1 << 2  ///< biharmonic horizontal mixing
+   };
+
+   /// Number of distinct combinations of terms
+   static constexpr I4 NCombinations = 1 << 3;
+
+   /// Number of tracers accumulated together for each load of the stencil
+   static constexpr I4 TracerBatchSize = 4;
+
+   /// Input arrays for all terms. Arrays needed only by disabled terms are
+   /// not accessed and may be left unallocated.
+   struct Inputs {
+      Array2DReal NormVelEdge;         ///< normal velocity
+      Array3DTracerAux HTracersOnEdge; ///< thickness-weighted edge tracers
+      Array3DReal TracerCell;          ///< tracers at cells
+      Array2DReal MeanLayerThickEdge;  ///< mean layer thickness at edges
+      Array3DTracerAux TrDel2Cell;     ///< Laplacian of tracers at cells
+   };
+
+   /// constructor declaration
+   FusedTracerTendOnCell(const HorzMesh *Mesh);
+
+   /// Sets the enabled terms and their coefficients from the individual
+   /// term functors
+   void setTerms(const TracerHorzAdvOnCell &TrHorzAdv,
+                 const TracerDiffOnCell &TrDiff,
+                 const TracerHyperDiffOnCell &TrHyperDiff);
+
+   /// Returns the bit mask of enabled terms
+   I4 getTerms() const { return Terms; }
+
+   /// Sets the parallel policy of the kernel
+   void setPolicy(KernelPolicyType InPolicy) { Policy = InPolicy; }
+
+   /// Returns the parallel policy of the kernel
+   KernelPolicyType getPolicy() const { return Policy; }
+
+   /// Computes the fused tendency of all tracers for cells 0 to NCells - 1
+   /// and all vertical chunks on the instance of the tracer group, after the
+   /// kernels queued on the default instance complete. As for the velocity
+   /// tendency, the groups must be joined with ExecInstances::fence().
+   void compute(const Array3DReal &Tend, ///< [out] tracer tendency
+                const Inputs &In,        ///< [in] input arrays
+                I4 NCells                ///< [in] number of cells to compute
+   ) const {
+      ExecInstances::fenceDefault();
+      dispatch<0>(Tend, In, NCells, ExecInstances::get(ExecGroup::Tracer));
+   }
+
+   /// Computes the fused tendency as above on an execution space instance,
+   /// which can run concurrently with kernels on other instances. The caller
+   /// must complete the kernels that produce the inputs first and the
+   /// instance must be fenced before the tendency is used elsewhere.
+   void compute(const Array3DReal &Tend, ///< [out] tracer tendency
+                const Inputs &In,        ///< [in] input arrays
+                I4 NCells,               ///< [in] number of cells to compute
+                const ExecSpace &Space   ///< [in] execution space instance
+   ) const {
+      dispatch<0>(Tend, In, NCells, Space);
+   }
+
+   /// Edges of a cell, the cells of each edge and the coefficients of each
+   /// edge read from the mesh and stencil arrays
+   struct MeshStencil {
+      const FusedTracerTendOnCell &Fused;
+      I4 ICell;
+      KOKKOS_FUNCTION I4 nEdges() const { return Fused.NEdgesOnCell(ICell); }
+      KOKKOS_FUNCTION I4 edge(I4 J) const {
+         return Fused.EdgesOnCell(ICell, J);
+      }
+      KOKKOS_FUNCTION I4 cell(I4 J, I4 Side) const {
+         return Fused.CellsOnEdge(Fused.EdgesOnCell(ICell, J), Side);
+      }
+      KOKKOS_FUNCTION Real divCoeff(I4 J) const {
+         return Fused.DivCoeffOnCell(ICell, J);
+      }
+      KOKKOS_FUNCTION Real laplaceCoeff(I4 J) const {
+         return Fused.LaplaceCoeffOnCell(ICell, J);
+      }
+   };
+
+   /// The same stencil staged in team scratch memory. Index holds the edge
+   /// and its two cells and Coeff the divergence and Laplacian coefficients.
+   struct ScratchStencil {
+      I4 NEdges;
+      ScratchArray2DI4 Index;
+      ScratchArray2DReal Coeff;
+      KOKKOS_FUNCTION I4 nEdges() const { return NEdges; }
+      KOKKOS_FUNCTION I4 edge(I4 J) const { return Index(0, J); }
+      KOKKOS_FUNCTION I4 cell(I4 J, I4 Side) const {
+         return Index(1 + Side, J);
+      }
+      KOKKOS_FUNCTION Real divCoeff(I4 J) const { return Coeff(0, J); }
+      KOKKOS_FUNCTION Real laplaceCoeff(I4 J) const { return Coeff(1, J); }
+   };
+
+   /// The kernel for one cell and vertical chunk, including the terms in
+   /// TermMask for all tracers
+   template <I4 TermMask>
+   KOKKOS_FUNCTION void computeChunk(const Array3DReal &Tend, I4 ICell,
+                                     I4 KChunk, const Inputs &In) const {
+      computeChunk<TermMask>(Tend, ICell, KChunk, In,
+                             MeshStencil{*this, ICell});
+   }
+
+   /// The kernel for one cell and vertical chunk with the cell stencil taken
+   /// from Nbrs, either a MeshStencil or a ScratchStencil
+   template <I4 TermMask, class Stencil>
+   KOKKOS_FUNCTION void computeChunk(const Array3DReal &Tend, I4 ICell,
+                                     I4 KChunk, const Inputs &In,
+                                     const Stencil &Nbrs) const {
+
+      const I4 KStart   = KChunk * VecLength;
+      const I4 NTracers = Tend.extent_int(0);
+
+      // The tendency is overwritten, so inactive chunks are set to zero
+      if (!isActiveChunk(KStart, MinLevelCell(ICell), MaxLevelCell(ICell))) {
+         for (int L = 0; L < NTracers; ++L) {
+            for (int KVec = 0; KVec < VecLength; ++KVec)
+               Tend(L, ICell, KStart + KVec) = 0;
+         }
+         return;
+      }
+
+      for (int LStart = 0; LStart < NTracers; LStart += TracerBatchSize) {
+         const I4 NBatch = Kokkos::min(TracerBatchSize, NTracers - LStart);
+
+         Real TendTmp[TracerBatchSize][VecLength] = {{0}};
+
+         for (int J = 0; J < Nbrs.nEdges(); ++J) {
+            const I4 JEdge  = Nbrs.edge(J);
+            const I4 JCell0 = Nbrs.cell(J, 0);
+            const I4 JCell1 = Nbrs.cell(J, 1);
+
+            const Real DivCoeff     = Nbrs.divCoeff(J);
+            const Real LaplaceCoeff = Nbrs.laplaceCoeff(J);
+
+            Real CoefDel2 = 0;
+            Real CoefDel4 = 0;
+            if constexpr ((TermMask & Del2) != 0)
+               CoefDel2 = -EddyDiff2 * MeshScalingDel2(JEdge);
+            if constexpr ((TermMask & Del4) != 0)
+               CoefDel4 = EddyDiff4 * MeshScalingDel4(JEdge);
+
+            for (int KVec = 0; KVec < VecLength; ++KVec) {
+               const I4 K      = KStart + KVec;
+               const Real Mask = EdgeMask(JEdge, K);
+
+               Real AdvCoef  = 0;
+               Real Del2Coef = 0;
+               if constexpr ((TermMask & HAdv) != 0)
+                  AdvCoef = Mask * DivCoeff * In.NormVelEdge(JEdge, K);
+               if constexpr ((TermMask & Del2) != 0)
+                  Del2Coef = Mask * CoefDel2 * LaplaceCoeff *
+                             In.MeanLayerThickEdge(JEdge, K);
+               const Real Del4Coef = Mask * CoefDel4 * LaplaceCoeff;
+
+               for (int LB = 0; LB < NBatch; ++LB) {
+                  const I4 L = LStart + LB;
+                  Real Sum   = 0;
+                  if constexpr ((TermMask & HAdv) != 0) {
+                     Sum += AdvCoef * In.HTracersOnEdge(L, JEdge, K);
+                  }
+                  if constexpr ((TermMask & Del2) != 0) {
+                     Sum += Del2Coef * (In.TracerCell(L, JCell1, K) -
+                                        In.TracerCell(L, JCell0, K));
+                  }
+                  if constexpr ((TermMask & Del4) != 0) {
+                     Sum += Del4Coef *
+                            (static_cast<Real>(In.TrDel2Cell(L, JCell1, K)) -
+                             static_cast<Real>(In.TrDel2Cell(L, JCell0, K)));
+                  }
+                  TendTmp[LB][KVec] += Sum;
+               }
+            }
+         }
+
+         for (int LB = 0; LB < NBatch; ++LB) {
+            for (int KVec = 0; KVec < VecLength; ++KVec) {
+               const I4 K                  = KStart + KVec;
+               Tend(LStart + LB, ICell, K) = TendTmp[LB][KVec];
+            }
+         }
+      }
+   }
+
+   // these should be private, they are public only because of CUDA
+   // limitations
+
+   /// Launches the kernel for the terms in TermMask over all cells and
+   /// vertical chunks with the selected policy
+   template <I4 TermMask>
+   void launch(const Array3DReal &Tend, const Inputs &In, I4 NCells,
+               const ExecSpace &Space) const {
+      if (Policy == KernelPolicyType::Team) {
+         launchTeam<TermMask>(Tend, In, NCells, Space);
+         return;
+      }
+      const FusedTracerTendOnCell Fused = *this;
+      const I4 NChunks                  = NVertLevels / VecLength;
+      Kokkos::parallel_for(
+          "fusedTracerTendOnCell",
+          Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>>(
+              Space, {0, 0}, {NCells, NChunks}),
+          KOKKOS_LAMBDA(int ICell, int KChunk) {
+             Fused.computeChunk<TermMask>(Tend, ICell, KChunk, In);
+          });
+   }
+
+   /// Launches the kernel with one team per cell. The cell stencil is staged
+   /// in team scratch memory and the vertical chunks are spread over the
+   /// threads and vector lanes of the team.
+   template <I4 TermMask>
+   void launchTeam(const Array3DReal &Tend, const Inputs &In, I4 NCells,
+                   const ExecSpace &Space) const {
+      const FusedTracerTendOnCell Fused = *this;
+      const I4 NChunks                  = NVertLevels / VecLength;
+      const I4 MaxEdges                 = EdgesOnCell.extent_int(1);
+      const size_t ScratchBytes = ScratchArray2DI4::shmem_size(3, MaxEdges) +
+                                  ScratchArray2DReal::shmem_size(2, MaxEdges);
+
+      TeamPolicyType TeamPolicy(Space, NCells, Kokkos::AUTO);
+      TeamPolicy.set_scratch_size(0, Kokkos::PerTeam(ScratchBytes));
+
+      Kokkos::parallel_for(
+          "fusedTracerTendOnCellTeam", TeamPolicy,
+          KOKKOS_LAMBDA(const TeamMemberType &Member) {
+             const I4 ICell = Member.league_rank();
+             ScratchStencil Nbrs{
+                 Fused.NEdgesOnCell(ICell),
+                 ScratchArray2DI4(Member.team_scratch(0), 3, MaxEdges),
+                 ScratchArray2DReal(Member.team_scratch(0), 2, MaxEdges)};
+
+             Kokkos::parallel_for(
+                 Kokkos::TeamVectorRange(Member, Nbrs.NEdges), [&](int J) {
+                    const I4 JEdge   = Fused.EdgesOnCell(ICell, J);
+                    Nbrs.Index(0, J) = JEdge;
+                    Nbrs.Index(1, J) = Fused.CellsOnEdge(JEdge, 0);
+                    Nbrs.Index(2, J) = Fused.CellsOnEdge(JEdge, 1);
+                    Nbrs.Coeff(0, J) = Fused.DivCoeffOnCell(ICell, J);
+                    Nbrs.Coeff(1, J) = Fused.LaplaceCoeffOnCell(ICell, J);
+                 });
+             Member.team_barrier();
+
+             Kokkos::parallel_for(
+                 Kokkos::TeamVectorRange(Member, NChunks), [&](int KChunk) {
+                    Fused.computeChunk<TermMask>(Tend, ICell, KChunk, In,
+                                                 Nbrs);
+                 });
+          });
+   }
+
+   /// Searches the term combinations from TermMask upward and launches the
+   /// kernel matching the enabled terms
+   template <I4 TermMask>
+   void dispatch(const Array3DReal &Tend, const Inputs &In, I4 NCells,
+                 const ExecSpace &Space) const {
+      if constexpr (TermMask < NCombinations) {
+         if (Terms == TermMask) {
+            launch<TermMask>(Tend, In, NCells, Space);
+         } else {
+            dispatch<TermMask + 1>(Tend, In, NCells, Space);
+         }
+      }
+   }
+
+ private:
+   I4 Terms = 0;
+   I4 NVertLevels;
+   KernelPolicyType Policy;
+   Real EddyDiff2 = 0;
+   Real EddyDiff4 = 0;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array2DI4 CellsOnEdge;
+   Array2DReal DivCoeffOnCell;
+   Array2DReal LaplaceCoeffOnCell;
+   Array1DReal MeshScalingDel2;
    Array1DReal MeshScalingDel4;
    Array2DReal EdgeMask;
+   Array1DI4 MinLevelCell;
+   Array1DI4 MaxLevelCell;
 };
 
 } // namespace OMEGA
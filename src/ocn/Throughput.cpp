@@ -0,0 +1,213 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- ocn/Throughput.cpp - model throughput benchmark ---------*- C++ -*-===//
+//
+// Implements the benchmark mode. The window of steps is timed with the wall
+// clock and the Timing statistics of the step, halo and IO regions are
+// differenced between the start and end of the window so that the warm-up
+// steps are excluded from the split as well as from the total.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Throughput.h"
+#include "Config.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Error.h"
+#include "Logging.h"
+#include "OmegaKokkos.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+namespace OMEGA {
+
+// create the static class members
+bool Throughput::Enabled           = false;
+I4 Throughput::WarmupSteps         = 0;
+std::string Throughput::OutputFile = "omega_throughput.json";
+bool Throughput::InWindow          = false;
+I8 Throughput::NSteps              = 0;
+R8 Throughput::SimTime             = 0;
+R8 Throughput::WallStart           = 0;
+R8 Throughput::WallEnd             = 0;
+Timing::RegionStats Throughput::StepStart;
+Timing::RegionStats Throughput::HaloStart;
+Timing::RegionStats Throughput::IOStart;
+
+//------------------------------------------------------------------------------
+// Read the benchmark options from the optional Benchmark group of the Omega
+// Config
+void Throughput::init() {
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   if (!OmegaConfig->existsGroup("Benchmark"))
+      return;
+
+   Config BenchConfig("Benchmark");
+   Error Err = OmegaConfig->get(BenchConfig);
+   CHECK_ERROR_ABORT(Err, "Throughput: error reading Benchmark group");
+
+   Err += BenchConfig.get("Enabled", Enabled);
+   Err += BenchConfig.get("WarmupSteps", WarmupSteps);
+   Err += BenchConfig.get("OutputFile", OutputFile);
+   CHECK_ERROR_ABORT(Err, "Throughput: Enabled, WarmupSteps or OutputFile "
+                          "not found in Benchmark Config");
+
+   if (Enabled and !Timing::isEnabled())
+      LOG_WARN("Throughput: Timing is disabled, the split of the benchmark "
+               "time into compute, halo and IO will be zero");
+
+} // end init
+
+//------------------------------------------------------------------------------
+// Check whether the benchmark mode is enabled
+bool Throughput::isEnabled() { return Enabled; }
+
+//------------------------------------------------------------------------------
+// Open the window at the first step after the warm-up steps. The device is
+// fenced so that work from the warm-up steps is not counted.
+void Throughput::startStep(I8 IStep) {
+
+   if (!Enabled or InWindow or IStep <= WarmupSteps)
+      return;
+
+   Kokkos::fence();
+   InWindow  = true;
+   WallStart = MPI_Wtime();
+   StepStart = Timing::getTotalStats("doStep");
+   HaloStart = Timing::getTotalStats("haloExchange");
+   IOStart   = Timing::getTotalStats("writeAll");
+
+} // end startStep
+
+//------------------------------------------------------------------------------
+// Close a step in the window
+void Throughput::endStep(const TimeInterval &StepInterval) {
+
+   if (!InWindow)
+      return;
+
+   R8 StepSeconds;
+   StepInterval.get(StepSeconds, TimeUnits::Seconds);
+
+   Kokkos::fence();
+   WallEnd = MPI_Wtime();
+   SimTime += StepSeconds;
+   ++NSteps;
+
+} // end endStep
+
+//------------------------------------------------------------------------------
+// Reduce the window times over tasks and write the throughput
+void Throughput::report(MPI_Comm Comm) {
+
+   if (!Enabled)
+      return;
+
+   I4 MyTask;
+   I4 NTasks;
+   MPI_Comm_rank(Comm, &MyTask);
+   MPI_Comm_size(Comm, &NTasks);
+
+   if (NSteps == 0) {
+      LOG_WARN("Throughput: no steps after the {} warm-up steps, no "
+               "benchmark results",
+               WarmupSteps);
+      return;
+   }
+
+   // Split of the window time on this task. Halo exchanges are all inside
+   // the step, so compute is the step time outside halo exchanges.
+   const R8 WallTime = WallEnd - WallStart;
+   const R8 StepTime = Timing::getTotalStats("doStep").Time - StepStart.Time;
+   const R8 HaloTime =
+       Timing::getTotalStats("haloExchange").Time - HaloStart.Time;
+   const R8 IOTime    = Timing::getTotalStats("writeAll").Time - IOStart.Time;
+   const R8 CompTime  = std::max(StepTime - HaloTime, 0.0);
+   const R8 OtherTime = std::max(WallTime - StepTime - IOTime, 0.0);
+
+   const I4 NSplit        = 5;
+   const R8 Local[NSplit] = {WallTime, CompTime, HaloTime, IOTime, OtherTime};
+   std::vector<R8> All(MyTask == 0 ? NSplit * NTasks : 0);
+   MPI_Gather(Local, NSplit, MPI_DOUBLE, All.data(), NSplit, MPI_DOUBLE, 0,
+              Comm);
+
+   if (MyTask != 0)
+      return;
+
+   // The slowest task sets the throughput
+   R8 MaxWall = 0;
+   for (int Task = 0; Task < NTasks; ++Task)
+      MaxWall = std::max(MaxWall, All[NSplit * Task]);
+
+   // Years are those of the calendar, or 365 days without a calendar year
+   R8 SecondsPerYear = Calendar::getSecondsPerYear();
+   if (SecondsPerYear <= 0)
+      SecondsPerYear = 365.0 * 86400.0;
+
+   const R8 SimYears       = SimTime / SecondsPerYear;
+   const R8 SYPD           = MaxWall > 0 ? SimYears / (MaxWall / 86400.0) : 0;
+   const R8 NCellsGlobal   = Decomp::getDefault()->NCellsGlobal;
+   const R8 NVertLevels    = Dimension::getDimLengthGlobal("NVertLevels");
+   const R8 PointsPerSec =
+       MaxWall > 0 ? NCellsGlobal * NVertLevels * NSteps / MaxWall : 0;
+
+   LOG_INFO("Throughput: {} steps after {} warm-up steps on {} tasks", NSteps,
+            WarmupSteps, NTasks);
+   LOG_INFO("Throughput: wall time {:.4f} s, simulated {:.6f} years", MaxWall,
+            SimYears);
+   LOG_INFO("Throughput: SYPD {:.4f}, cell-levels per second {:.5e}", SYPD,
+            PointsPerSec);
+
+   // Minimum, maximum and mean of each part of the split over tasks
+   const char *SplitNames[NSplit] = {"Wall", "Compute", "Halo", "IO", "Other"};
+   LOG_INFO("{:<10} {:>12} {:>12} {:>12}", "Time (s)", "Min", "Max", "Mean");
+   for (int ISplit = 0; ISplit < NSplit; ++ISplit) {
+      R8 Min = All[ISplit];
+      R8 Max = All[ISplit];
+      R8 Sum = 0;
+      for (int Task = 0; Task < NTasks; ++Task) {
+         const R8 Val = All[NSplit * Task + ISplit];
+         Min          = std::min(Min, Val);
+         Max          = std::max(Max, Val);
+         Sum += Val;
+      }
+      LOG_INFO("{:<10} {:>12.5e} {:>12.5e} {:>12.5e}", SplitNames[ISplit], Min,
+               Max, Sum / NTasks);
+   }
+
+   std::ofstream Json(OutputFile);
+   if (!Json) {
+      LOG_ERROR("Throughput: unable to open benchmark output file {}",
+                OutputFile);
+      return;
+   }
+   Json << "{\n";
+   Json << "  \"NTasks\": " << NTasks << ",\n";
+   Json << "  \"NCellsGlobal\": " << NCellsGlobal << ",\n";
+   Json << "  \"NVertLevels\": " << NVertLevels << ",\n";
+   Json << "  \"WarmupSteps\": " << WarmupSteps << ",\n";
+   Json << "  \"NSteps\": " << NSteps << ",\n";
+   Json << "  \"WallTime\": " << MaxWall << ",\n";
+   Json << "  \"SimulatedYears\": " << SimYears << ",\n";
+   Json << "  \"SYPD\": " << SYPD << ",\n";
+   Json << "  \"CellLevelsPerSec\": " << PointsPerSec << ",\n";
+   Json << "  \"Tasks\": [\n";
+   for (int Task = 0; Task < NTasks; ++Task) {
+      const R8 *Split = &All[NSplit * Task];
+      Json << "    {\"Task\": " << Task << ", \"Wall\": " << Split[0]
+           << ", \"Compute\": " << Split[1] << ", \"Halo\": " << Split[2]
+           << ", \"IO\": " << Split[3] << ", \"Other\": " << Split[4] << "}"
+           << (Task < NTasks - 1 ? ",\n" : "\n");
+   }
+   Json << "  ]\n}\n";
+
+} // end report
+
+} // namespace OMEGA
+//===----------------------------------------------------------------------===//
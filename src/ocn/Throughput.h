@@ -0,0 +1,77 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_THROUGHPUT_H
+#define OMEGA_THROUGHPUT_H
+//===-- ocn/Throughput.h - model throughput benchmark -----------*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the benchmark mode that measures model throughput
+///
+/// When the benchmark mode is enabled in the Benchmark group of the Omega
+/// Config, the Throughput class times a window of time steps of ocnRun that
+/// starts after a number of warm-up steps and ends at the last step. At
+/// finalize it reports the simulated years per day (SYPD), the number of
+/// cells times levels updated per second and, on each task, the split of
+/// the window time into compute, halo exchange, IO and other time. The split
+/// is taken from the Timing regions doStep, haloExchange and writeAll, so it
+/// requires Timing to be enabled. The results are written to the log and,
+/// by the master task, as JSON to a file.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "TimeMgr.h"
+#include "Timing.h"
+#include "mpi.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Throughput measurement over a window of time steps
+class Throughput {
+ public:
+   /// Reads the options from the optional Benchmark group of the Omega
+   /// Config. The benchmark mode is disabled if the group is absent.
+   static void init();
+
+   /// Returns true if the benchmark mode is enabled
+   static bool isEnabled();
+
+   /// Marks the start of a time step, opening the window after the warm-up
+   /// steps
+   static void startStep(I8 IStep ///< [in] step count, starting from 1
+   );
+
+   /// Marks the end of a time step in the window and adds the simulated
+   /// time of the step
+   static void endStep(const TimeInterval &StepInterval ///< [in] step length
+   );
+
+   /// Writes the throughput of the window to the log and the output file.
+   /// Must be called by all tasks.
+   static void report(MPI_Comm Comm ///< [in] communicator of tasks
+   );
+
+ private:
+   static bool Enabled;           ///< benchmark mode is on
+   static I4 WarmupSteps;         ///< steps excluded before the window
+   static std::string OutputFile; ///< name of the JSON output file
+
+   static bool InWindow; ///< the current step is in the window
+   static I8 NSteps;     ///< number of steps completed in the window
+   static R8 SimTime;    ///< simulated seconds in the window
+   static R8 WallStart;  ///< wall time at the start of the window
+   static R8 WallEnd;    ///< wall time at the end of the last step
+
+   /// Timing statistics of the regions at the start of the window
+   static Timing::RegionStats StepStart;
+   static Timing::RegionStats HaloStart;
+   static Timing::RegionStats IOStart;
+};
+
+} // namespace OMEGA
+#endif
@@ -0,0 +1,89 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- ocn/TracerLayout.cpp - memory layout of tracer arrays ---*- C++ -*-===//
+//
+// Sets the strides of each tracer array layout and copies tracers between
+// the canonical layout and the other layouts.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TracerLayout.h"
+#include "OmegaKokkos.h"
+#include "Timing.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Allocate the data and set the strides of the layout
+TracerArray::TracerArray(const std::string &Label, I4 InNTracers,
+                         I4 InNCells, I4 InNVertLevels,
+                         TracerLayoutType InLayout)
+    : NTracers(InNTracers), NCells(InNCells), NVertLevels(InNVertLevels),
+      Layout(InLayout) {
+
+   const I8 NChunks = (NVertLevels + VecLength - 1) / VecLength;
+   I8 Size          = I8(NTracers) * NCells * NVertLevels;
+
+   switch (Layout) {
+   case TracerLayoutType::TracerOuter:
+      StrideTracer = I8(NCells) * NVertLevels;
+      StrideCell   = NVertLevels;
+      StrideChunk  = VecLength;
+      StrideLevel  = 1;
+      break;
+   case TracerLayoutType::TracerInner:
+      StrideTracer = 1;
+      StrideCell   = I8(NVertLevels) * NTracers;
+      StrideChunk  = I8(VecLength) * NTracers;
+      StrideLevel  = NTracers;
+      break;
+   case TracerLayoutType::Blocked:
+      StrideTracer = VecLength;
+      StrideCell   = NChunks * NTracers * VecLength;
+      StrideChunk  = I8(NTracers) * VecLength;
+      StrideLevel  = 1;
+      Size         = NCells * StrideCell;
+      break;
+   }
+
+   Data = Array1DReal(Label, Size);
+}
+
+//------------------------------------------------------------------------------
+// Copy a canonical array into this array
+void TracerArray::copyFrom(const Array3DReal &Src) const {
+
+   const TracerArray Dst = *this;
+
+   const R8 Bytes = 2.0 * NTracers * NCells * NVertLevels * sizeof(Real);
+   TimingRegion Region("tracerLayoutCopyFrom", Bytes);
+
+   parallelFor(
+       "tracerLayoutCopyFrom", {NCells, NVertLevels, NTracers},
+       KOKKOS_LAMBDA(int ICell, int K, int L) {
+          Dst(L, ICell, K) = Src(L, ICell, K);
+       });
+}
+
+//------------------------------------------------------------------------------
+// Copy this array into a canonical array
+void TracerArray::copyTo(const Array3DReal &Dst) const {
+
+   const TracerArray Src = *this;
+
+   const R8 Bytes = 2.0 * NTracers * NCells * NVertLevels * sizeof(Real);
+   TimingRegion Region("tracerLayoutCopyTo", Bytes);
+
+   parallelFor(
+       "tracerLayoutCopyTo", {NCells, NVertLevels, NTracers},
+       KOKKOS_LAMBDA(int ICell, int K, int L) {
+          Dst(L, ICell, K) = Src(L, ICell, K);
+       });
+}
+
+} // namespace OMEGA
+
+//===----------------------------------------------------------------------===//
@@ -0,0 +1,155 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_TRACERLAYOUT_H
+#define OMEGA_TRACERLAYOUT_H
+//===-- ocn/TracerLayout.h - memory layout of tracer arrays -----*- C++ -*-===//
+//
+/// \file
+/// \brief Defines tracer arrays with a selectable memory layout
+///
+/// Tracer arrays are indexed (L, ICell, K) with the tracer index L first. The
+/// canonical Array3DReal storage keeps each tracer in a separate block, so a
+/// kernel that visits all tracers of a cell makes one pass through memory
+/// per tracer. The TracerArray class keeps the same indexing but can store
+/// the values in one of three layouts:
+///  - TracerOuter: (L, ICell, K), the canonical layout
+///  - TracerInner: (ICell, K, L), all tracers of a level are adjacent
+///  - Blocked: (ICell, KChunk, L, KVec), blocks of VecLength levels of each
+///    tracer are adjacent, so the tracers of a cell are read in one stream
+///    while each chunk of levels stays contiguous for the vector lanes
+///
+/// The kernels that take the tracer array as a template argument work with
+/// either the canonical arrays or a TracerArray. Halo exchanges and IO work
+/// on the canonical layout, using copyFrom and copyTo to stage the values.
+/// The model state and time steppers keep the canonical arrays, so the layout
+/// is chosen by the code that creates a TracerArray rather than by a Config
+/// option.
+//
+//===----------------------------------------------------------------------===//
+
+#include "DataTypes.h"
+#include "MachEnv.h"
+#include "OmegaSimd.h"
+
+#include <string>
+
+namespace OMEGA {
+
+/// Memory layouts of a tracer array
+enum class TracerLayoutType {
+   TracerOuter, ///< (L, ICell, K)
+   TracerInner, ///< (ICell, K, L)
+   Blocked      ///< (ICell, KChunk, L, KVec)
+};
+
+/// Tracer array indexed (L, ICell, K) with a selectable memory layout. The
+/// class is a light handle to the data like a Kokkos View and is captured by
+/// value in kernels.
+class TracerArray {
+ public:
+   /// Default constructor for an empty array
+   TracerArray() = default;
+
+   /// Allocates an array in the given layout. For the Blocked layout the
+   /// levels are padded to a multiple of VecLength.
+   TracerArray(const std::string &Label, ///< [in] label of the data
+               I4 NTracers,              ///< [in] number of tracers
+               I4 NCells,                ///< [in] number of cells
+               I4 NVertLevels,           ///< [in] number of vertical levels
+               TracerLayoutType Layout   ///< [in] memory layout
+   );
+
+   /// Returns a reference to the value of tracer L at cell ICell, level K
+   KOKKOS_INLINE_FUNCTION Real &operator()(I4 L, I4 ICell, I4 K) const {
+      return Data(offset(L, ICell, K));
+   }
+
+   /// Returns the offset of tracer L at cell ICell, level K in the data
+   KOKKOS_INLINE_FUNCTION I8 offset(I4 L, I4 ICell, I4 K) const {
+      return L * StrideTracer + ICell * StrideCell +
+             (K / VecLength) * StrideChunk + (K % VecLength) * StrideLevel;
+   }
+
+   /// Returns the extent of dimension Dim as for a Kokkos View
+   KOKKOS_INLINE_FUNCTION size_t extent(int Dim) const {
+      return Dim == 0 ? NTracers : (Dim == 1 ? NCells : NVertLevels);
+   }
+
+   /// Returns the extent of dimension Dim as an int
+   KOKKOS_INLINE_FUNCTION int extent_int(int Dim) const {
+      return static_cast<int>(extent(Dim));
+   }
+
+   /// Returns true if the levels of a chunk are contiguous in memory
+   KOKKOS_INLINE_FUNCTION bool contiguousChunks() const {
+      return StrideLevel == 1;
+   }
+
+   /// Returns the memory layout
+   TracerLayoutType getLayout() const { return Layout; }
+
+   /// Returns the underlying data, for example to size a buffer
+   const Array1DReal &getData() const { return Data; }
+
+   /// Copies a canonical array into this array
+   void copyFrom(const Array3DReal &Src ///< [in] canonical tracers
+   ) const;
+
+   /// Copies this array into a canonical array
+   void copyTo(const Array3DReal &Dst ///< [out] canonical tracers
+   ) const;
+
+ private:
+   Array1DReal Data; ///< Values in the chosen layout
+
+   I4 NTracers    = 0; ///< Number of tracers
+   I4 NCells      = 0; ///< Number of cells
+   I4 NVertLevels = 0; ///< Number of vertical levels
+
+   // Strides of each index. The level index K is split into the chunk
+   // K / VecLength and the level K % VecLength within the chunk.
+   I8 StrideTracer = 0; ///< Stride of the tracer index
+   I8 StrideCell   = 0; ///< Stride of the cell index
+   I8 StrideChunk  = 0; ///< Stride of the vertical chunk
+   I8 StrideLevel  = 0; ///< Stride of the level within a chunk
+
+   TracerLayoutType Layout = TracerLayoutType::TracerOuter;
+};
+
+#ifdef OMEGA_SIMD
+
+/// Loads levels KStart to KStart + VecLength - 1 of tracer L at cell I. The
+/// levels are gathered one by one if they are not contiguous.
+KOKKOS_INLINE_FUNCTION SimdReal loadChunk(const TracerArray &Arr, I4 L, I4 I,
+                                          I4 KStart) {
+   SimdReal Chunk;
+   if (Arr.contiguousChunks()) {
+      Chunk.copy_from(&Arr(L, I, KStart),
+                      Kokkos::Experimental::element_aligned_tag());
+   } else {
+      Chunk = SimdReal(
+          [&](std::size_t KVec) { return Arr(L, I, KStart + KVec); });
+   }
+   return Chunk;
+}
+
+/// Stores a chunk to levels KStart to KStart + VecLength - 1 of tracer L at
+/// cell I
+KOKKOS_INLINE_FUNCTION void storeChunk(const TracerArray &Arr, I4 L, I4 I,
+                                       I4 KStart, const SimdReal &Chunk) {
+   if (Arr.contiguousChunks()) {
+      Chunk.copy_to(&Arr(L, I, KStart),
+                    Kokkos::Experimental::element_aligned_tag());
+   } else {
+      for (int KVec = 0; KVec < VecLength; ++KVec)
+         Arr(L, I, KStart + KVec) = Chunk[KVec];
+   }
+}
+
+#endif
+
+} // namespace OMEGA
+#endif
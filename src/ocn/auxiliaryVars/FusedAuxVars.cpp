@@ -0,0 +1,77 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#include "FusedAuxVars.h"
+#include "DataTypes.h"
+#include "Timing.h"
+
+namespace OMEGA {
+
+FusedAuxVars::FusedAuxVars(const HorzMesh *Mesh)
+    : FluxThickEdgeChoice(FluxThickEdgeOption::Center), ComputeDel2(true),
+      NCellsAll(Mesh->NCellsAll), NVerticesAll(Mesh->NVerticesAll),
+      NEdgesAll(Mesh->NEdgesAll), VertexDegree(Mesh->VertexDegree),
+      NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
+      EdgesOnVertex(Mesh->EdgesOnVertex), CellsOnVertex(Mesh->CellsOnVertex),
+      CellsOnEdge(Mesh->CellsOnEdge), VerticesOnEdge(Mesh->VerticesOnEdge),
+      FVertex(Mesh->FVertex), EdgeMask(Mesh->EdgeMask),
+      DivCoeffOnCell(StencilCoeffs::get(Mesh)->DivCoeffOnCell),
+      KineticCoeffOnCell(StencilCoeffs::get(Mesh)->KineticCoeffOnCell),
+      CurlCoeffOnVertex(StencilCoeffs::get(Mesh)->CurlCoeffOnVertex),
+      KiteCoeffOnVertex(StencilCoeffs::get(Mesh)->KiteCoeffOnVertex),
+      GradCoeffOnEdge(StencilCoeffs::get(Mesh)->GradCoeffOnEdge),
+      TangentGradCoeffOnEdge(
+          StencilCoeffs::get(Mesh)->TangentGradCoeffOnEdge) {}
+
+// The kernels are launched in dependency order: the cell and vertex
+// variables of the velocity, then the edge variables that average or
+// differentiate them, then the Laplacians of the edge Laplacian
+void FusedAuxVars::compute(const Outputs &Out,
+                           const Array2DReal &NormalVelEdge,
+                           const Array2DReal &LayerThickCell,
+                           I4 NVertLevels) const {
+
+   const auto LocFused = *this;
+   const I4 NChunks    = NVertLevels / VecLength;
+
+   TimingRegion Region("fusedAuxVars");
+
+   parallelFor(
+       "fusedAuxVarsOnCell", {NCellsAll, NChunks},
+       KOKKOS_LAMBDA(int ICell, int KChunk) {
+          LocFused.computeVarsOnCell(Out, ICell, KChunk, NormalVelEdge);
+       });
+
+   parallelFor(
+       "fusedAuxVarsOnVertex", {NVerticesAll, NChunks},
+       KOKKOS_LAMBDA(int IVertex, int KChunk) {
+          LocFused.computeVarsOnVertex(Out, IVertex, KChunk, NormalVelEdge,
+                                       LayerThickCell);
+       });
+
+   parallelFor(
+       "fusedAuxVarsOnEdge", {NEdgesAll, NChunks},
+       KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          LocFused.computeVarsOnEdge(Out, IEdge, KChunk, NormalVelEdge,
+                                     LayerThickCell);
+       });
+
+   if (!ComputeDel2)
+      return;
+
+   parallelFor(
+       "fusedAuxDel2OnCell", {NCellsAll, NChunks},
+       KOKKOS_LAMBDA(int ICell, int KChunk) {
+          LocFused.computeDel2OnCell(Out, ICell, KChunk);
+       });
+
+   parallelFor(
+       "fusedAuxDel2OnVertex", {NVerticesAll, NChunks},
+       KOKKOS_LAMBDA(int IVertex, int KChunk) {
+          LocFused.computeDel2OnVertex(Out, IVertex, KChunk);
+       });
+}
+
+} // namespace OMEGA
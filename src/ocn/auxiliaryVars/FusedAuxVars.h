@@ -0,0 +1,338 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_AUX_FUSED_H
+#define OMEGA_AUX_FUSED_H
+
+#include "DataTypes.h"
+#include "HorzMesh.h"
+#include "LayerThicknessAuxVars.h"
+#include "OmegaKokkos.h"
+#include "OmegaSimd.h"
+#include "StencilCoeffs.h"
+
+namespace OMEGA {
+
+/// Computes the kinetic, layer thickness, vorticity and velocity Laplacian
+/// auxiliary variables with one traversal of the stencil for each entity and
+/// dependency level, instead of one kernel per variable group. The cell and
+/// vertex kernels of the first level share the loads of the normal velocity
+/// of each edge, the edge kernel loads the cell and vertex neighbors of an
+/// edge once for all edge quantities, and the vertex layer thickness is kept
+/// in registers. The Laplacians of the divergence and vorticity depend on the
+/// edge Laplacian, so they are computed in a last cell and vertex pass.
+class FusedAuxVars {
+ public:
+   /// Output arrays, normally the arrays of the auxiliary variable groups.
+   /// The Laplacian arrays are only accessed if ComputeDel2 is set.
+   struct Outputs {
+      Array2DReal KineticEnergyCell;    ///< kinetic energy at cells
+      Array2DReal VelocityDivCell;      ///< velocity divergence at cells
+      Array2DReal RelVortVertex;        ///< relative vorticity at vertices
+      Array2DReal NormRelVortVertex;    ///< normalized relative vorticity
+      Array2DReal NormPlanetVortVertex; ///< normalized planetary vorticity
+      Array2DReal NormRelVortEdge;      ///< normalized rel vorticity on edges
+      Array2DReal NormPlanetVortEdge;   ///< normalized planetary vorticity
+      Array2DReal FluxLayerThickEdge;   ///< layer thickness for fluxes
+      Array2DReal MeanLayerThickEdge;   ///< mean layer thickness on edges
+      Array2DReal Del2Edge;             ///< Laplacian of normal velocity
+      Array2DReal Del2DivCell;          ///< Laplacian of divergence
+      Array2DReal Del2RelVortVertex;    ///< Laplacian of relative vorticity
+   };
+
+   FluxThickEdgeOption FluxThickEdgeChoice; ///< flux thickness option
+   bool ComputeDel2;                        ///< compute the Laplacians
+
+   /// constructor declaration
+   FusedAuxVars(const HorzMesh *Mesh);
+
+   /// Computes all variables for the owned and halo entities
+   void compute(const Outputs &Out,                ///< [out] aux variables
+                const Array2DReal &NormalVelEdge,  ///< [in] normal velocity
+                const Array2DReal &LayerThickCell, ///< [in] layer thickness
+                I4 NVertLevels                     ///< [in] vertical levels
+   ) const;
+
+   /// Kinetic energy and velocity divergence of a cell and vertical chunk
+   KOKKOS_FUNCTION void
+   computeVarsOnCell(const Outputs &Out, I4 ICell, I4 KChunk,
+                     const Array2DReal &NormalVelEdge) const {
+      const I4 KStart = KChunk * VecLength;
+
+#ifdef OMEGA_SIMD
+      SimdReal KETmp(0._Real);
+      SimdReal DivTmp(0._Real);
+
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real KECoeff  = KineticCoeffOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
+         const SimdReal Vel  = loadChunk(NormalVelEdge, JEdge, KStart);
+         KETmp               = KETmp + KECoeff * Vel * Vel;
+         DivTmp              = DivTmp - DivCoeff * Vel;
+      }
+
+      storeChunk(Out.KineticEnergyCell, ICell, KStart, KETmp);
+      storeChunk(Out.VelocityDivCell, ICell, KStart, DivTmp);
+#else
+      Real KETmp[VecLength]  = {0};
+      Real DivTmp[VecLength] = {0};
+
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real KECoeff  = KineticCoeffOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const I4 K     = KStart + KVec;
+            const Real Vel = NormalVelEdge(JEdge, K);
+            KETmp[KVec] += KECoeff * Vel * Vel;
+            DivTmp[KVec] -= DivCoeff * Vel;
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K                      = KStart + KVec;
+         Out.KineticEnergyCell(ICell, K) = KETmp[KVec];
+         Out.VelocityDivCell(ICell, K)   = DivTmp[KVec];
+      }
+#endif
+   }
+
+   /// Relative vorticity, vertex layer thickness and normalized vorticities
+   /// of a vertex and vertical chunk
+   KOKKOS_FUNCTION void
+   computeVarsOnVertex(const Outputs &Out, I4 IVertex, I4 KChunk,
+                       const Array2DReal &NormalVelEdge,
+                       const Array2DReal &LayerThickCell) const {
+      const I4 KStart = KChunk * VecLength;
+
+#ifdef OMEGA_SIMD
+      SimdReal VortTmp(0._Real);
+      SimdReal ThickTmp(0._Real);
+
+      for (int J = 0; J < VertexDegree; ++J) {
+         const I4 JEdge       = EdgesOnVertex(IVertex, J);
+         const I4 JCell       = CellsOnVertex(IVertex, J);
+         const Real CurlCoeff = CurlCoeffOnVertex(IVertex, J);
+         const Real KiteCoeff = KiteCoeffOnVertex(IVertex, J);
+         VortTmp =
+             VortTmp + CurlCoeff * loadChunk(NormalVelEdge, JEdge, KStart);
+         ThickTmp =
+             ThickTmp + KiteCoeff * loadChunk(LayerThickCell, JCell, KStart);
+      }
+
+      const SimdReal InvThick = 1._Real / ThickTmp;
+      storeChunk(Out.RelVortVertex, IVertex, KStart, VortTmp);
+      storeChunk(Out.NormRelVortVertex, IVertex, KStart, VortTmp * InvThick);
+      storeChunk(Out.NormPlanetVortVertex, IVertex, KStart,
+                 FVertex(IVertex) * InvThick);
+#else
+      Real VortTmp[VecLength]  = {0};
+      Real ThickTmp[VecLength] = {0};
+
+      for (int J = 0; J < VertexDegree; ++J) {
+         const I4 JEdge       = EdgesOnVertex(IVertex, J);
+         const I4 JCell       = CellsOnVertex(IVertex, J);
+         const Real CurlCoeff = CurlCoeffOnVertex(IVertex, J);
+         const Real KiteCoeff = KiteCoeffOnVertex(IVertex, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const I4 K = KStart + KVec;
+            VortTmp[KVec] += CurlCoeff * NormalVelEdge(JEdge, K);
+            ThickTmp[KVec] += KiteCoeff * LayerThickCell(JCell, K);
+         }
+      }
+
+      const Real FVert = FVertex(IVertex);
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K                           = KStart + KVec;
+         const Real InvThick                  = 1._Real / ThickTmp[KVec];
+         Out.RelVortVertex(IVertex, K)        = VortTmp[KVec];
+         Out.NormRelVortVertex(IVertex, K)    = VortTmp[KVec] * InvThick;
+         Out.NormPlanetVortVertex(IVertex, K) = FVert * InvThick;
+      }
+#endif
+   }
+
+   /// Layer thicknesses, normalized vorticities and velocity Laplacian of an
+   /// edge and vertical chunk, from the cell and vertex variables
+   KOKKOS_FUNCTION void
+   computeVarsOnEdge(const Outputs &Out, I4 IEdge, I4 KChunk,
+                     const Array2DReal &NormalVelEdge,
+                     const Array2DReal &LayerThickCell) const {
+      const I4 KStart = KChunk * VecLength;
+
+      const I4 JCell0   = CellsOnEdge(IEdge, 0);
+      const I4 JCell1   = CellsOnEdge(IEdge, 1);
+      const I4 JVertex0 = VerticesOnEdge(IEdge, 0);
+      const I4 JVertex1 = VerticesOnEdge(IEdge, 1);
+
+#ifdef OMEGA_SIMD
+      using Kokkos::Experimental::where;
+
+      const SimdReal Thick0    = loadChunk(LayerThickCell, JCell0, KStart);
+      const SimdReal Thick1    = loadChunk(LayerThickCell, JCell1, KStart);
+      const SimdReal MeanThick = 0.5_Real * (Thick0 + Thick1);
+      storeChunk(Out.MeanLayerThickEdge, IEdge, KStart, MeanThick);
+
+      SimdReal FluxThick = MeanThick;
+      if (FluxThickEdgeChoice == FluxThickEdgeOption::Upwind) {
+         const SimdReal Vel = loadChunk(NormalVelEdge, IEdge, KStart);
+         FluxThick          = Kokkos::max(Thick0, Thick1);
+         where(Vel > 0._Real, FluxThick) = Thick0;
+         where(Vel < 0._Real, FluxThick) = Thick1;
+      }
+      storeChunk(Out.FluxLayerThickEdge, IEdge, KStart, FluxThick);
+
+      storeChunk(Out.NormRelVortEdge, IEdge, KStart,
+                 0.5_Real *
+                     (loadChunk(Out.NormRelVortVertex, JVertex0, KStart) +
+                      loadChunk(Out.NormRelVortVertex, JVertex1, KStart)));
+      storeChunk(Out.NormPlanetVortEdge, IEdge, KStart,
+                 0.5_Real *
+                     (loadChunk(Out.NormPlanetVortVertex, JVertex0, KStart) +
+                      loadChunk(Out.NormPlanetVortVertex, JVertex1, KStart)));
+#else
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K        = KStart + KVec;
+         const Real Thick0 = LayerThickCell(JCell0, K);
+         const Real Thick1 = LayerThickCell(JCell1, K);
+
+         const Real MeanThick             = 0.5_Real * (Thick0 + Thick1);
+         Out.MeanLayerThickEdge(IEdge, K) = MeanThick;
+
+         Real FluxThick = MeanThick;
+         if (FluxThickEdgeChoice == FluxThickEdgeOption::Upwind) {
+            const Real Vel = NormalVelEdge(IEdge, K);
+            if (Vel > 0) {
+               FluxThick = Thick0;
+            } else if (Vel < 0) {
+               FluxThick = Thick1;
+            } else {
+               FluxThick = Kokkos::max(Thick0, Thick1);
+            }
+         }
+         Out.FluxLayerThickEdge(IEdge, K) = FluxThick;
+
+         Out.NormRelVortEdge(IEdge, K)    =
+             0.5_Real * (Out.NormRelVortVertex(JVertex0, K) +
+                         Out.NormRelVortVertex(JVertex1, K));
+         Out.NormPlanetVortEdge(IEdge, K) =
+             0.5_Real * (Out.NormPlanetVortVertex(JVertex0, K) +
+                         Out.NormPlanetVortVertex(JVertex1, K));
+      }
+#endif
+
+      if (!ComputeDel2)
+         return;
+
+      const Real DcEdgeInv = GradCoeffOnEdge(IEdge);
+      const Real DvEdgeInv = TangentGradCoeffOnEdge(IEdge);
+#ifdef OMEGA_SIMD
+      const SimdReal DivGrad = loadChunk(Out.VelocityDivCell, JCell1, KStart) -
+                               loadChunk(Out.VelocityDivCell, JCell0, KStart);
+      const SimdReal VortGrad =
+          loadChunk(Out.RelVortVertex, JVertex1, KStart) -
+          loadChunk(Out.RelVortVertex, JVertex0, KStart);
+      storeChunk(Out.Del2Edge, IEdge, KStart,
+                 loadChunk(EdgeMask, IEdge, KStart) *
+                     (DivGrad * DcEdgeInv - VortGrad * DvEdgeInv));
+#else
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K = KStart + KVec;
+         const Real Del2U =
+             (Out.VelocityDivCell(JCell1, K) - Out.VelocityDivCell(JCell0, K)) *
+                 DcEdgeInv -
+             (Out.RelVortVertex(JVertex1, K) - Out.RelVortVertex(JVertex0, K)) *
+                 DvEdgeInv;
+         Out.Del2Edge(IEdge, K) = EdgeMask(IEdge, K) * Del2U;
+      }
+#endif
+   }
+
+   /// Laplacian of the divergence of a cell and vertical chunk
+   KOKKOS_FUNCTION void computeDel2OnCell(const Outputs &Out, I4 ICell,
+                                          I4 KChunk) const {
+      const I4 KStart = KChunk * VecLength;
+
+#ifdef OMEGA_SIMD
+      SimdReal DivTmp(0._Real);
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
+         DivTmp = DivTmp - DivCoeff * loadChunk(Out.Del2Edge, JEdge, KStart);
+      }
+      storeChunk(Out.Del2DivCell, ICell, KStart, DivTmp);
+#else
+      Real DivTmp[VecLength] = {0};
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const I4 JEdge      = EdgesOnCell(ICell, J);
+         const Real DivCoeff = DivCoeffOnCell(ICell, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const I4 K = KStart + KVec;
+            DivTmp[KVec] -= DivCoeff * Out.Del2Edge(JEdge, K);
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K                = KStart + KVec;
+         Out.Del2DivCell(ICell, K) = DivTmp[KVec];
+      }
+#endif
+   }
+
+   /// Laplacian of the relative vorticity of a vertex and vertical chunk
+   KOKKOS_FUNCTION void computeDel2OnVertex(const Outputs &Out, I4 IVertex,
+                                            I4 KChunk) const {
+      const I4 KStart = KChunk * VecLength;
+
+#ifdef OMEGA_SIMD
+      SimdReal VortTmp(0._Real);
+      for (int J = 0; J < VertexDegree; ++J) {
+         const I4 JEdge       = EdgesOnVertex(IVertex, J);
+         const Real CurlCoeff = CurlCoeffOnVertex(IVertex, J);
+         VortTmp = VortTmp + CurlCoeff * loadChunk(Out.Del2Edge, JEdge, KStart);
+      }
+      storeChunk(Out.Del2RelVortVertex, IVertex, KStart, VortTmp);
+#else
+      Real VortTmp[VecLength] = {0};
+      for (int J = 0; J < VertexDegree; ++J) {
+         const I4 JEdge       = EdgesOnVertex(IVertex, J);
+         const Real CurlCoeff = CurlCoeffOnVertex(IVertex, J);
+         for (int KVec = 0; KVec < VecLength; ++KVec) {
+            const I4 K = KStart + KVec;
+            VortTmp[KVec] += CurlCoeff * Out.Del2Edge(JEdge, K);
+         }
+      }
+
+      for (int KVec = 0; KVec < VecLength; ++KVec) {
+         const I4 K                        = KStart + KVec;
+         Out.Del2RelVortVertex(IVertex, K) = VortTmp[KVec];
+      }
+#endif
+   }
+
+ private:
+   I4 NCellsAll;
+   I4 NVerticesAll;
+   I4 NEdgesAll;
+   I4 VertexDegree;
+   Array1DI4 NEdgesOnCell;
+   Array2DI4 EdgesOnCell;
+   Array2DI4 EdgesOnVertex;
+   Array2DI4 CellsOnVertex;
+   Array2DI4 CellsOnEdge;
+   Array2DI4 VerticesOnEdge;
+   Array1DReal FVertex;
+   Array2DReal EdgeMask;
+   Array2DReal DivCoeffOnCell;
+   Array2DReal KineticCoeffOnCell;
+   Array2DReal CurlCoeffOnVertex;
+   Array2DReal KiteCoeffOnVertex;
+   Array1DReal GradCoeffOnEdge;
+   Array1DReal TangentGradCoeffOnEdge;
+};
+
+} // namespace OMEGA
+#endif
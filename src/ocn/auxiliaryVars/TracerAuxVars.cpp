@@ -18,8 +18,8 @@ TracerAuxVars::TracerAuxVars(const std::string &AuxStateSuffix,
       Del2TracersCell("Del2TracerCell" + AuxStateSuffix, NTracers,
                       Mesh->NCellsSize, NVertLevels),
       NEdgesOnCell(Mesh->NEdgesOnCell), EdgesOnCell(Mesh->EdgesOnCell),
-      CellsOnEdge(Mesh->CellsOnEdge), EdgeSignOnCell(Mesh->EdgeSignOnCell),
-      DcEdge(Mesh->DcEdge), DvEdge(Mesh->DvEdge), AreaCell(Mesh->AreaCell),
+      CellsOnEdge(Mesh->CellsOnEdge),
+      LaplaceCoeffOnCell(StencilCoeffs::get(Mesh)->LaplaceCoeffOnCell),
       EdgeMask(Mesh->EdgeMask) {}
 
 void TracerAuxVars::registerFields(const std::string &AuxGroupName,
@@ -28,8 +28,10 @@ void TracerAuxVars::registerFields(const std::string &AuxGroupName,
    int Err = 0; // error code
 
    // Create fields
-   const Real FillValue = -9.99e30;
-   int NDims            = 3;
+   const TracerAuxReal FillValue = -9.99e30;
+   const TracerAuxReal MinValue  = std::numeric_limits<TracerAuxReal>::min();
+   const TracerAuxReal MaxValue  = std::numeric_limits<TracerAuxReal>::max();
+   int NDims                     = 3;
    std::vector<std::string> DimNames(NDims);
    std::string DimSuffix;
    if (MeshName == "Default") {
@@ -49,7 +51,7 @@ void TracerAuxVars::registerFields(const std::string &AuxGroupName,
        "",                               // units
        "",                               // CF standard name
        0,                                // min valid value
-       std::numeric_limits<Real>::max(), // max valid value
+       MaxValue,                         // max valid value
        FillValue,                        // scalar for undefined entries
        NDims,                            // number of dimensions
        DimNames                          // dimension names
@@ -63,8 +65,8 @@ void TracerAuxVars::registerFields(const std::string &AuxGroupName,
                                                                  // description
        "",                                                       // units
        "",                               // CF standard name
-       std::numeric_limits<Real>::min(), // min valid value
-       std::numeric_limits<Real>::max(), // max valid value
+       MinValue,                         // min valid value
+       MaxValue,                         // max valid value
        FillValue,                        // scalar for undefined entries
        NDims,                            // number of dimensions
        DimNames                          // dimension names
@@ -82,11 +84,11 @@ void TracerAuxVars::registerFields(const std::string &AuxGroupName,
                 AuxGroupName);
 
    // Attach data to fields
-   Err = HTracersEdgeField->attachData<Array3DReal>(HTracersEdge);
+   Err = HTracersEdgeField->attachData<Array3DTracerAux>(HTracersEdge);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", HTracersEdge.label());
 
-   Err = Del2TracersCellField->attachData<Array3DReal>(Del2TracersCell);
+   Err = Del2TracersCellField->attachData<Array3DTracerAux>(Del2TracersCell);
    if (Err != 0)
       LOG_ERROR("Error attaching data to field {}", Del2TracersCell.label());
 }
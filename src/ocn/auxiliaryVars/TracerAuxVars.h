@@ -10,6 +10,8 @@
 #include "Field.h"
 #include "HorzMesh.h"
 #include "OmegaKokkos.h"
+#include "OmegaSimd.h"
+#include "StencilCoeffs.h"
 
 #include <string>
 
@@ -17,24 +19,64 @@ namespace OMEGA {
 
 enum class FluxTracerEdgeOption { Center, Upwind };
 
+// Storage type for the tracer auxiliary arrays. In a build with
+// OMEGA_MIXED_PRECISION these arrays are stored in single precision to halve
+// their memory footprint and bandwidth, while all arithmetic, including the
+// stencil accumulations that read them, is still done in Real.
+#ifdef OMEGA_MIXED_PRECISION
+using TracerAuxReal    = R4;
+using Array3DTracerAux = Array3DR4;
+#else
+using TracerAuxReal    = Real;
+using Array3DTracerAux = Array3DReal;
+#endif
+
 class TracerAuxVars {
  public:
-   Array3DReal HTracersEdge;
-   Array3DReal Del2TracersCell;
+   Array3DTracerAux HTracersEdge;
+   Array3DTracerAux Del2TracersCell;
 
    FluxTracerEdgeOption TracersOnEdgeChoice;
 
    TracerAuxVars(const std::string &AuxStateSuffix, const HorzMesh *Mesh,
                  const I4 NVertLevels, const I4 NTracers);
 
+   // The tracer arrays are template arguments so they can be either the
+   // canonical Array3DReal or a TracerArray in another layout. With
+   // OMEGA_SIMD the tracer and tracer aux rows are moved with gatherChunk and
+   // scatterChunk since their layout and precision may differ from Real.
+   template <class TracerArrayType>
    KOKKOS_FUNCTION void computeVarsOnEdge(int L, int IEdge, int KChunk,
                                           const Array2DReal &NormalVelEdge,
                                           const Array2DReal &HCell,
-                                          const Array3DReal &TrCell) const {
+                                          const TracerArrayType &TrCell) const {
       const int KStart = KChunk * VecLength;
       const int JCell0 = CellsOnEdge(IEdge, 0);
       const int JCell1 = CellsOnEdge(IEdge, 1);
 
+#ifdef OMEGA_SIMD
+      using Kokkos::Experimental::where;
+
+      const SimdReal HTr0 = loadChunk(HCell, JCell0, KStart) *
+                            gatherChunk(TrCell, L, JCell0, KStart);
+      const SimdReal HTr1 = loadChunk(HCell, JCell1, KStart) *
+                            gatherChunk(TrCell, L, JCell1, KStart);
+
+      SimdReal HTrEdge;
+      switch (TracersOnEdgeChoice) {
+      case FluxTracerEdgeOption::Center:
+         HTrEdge = 0.5_Real * (HTr0 + HTr1);
+         break;
+      case FluxTracerEdgeOption::Upwind: {
+         const SimdReal Vel = loadChunk(NormalVelEdge, IEdge, KStart);
+         HTrEdge            = Kokkos::max(HTr0, HTr1);
+         where(Vel > 0._Real, HTrEdge) = HTr0;
+         where(Vel < 0._Real, HTrEdge) = HTr1;
+         break;
+      }
+      }
+      scatterChunk(HTracersEdge, L, IEdge, KStart, HTrEdge);
+#else
       switch (TracersOnEdgeChoice) {
       case FluxTracerEdgeOption::Center:
          for (int KVec = 0; KVec < VecLength; ++KVec) {
@@ -61,16 +103,37 @@ class TracerAuxVars {
          }
          break;
       }
+#endif
    }
 
+   template <class TracerArrayType>
    KOKKOS_FUNCTION void
    computeVarsOnCells(int L, int ICell, int KChunk,
                       const Array2DReal &LayerThickEdgeMean,
-                      const Array3DReal &TrCell) const {
+                      const TracerArrayType &TrCell) const {
 
-      const int KStart       = KChunk * VecLength;
-      const Real InvAreaCell = 1._Real / AreaCell(ICell);
+      const int KStart = KChunk * VecLength;
+
+#ifdef OMEGA_SIMD
+      SimdReal Del2TrCellTmp(0._Real);
+
+      for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+         const int JEdge = EdgesOnCell(ICell, J);
 
+         const int JCell0 = CellsOnEdge(JEdge, 0);
+         const int JCell1 = CellsOnEdge(JEdge, 1);
+
+         const Real LaplaceCoeff = LaplaceCoeffOnCell(ICell, J);
+
+         const SimdReal TracerGrad = gatherChunk(TrCell, L, JCell1, KStart) -
+                                     gatherChunk(TrCell, L, JCell0, KStart);
+         Del2TrCellTmp =
+             Del2TrCellTmp - loadChunk(EdgeMask, JEdge, KStart) * LaplaceCoeff *
+                                 loadChunk(LayerThickEdgeMean, JEdge, KStart) *
+                                 TracerGrad;
+      }
+      scatterChunk(Del2TracersCell, L, ICell, KStart, Del2TrCellTmp);
+#else
       Real Del2TrCellTmp[VecLength] = {0};
 
       for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
@@ -79,20 +142,20 @@ class TracerAuxVars {
          const int JCell0 = CellsOnEdge(JEdge, 0);
          const int JCell1 = CellsOnEdge(JEdge, 1);
 
-         const Real DvDcEdge = DvEdge(JEdge) / DcEdge(JEdge);
+         const Real LaplaceCoeff = LaplaceCoeffOnCell(ICell, J);
 
          for (int KVec = 0; KVec < VecLength; ++KVec) {
             const int K           = KStart + KVec;
             const Real TracerGrad = TrCell(L, JCell1, K) - TrCell(L, JCell0, K);
-            Del2TrCellTmp[KVec] -= EdgeMask(JEdge, K) *
-                                   EdgeSignOnCell(ICell, J) * DvDcEdge *
+            Del2TrCellTmp[KVec] -= EdgeMask(JEdge, K) * LaplaceCoeff *
                                    LayerThickEdgeMean(JEdge, K) * TracerGrad;
          }
       }
       for (int KVec = 0; KVec < VecLength; ++KVec) {
          const int K                  = KStart + KVec;
-         Del2TracersCell(L, ICell, K) = Del2TrCellTmp[KVec] * InvAreaCell;
+         Del2TracersCell(L, ICell, K) = Del2TrCellTmp[KVec];
       }
+#endif
    }
 
    void registerFields(const std::string &AuxGroupName,
@@ -103,10 +166,7 @@ class TracerAuxVars {
    Array1DI4 NEdgesOnCell;
    Array2DI4 EdgesOnCell;
    Array2DI4 CellsOnEdge;
-   Array2DReal EdgeSignOnCell;
-   Array1DReal DcEdge;
-   Array1DReal DvEdge;
-   Array1DReal AreaCell;
+   Array2DReal LaplaceCoeffOnCell;
    Array2DReal EdgeMask;
 };
 
@@ -50,31 +50,58 @@ void ForwardBackwardStepper::doStep(
       LOG_CRITICAL("Invalid AuxState");
 
    // R_h^{n} = RHS_h(u^{n}, h^{n}, t^{n})
+   Timing::start("computeThicknessTendencies");
    Tend->computeThicknessTendencies(State, AuxState, CurLevel, CurLevel,
                                     SimTime);
-
-   // h^{n+1} = h^{n} + R_h^{n}
-   updateThicknessByTend(State, NextLevel, State, CurLevel, TimeStep);
-
-   // R_phi^{n} = RHS_phi(u^{n}, h^{n}, phi^{n}, t^{n})
-   Tend->computeTracerTendencies(State, AuxState, CurTracerArray, CurLevel,
-                                 CurLevel, SimTime);
-
-   // phi^{n+1} = (phi^{n} * h^{n} + R_phi^{n}) / h^{n+1}
-   updateTracersByTend(NextTracerArray, CurTracerArray, State, NextLevel, State,
-                       CurLevel, TimeStep);
+   Timing::stop("computeThicknessTendencies");
+
+   // The update graphs only record the fused cell update
+   if (FusedUpdate or UpdateGraphs) {
+      // The tracer tendencies only depend on the current time level so
+      // they can be computed first and both updates done in one sweep
+      // R_phi^{n} = RHS_phi(u^{n}, h^{n}, phi^{n}, t^{n})
+      Timing::start("computeTracerTendencies");
+      Tend->computeTracerTendencies(State, AuxState, CurTracerArray, CurLevel,
+                                    CurLevel, SimTime);
+      Timing::stop("computeTracerTendencies");
+
+      // h^{n+1} = h^{n} + R_h^{n}
+      // phi^{n+1} = (phi^{n} * h^{n} + R_phi^{n}) / h^{n+1}
+      updateThicknessAndTracersByTend(NextTracerArray, CurTracerArray, State,
+                                      NextLevel, State, CurLevel, TimeStep);
+   } else {
+      // h^{n+1} = h^{n} + R_h^{n}
+      updateThicknessByTend(State, NextLevel, State, CurLevel, TimeStep);
+
+      // R_phi^{n} = RHS_phi(u^{n}, h^{n}, phi^{n}, t^{n})
+      Timing::start("computeTracerTendencies");
+      Tend->computeTracerTendencies(State, AuxState, CurTracerArray, CurLevel,
+                                    CurLevel, SimTime);
+      Timing::stop("computeTracerTendencies");
+
+      // phi^{n+1} = (phi^{n} * h^{n} + R_phi^{n}) / h^{n+1}
+      updateTracersByTend(NextTracerArray, CurTracerArray, State, NextLevel,
+                          State, CurLevel, TimeStep);
+   }
 
    // R_u^{n+1} = RHS_u(u^{n}, h^{n+1}, t^{n+1})
+   Timing::start("computeVelocityTendencies");
    Tend->computeVelocityTendencies(State, AuxState, NextLevel, CurLevel,
                                    SimTime + TimeStep);
+   Timing::stop("computeVelocityTendencies");
 
    // u^{n+1} = u^{n} + R_u^{n+1}
    updateVelocityByTend(State, NextLevel, State, CurLevel, TimeStep);
 
+   // Implicit vertical mixing of the new velocity and tracers
+   applyImplicitVertMix(State, NextTracerArray, NextLevel);
+
    // Update time levels (New -> Old) of prognostic variables with halo
    // exchanges
+   Timing::start("updateTimeLevels");
    State->updateTimeLevels();
    Tracers::updateTimeLevels();
+   Timing::stop("updateTimeLevels");
 
    // Advance the clock and update the simulation time
    StepClock->advance();
@@ -0,0 +1,311 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- LowStorageRKStepper.cpp - low-storage Runge-Kutta -------*- C++ -*-===//
+//
+// Contains methods for the low-storage Runge-Kutta time stepping schemes
+//
+//===----------------------------------------------------------------------===//
+
+#include "LowStorageRKStepper.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Constructor creates an instance of a low-storage Runge Kutta stepper and
+// fills with some time information and the stage coefficients. Data
+// pointers are added later.
+LowStorageRKStepper::LowStorageRKStepper(
+    const std::string &InName,      ///< [in] name of time stepper
+    TimeStepperType InType,         ///< [in] LowStorageRK4 or SSPRK3
+    const TimeInstant &InStartTime, ///< [in] start time for time stepping
+    const TimeInstant &InStopTime,  ///< [in] stop  time for time stepping
+    const TimeInterval &InTimeStep  ///< [in] time step
+    )
+    : TimeStepper(InName, InType, 2, InStartTime, InStopTime, InTimeStep) {
+
+   if (InType == TimeStepperType::LowStorageRK4) {
+      // Carpenter and Kennedy (1994) five-stage fourth-order 2N scheme
+      RKA = {0.0, -567301805773.0 / 1357537059087.0,
+             -2404267990393.0 / 2016746695238.0,
+             -3550918686646.0 / 2091501179385.0,
+             -1275806237668.0 / 842570457699.0};
+      RKB = {1432997174477.0 / 9575080441755.0,
+             5161836677717.0 / 13612068292357.0,
+             1720146321549.0 / 2090206949498.0,
+             3134564353537.0 / 4481467310338.0,
+             2277821191437.0 / 14882151754819.0};
+      RKC = {0.0, 1432997174477.0 / 9575080441755.0,
+             2526269341429.0 / 6820363962896.0,
+             2006345519317.0 / 3224310063776.0,
+             2802321613138.0 / 2924317926251.0};
+   } else if (InType == TimeStepperType::SSPRK3) {
+      // Shu and Osher (1988) three-stage third-order SSP scheme
+      RKA = {0.0, 3.0 / 4.0, 1.0 / 3.0};
+      RKC = {0.0, 1.0, 0.5};
+   } else {
+      ABORT_ERROR("LowStorageRKStepper: invalid low-storage stepper type");
+   }
+}
+
+//------------------------------------------------------------------------------
+// Allocate the 2N-storage registers. The registers match the tendency
+// arrays so they cover all the points updated by each stage.
+void LowStorageRKStepper::finalizeInit() {
+
+   if (Type != TimeStepperType::LowStorageRK4)
+      return;
+
+   const auto &ThickTend  = Tend->LayerThicknessTend;
+   const auto &VelTend    = Tend->NormalVelocityTend;
+   const auto &TracerTend = Tend->TracerTend;
+
+   ThickRegister  = Array2DReal("LSRKThickRegister", ThickTend.extent(0),
+                                ThickTend.extent(1));
+   VelRegister    = Array2DReal("LSRKVelRegister", VelTend.extent(0),
+                                VelTend.extent(1));
+   TracerRegister = Array3DReal("LSRKTracerRegister", TracerTend.extent(0),
+                                TracerTend.extent(1), TracerTend.extent(2));
+}
+
+//------------------------------------------------------------------------------
+// Perform one stage of the 2N-storage scheme. The tracers are advanced in
+// thickness-weighted form using the stage input thickness, so the stage
+// can be done in place when the input and output levels are the same.
+void LowStorageRKStepper::updateLowStorageStage(
+    OceanState *State, int SrcLevel, int NextLevel,
+    const Array3DReal &SrcTracers, const Array3DReal &NextTracers, R8 CoeffA,
+    R8 CoeffB) const {
+
+   Array2DReal ThickSrc;
+   Array2DReal ThickNext;
+   Array2DReal VelSrc;
+   Array2DReal VelNext;
+   I4 Err = 0;
+   Err += State->getLayerThickness(ThickSrc, SrcLevel);
+   Err += State->getLayerThickness(ThickNext, NextLevel);
+   Err += State->getNormalVelocity(VelSrc, SrcLevel);
+   Err += State->getNormalVelocity(VelNext, NextLevel);
+   if (Err != 0)
+      ABORT_ERROR("LowStorageRK stage: error retrieving state");
+
+   const auto &ThickTend  = Tend->LayerThicknessTend;
+   const auto &VelTend    = Tend->NormalVelocityTend;
+   const auto &TracerTend = Tend->TracerTend;
+   const auto &ThickReg   = ThickRegister;
+   const auto &VelReg     = VelRegister;
+   const auto &TracerReg  = TracerRegister;
+   const int NTracers     = TracerTend.extent(0);
+   const int NVertLevels  = ThickTend.extent_int(1);
+
+   R8 DtSeconds;
+   TimeStep.get(DtSeconds, TimeUnits::Seconds);
+
+   // Each cell kernel level reads and writes the register and reads the
+   // source state and tendency for the thickness and every tracer, and
+   // writes the next state. The edge kernel does the same for velocity.
+   const R8 Bytes = (5.0 * NTracers + 5.0) * Mesh->NCellsAll * NVertLevels *
+                        sizeof(Real) +
+                    5.0 * Mesh->NEdgesAll * NVertLevels * sizeof(Real);
+   TimingRegion Region("lowStorageRKStage", Bytes);
+
+   // The cell and edge kernels are independent and are recorded into one
+   // graph if update graphs are enabled
+   const GraphKey Key{"lowStorageRKStage",
+                      {ThickSrc.data(), ThickNext.data(), VelSrc.data(),
+                       VelNext.data(), SrcTracers.data(), NextTracers.data(),
+                       ThickReg.data(), VelReg.data(), TracerReg.data(),
+                       ThickTend.data(), VelTend.data(), TracerTend.data()}};
+   runGraph(Key, {CoeffA, CoeffB, DtSeconds}, [&]() {
+      const UpdateCoeff A  = updateCoeff(0, CoeffA);
+      const UpdateCoeff B  = updateCoeff(1, CoeffB);
+      const UpdateCoeff Dt = updateCoeff(2, DtSeconds);
+
+      launchUpdate(
+          "lowStorageRKCellStage", Mesh->NCellsAll, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             const R8 CA         = A();
+             const R8 CB         = B();
+             const R8 CDt        = Dt();
+             const Real OldThick = ThickSrc(ICell, K);
+             const Real DThick =
+                 CA * ThickReg(ICell, K) + CDt * ThickTend(ICell, K);
+             const Real NewThick = OldThick + CB * DThick;
+             ThickReg(ICell, K)  = DThick;
+             ThickNext(ICell, K) = NewThick;
+             for (int L = 0; L < NTracers; ++L) {
+                TracerReg(L, ICell, K)   = CA * TracerReg(L, ICell, K) +
+                                           CDt * TracerTend(L, ICell, K);
+                NextTracers(L, ICell, K) = (SrcTracers(L, ICell, K) * OldThick +
+                                            CB * TracerReg(L, ICell, K)) /
+                                           NewThick;
+             }
+          });
+
+      launchUpdate(
+          "lowStorageRKEdgeStage", Mesh->NEdgesAll, NVertLevels,
+          KOKKOS_LAMBDA(int IEdge, int K) {
+             const Real DVel =
+                 A() * VelReg(IEdge, K) + Dt() * VelTend(IEdge, K);
+             VelReg(IEdge, K)  = DVel;
+             VelNext(IEdge, K) = VelSrc(IEdge, K) + B() * DVel;
+          });
+   });
+}
+
+//------------------------------------------------------------------------------
+// Perform one stage of the SSPRK3 scheme in Shu-Osher form. The stage and
+// next levels may be the same since each point is only read and then
+// written by the same thread.
+void LowStorageRKStepper::updateSSPStage(
+    OceanState *State, int CurLevel, int StageLevel, int NextLevel,
+    const Array3DReal &CurTracers, const Array3DReal &StageTracers,
+    const Array3DReal &NextTracers, R8 CurWeight) const {
+
+   Array2DReal ThickCur;
+   Array2DReal ThickStage;
+   Array2DReal ThickNext;
+   Array2DReal VelCur;
+   Array2DReal VelStage;
+   Array2DReal VelNext;
+   I4 Err = 0;
+   Err += State->getLayerThickness(ThickCur, CurLevel);
+   Err += State->getLayerThickness(ThickStage, StageLevel);
+   Err += State->getLayerThickness(ThickNext, NextLevel);
+   Err += State->getNormalVelocity(VelCur, CurLevel);
+   Err += State->getNormalVelocity(VelStage, StageLevel);
+   Err += State->getNormalVelocity(VelNext, NextLevel);
+   if (Err != 0)
+      ABORT_ERROR("SSPRK3 stage: error retrieving state");
+
+   const auto &ThickTend  = Tend->LayerThicknessTend;
+   const auto &VelTend    = Tend->NormalVelocityTend;
+   const auto &TracerTend = Tend->TracerTend;
+   const int NTracers     = TracerTend.extent(0);
+   const int NVertLevels  = ThickTend.extent_int(1);
+
+   R8 DtSeconds;
+   TimeStep.get(DtSeconds, TimeUnits::Seconds);
+   const R8 StageWeight = 1.0 - CurWeight;
+
+   // Reads the current and stage states and the tendency and writes the
+   // next state for the thickness, every tracer and the velocity
+   const R8 Bytes = (4.0 * NTracers + 4.0) * Mesh->NCellsAll * NVertLevels *
+                        sizeof(Real) +
+                    4.0 * Mesh->NEdgesAll * NVertLevels * sizeof(Real);
+   TimingRegion Region("sspRKStage", Bytes);
+
+   // The cell and edge kernels are independent and are recorded into one
+   // graph if update graphs are enabled
+   const GraphKey Key{"sspRKStage",
+                      {ThickCur.data(), ThickStage.data(), ThickNext.data(),
+                       VelCur.data(), VelStage.data(), VelNext.data(),
+                       CurTracers.data(), StageTracers.data(),
+                       NextTracers.data(), ThickTend.data(), VelTend.data(),
+                       TracerTend.data()}};
+   runGraph(Key, {CurWeight, StageWeight, DtSeconds}, [&]() {
+      const UpdateCoeff WCur   = updateCoeff(0, CurWeight);
+      const UpdateCoeff WStage = updateCoeff(1, StageWeight);
+      const UpdateCoeff Dt     = updateCoeff(2, DtSeconds);
+
+      launchUpdate(
+          "sspRKCellStage", Mesh->NCellsAll, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             const R8 CCur         = WCur();
+             const R8 CStage       = WStage();
+             const R8 CDt          = Dt();
+             const Real OldThick   = ThickCur(ICell, K);
+             const Real StageThick = ThickStage(ICell, K);
+             const Real NewThick =
+                 CCur * OldThick +
+                 CStage * (StageThick + CDt * ThickTend(ICell, K));
+             ThickNext(ICell, K) = NewThick;
+             for (int L = 0; L < NTracers; ++L) {
+                NextTracers(L, ICell, K) =
+                    (CCur * CurTracers(L, ICell, K) * OldThick +
+                     CStage * (StageTracers(L, ICell, K) * StageThick +
+                               CDt * TracerTend(L, ICell, K))) /
+                    NewThick;
+             }
+          });
+
+      launchUpdate(
+          "sspRKEdgeStage", Mesh->NEdgesAll, NVertLevels,
+          KOKKOS_LAMBDA(int IEdge, int K) {
+             VelNext(IEdge, K) =
+                 WCur() * VelCur(IEdge, K) +
+                 WStage() * (VelStage(IEdge, K) + Dt() * VelTend(IEdge, K));
+          });
+   });
+}
+
+//------------------------------------------------------------------------------
+// Advance the state by one step of the low-storage Runge Kutta scheme
+void LowStorageRKStepper::doStep(OceanState *State,   // model state
+                                 TimeInstant &SimTime // current simulation time
+) const {
+
+   int Err = 0;
+
+   const int CurLevel  = 0;
+   const int NextLevel = 1;
+
+   Array3DReal CurTracerArray, NextTracerArray;
+   Err = Tracers::getAll(CurTracerArray, CurLevel);
+   Err = Tracers::getAll(NextTracerArray, NextLevel);
+   if (Err != 0)
+      ABORT_ERROR("LowStorageRK doStep: error retrieving tracers");
+
+   const int NStages = RKC.size();
+   for (int Stage = 0; Stage < NStages; ++Stage) {
+
+      // The first stage starts from the current time level and all later
+      // stages update the next time level in place
+      const int SrcLevel            = (Stage == 0) ? CurLevel : NextLevel;
+      const Array3DReal &SrcTracers =
+          (Stage == 0) ? CurTracerArray : NextTracerArray;
+      const TimeInstant StageTime   = SimTime + RKC[Stage] * TimeStep;
+
+      // R_q^{(s)} = RHS_q(u^{(s)}, h^{(s)}, phi^{(s)}, t^{n} + c_s dt)
+      Timing::start("computeAllTendencies");
+      Tend->computeAllTendencies(State, AuxState, SrcTracers, SrcLevel,
+                                 SrcLevel, StageTime);
+      // Join the tendency groups, which may run on separate instances
+      ExecInstances::fence();
+      Timing::stop("computeAllTendencies");
+
+      if (Type == TimeStepperType::LowStorageRK4) {
+         // dq = A_s dq + dt R_q^{(s)},  q^{(s+1)} = q^{(s)} + B_s dq
+         updateLowStorageStage(State, SrcLevel, NextLevel, SrcTracers,
+                               NextTracerArray, RKA[Stage], RKB[Stage]);
+      } else {
+         // q^{(s+1)} = a_s q^{n} + (1 - a_s) (q^{(s)} + dt R_q^{(s)})
+         updateSSPStage(State, CurLevel, SrcLevel, NextLevel, CurTracerArray,
+                        SrcTracers, NextTracerArray, RKA[Stage]);
+      }
+
+      // Update halos of the stage state before the next stage with one
+      // merged exchange. The final stage is exchanged with the time level
+      // update.
+      if (Stage < NStages - 1)
+         exchangeStateHalos(State, NextTracerArray, NextLevel);
+   }
+
+   // Implicit vertical mixing of the new velocity and tracers
+   applyImplicitVertMix(State, NextTracerArray, NextLevel);
+
+   // Update time levels (New -> Old) of prognostic variables with halo
+   // exchanges
+   Timing::start("updateTimeLevels");
+   State->updateTimeLevels();
+   Tracers::updateTimeLevels();
+   Timing::stop("updateTimeLevels");
+
+   // Advance the clock and update the simulation time
+   StepClock->advance();
+   SimTime = StepClock->getCurrentTime();
+}
+
+} // namespace OMEGA
@@ -0,0 +1,102 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_LOWSTORAGERKSTEPPER_H
+#define OMEGA_LOWSTORAGERKSTEPPER_H
+//===-- LowStorageRKStepper.h - low-storage Runge-Kutta methods -*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the low-storage Runge-Kutta time steppers
+///
+/// Low-storage Runge-Kutta steppers advance the state with as few copies of
+/// the state as possible. LowStorageRK4 is the five-stage fourth-order
+/// 2N-storage scheme of Carpenter and Kennedy (1994) written in the Williamson
+/// (1980) form, which needs one extra register per prognostic variable beyond
+/// the state and tendencies. SSPRK3 is the three-stage third-order strong
+/// stability preserving scheme of Shu and Osher (1988), which only needs the
+/// current and next time levels. Tracers are advanced in thickness-weighted
+/// form within each stage, so no extra tracer copies are needed for SSPRK3
+/// and only one for LowStorageRK4.
+//
+//===----------------------------------------------------------------------===//
+
+#include "TimeStepper.h"
+
+#include <vector>
+
+namespace OMEGA {
+
+/// A class for the low-storage Runge-Kutta time steppers
+class LowStorageRKStepper : public TimeStepper {
+ public:
+   /// Constructor creates an instance of a low-storage RK stepper of the
+   /// input type and fills with some time information. Data pointers are
+   /// added later.
+   LowStorageRKStepper(
+       const std::string &InName,      ///< [in] name of time stepper
+       TimeStepperType InType,         ///< [in] LowStorageRK4 or SSPRK3
+       const TimeInstant &InStartTime, ///< [in] start time for time stepping
+       const TimeInstant &InStopTime,  ///< [in] stop  time for time stepping
+       const TimeInterval &InTimeStep  ///< [in] time step
+   );
+
+   /// Advance the state by one step of the low-storage RK scheme
+   void doStep(OceanState *State,   ///< [inout] model state
+               TimeInstant &SimTime ///< [inout] current simulation time
+   ) const override;
+
+   // these should be private, they are public only because of CUDA
+   // limitations
+
+   /// Performs one stage of a 2N-storage scheme. For each prognostic
+   /// variable q with register dq:
+   /// dq = CoeffA * dq + TimeStep * Tend
+   /// q(NextLevel) = q(SrcLevel) + CoeffB * dq
+   /// with tracers updated in thickness-weighted form
+   void updateLowStorageStage(
+       OceanState *State,              ///< [inout] model state
+       int SrcLevel,                   ///< [in] time level of stage input
+       int NextLevel,                  ///< [in] time level of stage output
+       const Array3DReal &SrcTracers,  ///< [in] tracers at stage input
+       const Array3DReal &NextTracers, ///< [out] tracers at stage output
+       R8 CoeffA,                      ///< [in] coeff for register
+       R8 CoeffB                       ///< [in] coeff for state update
+   ) const;
+
+   /// Performs one stage of the SSPRK3 scheme in Shu-Osher form:
+   /// q(NextLevel) = CurWeight * q(CurLevel) +
+   ///    (1 - CurWeight) * (q(StageLevel) + TimeStep * Tend)
+   /// with tracers updated in thickness-weighted form
+   void updateSSPStage(
+       OceanState *State,               ///< [inout] model state
+       int CurLevel,                    ///< [in] time level at start of step
+       int StageLevel,                  ///< [in] time level of stage input
+       int NextLevel,                   ///< [in] time level of stage output
+       const Array3DReal &CurTracers,   ///< [in] tracers at start of step
+       const Array3DReal &StageTracers, ///< [in] tracers at stage input
+       const Array3DReal &NextTracers,  ///< [out] tracers at stage output
+       R8 CurWeight                     ///< [in] weight for start of step
+   ) const;
+
+ protected:
+   /// Allocates the 2N-storage registers once the tendencies are attached
+   void finalizeInit() override;
+
+ private:
+   /// Stage coefficients. RKA and RKB are the Williamson coefficients for
+   /// LowStorageRK4, RKA holds the weights of the start of step state for
+   /// SSPRK3, and RKC are the stage times as a fraction of the time step.
+   std::vector<R8> RKA;
+   std::vector<R8> RKB;
+   std::vector<R8> RKC;
+
+   /// Registers for the 2N-storage scheme (unused by SSPRK3)
+   Array2DReal ThickRegister;  ///< register for layer thickness
+   Array2DReal VelRegister;    ///< register for normal velocity
+   Array3DReal TracerRegister; ///< register for thickness-weighted tracers
+};
+
+} // namespace OMEGA
+#endif
@@ -45,27 +45,38 @@ void RungeKutta2Stepper::doStep(OceanState *State,   // model state
 
    // q = (h,u,phi)
    // R_q^{n} = RHS_q(u^{n}, h^{n}, phi^{n}, t^{n})
+   Timing::start("computeAllTendencies");
    Tend->computeAllTendencies(State, AuxState, CurTracerArray, CurLevel,
                               CurLevel, SimTime);
+   // Join the tendency groups, which may run on separate instances
+   ExecInstances::fence();
+   Timing::stop("computeAllTendencies");
 
    // q^{n+0.5} = q^{n} + 0.5*dt*R_q^{n}
-   updateStateByTend(State, NextLevel, State, CurLevel, 0.5 * TimeStep);
-   updateTracersByTend(NextTracerArray, CurTracerArray, State, NextLevel, State,
-                       CurLevel, 0.5 * TimeStep);
+   updateStateAndTracersByTend(NextTracerArray, CurTracerArray, State,
+                               NextLevel, State, CurLevel, 0.5 * TimeStep);
 
    // R_q^{n+0.5} = RHS_q(u^{n+0.5}, h^{n+0.5}, phi^{n+0.5}, t^{n+0.5})
+   Timing::start("computeAllTendencies");
    Tend->computeAllTendencies(State, AuxState, NextTracerArray, NextLevel,
                               NextLevel, SimTime + 0.5 * TimeStep);
+   // Join the tendency groups, which may run on separate instances
+   ExecInstances::fence();
+   Timing::stop("computeAllTendencies");
 
    // q^{n+1} = q^{n} + dt*R_q^{n+0.5}
-   updateStateByTend(State, NextLevel, State, CurLevel, TimeStep);
-   updateTracersByTend(NextTracerArray, CurTracerArray, State, NextLevel, State,
-                       CurLevel, TimeStep);
+   updateStateAndTracersByTend(NextTracerArray, CurTracerArray, State,
+                               NextLevel, State, CurLevel, TimeStep);
+
+   // Implicit vertical mixing of the new velocity and tracers
+   applyImplicitVertMix(State, NextTracerArray, NextLevel);
 
    // Update time levels (New -> Old) of prognostic variables with halo
    // exchanges
+   Timing::start("updateTimeLevels");
    State->updateTimeLevels();
    Tracers::updateTimeLevels();
+   Timing::stop("updateTimeLevels");
 
    // Advance the clock and update the simulation time
    StepClock->advance();
@@ -0,0 +1,373 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- SplitExplicitStepper.cpp - split-explicit time stepper --*- C++ -*-===//
+//
+// Contains methods for the split-explicit barotropic/baroclinic time stepper
+//
+//===----------------------------------------------------------------------===//
+
+#include "SplitExplicitStepper.h"
+#include "Config.h"
+#include "Error.h"
+
+namespace OMEGA {
+
+//------------------------------------------------------------------------------
+// Constructor creates an instance of a split-explicit stepper and fills with
+// some time information. Data pointers are added later.
+SplitExplicitStepper::SplitExplicitStepper(
+    const std::string &InName,      ///< [in] name of time stepper
+    const TimeInstant &InStartTime, ///< [in] start time for time stepping
+    const TimeInstant &InStopTime,  ///< [in] stop  time for time stepping
+    const TimeInterval &InTimeStep  ///< [in] time step
+    )
+    : TimeStepper(InName, TimeStepperType::SplitExplicit, 2, InStartTime,
+                  InStopTime, InTimeStep) {}
+
+//------------------------------------------------------------------------------
+// Read the number of barotropic substeps and allocate the barotropic arrays
+// once the mesh is attached
+void SplitExplicitStepper::finalizeInit() {
+
+   // The number of substeps is optional in the TimeIntegration config
+   Config *OmegaConfig = Config::getOmegaConfig();
+   Config TimeIntConfig("TimeIntegration");
+   Error Err = OmegaConfig->get(TimeIntConfig);
+   if (Err.isSuccess() and TimeIntConfig.existsVar("BarotropicSubcycles")) {
+      Err = TimeIntConfig.get("BarotropicSubcycles", NBtrSubcycles);
+      CHECK_ERROR_ABORT(Err, "Error reading BarotropicSubcycles from Config");
+   }
+   if (NBtrSubcycles < 1)
+      ABORT_ERROR("SplitExplicit: BarotropicSubcycles must be positive");
+
+   ThickFluxDiv = std::make_unique<ThicknessFluxDivOnCell>(Mesh);
+   SshGrad      = std::make_unique<SSHGradOnEdge>(Mesh);
+   TrHorzAdv    = std::make_unique<TracerHorzAdvOnCell>(Mesh);
+
+   const I4 NCellsSize  = Mesh->NCellsSize;
+   const I4 NEdgesSize  = Mesh->NEdgesSize;
+   const I4 NVertLevels = Mesh->NVertLevels;
+
+   SshCell      = Array2DReal("BtrSshCell", NCellsSize, VecLength);
+   SshTend      = Array2DReal("BtrSshTend", NCellsSize, VecLength);
+   BtrThickEdge = Array2DReal("BtrThickEdge", NEdgesSize, VecLength);
+   BtrVel       = Array2DReal("BtrVel", NEdgesSize, VecLength);
+   BtrVelAvg    = Array2DReal("BtrVelAvg", NEdgesSize, VecLength);
+   BtrVelTend   = Array2DReal("BtrVelTend", NEdgesSize, VecLength);
+   BtrForcing   = Array2DReal("BtrForcing", NEdgesSize, VecLength);
+
+   LayerThickEdge = Array2DReal("SplitThickEdge", NEdgesSize, NVertLevels);
+   TransportVel   = Array2DReal("SplitTransportVel", NEdgesSize, NVertLevels);
+   ThickTendSplit = Array2DReal("SplitThickTend", NCellsSize, NVertLevels);
+   HTrEdgeSplit   = Array3DTracerAux("SplitHTrEdge", Tracers::getNumTracers(),
+                                     NEdgesSize, NVertLevels);
+}
+
+//------------------------------------------------------------------------------
+// Get the number of barotropic substeps
+int SplitExplicitStepper::getNBtrSubcycles() const { return NBtrSubcycles; }
+
+//------------------------------------------------------------------------------
+// Split the state at the start of the step into barotropic and baroclinic
+// parts. The slow forcing is the depth mean of the 3D velocity tendency with
+// the barotropic SSH gradient at the start of the step removed, since that
+// fast term is recomputed on every substep.
+void SplitExplicitStepper::initBarotropic(const Array2DReal &LayerThick,
+                                          const Array2DReal &NormalVel) const {
+
+   const auto &BottomDepth = Mesh->BottomDepth;
+   const auto &CellsOnEdge = Mesh->CellsOnEdge;
+   const auto &EdgeMask    = Mesh->EdgeMask;
+   const auto &VelTend     = Tend->NormalVelocityTend;
+   const auto &LocSsh      = SshCell;
+   const auto &LocThickE   = LayerThickEdge;
+   const auto &LocBtrThick = BtrThickEdge;
+   const auto &LocBtrVel   = BtrVel;
+   const auto &LocBtrAvg   = BtrVelAvg;
+   const auto &LocBtrTend  = BtrVelTend;
+   const auto &LocForcing  = BtrForcing;
+   const auto LocSshGrad   = *SshGrad;
+   const int NVertLevels   = Mesh->NVertLevels;
+
+   // SSH from the total column thickness
+   parallelFor(
+       "splitInitSsh", {Mesh->NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+          Real ColThick = 0;
+          for (int K = 0; K < NVertLevels; ++K)
+             ColThick += LayerThick(ICell, K);
+          LocSsh(ICell, 0) = ColThick - BottomDepth(ICell);
+       });
+
+   // Depth-mean velocity and slow forcing at edges
+   parallelFor(
+       "splitInitBtrVel", {Mesh->NEdgesAll}, KOKKOS_LAMBDA(int IEdge) {
+          const I4 ICell0 = CellsOnEdge(IEdge, 0);
+          const I4 ICell1 = CellsOnEdge(IEdge, 1);
+          Real ColThick   = 0;
+          Real ColVel     = 0;
+          Real ColTend    = 0;
+          for (int K = 0; K < NVertLevels; ++K) {
+             const Real ThickE =
+                 0.5_Real * EdgeMask(IEdge, K) *
+                 (LayerThick(ICell0, K) + LayerThick(ICell1, K));
+             ColThick += ThickE;
+             ColVel += ThickE * NormalVel(IEdge, K);
+             ColTend += ThickE * VelTend(IEdge, K);
+             LocThickE(IEdge, K) = ThickE;
+          }
+          const Real InvColThick = ColThick > 0 ? 1._Real / ColThick : 0;
+
+          LocBtrThick(IEdge, 0) = ColThick;
+          LocBtrVel(IEdge, 0)   = ColVel * InvColThick;
+          LocBtrAvg(IEdge, 0)   = 0;
+
+          for (int KVec = 0; KVec < VecLength; ++KVec)
+             LocBtrTend(IEdge, KVec) = 0;
+          LocSshGrad(LocBtrTend, IEdge, 0, LocSsh);
+          LocForcing(IEdge, 0) = ColTend * InvColThick - LocBtrTend(IEdge, 0);
+       });
+}
+
+//------------------------------------------------------------------------------
+// Advance the barotropic mode by one forward-backward substep. The SSH is
+// advanced with the current barotropic velocity and the velocity with the
+// gradient of the new SSH. The velocity used in the SSH update is averaged
+// over the substeps for the layer thickness transport.
+void SplitExplicitStepper::advanceBarotropic(R8 DtSub) const {
+
+   const auto &LocSsh      = SshCell;
+   const auto &LocSshTend  = SshTend;
+   const auto &LocBtrThick = BtrThickEdge;
+   const auto &LocBtrVel   = BtrVel;
+   const auto &LocBtrAvg   = BtrVelAvg;
+   const auto &LocBtrTend  = BtrVelTend;
+   const auto &LocForcing  = BtrForcing;
+   const auto LocThickDiv  = *ThickFluxDiv;
+   const auto LocSshGrad   = *SshGrad;
+   const Real InvNSub      = 1._Real / NBtrSubcycles;
+
+   // eta^{m+1} = eta^{m} - dts div(H ubar^{m})
+   parallelFor(
+       "splitBtrSsh", {Mesh->NCellsAll}, KOKKOS_LAMBDA(int ICell) {
+          for (int KVec = 0; KVec < VecLength; ++KVec)
+             LocSshTend(ICell, KVec) = 0;
+          LocThickDiv(LocSshTend, ICell, 0, LocBtrThick, LocBtrVel);
+          LocSsh(ICell, 0) += DtSub * LocSshTend(ICell, 0);
+       });
+   MeshHalo->exchangeFullArrayHalo(SshCell, OnCell);
+
+   // ubar^{m+1} = ubar^{m} + dts (-g grad(eta^{m+1}) + F)
+   parallelFor(
+       "splitBtrVel", {Mesh->NEdgesAll}, KOKKOS_LAMBDA(int IEdge) {
+          LocBtrAvg(IEdge, 0) += InvNSub * LocBtrVel(IEdge, 0);
+          for (int KVec = 0; KVec < VecLength; ++KVec)
+             LocBtrTend(IEdge, KVec) = 0;
+          LocSshGrad(LocBtrTend, IEdge, 0, LocSsh);
+          LocBtrVel(IEdge, 0) +=
+              DtSub * (LocBtrTend(IEdge, 0) + LocForcing(IEdge, 0));
+       });
+   MeshHalo->exchangeFullArrayHalo(BtrVel, OnEdge);
+}
+
+//------------------------------------------------------------------------------
+// Advance the baroclinic velocity over the full step and add the new
+// barotropic velocity. The layer thickness is advanced with the baroclinic
+// velocity at the start of the step plus the time-averaged barotropic
+// velocity, so the change in column thickness equals the change in SSH from
+// the subcycle. The horizontal advection in the thickness and tracer
+// tendencies, computed with the velocity at the start of the step, is
+// replaced by the advection with this transport velocity and the same edge
+// thickness flux, so a uniform tracer stays uniform. The other terms of both
+// tendencies are kept.
+void SplitExplicitStepper::updateBaroclinic(
+    const Array2DReal &LayerThickCur, const Array2DReal &LayerThickNext,
+    const Array2DReal &NormalVelCur, const Array2DReal &NormalVelNext,
+    const Array3DReal &CurTracers, const Array3DReal &NextTracers) const {
+
+   const auto &CellsOnEdge = Mesh->CellsOnEdge;
+   const auto &EdgeMask    = Mesh->EdgeMask;
+   const auto &VelTend     = Tend->NormalVelocityTend;
+   const auto &ThickTend   = Tend->LayerThicknessTend;
+   const auto &TracerTend  = Tend->TracerTend;
+   const auto &FluxThickE  = AuxState->LayerThicknessAux.FluxLayerThickEdge;
+   const auto &HTracersE   = AuxState->TracerAux.HTracersEdge;
+   const auto &LocThickE   = LayerThickEdge;
+   const auto &LocBtrThick = BtrThickEdge;
+   const auto &LocBtrVel   = BtrVel;
+   const auto &LocBtrAvg   = BtrVelAvg;
+   const auto &LocTransVel = TransportVel;
+   const auto &LocThickTnd = ThickTendSplit;
+   const auto &LocHTrE     = HTrEdgeSplit;
+   const auto LocThickDiv  = *ThickFluxDiv;
+   const auto LocTrHorzAdv = *TrHorzAdv;
+   const int NVertLevels   = Mesh->NVertLevels;
+   const int NChunks       = NVertLevels / VecLength;
+   const int NTracers      = TracerTend.extent(0);
+   const bool UpwindTracers =
+       AuxState->TracerAux.TracersOnEdgeChoice == FluxTracerEdgeOption::Upwind;
+
+   R8 DtSeconds;
+   TimeStep.get(DtSeconds, TimeUnits::Seconds);
+
+   parallelFor(
+       "splitBaroclinicVel", {Mesh->NEdgesAll}, KOKKOS_LAMBDA(int IEdge) {
+          // Recompute the depth means at the start of the step
+          const Real ColThick    = LocBtrThick(IEdge, 0);
+          const Real InvColThick = ColThick > 0 ? 1._Real / ColThick : 0;
+          Real ColVel            = 0;
+          Real ColTend           = 0;
+          for (int K = 0; K < NVertLevels; ++K) {
+             ColVel += LocThickE(IEdge, K) * NormalVelCur(IEdge, K);
+             ColTend += LocThickE(IEdge, K) * VelTend(IEdge, K);
+          }
+          const Real BtrVelCur = ColVel * InvColThick;
+          const Real BtrTend   = ColTend * InvColThick;
+
+          for (int K = 0; K < NVertLevels; ++K) {
+             const Real BclVelCur    = NormalVelCur(IEdge, K) - BtrVelCur;
+             const Real BclTend      = VelTend(IEdge, K) - BtrTend;
+             const Real Mask         = EdgeMask(IEdge, K);
+             NormalVelNext(IEdge, K) =
+                 Mask * (BclVelCur + DtSeconds * BclTend + LocBtrVel(IEdge, 0));
+             LocTransVel(IEdge, K)   = Mask * (BclVelCur + LocBtrAvg(IEdge, 0));
+          }
+       });
+
+   // Thickness-weighted edge tracers for the transport flux, with the same
+   // edge tracer choice as the tracer tendencies
+   parallelFor(
+       "splitTracersOnEdge", {NTracers, Mesh->NEdgesAll},
+       KOKKOS_LAMBDA(int L, int IEdge) {
+          const I4 ICell0 = CellsOnEdge(IEdge, 0);
+          const I4 ICell1 = CellsOnEdge(IEdge, 1);
+          for (int K = 0; K < NVertLevels; ++K) {
+             const Real Tr0 = CurTracers(L, ICell0, K);
+             const Real Tr1 = CurTracers(L, ICell1, K);
+             Real TrEdge    = 0.5_Real * (Tr0 + Tr1);
+             if (UpwindTracers) {
+                const Real Vel = LocTransVel(IEdge, K);
+                TrEdge = Vel > 0 ? Tr0 : (Vel < 0 ? Tr1 : TrEdge);
+             }
+             LocHTrE(L, IEdge, K) = LocThickE(IEdge, K) * TrEdge;
+          }
+       });
+
+   parallelFor(
+       "splitBaroclinicThick", {Mesh->NCellsAll, NChunks},
+       KOKKOS_LAMBDA(int ICell, int KChunk) {
+          const I4 KStart = KChunk * VecLength;
+
+          // Swap the advection at the start of the step for the transport
+          // advection, using the tendency arrays of the step end as scratch
+          for (int KVec = 0; KVec < VecLength; ++KVec)
+             LocThickTnd(ICell, KStart + KVec) = 0;
+          LocThickDiv(LocThickTnd, ICell, KChunk, FluxThickE, NormalVelCur);
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             const I4 K = KStart + KVec;
+             LocThickTnd(ICell, K) =
+                 ThickTend(ICell, K) - LocThickTnd(ICell, K);
+          }
+          LocThickDiv(LocThickTnd, ICell, KChunk, LocThickE, LocTransVel);
+
+          for (int L = 0; L < NTracers; ++L) {
+             for (int KVec = 0; KVec < VecLength; ++KVec)
+                NextTracers(L, ICell, KStart + KVec) = 0;
+             LocTrHorzAdv(NextTracers, L, ICell, KChunk, NormalVelCur,
+                          HTracersE);
+             for (int KVec = 0; KVec < VecLength; ++KVec) {
+                const I4 K = KStart + KVec;
+                NextTracers(L, ICell, K) =
+                    TracerTend(L, ICell, K) - NextTracers(L, ICell, K);
+             }
+             LocTrHorzAdv(NextTracers, L, ICell, KChunk, LocTransVel, LocHTrE);
+          }
+
+          for (int KVec = 0; KVec < VecLength; ++KVec) {
+             const I4 K          = KStart + KVec;
+             const Real OldThick = LayerThickCur(ICell, K);
+             const Real NewThick = OldThick + DtSeconds * LocThickTnd(ICell, K);
+             for (int L = 0; L < NTracers; ++L) {
+                NextTracers(L, ICell, K) =
+                    (CurTracers(L, ICell, K) * OldThick +
+                     DtSeconds * NextTracers(L, ICell, K)) /
+                    NewThick;
+             }
+             LayerThickNext(ICell, K) = NewThick;
+          }
+       });
+}
+
+//------------------------------------------------------------------------------
+// Advance the state by one baroclinic step with barotropic subcycling
+void SplitExplicitStepper::doStep(
+    OceanState *State,   // input model state
+    TimeInstant &SimTime // current simulation time
+) const {
+
+   int Err = 0;
+
+   const int CurLevel  = 0;
+   const int NextLevel = 1;
+
+   Array3DReal CurTracerArray, NextTracerArray;
+   Err = Tracers::getAll(CurTracerArray, CurLevel);
+   Err = Tracers::getAll(NextTracerArray, NextLevel);
+   if (Err != 0)
+      ABORT_ERROR("SplitExplicit doStep: error retrieving tracers");
+
+   Array2DReal LayerThickCur;
+   Array2DReal LayerThickNext;
+   Array2DReal NormalVelCur;
+   Array2DReal NormalVelNext;
+   Err += State->getLayerThickness(LayerThickCur, CurLevel);
+   Err += State->getLayerThickness(LayerThickNext, NextLevel);
+   Err += State->getNormalVelocity(NormalVelCur, CurLevel);
+   Err += State->getNormalVelocity(NormalVelNext, NextLevel);
+   if (Err != 0)
+      ABORT_ERROR("SplitExplicit doStep: error retrieving state");
+
+   // R_q^{n} = RHS_q(u^{n}, h^{n}, phi^{n}, t^{n})
+   Timing::start("computeAllTendencies");
+   Tend->computeAllTendencies(State, AuxState, CurTracerArray, CurLevel,
+                              CurLevel, SimTime);
+   // Join the tendency groups, which may run on separate instances
+   ExecInstances::fence();
+   Timing::stop("computeAllTendencies");
+
+   // Split into barotropic and baroclinic parts and subcycle the barotropic
+   // mode over the step
+   Timing::start("barotropicSubcycle");
+   initBarotropic(LayerThickCur, NormalVelCur);
+
+   R8 DtSeconds;
+   TimeStep.get(DtSeconds, TimeUnits::Seconds);
+   const R8 DtSub = DtSeconds / NBtrSubcycles;
+   for (int Sub = 0; Sub < NBtrSubcycles; ++Sub)
+      advanceBarotropic(DtSub);
+   Timing::stop("barotropicSubcycle");
+
+   // Baroclinic velocity, layer thickness and tracer updates
+   Timing::start("updateBaroclinic");
+   updateBaroclinic(LayerThickCur, LayerThickNext, NormalVelCur, NormalVelNext,
+                    CurTracerArray, NextTracerArray);
+   Timing::stop("updateBaroclinic");
+
+   // Implicit vertical mixing of the new velocity and tracers
+   applyImplicitVertMix(State, NextTracerArray, NextLevel);
+
+   // Update time levels (New -> Old) of prognostic variables with halo
+   // exchanges
+   Timing::start("updateTimeLevels");
+   State->updateTimeLevels();
+   Tracers::updateTimeLevels();
+   Timing::stop("updateTimeLevels");
+
+   // Advance the clock and update the simulation time
+   StepClock->advance();
+   SimTime = StepClock->getCurrentTime();
+}
+
+} // namespace OMEGA
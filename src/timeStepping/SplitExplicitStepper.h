@@ -0,0 +1,119 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+#ifndef OMEGA_SPLITEXPLICITSTEPPER_H
+#define OMEGA_SPLITEXPLICITSTEPPER_H
+//===-- SplitExplicitStepper.h - split-explicit time stepper ----*- C++ -*-===//
+//
+/// \file
+/// \brief Defines the split-explicit barotropic/baroclinic time stepper
+///
+/// The split-explicit stepper separates the fast external (barotropic) mode
+/// from the slow internal (baroclinic) dynamics. Each step computes the 3D
+/// tendencies once and splits the velocity into its thickness-weighted depth
+/// mean and the deviation from that mean. The barotropic SSH and velocity
+/// are then advanced with a number of forward-backward substeps of the 2D
+/// continuity and momentum equations, reusing the ThicknessFluxDivOnCell and
+/// SSHGradOnEdge functors on 2D arrays. The baroclinic velocity is advanced
+/// with the full step and recombined with the new barotropic velocity, and
+/// the layer thickness is advanced with the time-averaged barotropic
+/// transport so that the column thickness matches the barotropic SSH. The
+/// tracers are advected with the same thickness flux, so the horizontal
+/// advection computed with the velocity at the start of the step is replaced
+/// in both the thickness and the tracer tendencies.
+/// The number of substeps is set by the optional BarotropicSubcycles entry
+/// in the TimeIntegration configuration (default 20).
+//
+//===----------------------------------------------------------------------===//
+
+#include "TendencyTerms.h"
+#include "TimeStepper.h"
+
+#include <memory>
+
+namespace OMEGA {
+
+/// A class for the split-explicit time stepper
+class SplitExplicitStepper : public TimeStepper {
+ public:
+   /// Constructor creates an instance of a split-explicit stepper and fills
+   /// with some time information. Data pointers are added later.
+   SplitExplicitStepper(
+       const std::string &InName,      ///< [in] name of time stepper
+       const TimeInstant &InStartTime, ///< [in] start time for time stepping
+       const TimeInstant &InStopTime,  ///< [in] stop  time for time stepping
+       const TimeInterval &InTimeStep  ///< [in] time step
+   );
+
+   /// Advance the state by one baroclinic step with barotropic subcycling
+   void doStep(OceanState *State,   ///< [inout] model state
+               TimeInstant &SimTime ///< [inout] current simulation time
+   ) const override;
+
+   /// Get the number of barotropic substeps per baroclinic step
+   int getNBtrSubcycles() const;
+
+   // these should be private, they are public only because of CUDA
+   // limitations
+
+   /// Splits the current state into barotropic and baroclinic parts. Computes
+   /// the SSH, the depth-mean velocity and the slow depth-mean forcing of the
+   /// barotropic mode from the 3D velocity tendency
+   void initBarotropic(
+       const Array2DReal &LayerThick, ///< [in] layer thickness at step start
+       const Array2DReal &NormalVel   ///< [in] normal velocity at step start
+   ) const;
+
+   /// Advances the barotropic SSH and velocity by one forward-backward
+   /// substep and accumulates the time-averaged barotropic velocity
+   void advanceBarotropic(R8 DtSub ///< [in] substep length in seconds
+   ) const;
+
+   /// Advances the baroclinic velocity and recombines it with the new
+   /// barotropic velocity, then updates the layer thickness with the
+   /// time-averaged transport and the tracers
+   void updateBaroclinic(
+       const Array2DReal &LayerThickCur,  ///< [in] thickness at step start
+       const Array2DReal &LayerThickNext, ///< [out] thickness at step end
+       const Array2DReal &NormalVelCur,   ///< [in] velocity at step start
+       const Array2DReal &NormalVelNext,  ///< [out] velocity at step end
+       const Array3DReal &CurTracers,     ///< [in] tracers at step start
+       const Array3DReal &NextTracers     ///< [out] tracers at step end
+   ) const;
+
+ protected:
+   /// Reads the number of substeps and allocates the barotropic arrays
+   void finalizeInit() override;
+
+ private:
+   /// Number of barotropic substeps per baroclinic step
+   int NBtrSubcycles = 20;
+
+   /// Functors reused for the 2D barotropic equations and the layer
+   /// thickness and tracer transport
+   std::unique_ptr<ThicknessFluxDivOnCell> ThickFluxDiv;
+   std::unique_ptr<SSHGradOnEdge> SshGrad;
+   std::unique_ptr<TracerHorzAdvOnCell> TrHorzAdv;
+
+   // The barotropic arrays have a second dimension of VecLength so they can
+   // be passed to the vectorized functors. Only the first entry is used.
+   Array2DReal SshCell;      ///< barotropic SSH
+   Array2DReal SshTend;      ///< tendency of barotropic SSH
+   Array2DReal BtrThickEdge; ///< total column thickness at edges
+   Array2DReal BtrVel;       ///< barotropic velocity
+   Array2DReal BtrVelAvg;    ///< time-averaged barotropic velocity
+   Array2DReal BtrVelTend;   ///< fast tendency of barotropic velocity
+   Array2DReal BtrForcing;   ///< slow depth-mean forcing of barotropic vel
+
+   Array2DReal LayerThickEdge; ///< layer thickness at edges
+   Array2DReal TransportVel;   ///< velocity for the layer thickness flux
+   Array2DReal ThickTendSplit; ///< layer thickness tendency
+
+   /// Thickness-weighted tracers at edges for the transport flux
+   Array3DTracerAux HTrEdgeSplit;
+};
+
+} // namespace OMEGA
+#endif
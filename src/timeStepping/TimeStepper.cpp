@@ -13,8 +13,16 @@
 #include "Config.h"
 #include "Error.h"
 #include "ForwardBackwardStepper.h"
+#include "ImplicitVertMix.h"
+#include "MachEnv.h"
+#include "LowStorageRKStepper.h"
 #include "RungeKutta2Stepper.h"
 #include "RungeKutta4Stepper.h"
+#include "SplitExplicitStepper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mpi.h>
 
 namespace OMEGA {
 
@@ -40,9 +48,16 @@ TimeStepperType getTimeStepperFromStr(const std::string &InString) {
       TimeStepperChoice = TimeStepperType::RungeKutta4;
    } else if (InString == "RungeKutta2") {
       TimeStepperChoice = TimeStepperType::RungeKutta2;
+   } else if (InString == "LowStorageRK4") {
+      TimeStepperChoice = TimeStepperType::LowStorageRK4;
+   } else if (InString == "SSPRK3") {
+      TimeStepperChoice = TimeStepperType::SSPRK3;
+   } else if (InString == "SplitExplicit") {
+      TimeStepperChoice = TimeStepperType::SplitExplicit;
    } else {
       ABORT_ERROR("TimeStepper should be one of 'Forward-Backward', "
-                  "'RungeKutta4' or 'RungeKutta2' but got {}:",
+                  "'RungeKutta4', 'RungeKutta2', 'LowStorageRK4', "
+                  "'SSPRK3' or 'SplitExplicit' but got {}:",
                   InString);
    }
 
@@ -117,6 +132,15 @@ TimeStepper *TimeStepper::create(
       NewTimeStepper =
           new RungeKutta2Stepper(InName, InStartTime, InStopTime, InTimeStep);
       break;
+   case TimeStepperType::LowStorageRK4:
+   case TimeStepperType::SSPRK3:
+      NewTimeStepper = new LowStorageRKStepper(InName, InType, InStartTime,
+                                               InStopTime, InTimeStep);
+      break;
+   case TimeStepperType::SplitExplicit:
+      NewTimeStepper = new SplitExplicitStepper(InName, InStartTime,
+                                                InStopTime, InTimeStep);
+      break;
    case TimeStepperType::Invalid:
       ABORT_ERROR("Invalid time stepping method");
    default:
@@ -168,6 +192,15 @@ TimeStepper *TimeStepper::create(
       NewTimeStepper =
           new RungeKutta2Stepper(InName, InStartTime, InStopTime, InTimeStep);
       break;
+   case TimeStepperType::LowStorageRK4:
+   case TimeStepperType::SSPRK3:
+      NewTimeStepper = new LowStorageRKStepper(InName, InType, InStartTime,
+                                               InStopTime, InTimeStep);
+      break;
+   case TimeStepperType::SplitExplicit:
+      NewTimeStepper = new SplitExplicitStepper(InName, InStartTime,
+                                                InStopTime, InTimeStep);
+      break;
    case TimeStepperType::Invalid:
       ABORT_ERROR("Invalid time stepping method");
    default:
@@ -246,6 +279,20 @@ void TimeStepper::init1() {
    CHECK_ERROR_ABORT(Err, "TimeStepper not found in TimeIntegration Config");
    TimeStepperType TimeStepperChoice = getTimeStepperFromStr(TimeStepperStr);
 
+   // Fused thickness and tracer updates are optional
+   bool UseFused = false;
+   if (TimeIntConfig.existsVar("FusedUpdate")) {
+      Error ErrFused = TimeIntConfig.get("FusedUpdate", UseFused);
+      CHECK_ERROR_ABORT(ErrFused, "Error reading FusedUpdate from Config");
+   }
+
+   // Graph capture of the state update kernels is optional
+   bool UseGraph = false;
+   if (TimeIntConfig.existsVar("UpdateGraphs")) {
+      Error ErrGraph = TimeIntConfig.get("UpdateGraphs", UseGraph);
+      CHECK_ERROR_ABORT(ErrGraph, "Error reading UpdateGraphs from Config");
+   }
+
    // Initialize time step
    std::string TimeStepStr;
    Err += TimeIntConfig.get("TimeStep", TimeStepStr);
@@ -300,6 +347,39 @@ void TimeStepper::init1() {
    // pointers will be attached in phase 2 initialization
    TimeStepper::DefaultTimeStepper =
        create("Default", TimeStepperChoice, StartTime, StopTime, TimeStep);
+   TimeStepper::DefaultTimeStepper->setFusedUpdate(UseFused);
+   TimeStepper::DefaultTimeStepper->setUpdateGraphs(UseGraph);
+
+   // Adaptive time step control is optional and disabled if absent
+   if (TimeIntConfig.existsGroup("AdaptiveTimeStep")) {
+      Config AdaptConfig("AdaptiveTimeStep");
+      Error ErrAdapt = TimeIntConfig.get(AdaptConfig);
+      CHECK_ERROR_ABORT(ErrAdapt, "Error reading AdaptiveTimeStep group");
+
+      bool AdaptEnabled = false;
+      ErrAdapt += AdaptConfig.get("Enabled", AdaptEnabled);
+      CHECK_ERROR_ABORT(ErrAdapt, "AdaptiveTimeStep: Enabled not found");
+
+      if (AdaptEnabled) {
+         I4 CheckInterval;
+         R8 TargetCFLIn;
+         R8 MaxGrowthIn;
+         std::string MinStepStr;
+         std::string MaxStepStr;
+         ErrAdapt += AdaptConfig.get("CheckInterval", CheckInterval);
+         ErrAdapt += AdaptConfig.get("TargetCFL", TargetCFLIn);
+         ErrAdapt += AdaptConfig.get("MaxGrowth", MaxGrowthIn);
+         ErrAdapt += AdaptConfig.get("MinTimeStep", MinStepStr);
+         ErrAdapt += AdaptConfig.get("MaxTimeStep", MaxStepStr);
+         CHECK_ERROR_ABORT(ErrAdapt, "AdaptiveTimeStep: missing CheckInterval,"
+                                     " TargetCFL, MaxGrowth, MinTimeStep or "
+                                     "MaxTimeStep");
+         TimeInterval MinStep(MinStepStr);
+         TimeInterval MaxStep(MaxStepStr);
+         TimeStepper::DefaultTimeStepper->setAdaptiveTimeStep(
+             CheckInterval, TargetCFLIn, MaxGrowthIn, MinStep, MaxStep);
+      }
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -323,6 +403,154 @@ void TimeStepper::changeTimeStep(const TimeInterval &TimeStepIn) {
    StepClock->changeTimeStep(TimeStepIn);
 }
 
+//------------------------------------------------------------------------------
+// Select whether the fused thickness and tracer update is used
+void TimeStepper::setFusedUpdate(bool InFused) { FusedUpdate = InFused; }
+
+//------------------------------------------------------------------------------
+// Select whether the state update kernels are recorded into Kokkos graphs.
+// The RungeKutta2, Forward-Backward, LowStorageRK4 and SSPRK3 updates use
+// the graphs.
+void TimeStepper::setUpdateGraphs(bool InGraphs) {
+   UpdateGraphs = InGraphs;
+   Graphs.clear();
+
+   if (UpdateGraphs and Type != TimeStepperType::RungeKutta2 and
+       Type != TimeStepperType::ForwardBackward and
+       Type != TimeStepperType::LowStorageRK4 and
+       Type != TimeStepperType::SSPRK3)
+      LOG_WARN("TimeStepper {}: UpdateGraphs has no effect for this time "
+               "stepper",
+               Name);
+}
+
+//------------------------------------------------------------------------------
+// Enable adaptive time step control and set its parameters
+void TimeStepper::setAdaptiveTimeStep(I4 InCheckInterval, R8 InTargetCFL,
+                                      R8 InMaxGrowth,
+                                      const TimeInterval &InMin,
+                                      const TimeInterval &InMax) {
+
+   if (InCheckInterval < 1)
+      ABORT_ERROR("AdaptiveTimeStep: CheckInterval must be at least 1");
+   if (InTargetCFL <= 0.0)
+      ABORT_ERROR("AdaptiveTimeStep: TargetCFL must be positive");
+   if (InMaxGrowth < 1.0)
+      ABORT_ERROR("AdaptiveTimeStep: MaxGrowth must be at least 1");
+   if (InMin > InMax)
+      ABORT_ERROR("AdaptiveTimeStep: MinTimeStep larger than MaxTimeStep");
+
+   AdaptiveTimeStep = true;
+   CFLCheckInterval = InCheckInterval;
+   TargetCFL        = InTargetCFL;
+   MaxGrowth        = InMaxGrowth;
+   MinTimeStep      = InMin;
+   MaxTimeStep      = InMax;
+   AdaptedTimeStep  = TimeStep;
+}
+
+//------------------------------------------------------------------------------
+// Compute the maximum CFL number over owned edges and active levels. The
+// local maximum is reduced on device and then across tasks.
+R8 TimeStepper::computeMaxCFL(OceanState *State, int TimeLevel) const {
+
+   Array2DReal NormalVel;
+   I4 Err = State->getNormalVelocity(NormalVel, TimeLevel);
+   if (Err != 0)
+      ABORT_ERROR("TimeStepper computeMaxCFL: error retrieving velocity");
+
+   const auto &DcEdge    = Mesh->DcEdge;
+   const auto &EdgeMask  = Mesh->EdgeMask;
+   const int NVertLevels = NormalVel.extent_int(1);
+
+   R8 DtSeconds;
+   TimeStep.get(DtSeconds, TimeUnits::Seconds);
+
+   R8 LocalMaxCFL = 0.0;
+   parallelReduce(
+       "computeMaxCFL", {Mesh->NEdgesOwned, NVertLevels},
+       KOKKOS_LAMBDA(int IEdge, int K, R8 &Accum) {
+          const R8 CFL = EdgeMask(IEdge, K) *
+                         Kokkos::fabs(NormalVel(IEdge, K)) * DtSeconds /
+                         DcEdge(IEdge);
+          Accum        = Kokkos::max(Accum, CFL);
+       },
+       Kokkos::Max<R8>(LocalMaxCFL));
+
+   // The maximum is exact in any order, so reduce on each node first
+   R8 MaxCFL = 0.0;
+   Err       = MachEnv::getDefault()->allReduceHier(&LocalMaxCFL, &MaxCFL, 1,
+                                                    MPI_DOUBLE, MPI_MAX);
+   if (Err != MPI_SUCCESS)
+      ABORT_ERROR("TimeStepper computeMaxCFL: error in MPI_Allreduce");
+
+   return MaxCFL;
+}
+
+//------------------------------------------------------------------------------
+// Change the time step toward the target CFL number every CFLCheckInterval
+// steps. The new step is limited by MaxGrowth, clamped to the configured
+// bounds and rounded to whole seconds. On every step the step actually taken
+// is this adapted step shortened, if needed, to end exactly at the next ring
+// time of the alarms attached to the clock, which include the end alarm and
+// the stream alarms, so output and the stop time are never stepped over.
+// Once an alarm time is reached the adapted step is used again. Changing the
+// step through the clock keeps the alarms consistent.
+bool TimeStepper::adaptTimeStep(OceanState *State, I8 IStep) {
+
+   if (!AdaptiveTimeStep)
+      return false;
+
+   if (IStep % CFLCheckInterval == 0) {
+
+      // The velocity has been moved to the current time level after the
+      // step. The CFL number is computed with the step just taken, which
+      // may have been shortened for an alarm, so it is scaled to the
+      // adapted step.
+      R8 DtSeconds;
+      R8 AdaptedSeconds;
+      TimeStep.get(DtSeconds, TimeUnits::Seconds);
+      AdaptedTimeStep.get(AdaptedSeconds, TimeUnits::Seconds);
+      const R8 MaxCFL = computeMaxCFL(State, 0) * AdaptedSeconds / DtSeconds;
+
+      // A zero CFL (eg at rest) allows the largest growth
+      R8 Factor = MaxGrowth;
+      if (MaxCFL > 0.0)
+         Factor = std::clamp(TargetCFL / MaxCFL, 1.0 / MaxGrowth, MaxGrowth);
+
+      R8 MinSeconds;
+      R8 MaxSeconds;
+      MinTimeStep.get(MinSeconds, TimeUnits::Seconds);
+      MaxTimeStep.get(MaxSeconds, TimeUnits::Seconds);
+      R8 NewSeconds = std::clamp(std::floor(AdaptedSeconds * Factor),
+                                 MinSeconds, MaxSeconds);
+      NewSeconds    = std::max(NewSeconds, 1.0);
+
+      if (NewSeconds != AdaptedSeconds) {
+         AdaptedTimeStep =
+             TimeInterval(static_cast<I8>(NewSeconds), TimeUnits::Seconds);
+         LOG_INFO("TimeStepper: max CFL {} changing time step from {} to {} s",
+                  MaxCFL, AdaptedSeconds, NewSeconds);
+      }
+   }
+
+   // Land exactly on the next alarm. This may be shorter than MinTimeStep.
+   TimeInterval NewTimeStep = AdaptedTimeStep;
+   TimeInstant NextAlarmTime;
+   if (StepClock->getNextAlarmTime(NextAlarmTime)) {
+      const TimeInterval UntilAlarm =
+          NextAlarmTime - StepClock->getCurrentTime();
+      if (UntilAlarm < NewTimeStep)
+         NewTimeStep = UntilAlarm;
+   }
+
+   if (NewTimeStep == TimeStep)
+      return false;
+
+   changeTimeStep(NewTimeStep);
+   return true;
+}
+
 //------------------------------------------------------------------------------
 // Retrieval functions
 
@@ -373,6 +601,16 @@ Clock *TimeStepper::getClock() { return StepClock.get(); }
 // Get end alarm (ptr) from instance
 Alarm *TimeStepper::getEndAlarm() { return EndAlarm.get(); }
 
+// Get whether fused updates are used
+bool TimeStepper::getFusedUpdate() const { return FusedUpdate; }
+
+// Get whether the state updates are recorded into Kokkos graphs
+bool TimeStepper::getUpdateGraphs() const { return UpdateGraphs; }
+
+//------------------------------------------------------------------------------
+// Get whether adaptive time step control is enabled
+bool TimeStepper::getAdaptiveTimeStep() const { return AdaptiveTimeStep; }
+
 //------------------------------------------------------------------------------
 // Update functions
 
@@ -397,12 +635,22 @@ void TimeStepper::updateThicknessByTend(OceanState *State1, int TimeLevel1,
    R8 CoeffSeconds;
    Coeff.get(CoeffSeconds, TimeUnits::Seconds);
 
-   parallelFor(
-       "updateThickByTend", {Mesh->NCellsAll, NVertLevels},
-       KOKKOS_LAMBDA(int ICell, int K) {
-          LayerThick1(ICell, K) =
-              LayerThick2(ICell, K) + CoeffSeconds * LayerThickTend(ICell, K);
-       });
+   // Reads the old thickness and tendency and writes the new thickness
+   const R8 Bytes = 3.0 * Mesh->NCellsAll * NVertLevels * sizeof(Real);
+   TimingRegion Region("updateThickByTend", Bytes);
+
+   const GraphKey Key{"updateThickByTend",
+                      {LayerThick1.data(), LayerThick2.data(),
+                       LayerThickTend.data()}};
+   runGraph(Key, {CoeffSeconds}, [&]() {
+      const UpdateCoeff Dt = updateCoeff(0, CoeffSeconds);
+      launchUpdate(
+          "updateThickByTend", Mesh->NCellsAll, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             LayerThick1(ICell, K) =
+                 LayerThick2(ICell, K) + Dt() * LayerThickTend(ICell, K);
+          });
+   });
 }
 
 //------------------------------------------------------------------------------
@@ -426,12 +674,22 @@ void TimeStepper::updateVelocityByTend(OceanState *State1, int TimeLevel1,
    R8 CoeffSeconds;
    Coeff.get(CoeffSeconds, TimeUnits::Seconds);
 
-   parallelFor(
-       "updateVelByTend", {Mesh->NEdgesAll, NVertLevels},
-       KOKKOS_LAMBDA(int IEdge, int K) {
-          NormalVel1(IEdge, K) =
-              NormalVel2(IEdge, K) + CoeffSeconds * NormalVelTend(IEdge, K);
-       });
+   // Reads the old velocity and tendency and writes the new velocity
+   const R8 Bytes = 3.0 * Mesh->NEdgesAll * NVertLevels * sizeof(Real);
+   TimingRegion Region("updateVelByTend", Bytes);
+
+   const GraphKey Key{"updateVelByTend",
+                      {NormalVel1.data(), NormalVel2.data(),
+                       NormalVelTend.data()}};
+   runGraph(Key, {CoeffSeconds}, [&]() {
+      const UpdateCoeff Dt = updateCoeff(0, CoeffSeconds);
+      launchUpdate(
+          "updateVelByTend", Mesh->NEdgesAll, NVertLevels,
+          KOKKOS_LAMBDA(int IEdge, int K) {
+             NormalVel1(IEdge, K) =
+                 NormalVel2(IEdge, K) + Dt() * NormalVelTend(IEdge, K);
+          });
+   });
 }
 
 //------------------------------------------------------------------------------
@@ -463,6 +721,12 @@ void TimeStepper::updateTracersByTend(const Array3DReal &NextTracers,
    R8 CoeffSeconds;
    Coeff.get(CoeffSeconds, TimeUnits::Seconds);
 
+   // Reads the tracers, tendencies and both thicknesses and writes the
+   // new tracers
+   const R8 Bytes = (3.0 * NTracers + 2.0) * Mesh->NCellsAll * NVertLevels *
+                    sizeof(Real);
+   TimingRegion Region("updateTracersByTend", Bytes);
+
    parallelFor(
        "updateTracersByTend", {NTracers, Mesh->NCellsAll, NVertLevels},
        KOKKOS_LAMBDA(int L, int ICell, int K) {
@@ -473,6 +737,230 @@ void TimeStepper::updateTracersByTend(const Array3DReal &NextTracers,
        });
 }
 
+//------------------------------------------------------------------------------
+// Updates layer thickness and tracers in one sweep over cells. Each thread
+// computes the new thickness once and uses it for every tracer so the new
+// thickness array is not read back from memory.
+// LayerThickness1 = LayerThickness2 + Coeff * LayerThicknessTend
+// NextTracers     = (CurTracers * LayerThickness2 +
+//                    Coeff * TracersTend) / LayerThickness1
+void TimeStepper::updateThicknessAndTracersByTend(
+    const Array3DReal &NextTracers, const Array3DReal &CurTracers,
+    OceanState *State1, int TimeLevel1, OceanState *State2, int TimeLevel2,
+    TimeInterval Coeff) const {
+
+   Array2DReal LayerThick1;
+   Array2DReal LayerThick2;
+   I4 Err = 0;
+   Err += State1->getLayerThickness(LayerThick1, TimeLevel1);
+   Err += State2->getLayerThickness(LayerThick2, TimeLevel2);
+   if (Err != 0)
+      ABORT_ERROR("TimeStepper updateThickAndTracers: error retrieving thick");
+   const auto &LayerThickTend = Tend->LayerThicknessTend;
+   const auto &TracerTend     = Tend->TracerTend;
+   const int NTracers         = TracerTend.extent(0);
+   const int NVertLevels      = LayerThickTend.extent_int(1);
+
+   R8 CoeffSeconds;
+   Coeff.get(CoeffSeconds, TimeUnits::Seconds);
+
+   // Reads and writes as the separate thickness and tracer updates, except
+   // that the new thickness is not read back
+   const R8 Bytes = (3.0 * NTracers + 3.0) * Mesh->NCellsAll * NVertLevels *
+                    sizeof(Real);
+   TimingRegion Region("updateThickAndTracersByTend", Bytes);
+
+   const GraphKey Key{"updateThickAndTracersByTend",
+                      {LayerThick1.data(), LayerThick2.data(),
+                       NextTracers.data(), CurTracers.data(),
+                       LayerThickTend.data(), TracerTend.data()}};
+   runGraph(Key, {CoeffSeconds}, [&]() {
+      const UpdateCoeff Dt = updateCoeff(0, CoeffSeconds);
+      launchUpdate(
+          "updateThickAndTracersByTend", Mesh->NCellsAll, NVertLevels,
+          KOKKOS_LAMBDA(int ICell, int K) {
+             const R8 DtSeconds    = Dt();
+             const Real OldThick   = LayerThick2(ICell, K);
+             const Real NewThick   =
+                 OldThick + DtSeconds * LayerThickTend(ICell, K);
+             LayerThick1(ICell, K) = NewThick;
+             for (int L = 0; L < NTracers; ++L) {
+                NextTracers(L, ICell, K) =
+                    (CurTracers(L, ICell, K) * OldThick +
+                     DtSeconds * TracerTend(L, ICell, K)) /
+                    NewThick;
+             }
+          });
+   });
+}
+
+//------------------------------------------------------------------------------
+// Updates the full state and tracers, fusing the cell updates if requested
+void TimeStepper::updateStateAndTracersByTend(const Array3DReal &NextTracers,
+                                              const Array3DReal &CurTracers,
+                                              OceanState *State1,
+                                              int TimeLevel1,
+                                              OceanState *State2,
+                                              int TimeLevel2,
+                                              TimeInterval Coeff) const {
+   if (UpdateGraphs) {
+      // The fused cell update and the velocity update are independent, so
+      // they are recorded together into one graph
+      Array2DReal LayerThick1;
+      Array2DReal LayerThick2;
+      Array2DReal NormalVel1;
+      Array2DReal NormalVel2;
+      I4 Err = 0;
+      Err += State1->getLayerThickness(LayerThick1, TimeLevel1);
+      Err += State2->getLayerThickness(LayerThick2, TimeLevel2);
+      Err += State1->getNormalVelocity(NormalVel1, TimeLevel1);
+      Err += State2->getNormalVelocity(NormalVel2, TimeLevel2);
+      if (Err != 0)
+         ABORT_ERROR("TimeStepper updateStateAndTracers: error retrieving "
+                     "state");
+
+      R8 CoeffSeconds;
+      Coeff.get(CoeffSeconds, TimeUnits::Seconds);
+
+      const GraphKey Key{"updateStateAndTracersByTend",
+                         {NextTracers.data(), CurTracers.data(),
+                          LayerThick1.data(), LayerThick2.data(),
+                          NormalVel1.data(), NormalVel2.data(),
+                          Tend->LayerThicknessTend.data(),
+                          Tend->NormalVelocityTend.data(),
+                          Tend->TracerTend.data()}};
+      runGraph(Key, {CoeffSeconds}, [&]() {
+         updateThicknessAndTracersByTend(NextTracers, CurTracers, State1,
+                                         TimeLevel1, State2, TimeLevel2,
+                                         Coeff);
+         updateVelocityByTend(State1, TimeLevel1, State2, TimeLevel2, Coeff);
+      });
+   } else if (FusedUpdate) {
+      updateThicknessAndTracersByTend(NextTracers, CurTracers, State1,
+                                      TimeLevel1, State2, TimeLevel2, Coeff);
+      updateVelocityByTend(State1, TimeLevel1, State2, TimeLevel2, Coeff);
+   } else {
+      updateStateByTend(State1, TimeLevel1, State2, TimeLevel2, Coeff);
+      updateTracersByTend(NextTracers, CurTracers, State1, TimeLevel1, State2,
+                          TimeLevel2, Coeff);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Run a group of independent update kernels, recording them into a graph
+// the first time the key is seen and replaying the graph afterward. The
+// kernels launched by Segment while recording are only added to the graph.
+void TimeStepper::runGraph(const GraphKey &Key, const std::vector<R8> &Coeffs,
+                           const std::function<void()> &Segment) const {
+
+   // A nested group is part of the graph being recorded
+   if (!UpdateGraphs or Recording) {
+      Segment();
+      return;
+   }
+
+   auto It = Graphs.find(Key);
+   if (It == Graphs.end()) {
+      if (Graphs.size() >= MaxGraphs)
+         Graphs.clear();
+
+      Array1DR8 CoeffsDev("GraphCoeffs", Coeffs.size());
+      RecordValues = Coeffs;
+      RecordCoeffs = CoeffsDev;
+      GraphKernels.clear();
+      Recording = true;
+      Segment();
+      Recording = false;
+
+      auto Graph = Kokkos::Experimental::create_graph(
+          ExecSpace(), [&](const GraphRootType &Root) {
+             for (const auto &AddKernel : GraphKernels)
+                AddKernel(Root);
+          });
+      GraphKernels.clear();
+      RecordValues.clear();
+      RecordCoeffs = Array1DR8();
+
+      RecordedGraph NewGraph{std::move(Graph), CoeffsDev,
+                             createHostMirrorCopy(CoeffsDev)};
+      It = Graphs.emplace(Key, std::move(NewGraph)).first;
+   }
+
+   // The blocking copy also waits for an earlier replay of the graph that
+   // may still read the old coefficients
+   RecordedGraph &Recorded = It->second;
+   for (size_t I = 0; I < Coeffs.size(); ++I)
+      Recorded.CoeffsH(I) = Coeffs[I];
+   deepCopy(Recorded.Coeffs, Recorded.CoeffsH);
+
+   Timing::start("submitGraph");
+   Recorded.Graph.submit();
+   Timing::stop("submitGraph");
+}
+
+//------------------------------------------------------------------------------
+// Return the kernel coefficient for a value, read from the coefficients of
+// the graph while one is recorded
+TimeStepper::UpdateCoeff TimeStepper::updateCoeff(I4 Index, R8 Value) const {
+
+   if (!Recording)
+      return UpdateCoeff{Value, Array1DR8(), 0};
+
+   if (Index < 0 or Index >= static_cast<I4>(RecordValues.size()) or
+       RecordValues[Index] != Value)
+      ABORT_ERROR("TimeStepper {}: update coefficient {} is not coefficient "
+                  "{} of the graph being recorded",
+                  Name, Value, Index);
+
+   return UpdateCoeff{Value, RecordCoeffs, Index};
+}
+
+//------------------------------------------------------------------------------
+// Exchange the halos of the full prognostic state at one time level. The
+// arrays are packed into one buffer per neighbor so the exchange costs one
+// round of messages instead of one for each of thickness, velocity and the
+// tracers. The state arrays are rotated by index at the end of each step,
+// so a time level index refers to one of a few sets of arrays. Each set is
+// registered with the halo the first time it is exchanged, which sets up
+// its buffers and persistent requests once.
+void TimeStepper::exchangeStateHalos(OceanState *State,
+                                     const Array3DReal &TracerArray,
+                                     int TimeLevel) const {
+
+   Array2DReal LayerThick;
+   Array2DReal NormalVel;
+   I4 Err = 0;
+   Err += State->getLayerThickness(LayerThick, TimeLevel);
+   Err += State->getNormalVelocity(NormalVel, TimeLevel);
+   if (Err != 0)
+      ABORT_ERROR("TimeStepper exchangeStateHalos: error retrieving state");
+
+   const std::vector<const void *> Arrays{LayerThick.data(), NormalVel.data(),
+                                          TracerArray.data()};
+   auto It = StateExchanges.find(Arrays);
+   if (It == StateExchanges.end()) {
+      HaloArrayList List;
+      List.add(LayerThick, OnCell);
+      List.add(NormalVel, OnEdge);
+      List.add(TracerArray, OnCell);
+
+      const std::string ExchName =
+          Name + "State" + std::to_string(StateExchanges.size());
+      Err = MeshHalo->registerExchange(ExchName, List);
+      if (Err != 0)
+         ABORT_ERROR("TimeStepper exchangeStateHalos: error registering "
+                     "exchange {}",
+                     ExchName);
+      It = StateExchanges.emplace(Arrays, ExchName).first;
+   }
+
+   Timing::start("exchangeStateHalos");
+   Err = MeshHalo->exchangeRegistered(It->second);
+   Timing::stop("exchangeStateHalos");
+   if (Err != 0)
+      ABORT_ERROR("TimeStepper exchangeStateHalos: error in halo exchange");
+}
+
 //------------------------------------------------------------------------------
 // couple tracer array to layer thickness
 void TimeStepper::weightTracers(const Array3DReal &NextTracers,
@@ -483,6 +971,11 @@ void TimeStepper::weightTracers(const Array3DReal &NextTracers,
    const int NTracers              = NextTracers.extent(0);
    const int NVertLevels           = NextTracers.extent(2);
 
+   // Reads the tracers and thickness and writes the weighted tracers
+   const R8 Bytes = (2.0 * NTracers + 1.0) * Mesh->NCellsAll * NVertLevels *
+                    sizeof(Real);
+   TimingRegion Region("weightTracers", Bytes);
+
    parallelFor(
        "weightTracers", {NTracers, Mesh->NCellsAll, NVertLevels},
        KOKKOS_LAMBDA(int L, int ICell, int K) {
@@ -504,6 +997,11 @@ void TimeStepper::accumulateTracersUpdate(const Array3DReal &AccumTracer,
    R8 CoeffSeconds;
    Coeff.get(CoeffSeconds, TimeUnits::Seconds);
 
+   // Reads the tendencies and reads and writes the accumulated tracers
+   const R8 Bytes =
+       3.0 * NTracers * Mesh->NCellsAll * NVertLevels * sizeof(Real);
+   TimingRegion Region("accumulateTracersUpdate", Bytes);
+
    parallelFor(
        "accumulateTracersUpdate", {NTracers, Mesh->NCellsAll, NVertLevels},
        KOKKOS_LAMBDA(int L, int ICell, int K) {
@@ -521,6 +1019,11 @@ void TimeStepper::finalizeTracersUpdate(const Array3DReal &NextTracers,
    const int NTracers           = NextTracers.extent(0);
    const int NVertLevels        = NextTracers.extent(2);
 
+   // Reads the thickness and reads and writes the tracers
+   const R8 Bytes = (2.0 * NTracers + 1.0) * Mesh->NCellsAll * NVertLevels *
+                    sizeof(Real);
+   TimingRegion Region("finalizeTracersUpdate", Bytes);
+
    parallelFor(
        "finalizeTracersUpdate", {NTracers, Mesh->NCellsAll, NVertLevels},
        KOKKOS_LAMBDA(int L, int ICell, int K) {
@@ -528,4 +1031,32 @@ void TimeStepper::finalizeTracersUpdate(const Array3DReal &NextTracers,
        });
 }
 
+//------------------------------------------------------------------------------
+// Applies the implicit vertical mixing over the full time step to the
+// velocity and tracers at a time level if mixing is enabled
+void TimeStepper::applyImplicitVertMix(OceanState *State,
+                                       const Array3DReal &TracerArray,
+                                       int TimeLevel) const {
+
+   const ImplicitVertMix *VertMix = ImplicitVertMix::getDefault();
+   if (VertMix == nullptr)
+      return;
+
+   Array2DReal LayerThick;
+   Array2DReal NormalVel;
+   I4 Err = 0;
+   Err += State->getLayerThickness(LayerThick, TimeLevel);
+   Err += State->getNormalVelocity(NormalVel, TimeLevel);
+   if (Err != 0)
+      ABORT_ERROR("TimeStepper applyImplicitVertMix: error retrieving state");
+
+   R8 DtSeconds;
+   TimeStep.get(DtSeconds, TimeUnits::Seconds);
+
+   Timing::start("implicitVertMix");
+   VertMix->mixVelocity(NormalVel, LayerThick, DtSeconds);
+   VertMix->mixTracers(TracerArray, LayerThick, DtSeconds);
+   Timing::stop("implicitVertMix");
+}
+
 } // namespace OMEGA
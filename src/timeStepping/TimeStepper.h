@@ -23,11 +23,35 @@
 ///    # Default is the No Leap (Gregorian calendar with no leap years)
 ///    CalendarType: No Leap
 ///    # Algorithm to use for the dynamics time integration
-///    # Supported options are Forward-Backward (default), RungeKutta2 and
-///    # RungeKutta4
+///    # Supported options are Forward-Backward (default), RungeKutta2,
+///    # RungeKutta4, the low-storage LowStorageRK4 and SSPRK3 and the
+///    # SplitExplicit barotropic/baroclinic stepper
 ///    TimeStepper: Forward-Backward
+///    # Optionally fuse the thickness and tracer updates from tendencies into
+///    # a single sweep over cells (default false if absent)
+///    FusedUpdate: true
+///    # Optionally record the state update kernels of each stage into Kokkos
+///    # graphs that are replayed in later steps. Only the update kernels of
+///    # the RungeKutta2, Forward-Backward, LowStorageRK4 and SSPRK3 steppers
+///    # are recorded, the tendencies and halo exchanges are not (default
+///    # false if absent)
+///    UpdateGraphs: false
+///    # Number of barotropic substeps per step for SplitExplicit (default 20)
+///    BarotropicSubcycles: 20
 ///    # Time step to use, in form of DDDD_hh:mm:ss (days, hours, minutes, secs)
 ///    TimeStep: 0000_00:10:00
+///    # Optional adaptive time step control. Every CheckInterval steps the
+///    # maximum CFL number over owned edges is computed and the time step is
+///    # scaled toward TargetCFL, changing by at most a factor of MaxGrowth
+///    # and staying within [MinTimeStep, MaxTimeStep]. A step is shortened
+///    # to land exactly on the next alarm of the clock, eg an output time
+///    AdaptiveTimeStep:
+///       Enabled: false
+///       CheckInterval: 10
+///       TargetCFL: 0.5
+///       MaxGrowth: 1.1
+///       MinTimeStep: 0000_00:00:30
+///       MaxTimeStep: 0000_00:30:00
 ///    # Start time of full simulation (YYYY-MM-DD_hh:mm:ss)
 ///    StartTime: 0001-01-01_00:00:00
 ///    # Either stop time or run duration must be supplied with Duration
@@ -44,16 +68,22 @@
 
 #include "AuxiliaryState.h"
 #include "DataTypes.h"
+#include "ExecInstances.h"
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "OceanState.h"
 #include "Tendencies.h"
 #include "TimeMgr.h"
+#include "Timing.h"
 #include "Tracers.h"
 
+#include <Kokkos_Graph.hpp>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace OMEGA {
 
@@ -63,6 +93,9 @@ enum class TimeStepperType {
    ForwardBackward,
    RungeKutta4,
    RungeKutta2,
+   LowStorageRK4,
+   SSPRK3,
+   SplitExplicit,
    Invalid
 };
 
@@ -171,6 +204,51 @@ class TimeStepper {
    void changeTimeStep(const TimeInterval &TimeStepIn ///< [in] new time step
    );
 
+   /// Select whether the fused thickness and tracer update is used
+   void setFusedUpdate(bool InFused ///< [in] true to use fused updates
+   );
+
+   /// Get whether the fused thickness and tracer update is used
+   bool getFusedUpdate() const;
+
+   /// Select whether the state update kernels are recorded into Kokkos
+   /// graphs. The RungeKutta2, Forward-Backward, LowStorageRK4 and SSPRK3
+   /// updates use them, the tendency computations and halo exchanges are
+   /// never recorded.
+   void setUpdateGraphs(bool InGraphs ///< [in] true to use graphs
+   );
+
+   /// Get whether the state update kernels are recorded into Kokkos graphs
+   bool getUpdateGraphs() const;
+
+   /// Enable adaptive time step control and set its parameters
+   void setAdaptiveTimeStep(
+       I4 InCheckInterval,        ///< [in] steps between CFL checks
+       R8 InTargetCFL,            ///< [in] target maximum CFL number
+       R8 InMaxGrowth,            ///< [in] max change factor per check
+       const TimeInterval &InMin, ///< [in] minimum allowed time step
+       const TimeInterval &InMax  ///< [in] maximum allowed time step
+   );
+
+   /// Get whether adaptive time step control is enabled
+   bool getAdaptiveTimeStep() const;
+
+   /// Computes the maximum CFL number |u| dt / dcEdge over all owned edges
+   /// and active levels across all MPI tasks
+   R8 computeMaxCFL(OceanState *State, ///< [in] model state
+                    int TimeLevel      ///< [in] time level of velocity
+   ) const;
+
+   /// If adaptive time stepping is enabled and this is a check step,
+   /// computes the maximum CFL number and changes the time step toward the
+   /// target CFL within the configured bounds. On every step the next step
+   /// is shortened if needed to end exactly at the next ring time of the
+   /// alarms attached to the clock. Returns true if the time step was
+   /// changed.
+   bool adaptTimeStep(OceanState *State, ///< [in] model state
+                      I8 IStep           ///< [in] number of steps completed
+   );
+
    // these should be protected, they are public only because of CUDA
    // limitations
 
@@ -219,6 +297,44 @@ class TimeStepper {
        TimeInterval Coeff  ///< [in] time-related coeff for tendency
    ) const;
 
+   /// Updates layer thickness and tracers in a single sweep over cells,
+   /// equivalent to updateThicknessByTend followed by updateTracersByTend
+   /// but the new thickness is used directly rather than re-read
+   void updateThicknessAndTracersByTend(
+       const Array3DReal &NextTracers, ///< [out] updated tracers
+       const Array3DReal &CurTracers,  ///< [in]  current tracers
+       OceanState *State1, ///< [out] updated layer thickness in state
+       int TimeLevel1,     ///< [in] time level index for new time
+       OceanState *State2, ///< [in] state (thickness) for current time
+       int TimeLevel2,     ///< [in] time level index for current time
+       TimeInterval Coeff  ///< [in] time-related coeff for tendency
+   ) const;
+
+   /// Updates the full state and tracers using tendency terms. Uses the
+   /// fused thickness and tracer update if enabled or if graph capture is
+   /// enabled, and otherwise calls updateStateByTend and updateTracersByTend
+   void updateStateAndTracersByTend(
+       const Array3DReal &NextTracers, ///< [out] updated tracers
+       const Array3DReal &CurTracers,  ///< [in]  current tracers
+       OceanState *State1, ///< [out] updated state
+       int TimeLevel1,     ///< [in] time level index for new time
+       OceanState *State2, ///< [in] state data for current time
+       int TimeLevel2,     ///< [in] time level index for current time
+       TimeInterval Coeff  ///< [in] time-related coeff for tendency
+   ) const;
+
+   /// Exchanges the halos of the layer thickness, normal velocity and
+   /// tracers at the input time level in a single merged exchange, so that
+   /// only one message is sent to each neighbor rather than one per array.
+   /// The exchange of each set of arrays is registered with the halo on
+   /// first use. Used for intermediate stages. The end of step exchanges
+   /// are still done by the updateTimeLevels calls of the state and tracers.
+   void exchangeStateHalos(
+       OceanState *State,              ///< [inout] model state
+       const Array3DReal &TracerArray, ///< [inout] tracers at TimeLevel
+       int TimeLevel                   ///< [in] time level to exchange
+   ) const;
+
    /// couple tracer array to layer thickness
    void weightTracers(
        const Array3DReal &NextTracers, ///< [inout] tracers to modify
@@ -241,6 +357,15 @@ class TimeStepper {
        int TimeLevel                   ///< [in] time level index
    ) const;
 
+   /// Applies the implicit vertical mixing of velocity and tracers over the
+   /// time step, using the layer thickness at the same time level. Does
+   /// nothing if implicit vertical mixing is disabled.
+   void applyImplicitVertMix(
+       OceanState *State,              ///< [inout] state (velocity) to mix
+       const Array3DReal &TracerArray, ///< [inout] tracers to mix
+       int TimeLevel                   ///< [in] time level index
+   ) const;
+
  protected:
    /// Name of time stepper
    std::string Name;
@@ -260,6 +385,118 @@ class TimeStepper {
    /// Stop time
    TimeInstant StopTime;
 
+   /// Flag to fuse the thickness and tracer updates
+   bool FusedUpdate = false;
+
+   /// Flag to record the state updates into Kokkos graphs
+   bool UpdateGraphs = false;
+
+   /// Root node of a recorded graph
+   using GraphRootType = Kokkos::Experimental::GraphNodeRef<ExecSpace>;
+
+   /// Identifies a recorded graph by a name and the data pointers of all
+   /// arrays read or written by its kernels, including the tendencies. A
+   /// graph is only replayed for the same arrays it was recorded with.
+   struct GraphKey {
+      std::string Name;
+      std::vector<const void *> Data;
+
+      bool operator<(const GraphKey &Other) const {
+         return std::tie(Name, Data) < std::tie(Other.Name, Other.Data);
+      }
+   };
+
+   /// A recorded graph and the device copy of the scalar coefficients its
+   /// kernels read, which are refreshed before every replay
+   struct RecordedGraph {
+      Kokkos::Experimental::Graph<ExecSpace> Graph;
+      Array1DR8 Coeffs;
+      HostArray1DR8 CoeffsH;
+   };
+
+   /// Scalar coefficient of an update kernel, eg the time step. Kernels
+   /// launched directly use the captured value. Kernels recorded into a
+   /// graph read the coefficient of the graph in device memory instead, so
+   /// the graph is replayed unchanged when only the coefficients change.
+   struct UpdateCoeff {
+      R8 Value = 0;    ///< value for kernels launched directly
+      Array1DR8 Graph; ///< coefficients of the graph, empty outside graphs
+      I4 Index = 0;    ///< position of the coefficient in Graph
+
+      KOKKOS_INLINE_FUNCTION R8 operator()() const {
+         return Graph.extent(0) > 0 ? Graph(Index) : Value;
+      }
+   };
+
+   /// Maximum number of recorded graphs. The time levels alternate between
+   /// arrays, so each stage needs two graphs, and all graphs are dropped if
+   /// the arrays change often enough to reach this limit.
+   static constexpr size_t MaxGraphs = 64;
+
+   /// Recorded graphs
+   mutable std::map<GraphKey, RecordedGraph> Graphs;
+
+   /// Names of the registered halo exchanges of exchangeStateHalos by the
+   /// data pointers of the thickness, velocity and tracer arrays
+   mutable std::map<std::vector<const void *>, std::string> StateExchanges;
+
+   /// Kernels added to the graph being recorded
+   mutable std::vector<std::function<void(const GraphRootType &)>>
+       GraphKernels;
+
+   /// True while a graph is being recorded
+   mutable bool Recording = false;
+
+   /// Coefficients of the graph being recorded, on host and device
+   mutable std::vector<R8> RecordValues;
+   mutable Array1DR8 RecordCoeffs;
+
+   /// Runs Segment, a group of independent update kernels launched with
+   /// launchUpdate. With update graphs the kernels are recorded into a
+   /// graph the first time Key is seen and the graph is replayed afterward,
+   /// with Coeffs copied to device memory first. Otherwise, or when called
+   /// by a Segment that is being recorded, Segment is called directly.
+   void runGraph(const GraphKey &Key,                  ///< [in] graph key
+                 const std::vector<R8> &Coeffs,        ///< [in] coefficients
+                 const std::function<void()> &Segment ///< [in] kernels
+   ) const;
+
+   /// Returns the kernel coefficient for Value. While a graph is recorded,
+   /// Value must be the coefficient at Index of those passed to runGraph.
+   UpdateCoeff updateCoeff(I4 Index, ///< [in] position in the coefficients
+                           R8 Value  ///< [in] coefficient value
+   ) const;
+
+   /// Launches a kernel over cells or edges and vertical levels, or adds it
+   /// to the graph being recorded
+   template <class KernelType>
+   void launchUpdate(const std::string &Label, ///< [in] kernel label
+                     I4 NEntities,             ///< [in] cells or edges
+                     I4 NVertLevels,           ///< [in] vertical levels
+                     const KernelType &Kernel  ///< [in] kernel body
+   ) const {
+      if (!Recording) {
+         parallelFor(Label, {NEntities, NVertLevels}, Kernel);
+         return;
+      }
+      GraphKernels.push_back([=](const GraphRootType &Root) {
+         Root.then_parallel_for(
+             Label,
+             Kokkos::MDRangePolicy<ExecSpace, Kokkos::Rank<2>>(
+                 {0, 0}, {NEntities, NVertLevels}),
+             Kernel);
+      });
+   }
+
+   /// Adaptive time step control parameters
+   bool AdaptiveTimeStep = false; ///< flag to enable adaptive control
+   I4 CFLCheckInterval   = 1;     ///< steps between CFL checks
+   R8 TargetCFL          = 0.5;   ///< target maximum CFL number
+   R8 MaxGrowth          = 1.1;   ///< max change factor per check
+   TimeInterval MinTimeStep;      ///< minimum allowed time step
+   TimeInterval MaxTimeStep;      ///< maximum allowed time step
+   TimeInterval AdaptedTimeStep;  ///< step from the CFL before alarm limits
+
    /// Alarm that rings at StopTime
    std::unique_ptr<Alarm> EndAlarm;
 
@@ -0,0 +1,358 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA analysis members -------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA in-situ analysis members
+///
+/// This driver creates one analysis member of each type from Config groups
+/// built in the driver and checks the products against values computed
+/// directly from the state. The layer thickness is set to known constants so
+/// that the time means, zonal means and surface values are known exactly.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AnalysisMember.h"
+#include "AuxiliaryState.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Error.h"
+#include "Field.h"
+#include "GlobalStats.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "IOStream.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "Tendencies.h"
+#include "TimeAverage.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// The initialization routine for analysis testing. It calls the init routines
+// of all the modules the analysis members use and reads the initial state.
+int initAnalysisTest() {
+
+   int Err = 0;
+   Error Err1;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Config::readAll("omega.yml");
+
+   TimeStepper::init1();
+   TimeStepper *DefStepper = TimeStepper::getDefault();
+   Clock *ModelClock       = DefStepper->getClock();
+
+   Err = IO::init(DefComm);
+   if (Err != 0)
+      LOG_ERROR("Analysis: error initializing parallel IO");
+
+   IOStream::init(ModelClock);
+
+   Err = Field::init(ModelClock);
+   if (Err != 0) {
+      LOG_CRITICAL("Analysis: Error initializing Fields");
+      return Err;
+   }
+
+   Decomp::init();
+
+   Err = Halo::init();
+   if (Err != 0)
+      LOG_ERROR("Analysis: error initializing default halo");
+
+   HorzMesh::init();
+
+   Config *OmegaConfig = Config::getOmegaConfig();
+   Config DimConfig("Dimension");
+   Err1 += OmegaConfig->get(DimConfig);
+   I4 NVertLevels;
+   Err1 += DimConfig.get("NVertLevels", NVertLevels);
+   CHECK_ERROR_ABORT(Err1, "Analysis: NVertLevels not found in Config");
+   auto VertDim = Dimension::create("NVertLevels", NVertLevels);
+
+   Tracers::init();
+   AuxiliaryState::init();
+   Tendencies::init();
+   TimeStepper::init2();
+
+   Err = OceanState::init();
+   if (Err != 0) {
+      LOG_CRITICAL("Analysis: Error initializing default state");
+      return Err;
+   }
+
+   bool StreamsValid = IOStream::validateAll();
+   if (!StreamsValid) {
+      LOG_CRITICAL("Analysis: Error validating IO Streams");
+      return -1;
+   }
+
+   Metadata ReqMeta;
+   Err = IOStream::read("InitialState", ModelClock, ReqMeta);
+   if (Err != IOStream::Success) {
+      LOG_CRITICAL("Analysis: Error reading initial state from stream");
+      return Err;
+   }
+
+   OceanState *DefState = OceanState::getDefault();
+   DefState->exchangeHalo(0);
+   DefState->copyToHost(0);
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+// Builds the Config group of a member with a compute interval of one hour
+Config memberConfig(const std::string &Name,
+                    const std::vector<std::string> &Fields) {
+   Config MemberConfig(Name);
+   MemberConfig.add("Enabled", true);
+   MemberConfig.add("ComputeFreq", 1);
+   MemberConfig.add("ComputeFreqUnits", std::string("hours"));
+   if (!Fields.empty())
+      MemberConfig.add("Fields", Fields);
+   return MemberConfig;
+}
+
+//------------------------------------------------------------------------------
+// Counts the entries of a host array that differ from a value by more than
+// a relative tolerance
+template <class HostArray>
+int countDiffs(const HostArray &Array, I4 NRows, I4 NCols, R8 Value) {
+   int NDiffs = 0;
+   for (int I = 0; I < NRows; ++I) {
+      for (int K = 0; K < NCols; ++K) {
+         if (std::abs(Array(I, K) - Value) > 1.0e-12 * std::abs(Value))
+            ++NDiffs;
+      }
+   }
+   return NDiffs;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for analysis members
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      int Err = initAnalysisTest();
+      if (Err != 0)
+         LOG_CRITICAL("Analysis: Error initializing");
+
+      HorzMesh *Mesh          = HorzMesh::getDefault();
+      OceanState *State       = OceanState::getDefault();
+      TimeStepper *DefStepper = TimeStepper::getDefault();
+      Clock *ModelClock       = DefStepper->getClock();
+      const I4 NVertLevels    = State->NVertLevels;
+      const I4 NCellsOwned    = Mesh->NCellsOwned;
+
+      // Keep the initial thickness to compute the statistics and restore
+      Array2DReal LayerThick;
+      State->getLayerThickness(LayerThick, 0);
+      Array2DReal InitThick("InitThick", LayerThick.extent(0),
+                            LayerThick.extent(1));
+      deepCopy(InitThick, LayerThick);
+
+      // Create one member of each type
+      Config GlobalConfig = memberConfig("GlobalStats", {});
+      Config MeanConfig   = memberConfig("TestMean", {"LayerThickness"});
+      Config ZonalConfig  = memberConfig("ZonalMean", {"LayerThickness"});
+      ZonalConfig.add("NLatBins", 18);
+      Config SurfConfig = memberConfig("Surface", {"LayerThickness"});
+
+      auto *Stats = dynamic_cast<GlobalStats *>(AnalysisMember::create(
+          "GlobalStats", AnalysisType::GlobalStats, GlobalConfig, ModelClock));
+      auto *Mean = dynamic_cast<TimeAverage *>(AnalysisMember::create(
+          "TestMean", AnalysisType::TimeAverage, MeanConfig, ModelClock));
+      AnalysisMember *Zonal = AnalysisMember::create(
+          "ZonalMean", AnalysisType::ZonalMean, ZonalConfig, ModelClock);
+      AnalysisMember *Surf = AnalysisMember::create(
+          "Surface", AnalysisType::SurfaceFields, SurfConfig, ModelClock);
+
+      if (Stats and Mean and Zonal and Surf and
+          AnalysisMember::getNumMembers() == 4 and
+          FieldGroup::exists("TestMean") and
+          FieldGroup::isFieldInGroup("LayerThicknessTestMean", "TestMean")) {
+         LOG_INFO("Analysis: member creation PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: member creation FAIL");
+      }
+
+      // Duplicate names are rejected
+      if (AnalysisMember::create("Surface", AnalysisType::SurfaceFields,
+                                 SurfConfig, ModelClock) == nullptr) {
+         LOG_INFO("Analysis: duplicate member rejected PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: duplicate member rejected FAIL");
+      }
+
+      // Global statistics of the initial state against a direct sum
+      Stats->compute(State, 0);
+      R8 LocalVolume       = 0;
+      const auto &AreaCell = Mesh->AreaCell;
+      parallelReduce(
+          "refVolume", {NCellsOwned, NVertLevels},
+          KOKKOS_LAMBDA(int ICell, int K, R8 &Accum) {
+             Accum += AreaCell(ICell) * InitThick(ICell, K);
+          },
+          LocalVolume);
+      R8 RefVolume = 0;
+      MPI_Allreduce(&LocalVolume, &RefVolume, 1, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      R8 Volume = Stats->getValue("GlobalStatsVolume");
+      R8 MinH   = Stats->getValue("GlobalStatsMinThickness");
+      R8 MaxH   = Stats->getValue("GlobalStatsMaxThickness");
+      if (Volume > 0 and std::abs(Volume - RefVolume) <= 1.0e-10 * RefVolume and
+          MinH > 0 and MinH <= MaxH) {
+         LOG_INFO("Analysis: GlobalStats volume and thickness PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: GlobalStats FAIL: volume {} ref {} range {} {}",
+                   Volume, RefVolume, MinH, MaxH);
+      }
+
+      I4 NTracers     = Tracers::getNumTracers();
+      int NBadTracers = 0;
+      for (int L = 0; L < NTracers; ++L) {
+         std::string TracerName;
+         Tracers::getName(TracerName, L);
+         R8 TrMean = Stats->getValue(TracerName + "GlobalStatsMean");
+         R8 TrMin  = Stats->getValue(TracerName + "GlobalStatsMin");
+         R8 TrMax  = Stats->getValue(TracerName + "GlobalStatsMax");
+         if (TrMean < TrMin - 1.0e-12 * std::abs(TrMin) or
+             TrMean > TrMax + 1.0e-12 * std::abs(TrMax))
+            ++NBadTracers;
+      }
+      if (NBadTracers == 0) {
+         LOG_INFO("Analysis: GlobalStats tracer range PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: GlobalStats tracer range FAIL");
+      }
+
+      // Time mean of the samples 1, 2 and 3 is 2
+      for (int N = 1; N <= 3; ++N) {
+         deepCopy(LayerThick, Real(N));
+         Mean->compute(State, 0);
+      }
+      auto MeanArray =
+          Field::getFieldDataArray<Array2DReal>("LayerThicknessTestMean");
+      auto MeanH = createHostMirrorCopy(MeanArray);
+      int NDiffs = countDiffs(MeanH, MeanH.extent(0), NVertLevels, 2.0);
+      if (Mean->getNumSamples() == 3 and NDiffs == 0) {
+         LOG_INFO("Analysis: TimeAverage mean PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: TimeAverage FAIL: {} samples, {} diffs",
+                   Mean->getNumSamples(), NDiffs);
+      }
+
+      // The zonal mean of a constant is the constant in every ocean bin
+      deepCopy(LayerThick, 5.0);
+      Zonal->compute(State, 0);
+      auto ZonalH =
+          Field::getFieldDataArray<HostArray2DReal>("LayerThicknessZonalMean");
+      int NOcean = 0;
+      NDiffs     = 0;
+      for (int IBin = 0; IBin < ZonalH.extent_int(0); ++IBin) {
+         for (int K = 0; K < NVertLevels; ++K) {
+            if (ZonalH(IBin, K) > 1.0e20 or ZonalH(IBin, K) < -1.0e20)
+               continue; // empty bin with fill value
+            ++NOcean;
+            if (std::abs(ZonalH(IBin, K) - 5.0) > 1.0e-12)
+               ++NDiffs;
+         }
+      }
+      if (NOcean > 0 and NDiffs == 0) {
+         LOG_INFO("Analysis: ZonalMean constant PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: ZonalMean FAIL: {} ocean bins, {} diffs",
+                   NOcean, NDiffs);
+      }
+
+      // The surface field is the top level of the initial thickness
+      deepCopy(LayerThick, InitThick);
+      Surf->compute(State, 0);
+      auto SurfH = createHostMirrorCopy(
+          Field::getFieldDataArray<Array1DReal>("LayerThicknessSurface"));
+      auto InitH = createHostMirrorCopy(InitThick);
+      NDiffs     = 0;
+      for (int ICell = 0; ICell < SurfH.extent_int(0); ++ICell) {
+         if (SurfH(ICell) != InitH(ICell, 0))
+            ++NDiffs;
+      }
+      if (NDiffs == 0) {
+         LOG_INFO("Analysis: SurfaceFields top level PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: SurfaceFields FAIL: {} diffs", NDiffs);
+      }
+
+      // Removal of members
+      AnalysisMember::erase("Surface");
+      bool Erased = AnalysisMember::getNumMembers() == 3;
+      AnalysisMember::clear();
+      if (Erased and AnalysisMember::getNumMembers() == 0) {
+         LOG_INFO("Analysis: member removal PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("Analysis: member removal FAIL");
+      }
+
+      // Finalize Omega objects
+      OceanState::clear();
+      Tracers::clear();
+      AuxiliaryState::clear();
+      Tendencies::clear();
+      TimeStepper::clear();
+      HorzMesh::clear();
+      Halo::clear();
+      Decomp::clear();
+      MachEnv::removeAll();
+      FieldGroup::clear();
+      Field::clear();
+      Dimension::clear();
+
+      if (RetVal == 0)
+         LOG_INFO("Analysis: Successful completion");
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -11,7 +11,9 @@
 /// This driver tests the OMEGA domain decomposition, decomposing the
 /// horizontal domain and creating a number of index-space arrays for
 /// locating and describing mesh locations within a parallel distributed
-/// memory.
+/// memory. The connectivity of each decomposition is compared with a serial
+/// reference read of the mesh file, so the test can be run on any number of
+/// tasks.
 ///
 //
 //===-----------------------------------------------------------------------===/
@@ -25,7 +27,10 @@
 #include "Pacer.h"
 #include "mpi.h"
 
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <vector>
 
 using namespace OMEGA;
 
@@ -61,6 +66,247 @@ int initDecompTest() {
    return Err;
 }
 
+//------------------------------------------------------------------------------
+// Checks that all cells and edges are owned by exactly one task in the input
+// decomposition by summing the global IDs of owned cells and edges over all
+// tasks and comparing with the sum of the integers 1 to NCellsGlobal (or
+// NEdgesGlobal). Returns the number of failed checks.
+
+int checkOwnedSums(const Decomp *TestDecomp, MPI_Comm Comm,
+                   const std::string &Label) {
+
+   int NErr = 0;
+
+   I4 RefSumCells = 0;
+   I4 RefSumEdges = 0;
+   for (int n = 0; n < TestDecomp->NCellsGlobal; ++n)
+      RefSumCells += n + 1;
+   for (int n = 0; n < TestDecomp->NEdgesGlobal; ++n)
+      RefSumEdges += n + 1;
+
+   I4 LocSumCells = 0;
+   I4 LocSumEdges = 0;
+   for (int n = 0; n < TestDecomp->NCellsOwned; ++n)
+      LocSumCells += TestDecomp->CellIDH(n);
+   for (int n = 0; n < TestDecomp->NEdgesOwned; ++n)
+      LocSumEdges += TestDecomp->EdgeIDH(n);
+
+   I4 SumCells = 0;
+   I4 SumEdges = 0;
+   MPI_Allreduce(&LocSumCells, &SumCells, 1, MPI_INT32_T, MPI_SUM, Comm);
+   MPI_Allreduce(&LocSumEdges, &SumEdges, 1, MPI_INT32_T, MPI_SUM, Comm);
+
+   if (SumCells == RefSumCells && SumEdges == RefSumEdges) {
+      LOG_INFO("DecompTest: {} owned sum test PASS", Label);
+   } else {
+      ++NErr;
+      LOG_INFO("DecompTest: {} owned sum test FAIL {} {} {} {}", Label,
+               SumCells, RefSumCells, SumEdges, RefSumEdges);
+   }
+
+   return NErr;
+}
+
+//------------------------------------------------------------------------------
+// Connectivity arrays of the mesh file in their global layout. Entries are
+// the one-based global IDs stored in the file.
+
+struct MeshRef {
+   std::vector<I4> CellsOnCell;
+   std::vector<I4> EdgesOnCell;
+   std::vector<I4> VerticesOnCell;
+   std::vector<I4> CellsOnEdge;
+   std::vector<I4> VerticesOnEdge;
+   std::vector<I4> CellsOnVertex;
+   std::vector<I4> EdgesOnVertex;
+};
+
+//------------------------------------------------------------------------------
+// Reads a connectivity array from the mesh file into its full global layout
+// on every task. Each task reads a block of the array and the blocks are
+// gathered to all tasks, so the reference does not depend on the
+// redistribution of the arrays in Decomp.
+
+std::vector<I4> readGlobalArray(int FileID, const std::string &VarName,
+                                const std::string &VarNameOld, I4 NGlobal,
+                                I4 NPerEntry, MPI_Comm Comm) {
+
+   int MyTask;
+   int NumTasks;
+   MPI_Comm_rank(Comm, &MyTask);
+   MPI_Comm_size(Comm, &NumTasks);
+
+   I4 NChunk    = (NGlobal - 1) / NumTasks + 1;
+   I4 ChunkSize = NChunk * NPerEntry;
+   std::vector<I4> Offset(ChunkSize, -1);
+   for (int N = 0; N < NChunk; ++N) {
+      I4 GlobAdd = MyTask * NChunk + N;
+      if (GlobAdd >= NGlobal)
+         break;
+      for (int J = 0; J < NPerEntry; ++J)
+         Offset[N * NPerEntry + J] = GlobAdd * NPerEntry + J;
+   }
+
+   int DecompID;
+   std::vector<I4> Dims{NGlobal, NPerEntry};
+   int Err = IO::createDecomp(DecompID, IO::IOTypeI4, 2, Dims, ChunkSize,
+                              Offset, IO::RearrBox);
+   if (Err != 0)
+      LOG_ERROR("DecompTest: error creating decomposition for {}", VarName);
+
+   std::vector<I4> Chunk(ChunkSize, 0);
+   int VarID;
+   Err = IO::readArray(Chunk.data(), ChunkSize, VarName, FileID, DecompID,
+                       VarID);
+   if (Err != 0) { // not found, try again under older name
+      Err = IO::readArray(Chunk.data(), ChunkSize, VarNameOld, FileID,
+                          DecompID, VarID);
+      if (Err != 0)
+         LOG_ERROR("DecompTest: error reading {}", VarName);
+   }
+   IO::destroyDecomp(DecompID);
+
+   std::vector<I4> Global(ChunkSize * NumTasks);
+   MPI_Allgather(Chunk.data(), ChunkSize, MPI_INT32_T, Global.data(),
+                 ChunkSize, MPI_INT32_T, Comm);
+   Global.resize(NGlobal * NPerEntry);
+
+   return Global;
+}
+
+//------------------------------------------------------------------------------
+// Reads the serial reference of the connectivity arrays of a decomposition's
+// mesh file
+
+MeshRef readMeshRef(const Decomp *TestDecomp, MPI_Comm Comm) {
+
+   int FileID;
+   int Err = IO::openFile(FileID, TestDecomp->MeshFileName, IO::ModeRead);
+   if (Err != 0)
+      LOG_ERROR("DecompTest: error opening mesh file");
+
+   const I4 NCells    = TestDecomp->NCellsGlobal;
+   const I4 NEdges    = TestDecomp->NEdgesGlobal;
+   const I4 NVertices = TestDecomp->NVerticesGlobal;
+   const I4 MaxEdges  = TestDecomp->MaxEdges;
+   const I4 NOnEdge   = TestDecomp->MaxCellsOnEdge;
+   const I4 Degree    = TestDecomp->VertexDegree;
+
+   MeshRef Ref;
+   Ref.CellsOnCell    = readGlobalArray(FileID, "CellsOnCell", "cellsOnCell",
+                                        NCells, MaxEdges, Comm);
+   Ref.EdgesOnCell    = readGlobalArray(FileID, "EdgesOnCell", "edgesOnCell",
+                                        NCells, MaxEdges, Comm);
+   Ref.VerticesOnCell = readGlobalArray(FileID, "VerticesOnCell",
+                                        "verticesOnCell", NCells, MaxEdges,
+                                        Comm);
+   Ref.CellsOnEdge    = readGlobalArray(FileID, "CellsOnEdge", "cellsOnEdge",
+                                        NEdges, NOnEdge, Comm);
+   Ref.VerticesOnEdge = readGlobalArray(FileID, "VerticesOnEdge",
+                                        "verticesOnEdge", NEdges, 2, Comm);
+   Ref.CellsOnVertex  = readGlobalArray(FileID, "CellsOnVertex",
+                                        "cellsOnVertex", NVertices, Degree,
+                                        Comm);
+   Ref.EdgesOnVertex  = readGlobalArray(FileID, "EdgesOnVertex",
+                                        "edgesOnVertex", NVertices, Degree,
+                                        Comm);
+
+   IO::closeFile(FileID);
+
+   return Ref;
+}
+
+//------------------------------------------------------------------------------
+// Checks a connectivity entry, the local address of a neighbor, against the
+// global ID in the reference. A reference entry outside the valid range of
+// IDs must map to the boundary address NAll.
+
+bool matchEntry(I4 LocalAdd, const HostArray1DI4 &IDH, I4 NAll, I4 RefID,
+                I4 NGlobal) {
+   if (RefID < 1 || RefID > NGlobal)
+      return LocalAdd == NAll;
+   return LocalAdd >= 0 && LocalAdd < NAll && IDH(LocalAdd) == RefID;
+}
+
+//------------------------------------------------------------------------------
+// Checks the connectivity of all owned cells, edges and vertices of a
+// decomposition against the serial reference. Active edges of each cell are
+// stored first in EdgesOnCell, so they are compared with the valid reference
+// entries in order. Returns the number of failed checks.
+
+int checkConnectivity(const Decomp *TestDecomp, const MeshRef &Ref,
+                      MPI_Comm Comm, const std::string &Label) {
+
+   const Decomp *D   = TestDecomp;
+   const I4 MaxEdges = D->MaxEdges;
+   const I4 NOnEdge  = D->MaxCellsOnEdge;
+   const I4 Degree   = D->VertexDegree;
+   I4 LocErr         = 0;
+
+   for (int Cell = 0; Cell < D->NCellsOwned; ++Cell) {
+      I4 RefAdd    = (D->CellIDH(Cell) - 1) * MaxEdges;
+      I4 EdgeCount = 0;
+      for (int J = 0; J < MaxEdges; ++J) {
+         if (!matchEntry(D->CellsOnCellH(Cell, J), D->CellIDH, D->NCellsAll,
+                         Ref.CellsOnCell[RefAdd + J], D->NCellsGlobal))
+            ++LocErr;
+         if (!matchEntry(D->VerticesOnCellH(Cell, J), D->VertexIDH,
+                         D->NVerticesAll, Ref.VerticesOnCell[RefAdd + J],
+                         D->NVerticesGlobal))
+            ++LocErr;
+         I4 RefEdge = Ref.EdgesOnCell[RefAdd + J];
+         if (RefEdge >= 1 && RefEdge <= D->NEdgesGlobal) {
+            if (!matchEntry(D->EdgesOnCellH(Cell, EdgeCount), D->EdgeIDH,
+                            D->NEdgesAll, RefEdge, D->NEdgesGlobal))
+               ++LocErr;
+            ++EdgeCount;
+         }
+      }
+      if (D->NEdgesOnCellH(Cell) != EdgeCount)
+         ++LocErr;
+   }
+
+   for (int Edge = 0; Edge < D->NEdgesOwned; ++Edge) {
+      I4 EdgeID = D->EdgeIDH(Edge);
+      for (int J = 0; J < NOnEdge; ++J) {
+         if (!matchEntry(D->CellsOnEdgeH(Edge, J), D->CellIDH, D->NCellsAll,
+                         Ref.CellsOnEdge[(EdgeID - 1) * NOnEdge + J],
+                         D->NCellsGlobal))
+            ++LocErr;
+      }
+      for (int J = 0; J < 2; ++J) {
+         if (!matchEntry(D->VerticesOnEdgeH(Edge, J), D->VertexIDH,
+                         D->NVerticesAll,
+                         Ref.VerticesOnEdge[(EdgeID - 1) * 2 + J],
+                         D->NVerticesGlobal))
+            ++LocErr;
+      }
+   }
+
+   for (int Vrtx = 0; Vrtx < D->NVerticesOwned; ++Vrtx) {
+      I4 RefAdd = (D->VertexIDH(Vrtx) - 1) * Degree;
+      for (int J = 0; J < Degree; ++J) {
+         if (!matchEntry(D->CellsOnVertexH(Vrtx, J), D->CellIDH, D->NCellsAll,
+                         Ref.CellsOnVertex[RefAdd + J], D->NCellsGlobal))
+            ++LocErr;
+         if (D->hasEdgesOnVertex() &&
+             !matchEntry(D->EdgesOnVertexH(Vrtx, J), D->EdgeIDH, D->NEdgesAll,
+                         Ref.EdgesOnVertex[RefAdd + J], D->NEdgesGlobal))
+            ++LocErr;
+      }
+   }
+
+   I4 NErr = 0;
+   MPI_Allreduce(&LocErr, &NErr, 1, MPI_INT32_T, MPI_SUM, Comm);
+
+   if (NErr == 0) {
+      LOG_INFO("DecompTest: {} connectivity test PASS", Label);
+      return 0;
+   }
+   LOG_INFO("DecompTest: {} connectivity test FAIL {}", Label, NErr);
+   return 1;
+}
+
 //------------------------------------------------------------------------------
 // The test driver for Decomp. This tests the decomposition of a sample
 // horizontal domain and verifies the mesh is decomposed correctly.
@@ -152,6 +398,217 @@ int main(int argc, char *argv[]) {
                   RefSumVertices);
       }
 
+      // Test the connectivity of each decomposition against a serial
+      // reference read of the mesh file. The reference does not depend on
+      // the number of tasks, so the test must pass on any task count.
+      const MeshRef Ref = readMeshRef(DefDecomp, Comm);
+      RetVal += checkConnectivity(DefDecomp, Ref, Comm, "Default");
+
+      // Test that the interior and boundary lists partition the owned
+      // cells and edges and that no halo cell can be reached from an
+      // interior cell in InteriorWidth steps across cell neighbors
+      I4 IntErr = 0;
+      if (DefDecomp->NCellsInterior + DefDecomp->NCellsBoundary !=
+          DefDecomp->NCellsOwned)
+         ++IntErr;
+      if (DefDecomp->NEdgesInterior + DefDecomp->NEdgesBoundary !=
+          DefDecomp->NEdgesOwned)
+         ++IntErr;
+      for (int n = 0; n < DefDecomp->NCellsInterior; ++n) {
+         std::vector<I4> Reached = {DefDecomp->CellsInteriorH(n)};
+         for (int Layer = 0; Layer < DefDecomp->InteriorWidth; ++Layer) {
+            std::vector<I4> Next;
+            for (I4 Cell : Reached) {
+               for (int J = 0; J < DefDecomp->NEdgesOnCellH(Cell); ++J) {
+                  I4 NbrCell = DefDecomp->CellsOnCellH(Cell, J);
+                  if (NbrCell >= DefDecomp->NCellsAll)
+                     continue;
+                  if (NbrCell >= DefDecomp->NCellsOwned)
+                     ++IntErr;
+                  else
+                     Next.push_back(NbrCell);
+               }
+            }
+            Reached.swap(Next);
+         }
+      }
+      if (IntErr == 0) {
+         LOG_INFO("DecompTest: Interior/boundary lists test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: Interior/boundary lists test FAIL");
+      }
+
+      // Test a decomposition of the same mesh with the distributed
+      // ParMetis partitioning, which must also produce a complete partition
+      // with the same global sizes
+      Decomp *ParDecomp =
+          Decomp::create("ParMetis", DefEnv, NumTasks, PartMethodParMetisKWay,
+                         DefDecomp->HaloWidth, DefDecomp->MeshFileName);
+      if (ParDecomp->NCellsGlobal != DefDecomp->NCellsGlobal ||
+          ParDecomp->NCellsAll < ParDecomp->NCellsOwned) {
+         RetVal += 1;
+         LOG_INFO("DecompTest: ParMetis decomp sizes FAIL");
+      }
+      RetVal += checkOwnedSums(ParDecomp, Comm, "ParMetis");
+      RetVal += checkConnectivity(ParDecomp, Ref, Comm, "ParMetis");
+
+      // Test the space-filling curve partition, which should also assign
+      // nearly equal numbers of cells to each task
+      Decomp *SFCDecomp =
+          Decomp::create("SFC", DefEnv, NumTasks, PartMethodHilbertSFC,
+                         DefDecomp->HaloWidth, DefDecomp->MeshFileName);
+      RetVal += checkOwnedSums(SFCDecomp, Comm, "HilbertSFC");
+      RetVal += checkConnectivity(SFCDecomp, Ref, Comm, "HilbertSFC");
+      I4 MinOwned = 0;
+      I4 MaxOwned = 0;
+      MPI_Allreduce(&SFCDecomp->NCellsOwned, &MinOwned, 1, MPI_INT32_T,
+                    MPI_MIN, Comm);
+      MPI_Allreduce(&SFCDecomp->NCellsOwned, &MaxOwned, 1, MPI_INT32_T,
+                    MPI_MAX, Comm);
+      if (MaxOwned - MinOwned <= 1) {
+         LOG_INFO("DecompTest: HilbertSFC balance test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: HilbertSFC balance test FAIL {} {}", MinOwned,
+                  MaxOwned);
+      }
+
+      // Test the reverse Cuthill-McKee local ordering. The partition is
+      // unchanged so the owned and halo sizes must match the default decomp
+      // and owned cells must be at their new local address.
+      Decomp *RCMDecomp = Decomp::create(
+          "RCM", DefEnv, NumTasks, PartMethodMetisKWay,
+          DefDecomp->HaloWidth, DefDecomp->MeshFileName, LocalOrderRCM);
+      RetVal += checkOwnedSums(RCMDecomp, Comm, "RCM");
+      RetVal += checkConnectivity(RCMDecomp, Ref, Comm, "RCM");
+      I4 RCMErr = 0;
+      if (RCMDecomp->NCellsOwned != DefDecomp->NCellsOwned ||
+          RCMDecomp->NCellsAll != DefDecomp->NCellsAll ||
+          RCMDecomp->NEdgesOwned != DefDecomp->NEdgesOwned)
+         ++RCMErr;
+      for (int Cell = 0; Cell < RCMDecomp->NCellsOwned; ++Cell) {
+         if (RCMDecomp->CellLocH(Cell, 0) != MyTask ||
+             RCMDecomp->CellLocH(Cell, 1) != Cell)
+            ++RCMErr;
+      }
+      if (RCMErr == 0) {
+         LOG_INFO("DecompTest: RCM local order test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: RCM local order test FAIL");
+      }
+
+      // Test partitions weighted by the number of active levels, with a
+      // multi-constraint METIS partition and a weighted SFC partition
+      Decomp *WgtDecomp = Decomp::create(
+          "Weighted", DefEnv, NumTasks, PartMethodMetisKWay,
+          DefDecomp->HaloWidth, DefDecomp->MeshFileName, LocalOrderGlobalID,
+          PartWeightLevelsEdges);
+      RetVal += checkOwnedSums(WgtDecomp, Comm, "Weighted MetisKWay");
+      Decomp *WgtSFCDecomp = Decomp::create(
+          "WeightedSFC", DefEnv, NumTasks, PartMethodHilbertSFC,
+          DefDecomp->HaloWidth, DefDecomp->MeshFileName, LocalOrderGlobalID,
+          PartWeightLevels);
+      RetVal += checkOwnedSums(WgtSFCDecomp, Comm, "Weighted HilbertSFC");
+      RetVal += checkConnectivity(WgtDecomp, Ref, Comm, "Weighted MetisKWay");
+      RetVal +=
+          checkConnectivity(WgtSFCDecomp, Ref, Comm, "Weighted HilbertSFC");
+
+      // Test the deferred read of EdgesOnEdge and EdgesOnVertex. The
+      // partition matches the default decomp so the arrays must be
+      // identical once loaded.
+      Decomp *LazyDecomp = Decomp::create(
+          "Lazy", DefEnv, NumTasks, PartMethodMetisKWay, DefDecomp->HaloWidth,
+          DefDecomp->MeshFileName, LocalOrderGlobalID, PartWeightNone, true);
+      I4 LazyErr = 0;
+      if (LazyDecomp->hasEdgesOnEdge() || LazyDecomp->hasEdgesOnVertex())
+         ++LazyErr;
+      Err = LazyDecomp->loadDeferred();
+      if (Err != 0 || !LazyDecomp->hasEdgesOnEdge() ||
+          !LazyDecomp->hasEdgesOnVertex() ||
+          LazyDecomp->NEdgesAll != DefDecomp->NEdgesAll ||
+          LazyDecomp->NVerticesAll != DefDecomp->NVerticesAll)
+         ++LazyErr;
+      for (int Edge = 0; Edge < DefDecomp->NEdgesSize && LazyErr == 0;
+           ++Edge) {
+         if (LazyDecomp->NEdgesOnEdgeH(Edge) != DefDecomp->NEdgesOnEdgeH(Edge))
+            ++LazyErr;
+         for (int NbrEdge = 0; NbrEdge < 2 * DefDecomp->MaxEdges; ++NbrEdge) {
+            if (LazyDecomp->EdgesOnEdgeH(Edge, NbrEdge) !=
+                DefDecomp->EdgesOnEdgeH(Edge, NbrEdge))
+               ++LazyErr;
+         }
+      }
+      for (int Vrtx = 0; Vrtx < DefDecomp->NVerticesSize && LazyErr == 0;
+           ++Vrtx) {
+         for (int Edge = 0; Edge < DefDecomp->VertexDegree; ++Edge) {
+            if (LazyDecomp->EdgesOnVertexH(Vrtx, Edge) !=
+                DefDecomp->EdgesOnVertexH(Vrtx, Edge))
+               ++LazyErr;
+         }
+      }
+      if (LazyErr == 0) {
+         LOG_INFO("DecompTest: Lazy connectivity read test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: Lazy connectivity read test FAIL");
+      }
+      RetVal += checkConnectivity(LazyDecomp, Ref, Comm, "Lazy");
+
+      // Test the partition cache. The first decomp writes the cache, the
+      // second must read an identical decomposition from it and a decomp
+      // with a different local order must not use it.
+      const std::string CacheFile = "DecompTestCache.bin";
+      if (MyTask == 0)
+         std::remove(CacheFile.c_str());
+      MPI_Barrier(Comm);
+      Decomp *CacheWrite = Decomp::create(
+          "CacheWrite", DefEnv, NumTasks, PartMethodMetisKWay,
+          DefDecomp->HaloWidth, DefDecomp->MeshFileName, LocalOrderRCM,
+          PartWeightNone, false, CacheFile);
+      Decomp *CacheRead = Decomp::create(
+          "CacheRead", DefEnv, NumTasks, PartMethodMetisKWay,
+          DefDecomp->HaloWidth, DefDecomp->MeshFileName, LocalOrderRCM,
+          PartWeightNone, false, CacheFile);
+      Decomp *CacheOther = Decomp::create(
+          "CacheOther", DefEnv, NumTasks, PartMethodMetisKWay,
+          DefDecomp->HaloWidth, DefDecomp->MeshFileName, LocalOrderGlobalID,
+          PartWeightNone, false, CacheFile);
+      I4 CacheErr = 0;
+      if (CacheWrite->CacheLoaded || !CacheRead->CacheLoaded ||
+          CacheOther->CacheLoaded)
+         ++CacheErr;
+      if (CacheRead->NCellsAll != CacheWrite->NCellsAll ||
+          CacheRead->NEdgesAll != CacheWrite->NEdgesAll ||
+          CacheRead->NVerticesAll != CacheWrite->NVerticesAll)
+         ++CacheErr;
+      for (int Cell = 0; Cell < CacheWrite->NCellsAll && CacheErr == 0;
+           ++Cell) {
+         if (CacheRead->CellIDH(Cell) != CacheWrite->CellIDH(Cell) ||
+             CacheRead->CellLocH(Cell, 0) != CacheWrite->CellLocH(Cell, 0) ||
+             CacheRead->CellLocH(Cell, 1) != CacheWrite->CellLocH(Cell, 1))
+            ++CacheErr;
+         for (int J = 0; J < CacheWrite->MaxEdges; ++J) {
+            if (CacheRead->CellsOnCellH(Cell, J) !=
+                CacheWrite->CellsOnCellH(Cell, J))
+               ++CacheErr;
+         }
+      }
+      for (int Edge = 0; Edge < CacheWrite->NEdgesAll && CacheErr == 0;
+           ++Edge) {
+         if (CacheRead->EdgeIDH(Edge) != CacheWrite->EdgeIDH(Edge))
+            ++CacheErr;
+      }
+      if (CacheErr == 0) {
+         LOG_INFO("DecompTest: partition cache test PASS");
+      } else {
+         RetVal += 1;
+         LOG_INFO("DecompTest: partition cache test FAIL");
+      }
+      if (MyTask == 0)
+         std::remove(CacheFile.c_str());
+
       // Clean up
       Decomp::clear();
       MachEnv::removeAll();
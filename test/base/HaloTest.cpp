@@ -104,6 +104,50 @@ int haloExchangeTest(
 
 } // end haloExchangeTest
 
+//------------------------------------------------------------------------------
+// This function template compares an array that has been exchanged as part of
+// an aggregated HaloArrayList exchange with the array containing the expected
+// values in all owned and halo elements. An error code is returned if any
+// elements differ.
+
+template <typename T>
+int checkListArray(
+    T InitArray,      /// Array initialized based on global IDs of elements
+    T TestArray,      /// Array after the aggregated halo exchange
+    const char *Label /// Unique label for test
+) {
+
+   I4 IErr = 0; // error code
+
+   auto TestArrayH = createHostMirrorCopy(TestArray);
+   auto InitArrayH = createHostMirrorCopy(InitArray);
+
+   // Collapse arrays to 1D for easy iteration
+   Kokkos::View<typename T::value_type *, typename T::array_layout,
+                HostMemSpace>
+       CollapsedInit(InitArrayH.data(), InitArrayH.size());
+   Kokkos::View<typename T::value_type *, typename T::array_layout,
+                HostMemSpace>
+       CollapsedTest(TestArrayH.data(), TestArrayH.size());
+
+   I4 NTot = InitArray.size();
+   for (int N = 0; N < NTot; ++N) {
+      if (CollapsedInit(N) != CollapsedTest(N)) {
+         IErr = 1;
+         break;
+      }
+   }
+
+   if (IErr == 0) {
+      LOG_INFO("HaloTest: {} list exchange test PASS", Label);
+   } else {
+      LOG_INFO("HaloTest: {} list exchange test FAIL", Label);
+   }
+
+   return IErr;
+
+} // end checkListArray
+
 //------------------------------------------------------------------------------
 // Initialization routine for Halo tests. Calls all the init routines needed
 // to create the default Halo.
@@ -578,6 +622,229 @@ int main(int argc, char *argv[]) {
       TotErr += haloExchangeTest(DefHalo, Init5DR4, Test5DR4, "5DR4");
       TotErr += haloExchangeTest(DefHalo, Init5DR8, Test5DR8, "5DR8");
 
+      // Test an aggregated exchange of device arrays of mixed type, rank,
+      // and index space, which are all sent in one message per neighbor.
+      // Reset the halo elements of the test arrays before the exchange.
+      deepCopy(Test1DI4EdgeH, Init1DI4EdgeH);
+      for (int IEdge = DefDecomp->NEdgesOwned; IEdge < DefDecomp->NEdgesAll;
+           ++IEdge) {
+         Test1DI4EdgeH(IEdge) = -1;
+      }
+      deepCopy(Test1DI4VertexH, Init1DI4VertexH);
+      for (int IVertex = DefDecomp->NVerticesOwned;
+           IVertex < DefDecomp->NVerticesAll; ++IVertex) {
+         Test1DI4VertexH(IVertex) = -1;
+      }
+      deepCopy(Test2DR8H, Init2DR8H);
+      deepCopy(Test3DR4H, Init3DR4H);
+      deepCopy(Test5DI8H, Init5DI8H);
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int J = 0; J < N2; ++J) {
+            Test2DR8H(ICell, J) = -1;
+            for (int K = 0; K < N3; ++K) {
+               Test3DR4H(K, ICell, J) = -1;
+               for (int L = 0; L < N4; ++L) {
+                  for (int M = 0; M < N5; ++M) {
+                     Test5DI8H(M, L, K, ICell, J) = -1;
+                  }
+               }
+            }
+         }
+      }
+      deepCopy(Test1DI4Edge, Test1DI4EdgeH);
+      deepCopy(Test1DI4Vertex, Test1DI4VertexH);
+      deepCopy(Test2DR8, Test2DR8H);
+      deepCopy(Test3DR4, Test3DR4H);
+      deepCopy(Test5DI8, Test5DI8H);
+
+      HaloArrayList DevList;
+      DevList.add(Test1DI4Edge, OnEdge);
+      DevList.add(Test2DR8, OnCell);
+      DevList.add(Test1DI4Vertex, OnVertex);
+      DevList.add(Test3DR4, OnCell);
+      DevList.add(Test5DI8, OnCell);
+
+      IErr = DefHalo->exchangeArrayHalos(DevList);
+      if (IErr != 0) {
+         LOG_ERROR("HaloTest: Error during device list halo exchange");
+         ++TotErr;
+      }
+
+      TotErr += checkListArray(Init1DI4Edge, Test1DI4Edge, "1DI4Edge");
+      TotErr += checkListArray(Init2DR8, Test2DR8, "2DR8");
+      TotErr += checkListArray(Init1DI4Vertex, Test1DI4Vertex, "1DI4Vertex");
+      TotErr += checkListArray(Init3DR4, Test3DR4, "3DR4");
+      TotErr += checkListArray(Init5DI8, Test5DI8, "5DI8");
+
+      // Repeat the aggregated exchange test with host arrays
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         Test1DR8H(ICell) = -1;
+         for (int J = 0; J < N2; ++J) {
+            for (int K = 0; K < N3; ++K) {
+               for (int L = 0; L < N4; ++L) {
+                  Test4DI4H(L, K, ICell, J) = -1;
+               }
+            }
+         }
+      }
+
+      HaloArrayList HostList;
+      HostList.add(Test1DR8H, OnCell);
+      HostList.add(Test1DI4EdgeH, OnEdge);
+      HostList.add(Test4DI4H, OnCell);
+
+      IErr = DefHalo->exchangeArrayHalos(HostList);
+      if (IErr != 0) {
+         LOG_ERROR("HaloTest: Error during host list halo exchange");
+         ++TotErr;
+      }
+
+      TotErr += checkListArray(Init1DR8H, Test1DR8H, "1DR8H");
+      TotErr += checkListArray(Init1DI4EdgeH, Test1DI4EdgeH, "1DI4EdgeH");
+      TotErr += checkListArray(Init4DI4H, Test4DI4H, "4DI4H");
+
+      // Test a split-phase exchange. The owned elements are not modified
+      // between the start and finish of the exchange, and the exchange is
+      // progressed with testExchange while it is in flight.
+      deepCopy(Test2DR8H, Init2DR8H);
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int J = 0; J < N2; ++J) {
+            Test2DR8H(ICell, J) = -1;
+         }
+      }
+      deepCopy(Test2DR8, Test2DR8H);
+
+      HaloArrayList SplitList;
+      SplitList.add(Test2DR8, OnCell);
+
+      HaloExchangeHandle Handle = DefHalo->startExchange(SplitList);
+      if (!Handle.isActive()) {
+         LOG_ERROR("HaloTest: split-phase exchange failed to start");
+         ++TotErr;
+      }
+      DefHalo->testExchange(Handle);
+
+      // An exchange cannot be registered while the exchange is in progress
+      IErr = DefHalo->registerExchange("ActiveTest", SplitList);
+      if (IErr == 0) {
+         LOG_ERROR("HaloTest: registered an exchange during an active "
+                   "exchange");
+         DefHalo->unregisterExchange("ActiveTest");
+         ++TotErr;
+      }
+
+      IErr = DefHalo->finishExchange(Handle);
+      if (IErr != 0 || Handle.isActive()) {
+         LOG_ERROR("HaloTest: Error during split-phase halo exchange");
+         ++TotErr;
+      }
+      TotErr += checkListArray(Init2DR8, Test2DR8, "Split 2DR8");
+
+      // Test a registered exchange with persistent requests. The exchange
+      // is repeated to check that the buffers and requests can be reused.
+      HaloArrayList RegList;
+      RegList.add(Test2DR8, OnCell);
+      RegList.add(Test1DI4Edge, OnEdge);
+
+      IErr = DefHalo->registerExchange("RegTest", RegList);
+      if (IErr != 0) {
+         LOG_ERROR("HaloTest: Error registering exchange");
+         ++TotErr;
+      }
+
+      for (int IRep = 0; IRep < 2; ++IRep) {
+         deepCopy(Test2DR8H, Init2DR8H);
+         deepCopy(Test1DI4EdgeH, Init1DI4EdgeH);
+         for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+            for (int J = 0; J < N2; ++J) {
+               Test2DR8H(ICell, J) = -1;
+            }
+         }
+         for (int IEdge = DefDecomp->NEdgesOwned;
+              IEdge < DefDecomp->NEdgesAll; ++IEdge) {
+            Test1DI4EdgeH(IEdge) = -1;
+         }
+         deepCopy(Test2DR8, Test2DR8H);
+         deepCopy(Test1DI4Edge, Test1DI4EdgeH);
+
+         IErr = DefHalo->exchangeRegistered("RegTest");
+         if (IErr != 0) {
+            LOG_ERROR("HaloTest: Error during registered halo exchange");
+            ++TotErr;
+         }
+         TotErr += checkListArray(Init2DR8, Test2DR8, "Registered 2DR8");
+         TotErr +=
+             checkListArray(Init1DI4Edge, Test1DI4Edge, "Registered 1DI4Edge");
+      }
+
+      DefHalo->unregisterExchange("RegTest");
+
+      // Test the exchange of device arrays staged through host memory by
+      // creating a Halo that does not pass device buffers to MPI. Both the
+      // standard and registered exchanges are checked.
+      Halo::setMPIOnDevice(false);
+      Halo *StagedHalo =
+          Halo::create("Staged", MachEnv::getDefault(), DefDecomp);
+
+      IErr = StagedHalo->registerExchange("StagedReg", RegList);
+      if (IErr != 0) {
+         LOG_ERROR("HaloTest: Error registering staged exchange");
+         ++TotErr;
+      }
+
+      for (int IRep = 0; IRep < 2; ++IRep) {
+         deepCopy(Test2DR8H, Init2DR8H);
+         deepCopy(Test1DI4EdgeH, Init1DI4EdgeH);
+         for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+            for (int J = 0; J < N2; ++J) {
+               Test2DR8H(ICell, J) = -1;
+            }
+         }
+         for (int IEdge = DefDecomp->NEdgesOwned;
+              IEdge < DefDecomp->NEdgesAll; ++IEdge) {
+            Test1DI4EdgeH(IEdge) = -1;
+         }
+         deepCopy(Test2DR8, Test2DR8H);
+         deepCopy(Test1DI4Edge, Test1DI4EdgeH);
+
+         if (IRep == 0) {
+            IErr = StagedHalo->exchangeArrayHalos(RegList);
+         } else {
+            IErr = StagedHalo->exchangeRegistered("StagedReg");
+         }
+         if (IErr != 0) {
+            LOG_ERROR("HaloTest: Error during staged halo exchange");
+            ++TotErr;
+         }
+         TotErr += checkListArray(Init2DR8, Test2DR8, "Staged 2DR8");
+         TotErr +=
+             checkListArray(Init1DI4Edge, Test1DI4Edge, "Staged 1DI4Edge");
+      }
+
+      // Test a staged split-phase exchange progressed with testExchange
+      // until every message has arrived. The messages are unpacked by
+      // testExchange, so the halos are checked before finishExchange.
+      deepCopy(Test2DR8H, Init2DR8H);
+      for (int ICell = NumOwned; ICell < NumAll; ++ICell) {
+         for (int J = 0; J < N2; ++J) {
+            Test2DR8H(ICell, J) = -1;
+         }
+      }
+      deepCopy(Test2DR8, Test2DR8H);
+
+      HaloExchangeHandle StagedHandle = StagedHalo->startExchange(SplitList);
+      while (!StagedHalo->testExchange(StagedHandle)) {
+      }
+      TotErr += checkListArray(Init2DR8, Test2DR8, "Staged test 2DR8");
+      IErr = StagedHalo->finishExchange(StagedHandle);
+      if (IErr != 0 || StagedHandle.isActive()) {
+         LOG_ERROR("HaloTest: Error during staged split-phase exchange");
+         ++TotErr;
+      }
+      TotErr += checkListArray(Init2DR8, Test2DR8, "Staged finish 2DR8");
+
+      StagedHalo->unregisterExchange("StagedReg");
+
       // Memory clean up
       Halo::clear();
       Decomp::clear();
@@ -1620,6 +1620,26 @@ int main(int argc, char *argv[]) {
          LOG_ERROR("IOTest: error destroying decomp Vrtx R8 FAIL");
       }
 
+      // Test the decomposition cache: a cached decomp must be retrieved
+      // under its key, unknown keys must not be found and the cache must be
+      // empty after it is cleared
+      int DecompCache;
+      int DecompFound = -1;
+      Err = IO::createDecomp(DecompCache, IO::IOTypeR8, 2, CellDims,
+                             CellArraySize, OffsetCell, IO::DefaultRearr);
+      IO::cacheDecomp("R8:Cells:Levels", DecompCache);
+      bool Found   = IO::getCachedDecomp("R8:Cells:Levels", DecompFound) &&
+                   DecompFound == DecompCache;
+      bool Missing = !IO::getCachedDecomp("R4:Cells:Levels", DecompFound);
+      Err += IO::clearDecompCache();
+      bool Cleared = !IO::getCachedDecomp("R8:Cells:Levels", DecompFound);
+      if (Err == 0 && Found && Missing && Cleared) {
+         LOG_ERROR("IOTest: decomp cache PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("IOTest: decomp cache FAIL");
+      }
+
       // Exit environments
       Decomp::clear();
       MachEnv::removeAll();
@@ -18,6 +18,7 @@
 //===-----------------------------------------------------------------------===/
 
 #include "MachEnv.h"
+#include "DataTypes.h"
 #include "Logging.h"
 #include "mpi.h"
 
@@ -483,10 +484,58 @@ int main(int argc, char *argv[]) {
 
    } // end if member of general subset env
 
+   //---------------------------------------------------------------------------
+   // Test the node layout of the default environment. Each task is on
+   // exactly one node, so the node sizes of the leaders add up to the
+   // number of tasks and the number of leaders is the number of nodes.
+
+   int IsLeader     = DefEnv->isNodeLeader() ? 1 : 0;
+   int LeaderTasks  = IsLeader * DefEnv->getNumNodeTasks();
+   int NodeCount[2] = {IsLeader, LeaderTasks};
+   MPI_Allreduce(MPI_IN_PLACE, NodeCount, 2, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+   if (NodeCount[0] == DefEnv->getNumNodes() && NodeCount[1] == WorldSize &&
+       DefEnv->getMyNode() >= 0 && DefEnv->getMyNode() < NodeCount[0] &&
+       IsLeader == (DefEnv->getMyNodeTask() == 0 ? 1 : 0))
+      std::cout << "DefaultEnv node layout test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "DefaultEnv node layout test: FAIL" << std::endl;
+   }
+
+   if ((DefEnv->getLeaderComm() != MPI_COMM_NULL) == DefEnv->isNodeLeader())
+      std::cout << "DefaultEnv leader comm test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "DefaultEnv leader comm test: FAIL" << std::endl;
+   }
+
+   // The hierarchical reduction matches the flat reduction for an
+   // integer sum, also when reducing in place
+   int TaskSum    = 0;
+   int TaskSumRef = WorldSize * (WorldSize - 1) / 2;
+   DefEnv->allReduceHier(&WorldTask, &TaskSum, 1, MPI_INT, MPI_SUM);
+   int TaskSumInPlace = WorldTask;
+   DefEnv->allReduceHier(MPI_IN_PLACE, &TaskSumInPlace, 1, MPI_INT, MPI_SUM);
+   if (TaskSum == TaskSumRef && TaskSumInPlace == TaskSumRef)
+      std::cout << "DefaultEnv hierarchical reduction test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "DefaultEnv hierarchical reduction test: FAIL" << std::endl;
+   }
+
    //---------------------------------------------------------------------------
    // Test setting of compile-time vector length
 
-#ifdef OMEGA_VECTOR_LENGTH
+#if defined(OMEGA_SIMD)
+   if (OMEGA::VecLength ==
+       Kokkos::Experimental::native_simd<OMEGA::Real>::size())
+      std::cout << "MPI vector length test: PASS" << std::endl;
+   else {
+      RetVal += 1;
+      std::cout << "MPI vector length test: FAIL" << std::endl;
+   }
+#elif defined(OMEGA_VECTOR_LENGTH)
    if (OMEGA::VecLength == OMEGA_VECTOR_LENGTH)
       std::cout << "MPI vector length test: PASS" << std::endl;
    else {
@@ -0,0 +1,105 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA memory registry --------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA memory registry
+///
+/// This driver tests that the memory registry sums the arrays of a module by
+/// memory space, replaces entries recorded again under the same name and
+/// removes entries and modules.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "MemoryRegistry.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      const I4 N     = 100;
+      const I8 Bytes = N * sizeof(R8);
+
+      // Device arrays are counted as host memory for host-only builds
+      const bool DevOnHost =
+          Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                     ExecSpace::memory_space>::accessible;
+
+      // Arrays are summed by memory space
+      Array1DR8 DevA("DevA", N);
+      HostArray2DR8 HostA("HostA", N, 2);
+      MemoryRegistry::add("Test", "DevA", DevA);
+      MemoryRegistry::add("Test", "HostA", HostA);
+      MemoryRegistry::addBytes("Test", "Buffer", true, Bytes);
+      const I8 DevBytes  = DevOnHost ? 0 : Bytes;
+      const I8 HostBytes = DevOnHost ? 4 * Bytes : 3 * Bytes;
+      if (MemoryRegistry::getBytes("Test", false) == DevBytes &&
+          MemoryRegistry::getBytes("Test", true) == HostBytes) {
+         LOG_INFO("MemoryRegistryTest: sum test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("MemoryRegistryTest: sum test FAIL");
+      }
+
+      // An array recorded again under the same name replaces the entry
+      Array1DR8 DevB("DevB", 3 * N);
+      MemoryRegistry::add("Test", "DevA", DevB);
+      MemoryRegistry::remove("Test", "Buffer");
+      if (MemoryRegistry::getBytes("Test", false) +
+              MemoryRegistry::getBytes("Test", true) ==
+          5 * Bytes) {
+         LOG_INFO("MemoryRegistryTest: replace and remove test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("MemoryRegistryTest: replace and remove test FAIL");
+      }
+
+      // Removing a module leaves the other modules
+      MemoryRegistry::add("Other", "DevA", DevA);
+      MemoryRegistry::removeModule("Test");
+      if (MemoryRegistry::getBytes("Test", DevOnHost) == 0 &&
+          MemoryRegistry::getBytes("Other", DevOnHost) == Bytes) {
+         LOG_INFO("MemoryRegistryTest: remove module test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("MemoryRegistryTest: remove module test FAIL");
+      }
+
+      MemoryRegistry::clear();
+      if (MemoryRegistry::getBytes("Other", DevOnHost) == 0) {
+         LOG_INFO("MemoryRegistryTest: clear test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("MemoryRegistryTest: clear test FAIL");
+      }
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
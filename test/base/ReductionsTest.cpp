@@ -0,0 +1,202 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA global reductions ------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA global reductions
+///
+/// This driver tests the batched global sums, minima and maxima. A set of
+/// distributed arrays with values over many orders of magnitude is reduced
+/// across all tasks and the results are compared with the same reductions
+/// computed on a single task, which must be bit-for-bit identical for the
+/// fixed-point sums and the minima and maxima.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Reductions.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace OMEGA;
+
+constexpr I4 NGlobal = 100000; // number of global entries
+constexpr I4 NLevels = 8;      // number of levels of 2D arrays
+constexpr I4 NHalo   = 10;     // number of halo entries, excluded from sums
+constexpr R8 HaloVal = 1.0e30; // halo value that would spoil any sum
+
+// A value of global entry G at level K spanning nine orders of magnitude,
+// with alternating signs so that the sums have a lot of cancellation
+R8 refValue(I4 G, I4 K) {
+   return std::sin(0.1 * G + K) * std::pow(10.0, G % 9 - 4);
+}
+
+//------------------------------------------------------------------------------
+// Computes a batch of reductions for entries [Start, Start+NOwned) with a
+// halo of spoiled values and returns the results
+std::vector<R8> runBatch(const MachEnv *Env, SumMethod Method, I4 Start,
+                         I4 NOwned) {
+
+   I4 NAll = NOwned + NHalo;
+   HostArray2DReal ArrayH("Array", NAll, NLevels);
+   HostArray1DReal WeightH("Weight", NAll);
+   HostArray1DReal Array1DH("Array1D", NAll);
+   for (int I = 0; I < NAll; ++I) {
+      bool Owned  = I < NOwned;
+      I4 G        = Start + I;
+      WeightH(I)  = Owned ? 1.0 + (G % 7) : HaloVal;
+      Array1DH(I) = Owned ? refValue(G, NLevels) : HaloVal;
+      for (int K = 0; K < NLevels; ++K)
+         ArrayH(I, K) = Owned ? refValue(G, K) : HaloVal;
+   }
+   Array2DReal Array   = createDeviceMirrorCopy(ArrayH);
+   Array1DReal Weight  = createDeviceMirrorCopy(WeightH);
+   Array1DReal Array1D = createDeviceMirrorCopy(Array1DH);
+
+   ReductionBatch Batch(Env, Method);
+   std::vector<I4> Handles;
+   Handles.push_back(Batch.addSum(Array1D, NOwned));
+   Handles.push_back(Batch.addSum(Array, NOwned));
+   Handles.push_back(Batch.addSum(Array, Weight, NOwned));
+   Handles.push_back(Batch.addSum(Array, Array, NOwned));
+   Handles.push_back(Batch.addSum(
+       "sumCubes", NOwned, NLevels, KOKKOS_LAMBDA(int I, int K) {
+          return R8(Array(I, K) * Array(I, K) * Array(I, K));
+       }));
+   Handles.push_back(Batch.addMin(Array, NOwned));
+   Handles.push_back(Batch.addMax(Array, NOwned));
+
+   std::vector<R8> Results;
+   I4 Err = Batch.reduce();
+   if (Err != 0)
+      return Results;
+   for (I4 Handle : Handles)
+      Results.push_back(Batch.getResult(Handle));
+
+   // A second reduce of the same batch must give the same results
+   Err = Batch.reduce();
+   for (int N = 0; N < Handles.size(); ++N) {
+      if (Err != 0 or Batch.getResult(Handles[N]) != Results[N])
+         Results.clear();
+   }
+
+   return Results;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for global reductions
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+      MPI_Comm DefComm = DefEnv->getComm();
+      I4 MyTask        = DefEnv->getMyTask();
+      I4 NumTasks      = DefEnv->getNumTasks();
+
+      // A single-task environment for the reference reductions
+      MachEnv *SerialEnv = MachEnv::create("Serial", DefEnv, 1);
+
+      // Each task owns a contiguous chunk of the global entries
+      I4 NChunk = (NGlobal - 1) / NumTasks + 1;
+      I4 Start  = MyTask * NChunk;
+      I4 NOwned = std::max(std::min(NChunk, NGlobal - Start), 0);
+
+      const SumMethod Methods[3]    = {SumMethodFixedPoint,
+                                       SumMethodCompensated, SumMethodNative};
+      const char *MethodNames[3]    = {"FixedPoint", "Compensated", "Native"};
+      const R8 Tolerance[3]         = {0.0, 1.0e-14, 1.0e-10};
+      const I4 NResults             = 7;
+      const I4 NSumResults          = 5;
+      std::vector<R8> FixedPointRef = {};
+
+      for (int M = 0; M < 3; ++M) {
+         std::vector<R8> Results =
+             runBatch(DefEnv, Methods[M], Start, NOwned);
+
+         // The reference is computed on the master task and broadcast
+         std::vector<R8> Reference(NResults, 0.0);
+         if (SerialEnv->isMember()) {
+            Reference = runBatch(SerialEnv, Methods[M], 0, NGlobal);
+            Reference.resize(NResults, 0.0);
+         }
+         MPI_Bcast(Reference.data(), NResults, MPI_DOUBLE, 0, DefComm);
+
+         I4 Err = Results.size() == NResults ? 0 : 1;
+         for (int N = 0; N < NResults and Err == 0; ++N) {
+            // Minima and maxima are exact for every method
+            R8 Tol  = N < NSumResults ? Tolerance[M] : 0.0;
+            R8 Diff = std::fabs(Results[N] - Reference[N]);
+            if (Diff > Tol * std::fabs(Reference[N]))
+               ++Err;
+         }
+
+         // The other methods must agree with the fixed-point sums
+         if (M == 0)
+            FixedPointRef = Reference;
+         for (int N = 0; N < NSumResults and Err == 0; ++N) {
+            R8 Diff = std::fabs(Results[N] - FixedPointRef[N]);
+            if (Diff > 1.0e-10 * std::fabs(FixedPointRef[N]))
+               ++Err;
+         }
+
+         if (Err == 0) {
+            LOG_INFO("ReductionsTest: {} reduction test PASS",
+                     MethodNames[M]);
+         } else {
+            RetVal += 1;
+            LOG_ERROR("ReductionsTest: {} reduction test FAIL",
+                      MethodNames[M]);
+         }
+      }
+
+      // Single-array sum interface
+      HostArray1DReal OnesH("Ones", NOwned + NHalo);
+      for (int I = 0; I < NOwned + NHalo; ++I)
+         OnesH(I) = I < NOwned ? 1.0 : HaloVal;
+      Array1DReal Ones = createDeviceMirrorCopy(OnesH);
+      R8 NSum          = globalSum(Ones, NOwned);
+      if (NSum == NGlobal) {
+         LOG_INFO("ReductionsTest: globalSum test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ReductionsTest: globalSum test FAIL {}", NSum);
+      }
+
+      // Translation of the sum method option
+      if (getSumMethodFromStr("FixedPoint") == SumMethodFixedPoint and
+          getSumMethodFromStr("Compensated") == SumMethodCompensated and
+          getSumMethodFromStr("Native") == SumMethodNative and
+          getSumMethodFromStr("Other") == SumMethodUnknown) {
+         LOG_INFO("ReductionsTest: sum method option test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ReductionsTest: sum method option test FAIL");
+      }
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,137 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA scratch pool -----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the OMEGA scratch array pool
+///
+/// This driver tests that the scratch pool reuses arrays once they are no
+/// longer referenced, hands out separate arrays while they are in use,
+/// serves rank-1 requests by capacity and frees the superseded arrays, and
+/// keeps separate statistics for the device and host pools.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "ScratchPool.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+
+      const I4 N     = 100;
+      const I8 Bytes = N * sizeof(R8);
+
+      // Device arrays are counted in the host pool for host-only builds
+      const bool DevOnHost =
+          Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                     ExecSpace::memory_space>::accessible;
+
+      // An array dropped by its user is returned by the next request
+      const R8 *FirstPtr;
+      {
+         Array1DR8 First = ScratchPool::get<Array1DR8>("First", N);
+         FirstPtr        = First.data();
+      }
+      Array1DR8 Second = ScratchPool::get<Array1DR8>("Second", N);
+      if (Second.data() == FirstPtr && ScratchPool::getNumReused() == 1 &&
+          ScratchPool::getDeviceBytes() + ScratchPool::getHostBytes() ==
+              Bytes) {
+         LOG_INFO("ScratchPoolTest: reuse test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ScratchPoolTest: reuse test FAIL");
+      }
+
+      // An array in use is not handed out again, including through a
+      // subview
+      auto Sub        = Kokkos::subview(Second, Kokkos::make_pair(0, N / 2));
+      Second          = Array1DR8();
+      Array1DR8 Third = ScratchPool::get<Array1DR8>("Third", N);
+      if (Third.data() != Sub.data() &&
+          ScratchPool::getDeviceBytes() + ScratchPool::getHostBytes() ==
+              2 * Bytes) {
+         LOG_INFO("ScratchPoolTest: in use test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ScratchPoolTest: in use test FAIL");
+      }
+
+      // Arrays of other extents and host arrays are allocated separately
+      Array1DR8 Longer    = ScratchPool::get<Array1DR8>("Longer", 2 * N);
+      HostArray2DR8 HostA = ScratchPool::get<HostArray2DR8>("HostA", N, 2);
+      const I8 DevBytes  = DevOnHost ? 0 : 4 * Bytes;
+      const I8 HostBytes = DevOnHost ? 6 * Bytes : 2 * Bytes;
+      if (Longer.extent_int(0) == 2 * N && HostA.extent_int(1) == 2 &&
+          ScratchPool::getDeviceBytes() == DevBytes &&
+          ScratchPool::getHostBytes() == HostBytes) {
+         LOG_INFO("ScratchPoolTest: extents and spaces test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ScratchPoolTest: extents and spaces test FAIL");
+      }
+
+      // A shorter request is served by a longer free array, and a longer
+      // request frees the shorter free arrays instead of keeping them
+      const R8 *LongerPtr = Longer.data();
+      Longer              = Array1DR8();
+      Array1DR8 Shorter   = ScratchPool::get<Array1DR8>("Shorter", N / 2);
+      const bool Capacity =
+          Shorter.data() == LongerPtr && Shorter.extent_int(0) == N / 2;
+      Shorter = Array1DR8();
+
+      Array1DR8 Longest = ScratchPool::get<Array1DR8>("Longest", 4 * N);
+      const I8 HeldBytes =
+          ScratchPool::getDeviceBytes() + ScratchPool::getHostBytes();
+      const I8 PeakBytes =
+          ScratchPool::getDevicePeakBytes() + ScratchPool::getHostPeakBytes();
+      const I8 TotalBytes = 8 * Bytes;
+      if (Capacity && HeldBytes == TotalBytes && PeakBytes == TotalBytes) {
+         LOG_INFO("ScratchPoolTest: capacity test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ScratchPoolTest: capacity test FAIL");
+      }
+
+      ScratchPool::report();
+
+      // Arrays still in use stay valid after the pools are cleared
+      ScratchPool::clear();
+      deepCopy(Third, 1.0);
+      if (ScratchPool::getDeviceBytes() == 0 &&
+          ScratchPool::getHostBytes() == 0 && Third.extent_int(0) == N) {
+         LOG_INFO("ScratchPoolTest: clear test PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("ScratchPoolTest: clear test FAIL");
+      }
+
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,462 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Benchmark driver for OMEGA Halo and Decomp ---------------*- C++ -*-===/
+//
+/// \file
+/// \brief Scaling benchmark of the decomposition and the halo exchange
+///
+/// This driver measures the time to construct a decomposition of the mesh
+/// given on the command line, split into the read, adjacency gather, METIS,
+/// partition and rearrange phases, for each partition method. It reports
+/// the imbalance of the owned cells across tasks and the number of elements
+/// exchanged with each neighbor in each index space. It then times
+/// exchangeFullArrayHalo for cell arrays of rank 1, 2 and 3 over a sweep of
+/// the number of vertical levels and tracers, with host arrays, device
+/// arrays passed to MPI as the build is configured and device arrays staged
+/// through host memory. The latency of each exchange and the achieved
+/// bandwidth are the slowest over all tasks. Results are written to the log
+/// and as JSON to a file. The task count is that of the run, so a scaling
+/// study runs the driver once per task count. Usage:
+///
+///    omega_bench_halo [-m MeshFile] [-k NVertLevels,...] [-t NTracers,...]
+///                     [-n NReps] [-d NDecompReps] [-o JsonFile]
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Halo.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Error.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Benchmark options from the command line
+struct BenchOptions {
+   std::string MeshFile = "OmegaMesh.nc";
+   std::string JsonFile = "omega_bench_halo.json";
+   std::vector<I4> NVertLevels{16, 64};
+   std::vector<I4> NTracers{1, 4};
+   I4 NReps       = 50;
+   I4 NDecompReps = 1;
+};
+
+// Timing of one exchange configuration
+struct ExchangeResult {
+   std::string Label;
+   I4 Rank;
+   I4 NVertLevels;
+   I4 NTracers;
+   R8 Latency;  // slowest task time per exchange
+   R8 MaxBytes; // largest bytes sent and received by a task per exchange
+   R8 SumBytes; // bytes sent and received by all tasks per exchange
+};
+
+//------------------------------------------------------------------------------
+// Parse a comma separated list of positive integers
+bool parseList(const std::string &Val, std::vector<I4> &List) {
+   List.clear();
+   std::stringstream Stream(Val);
+   std::string Item;
+   while (std::getline(Stream, Item, ',')) {
+      I4 N = std::atoi(Item.c_str());
+      if (N <= 0)
+         return false;
+      List.push_back(N);
+   }
+   return !List.empty();
+}
+
+// Read the options, returning false if an option is not recognized
+bool parseOptions(BenchOptions &Opts, int argc, char *argv[]) {
+   for (int I = 1; I < argc; ++I) {
+      const std::string Arg = argv[I];
+      if (I + 1 >= argc)
+         return false;
+      const std::string Val = argv[++I];
+      if (Arg == "-m") {
+         Opts.MeshFile = Val;
+      } else if (Arg == "-o") {
+         Opts.JsonFile = Val;
+      } else if (Arg == "-k") {
+         if (!parseList(Val, Opts.NVertLevels))
+            return false;
+      } else if (Arg == "-t") {
+         if (!parseList(Val, Opts.NTracers))
+            return false;
+      } else if (Arg == "-n") {
+         Opts.NReps = std::atoi(Val.c_str());
+      } else if (Arg == "-d") {
+         Opts.NDecompReps = std::atoi(Val.c_str());
+      } else {
+         return false;
+      }
+   }
+   return Opts.NReps > 0 and Opts.NDecompReps > 0;
+}
+
+//------------------------------------------------------------------------------
+// Construct decompositions with each partition method and write the slowest
+// task time of each phase, averaged over the repetitions
+void benchDecomp(std::ofstream &Json, const BenchOptions &Opts,
+                 MachEnv *DefEnv) {
+
+   MPI_Comm Comm    = DefEnv->getComm();
+   I4 NumTasks      = DefEnv->getNumTasks();
+   I4 HaloWidth     = Decomp::getDefault()->HaloWidth;
+   const I4 NPhases = 6;
+
+   const std::vector<std::pair<std::string, PartMethod>> Methods = {
+       {"MetisKWay", PartMethodMetisKWay},
+       {"ParMetisKWay", PartMethodParMetisKWay},
+       {"HilbertSFC", PartMethodHilbertSFC}};
+
+   LOG_INFO("HaloBench: decomposition times (s), slowest task");
+   LOG_INFO("{:<14} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}", "Method",
+            "Read", "Gather", "Metis", "Partition", "Rearrange", "Total");
+   Json << "  \"Decomp\": [\n";
+
+   for (int IMethod = 0; IMethod < Methods.size(); ++IMethod) {
+      const auto &[MethodName, Method] = Methods[IMethod];
+
+      std::vector<R8> Times(NPhases, 0);
+      for (int IRep = 0; IRep < Opts.NDecompReps; ++IRep) {
+         const std::string Name = "Bench" + MethodName;
+         MPI_Barrier(Comm);
+         Decomp *NewDecomp = Decomp::create(Name, DefEnv, NumTasks, Method,
+                                            HaloWidth, Opts.MeshFile);
+         const R8 Local[NPhases] = {
+             NewDecomp->ReadMeshTime,  NewDecomp->GatherTime,
+             NewDecomp->MetisTime,     NewDecomp->PartitionTime,
+             NewDecomp->RearrangeTime, NewDecomp->ConstructTime};
+         R8 Max[NPhases];
+         MPI_Allreduce(Local, Max, NPhases, MPI_DOUBLE, MPI_MAX, Comm);
+         for (int IPhase = 0; IPhase < NPhases; ++IPhase)
+            Times[IPhase] += Max[IPhase] / Opts.NDecompReps;
+         Decomp::erase(Name);
+      }
+
+      LOG_INFO("{:<14} {:>10.4f} {:>10.4f} {:>10.4f} {:>10.4f} {:>10.4f} "
+               "{:>10.4f}",
+               MethodName, Times[0], Times[1], Times[2], Times[3], Times[4],
+               Times[5]);
+      Json << "    {\"Method\": \"" << MethodName << "\", "
+           << "\"ReadMeshTime\": " << Times[0] << ", "
+           << "\"GatherTime\": " << Times[1] << ", "
+           << "\"MetisTime\": " << Times[2] << ", "
+           << "\"PartitionTime\": " << Times[3] << ", "
+           << "\"RearrangeTime\": " << Times[4] << ", "
+           << "\"ConstructTime\": " << Times[5] << "}"
+           << (IMethod < Methods.size() - 1 ? ",\n" : "\n");
+   }
+   Json << "  ],\n";
+
+} // end benchDecomp
+
+//------------------------------------------------------------------------------
+// Write the imbalance of the owned cells and the elements exchanged with each
+// neighbor by every task in each index space of the default halo
+void writeNeighbors(std::ofstream &Json, MachEnv *DefEnv) {
+
+   MPI_Comm Comm     = DefEnv->getComm();
+   I4 NumTasks       = DefEnv->getNumTasks();
+   bool IsMaster     = DefEnv->isMasterTask();
+   Decomp *DefDecomp = Decomp::getDefault();
+   Halo *DefHalo     = Halo::getDefault();
+
+   // Owned cell imbalance, as the ratio of the largest to the mean count
+   I4 MinOwned;
+   I4 MaxOwned;
+   I4 SumOwned;
+   MPI_Allreduce(&DefDecomp->NCellsOwned, &MinOwned, 1, MPI_INT32_T, MPI_MIN,
+                 Comm);
+   MPI_Allreduce(&DefDecomp->NCellsOwned, &MaxOwned, 1, MPI_INT32_T, MPI_MAX,
+                 Comm);
+   MPI_Allreduce(&DefDecomp->NCellsOwned, &SumOwned, 1, MPI_INT32_T, MPI_SUM,
+                 Comm);
+   const R8 MeanOwned = static_cast<R8>(SumOwned) / NumTasks;
+   const R8 Imbalance = MaxOwned / MeanOwned;
+
+   LOG_INFO("HaloBench: NCellsOwned min {} max {} mean {:.1f} imbalance {:.4f}",
+            MinOwned, MaxOwned, MeanOwned, Imbalance);
+   Json << "  \"NCellsOwned\": {\"Min\": " << MinOwned
+        << ", \"Max\": " << MaxOwned << ", \"Mean\": " << MeanOwned
+        << ", \"Imbalance\": " << Imbalance << "},\n";
+
+   // Gather the neighbor task and message sizes of each task, with four
+   // entries per neighbor, to the master task
+   const MeshElement Elems[3]     = {OnCell, OnEdge, OnVertex};
+   const std::string ElemNames[3] = {"OnCell", "OnEdge", "OnVertex"};
+   Json << "  \"Neighbors\": {\n";
+   for (int IElem = 0; IElem < 3; ++IElem) {
+      std::vector<I4> TaskIDs;
+      std::vector<I4> NSend;
+      std::vector<I4> NRecv;
+      DefHalo->getNeighborSizes(Elems[IElem], TaskIDs, NSend, NRecv);
+
+      std::vector<I4> Local;
+      for (int INghbr = 0; INghbr < TaskIDs.size(); ++INghbr) {
+         Local.push_back(DefEnv->getMyTask());
+         Local.push_back(TaskIDs[INghbr]);
+         Local.push_back(NSend[INghbr]);
+         Local.push_back(NRecv[INghbr]);
+      }
+      I4 LocalSize = Local.size();
+      std::vector<I4> Sizes(NumTasks);
+      MPI_Gather(&LocalSize, 1, MPI_INT32_T, Sizes.data(), 1, MPI_INT32_T, 0,
+                 Comm);
+      std::vector<I4> Offsets(NumTasks, 0);
+      for (int Task = 1; Task < NumTasks; ++Task)
+         Offsets[Task] = Offsets[Task - 1] + Sizes[Task - 1];
+      std::vector<I4> All(IsMaster ? Offsets[NumTasks - 1] + Sizes.back() : 0);
+      MPI_Gatherv(Local.data(), LocalSize, MPI_INT32_T, All.data(),
+                  Sizes.data(), Offsets.data(), MPI_INT32_T, 0, Comm);
+
+      if (!IsMaster)
+         continue;
+
+      const I4 NEntries = All.size() / 4;
+      I4 MaxNghbrs      = 0;
+      I4 MaxSend        = 0;
+      R8 SumSend        = 0;
+      for (int Task = 0; Task < NumTasks; ++Task)
+         MaxNghbrs = std::max(MaxNghbrs, Sizes[Task] / 4);
+      Json << "    \"" << ElemNames[IElem] << "\": [";
+      for (int I = 0; I < NEntries; ++I) {
+         MaxSend = std::max(MaxSend, All[4 * I + 2]);
+         SumSend += All[4 * I + 2];
+         Json << (I == 0 ? "\n" : ",\n") << "      {\"Task\": " << All[4 * I]
+              << ", \"Neighbor\": " << All[4 * I + 1]
+              << ", \"NSend\": " << All[4 * I + 2]
+              << ", \"NRecv\": " << All[4 * I + 3] << "}";
+      }
+      Json << "\n    ]" << (IElem < 2 ? ",\n" : "\n");
+
+      LOG_INFO("HaloBench: {} messages per exchange {}, max neighbors {}, "
+               "elements per message max {} mean {:.1f}",
+               ElemNames[IElem], NEntries, MaxNghbrs, MaxSend,
+               NEntries > 0 ? SumSend / NEntries : 0.0);
+      for (int I = 0; I < NEntries; ++I)
+         LOG_INFO("HaloBench:    task {:>6} to {:>6} send {:>8} recv {:>8}",
+                  All[4 * I], All[4 * I + 1], All[4 * I + 2], All[4 * I + 3]);
+   }
+   Json << "  },\n";
+
+} // end writeNeighbors
+
+//------------------------------------------------------------------------------
+// Time the halo exchange of a cell array after one warm-up exchange
+template <typename T>
+void runExchange(std::vector<ExchangeResult> &Results, Halo *MyHalo, T &Array,
+                 const std::string &Label, I4 NVertLevels, I4 NTracers,
+                 const BenchOptions &Opts, MPI_Comm Comm) {
+
+   using ValType = typename T::non_const_value_type;
+
+   // The array size at each cell
+   const I4 Rank = T::rank;
+   R8 ElemSize   = sizeof(ValType);
+   if (Rank > 1)
+      ElemSize *= NVertLevels;
+   if (Rank > 2)
+      ElemSize *= NTracers;
+
+   std::vector<I4> TaskIDs;
+   std::vector<I4> NSend;
+   std::vector<I4> NRecv;
+   MyHalo->getNeighborSizes(OnCell, TaskIDs, NSend, NRecv);
+   R8 LocalBytes = 0;
+   for (int INghbr = 0; INghbr < TaskIDs.size(); ++INghbr)
+      LocalBytes += (NSend[INghbr] + NRecv[INghbr]) * ElemSize;
+
+   I4 Err = MyHalo->exchangeFullArrayHalo(Array, OnCell);
+   if (Err != 0)
+      ABORT_ERROR("HaloBench: error in {} halo exchange", Label);
+
+   MPI_Barrier(Comm);
+   const R8 StartTime = MPI_Wtime();
+   for (int IRep = 0; IRep < Opts.NReps; ++IRep)
+      MyHalo->exchangeFullArrayHalo(Array, OnCell);
+   Kokkos::fence();
+   const R8 LocalTime = (MPI_Wtime() - StartTime) / Opts.NReps;
+
+   R8 Latency;
+   R8 MaxBytes;
+   R8 SumBytes;
+   MPI_Allreduce(&LocalTime, &Latency, 1, MPI_DOUBLE, MPI_MAX, Comm);
+   MPI_Allreduce(&LocalBytes, &MaxBytes, 1, MPI_DOUBLE, MPI_MAX, Comm);
+   MPI_Allreduce(&LocalBytes, &SumBytes, 1, MPI_DOUBLE, MPI_SUM, Comm);
+
+   Results.push_back(
+       {Label, Rank, NVertLevels, NTracers, Latency, MaxBytes, SumBytes});
+
+} // end runExchange
+
+//------------------------------------------------------------------------------
+// Time the exchange of cell arrays of each rank and size with host arrays,
+// device arrays and device arrays staged through host memory
+void benchExchanges(std::vector<ExchangeResult> &Results,
+                    const BenchOptions &Opts, MPI_Comm Comm) {
+
+   Decomp *DefDecomp = Decomp::getDefault();
+   Halo *DefHalo     = Halo::getDefault();
+   const I4 NCells   = DefDecomp->NCellsSize;
+
+   Halo::setMPIOnDevice(false);
+   Halo *StagedHalo =
+       Halo::create("BenchStaged", MachEnv::getDefault(), DefDecomp);
+
+   // One test for each memory mode: the halo to use and whether the arrays
+   // are on the host
+   const std::vector<std::tuple<std::string, Halo *, bool>> Modes = {
+       {"Host", DefHalo, true},
+       {"Device", DefHalo, false},
+       {"DeviceStaged", StagedHalo, false}};
+
+   for (const auto &[ModeName, MyHalo, OnHost] : Modes) {
+      if (OnHost) {
+         HostArray1DReal A1("A1", NCells);
+         runExchange(Results, MyHalo, A1, ModeName, 1, 1, Opts, Comm);
+      } else {
+         Array1DReal A1("A1", NCells);
+         runExchange(Results, MyHalo, A1, ModeName, 1, 1, Opts, Comm);
+      }
+      for (I4 NVertLevels : Opts.NVertLevels) {
+         if (OnHost) {
+            HostArray2DReal A2("A2", NCells, NVertLevels);
+            runExchange(Results, MyHalo, A2, ModeName, NVertLevels, 1, Opts,
+                        Comm);
+         } else {
+            Array2DReal A2("A2", NCells, NVertLevels);
+            runExchange(Results, MyHalo, A2, ModeName, NVertLevels, 1, Opts,
+                        Comm);
+         }
+         for (I4 NTracers : Opts.NTracers) {
+            if (OnHost) {
+               HostArray3DReal A3("A3", NTracers, NCells, NVertLevels);
+               runExchange(Results, MyHalo, A3, ModeName, NVertLevels,
+                           NTracers, Opts, Comm);
+            } else {
+               Array3DReal A3("A3", NTracers, NCells, NVertLevels);
+               runExchange(Results, MyHalo, A3, ModeName, NVertLevels,
+                           NTracers, Opts, Comm);
+            }
+         }
+      }
+   }
+
+   Halo::erase("BenchStaged");
+
+} // end benchExchanges
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+int main(int argc, char *argv[]) {
+
+   int RetErr = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      BenchOptions Opts;
+      if (!parseOptions(Opts, argc, argv)) {
+         std::cerr << "Usage: omega_bench_halo [-m MeshFile] "
+                      "[-k NVertLevels,...] [-t NTracers,...] [-n NReps] "
+                      "[-d NDecompReps] [-o JsonFile]"
+                   << std::endl;
+         RetErr = 1;
+      } else {
+         MachEnv::init(MPI_COMM_WORLD);
+         MachEnv *DefEnv  = MachEnv::getDefault();
+         MPI_Comm DefComm = DefEnv->getComm();
+         initLogging(DefEnv);
+
+         Config("Omega");
+         Config::readAll("omega.yml");
+
+         I4 IOErr = IO::init(DefComm);
+         if (IOErr != 0)
+            ABORT_ERROR("HaloBench: error initializing parallel IO");
+
+         Decomp::init(Opts.MeshFile);
+         I4 HaloErr = Halo::init();
+         if (HaloErr != 0)
+            ABORT_ERROR("HaloBench: error initializing default halo");
+
+         // Only the master task writes the JSON file
+         std::ofstream Json;
+         if (DefEnv->isMasterTask())
+            Json.open(Opts.JsonFile);
+         Json << "{\n";
+         Json << "  \"MeshFile\": \"" << Opts.MeshFile << "\",\n";
+         Json << "  \"NCellsGlobal\": " << Decomp::getDefault()->NCellsGlobal
+              << ",\n";
+         Json << "  \"NTasks\": " << DefEnv->getNumTasks() << ",\n";
+         Json << "  \"NReps\": " << Opts.NReps << ",\n";
+
+         benchDecomp(Json, Opts, DefEnv);
+         writeNeighbors(Json, DefEnv);
+
+         std::vector<ExchangeResult> Results;
+         benchExchanges(Results, Opts, DefComm);
+
+         LOG_INFO("HaloBench: exchangeFullArrayHalo, slowest task");
+         LOG_INFO("{:<14} {:>4} {:>6} {:>6} {:>12} {:>12} {:>10} {:>10}",
+                  "Buffers", "Rank", "NVert", "NTr", "Latency (s)",
+                  "MaxBytes", "Task GB/s", "Tot GB/s");
+         Json << "  \"Exchanges\": [\n";
+         for (int I = 0; I < Results.size(); ++I) {
+            const auto &Res = Results[I];
+            const R8 TaskBW = Res.MaxBytes / Res.Latency * 1.0e-9;
+            const R8 TotBW  = Res.SumBytes / Res.Latency * 1.0e-9;
+            LOG_INFO("{:<14} {:>4} {:>6} {:>6} {:>12.5e} {:>12.0f} "
+                     "{:>10.3f} {:>10.3f}",
+                     Res.Label, Res.Rank, Res.NVertLevels, Res.NTracers,
+                     Res.Latency, Res.MaxBytes, TaskBW, TotBW);
+            Json << "    {\"Buffers\": \"" << Res.Label << "\", "
+                 << "\"Rank\": " << Res.Rank << ", "
+                 << "\"NVertLevels\": " << Res.NVertLevels << ", "
+                 << "\"NTracers\": " << Res.NTracers << ", "
+                 << "\"Latency\": " << Res.Latency << ", "
+                 << "\"MaxBytes\": " << Res.MaxBytes << ", "
+                 << "\"SumBytes\": " << Res.SumBytes << ", "
+                 << "\"TaskGBytesPerSec\": " << TaskBW << ", "
+                 << "\"TotalGBytesPerSec\": " << TotBW << "}"
+                 << (I < Results.size() - 1 ? ",\n" : "\n");
+         }
+         Json << "  ]\n}\n";
+
+         Halo::clear();
+         Decomp::clear();
+         MachEnv::removeAll();
+      }
+   }
+   Pacer::finalize();
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   return RetErr;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
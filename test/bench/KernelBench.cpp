@@ -0,0 +1,937 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Benchmark driver for OMEGA kernels -----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Micro-benchmarks of the tendency, auxiliary variable, EOS and
+/// time stepper update kernels
+///
+/// This driver times each tendency term functor, each auxiliary variable
+/// kernel, the EOS kernels and the time stepper update kernels on the mesh
+/// given on the command line, with synthetic smooth input fields. The size
+/// of the problem is set by the choice of mesh and by the number of vertical
+/// levels and tracers. Each kernel is run a number of times after a warm-up
+/// call, with a device fence after every call. For each kernel the minimum,
+/// mean and maximum time per call are reported, with the slowest task
+/// defining the time, together with the achieved GFLOP/s, the effective
+/// bandwidth and the SIMD width of the kernel, which is 1 for kernels
+/// without an explicit SIMD form or in builds without OMEGA_SIMD. The
+/// operation counts are estimates per point from the stencil of each
+/// kernel, and the bytes are the compulsory traffic of reading each input
+/// array and writing each output array once. The results are written
+/// to the log and as JSON to a file for tracking performance across commits
+/// and hardware. Usage:
+///
+///    omega_bench_kernels [-m MeshFile] [-k NVertLevels] [-t NTracers]
+///                        [-n NReps] [-o JsonFile]
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Eos.h"
+#include "Error.h"
+#include "Field.h"
+#include "FusedAuxVars.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "KineticAuxVars.h"
+#include "LayerThicknessAuxVars.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "OmegaSimd.h"
+#include "Pacer.h"
+#include "StencilCoeffs.h"
+#include "Tendencies.h"
+#include "TendencyTerms.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Timing.h"
+#include "TracerAuxVars.h"
+#include "Tracers.h"
+#include "VelocityDel2AuxVars.h"
+#include "VorticityAuxVars.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Benchmark options from the command line
+struct BenchOptions {
+   std::string MeshFile = "OmegaMesh.nc";
+   std::string JsonFile = "omega_bench_kernels.json";
+   I4 NVertLevels       = 64;
+   I4 NTracers          = 4;
+   I4 NReps             = 20;
+};
+
+// Estimated cost of one call of a kernel on this task
+struct KernelCost {
+   R8 Flops;          // floating point operations
+   R8 Bytes;          // compulsory bytes read and written
+   I4 SimdWidth = 1;  // values per vector instruction in an explicit SIMD form
+};
+
+// Timing of one kernel on this task
+struct BenchResult {
+   std::string Name;
+   KernelCost Cost;
+   R8 MinTime;
+   R8 MeanTime;
+   R8 MaxTime;
+};
+
+//------------------------------------------------------------------------------
+// Read the options, returning false if an option is not recognized
+bool parseOptions(BenchOptions &Opts, int argc, char *argv[]) {
+   for (int I = 1; I < argc; ++I) {
+      const std::string Arg = argv[I];
+      if (I + 1 >= argc)
+         return false;
+      const std::string Val = argv[++I];
+      if (Arg == "-m") {
+         Opts.MeshFile = Val;
+      } else if (Arg == "-o") {
+         Opts.JsonFile = Val;
+      } else if (Arg == "-k") {
+         Opts.NVertLevels = std::atoi(Val.c_str());
+      } else if (Arg == "-t") {
+         Opts.NTracers = std::atoi(Val.c_str());
+      } else if (Arg == "-n") {
+         Opts.NReps = std::atoi(Val.c_str());
+      } else {
+         return false;
+      }
+   }
+   return Opts.NVertLevels > 0 and Opts.NVertLevels % VecLength == 0 and
+          Opts.NTracers > 0 and Opts.NReps > 0;
+}
+
+//------------------------------------------------------------------------------
+// Fill arrays with smooth synthetic values Base + Amp * sin(...), which are
+// positive for Amp < Base, so thicknesses can be used as divisors
+void fillArray(const Array1DReal &Arr, Real Base, Real Amp) {
+   parallelFor(
+       "benchFill1D", {Arr.extent_int(0)}, KOKKOS_LAMBDA(int I) {
+          Arr(I) = Base + Amp * Kokkos::sin(0.01_Real * I);
+       });
+}
+
+void fillArray(const Array2DReal &Arr, Real Base, Real Amp) {
+   parallelFor(
+       "benchFill2D", {Arr.extent_int(0), Arr.extent_int(1)},
+       KOKKOS_LAMBDA(int I, int K) {
+          Arr(I, K) = Base + Amp * Kokkos::sin(0.01_Real * I + 0.1_Real * K);
+       });
+}
+
+template <class Array3DType>
+void fillArray(const Array3DType &Arr, Real Base, Real Amp) {
+   parallelFor(
+       "benchFill3D", {Arr.extent_int(0), Arr.extent_int(1), Arr.extent_int(2)},
+       KOKKOS_LAMBDA(int L, int I, int K) {
+          Arr(L, I, K) = Base + Amp * Kokkos::sin(0.01_Real * I +
+                                                  0.1_Real * K + L);
+       });
+}
+
+//------------------------------------------------------------------------------
+// Time a kernel launcher over the requested repetitions after one warm-up
+// call. The device is fenced after each call so that the time covers the
+// kernel execution.
+template <class F>
+void runBench(std::vector<BenchResult> &Results, const std::string &Name,
+              const KernelCost &Cost, const BenchOptions &Opts, F &&Launch) {
+
+   Launch();
+   Kokkos::fence();
+
+   R8 MinTime = 1.0e30;
+   R8 MaxTime = 0;
+   R8 SumTime = 0;
+   for (int IRep = 0; IRep < Opts.NReps; ++IRep) {
+      const R8 StartTime = MPI_Wtime();
+      Launch();
+      Kokkos::fence();
+      const R8 Time = MPI_Wtime() - StartTime;
+      MinTime       = std::min(MinTime, Time);
+      MaxTime       = std::max(MaxTime, Time);
+      SumTime += Time;
+   }
+
+   Results.push_back({Name, Cost, MinTime, SumTime / Opts.NReps, MaxTime});
+}
+
+//------------------------------------------------------------------------------
+// Benchmark the tendency term functors one at a time and fused
+void benchTendencyTerms(std::vector<BenchResult> &Results,
+                        const BenchOptions &Opts) {
+
+   const auto *Mesh = HorzMesh::getDefault();
+   const I4 K       = Opts.NVertLevels;
+   const I4 NT      = Opts.NTracers;
+   const I4 NChunks = K / VecLength;
+   const I4 NCells  = Mesh->NCellsOwned;
+   const I4 NEdges  = Mesh->NEdgesOwned;
+
+   // Mean neighbor counts for the operation estimates
+   const R8 NC      = NCells;
+   const R8 NE      = NEdges;
+   const R8 NV      = Mesh->NVerticesOwned;
+   const R8 ECell   = 2.0 * NE / NC;
+   const R8 EEdge   = 2.0 * (ECell - 1.0);
+   const R8 RSize   = sizeof(Real);
+   const R8 CellPts = NC * K;
+   const R8 EdgePts = NE * K;
+
+   // Synthetic inputs
+   FusedVelocityTendOnEdge::Inputs VelIn;
+   VelIn.NormRVortEdge      = Array2DReal("NormRVortEdge", Mesh->NEdgesSize, K);
+   VelIn.NormFEdge          = Array2DReal("NormFEdge", Mesh->NEdgesSize, K);
+   VelIn.FluxLayerThickEdge = Array2DReal("FluxThickEdge", Mesh->NEdgesSize, K);
+   VelIn.NormVelEdge        = Array2DReal("NormVelEdge", Mesh->NEdgesSize, K);
+   VelIn.KECell             = Array2DReal("KECell", Mesh->NCellsSize, K);
+   VelIn.SshCell            = Array2DReal("SshCell", Mesh->NCellsSize, K);
+   VelIn.DivCell            = Array2DReal("DivCell", Mesh->NCellsSize, K);
+   VelIn.RVortVertex = Array2DReal("RVortVertex", Mesh->NVerticesSize, K);
+   VelIn.Del2DivCell = Array2DReal("Del2DivCell", Mesh->NCellsSize, K);
+   VelIn.Del2RVortVertex =
+       Array2DReal("Del2RVortVertex", Mesh->NVerticesSize, K);
+   VelIn.NormalStressEdge = Array1DReal("NormalStressEdge", Mesh->NEdgesSize);
+   VelIn.LayerThickEdge   = Array2DReal("LayerThickEdge", Mesh->NEdgesSize, K);
+
+   fillArray(VelIn.NormRVortEdge, 1.0e-5, 1.0e-6);
+   fillArray(VelIn.NormFEdge, 1.0e-4, 1.0e-5);
+   fillArray(VelIn.FluxLayerThickEdge, 100.0, 10.0);
+   fillArray(VelIn.NormVelEdge, 0.0, 0.5);
+   fillArray(VelIn.KECell, 0.1, 0.05);
+   fillArray(VelIn.SshCell, 0.0, 1.0);
+   fillArray(VelIn.DivCell, 0.0, 1.0e-6);
+   fillArray(VelIn.RVortVertex, 0.0, 1.0e-6);
+   fillArray(VelIn.Del2DivCell, 0.0, 1.0e-12);
+   fillArray(VelIn.Del2RVortVertex, 0.0, 1.0e-12);
+   fillArray(VelIn.NormalStressEdge, 0.0, 0.1);
+   fillArray(VelIn.LayerThickEdge, 100.0, 10.0);
+
+   FusedTracerTendOnCell::Inputs TrIn;
+   TrIn.NormVelEdge = VelIn.NormVelEdge;
+   TrIn.HTracersOnEdge =
+       Array3DTracerAux("HTracersOnEdge", NT, Mesh->NEdgesSize, K);
+   TrIn.TracerCell         = Array3DReal("TracerCell", NT, Mesh->NCellsSize, K);
+   TrIn.MeanLayerThickEdge = VelIn.LayerThickEdge;
+   TrIn.TrDel2Cell = Array3DTracerAux("TrDel2Cell", NT, Mesh->NCellsSize, K);
+
+   fillArray(TrIn.HTracersOnEdge, 1000.0, 100.0);
+   fillArray(TrIn.TracerCell, 10.0, 1.0);
+   fillArray(TrIn.TrDel2Cell, 0.0, 1.0e-8);
+
+   Array2DReal ThickTend("ThickTend", Mesh->NCellsSize, K);
+   Array2DReal VelTend("VelTend", Mesh->NEdgesSize, K);
+   Array3DReal TracerTend("TracerTend", NT, Mesh->NCellsSize, K);
+
+   // Functors with all terms enabled
+   ThicknessFluxDivOnCell ThickFluxDivOnC(Mesh);
+   PotentialVortHAdvOnEdge PotVortHAdvOnE(Mesh);
+   KEGradOnEdge KEGradOnE(Mesh);
+   SSHGradOnEdge SSHGradOnE(Mesh);
+   VelocityDiffusionOnEdge VelDiffOnE(Mesh);
+   VelocityHyperDiffOnEdge VelHyperDiffOnE(Mesh);
+   WindForcingOnEdge WindForcingOnE(Mesh);
+   BottomDragOnEdge BottomDragOnE(Mesh);
+   TracerHorzAdvOnCell TrHorzAdvOnC(Mesh);
+   TracerDiffOnCell TrDiffOnC(Mesh);
+   TracerHyperDiffOnCell TrHypDiffOnC(Mesh);
+
+   ThickFluxDivOnC.Enabled         = true;
+   PotVortHAdvOnE.Enabled          = true;
+   KEGradOnE.Enabled               = true;
+   SSHGradOnE.Enabled              = true;
+   VelDiffOnE.Enabled              = true;
+   VelDiffOnE.ViscDel2             = 1.0e3;
+   VelHyperDiffOnE.Enabled         = true;
+   VelHyperDiffOnE.ViscDel4        = 1.2e11;
+   VelHyperDiffOnE.DivFactor       = 1.0;
+   WindForcingOnE.Enabled          = true;
+   WindForcingOnE.SaltWaterDensity = 1026.0;
+   BottomDragOnE.Enabled           = true;
+   BottomDragOnE.Coeff             = 1.0e-3;
+   TrHorzAdvOnC.Enabled            = true;
+   TrDiffOnC.Enabled               = true;
+   TrDiffOnC.EddyDiff2             = 10.0;
+   TrHypDiffOnC.Enabled            = true;
+   TrHypDiffOnC.EddyDiff4          = 1.0e9;
+
+   runBench(Results, "ThicknessFluxDivOnCell",
+            {3 * ECell * CellPts, (2 * NE + NC) * K * RSize, simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchThickFluxDiv", {NCells, NChunks},
+                   KOKKOS_LAMBDA(int ICell, int KChunk) {
+                      ThickFluxDivOnC(ThickTend, ICell, KChunk,
+                                      VelIn.FluxLayerThickEdge,
+                                      VelIn.NormVelEdge);
+                   });
+            });
+
+   runBench(Results, "PotentialVortHAdvOnEdge",
+            {6 * EEdge * EdgePts, 5 * NE * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchPotVortHAdv", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      PotVortHAdvOnE(VelTend, IEdge, KChunk,
+                                     VelIn.NormRVortEdge, VelIn.NormFEdge,
+                                     VelIn.FluxLayerThickEdge,
+                                     VelIn.NormVelEdge);
+                   });
+            });
+
+   runBench(Results, "KEGradOnEdge",
+            {3 * EdgePts, (NC + NE) * K * RSize, simdWidth()}, Opts, [&] {
+               parallelFor(
+                   "benchKEGrad", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      KEGradOnE(VelTend, IEdge, KChunk, VelIn.KECell);
+                   });
+            });
+
+   runBench(Results, "SSHGradOnEdge",
+            {3 * EdgePts, (NC + NE) * K * RSize, simdWidth()}, Opts, [&] {
+               parallelFor(
+                   "benchSSHGrad", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      SSHGradOnE(VelTend, IEdge, KChunk, VelIn.SshCell);
+                   });
+            });
+
+   runBench(Results, "VelocityDiffusionOnEdge",
+            {8 * EdgePts, (NC + NV + NE) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchVelDiff", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      VelDiffOnE(VelTend, IEdge, KChunk, VelIn.DivCell,
+                                 VelIn.RVortVertex);
+                   });
+            });
+
+   runBench(Results, "VelocityHyperDiffOnEdge",
+            {9 * EdgePts, (NC + NV + NE) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchVelHyperDiff", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      VelHyperDiffOnE(VelTend, IEdge, KChunk,
+                                      VelIn.Del2DivCell,
+                                      VelIn.Del2RVortVertex);
+                   });
+            });
+
+   // The surface and bottom terms only act on one level
+   runBench(Results, "WindForcingOnEdge", {3 * NE, 3 * NE * RSize}, Opts,
+            [&] {
+               parallelFor(
+                   "benchWindForcing", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      WindForcingOnE(VelTend, IEdge, KChunk,
+                                     VelIn.NormalStressEdge,
+                                     VelIn.LayerThickEdge);
+                   });
+            });
+
+   runBench(Results, "BottomDragOnEdge", {12 * NE, (3 * NE + NC) * RSize},
+            Opts, [&] {
+               parallelFor(
+                   "benchBottomDrag", {NEdges}, KOKKOS_LAMBDA(int IEdge) {
+                      BottomDragOnE(VelTend, IEdge, VelIn.NormVelEdge,
+                                    VelIn.KECell, VelIn.LayerThickEdge);
+                   });
+            });
+
+   FusedVelocityTendOnEdge FusedVelTendOnE(Mesh);
+   FusedVelTendOnE.setTerms(PotVortHAdvOnE, KEGradOnE, SSHGradOnE, VelDiffOnE,
+                            VelHyperDiffOnE, WindForcingOnE, BottomDragOnE);
+   runBench(Results, "FusedVelocityTendOnEdge",
+            {(6 * EEdge + 23) * EdgePts + 15 * NE,
+             (6 * NE + 4 * NC + 2 * NV) * K * RSize},
+            Opts, [&] { FusedVelTendOnE.compute(VelTend, VelIn, NEdges); });
+
+   const R8 TrPts = NT * CellPts;
+
+   runBench(Results, "TracerHorzAdvOnCell",
+            {3 * ECell * TrPts, (NE + NT * NE + NT * NC) * K * RSize}, Opts,
+            [&] {
+               parallelFor(
+                   "benchTracerHorzAdv", {NT, NCells, NChunks},
+                   KOKKOS_LAMBDA(int L, int ICell, int KChunk) {
+                      TrHorzAdvOnC(TracerTend, L, ICell, KChunk,
+                                   TrIn.NormVelEdge, TrIn.HTracersOnEdge);
+                   });
+            });
+
+   runBench(Results, "TracerDiffOnCell",
+            {7 * ECell * TrPts, (2 * NT * NC + NE) * K * RSize, simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchTracerDiff", {NT, NCells, NChunks},
+                   KOKKOS_LAMBDA(int L, int ICell, int KChunk) {
+                      TrDiffOnC(TracerTend, L, ICell, KChunk,
+                                TrIn.TracerCell, TrIn.MeanLayerThickEdge);
+                   });
+            });
+
+   runBench(Results, "TracerHyperDiffOnCell",
+            {3 * ECell * TrPts, 2 * NT * NC * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchTracerHyperDiff", {NT, NCells, NChunks},
+                   KOKKOS_LAMBDA(int L, int ICell, int KChunk) {
+                      TrHypDiffOnC(TracerTend, L, ICell, KChunk,
+                                   TrIn.TrDel2Cell);
+                   });
+            });
+
+   FusedTracerTendOnCell FusedTrTendOnC(Mesh);
+   FusedTrTendOnC.setTerms(TrHorzAdvOnC, TrDiffOnC, TrHypDiffOnC);
+   runBench(Results, "FusedTracerTendOnCell",
+            {13 * ECell * TrPts, (2 * NE + NT * NE + 3 * NT * NC) * K * RSize},
+            Opts, [&] { FusedTrTendOnC.compute(TracerTend, TrIn, NCells); });
+
+} // end benchTendencyTerms
+
+//------------------------------------------------------------------------------
+// Benchmark the kernels of each auxiliary variable group and the fused
+// auxiliary variable kernels
+void benchAuxVars(std::vector<BenchResult> &Results, const BenchOptions &Opts) {
+
+   const auto *Mesh = HorzMesh::getDefault();
+   const I4 K       = Opts.NVertLevels;
+   const I4 NT      = Opts.NTracers;
+   const I4 NChunks = K / VecLength;
+   const I4 NCells  = Mesh->NCellsAll;
+   const I4 NEdges  = Mesh->NEdgesAll;
+   const I4 NVerts  = Mesh->NVerticesAll;
+   const R8 NC      = NCells;
+   const R8 NE      = NEdges;
+   const R8 NV      = NVerts;
+   const R8 ECell   = 2.0 * NE / NC;
+   const R8 VD      = Mesh->VertexDegree;
+   const R8 RSize   = sizeof(Real);
+   const R8 CellPts = NC * K;
+   const R8 EdgePts = NE * K;
+   const R8 VertPts = NV * K;
+
+   Array2DReal NormalVelEdge("NormalVelEdge", Mesh->NEdgesSize, K);
+   Array2DReal LayerThickCell("LayerThickCell", Mesh->NCellsSize, K);
+   Array3DReal TracerCell("TracerCell", NT, Mesh->NCellsSize, K);
+   fillArray(NormalVelEdge, 0.0, 0.5);
+   fillArray(LayerThickCell, 100.0, 10.0);
+   fillArray(TracerCell, 10.0, 1.0);
+
+   KineticAuxVars KineticAux("Bench", Mesh, K);
+   LayerThicknessAuxVars LayerThickAux("Bench", Mesh, K);
+   VorticityAuxVars VorticityAux("Bench", Mesh, K);
+   VelocityDel2AuxVars VelDel2Aux("Bench", Mesh, K);
+   TracerAuxVars TracerAux("Bench", Mesh, K, NT);
+
+   runBench(Results, "KineticAuxVars::computeVarsOnCell",
+            {5 * ECell * CellPts, (NE + 2 * NC) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchKineticOnCell", {NCells, NChunks},
+                   KOKKOS_LAMBDA(int ICell, int KChunk) {
+                      KineticAux.computeVarsOnCell(ICell, KChunk,
+                                                   NormalVelEdge);
+                   });
+            });
+
+   runBench(Results, "LayerThicknessAuxVars::computeVarsOnEdge",
+            {2 * EdgePts, (NC + 3 * NE) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchLayerThickOnEdge", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      LayerThickAux.computeVarsOnEdge(IEdge, KChunk,
+                                                      LayerThickCell,
+                                                      NormalVelEdge);
+                   });
+            });
+
+   runBench(Results, "VorticityAuxVars::computeVarsOnVertex",
+            {(4 * VD + 3) * VertPts, (NE + NC + 3 * NV) * K * RSize}, Opts,
+            [&] {
+               parallelFor(
+                   "benchVorticityOnVertex", {NVerts, NChunks},
+                   KOKKOS_LAMBDA(int IVertex, int KChunk) {
+                      VorticityAux.computeVarsOnVertex(IVertex, KChunk,
+                                                       LayerThickCell,
+                                                       NormalVelEdge);
+                   });
+            });
+
+   runBench(Results, "VorticityAuxVars::computeVarsOnEdge",
+            {4 * EdgePts, (2 * NV + 2 * NE) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchVorticityOnEdge", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      VorticityAux.computeVarsOnEdge(IEdge, KChunk);
+                   });
+            });
+
+   const auto &DivCell  = KineticAux.VelocityDivCell;
+   const auto &RelVortV = VorticityAux.RelVortVertex;
+
+   runBench(Results, "VelocityDel2AuxVars::computeVarsOnEdge",
+            {6 * EdgePts, (NC + NV + NE) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchVelDel2OnEdge", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      VelDel2Aux.computeVarsOnEdge(IEdge, KChunk, DivCell,
+                                                   RelVortV);
+                   });
+            });
+
+   runBench(Results, "VelocityDel2AuxVars::computeVarsOnCell",
+            {3 * ECell * CellPts, (NE + NC) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchVelDel2OnCell", {NCells, NChunks},
+                   KOKKOS_LAMBDA(int ICell, int KChunk) {
+                      VelDel2Aux.computeVarsOnCell(ICell, KChunk);
+                   });
+            });
+
+   runBench(Results, "VelocityDel2AuxVars::computeVarsOnVertex",
+            {3 * VD * VertPts, (NE + NV) * K * RSize}, Opts, [&] {
+               parallelFor(
+                   "benchVelDel2OnVertex", {NVerts, NChunks},
+                   KOKKOS_LAMBDA(int IVertex, int KChunk) {
+                      VelDel2Aux.computeVarsOnVertex(IVertex, KChunk);
+                   });
+            });
+
+   const auto &MeanThickEdge = LayerThickAux.MeanLayerThickEdge;
+
+   runBench(Results, "TracerAuxVars::computeVarsOnEdge",
+            {3 * NT * EdgePts, (NC + NT * NC + NT * NE) * K * RSize,
+             simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchTracerAuxOnEdge", {NT, NEdges, NChunks},
+                   KOKKOS_LAMBDA(int L, int IEdge, int KChunk) {
+                      TracerAux.computeVarsOnEdge(L, IEdge, KChunk,
+                                                  NormalVelEdge,
+                                                  LayerThickCell, TracerCell);
+                   });
+            });
+
+   runBench(Results, "TracerAuxVars::computeVarsOnCells",
+            {5 * ECell * NT * CellPts, (NE + 2 * NT * NC) * K * RSize,
+             simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchTracerAuxOnCell", {NT, NCells, NChunks},
+                   KOKKOS_LAMBDA(int L, int ICell, int KChunk) {
+                      TracerAux.computeVarsOnCells(L, ICell, KChunk,
+                                                   MeanThickEdge, TracerCell);
+                   });
+            });
+
+   // Fused kernels writing to the arrays of the groups above
+   FusedAuxVars FusedAux(Mesh);
+   FusedAuxVars::Outputs Out;
+   Out.KineticEnergyCell    = KineticAux.KineticEnergyCell;
+   Out.VelocityDivCell      = KineticAux.VelocityDivCell;
+   Out.RelVortVertex        = VorticityAux.RelVortVertex;
+   Out.NormRelVortVertex    = VorticityAux.NormRelVortVertex;
+   Out.NormPlanetVortVertex = VorticityAux.NormPlanetVortVertex;
+   Out.NormRelVortEdge      = VorticityAux.NormRelVortEdge;
+   Out.NormPlanetVortEdge   = VorticityAux.NormPlanetVortEdge;
+   Out.FluxLayerThickEdge   = LayerThickAux.FluxLayerThickEdge;
+   Out.MeanLayerThickEdge   = LayerThickAux.MeanLayerThickEdge;
+   Out.Del2Edge             = VelDel2Aux.Del2Edge;
+   Out.Del2DivCell          = VelDel2Aux.Del2DivCell;
+   Out.Del2RelVortVertex    = VelDel2Aux.Del2RelVortVertex;
+
+   runBench(Results, "FusedAuxVars::computeVarsOnCell",
+            {5 * ECell * CellPts, (NE + 2 * NC) * K * RSize, simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchFusedAuxOnCell", {NCells, NChunks},
+                   KOKKOS_LAMBDA(int ICell, int KChunk) {
+                      FusedAux.computeVarsOnCell(Out, ICell, KChunk,
+                                                 NormalVelEdge);
+                   });
+            });
+
+   runBench(Results, "FusedAuxVars::computeVarsOnVertex",
+            {(4 * VD + 3) * VertPts, (NE + NC + 3 * NV) * K * RSize,
+             simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchFusedAuxOnVertex", {NVerts, NChunks},
+                   KOKKOS_LAMBDA(int IVertex, int KChunk) {
+                      FusedAux.computeVarsOnVertex(Out, IVertex, KChunk,
+                                                   NormalVelEdge,
+                                                   LayerThickCell);
+                   });
+            });
+
+   runBench(Results, "FusedAuxVars::computeVarsOnEdge",
+            {10 * EdgePts, (2 * NC + 2 * NV + 4 * NE) * K * RSize,
+             simdWidth()},
+            Opts, [&] {
+               parallelFor(
+                   "benchFusedAuxOnEdge", {NEdges, NChunks},
+                   KOKKOS_LAMBDA(int IEdge, int KChunk) {
+                      FusedAux.computeVarsOnEdge(Out, IEdge, KChunk,
+                                                 NormalVelEdge,
+                                                 LayerThickCell);
+                   });
+            });
+
+   runBench(Results, "FusedAuxVars::compute",
+            {(8 * ECell + 10) * CellPts + 10 * EdgePts +
+                 (7 * VD + 3) * VertPts,
+             (4 * NC + 4 * NV + 6 * NE) * K * RSize, simdWidth()},
+            Opts, [&] {
+               FusedAux.compute(Out, NormalVelEdge, LayerThickCell, K);
+            });
+
+} // end benchAuxVars
+
+//------------------------------------------------------------------------------
+// Benchmark the specific volume kernels of each equation of state
+void benchEos(std::vector<BenchResult> &Results, const BenchOptions &Opts) {
+
+   const auto *Mesh = HorzMesh::getDefault();
+   const I4 K       = Opts.NVertLevels;
+   const R8 Pts     = static_cast<R8>(Mesh->NCellsAll) * K;
+   const R8 RSize   = sizeof(Real);
+
+   Array2DReal ConservTemp("ConservTemp", Mesh->NCellsSize, K);
+   Array2DReal AbsSalinity("AbsSalinity", Mesh->NCellsSize, K);
+   Array2DReal Pressure("Pressure", Mesh->NCellsSize, K);
+   fillArray(ConservTemp, 10.0, 8.0);
+   fillArray(AbsSalinity, 35.0, 2.0);
+   fillArray(Pressure, 2000.0, 1500.0);
+
+   Eos *DefEos          = Eos::getInstance();
+   const EosType InType = DefEos->EosChoice;
+   const I4 KDisp       = 1;
+
+   DefEos->EosChoice = EosType::LinearEos;
+   runBench(Results, "Eos::computeSpecVol:Linear",
+            {4 * Pts, 3 * Pts * RSize, simdWidth()}, Opts, [&] {
+               DefEos->computeSpecVol(ConservTemp, AbsSalinity, Pressure);
+            });
+
+   DefEos->EosChoice = EosType::Teos10Eos;
+   runBench(Results, "Eos::computeSpecVol:Teos10",
+            {180 * Pts, 4 * Pts * RSize, simdWidth()}, Opts, [&] {
+               DefEos->computeSpecVol(ConservTemp, AbsSalinity, Pressure);
+            });
+   runBench(Results, "Eos::computeSpecVolDisp:Teos10",
+            {180 * Pts, 4 * Pts * RSize, simdWidth()}, Opts, [&] {
+               DefEos->computeSpecVolDisp(ConservTemp, AbsSalinity, Pressure,
+                                          KDisp);
+            });
+   runBench(Results, "Eos::computeSpecVolAndDisp:Teos10",
+            {200 * Pts, 5 * Pts * RSize, simdWidth()}, Opts, [&] {
+               DefEos->computeSpecVolAndDisp(ConservTemp, AbsSalinity,
+                                             Pressure, KDisp);
+            });
+
+   DefEos->initTeos10Table();
+   DefEos->EosChoice = EosType::Teos10TableEos;
+   runBench(Results, "Eos::computeSpecVol:Teos10Table",
+            {40 * Pts, 4 * Pts * RSize}, Opts, [&] {
+               DefEos->computeSpecVol(ConservTemp, AbsSalinity, Pressure);
+            });
+
+   DefEos->EosChoice = InType;
+
+} // end benchEos
+
+//------------------------------------------------------------------------------
+// Benchmark the update kernels of the default time stepper
+void benchTimeStepper(std::vector<BenchResult> &Results,
+                      const BenchOptions &Opts) {
+
+   const auto *Mesh      = HorzMesh::getDefault();
+   TimeStepper *Stepper  = TimeStepper::getDefault();
+   OceanState *State     = OceanState::getDefault();
+   Tendencies *Tend      = Tendencies::getDefault();
+   const TimeInterval Dt = Stepper->getTimeStep();
+   const I4 K            = Opts.NVertLevels;
+   const R8 CellPts      = static_cast<R8>(Mesh->NCellsAll) * K;
+   const R8 EdgePts      = static_cast<R8>(Mesh->NEdgesAll) * K;
+   const R8 NT           = Tend->TracerTend.extent(0);
+   const R8 RSize        = sizeof(Real);
+
+   // Physical values so that the tracer updates divide by a thickness
+   Array2DReal Thick;
+   Array2DReal Vel;
+   Array3DReal CurTracers;
+   Array3DReal NextTracers;
+   for (int Level = 0; Level < 2; ++Level) {
+      State->getLayerThickness(Thick, Level);
+      State->getNormalVelocity(Vel, Level);
+      fillArray(Thick, 100.0, 10.0);
+      fillArray(Vel, 0.0, 0.5);
+   }
+   Tracers::getAll(CurTracers, 0);
+   Tracers::getAll(NextTracers, 1);
+   fillArray(CurTracers, 10.0, 1.0);
+   fillArray(Tend->LayerThicknessTend, 0.0, 1.0e-4);
+   fillArray(Tend->NormalVelocityTend, 0.0, 1.0e-6);
+   fillArray(Tend->TracerTend, 0.0, 1.0e-3);
+
+   runBench(Results, "updateThickByTend", {2 * CellPts, 3 * CellPts * RSize},
+            Opts, [&] {
+               Stepper->updateThicknessByTend(State, 1, State, 0, Dt);
+            });
+
+   runBench(Results, "updateVelByTend", {2 * EdgePts, 3 * EdgePts * RSize},
+            Opts, [&] {
+               Stepper->updateVelocityByTend(State, 1, State, 0, Dt);
+            });
+
+   runBench(Results, "updateTracersByTend",
+            {4 * NT * CellPts, (3 * NT + 2) * CellPts * RSize}, Opts, [&] {
+               Stepper->updateTracersByTend(NextTracers, CurTracers, State, 1,
+                                            State, 0, Dt);
+            });
+
+   runBench(Results, "updateThickAndTracersByTend",
+            {(4 * NT + 2) * CellPts, (3 * NT + 3) * CellPts * RSize}, Opts,
+            [&] {
+               Stepper->updateThicknessAndTracersByTend(
+                   NextTracers, CurTracers, State, 1, State, 0, Dt);
+            });
+
+   runBench(Results, "weightTracers",
+            {NT * CellPts, (2 * NT + 1) * CellPts * RSize}, Opts, [&] {
+               Stepper->weightTracers(NextTracers, CurTracers, State, 0);
+            });
+
+   runBench(Results, "accumulateTracersUpdate",
+            {2 * NT * CellPts, 3 * NT * CellPts * RSize}, Opts,
+            [&] { Stepper->accumulateTracersUpdate(NextTracers, Dt); });
+
+   // Repeated normalizations only rescale the tracers by a bounded factor
+   runBench(Results, "finalizeTracersUpdate",
+            {NT * CellPts, (2 * NT + 1) * CellPts * RSize}, Opts, [&] {
+               Stepper->finalizeTracersUpdate(NextTracers, State, 0);
+            });
+
+} // end benchTimeStepper
+
+//------------------------------------------------------------------------------
+// Reduce the results over tasks and write them to the log and the JSON file
+void writeResults(const std::vector<BenchResult> &Results,
+                  const BenchOptions &Opts, MPI_Comm Comm) {
+
+   I4 MyTask;
+   I4 NTasks;
+   MPI_Comm_rank(Comm, &MyTask);
+   MPI_Comm_size(Comm, &NTasks);
+
+   // The slowest task sets the time and the costs are summed over tasks
+   const I4 NKernels = Results.size();
+   std::vector<R8> Local(5 * NKernels);
+   for (int I = 0; I < NKernels; ++I) {
+      Local[5 * I]     = Results[I].MinTime;
+      Local[5 * I + 1] = Results[I].MeanTime;
+      Local[5 * I + 2] = Results[I].MaxTime;
+      Local[5 * I + 3] = Results[I].Cost.Flops;
+      Local[5 * I + 4] = Results[I].Cost.Bytes;
+   }
+   std::vector<R8> MaxTimes(5 * NKernels);
+   std::vector<R8> SumCosts(5 * NKernels);
+   MPI_Reduce(Local.data(), MaxTimes.data(), 5 * NKernels, MPI_DOUBLE, MPI_MAX,
+              0, Comm);
+   MPI_Reduce(Local.data(), SumCosts.data(), 5 * NKernels, MPI_DOUBLE, MPI_SUM,
+              0, Comm);
+
+   if (MyTask != 0)
+      return;
+
+   const auto *Mesh = HorzMesh::getDefault();
+   I4 NCellsGlobal  = Decomp::getDefault()->NCellsGlobal;
+
+   std::ofstream Json(Opts.JsonFile);
+   Json << "{\n";
+   Json << "  \"MeshFile\": \"" << Opts.MeshFile << "\",\n";
+   Json << "  \"NCellsGlobal\": " << NCellsGlobal << ",\n";
+   Json << "  \"NVertLevels\": " << Opts.NVertLevels << ",\n";
+   Json << "  \"NTracers\": " << Opts.NTracers << ",\n";
+   Json << "  \"NTasks\": " << NTasks << ",\n";
+   Json << "  \"NReps\": " << Opts.NReps << ",\n";
+   Json << "  \"RealBytes\": " << sizeof(Real) << ",\n";
+   Json << "  \"VecLength\": " << VecLength << ",\n";
+   Json << "  \"Kernels\": [\n";
+
+   LOG_INFO("KernelBench: {} on {} tasks, NCellsGlobal {}, NVertLevels {}",
+            Opts.MeshFile, NTasks, NCellsGlobal, Opts.NVertLevels);
+   LOG_INFO("{:<44} {:>12} {:>12} {:>10} {:>10} {:>5}", "Kernel", "Min (s)",
+            "Mean (s)", "GFLOP/s", "GB/s", "SIMD");
+
+   for (int I = 0; I < NKernels; ++I) {
+      const R8 MinTime  = MaxTimes[5 * I];
+      const R8 MeanTime = MaxTimes[5 * I + 1];
+      const R8 MaxTime  = MaxTimes[5 * I + 2];
+      const R8 Flops    = SumCosts[5 * I + 3];
+      const R8 Bytes    = SumCosts[5 * I + 4];
+      const R8 GFlops   = MinTime > 0 ? Flops / MinTime * 1.0e-9 : 0;
+      const R8 GBs      = MinTime > 0 ? Bytes / MinTime * 1.0e-9 : 0;
+
+      const I4 SimdWidth = Results[I].Cost.SimdWidth;
+
+      LOG_INFO("{:<44} {:>12.5e} {:>12.5e} {:>10.3f} {:>10.3f} {:>5}",
+               Results[I].Name, MinTime, MeanTime, GFlops, GBs, SimdWidth);
+
+      Json << "    {\"Name\": \"" << Results[I].Name << "\", "
+           << "\"MinTime\": " << MinTime << ", "
+           << "\"MeanTime\": " << MeanTime << ", "
+           << "\"MaxTime\": " << MaxTime << ", "
+           << "\"Flops\": " << Flops << ", "
+           << "\"Bytes\": " << Bytes << ", "
+           << "\"GFlopsPerSec\": " << GFlops << ", "
+           << "\"GBytesPerSec\": " << GBs << ", "
+           << "\"SimdWidth\": " << SimdWidth << "}"
+           << (I < NKernels - 1 ? ",\n" : "\n");
+   }
+   Json << "  ]\n}\n";
+
+} // end writeResults
+
+//------------------------------------------------------------------------------
+// Initialize the modules needed by the kernels, as in ocnInit but without
+// reading any stream
+void initBench(const BenchOptions &Opts) {
+
+   Error Err;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Config::readAll("omega.yml");
+
+   // Reset NVertLevels to the benchmark value
+   Config *OmegaConfig = Config::getOmegaConfig();
+   Config DimConfig("Dimension");
+   Err += OmegaConfig->get(DimConfig);
+   CHECK_ERROR_ABORT(Err, "KernelBench: Dimension group not found in Config");
+   DimConfig.set("NVertLevels", Opts.NVertLevels);
+
+   TimeStepper::init1();
+   Clock *ModelClock = TimeStepper::getDefault()->getClock();
+
+   I4 IOErr = IO::init(DefComm);
+   if (IOErr != 0)
+      ABORT_ERROR("KernelBench: error initializing parallel IO");
+
+   I4 FieldErr = Field::init(ModelClock);
+   if (FieldErr != 0)
+      ABORT_ERROR("KernelBench: error initializing Fields");
+
+   Decomp::init(Opts.MeshFile);
+
+   I4 HaloErr = Halo::init();
+   if (HaloErr != 0)
+      ABORT_ERROR("KernelBench: error initializing default halo");
+
+   HorzMesh::init();
+   Dimension::create("NVertLevels", Opts.NVertLevels);
+
+   Tracers::init();
+   AuxiliaryState::init();
+   Tendencies::init();
+   TimeStepper::init2();
+
+   I4 StateErr = OceanState::init();
+   if (StateErr != 0)
+      ABORT_ERROR("KernelBench: error initializing default state");
+
+   Eos::init();
+
+   // Time the bare kernels without the Pacer regions of the model
+   Timing::setOptions(false, false);
+
+} // end initBench
+
+//------------------------------------------------------------------------------
+// Clean up all modules in the order of ocnFinalize
+void finalizeBench() {
+
+   Eos::destroyInstance();
+   Tracers::clear();
+   TimeStepper::clear();
+   Tendencies::clear();
+   AuxiliaryState::clear();
+   OceanState::clear();
+   Dimension::clear();
+   Field::clear();
+   StencilCoeffs::clear();
+   HorzMesh::clear();
+   Halo::clear();
+   Decomp::clear();
+   MachEnv::removeAll();
+
+} // end finalizeBench
+
+//------------------------------------------------------------------------------
+// The benchmark driver
+int main(int argc, char *argv[]) {
+
+   int RetErr = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      BenchOptions Opts;
+      if (!parseOptions(Opts, argc, argv)) {
+         std::cerr << "Usage: omega_bench_kernels [-m MeshFile] "
+                      "[-k NVertLevels] [-t NTracers] [-n NReps] "
+                      "[-o JsonFile]\nNVertLevels must be a multiple of "
+                   << VecLength << std::endl;
+         RetErr = 1;
+      } else {
+         initBench(Opts);
+
+         // Use the number of tracers defined in the config for the time
+         // stepper kernels and the requested number elsewhere
+         std::vector<BenchResult> Results;
+         benchTendencyTerms(Results, Opts);
+         benchAuxVars(Results, Opts);
+         benchEos(Results, Opts);
+         benchTimeStepper(Results, Opts);
+
+         writeResults(Results, Opts, MachEnv::getDefault()->getComm());
+
+         finalizeBench();
+      }
+   }
+   Pacer::finalize();
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   return RetErr;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -301,6 +301,8 @@ int main(int argc, char **argv) {
       }
 
       // Destroy a dimension
+      I8 OldID                 = TestDim->getID();
+      HostArray1DI4 OldOffsets = TestDim->getOffset();
       Dimension::destroy("NCells");
       if (Dimension::exists("NCells")) {
          LOG_ERROR("Dimension destroy test: FAIL");
@@ -309,6 +311,16 @@ int main(int argc, char **argv) {
          LOG_INFO("Dimension destroy test: PASS");
       }
 
+      // A re-created dimension gets a new ID even with the same properties
+      auto NewDim = Dimension::create("NCells", NCellsGlbRef, NCellsLocRef,
+                                      OldOffsets);
+      if (NewDim != nullptr and NewDim->getID() != OldID) {
+         LOG_INFO("Dimension re-create ID test: PASS");
+      } else {
+         LOG_ERROR("Dimension re-create ID test: FAIL");
+         ++Err;
+      }
+
       // Test removal of all dims
       Dimension::clear();
       NDims = Dimension::getNumDefinedDims();
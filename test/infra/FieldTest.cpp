@@ -669,6 +669,34 @@ int main(int argc, char **argv) {
       TstEval<std::string>("Retrieve dim names 5 result 5", DimNames[4],
                            "NStuff", Err);
 
+      // Check retrieval by handle and the cached field attributes
+      FieldHandle Handle5DR4 = Field::getHandle("Test5DR4");
+      TstEval<FieldHandle>("Retrieve handle - member", Test5DR4->getHandle(),
+                           Handle5DR4, Err);
+      TstEval<bool>("Retrieve field by handle",
+                    Field::get(Handle5DR4) == Test5DR4, true, Err);
+      TstEval<FieldHandle>("Retrieve handle of missing field",
+                           Field::getHandle("Junk"), InvalidFieldHandle, Err);
+      const FieldInfo &Info5DR4 = Test5DR4->getInfo();
+      TstEval<int>("Cached number of dims", Info5DR4.NDims, 5, Err);
+      TstEval<ArrayDataType>("Cached data type", Info5DR4.DataType,
+                             ArrayDataType::R4, Err);
+
+      R4 Fill5DR4 = 0;
+      Err1        = Test5DR4->getFillValue(Fill5DR4);
+      TstEval<int>("Cached fill value call", Err1, ErrRef, Err);
+      TstEval<R4>("Cached fill value converted", Fill5DR4, 999.0f, Err);
+      Test5DR4->updateMetadata("FillValue", -1.0e10);
+      Err1 = Test5DR4->getFillValue(Fill5DR4);
+      TstEval<R4>("Cached fill value updated", Fill5DR4, R4(-1.0e10), Err);
+
+      Array5DR4 Data5DR4Handle =
+          Field::getFieldDataArray<Array5DR4>(Handle5DR4);
+      TstEval<bool>("Get data array by handle",
+                    Data5DR4Handle.data() ==
+                        Test5DR4->getDataArray<Array5DR4>().data(),
+                    true, Err);
+
       // Test some field group functions and use to retrieve some remaining
       // fields for data testing
 
@@ -927,8 +955,11 @@ int main(int argc, char **argv) {
       TstEval<bool>("Remove all field groups", GroupTest, false, Err);
 
       // Destroy a field and check for removal
-      bool ShouldExist = false;
+      bool ShouldExist        = false;
+      FieldHandle Handle1DI4H = Field::getHandle("Test1DI4H");
       Field::destroy("Test1DI4H");
+      bool HandleRemoved = Field::get(Handle1DI4H) == nullptr;
+      TstEval<bool>("Destroyed field handle", HandleRemoved, true, Err);
       Field::destroy("Test1DI4");
       bool FieldExists = Field::exists("Test1DI4H");
       TstEval<bool>("Destroy field 1DI4H", FieldExists, ShouldExist, Err);
@@ -941,6 +972,17 @@ int main(int argc, char **argv) {
       TstEval<bool>("Clear all fields 2DR8H", FieldExists, ShouldExist, Err);
       FieldExists = Field::exists("Test2DR8");
       TstEval<bool>("Clear all fields 2DR8", FieldExists, ShouldExist, Err);
+
+      // Handles saved before a clear stay invalid for new fields
+      DimNames.resize(1);
+      DimNames[0]       = "NCells";
+      auto NewField     = Field::create("TestNew", "Field created after clear",
+                                        "UnitsNew", "var_name_new", 0, 100000,
+                                        999, 1, DimNames);
+      bool HandleUnused = NewField->getHandle() > Handle5DR4 and
+                          Field::get(Handle5DR4) == nullptr;
+      TstEval<bool>("Handles after clear", HandleUnused, true, Err);
+      Field::clear();
    }
 
    // Clean up environments
@@ -10,7 +10,9 @@
 ///
 /// This driver tests the ability to write to/from files within Omega. An
 /// IOStream is defined for each unique combination of read/write frequency,
-/// contents of the file and other properties.
+/// contents of the file and other properties. A stream with an average
+/// reduction is added to write the annual mean of a field with known values
+/// each step, and the written mean is read back and checked.
 //
 //===-----------------------------------------------------------------------===/
 
@@ -33,7 +35,10 @@
 #include "TimeStepper.h"
 #include "Tracers.h"
 #include "mpi.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <thread>
 #include <vector>
 
@@ -51,6 +56,174 @@ void TestEval(const std::string &TestName, T TestVal, T ExpectVal, int &Error) {
       ++Error;
    }
 }
+//------------------------------------------------------------------------------
+// Adds a stream that writes the annual mean of the TimeMeanTest field and a
+// stream that reads the mean back to the IOStreams configuration
+void addTimeMeanStreams(Config *OmegaConfig) {
+
+   Config StreamsConfig("IOStreams");
+   Error Err = OmegaConfig->get(StreamsConfig);
+   CHECK_ERROR_ABORT(Err, "IOStreamTest: IOStreams group not found");
+
+   std::vector<std::string> MeanContents{"TimeMeanTest"};
+
+   Config WriteConfig("TimeMeanWrite");
+   WriteConfig.add("UsePointerFile", false);
+   WriteConfig.add("Filename", std::string("ocn.test.mean"));
+   WriteConfig.add("Mode", std::string("write"));
+   WriteConfig.add("IfExists", std::string("replace"));
+   WriteConfig.add("Precision", std::string("double"));
+   WriteConfig.add("Freq", 1);
+   WriteConfig.add("FreqUnits", std::string("years"));
+   WriteConfig.add("UseStartEnd", false);
+   WriteConfig.add("Reduction", std::string("average"));
+   WriteConfig.add("Contents", MeanContents);
+   StreamsConfig.add(WriteConfig);
+
+   Config ReadConfig("TimeMeanRead");
+   ReadConfig.add("UsePointerFile", false);
+   ReadConfig.add("Filename", std::string("ocn.test.mean"));
+   ReadConfig.add("Mode", std::string("read"));
+   ReadConfig.add("Precision", std::string("double"));
+   ReadConfig.add("Freq", 1);
+   ReadConfig.add("FreqUnits", std::string("OnStartup"));
+   ReadConfig.add("UseStartEnd", false);
+   ReadConfig.add("Contents", MeanContents);
+   StreamsConfig.add(ReadConfig);
+}
+
+//------------------------------------------------------------------------------
+// Adds annual write streams of the TimeMeanTest field with compression and
+// chunking in a NetCDF4 file and a NetCDF3 file, and a stream to read each
+// file back. The NetCDF3 stream also asks for quantization, which must be
+// ignored with the other options for the values to read back exactly.
+void addStorageStreams(Config *OmegaConfig) {
+
+   Config StreamsConfig("IOStreams");
+   Error Err = OmegaConfig->get(StreamsConfig);
+   CHECK_ERROR_ABORT(Err, "IOStreamTest: IOStreams group not found");
+
+   std::vector<std::string> StorageContents{"TimeMeanTest"};
+
+   const std::vector<std::string> Formats{"netcdf4c", "netcdf3"};
+   for (const std::string &Format : Formats) {
+      const std::string Filename = "ocn.test.storage." + Format;
+
+      Config WriteConfig("StorageWrite_" + Format);
+      WriteConfig.add("UsePointerFile", false);
+      WriteConfig.add("Filename", Filename);
+      WriteConfig.add("Mode", std::string("write"));
+      WriteConfig.add("IfExists", std::string("replace"));
+      WriteConfig.add("Precision", std::string("double"));
+      WriteConfig.add("Format", Format);
+      WriteConfig.add("Compression", std::string("deflate"));
+      WriteConfig.add("CompressionLevel", 4);
+      WriteConfig.add("Freq", 1);
+      WriteConfig.add("FreqUnits", std::string("years"));
+      WriteConfig.add("UseStartEnd", false);
+      WriteConfig.add("Contents", StorageContents);
+      if (Format == "netcdf3")
+         WriteConfig.add("Quantize", 3);
+      Config ChunkConfig("ChunkSizes");
+      ChunkConfig.add("NCells", 64);
+      WriteConfig.add(ChunkConfig);
+      StreamsConfig.add(WriteConfig);
+
+      Config ReadConfig("StorageRead_" + Format);
+      ReadConfig.add("UsePointerFile", false);
+      ReadConfig.add("Filename", Filename);
+      ReadConfig.add("Mode", std::string("read"));
+      ReadConfig.add("Precision", std::string("double"));
+      ReadConfig.add("Freq", 1);
+      ReadConfig.add("FreqUnits", std::string("OnStartup"));
+      ReadConfig.add("UseStartEnd", false);
+      ReadConfig.add("Contents", StorageContents);
+      StreamsConfig.add(ReadConfig);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Adds annual write streams that exercise each way a field is staged for
+// writing and a stream to read each file back. The host field is written
+// directly from its array, the device field is packed and copied to the
+// host and the single precision stream converts the device field to R4
+// before the copy.
+void addStagingStreams(Config *OmegaConfig) {
+
+   Config StreamsConfig("IOStreams");
+   Error Err = OmegaConfig->get(StreamsConfig);
+   CHECK_ERROR_ABORT(Err, "IOStreamTest: IOStreams group not found");
+
+   const std::vector<std::string> Stages{"Direct", "Device", "Single"};
+   for (const std::string &Stage : Stages) {
+      const std::string Filename = "ocn.test.stage." + Stage;
+      std::vector<std::string> StageContents{"TimeMeanTest"};
+      if (Stage == "Direct")
+         StageContents[0] = "StageHostTest";
+      const std::string Precision = Stage == "Single" ? "single" : "double";
+
+      Config WriteConfig("StageWrite" + Stage);
+      WriteConfig.add("UsePointerFile", false);
+      WriteConfig.add("Filename", Filename);
+      WriteConfig.add("Mode", std::string("write"));
+      WriteConfig.add("IfExists", std::string("replace"));
+      WriteConfig.add("Precision", Precision);
+      WriteConfig.add("Freq", 1);
+      WriteConfig.add("FreqUnits", std::string("years"));
+      WriteConfig.add("UseStartEnd", false);
+      WriteConfig.add("Contents", StageContents);
+      StreamsConfig.add(WriteConfig);
+
+      Config ReadConfig("StageRead" + Stage);
+      ReadConfig.add("UsePointerFile", false);
+      ReadConfig.add("Filename", Filename);
+      ReadConfig.add("Mode", std::string("read"));
+      ReadConfig.add("Precision", std::string("double"));
+      ReadConfig.add("Freq", 1);
+      ReadConfig.add("FreqUnits", std::string("OnStartup"));
+      ReadConfig.add("UseStartEnd", false);
+      ReadConfig.add("Contents", StageContents);
+      StreamsConfig.add(ReadConfig);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Adds an annual write stream of the TimeMeanTest field that is written as
+// subfiles and a stream to read the subfiles back. The number of subfiles
+// cannot exceed the number of tasks.
+void addSubfileStreams(Config *OmegaConfig, int NumTasks) {
+
+   Config StreamsConfig("IOStreams");
+   Error Err = OmegaConfig->get(StreamsConfig);
+   CHECK_ERROR_ABORT(Err, "IOStreamTest: IOStreams group not found");
+
+   std::vector<std::string> SubfileContents{"TimeMeanTest"};
+
+   Config WriteConfig("SubfileWrite");
+   WriteConfig.add("UsePointerFile", false);
+   WriteConfig.add("Filename", std::string("ocn.test.subfile"));
+   WriteConfig.add("Mode", std::string("write"));
+   WriteConfig.add("IfExists", std::string("replace"));
+   WriteConfig.add("Precision", std::string("double"));
+   WriteConfig.add("Subfiles", std::min(2, NumTasks));
+   WriteConfig.add("Freq", 1);
+   WriteConfig.add("FreqUnits", std::string("years"));
+   WriteConfig.add("UseStartEnd", false);
+   WriteConfig.add("Contents", SubfileContents);
+   StreamsConfig.add(WriteConfig);
+
+   Config ReadConfig("SubfileRead");
+   ReadConfig.add("UsePointerFile", false);
+   ReadConfig.add("Filename", std::string("ocn.test.subfile"));
+   ReadConfig.add("Mode", std::string("read"));
+   ReadConfig.add("Precision", std::string("double"));
+   ReadConfig.add("Freq", 1);
+   ReadConfig.add("FreqUnits", std::string("OnStartup"));
+   ReadConfig.add("UseStartEnd", false);
+   ReadConfig.add("Contents", SubfileContents);
+   StreamsConfig.add(ReadConfig);
+}
+
 //------------------------------------------------------------------------------
 // Initialization routine to create reference Fields
 int initIOStreamTest(Clock *&ModelClock // Model clock
@@ -70,6 +243,10 @@ int initIOStreamTest(Clock *&ModelClock // Model clock
    Config("Omega");
    Config::readAll("omega.yml");
    Config *OmegaConfig = Config::getOmegaConfig();
+   addTimeMeanStreams(OmegaConfig);
+   addStorageStreams(OmegaConfig);
+   addStagingStreams(OmegaConfig);
+   addSubfileStreams(OmegaConfig, DefEnv->getNumTasks());
 
    // Initialize the default time stepper (phase 1) that includes the
    // num time levels, calendar, model clock and start/stop times and alarms
@@ -119,6 +296,40 @@ int initIOStreamTest(Clock *&ModelClock // Model clock
    // Initialize Tracers
    Tracers::init();
 
+   // Create a cell field that is set each step and written as an annual mean
+   I4 NCellsSize = DefDecomp->NCellsSize;
+   std::vector<std::string> MeanDims{"NCells"};
+   std::shared_ptr<Field> MeanField =
+       Field::create("TimeMeanTest",             // field name
+                     "field to test time means", // long name or description
+                     "hours",                    // units
+                     "",                         // CF standard name
+                     0.0,                        // min valid value
+                     1.0e30,                     // max valid value
+                     -9.99e30,                   // value of undefined entries
+                     1,                          // number of dimensions
+                     MeanDims                    // dimension names
+       );
+   Array1DR8 MeanTest("TimeMeanTest", NCellsSize);
+   Err1 = MeanField->attachData<Array1DR8>(MeanTest);
+   TestEval("Attach time mean field data", Err1, ErrRef, Err);
+
+   // Create a host cell field that is written without staging
+   std::shared_ptr<Field> HostField =
+       Field::create("StageHostTest",                // field name
+                     "host field to test staging",   // long name
+                     "hours",                        // units
+                     "",                             // CF standard name
+                     0.0,                            // min valid value
+                     1.0e30,                         // max valid value
+                     -9.99e30,                       // fill value
+                     1,                              // number of dimensions
+                     MeanDims                        // dimension names
+       );
+   HostArray1DR8 HostTest("StageHostTest", NCellsSize);
+   Err1 = HostField->attachData<HostArray1DR8>(HostTest);
+   TestEval("Attach host staging field data", Err1, ErrRef, Err);
+
    // Add some global (Model and Simulation) metadata
    std::shared_ptr<Field> CodeField = Field::get(CodeMeta);
    std::shared_ptr<Field> SimField  = Field::get(SimMeta);
@@ -160,8 +371,10 @@ int main(int argc, char **argv) {
    int Err1   = 0;
    int ErrRef = 0;
 
-   // Initialize the global MPI and Kokkos environments
-   MPI_Init(&argc, &argv);
+   // Initialize the global MPI and Kokkos environments. Thread support is
+   // requested to test asynchronous writes if available.
+   int ThreadLevel;
+   MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &ThreadLevel);
    Kokkos::initialize();
    Pacer::initialize(MPI_COMM_WORLD);
    Pacer::setPrefix("Omega:");
@@ -203,13 +416,41 @@ int main(int argc, char **argv) {
       Alarm StopAlarm("Stop Time", StopTime);
       ModelClock->attachAlarm(&StopAlarm);
 
+      // Field written as an annual mean by the TimeMeanWrite stream
+      Array1DR8 MeanTest =
+          Field::get("TimeMeanTest")->getDataArray<Array1DR8>();
+      HostArray1DR8 HostTest =
+          Field::get("StageHostTest")->getDataArray<HostArray1DR8>();
+      HostArray1DI4 CellIDH = DefDecomp->CellIDH;
+
       // Overwrite
-      // Step forward in time and write files if it is time
+      // Step forward in time and write files if it is time. The steps
+      // alternate between one and three hours, which both divide a day, so
+      // that a mean weighted by the step length differs from the mean over
+      // the steps.
+      I8 IStep = 0;
       while (!StopAlarm.isRinging()) {
+         const I4 StepHours = (IStep % 2 == 0) ? 1 : 3;
+         ModelClock->changeTimeStep(TimeInterval(StepHours, TimeUnits::Hours));
          ModelClock->advance();
+         ++IStep;
          TimeInstant CurTime    = ModelClock->getCurrentTime();
          std::string CurTimeStr = CurTime.getString(4, 2, " ");
 
+         // The value of each step is the step length in hours plus a cell
+         // term to test the indexing
+         parallelFor(
+             {NCellsSize}, KOKKOS_LAMBDA(int Cell) {
+                MeanTest(Cell) = StepHours + 0.0001 * CellID(Cell);
+             });
+         for (int Cell = 0; Cell < NCellsSize; ++Cell)
+            HostTest(Cell) = StepHours + 0.0001 * CellIDH(Cell);
+
+         // Accumulate the fields of streams with a time reduction
+         Err1 = IOStream::accumulateAll(ModelClock);
+         if (Err1 != 0)
+            TestEval("Accumulate streams " + CurTimeStr, Err1, ErrRef, Err);
+
          Err1 = IOStream::writeAll(ModelClock);
          if (Err1 != 0) // to prevent too much output in log
             TestEval("Write all streams " + CurTimeStr, Err1, ErrRef, Err);
@@ -235,8 +476,122 @@ int main(int argc, char **argv) {
           DataReducer);
       TestEval("Check Salt array ", Err1, ErrRef, Err);
 
+      // Read back the annual mean of the test field. Equal numbers of one
+      // and three hour steps hold values of 1 and 3, so the mean weighted
+      // by the step length is (1 * 1 + 3 * 3) / 4 = 2.5 plus the cell term.
+      deepCopy(MeanTest, 0.0);
+      Err1 = IOStream::read("TimeMeanRead", ModelClock, ReqMetadata, ForceRead);
+      TestEval("Read time mean", Err1, IOStream::Success, Err);
+
+      Err1             = 0;
+      auto MeanReducer = Kokkos::Sum<I4>(Err1);
+
+      parallelReduce(
+          {NCellsOwned},
+          KOKKOS_LAMBDA(int Cell, I4 &Err1) {
+             const R8 Expected = 2.5 + 0.0001 * CellID(Cell);
+             if (Kokkos::fabs(MeanTest(Cell) - Expected) > 1.0e-10)
+                ++Err1;
+          },
+          MeanReducer);
+      TestEval("Check time-weighted mean", Err1, ErrRef, Err);
+
+      // Read back the files written with storage options. The NetCDF3
+      // stream must have dropped the options to write its file. The last
+      // step of each year is a three hour step, so both files hold 3 plus
+      // the cell term.
+      const std::vector<std::string> Formats{"netcdf4c", "netcdf3"};
+      for (const std::string &Format : Formats) {
+         deepCopy(MeanTest, 0.0);
+         Err1 = IOStream::read("StorageRead_" + Format, ModelClock,
+                               ReqMetadata, ForceRead);
+         TestEval("Read " + Format + " storage", Err1, IOStream::Success,
+                  Err);
+
+         Err1                = 0;
+         auto StorageReducer = Kokkos::Sum<I4>(Err1);
+
+         parallelReduce(
+             {NCellsOwned},
+             KOKKOS_LAMBDA(int Cell, I4 &Err1) {
+                const R8 Expected = 3.0 + 0.0001 * CellID(Cell);
+                if (MeanTest(Cell) != Expected)
+                   ++Err1;
+             },
+             StorageReducer);
+         TestEval("Check " + Format + " storage", Err1, ErrRef, Err);
+      }
+
+      // Read back the files written by each staging path. The last step of
+      // each year is a three hour step. The single precision file is only
+      // accurate to the R4 precision.
+      const std::vector<std::string> Stages{"Direct", "Device", "Single"};
+      for (const std::string &Stage : Stages) {
+         deepCopy(MeanTest, 0.0);
+         deepCopy(HostTest, 0.0);
+         Err1 = IOStream::read("StageRead" + Stage, ModelClock, ReqMetadata,
+                               ForceRead);
+         TestEval("Read " + Stage + " staging", Err1, IOStream::Success, Err);
+
+         const R8 Tol = Stage == "Single" ? 1.0e-6 : 0.0;
+         I4 NErr      = 0;
+         if (Stage == "Direct") {
+            for (int Cell = 0; Cell < NCellsOwned; ++Cell) {
+               const R8 Expected = 3.0 + 0.0001 * CellIDH(Cell);
+               if (std::abs(HostTest(Cell) - Expected) > Tol * Expected)
+                  ++NErr;
+            }
+         } else {
+            auto StageReducer = Kokkos::Sum<I4>(NErr);
+            parallelReduce(
+                {NCellsOwned},
+                KOKKOS_LAMBDA(int Cell, I4 &NErr) {
+                   const R8 Expected = 3.0 + 0.0001 * CellID(Cell);
+                   if (Kokkos::fabs(MeanTest(Cell) - Expected) >
+                       Tol * Expected)
+                      ++NErr;
+                },
+                StageReducer);
+         }
+         TestEval("Check " + Stage + " staging", NErr, ErrRef, Err);
+      }
+
+      // Read back the subfiles, which must replace the single file when
+      // there is more than one task
+      if (MachEnv::getDefault()->getNumTasks() > 1) {
+         bool Subfiled =
+             std::filesystem::exists(IO::subfileName("ocn.test.subfile", 0)) and
+             !std::filesystem::exists("ocn.test.subfile");
+         TestEval("Write subfiles", Subfiled, true, Err);
+      }
+
+      deepCopy(MeanTest, 0.0);
+      Err1 = IOStream::read("SubfileRead", ModelClock, ReqMetadata, ForceRead);
+      TestEval("Read subfiles", Err1, IOStream::Success, Err);
+
+      Err1                = 0;
+      auto SubfileReducer = Kokkos::Sum<I4>(Err1);
+
+      parallelReduce(
+          {NCellsOwned},
+          KOKKOS_LAMBDA(int Cell, I4 &Err1) {
+             const R8 Expected = 3.0 + 0.0001 * CellID(Cell);
+             if (MeanTest(Cell) != Expected)
+                ++Err1;
+          },
+          SubfileReducer);
+      TestEval("Check subfile data", Err1, ErrRef, Err);
+
+      // Start an asynchronous history write and finalize right away. The
+      // write must be complete once finalize returns.
+      Err1 = IOStream::write("History", ModelClock, true);
+      TestEval("Force async history write", Err1, IOStream::Success, Err);
+
       // Write final output and remove all streams
-      IOStream::finalize(ModelClock);
+      Err1 = IOStream::finalize(ModelClock);
+      TestEval("Finalize after async write", Err1, ErrRef, Err);
+      TestEval("No pending write after finalize", IOStream::hasPendingWrite(),
+               false, Err);
    }
 
    // Clean up environments
@@ -0,0 +1,158 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA logging options --------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA logging options
+///
+/// This driver tests the run-time logging options: the per-step message
+/// frequency, the asynchronous logger with errors written synchronously, a
+/// full queue that drops messages rather than blocking, and the writing of
+/// all queued messages at finalize.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "mpi.h"
+
+#include <spdlog/sinks/basic_file_sink.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// Reads the text written so far to the log file
+std::string readLog(const std::string &LogFile) {
+   std::ifstream LogStream(LogFile);
+   return std::string(std::istreambuf_iterator<char>(LogStream),
+                      std::istreambuf_iterator<char>());
+}
+
+//------------------------------------------------------------------------------
+// Counts the occurrences of a string in the log text
+int countMsg(const std::string &Log, const std::string &Msg) {
+   int Count          = 0;
+   std::size_t Offset = Log.find(Msg);
+   while (Offset != std::string::npos) {
+      ++Count;
+      Offset = Log.find(Msg, Offset + Msg.size());
+   }
+   return Count;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the logging options
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+
+      // Log to a file for each task so the written messages can be checked
+      // while the background thread writes to it
+      const std::string LogFile =
+          "LoggingConfigTest." + std::to_string(DefEnv->getMyTask()) + ".log";
+      auto Sink =
+          std::make_shared<spdlog::sinks::basic_file_sink_mt>(LogFile, true);
+      auto Logger = std::make_shared<spdlog::logger>("LoggingConfigTest", Sink);
+      initLogging(DefEnv, Logger);
+      bool LogTask = spdlog::default_logger()->level() != spdlog::level::off;
+
+      // A small queue so that a burst of messages overruns it
+      const I4 QueueSize = 16;
+      const I4 StepFreq  = 4;
+      Config("Omega");
+      Config LogConfig("Logging");
+      LogConfig.add("Async", true);
+      LogConfig.add("QueueSize", QueueSize);
+      LogConfig.add("FlushInterval", 0);
+      LogConfig.add("MasterLevel", std::string("info"));
+      LogConfig.add("OtherLevel", std::string("info"));
+      LogConfig.add("StepLogFreq", StepFreq);
+      Config::getOmegaConfig()->add(LogConfig);
+
+      configLogging(DefEnv);
+
+      // Per-step messages are only written every StepLogFreq steps
+      if (isLogStep(0) and !isLogStep(1) and !isLogStep(StepFreq - 1) and
+          isLogStep(StepFreq) and isLogStep(3 * StepFreq)) {
+         LOG_INFO("LoggingConfigTest: step frequency PASS");
+      } else {
+         LOG_ERROR("LoggingConfigTest: step frequency FAIL");
+         ++Err;
+      }
+
+      // An error is in the log as soon as the log call returns, without
+      // waiting for the background thread
+      const std::string ErrorMsg = "LoggingConfigTest: synchronous error";
+      LOG_ERROR(ErrorMsg);
+      if (!LogTask or countMsg(readLog(LogFile), ErrorMsg) == 1) {
+         LOG_INFO("LoggingConfigTest: synchronous errors PASS");
+      } else {
+         LOG_ERROR("LoggingConfigTest: synchronous errors FAIL");
+         ++Err;
+      }
+
+      // A burst of messages much larger than the queue returns without
+      // waiting for space. Each message is either written or dropped and
+      // counted, so the test only checks that the burst completes and that
+      // the last message, which is never the oldest, is written.
+      const I4 NBurst            = 100 * QueueSize;
+      const std::string BurstMsg = "LoggingConfigTest: burst message";
+      for (int I = 0; I < NBurst; ++I) {
+         LOG_INFO("{} {}", BurstMsg, I);
+      }
+      const std::string LastMsg = "LoggingConfigTest: last queued message";
+      LOG_INFO(LastMsg);
+
+      // Finalize writes every queued message and restores the synchronous
+      // logger, so a later message is written immediately
+      finalizeLogging();
+      const std::string SyncMsg = "LoggingConfigTest: after finalize";
+      LOG_INFO(SyncMsg);
+      spdlog::default_logger()->flush();
+      std::string Log = readLog(LogFile);
+      if (!LogTask or
+          (countMsg(Log, LastMsg) == 1 and countMsg(Log, SyncMsg) == 1 and
+           countMsg(Log, BurstMsg) <= NBurst)) {
+         LOG_INFO("LoggingConfigTest: finalize PASS");
+      } else {
+         LOG_ERROR("LoggingConfigTest: finalize FAIL");
+         ++Err;
+      }
+
+      // The error written synchronously is not written again by the queue
+      if (!LogTask or countMsg(Log, ErrorMsg) == 1) {
+         LOG_INFO("LoggingConfigTest: errors written once PASS");
+      } else {
+         LOG_ERROR("LoggingConfigTest: errors written once FAIL");
+         ++Err;
+      }
+
+      if (Err == 0)
+         LOG_INFO("LoggingConfigTest: Successful completion");
+
+      MachEnv::removeAll();
+   }
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
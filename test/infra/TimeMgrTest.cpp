@@ -389,6 +389,43 @@ void testTimeFrac(void) {
    if (DTst != 3 or WTst != 3 or NTst != 2)
       ErrAll += Error(ErrorCode::Fail, "TimeMgrTest/TimeFrac: simplify: FAIL");
 
+   // Test normalize function, which keeps the denominator
+
+   Tst2TF.set(2, 10, 6);
+   Tst2TF.normalize();
+   Tst2TF.get(WTst, NTst, DTst);
+
+   if (DTst != 6 or WTst != 3 or NTst != 4)
+      ErrAll += Error(ErrorCode::Fail, "TimeMgrTest/TimeFrac: normalize: FAIL");
+
+   // Test comparison and arithmetic on a shared denominator, including
+   // fractions that are not in proper form
+
+   Tst1TF.set(1, 5, 4);
+   Tst2TF.set(2, 1, 4);
+   if (Tst1TF != Tst2TF or !(Tst1TF == Tst2TF) or !(Tst1TF <= Tst2TF) or
+       !(Tst1TF >= Tst2TF) or Tst1TF < Tst2TF or Tst1TF > Tst2TF)
+      ErrAll += Error(ErrorCode::Fail,
+                      "TimeMgrTest/TimeFrac: shared denominator compare: FAIL");
+
+   Tst2TF.set(-1, -3, 4);
+   if (!(Tst2TF < Tst1TF) or !(Tst1TF > Tst2TF))
+      ErrAll += Error(ErrorCode::Fail,
+                      "TimeMgrTest/TimeFrac: shared denominator sign: FAIL");
+
+   Tst1TF.set(1, 3, 4);
+   Tst2TF.set(2, 1, 4);
+   (Tst1TF + Tst2TF).get(WTst, NTst, DTst);
+   if (WTst != 4 or NTst != 0 or DTst != 1)
+      ErrAll += Error(ErrorCode::Fail,
+                      "TimeMgrTest/TimeFrac: shared denominator add: FAIL");
+
+   (Tst2TF - Tst1TF).get(WTst, NTst, DTst);
+   if (WTst != 0 or NTst != 1 or DTst != 2)
+      ErrAll +=
+          Error(ErrorCode::Fail,
+                "TimeMgrTest/TimeFrac: shared denominator subtract: FAIL");
+
    // Test convert function
 
    Tst2TF.set(2, 5, 3);
@@ -3179,6 +3216,55 @@ void testAlarm(void) {
       }
    }
 
+   // Test alarms with sub-second ring times and intervals, as used for
+   // substeps, that ring within a whole second
+
+   TimeInstant TimeSubSec(2019, 8, 15, 14, 25, 33.75);
+   Alarm AlarmSubSec("Sub-second", TimeSubSec);
+
+   TimeInterval IntervalSubSec(1, 1, 2);
+   Alarm AlarmEverySubSec("Every 1.5 Seconds", IntervalSubSec, StartTime);
+   TimeInterval IntervalQuarter(0, 1, 4);
+
+   CurTime = StartTime; // start time is 2019-08-15_14:25:23.25
+
+   for (int N = 1; N <= 80; ++N) {
+      // increment time in quarter-second intervals
+      CurTime += IntervalQuarter;
+
+      // update alarm state based on current time
+      AlarmSubSec.updateStatus(CurTime);
+      AlarmEverySubSec.updateStatus(CurTime);
+
+      // Test whether one-time alarm should be ringing or not
+      if (N == 42) {
+         if (!(AlarmSubSec.isRinging()))
+            ErrAll += Error(ErrorCode::Fail,
+                            "TimeMgrTest/Alarm: one-time sub-second alarm: "
+                            "FAIL");
+         AlarmSubSec.stop();
+      } else {
+         if (AlarmSubSec.isRinging())
+            ErrAll += Error(ErrorCode::Fail,
+                            "TimeMgrTest/Alarm: one-time sub-second alarm "
+                            "should not be ringing: FAIL");
+      }
+
+      // Test whether interval alarm should be ringing or not
+      if (N % 6 == 0) {
+         if (!(AlarmEverySubSec.isRinging()))
+            ErrAll += Error(ErrorCode::Fail,
+                            "TimeMgrTest/Alarm: periodic sub-second alarm: "
+                            "FAIL");
+         AlarmEverySubSec.reset(CurTime);
+      } else {
+         if (AlarmEverySubSec.isRinging())
+            ErrAll += Error(ErrorCode::Fail,
+                            "TimeMgrTest/Alarm: periodic sub-second alarm "
+                            "should not be ringing: FAIL");
+      }
+   }
+
    CHECK_ERROR_ABORT(ErrAll, "TimeMgr/Alarm unit tests FAIL");
 
 } // end testAlarm
@@ -0,0 +1,174 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA Timing class -----------------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for OMEGA Timing class
+///
+/// This driver tests the hierarchical region timers, including the nesting
+/// of region paths, the accumulation of calls and bytes, the scoped regions
+/// and the summary across tasks.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "Timing.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "mpi.h"
+
+using namespace OMEGA;
+
+//------------------------------------------------------------------------------
+// A kernel to time, touching two arrays of NCells entries
+void runKernel(const Array1DReal &A, const Array1DReal &B, I4 NCells) {
+   parallelFor(
+       "timingTestKernel", {NCells},
+       KOKKOS_LAMBDA(int ICell) { B(ICell) = 2._Real * A(ICell); });
+}
+
+//------------------------------------------------------------------------------
+// The test driver for Timing
+int main(int argc, char *argv[]) {
+
+   int Err = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   {
+      MachEnv::init(MPI_COMM_WORLD);
+      MachEnv *DefEnv = MachEnv::getDefault();
+      initLogging(DefEnv);
+      MPI_Comm DefComm = DefEnv->getComm();
+      Pacer::initialize(DefComm);
+      Pacer::setPrefix("Omega:");
+
+      Config("Omega");
+      Config::readAll("omega.yml");
+      Timing::init();
+
+      // Fence in every region so the kernel is included in its time
+      Timing::setOptions(true, true);
+
+      const I4 NCells = 100000;
+      Array1DReal A("A", NCells);
+      Array1DReal B("B", NCells);
+      deepCopy(A, 1._Real);
+      const R8 KernelBytes = 2.0 * NCells * sizeof(Real);
+
+      // Nested regions are recorded under the path of the enclosing regions
+      const I4 NCalls = 3;
+      Timing::start("outer");
+      for (int I = 0; I < NCalls; ++I) {
+         Timing::start("kernel");
+         runKernel(A, B, NCells);
+         Timing::stop("kernel", KernelBytes);
+      }
+      Timing::stop("outer");
+
+      Timing::RegionStats Outer = Timing::getStats("outer");
+      Timing::RegionStats Inner = Timing::getStats("outer:kernel");
+      if (Outer.Calls == 1 and Inner.Calls == NCalls and
+          Inner.Bytes == NCalls * KernelBytes and Inner.Time > 0 and
+          Outer.Time >= Inner.Time) {
+         LOG_INFO("TimingTest: nested regions PASS");
+      } else {
+         LOG_ERROR("TimingTest: nested regions FAIL");
+         ++Err;
+      }
+
+      // A top-level region of the same name is a separate region
+      if (Timing::getStats("kernel").Calls == 0 and
+          Timing::getTotalStats("kernel").Calls == NCalls) {
+         LOG_INFO("TimingTest: region paths PASS");
+      } else {
+         LOG_ERROR("TimingTest: region paths FAIL");
+         ++Err;
+      }
+
+      // The total over paths includes the region wherever it was timed but
+      // counts a region nested in itself once
+      Timing::start("kernel");
+      Timing::start("kernel");
+      runKernel(A, B, NCells);
+      Timing::stop("kernel", KernelBytes);
+      Timing::stop("kernel", KernelBytes);
+      Timing::RegionStats Total = Timing::getTotalStats("kernel");
+      if (Total.Calls == NCalls + 1 and
+          Total.Bytes == (NCalls + 1) * KernelBytes) {
+         LOG_INFO("TimingTest: total over paths PASS");
+      } else {
+         LOG_ERROR("TimingTest: total over paths FAIL");
+         ++Err;
+      }
+
+      // A scoped region is stopped when it goes out of scope
+      {
+         TimingRegion Region("scoped", KernelBytes);
+         runKernel(A, B, NCells);
+      }
+      Timing::RegionStats Scoped = Timing::getStats("scoped");
+      if (Scoped.Calls == 1 and Scoped.Bytes == KernelBytes) {
+         LOG_INFO("TimingTest: scoped region PASS");
+      } else {
+         LOG_ERROR("TimingTest: scoped region FAIL");
+         ++Err;
+      }
+
+      // Stopping a region that is not the innermost is rejected and does
+      // not stop the innermost region
+      Timing::start("first");
+      Timing::start("second");
+      Timing::stop("first");
+      Timing::stop("second");
+      Timing::stop("first");
+      if (Timing::getStats("first").Calls == 1 and
+          Timing::getStats("first:second").Calls == 1) {
+         LOG_INFO("TimingTest: mismatched stop PASS");
+      } else {
+         LOG_ERROR("TimingTest: mismatched stop FAIL");
+         ++Err;
+      }
+
+      // No statistics are accumulated when timing is disabled
+      Timing::setOptions(false, false);
+      Timing::start("disabled");
+      Timing::stop("disabled");
+      Timing::setOptions(true, false);
+      if (Timing::getStats("disabled").Calls == 0) {
+         LOG_INFO("TimingTest: disabled timers PASS");
+      } else {
+         LOG_ERROR("TimingTest: disabled timers FAIL");
+         ++Err;
+      }
+
+      // The summary is collective over all tasks
+      Timing::printSummary(DefComm);
+
+      Timing::clear();
+      if (Timing::getStats("outer").Calls == 0) {
+         LOG_INFO("TimingTest: clear PASS");
+      } else {
+         LOG_ERROR("TimingTest: clear FAIL");
+         ++Err;
+      }
+
+      Pacer::finalize();
+      MachEnv::removeAll();
+   }
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (Err >= 256)
+      Err = 255;
+
+   return Err;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
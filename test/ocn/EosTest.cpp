@@ -46,11 +46,12 @@ const Real LinearExpValue =
     0.0009784735812133072; // Expected value for Linear eos
 
 /// Test input values
-double Sa       = 30.0;   // Absolute Salinity in g/kg
-double Ct       = 10.0;   // Conservative Temperature in degC
-double P        = 1000.0; // Pressure in dbar
-const I4 KDisp  = 1;      // Displace parcel to K=1 for TEOS-10 eos
-const Real RTol = 1e-10;  // Relative tolerance for isApprox checks
+double Sa            = 30.0;   // Absolute Salinity in g/kg
+double Ct            = 10.0;   // Conservative Temperature in degC
+double P             = 1000.0; // Pressure in dbar
+const I4 KDisp       = 1;      // Displace parcel to K=1 for TEOS-10 eos
+const Real RTol      = 1e-10;  // Relative tolerance for isApprox checks
+const Real TableRTol = 1e-5;   // Relative tolerance for the TEOS-10 table
 
 /// The initialization routine for Eos testing. It calls various
 /// init routines, including the creation of the default decomposition.
@@ -294,6 +295,124 @@ int testEosTeos10Displaced() {
    return Err;
 }
 
+/// Test that the combined local and displaced TEOS-10 calculation matches
+/// the separate calculations, using a pressure that varies with depth
+int testEosTeos10Both() {
+   int Err          = 0;
+   const auto *Mesh = HorzMesh::getDefault();
+   /// Get Eos instance to test
+   Eos *TestEos       = Eos::getInstance();
+   TestEos->EosChoice = EosType::Teos10Eos;
+
+   /// Create and fill ocean state arrays
+   Array2DReal SArray = Array2DReal("SArray", Mesh->NCellsAll, NVertLevels);
+   Array2DReal TArray = Array2DReal("TArray", Mesh->NCellsAll, NVertLevels);
+   Array2DReal PArray = Array2DReal("PArray", Mesh->NCellsAll, NVertLevels);
+   deepCopy(SArray, Sa);
+   deepCopy(TArray, Ct);
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) { PArray(ICell, K) = 10.0 * (K + 1); });
+
+   /// Compute the reference values with the separate calls
+   Array2DReal RefSpecVol("RefSpecVol", Mesh->NCellsAll, NVertLevels);
+   Array2DReal RefSpecVolDisp("RefSpecVolDisp", Mesh->NCellsAll, NVertLevels);
+   TestEos->computeSpecVol(TArray, SArray, PArray);
+   deepCopy(RefSpecVol, TestEos->SpecVol);
+   TestEos->computeSpecVolDisp(TArray, SArray, PArray, KDisp);
+   deepCopy(RefSpecVolDisp, TestEos->SpecVolDisplaced);
+
+   /// Compute both in one pass
+   deepCopy(TestEos->SpecVol, 0.0);
+   deepCopy(TestEos->SpecVolDisplaced, 0.0);
+   TestEos->computeSpecVolAndDisp(TArray, SArray, PArray, KDisp);
+
+   /// The same operations are done, so the results must match exactly
+   int numMismatches            = 0;
+   Array2DReal SpecVol          = TestEos->SpecVol;
+   Array2DReal SpecVolDisplaced = TestEos->SpecVolDisplaced;
+   parallelReduce(
+       "CheckSpecVolBoth-Teos", {Mesh->NCellsAll, NVertLevels},
+       KOKKOS_LAMBDA(int i, int j, int &localCount) {
+          if (SpecVol(i, j) != RefSpecVol(i, j) ||
+              SpecVolDisplaced(i, j) != RefSpecVolDisp(i, j)) {
+             localCount++;
+          }
+       },
+       numMismatches);
+
+   if (numMismatches != 0) {
+      Err++;
+      LOG_ERROR("EosTest: TEOS SpecVolAndDisp FAIL with {} mismatches",
+                numMismatches);
+   }
+   if (Err == 0) {
+      LOG_INFO("EosTest SpecVolAndDisp TEOS-10: PASS");
+   }
+
+   return Err;
+}
+
+/// Test the tabulated TEOS-10 EOS against the polynomial, using values
+/// between the grid points of the default table in all three coordinates
+int testEosTeos10Table() {
+   int Err          = 0;
+   const auto *Mesh = HorzMesh::getDefault();
+   /// Get Eos instance to test
+   Eos *TestEos       = Eos::getInstance();
+   TestEos->EosChoice = EosType::Teos10Eos;
+
+   /// Create and fill ocean state arrays
+   Array2DReal SArray = Array2DReal("SArray", Mesh->NCellsAll, NVertLevels);
+   Array2DReal TArray = Array2DReal("TArray", Mesh->NCellsAll, NVertLevels);
+   Array2DReal PArray = Array2DReal("PArray", Mesh->NCellsAll, NVertLevels);
+   deepCopy(SArray, Sa + 0.61);
+   deepCopy(TArray, Ct + 0.37);
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K) { PArray(ICell, K) = 85.0 * K + 12.0; });
+
+   /// Compute the reference values with the polynomial
+   Array2DReal RefSpecVol("RefSpecVol", Mesh->NCellsAll, NVertLevels);
+   Array2DReal RefSpecVolDisp("RefSpecVolDisp", Mesh->NCellsAll, NVertLevels);
+   TestEos->computeSpecVolAndDisp(TArray, SArray, PArray, KDisp);
+   deepCopy(RefSpecVol, TestEos->SpecVol);
+   deepCopy(RefSpecVolDisp, TestEos->SpecVolDisplaced);
+
+   /// Build the table and compute both from the table
+   TestEos->initTeos10Table();
+   TestEos->EosChoice = EosType::Teos10TableEos;
+   TestEos->computeSpecVolAndDisp(TArray, SArray, PArray, KDisp);
+
+   int numMismatches            = 0;
+   Array2DReal SpecVol          = TestEos->SpecVol;
+   Array2DReal SpecVolDisplaced = TestEos->SpecVolDisplaced;
+   parallelReduce(
+       "CheckSpecVolTable-Teos", {Mesh->NCellsAll, NVertLevels},
+       KOKKOS_LAMBDA(int i, int j, int &localCount) {
+          if (!isApprox(SpecVol(i, j), RefSpecVol(i, j), TableRTol) ||
+              !isApprox(SpecVolDisplaced(i, j), RefSpecVolDisp(i, j),
+                        TableRTol)) {
+             localCount++;
+          }
+       },
+       numMismatches);
+
+   auto SpecVolH    = createHostMirrorCopy(SpecVol);
+   auto RefSpecVolH = createHostMirrorCopy(RefSpecVol);
+   if (numMismatches != 0) {
+      Err++;
+      LOG_ERROR("EosTest: TEOS table SpecVol isApprox FAIL, "
+                "expected {}, got {} with {} mismatches",
+                RefSpecVolH(1, 1), SpecVolH(1, 1), numMismatches);
+   }
+   if (Err == 0) {
+      LOG_INFO("EosTest SpecVolCalc TEOS-10 table: PASS");
+   }
+
+   return Err;
+}
+
 /// Finalize and clean up all test infrastructure
 void finalizeEosTest() {
    HorzMesh::clear();
@@ -333,6 +452,8 @@ int checkValueGswcSpecVol() {
 // --> next checks the value on a Eos with linear displaced option
 // --> next checks the value on a Eos with TEOS-10 option
 // --> next checks the value on a Eos with TEOS-10 displaced option
+// --> next checks the combined TEOS-10 option against the separate ones
+// --> next checks the tabulated TEOS-10 option against the polynomial
 int eosTest(const std::string &MeshFile = "OmegaMesh.nc") {
    int Err = initEosTest(MeshFile);
    if (Err != 0) {
@@ -348,6 +469,8 @@ int eosTest(const std::string &MeshFile = "OmegaMesh.nc") {
    Err += testEosLinearDisplaced();
    Err += testEosTeos10();
    Err += testEosTeos10Displaced();
+   Err += testEosTeos10Both();
+   Err += testEosTeos10Table();
 
    if (Err == 0) {
       LOG_INFO("EosTest: Successful completion");
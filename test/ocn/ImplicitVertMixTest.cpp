@@ -0,0 +1,351 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA implicit vertical mixing ----------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the implicit vertical mixing
+///
+/// This driver tests the batched tridiagonal solves of the ImplicitVertMix
+/// class. The tracers and velocity are mixed with large coefficients and the
+/// solution is checked by evaluating the residual of the tridiagonal system
+/// of every owned column on the host. The column integrals must be conserved
+/// and the levels outside the active range of each column left unchanged.
+//
+//===-----------------------------------------------------------------------===/
+
+#include "ImplicitVertMix.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Decomp.h"
+#include "Dimension.h"
+#include "Error.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "IO.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanTestCommon.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "StencilCoeffs.h"
+#include "mpi.h"
+
+#include <cmath>
+
+using namespace OMEGA;
+
+/// Test constants
+constexpr int NVertLevels = 16;
+constexpr int NTracers    = 3;
+const Real Diffusivity    = 1.0e-2; // large enough to mix over many levels
+const Real Viscosity      = 1.0e-1;
+const Real Dt             = 3600.0;
+const Real RTol           = sizeof(Real) == 4 ? 1e-4 : 1e-10;
+
+constexpr char DefaultMeshFile[] = "OmegaPlanarMesh.nc";
+
+/// The initialization routine for the implicit vertical mixing test
+void initVertMixTest(const std::string &MeshFile) {
+
+   Error Err;
+
+   MachEnv::init(MPI_COMM_WORLD);
+   MachEnv *DefEnv  = MachEnv::getDefault();
+   MPI_Comm DefComm = DefEnv->getComm();
+
+   initLogging(DefEnv);
+
+   Config("Omega");
+   Config::readAll("omega.yml");
+
+   // Reset NVertLevels to the test value
+   Config *OmegaConfig = Config::getOmegaConfig();
+   Config DimConfig("Dimension");
+   Err += OmegaConfig->get(DimConfig);
+   CHECK_ERROR_ABORT(
+       Err, "ImplicitVertMixTest: Dimension group not found in Config");
+   DimConfig.set("NVertLevels", NVertLevels);
+
+   I4 IOErr = IO::init(DefComm);
+   if (IOErr != 0)
+      ABORT_ERROR("ImplicitVertMixTest: error initializing parallel IO");
+
+   Decomp::init(MeshFile);
+
+   int HaloErr = Halo::init();
+   if (HaloErr != 0)
+      ABORT_ERROR("ImplicitVertMixTest: error initializing default halo");
+
+   HorzMesh::init();
+
+} // end initVertMixTest
+
+/// Finalize and clean up all test infrastructure
+void finalizeVertMixTest() {
+
+   ImplicitVertMix::clear();
+   StencilCoeffs::clear();
+   HorzMesh::clear();
+   Dimension::clear();
+   Halo::clear();
+   Decomp::clear();
+   MachEnv::removeAll();
+
+} // end finalizeVertMixTest
+
+/// Checks one column of a solve. Thick(K) and Coeff(K) are the thickness and
+/// the mixing coefficient at the top of level K, Old and New the values
+/// before and after mixing. Returns the number of failed checks.
+template <class ThickFn, class CoeffFn, class OldFn, class NewFn>
+int checkColumn(I4 MinLevel, I4 MaxLevel, ThickFn Thick, CoeffFn Coeff,
+                OldFn Old, NewFn New) {
+
+   int NFail   = 0;
+   Real SumOld = 0;
+   Real SumNew = 0;
+   Real SumAbs = 0;
+
+   for (int K = 0; K < NVertLevels; ++K) {
+      // Levels outside the active range are not modified
+      if (K < MinLevel || K > MaxLevel) {
+         if (New(K) != Old(K))
+            ++NFail;
+         continue;
+      }
+
+      Real Above = 0;
+      Real Below = 0;
+      if (K > MinLevel)
+         Above = 2 * Dt * Coeff(K) / (Thick(K - 1) + Thick(K));
+      if (K < MaxLevel)
+         Below = 2 * Dt * Coeff(K + 1) / (Thick(K) + Thick(K + 1));
+
+      Real Resid = (Thick(K) + Above + Below) * New(K) - Thick(K) * Old(K);
+      if (K > MinLevel)
+         Resid -= Above * New(K - 1);
+      if (K < MaxLevel)
+         Resid -= Below * New(K + 1);
+
+      const Real Scale =
+          (Thick(K) + Above + Below) * (std::abs(Old(K)) + std::abs(New(K)));
+      if (std::abs(Resid) > RTol * Scale)
+         ++NFail;
+
+      SumOld += Thick(K) * Old(K);
+      SumNew += Thick(K) * New(K);
+      SumAbs += Thick(K) * std::abs(Old(K));
+   }
+
+   // The column integral is conserved
+   if (std::abs(SumNew - SumOld) > RTol * SumAbs)
+      ++NFail;
+
+   return NFail;
+}
+
+/// Mixes a set of tracers and checks the solution in every owned column
+int testMixTracers(ImplicitVertMix &VertMix) {
+
+   int Err          = 0;
+   const auto *Mesh = HorzMesh::getDefault();
+
+   Array2DReal LayerThick("LayerThick", Mesh->NCellsSize, NVertLevels);
+   Array3DReal TracerArray("TracerArray", NTracers, Mesh->NCellsSize,
+                           NVertLevels);
+
+   parallelFor(
+       {Mesh->NCellsSize, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = 10 + K + 0.1_Real * (ICell % 7);
+       });
+   parallelFor(
+       {NTracers, Mesh->NCellsSize, NVertLevels},
+       KOKKOS_LAMBDA(int L, int ICell, int K) {
+          TracerArray(L, ICell, K) = (L + 1) * Kokkos::cos(Real(K)) +
+                                     (ICell % 5) + 10 * L;
+       });
+
+   auto OldTracersH = createHostMirrorCopy(TracerArray);
+   VertMix.mixTracers(TracerArray, LayerThick, Dt);
+   auto NewTracersH = createHostMirrorCopy(TracerArray);
+
+   auto LayerThickH = createHostMirrorCopy(LayerThick);
+   auto VertDiffH   = createHostMirrorCopy(VertMix.VertDiff);
+   auto MinLevelH   = createHostMirrorCopy(VertMix.getMinLevelCell());
+   auto MaxLevelH   = createHostMirrorCopy(VertMix.getMaxLevelCell());
+
+   // The columns span the levels of the cell itself, which include the
+   // levels of all its edges
+   auto *Coeffs       = StencilCoeffs::get(Mesh);
+   auto MinEdgeLevelH = createHostMirrorCopy(Coeffs->MinLevelCell);
+   auto MaxEdgeLevelH = createHostMirrorCopy(Coeffs->MaxLevelCell);
+
+   int NFail = 0;
+   for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+      if (MinEdgeLevelH(ICell) <= MaxEdgeLevelH(ICell) &&
+          (MinLevelH(ICell) > MinEdgeLevelH(ICell) ||
+           MaxLevelH(ICell) < MaxEdgeLevelH(ICell)))
+         ++NFail;
+   }
+   for (int L = 0; L < NTracers; ++L) {
+      for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+         NFail += checkColumn(
+             MinLevelH(ICell), MaxLevelH(ICell),
+             [&](int K) { return LayerThickH(ICell, K); },
+             [&](int K) { return VertDiffH(ICell, K); },
+             [&](int K) { return OldTracersH(L, ICell, K); },
+             [&](int K) { return NewTracersH(L, ICell, K); });
+      }
+   }
+
+   if (NFail != 0) {
+      ++Err;
+      LOG_ERROR("ImplicitVertMixTest: mixTracers FAIL with {} failed checks",
+                NFail);
+   } else {
+      LOG_INFO("ImplicitVertMixTest: mixTracers PASS");
+   }
+
+   return Err;
+}
+
+/// Mixes the normal velocity and checks the solution on every owned edge
+int testMixVelocity(ImplicitVertMix &VertMix) {
+
+   int Err          = 0;
+   const auto *Mesh = HorzMesh::getDefault();
+
+   Array2DReal LayerThick("LayerThick", Mesh->NCellsSize, NVertLevels);
+   Array2DReal NormalVel("NormalVel", Mesh->NEdgesSize, NVertLevels);
+
+   parallelFor(
+       {Mesh->NCellsSize, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = 20 - K + 0.1_Real * (ICell % 3);
+       });
+   parallelFor(
+       {Mesh->NEdgesSize, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          NormalVel(IEdge, K) = Kokkos::sin(Real(K)) + 0.01_Real * (IEdge % 3);
+       });
+
+   auto OldVelH = createHostMirrorCopy(NormalVel);
+   VertMix.mixVelocity(NormalVel, LayerThick, Dt);
+   auto NewVelH = createHostMirrorCopy(NormalVel);
+
+   auto LayerThickH  = createHostMirrorCopy(LayerThick);
+   auto VertViscH    = createHostMirrorCopy(VertMix.VertVisc);
+   auto CellsOnEdgeH = createHostMirrorCopy(Mesh->CellsOnEdge);
+   auto *Coeffs      = StencilCoeffs::get(Mesh);
+   auto MinLevelH    = createHostMirrorCopy(Coeffs->MinLevelEdge);
+   auto MaxLevelH    = createHostMirrorCopy(Coeffs->MaxLevelEdge);
+
+   int NFail = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+      const I4 Cell1 = CellsOnEdgeH(IEdge, 0);
+      const I4 Cell2 = CellsOnEdgeH(IEdge, 1);
+      NFail += checkColumn(
+          MinLevelH(IEdge), MaxLevelH(IEdge),
+          [&](int K) {
+             return 0.5_Real * (LayerThickH(Cell1, K) + LayerThickH(Cell2, K));
+          },
+          [&](int K) {
+             return 0.5_Real * (VertViscH(Cell1, K) + VertViscH(Cell2, K));
+          },
+          [&](int K) { return OldVelH(IEdge, K); },
+          [&](int K) { return NewVelH(IEdge, K); });
+   }
+
+   if (NFail != 0) {
+      ++Err;
+      LOG_ERROR("ImplicitVertMixTest: mixVelocity FAIL with {} failed checks",
+                NFail);
+   } else {
+      LOG_INFO("ImplicitVertMixTest: mixVelocity PASS");
+   }
+
+   return Err;
+}
+
+/// Checks that a uniform tracer is unchanged by mixing
+int testUniformTracer(ImplicitVertMix &VertMix) {
+
+   int Err          = 0;
+   const auto *Mesh = HorzMesh::getDefault();
+   const Real Value = 35.0;
+
+   Array2DReal LayerThick("LayerThick", Mesh->NCellsSize, NVertLevels);
+   Array3DReal TracerArray("TracerArray", 1, Mesh->NCellsSize, NVertLevels);
+   parallelFor(
+       {Mesh->NCellsSize, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          LayerThick(ICell, K) = 1 + K * K;
+       });
+   deepCopy(TracerArray, Value);
+
+   VertMix.mixTracers(TracerArray, LayerThick, Dt);
+
+   int NMismatch = 0;
+   parallelReduce(
+       {Mesh->NCellsOwned, NVertLevels},
+       KOKKOS_LAMBDA(int ICell, int K, int &Accum) {
+          if (Kokkos::abs(TracerArray(0, ICell, K) - Value) > RTol * Value)
+             ++Accum;
+       },
+       NMismatch);
+
+   if (NMismatch != 0) {
+      ++Err;
+      LOG_ERROR("ImplicitVertMixTest: uniform tracer FAIL with {} mismatches",
+                NMismatch);
+   } else {
+      LOG_INFO("ImplicitVertMixTest: uniform tracer PASS");
+   }
+
+   return Err;
+}
+
+// the main test (all in one to have the same log)
+int implicitVertMixTest(const std::string &MeshFile = DefaultMeshFile) {
+
+   initVertMixTest(MeshFile);
+
+   const auto *Mesh = HorzMesh::getDefault();
+   ImplicitVertMix VertMix(Mesh, Diffusivity, Viscosity);
+
+   LOG_INFO("ImplicitVertMixTest: VecLength {}", VecLength);
+
+   int Err = 0;
+   Err += testUniformTracer(VertMix);
+   Err += testMixTracers(VertMix);
+   Err += testMixVelocity(VertMix);
+
+   if (Err == 0)
+      LOG_INFO("ImplicitVertMixTest: Successful completion");
+
+   finalizeVertMixTest();
+
+   return Err;
+}
+
+// The test driver for the implicit vertical mixing
+int main(int argc, char *argv[]) {
+
+   int RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize(argc, argv);
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+
+   RetVal += implicitVertMixTest();
+
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -20,17 +20,21 @@
 //
 //===-----------------------------------------------------------------------===/
 #include "TendencyTerms.h"
+#include "AuxDependencies.h"
 #include "DataTypes.h"
 #include "Decomp.h"
 #include "Dimension.h"
 #include "Error.h"
+#include "FusedAuxVars.h"
 #include "Halo.h"
 #include "HorzMesh.h"
 #include "IO.h"
 #include "Logging.h"
 #include "OceanTestCommon.h"
 #include "OmegaKokkos.h"
+#include "OmegaSimd.h"
 #include "Pacer.h"
+#include "StencilCoeffs.h"
 #include "mpi.h"
 
 #include <cmath>
@@ -838,6 +842,191 @@ int testBottomDrag(int NVertLevels, Real RTol) {
    return Err;
 } // end testBottomDrag
 
+int testFusedVelocityTend(int NVertLevels) {
+
+   int Err = 0;
+   TestSetup Setup;
+
+   const auto Mesh   = HorzMesh::getDefault();
+   const int NChunks = NVertLevels / VecLength;
+
+   // Set input arrays
+   FusedVelocityTendOnEdge::Inputs In;
+
+   In.NormRVortEdge = Array2DReal("NormRVortEdge", Mesh->NEdgesSize,
+                                  NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.normRelVort(X, Y); },
+       In.NormRVortEdge, Geom, Mesh, OnEdge);
+
+   In.NormFEdge = Array2DReal("NormFEdge", Mesh->NEdgesSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.normPlanetVort(X, Y); },
+       In.NormFEdge, Geom, Mesh, OnEdge);
+
+   In.LayerThickEdge = Array2DReal("LayerThickEdge", Mesh->NEdgesSize,
+                                   NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.layerThick(X, Y); },
+       In.LayerThickEdge, Geom, Mesh, OnEdge);
+   In.FluxLayerThickEdge = In.LayerThickEdge;
+
+   In.NormVelEdge = Array2DReal("NormVelEdge", Mesh->NEdgesSize, NVertLevels);
+   Err += setVectorEdge(
+       KOKKOS_LAMBDA(Real(&VecField)[2], Real X, Real Y) {
+          VecField[0] = Setup.vectorX(X, Y);
+          VecField[1] = Setup.vectorY(X, Y);
+       },
+       In.NormVelEdge, EdgeComponent::Normal, Geom, Mesh);
+
+   In.NormalStressEdge = Array1DReal("NormalStressEdge", Mesh->NEdgesSize);
+   Err += setVectorEdge(
+       KOKKOS_LAMBDA(Real(&VecField)[2], Real X, Real Y) {
+          VecField[0] = Setup.vectorY(X, Y);
+          VecField[1] = Setup.vectorX(X, Y);
+       },
+       In.NormalStressEdge, EdgeComponent::Normal, Geom, Mesh);
+
+   In.KECell = Array2DReal("KECell", Mesh->NCellsSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) {
+          return Setup.scalarA(X, Y) * Setup.scalarA(X, Y) / 2;
+       },
+       In.KECell, Geom, Mesh, OnCell);
+
+   In.SshCell = Array2DReal("SshCell", Mesh->NCellsSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalar(X, Y); },
+       In.SshCell, Geom, Mesh, OnCell);
+
+   In.DivCell = Array2DReal("DivCell", Mesh->NCellsSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.divergence(X, Y); },
+       In.DivCell, Geom, Mesh, OnCell);
+
+   In.RVortVertex = Array2DReal("RVortVertex", Mesh->NVerticesSize,
+                                NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.curl(X, Y); },
+       In.RVortVertex, Geom, Mesh, OnVertex);
+
+   In.Del2DivCell = Array2DReal("Del2DivCell", Mesh->NCellsSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalarB(X, Y); },
+       In.Del2DivCell, Geom, Mesh, OnCell);
+
+   In.Del2RVortVertex = Array2DReal("Del2RVortVertex", Mesh->NVerticesSize,
+                                    NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalarC(X, Y); },
+       In.Del2RVortVertex, Geom, Mesh, OnVertex);
+
+   // Enable all terms with arbitrary coefficients
+   PotentialVortHAdvOnEdge PotVortHAdvOnE(Mesh);
+   KEGradOnEdge KEGradOnE(Mesh);
+   SSHGradOnEdge SSHGradOnE(Mesh);
+   VelocityDiffusionOnEdge VelDiffOnE(Mesh);
+   VelocityHyperDiffOnEdge VelHyperDiffOnE(Mesh);
+   WindForcingOnEdge WindForcingOnE(Mesh);
+   BottomDragOnEdge BottomDragOnE(Mesh);
+
+   PotVortHAdvOnE.Enabled          = true;
+   KEGradOnE.Enabled               = true;
+   SSHGradOnE.Enabled              = true;
+   VelDiffOnE.Enabled              = true;
+   VelDiffOnE.ViscDel2             = 0.123456789;
+   VelHyperDiffOnE.Enabled         = true;
+   VelHyperDiffOnE.ViscDel4        = 0.0123456789;
+   VelHyperDiffOnE.DivFactor       = 1.0;
+   WindForcingOnE.Enabled          = true;
+   WindForcingOnE.SaltWaterDensity = 0.987654321;
+   BottomDragOnE.Enabled           = true;
+   BottomDragOnE.Coeff             = 1.123456789;
+
+   // Compute reference result as the sum of the individual terms
+   Array2DReal RefVelTend("RefVelTend", Mesh->NEdgesOwned, NVertLevels);
+
+   parallelFor(
+       {Mesh->NEdgesOwned, NChunks}, KOKKOS_LAMBDA(int IEdge, int KChunk) {
+          PotVortHAdvOnE(RefVelTend, IEdge, KChunk, In.NormRVortEdge,
+                         In.NormFEdge, In.FluxLayerThickEdge, In.NormVelEdge);
+          KEGradOnE(RefVelTend, IEdge, KChunk, In.KECell);
+          SSHGradOnE(RefVelTend, IEdge, KChunk, In.SshCell);
+          VelDiffOnE(RefVelTend, IEdge, KChunk, In.DivCell, In.RVortVertex);
+          VelHyperDiffOnE(RefVelTend, IEdge, KChunk, In.Del2DivCell,
+                          In.Del2RVortVertex);
+          WindForcingOnE(RefVelTend, IEdge, KChunk, In.NormalStressEdge,
+                         In.LayerThickEdge);
+       });
+   parallelFor(
+       {Mesh->NEdgesOwned}, KOKKOS_LAMBDA(int IEdge) {
+          BottomDragOnE(RefVelTend, IEdge, In.NormVelEdge, In.KECell,
+                        In.LayerThickEdge);
+       });
+
+   // Compute fused result
+   Array2DReal NumVelTend("NumVelTend", Mesh->NEdgesOwned, NVertLevels);
+
+   FusedVelocityTendOnEdge FusedVelTendOnE(Mesh);
+   FusedVelTendOnE.setTerms(PotVortHAdvOnE, KEGradOnE, SSHGradOnE, VelDiffOnE,
+                            VelHyperDiffOnE, WindForcingOnE, BottomDragOnE);
+   if (FusedVelTendOnE.getTerms() !=
+       FusedVelocityTendOnEdge::NCombinations - 1) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: FusedVelocityTend terms not all enabled");
+   }
+   FusedVelTendOnE.compute(NumVelTend, In, Mesh->NEdgesOwned);
+
+   // The fused and unfused results differ only by roundoff
+   ErrorMeasures FusedErrors;
+   Err += computeErrors(FusedErrors, NumVelTend, RefVelTend, Mesh, OnEdge);
+
+   const ErrorMeasures ExpectedFusedErrors = {0, 0};
+
+   const Real RTol = 0;
+   const Real ATol = 1000 * std::numeric_limits<Real>::epsilon();
+   Err += checkErrors("TendencyTermsTest", "FusedVelocityTend", FusedErrors,
+                      ExpectedFusedErrors, RTol, ATol);
+
+   // The team policy gives the same result as the flat policy
+   Array2DReal TeamVelTend("TeamVelTend", Mesh->NEdgesOwned, NVertLevels);
+   FusedVelTendOnE.setPolicy(KernelPolicyType::Team);
+   FusedVelTendOnE.compute(TeamVelTend, In, Mesh->NEdgesOwned);
+
+   ErrorMeasures TeamErrors;
+   Err += computeErrors(TeamErrors, TeamVelTend, RefVelTend, Mesh, OnEdge);
+   Err += checkErrors("TendencyTermsTest", "FusedVelocityTendTeam", TeamErrors,
+                      ExpectedFusedErrors, RTol, ATol);
+
+   // Two launches on separate execution space instances with disjoint
+   // outputs can overlap and both give the same result
+   FusedVelTendOnE.setPolicy(KernelPolicyType::Flat);
+   auto Spaces = Kokkos::Experimental::partition_space(ExecSpace(), 1, 1);
+   // the inputs are written on the default instance
+   ExecSpace().fence();
+   Array2DReal ConcVelTend0("ConcVelTend0", Mesh->NEdgesOwned, NVertLevels);
+   Array2DReal ConcVelTend1("ConcVelTend1", Mesh->NEdgesOwned, NVertLevels);
+   FusedVelTendOnE.compute(ConcVelTend0, In, Mesh->NEdgesOwned, Spaces[0]);
+   FusedVelTendOnE.compute(ConcVelTend1, In, Mesh->NEdgesOwned, Spaces[1]);
+   Spaces[0].fence();
+   Spaces[1].fence();
+
+   ErrorMeasures ConcErrors0;
+   ErrorMeasures ConcErrors1;
+   Err += computeErrors(ConcErrors0, ConcVelTend0, RefVelTend, Mesh, OnEdge);
+   Err += computeErrors(ConcErrors1, ConcVelTend1, RefVelTend, Mesh, OnEdge);
+   Err += checkErrors("TendencyTermsTest", "FusedVelocityTendConcurrent",
+                      ConcErrors0, ExpectedFusedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedVelocityTendConcurrent",
+                      ConcErrors1, ExpectedFusedErrors, RTol, ATol);
+
+   if (Err == 0) {
+      LOG_INFO("TendencyTermsTest: FusedVelocityTend PASS");
+   }
+
+   return Err;
+} // end testFusedVelocityTend
+
 int testTracerHorzAdvOnCell(int NVertLevels, int NTracers, Real RTol) {
 
    I4 Err = 0;
@@ -863,7 +1052,8 @@ int testTracerHorzAdvOnCell(int NVertLevels, int NTracers, Real RTol) {
        },
        NormalVelocity, EdgeComponent::Normal, Geom, Mesh);
 
-   Array3DReal HTrOnEdge("HTrOnEdge", NTracers, Mesh->NEdgesSize, NVertLevels);
+   Array3DTracerAux HTrOnEdge("HTrOnEdge", NTracers, Mesh->NEdgesSize,
+                              NVertLevels);
 
    Err += setScalar(
        KOKKOS_LAMBDA(Real X, Real Y) { return -Setup.layerThick(X, Y); },
@@ -943,6 +1133,38 @@ int testTracerDiffOnCell(int NVertLevels, int NTracers, Real RTol) {
    Err += checkErrors("TendencyTermsTest", "TracerDiff", TrDiffErrors,
                       Setup.ExpectedTrDel2Errors, RTol);
 
+   // The same term computed on tracer arrays in each layout gives the same
+   // result after copying back to the canonical layout
+   const ErrorMeasures ExpectedLayoutErrors = {0, 0};
+   const Real LayoutATol = 1000 * std::numeric_limits<Real>::epsilon();
+
+   for (auto Layout : {TracerLayoutType::TracerOuter,
+                       TracerLayoutType::TracerInner,
+                       TracerLayoutType::Blocked}) {
+      TracerArray LayoutTracerCell("LayoutTracerCell", NTracers,
+                                   Mesh->NCellsSize, NVertLevels, Layout);
+      TracerArray LayoutTracerDiff("LayoutTracerDiff", NTracers,
+                                   Mesh->NCellsOwned, NVertLevels, Layout);
+      LayoutTracerCell.copyFrom(TracerCell);
+
+      parallelFor(
+          {NTracers, Mesh->NCellsOwned, NVertLevels},
+          KOKKOS_LAMBDA(int L, int ICell, int KLevel) {
+             TrDiffOnC(LayoutTracerDiff, L, ICell, KLevel, LayoutTracerCell,
+                       LayerThickEdge);
+          });
+
+      Array3DReal CopyTracerDiff("CopyTracerDiff", NTracers,
+                                 Mesh->NCellsOwned, NVertLevels);
+      LayoutTracerDiff.copyTo(CopyTracerDiff);
+
+      ErrorMeasures LayoutErrors;
+      Err += computeErrors(LayoutErrors, CopyTracerDiff, NumTracerDiff, Mesh,
+                           OnCell);
+      Err += checkErrors("TendencyTermsTest", "TracerDiffLayout", LayoutErrors,
+                         ExpectedLayoutErrors, 0, LayoutATol);
+   }
+
    if (Err == 0) {
       LOG_INFO("TendencyTermsTest: TracerDiff PASS");
    }
@@ -966,8 +1188,8 @@ int testTracerHyperDiffOnCell(int NVertLevels, int NTracers, Real RTol) {
        ExactTracerHyperDiff, Geom, Mesh, OnCell, ExchangeHalos::No);
 
    // Set input arrays
-   Array3DReal TrDel2Cell("TracerCell", NTracers, Mesh->NCellsSize,
-                          NVertLevels);
+   Array3DTracerAux TrDel2Cell("TracerCell", NTracers, Mesh->NCellsSize,
+                               NVertLevels);
 
    Err += setScalar(
        KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalarC(X, Y); },
@@ -998,6 +1220,383 @@ int testTracerHyperDiffOnCell(int NVertLevels, int NTracers, Real RTol) {
    return Err;
 } // end testTracerHyperDiffOnCell
 
+int testFusedTracerTend(int NVertLevels, int NTracers) {
+
+   I4 Err = 0;
+   TestSetup Setup;
+
+   const auto Mesh   = HorzMesh::getDefault();
+   const int NChunks = NVertLevels / VecLength;
+
+   // Set input arrays
+   FusedTracerTendOnCell::Inputs In;
+
+   In.NormVelEdge = Array2DReal("NormVelEdge", Mesh->NEdgesSize, NVertLevels);
+   Err += setVectorEdge(
+       KOKKOS_LAMBDA(Real(&VecField)[2], Real X, Real Y) {
+          VecField[0] = Setup.vectorX(X, Y);
+          VecField[1] = Setup.vectorY(X, Y);
+       },
+       In.NormVelEdge, EdgeComponent::Normal, Geom, Mesh);
+
+   Array3DTracerAux HTrOnEdge("HTrOnEdge", NTracers, Mesh->NEdgesSize,
+                              NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return -Setup.layerThick(X, Y); },
+       HTrOnEdge, Geom, Mesh, OnEdge);
+   In.HTracersOnEdge = HTrOnEdge;
+
+   In.TracerCell = Array3DReal("TracerCell", NTracers, Mesh->NCellsSize,
+                               NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalarA(X, Y); },
+       In.TracerCell, Geom, Mesh, OnCell);
+
+   In.MeanLayerThickEdge = Array2DReal("MeanLayerThickEdge", Mesh->NEdgesSize,
+                                       NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalarB(X, Y); },
+       In.MeanLayerThickEdge, Geom, Mesh, OnEdge);
+
+   Array3DTracerAux TrDel2Cell("TrDel2Cell", NTracers, Mesh->NCellsSize,
+                               NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.scalarC(X, Y); },
+       TrDel2Cell, Geom, Mesh, OnCell);
+   In.TrDel2Cell = TrDel2Cell;
+
+   // Enable all terms with arbitrary coefficients
+   TracerHorzAdvOnCell TrHorzAdvOnC(Mesh);
+   TracerDiffOnCell TrDiffOnC(Mesh);
+   TracerHyperDiffOnCell TrHypDiffOnC(Mesh);
+
+   TrHorzAdvOnC.Enabled   = true;
+   TrDiffOnC.Enabled      = true;
+   TrDiffOnC.EddyDiff2    = 0.123456789;
+   TrHypDiffOnC.Enabled   = true;
+   TrHypDiffOnC.EddyDiff4 = 0.0123456789;
+
+   // Compute reference result as the sum of the individual terms
+   Array3DReal RefTracerTend("RefTracerTend", NTracers, Mesh->NCellsOwned,
+                             NVertLevels);
+   parallelFor(
+       {NTracers, Mesh->NCellsOwned, NChunks},
+       KOKKOS_LAMBDA(int L, int ICell, int KChunk) {
+          TrHorzAdvOnC(RefTracerTend, L, ICell, KChunk, In.NormVelEdge,
+                       In.HTracersOnEdge);
+          TrDiffOnC(RefTracerTend, L, ICell, KChunk, In.TracerCell,
+                    In.MeanLayerThickEdge);
+          TrHypDiffOnC(RefTracerTend, L, ICell, KChunk, In.TrDel2Cell);
+       });
+
+   // Compute fused result
+   Array3DReal NumTracerTend("NumTracerTend", NTracers, Mesh->NCellsOwned,
+                             NVertLevels);
+
+   FusedTracerTendOnCell FusedTrTendOnC(Mesh);
+   FusedTrTendOnC.setTerms(TrHorzAdvOnC, TrDiffOnC, TrHypDiffOnC);
+   FusedTrTendOnC.compute(NumTracerTend, In, Mesh->NCellsOwned);
+
+   // The fused and unfused results differ only by roundoff
+   ErrorMeasures FusedErrors;
+   Err += computeErrors(FusedErrors, NumTracerTend, RefTracerTend, Mesh,
+                        OnCell);
+
+   const ErrorMeasures ExpectedFusedErrors = {0, 0};
+
+   const Real RTol = 0;
+   const Real ATol = 1000 * std::numeric_limits<Real>::epsilon();
+   Err += checkErrors("TendencyTermsTest", "FusedTracerTend", FusedErrors,
+                      ExpectedFusedErrors, RTol, ATol);
+
+   // The team policy gives the same result as the flat policy
+   Array3DReal TeamTracerTend("TeamTracerTend", NTracers, Mesh->NCellsOwned,
+                              NVertLevels);
+   FusedTrTendOnC.setPolicy(KernelPolicyType::Team);
+   FusedTrTendOnC.compute(TeamTracerTend, In, Mesh->NCellsOwned);
+
+   ErrorMeasures TeamErrors;
+   Err += computeErrors(TeamErrors, TeamTracerTend, RefTracerTend, Mesh,
+                        OnCell);
+   Err += checkErrors("TendencyTermsTest", "FusedTracerTendTeam", TeamErrors,
+                      ExpectedFusedErrors, RTol, ATol);
+
+   // Two launches on separate execution space instances with disjoint
+   // outputs can overlap and both give the same result
+   FusedTrTendOnC.setPolicy(KernelPolicyType::Flat);
+   auto Spaces = Kokkos::Experimental::partition_space(ExecSpace(), 1, 1);
+   // the inputs are written on the default instance
+   ExecSpace().fence();
+   Array3DReal ConcTracerTend0("ConcTracerTend0", NTracers, Mesh->NCellsOwned,
+                               NVertLevels);
+   Array3DReal ConcTracerTend1("ConcTracerTend1", NTracers, Mesh->NCellsOwned,
+                               NVertLevels);
+   FusedTrTendOnC.compute(ConcTracerTend0, In, Mesh->NCellsOwned, Spaces[0]);
+   FusedTrTendOnC.compute(ConcTracerTend1, In, Mesh->NCellsOwned, Spaces[1]);
+   Spaces[0].fence();
+   Spaces[1].fence();
+
+   ErrorMeasures ConcErrors0;
+   ErrorMeasures ConcErrors1;
+   Err += computeErrors(ConcErrors0, ConcTracerTend0, RefTracerTend, Mesh,
+                        OnCell);
+   Err += computeErrors(ConcErrors1, ConcTracerTend1, RefTracerTend, Mesh,
+                        OnCell);
+   Err += checkErrors("TendencyTermsTest", "FusedTracerTendConcurrent",
+                      ConcErrors0, ExpectedFusedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedTracerTendConcurrent",
+                      ConcErrors1, ExpectedFusedErrors, RTol, ATol);
+
+   if (Err == 0) {
+      LOG_INFO("TendencyTermsTest: FusedTracerTend PASS");
+   }
+
+   return Err;
+} // end testFusedTracerTend
+
+int testStencilCoeffs() {
+
+   I4 Err = 0;
+
+   const auto Mesh = HorzMesh::getDefault();
+
+   // The coefficients are computed once and shared for each mesh
+   StencilCoeffs *Coeffs = StencilCoeffs::get(Mesh);
+   if (StencilCoeffs::get(Mesh) != Coeffs) {
+      LOG_ERROR("TendencyTermsTest: StencilCoeffs not shared FAIL");
+      ++Err;
+   }
+
+   // Compare the coefficients with the mesh geometry they replace
+   auto DivCoeffH       = createHostMirrorCopy(Coeffs->DivCoeffOnCell);
+   auto LaplaceCoeffH   = createHostMirrorCopy(Coeffs->LaplaceCoeffOnCell);
+   auto GradCoeffH      = createHostMirrorCopy(Coeffs->GradCoeffOnEdge);
+   auto TangentCoeffH   = createHostMirrorCopy(Coeffs->TangentGradCoeffOnEdge);
+   auto NEdgesOnCellH   = createHostMirrorCopy(Mesh->NEdgesOnCell);
+   auto EdgesOnCellH    = createHostMirrorCopy(Mesh->EdgesOnCell);
+   auto EdgeSignOnCellH = createHostMirrorCopy(Mesh->EdgeSignOnCell);
+   auto DvEdgeH         = createHostMirrorCopy(Mesh->DvEdge);
+   auto DcEdgeH         = createHostMirrorCopy(Mesh->DcEdge);
+   auto AreaCellH       = createHostMirrorCopy(Mesh->AreaCell);
+   auto EdgeMaskH       = createHostMirrorCopy(Mesh->EdgeMask);
+   auto MinLevelEdgeH   = createHostMirrorCopy(Coeffs->MinLevelEdge);
+   auto MaxLevelEdgeH   = createHostMirrorCopy(Coeffs->MaxLevelEdge);
+   auto MinLevelCellH   = createHostMirrorCopy(Coeffs->MinLevelCell);
+   auto MaxLevelCellH   = createHostMirrorCopy(Coeffs->MaxLevelCell);
+
+   const Real Tol = 10 * std::numeric_limits<Real>::epsilon();
+
+   I4 NMismatch = 0;
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      for (int J = 0; J < NEdgesOnCellH(ICell); ++J) {
+         const I4 JEdge    = EdgesOnCellH(ICell, J);
+         const Real Div    =
+             EdgeSignOnCellH(ICell, J) * DvEdgeH(JEdge) / AreaCellH(ICell);
+         const Real Lapl   = Div / DcEdgeH(JEdge);
+         const Real DivDif = std::abs(DivCoeffH(ICell, J) - Div);
+         const Real LapDif = std::abs(LaplaceCoeffH(ICell, J) - Lapl);
+         if (DivDif > Tol * std::abs(Div) || LapDif > Tol * std::abs(Lapl))
+            ++NMismatch;
+      }
+   }
+   for (int IEdge = 0; IEdge < Mesh->NEdgesAll; ++IEdge) {
+      const Real GradDif = std::abs(GradCoeffH(IEdge) * DcEdgeH(IEdge) - 1);
+      const Real TangDif = std::abs(TangentCoeffH(IEdge) * DvEdgeH(IEdge) - 1);
+      if (GradDif > Tol || TangDif > Tol)
+         ++NMismatch;
+   }
+
+   // Every active level of an edge, and of the edges of a cell, must lie
+   // within the active range of the edge and of the cell
+   for (int ICell = 0; ICell < Mesh->NCellsAll; ++ICell) {
+      for (int J = 0; J < NEdgesOnCellH(ICell); ++J) {
+         const I4 JEdge = EdgesOnCellH(ICell, J);
+         for (int K = 0; K < EdgeMaskH.extent_int(1); ++K) {
+            const bool InEdge =
+                K >= MinLevelEdgeH(JEdge) && K <= MaxLevelEdgeH(JEdge);
+            const bool InCell =
+                K >= MinLevelCellH(ICell) && K <= MaxLevelCellH(ICell);
+            if (EdgeMaskH(JEdge, K) != 0 && !(InEdge && InCell))
+               ++NMismatch;
+            if (EdgeMaskH(JEdge, K) == 0 &&
+                (K == MinLevelEdgeH(JEdge) || K == MaxLevelEdgeH(JEdge)))
+               ++NMismatch;
+         }
+      }
+   }
+
+   if (NMismatch > 0) {
+      LOG_ERROR("TendencyTermsTest: StencilCoeffs {} mismatches FAIL",
+                NMismatch);
+      ++Err;
+   }
+
+   if (Err == 0) {
+      LOG_INFO("TendencyTermsTest: StencilCoeffs PASS");
+   }
+
+   return Err;
+} // end testStencilCoeffs
+
+// Compare the fused auxiliary variable kernels with unfused kernels that use
+// the mesh geometry directly
+int testFusedAuxVars(int NVertLevels) {
+
+   int Err = 0;
+   TestSetup Setup;
+
+   const auto Mesh = HorzMesh::getDefault();
+
+   // Set input arrays
+   Array2DReal NormVelEdge("NormVelEdge", Mesh->NEdgesSize, NVertLevels);
+   Err += setVectorEdge(
+       KOKKOS_LAMBDA(Real(&VecField)[2], Real X, Real Y) {
+          VecField[0] = Setup.vectorX(X, Y);
+          VecField[1] = Setup.vectorY(X, Y);
+       },
+       NormVelEdge, EdgeComponent::Normal, Geom, Mesh);
+
+   Array2DReal LayerThickCell("LayerThickCell", Mesh->NCellsSize, NVertLevels);
+   Err += setScalar(
+       KOKKOS_LAMBDA(Real X, Real Y) { return Setup.layerThick(X, Y); },
+       LayerThickCell, Geom, Mesh, OnCell);
+
+   // Compute fused result
+   const I4 NCells    = Mesh->NCellsSize;
+   const I4 NEdges    = Mesh->NEdgesSize;
+   const I4 NVertices = Mesh->NVerticesSize;
+
+   FusedAuxVars::Outputs Out;
+   Out.KineticEnergyCell    = Array2DReal("KE", NCells, NVertLevels);
+   Out.VelocityDivCell      = Array2DReal("Div", NCells, NVertLevels);
+   Out.RelVortVertex        = Array2DReal("RVort", NVertices, NVertLevels);
+   Out.NormRelVortVertex    = Array2DReal("NRVort", NVertices, NVertLevels);
+   Out.NormPlanetVortVertex = Array2DReal("NFVert", NVertices, NVertLevels);
+   Out.NormRelVortEdge      = Array2DReal("NRVortEdge", NEdges, NVertLevels);
+   Out.NormPlanetVortEdge   = Array2DReal("NFEdge", NEdges, NVertLevels);
+   Out.FluxLayerThickEdge   = Array2DReal("FluxThick", NEdges, NVertLevels);
+   Out.MeanLayerThickEdge   = Array2DReal("MeanThick", NEdges, NVertLevels);
+   Out.Del2Edge             = Array2DReal("Del2Edge", NEdges, NVertLevels);
+   Out.Del2DivCell          = Array2DReal("Del2Div", NCells, NVertLevels);
+   Out.Del2RelVortVertex    = Array2DReal("Del2RVort", NVertices, NVertLevels);
+
+   FusedAuxVars FusedAux(Mesh);
+   FusedAux.compute(Out, NormVelEdge, LayerThickCell, NVertLevels);
+
+   // Compute the reference result one variable at a time
+   Array2DReal RefKE("RefKE", NCells, NVertLevels);
+   Array2DReal RefDiv("RefDiv", NCells, NVertLevels);
+   Array2DReal RefRVort("RefRVort", NVertices, NVertLevels);
+   Array2DReal RefDel2Edge("RefDel2Edge", NEdges, NVertLevels);
+   Array2DReal RefDel2Div("RefDel2Div", NCells, NVertLevels);
+   Array2DReal RefDel2RVort("RefDel2RVort", NVertices, NVertLevels);
+
+   const auto &NEdgesOnCell     = Mesh->NEdgesOnCell;
+   const auto &EdgesOnCell      = Mesh->EdgesOnCell;
+   const auto &EdgeSignOnCell   = Mesh->EdgeSignOnCell;
+   const auto &EdgesOnVertex    = Mesh->EdgesOnVertex;
+   const auto &EdgeSignOnVertex = Mesh->EdgeSignOnVertex;
+   const auto &CellsOnEdge      = Mesh->CellsOnEdge;
+   const auto &VerticesOnEdge   = Mesh->VerticesOnEdge;
+   const auto &DcEdge           = Mesh->DcEdge;
+   const auto &DvEdge           = Mesh->DvEdge;
+   const auto &AreaCell         = Mesh->AreaCell;
+   const auto &AreaTriangle     = Mesh->AreaTriangle;
+   const auto &EdgeMask         = Mesh->EdgeMask;
+   const I4 VertexDegree        = Mesh->VertexDegree;
+
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          Real KE  = 0;
+          Real Div = 0;
+          for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+             const I4 JEdge = EdgesOnCell(ICell, J);
+             const Real Vel = NormVelEdge(JEdge, K);
+             KE += 0.25_Real * DcEdge(JEdge) * DvEdge(JEdge) * Vel * Vel;
+             Div -= EdgeSignOnCell(ICell, J) * DvEdge(JEdge) * Vel;
+          }
+          RefKE(ICell, K)  = KE / AreaCell(ICell);
+          RefDiv(ICell, K) = Div / AreaCell(ICell);
+       });
+   parallelFor(
+       {Mesh->NVerticesAll, NVertLevels}, KOKKOS_LAMBDA(int IVertex, int K) {
+          Real Vort = 0;
+          for (int J = 0; J < VertexDegree; ++J) {
+             const I4 JEdge = EdgesOnVertex(IVertex, J);
+             Vort += EdgeSignOnVertex(IVertex, J) * DcEdge(JEdge) *
+                     NormVelEdge(JEdge, K);
+          }
+          RefRVort(IVertex, K) = Vort / AreaTriangle(IVertex);
+       });
+   parallelFor(
+       {Mesh->NEdgesAll, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+          const I4 ICell0       = CellsOnEdge(IEdge, 0);
+          const I4 ICell1       = CellsOnEdge(IEdge, 1);
+          const I4 IVertex0     = VerticesOnEdge(IEdge, 0);
+          const I4 IVertex1     = VerticesOnEdge(IEdge, 1);
+          RefDel2Edge(IEdge, K) =
+              EdgeMask(IEdge, K) *
+              ((RefDiv(ICell1, K) - RefDiv(ICell0, K)) / DcEdge(IEdge) -
+               (RefRVort(IVertex1, K) - RefRVort(IVertex0, K)) / DvEdge(IEdge));
+       });
+   parallelFor(
+       {Mesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+          Real Div = 0;
+          for (int J = 0; J < NEdgesOnCell(ICell); ++J) {
+             const I4 JEdge = EdgesOnCell(ICell, J);
+             Div -= EdgeSignOnCell(ICell, J) * DvEdge(JEdge) *
+                    RefDel2Edge(JEdge, K);
+          }
+          RefDel2Div(ICell, K) = Div / AreaCell(ICell);
+       });
+   parallelFor(
+       {Mesh->NVerticesAll, NVertLevels}, KOKKOS_LAMBDA(int IVertex, int K) {
+          Real Vort = 0;
+          for (int J = 0; J < VertexDegree; ++J) {
+             const I4 JEdge = EdgesOnVertex(IVertex, J);
+             Vort += EdgeSignOnVertex(IVertex, J) * DcEdge(JEdge) *
+                     RefDel2Edge(JEdge, K);
+          }
+          RefDel2RVort(IVertex, K) = Vort / AreaTriangle(IVertex);
+       });
+
+   // The fused and unfused results differ only by roundoff
+   ErrorMeasures KEErrors, DivErrors, RVortErrors;
+   ErrorMeasures Del2Errors, Del2DivErrors, Del2RVortErrors;
+   Err += computeErrors(KEErrors, Out.KineticEnergyCell, RefKE, Mesh, OnCell);
+   Err += computeErrors(DivErrors, Out.VelocityDivCell, RefDiv, Mesh, OnCell);
+   Err += computeErrors(RVortErrors, Out.RelVortVertex, RefRVort, Mesh,
+                        OnVertex);
+   Err += computeErrors(Del2Errors, Out.Del2Edge, RefDel2Edge, Mesh, OnEdge);
+   Err += computeErrors(Del2DivErrors, Out.Del2DivCell, RefDel2Div, Mesh,
+                        OnCell);
+   Err += computeErrors(Del2RVortErrors, Out.Del2RelVortVertex, RefDel2RVort,
+                        Mesh, OnVertex);
+
+   const ErrorMeasures ExpectedErrors = {0, 0};
+
+   const Real RTol = 0;
+   const Real ATol = 1000 * std::numeric_limits<Real>::epsilon();
+   Err += checkErrors("TendencyTermsTest", "FusedAuxKE", KEErrors,
+                      ExpectedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedAuxDiv", DivErrors,
+                      ExpectedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedAuxRVort", RVortErrors,
+                      ExpectedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedAuxDel2", Del2Errors,
+                      ExpectedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedAuxDel2Div", Del2DivErrors,
+                      ExpectedErrors, RTol, ATol);
+   Err += checkErrors("TendencyTermsTest", "FusedAuxDel2RVort",
+                      Del2RVortErrors, ExpectedErrors, RTol, ATol);
+
+   if (Err == 0) {
+      LOG_INFO("TendencyTermsTest: FusedAuxVars PASS");
+   }
+
+   return Err;
+} // end testFusedAuxVars
+
 void initTendTest(const std::string &MeshFile, int NVertLevels) {
 
    Error Err;
@@ -1040,6 +1639,7 @@ void initTendTest(const std::string &MeshFile, int NVertLevels) {
 
 void finalizeTendTest() {
 
+   StencilCoeffs::clear();
    HorzMesh::clear();
    Dimension::clear();
    Halo::clear();
@@ -1048,6 +1648,79 @@ void finalizeTendTest() {
 
 } // end finalizeTendTest
 
+// Check that the aux groups follow the enabled terms and are computed once
+// per stage
+int testAuxDependencies() {
+   int Err          = 0;
+   const auto *Mesh = HorzMesh::getDefault();
+
+   // Enable all momentum terms except the biharmonic mixing, and only the
+   // tracer advection
+   PotentialVortHAdvOnEdge PotVortHAdvOnE(Mesh);
+   KEGradOnEdge KEGradOnE(Mesh);
+   SSHGradOnEdge SSHGradOnE(Mesh);
+   VelocityDiffusionOnEdge VelDiffOnE(Mesh);
+   VelocityHyperDiffOnEdge VelHyperDiffOnE(Mesh);
+   WindForcingOnEdge WindForcingOnE(Mesh);
+   BottomDragOnEdge BottomDragOnE(Mesh);
+   TracerHorzAdvOnCell TrHorzAdvOnC(Mesh);
+   TracerDiffOnCell TrDiffOnC(Mesh);
+   TracerHyperDiffOnCell TrHypDiffOnC(Mesh);
+
+   PotVortHAdvOnE.Enabled  = true;
+   KEGradOnE.Enabled       = true;
+   SSHGradOnE.Enabled      = false;
+   VelDiffOnE.Enabled      = true;
+   VelHyperDiffOnE.Enabled = false;
+   WindForcingOnE.Enabled  = false;
+   BottomDragOnE.Enabled   = false;
+   TrHorzAdvOnC.Enabled    = true;
+   TrDiffOnC.Enabled       = false;
+   TrHypDiffOnC.Enabled    = false;
+
+   FusedVelocityTendOnEdge FusedVelTendOnE(Mesh);
+   FusedVelTendOnE.setTerms(PotVortHAdvOnE, KEGradOnE, SSHGradOnE, VelDiffOnE,
+                            VelHyperDiffOnE, WindForcingOnE, BottomDragOnE);
+   FusedTracerTendOnCell FusedTrTendOnC(Mesh);
+   FusedTrTendOnC.setTerms(TrHorzAdvOnC, TrDiffOnC, TrHypDiffOnC);
+
+   AuxDependencies Deps;
+   Deps.addTerms(FusedVelTendOnE);
+   Deps.addTerms(FusedTrTendOnC);
+
+   // No streams are defined, so stream fields add no groups
+   Deps.addStreamFields(AuxGroup::VelocityDel2, {"Del2DivCell"});
+
+   if (!Deps.isRequired(AuxGroup::Kinetic) or
+       !Deps.isRequired(AuxGroup::Vorticity) or
+       !Deps.isRequired(AuxGroup::LayerThickness) or
+       !Deps.isRequired(AuxGroup::Tracer)) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: AuxDependencies missing needed group");
+   }
+   if (Deps.isRequired(AuxGroup::VelocityDel2)) {
+      Err++;
+      LOG_ERROR("TendencyTermsTest: AuxDependencies needs VelocityDel2");
+   }
+
+   // Each needed group is computed once per stage, unneeded ones never
+   for (int Stage = 0; Stage < 2; ++Stage) {
+      Deps.startStage();
+      if (!Deps.needsCompute(AuxGroup::Kinetic) or
+          Deps.needsCompute(AuxGroup::Kinetic) or
+          Deps.needsCompute(AuxGroup::VelocityDel2)) {
+         Err++;
+         LOG_ERROR("TendencyTermsTest: AuxDependencies stage {} FAIL", Stage);
+      }
+   }
+
+   if (Err == 0) {
+      LOG_INFO("TendencyTermsTest: AuxDependencies PASS");
+   }
+
+   return Err;
+} // end testAuxDependencies
+
 int tendencyTermsTest(const std::string &MeshFile = DefaultMeshFile) {
    int Err         = 0;
    int NVertLevels = 16;
@@ -1058,6 +1731,14 @@ int tendencyTermsTest(const std::string &MeshFile = DefaultMeshFile) {
    int NTracers     = 3;
 
    const Real RTol = sizeof(Real) == 4 ? 2e-2 : 1e-5;
+   // Tracer terms that read the auxiliary arrays in single precision in a
+   // mixed-precision build
+   const Real TrAuxRTol = sizeof(TracerAuxReal) == 4 ? 2e-2 : RTol;
+
+   LOG_INFO("TendencyTermsTest: VecLength {}, SIMD width {}", VecLength,
+            simdWidth());
+
+   Err += testStencilCoeffs();
 
    Err += testThickFluxDiv(NVertLevels, RTol);
 
@@ -1075,11 +1756,19 @@ int tendencyTermsTest(const std::string &MeshFile = DefaultMeshFile) {
 
    Err += testBottomDrag(NVertLevels, RTol);
 
-   Err += testTracerHorzAdvOnCell(NVertLevels, NTracers, RTol);
+   Err += testFusedVelocityTend(NVertLevels);
+
+   Err += testTracerHorzAdvOnCell(NVertLevels, NTracers, TrAuxRTol);
 
    Err += testTracerDiffOnCell(NVertLevels, NTracers, RTol);
 
-   Err += testTracerHyperDiffOnCell(NVertLevels, NTracers, RTol);
+   Err += testTracerHyperDiffOnCell(NVertLevels, NTracers, TrAuxRTol);
+
+   Err += testFusedTracerTend(NVertLevels, NTracers);
+
+   Err += testFusedAuxVars(NVertLevels);
+
+   Err += testAuxDependencies();
 
    if (Err == 0) {
       LOG_INFO("TendencyTermsTest: Successful completion");
@@ -0,0 +1,197 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA adaptive time step -----------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the adaptive time step control
+///
+/// This driver initializes the standalone model, creates a time stepper with
+/// adaptive time step control and attaches a periodic output alarm to its
+/// clock. The normal velocity is set to a uniform value so that the maximum
+/// CFL number of the initial time step is known and larger than the target.
+/// The clock is then advanced with the time step chosen after each step. The
+/// CFL number must shorten the first step to a step that is not a divisor of
+/// the time to the output alarm, and every time the output alarm
+/// rings the clock must be exactly at the alarm time, so that the shortened
+/// steps land on the output times rather than stepping over them.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "DataTypes.h"
+#include "Error.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanDriver.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "Tendencies.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+/// Test constants
+constexpr I8 InitialStep    = 600;  // initial time step in seconds
+constexpr I8 OutputInterval = 1000; // output alarm interval in seconds
+constexpr int NOutputs      = 3;    // number of output times to reach
+const R8 TargetCFL          = 0.5;
+const R8 InitialCFL         = 0.96; // CFL number of the initial time step
+
+//------------------------------------------------------------------------------
+// Returns the largest EdgeMask / DcEdge over the owned edges and levels on
+// all tasks, which converts |u| dt into the maximum CFL number
+R8 maxInvDcEdge(const HorzMesh *Mesh) {
+
+   auto DcEdgeH   = createHostMirrorCopy(Mesh->DcEdge);
+   auto EdgeMaskH = createHostMirrorCopy(Mesh->EdgeMask);
+
+   R8 MaxInvDc = 0;
+   for (int IEdge = 0; IEdge < Mesh->NEdgesOwned; ++IEdge) {
+      for (int K = 0; K < EdgeMaskH.extent_int(1); ++K) {
+         const R8 InvDc = EdgeMaskH(IEdge, K) / DcEdgeH(IEdge);
+         MaxInvDc       = std::max(MaxInvDc, InvDc);
+      }
+   }
+
+   MPI_Allreduce(MPI_IN_PLACE, &MaxInvDc, 1, MPI_DOUBLE, MPI_MAX,
+                 MachEnv::getDefault()->getComm());
+   return MaxInvDc;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the adaptive time step
+int main(int argc, char *argv[]) {
+
+   I4 RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      I4 Err = ocnInit(MPI_COMM_WORLD);
+      if (Err != 0)
+         ABORT_ERROR("AdaptiveTimeStepTest: error initializing Omega");
+
+      TimeStepper *DefStepper = TimeStepper::getDefault();
+      HorzMesh *DefMesh       = HorzMesh::getDefault();
+      OceanState *DefState    = OceanState::getDefault();
+      TimeInstant StartTime   = DefStepper->getStartTime();
+      TimeInstant StopTime =
+          StartTime + TimeInterval(10 * OutputInterval, TimeUnits::Seconds);
+
+      TimeStepper *Stepper = TimeStepper::create(
+          "Adaptive", TimeStepperType::ForwardBackward, StartTime, StopTime,
+          TimeInterval(InitialStep, TimeUnits::Seconds),
+          Tendencies::getDefault(), AuxiliaryState::getDefault(), DefMesh,
+          Halo::getDefault());
+      if (Stepper == nullptr)
+         ABORT_ERROR("AdaptiveTimeStepTest: error creating stepper");
+
+      // Check every step, allow the step to halve or double and bound it
+      // well away from the steps expected below
+      Stepper->setAdaptiveTimeStep(1, TargetCFL, 2.0,
+                                   TimeInterval(10, TimeUnits::Seconds),
+                                   TimeInterval(3600, TimeUnits::Seconds));
+
+      // An output alarm as created by a stream, attached to the clock
+      Clock *StepClock = Stepper->getClock();
+      TimeInterval OutputStep(OutputInterval, TimeUnits::Seconds);
+      Alarm OutputAlarm("AdaptiveOutput", OutputStep, StartTime);
+      StepClock->attachAlarm(&OutputAlarm);
+
+      // A uniform velocity with the CFL number InitialCFL at the initial
+      // step, which is not a whole fraction of the output interval
+      Array2DReal NormalVel;
+      Err = DefState->getNormalVelocity(NormalVel, 0);
+      if (Err != 0)
+         ABORT_ERROR("AdaptiveTimeStepTest: error retrieving velocity");
+      const R8 Vel = InitialCFL / (InitialStep * maxInvDcEdge(DefMesh));
+      deepCopy(NormalVel, static_cast<Real>(Vel));
+
+      // The step chosen from the CFL number after the first step, shorter
+      // than the 400 s left to the first output time
+      const TimeInterval CFLStep(
+          static_cast<I8>(std::floor(InitialStep * TargetCFL / InitialCFL)),
+          TimeUnits::Seconds);
+
+      // Advance the clock as doStep does and adapt the step after each step
+      // as ocnRun does. The state is not changed so the CFL number only
+      // depends on the time step.
+      bool Shortened   = false;
+      bool OnAlarm     = true;
+      int NRings       = 0;
+      I8 IStep         = 0;
+      TimeInstant Ring = StartTime + OutputStep;
+      while (NRings < NOutputs and IStep < 100) {
+         StepClock->advance();
+         ++IStep;
+
+         if (OutputAlarm.isRinging()) {
+            if (StepClock->getCurrentTime() != Ring) {
+               OnAlarm = false;
+               LOG_ERROR("AdaptiveTimeStepTest: output alarm rang at {} "
+                         "instead of {}",
+                         StepClock->getCurrentTime().getString(4, 0, "_"),
+                         Ring.getString(4, 0, "_"));
+            }
+            OutputAlarm.reset(StepClock->getCurrentTime());
+            Ring = Ring + OutputStep;
+            ++NRings;
+         }
+
+         Stepper->adaptTimeStep(DefState, IStep);
+         if (IStep == 1)
+            Shortened = Stepper->getTimeStep() == CFLStep;
+      }
+
+      if (Shortened) {
+         LOG_INFO("AdaptiveTimeStepTest: CFL shortens time step PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("AdaptiveTimeStepTest: CFL shortens time step FAIL");
+      }
+
+      if (OnAlarm and NRings == NOutputs) {
+         LOG_INFO("AdaptiveTimeStepTest: steps land on output alarm PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("AdaptiveTimeStepTest: steps land on output alarm FAIL, "
+                   "{} of {} output times reached",
+                   NRings, NOutputs);
+      }
+
+      TimeStepper::erase("Adaptive");
+
+      Err = ocnFinalize(StartTime);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("AdaptiveTimeStepTest: error finalizing Omega");
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("AdaptiveTimeStepTest: Successful completion");
+   }
+   Pacer::finalize();
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,221 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA fused state updates ----------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the fused thickness and tracer update
+///
+/// This driver initializes the standalone model and sets the current layer
+/// thickness, tracers and all tendencies to non-uniform values. The state
+/// and tracers are then updated by their tendencies with the separate
+/// thickness and tracer updates, with the fused update and with the update
+/// kernels recorded into a graph. All three must give the same new layer
+/// thickness, normal velocity and tracers.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "DataTypes.h"
+#include "Error.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanDriver.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "Tendencies.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+/// Test constants
+constexpr int CurLevel  = 0; // time level of the current state
+constexpr int NextLevel = 1; // time level of the updated state
+const Real RTol         = sizeof(Real) == 4 ? 1e-6 : 1e-14;
+
+/// Host copies of the updated state and tracers
+struct UpdatedState {
+   HostArray2DReal LayerThick;
+   HostArray2DReal NormalVel;
+   HostArray3DReal Tracers;
+};
+
+//------------------------------------------------------------------------------
+// Returns the largest relative difference between two host arrays on all
+// tasks
+template <class ArrayType>
+Real maxRelDiff(const ArrayType &Test, const ArrayType &Ref) {
+
+   Real MaxDiff     = 0;
+   const Real *TPtr = Test.data();
+   const Real *RPtr = Ref.data();
+   for (std::size_t I = 0; I < Ref.size(); ++I) {
+      const Real Scale = std::max(std::abs(RPtr[I]), Real(1));
+      MaxDiff          = std::max(MaxDiff, std::abs(TPtr[I] - RPtr[I]) / Scale);
+   }
+
+   MPI_Allreduce(MPI_IN_PLACE, &MaxDiff, 1, MPI_RealKind, MPI_MAX,
+                 MachEnv::getDefault()->getComm());
+   return MaxDiff;
+}
+
+//------------------------------------------------------------------------------
+// Resets the new time level, updates the state and tracers by their
+// tendencies and returns host copies of the result
+UpdatedState updateState(TimeStepper *Stepper, OceanState *State,
+                         const TimeInterval &Coeff) {
+
+   Array2DReal LayerThick;
+   Array2DReal NormalVel;
+   Array3DReal NextTracers;
+   Array3DReal CurTracers;
+   I4 Err = 0;
+   Err += State->getLayerThickness(LayerThick, NextLevel);
+   Err += State->getNormalVelocity(NormalVel, NextLevel);
+   Err += Tracers::getAll(NextTracers, NextLevel);
+   Err += Tracers::getAll(CurTracers, CurLevel);
+   if (Err != 0)
+      ABORT_ERROR("FusedUpdateTest: error retrieving state");
+
+   deepCopy(LayerThick, -1.0_Real);
+   deepCopy(NormalVel, -1.0_Real);
+   deepCopy(NextTracers, -1.0_Real);
+
+   Stepper->updateStateAndTracersByTend(NextTracers, CurTracers, State,
+                                        NextLevel, State, CurLevel, Coeff);
+
+   UpdatedState Result;
+   Result.LayerThick = createHostMirrorCopy(LayerThick);
+   Result.NormalVel  = createHostMirrorCopy(NormalVel);
+   Result.Tracers    = createHostMirrorCopy(NextTracers);
+   return Result;
+}
+
+//------------------------------------------------------------------------------
+// Compares an updated state against the reference and logs the result
+int checkState(const UpdatedState &Test, const UpdatedState &Ref,
+               const std::string &Label) {
+
+   const Real MaxDiff = std::max({maxRelDiff(Test.LayerThick, Ref.LayerThick),
+                                  maxRelDiff(Test.NormalVel, Ref.NormalVel),
+                                  maxRelDiff(Test.Tracers, Ref.Tracers)});
+   if (MaxDiff < RTol) {
+      LOG_INFO("FusedUpdateTest: {} matches separate updates PASS", Label);
+      return 0;
+   }
+   LOG_ERROR("FusedUpdateTest: {} matches separate updates FAIL, max "
+             "relative difference {}",
+             Label, MaxDiff);
+   return 1;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the fused state updates
+int main(int argc, char *argv[]) {
+
+   I4 RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      I4 Err = ocnInit(MPI_COMM_WORLD);
+      if (Err != 0)
+         ABORT_ERROR("FusedUpdateTest: error initializing Omega");
+
+      TimeStepper *DefStepper = TimeStepper::getDefault();
+      HorzMesh *DefMesh       = HorzMesh::getDefault();
+      OceanState *DefState    = OceanState::getDefault();
+      Tendencies *DefTend     = Tendencies::getDefault();
+      TimeInstant StartTime   = DefStepper->getStartTime();
+
+      TimeStepper *Stepper = TimeStepper::create(
+          "Fused", TimeStepperType::ForwardBackward, StartTime,
+          DefStepper->getStopTime(), DefStepper->getTimeStep(), DefTend,
+          AuxiliaryState::getDefault(), DefMesh, Halo::getDefault());
+      if (Stepper == nullptr)
+         ABORT_ERROR("FusedUpdateTest: error creating stepper");
+
+      // Non-uniform current thickness, tracers and tendencies so that an
+      // indexing error in either update shows up
+      Array2DReal LayerThick;
+      Array3DReal CurTracers;
+      Err += DefState->getLayerThickness(LayerThick, CurLevel);
+      Err += Tracers::getAll(CurTracers, CurLevel);
+      if (Err != 0)
+         ABORT_ERROR("FusedUpdateTest: error retrieving current state");
+
+      const auto &ThickTend  = DefTend->LayerThicknessTend;
+      const auto &VelTend    = DefTend->NormalVelocityTend;
+      const auto &TracerTend = DefTend->TracerTend;
+      const int NTracers     = TracerTend.extent_int(0);
+      const int NVertLevels  = ThickTend.extent_int(1);
+
+      parallelFor(
+          {DefMesh->NCellsAll, NVertLevels}, KOKKOS_LAMBDA(int ICell, int K) {
+             LayerThick(ICell, K) = 10.0_Real + 0.01_Real * (ICell % 97) + K;
+             ThickTend(ICell, K)  = 1.0e-4_Real * ((ICell + K) % 7 - 3);
+          });
+      parallelFor(
+          {DefMesh->NEdgesAll, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+             VelTend(IEdge, K) = 1.0e-6_Real * ((IEdge + 2 * K) % 5 - 2);
+          });
+      parallelFor(
+          {NTracers, DefMesh->NCellsAll, NVertLevels},
+          KOKKOS_LAMBDA(int L, int ICell, int K) {
+             CurTracers(L, ICell, K) = 1.0_Real + L + 0.001_Real * (ICell % 89);
+             TracerTend(L, ICell, K) = 1.0e-3_Real * ((ICell + L + K) % 11 - 5);
+          });
+
+      const TimeInterval Coeff(600, TimeUnits::Seconds);
+
+      Stepper->setUpdateGraphs(false);
+      Stepper->setFusedUpdate(false);
+      const UpdatedState Ref = updateState(Stepper, DefState, Coeff);
+
+      Stepper->setFusedUpdate(true);
+      RetVal += checkState(updateState(Stepper, DefState, Coeff), Ref,
+                           "fused update");
+
+      // The graph is recorded on the first update and replayed on the next
+      Stepper->setUpdateGraphs(true);
+      RetVal += checkState(updateState(Stepper, DefState, Coeff), Ref,
+                           "recorded graph");
+      RetVal += checkState(updateState(Stepper, DefState, Coeff), Ref,
+                           "replayed graph");
+
+      TimeStepper::erase("Fused");
+
+      Err = ocnFinalize(StartTime);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("FusedUpdateTest: error finalizing Omega");
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("FusedUpdateTest: Successful completion");
+   }
+   Pacer::finalize();
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
@@ -0,0 +1,236 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA low-storage RK convergence ---------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the order of the low-storage Runge-Kutta steppers
+///
+/// This driver initializes the standalone model and creates a tendency
+/// group with every tendency term disabled and a custom velocity tendency
+/// that decays the normal velocity at a constant rate, so the exact
+/// solution is an exponential decay. The LowStorageRK4 and SSPRK3 steppers
+/// integrate this decay over a fixed interval with a sequence of halved time
+/// steps, and the error of each stepper must converge at its formal order.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "Config.h"
+#include "DataTypes.h"
+#include "Error.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanDriver.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "Tendencies.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace OMEGA;
+
+/// Test constants
+constexpr I8 BaseStep    = 3600;           // coarsest time step in seconds
+constexpr int NBaseSteps = 8;              // steps at the coarsest step
+constexpr int NRefine    = 3;              // number of step refinements
+const R8 DecayRate       = 0.5 / BaseStep; // decay rate in 1/s
+const R8 RateTol         = 0.3;            // allowed error in the order
+const Real InitVelocity  = 1.0;
+
+/// Config flags of all tendency terms, which are disabled for the test
+const std::vector<std::string> TendFlags = {
+    "ThicknessFluxTendencyEnable",   "PVTendencyEnable",
+    "KETendencyEnable",              "SSHTendencyEnable",
+    "VelDiffTendencyEnable",         "VelHyperDiffTendencyEnable",
+    "WindForcingTendencyEnable",     "BottomDragTendencyEnable",
+    "TracerHorzAdvTendencyEnable",   "TracerDiffTendencyEnable",
+    "TracerHyperDiffTendencyEnable"};
+
+/// Custom velocity tendency for the decay of the normal velocity
+struct DecayVelocityTendency {
+   void operator()(Array2DReal NormalVelTend, OceanState *State,
+                   AuxiliaryState *AuxState, int ThickTimeLevel,
+                   int VelTimeLevel, TimeInstant Time) const {
+
+      const HorzMesh *Mesh  = HorzMesh::getDefault();
+      const int NVertLevels = NormalVelTend.extent_int(1);
+      const Real Rate       = DecayRate;
+
+      Array2DReal NormalVel;
+      I4 Err = State->getNormalVelocity(NormalVel, VelTimeLevel);
+      if (Err != 0)
+         ABORT_ERROR("RKConvergenceTest: error retrieving velocity");
+
+      parallelFor(
+          {Mesh->NEdgesAll, NVertLevels}, KOKKOS_LAMBDA(int IEdge, int K) {
+             NormalVelTend(IEdge, K) -= Rate * NormalVel(IEdge, K);
+          });
+   }
+};
+
+/// Custom thickness tendency that leaves the thickness unchanged
+struct ZeroThicknessTendency {
+   void operator()(Array2DReal LayerThickTend, OceanState *State,
+                   AuxiliaryState *AuxState, int ThickTimeLevel,
+                   int VelTimeLevel, TimeInstant Time) const {}
+};
+
+//------------------------------------------------------------------------------
+// Sets the normal velocity on all time levels to its initial value
+void resetVelocity(OceanState *State, int NTimeLevels) {
+   for (int TimeLevel = 0; TimeLevel < NTimeLevels; ++TimeLevel) {
+      Array2DReal NormalVel;
+      I4 Err = State->getNormalVelocity(NormalVel, TimeLevel);
+      if (Err != 0)
+         ABORT_ERROR("RKConvergenceTest: error retrieving velocity");
+      deepCopy(NormalVel, InitVelocity);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Integrates the decay over the test interval with the given stepper type
+// and time step and returns the largest error on all tasks
+R8 integrateDecay(TimeStepperType Type, Tendencies *DecayTend, I8 TimeStep,
+                  int NSteps) {
+
+   TimeStepper *DefStepper = TimeStepper::getDefault();
+   HorzMesh *DefMesh       = HorzMesh::getDefault();
+   OceanState *DefState    = OceanState::getDefault();
+   TimeInstant SimTime     = DefStepper->getStartTime();
+
+   TimeStepper *Stepper = TimeStepper::create(
+       "Convergence", Type, SimTime, DefStepper->getStopTime(),
+       TimeInterval(TimeStep, TimeUnits::Seconds), DecayTend,
+       AuxiliaryState::getDefault(), DefMesh, Halo::getDefault());
+   if (Stepper == nullptr)
+      ABORT_ERROR("RKConvergenceTest: error creating stepper");
+
+   resetVelocity(DefState, Stepper->getNTimeLevels());
+   for (int Step = 0; Step < NSteps; ++Step)
+      Stepper->doStep(DefState, SimTime);
+
+   TimeStepper::erase("Convergence");
+
+   const R8 Exact =
+       InitVelocity * std::exp(-DecayRate * static_cast<R8>(TimeStep * NSteps));
+
+   Array2DReal NormalVel;
+   I4 Err = DefState->getNormalVelocity(NormalVel, 0);
+   if (Err != 0)
+      ABORT_ERROR("RKConvergenceTest: error retrieving velocity");
+   auto NormalVelH = createHostMirrorCopy(NormalVel);
+
+   R8 MaxErr = 0;
+   for (int IEdge = 0; IEdge < DefMesh->NEdgesOwned; ++IEdge) {
+      for (int K = 0; K < NormalVelH.extent_int(1); ++K) {
+         MaxErr = std::max(MaxErr, std::abs(NormalVelH(IEdge, K) - Exact));
+      }
+   }
+
+   MPI_Allreduce(MPI_IN_PLACE, &MaxErr, 1, MPI_DOUBLE, MPI_MAX,
+                 MachEnv::getDefault()->getComm());
+   return MaxErr;
+}
+
+//------------------------------------------------------------------------------
+// Checks that the errors of a stepper converge at its formal order
+int checkOrder(TimeStepperType Type, Tendencies *DecayTend,
+               const std::string &Name, R8 Order) {
+
+   std::vector<R8> Errors;
+   I8 TimeStep = BaseStep;
+   int NSteps  = NBaseSteps;
+   for (int IRefine = 0; IRefine < NRefine; ++IRefine) {
+      Errors.push_back(integrateDecay(Type, DecayTend, TimeStep, NSteps));
+      TimeStep /= 2;
+      NSteps *= 2;
+   }
+
+   int Err = 0;
+   for (int IRefine = 1; IRefine < NRefine; ++IRefine) {
+      const R8 Rate = std::log2(Errors[IRefine - 1] / Errors[IRefine]);
+      if (std::abs(Rate - Order) < RateTol) {
+         LOG_INFO("RKConvergenceTest: {} order {} at refinement {} PASS",
+                  Name, Rate, IRefine);
+      } else {
+         ++Err;
+         LOG_ERROR("RKConvergenceTest: {} order {} at refinement {} FAIL, "
+                   "expected {}",
+                   Name, Rate, IRefine, Order);
+      }
+   }
+   return Err;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the convergence of the low-storage RK steppers
+int main(int argc, char *argv[]) {
+
+   I4 RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      I4 Err = ocnInit(MPI_COMM_WORLD);
+      if (Err != 0)
+         ABORT_ERROR("RKConvergenceTest: error initializing Omega");
+
+      // Disable every tendency term so that only the custom tendencies
+      // are computed. The default tendencies are already built, so the
+      // shared config can be changed here.
+      Config TendConfig("Tendencies");
+      Err = Config::getOmegaConfig()->get(TendConfig);
+      if (Err != 0)
+         ABORT_ERROR("RKConvergenceTest: Tendencies group not found");
+      for (const std::string &Flag : TendFlags)
+         TendConfig.set(Flag, false);
+
+      Tendencies *DefTend   = Tendencies::getDefault();
+      const int NVertLevels = DefTend->LayerThicknessTend.extent_int(1);
+      Tendencies *DecayTend = Tendencies::create(
+          "Decay", HorzMesh::getDefault(), NVertLevels,
+          Tracers::getNumTracers(), &TendConfig, ZeroThicknessTendency{},
+          DecayVelocityTendency{});
+      if (DecayTend == nullptr)
+         ABORT_ERROR("RKConvergenceTest: error creating tendencies");
+
+      RetVal += checkOrder(TimeStepperType::LowStorageRK4, DecayTend,
+                           "LowStorageRK4", 4.0);
+      RetVal += checkOrder(TimeStepperType::SSPRK3, DecayTend, "SSPRK3", 3.0);
+
+      Err = ocnFinalize(TimeStepper::getDefault()->getStartTime());
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("RKConvergenceTest: error finalizing Omega");
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("RKConvergenceTest: Successful completion");
+   }
+   Pacer::finalize();
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/
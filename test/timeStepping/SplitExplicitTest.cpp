@@ -0,0 +1,152 @@
+/*
+ * © 2025. Triad National Security, LLC. All rights reserved.
+ * This program was produced under U.S. Government contract 89233218CNA000001 for Los Alamos National Laboratory (LANL), which is operated by Triad National Security, LLC for the U.S. Department of Energy/National Nuclear Security Administration. All rights in the program are reserved by Triad National Security, LLC, and the U.S. Department of Energy/National Nuclear Security Administration. The Government is granted for itself and others acting on its behalf a nonexclusive, paid-up, irrevocable worldwide license in this material to reproduce, prepare. derivative works, distribute copies to the public, perform publicly and display publicly, and to permit others to do so.
+ */
+
+//===-- Test driver for OMEGA split-explicit stepper -------------*- C++ -*-===/
+//
+/// \file
+/// \brief Test driver for the split-explicit time stepper
+///
+/// This driver initializes the standalone model, creates a split-explicit
+/// stepper on the default mesh, sets every tracer to a uniform value and
+/// takes a few steps. The layer thickness changes with the barotropic
+/// transport, but since the tracers are advected with the same thickness
+/// flux they must stay uniform in all active layers of the owned cells.
+///
+//
+//===-----------------------------------------------------------------------===/
+
+#include "AuxiliaryState.h"
+#include "DataTypes.h"
+#include "Error.h"
+#include "Halo.h"
+#include "HorzMesh.h"
+#include "Logging.h"
+#include "MachEnv.h"
+#include "OceanDriver.h"
+#include "OceanState.h"
+#include "OmegaKokkos.h"
+#include "Pacer.h"
+#include "SplitExplicitStepper.h"
+#include "StencilCoeffs.h"
+#include "Tendencies.h"
+#include "TimeMgr.h"
+#include "TimeStepper.h"
+#include "Tracers.h"
+#include "mpi.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace OMEGA;
+
+/// Test constants
+constexpr int NSteps   = 4;
+const Real TracerValue = 5.0;
+const Real RTol        = sizeof(Real) == 4 ? 1e-5 : 1e-12;
+
+//------------------------------------------------------------------------------
+// Returns the largest relative deviation of the tracers from TracerValue in
+// the active layers of the owned cells
+Real maxTracerDeviation(const HorzMesh *Mesh, int TimeLevel) {
+
+   Array3DReal TracerArray;
+   I4 Err = Tracers::getAll(TracerArray, TimeLevel);
+   if (Err != 0)
+      ABORT_ERROR("SplitExplicitTest: error retrieving tracers");
+
+   const StencilCoeffs *Coeffs = StencilCoeffs::get(Mesh);
+   auto TracerH                = createHostMirrorCopy(TracerArray);
+   auto MinLevelH              = createHostMirrorCopy(Coeffs->MinLevelCell);
+   auto MaxLevelH              = createHostMirrorCopy(Coeffs->MaxLevelCell);
+
+   Real MaxDev = 0;
+   for (int L = 0; L < TracerH.extent_int(0); ++L) {
+      for (int ICell = 0; ICell < Mesh->NCellsOwned; ++ICell) {
+         for (int K = MinLevelH(ICell); K <= MaxLevelH(ICell); ++K) {
+            const Real Dev =
+                std::abs(TracerH(L, ICell, K) - TracerValue) / TracerValue;
+            MaxDev = std::max(MaxDev, Dev);
+         }
+      }
+   }
+
+   MPI_Allreduce(MPI_IN_PLACE, &MaxDev, 1, MPI_RealKind, MPI_MAX,
+                 MachEnv::getDefault()->getComm());
+   return MaxDev;
+}
+
+//------------------------------------------------------------------------------
+// The test driver for the split-explicit stepper
+int main(int argc, char *argv[]) {
+
+   I4 RetVal = 0;
+
+   MPI_Init(&argc, &argv);
+   Kokkos::initialize();
+   Pacer::initialize(MPI_COMM_WORLD);
+   Pacer::setPrefix("Omega:");
+   {
+      I4 Err = ocnInit(MPI_COMM_WORLD);
+      if (Err != 0)
+         ABORT_ERROR("SplitExplicitTest: error initializing Omega");
+
+      TimeStepper *DefStepper = TimeStepper::getDefault();
+      HorzMesh *DefMesh       = HorzMesh::getDefault();
+      OceanState *DefState    = OceanState::getDefault();
+      TimeInstant SimTime     = DefStepper->getStartTime();
+
+      TimeStepper *Stepper = TimeStepper::create(
+          "SplitExplicit", TimeStepperType::SplitExplicit, SimTime,
+          DefStepper->getStopTime(), DefStepper->getTimeStep(),
+          Tendencies::getDefault(), AuxiliaryState::getDefault(), DefMesh,
+          Halo::getDefault());
+      if (Stepper == nullptr)
+         ABORT_ERROR("SplitExplicitTest: error creating stepper");
+
+      // Uniform tracers on both time levels, including the halo
+      for (int TimeLevel = 0; TimeLevel < Stepper->getNTimeLevels();
+           ++TimeLevel) {
+         Array3DReal TracerArray;
+         Err = Tracers::getAll(TracerArray, TimeLevel);
+         if (Err != 0)
+            ABORT_ERROR("SplitExplicitTest: error retrieving tracers");
+         deepCopy(TracerArray, TracerValue);
+      }
+
+      for (int Step = 0; Step < NSteps; ++Step)
+         Stepper->doStep(DefState, SimTime);
+
+      const Real MaxDev = maxTracerDeviation(DefMesh, 0);
+      if (MaxDev < RTol) {
+         LOG_INFO("SplitExplicitTest: tracer uniformity PASS");
+      } else {
+         RetVal += 1;
+         LOG_ERROR("SplitExplicitTest: tracer uniformity FAIL, max relative "
+                   "deviation {}",
+                   MaxDev);
+      }
+
+      TimeStepper::erase("SplitExplicit");
+
+      Err = ocnFinalize(SimTime);
+      if (Err != 0) {
+         RetVal += 1;
+         LOG_ERROR("SplitExplicitTest: error finalizing Omega");
+      }
+
+      if (RetVal == 0)
+         LOG_INFO("SplitExplicitTest: Successful completion");
+   }
+   Pacer::finalize();
+   Kokkos::finalize();
+   MPI_Finalize();
+
+   if (RetVal >= 256)
+      RetVal = 255;
+
+   return RetVal;
+
+} // end of main
+//===-----------------------------------------------------------------------===/